@@ -387,11 +387,13 @@ H5AC_create(const H5F_t *f, H5AC_cache_config_t *config_ptr, H5AC_cache_image_co
 #endif /* H5_HAVE_PARALLEL */
 
     /* Turn on metadata cache logging, if being used
-     * This will be JSON until we create a special API call. Trace output
-     * is generated when logging is controlled by the struct.
+     * This will be JSON or binary, as set with H5Pset_mdc_log_format().
+     * Trace output is generated when logging is controlled by the struct.
      */
     if (H5F_USE_MDC_LOGGING(f))
-        if (H5C_log_set_up(f->shared->cache, H5F_MDC_LOG_LOCATION(f), H5C_LOG_STYLE_JSON,
+        if (H5C_log_set_up(f->shared->cache, H5F_MDC_LOG_LOCATION(f),
+                           (H5F_MDC_LOG_FORMAT_BINARY == H5F_MDC_LOG_FORMAT(f)) ? H5C_LOG_STYLE_BINARY
+                                                                                : H5C_LOG_STYLE_JSON,
                            H5F_START_MDC_LOG_ON_ACCESS(f)) < 0)
             HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "mdc logging setup failed")
 
@@ -409,6 +411,7 @@ H5AC_create(const H5F_t *f, H5AC_cache_config_t *config_ptr, H5AC_cache_image_co
     int_ci_config.generate_image     = image_config_ptr->generate_image;
     int_ci_config.save_resize_status = image_config_ptr->save_resize_status;
     int_ci_config.entry_ageout       = image_config_ptr->entry_ageout;
+    int_ci_config.compress_image     = image_config_ptr->compress_image;
     if (H5C_set_cache_image_config(f, f->shared->cache, &int_ci_config) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_CANTSET, FAIL, "auto resize configuration failed")
 
@@ -1186,6 +1189,43 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5AC_pin_protected_entry() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_prefetch_entries
+ *
+ * Purpose:     Read ahead the images of entries that are about to be
+ *              protected, so that they can be loaded without further
+ *              I/O.  This is only a hint: entries that are already in
+ *              the cache are skipped, and nothing is read when the file
+ *              driver can't combine the reads.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5AC_prefetch_entries(H5F_t *f, size_t count, const H5AC_prefetch_req_t reqs[])
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(f->shared->cache);
+    HDassert(count == 0 || reqs);
+
+    /* Reading a single image ahead of its entry saves nothing */
+    if (count < 2)
+        HGOTO_DONE(SUCCEED)
+
+    if (H5C_prefetch_entries(f, count, reqs) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTLOAD, FAIL, "unable to read ahead metadata cache entries")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_prefetch_entries() */
+
 /*-------------------------------------------------------------------------
  *
  * Function:    H5AC_prep_for_file_close
@@ -1696,6 +1736,60 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5AC_unprotect() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_protect_shared
+ *
+ * Purpose:     Wrapper function for H5C_protect_shared().  Unlike the
+ *              other functions here, this may be called by threads that
+ *              don't hold the library's lock, for files whose cache
+ *              allows shared reads.  Nothing is logged.
+ *
+ * Return:      Pointer to the entry on success/NULL if it isn't in the
+ *              cache, and has to be protected with H5AC_protect()
+ *
+ *-------------------------------------------------------------------------
+ */
+void *
+H5AC_protect_shared(H5F_t *f, const H5AC_class_t *type, haddr_t addr)
+{
+    void *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(f->shared->cache);
+    HDassert(type);
+    HDassert(H5F_addr_defined(addr));
+
+    ret_value = H5C_protect_shared(f->shared->cache, type, addr);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5AC_protect_shared() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5AC_unprotect_shared
+ *
+ * Purpose:     Wrapper function for H5C_unprotect_shared().
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5AC_unprotect_shared(void *thing)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(thing);
+
+    H5C_unprotect_shared(thing);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5AC_unprotect_shared() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5AC_get_cache_auto_resize_config
  *
@@ -1711,9 +1805,10 @@ done:
 herr_t
 H5AC_get_cache_auto_resize_config(const H5AC_t *cache_ptr, H5AC_cache_config_t *config_ptr)
 {
-    H5C_auto_size_ctl_t internal_config;
-    hbool_t             evictions_enabled;
-    herr_t              ret_value = SUCCEED; /* Return value */
+    H5C_auto_size_ctl_t        internal_config;
+    hbool_t                    evictions_enabled;
+    enum H5C_cache_repl_policy repl_policy;
+    herr_t                     ret_value = SUCCEED; /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
 
@@ -1736,6 +1831,8 @@ H5AC_get_cache_auto_resize_config(const H5AC_t *cache_ptr, H5AC_cache_config_t *
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_get_cache_auto_resize_config() failed")
     if (H5C_get_evictions_enabled((const H5C_t *)cache_ptr, &evictions_enabled) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_get_resize_enabled() failed")
+    if (H5C_get_repl_policy((const H5C_t *)cache_ptr, &repl_policy) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_get_repl_policy() failed")
 
     /* Set the information to return */
     if (internal_config.rpt_fcn == NULL)
@@ -1768,6 +1865,7 @@ H5AC_get_cache_auto_resize_config(const H5AC_t *cache_ptr, H5AC_cache_config_t *
     config_ptr->epochs_before_eviction = (int)(internal_config.epochs_before_eviction);
     config_ptr->apply_empty_reserve    = internal_config.apply_empty_reserve;
     config_ptr->empty_reserve          = internal_config.empty_reserve;
+    config_ptr->repl_policy            = repl_policy;
 #ifdef H5_HAVE_PARALLEL
     {
         H5AC_aux_t *aux_ptr;
@@ -1963,6 +2061,8 @@ H5AC_set_cache_auto_resize_config(H5AC_t *cache_ptr, H5AC_cache_config_t *config
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_set_cache_auto_resize_config() failed")
     if (H5C_set_evictions_enabled(cache_ptr, config_ptr->evictions_enabled) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_set_evictions_enabled() failed")
+    if (H5C_set_repl_policy(cache_ptr, config_ptr->repl_policy) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C_set_repl_policy() failed")
 
 #ifdef H5_HAVE_PARALLEL
     {
@@ -2051,6 +2151,9 @@ H5AC_validate_config(H5AC_cache_config_t *config_ptr)
         (config_ptr->metadata_write_strategy != H5AC_METADATA_WRITE_STRATEGY__DISTRIBUTED))
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "config_ptr->metadata_write_strategy out of range")
 
+    if ((config_ptr->repl_policy != H5C_repl__lru) && (config_ptr->repl_policy != H5C_repl__2q))
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "config_ptr->repl_policy out of range")
+
     if (H5AC__ext_config_2_int_config(config_ptr, &internal_config) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5AC__ext_config_2_int_config() failed")
 
@@ -2107,6 +2210,7 @@ H5AC_validate_cache_image_config(H5AC_cache_image_config_t *config_ptr)
     internal_config.generate_image     = config_ptr->generate_image;
     internal_config.save_resize_status = config_ptr->save_resize_status;
     internal_config.entry_ageout       = config_ptr->entry_ageout;
+    internal_config.compress_image     = config_ptr->compress_image;
 
     if (H5C_validate_cache_image_config(&internal_config) < 0)
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "error(s) in new cache image config")
@@ -168,8 +168,9 @@ typedef H5C_notify_action_t H5AC_notify_action_t;
 #define H5AC_NOTIFY_ACTION_CHILD_UNSERIALIZED H5C_NOTIFY_ACTION_CHILD_UNSERIALIZED
 #define H5AC_NOTIFY_ACTION_CHILD_SERIALIZED   H5C_NOTIFY_ACTION_CHILD_SERIALIZED
 
-#define H5AC__CLASS_NO_FLAGS_SET          H5C__CLASS_NO_FLAGS_SET
-#define H5AC__CLASS_SPECULATIVE_LOAD_FLAG H5C__CLASS_SPECULATIVE_LOAD_FLAG
+#define H5AC__CLASS_NO_FLAGS_SET            H5C__CLASS_NO_FLAGS_SET
+#define H5AC__CLASS_SPECULATIVE_LOAD_FLAG   H5C__CLASS_SPECULATIVE_LOAD_FLAG
+#define H5AC__CLASS_PARALLEL_SERIALIZE_FLAG H5C__CLASS_PARALLEL_SERIALIZE_FLAG
 
 /* The following flags should only appear in test code */
 #define H5AC__CLASS_SKIP_READS  H5C__CLASS_SKIP_READS
@@ -193,6 +194,8 @@ typedef H5C_get_fsf_size_t       H5AC_get_fsf_size_t;
 
 typedef H5C_class_t H5AC_class_t;
 
+typedef H5C_prefetch_req_t H5AC_prefetch_req_t;
+
 /* Cache entry info */
 typedef H5C_cache_entry_t H5AC_info_t;
 
@@ -257,7 +260,8 @@ typedef struct H5AC_proxy_entry_t {
   /* double      empty_reserve          = */ 0.1f,                            \
   /* size_t      dirty_bytes_threshold  = */ (256 * 1024),                    \
   /* int         metadata_write_strategy = */                                  \
-                    H5AC__DEFAULT_METADATA_WRITE_STRATEGY  \
+                    H5AC__DEFAULT_METADATA_WRITE_STRATEGY, \
+  /* enum H5C_cache_repl_policy repl_policy = */ H5C_repl__lru                 \
 }
 #else /* H5_HAVE_PARALLEL */
 #define H5AC__DEFAULT_CACHE_CONFIG                                            \
@@ -293,7 +297,8 @@ typedef struct H5AC_proxy_entry_t {
   /* double      empty_reserve          = */ 0.1f,                            \
   /* size_t      dirty_bytes_threshold  = */ (256 * 1024),                    \
   /* int         metadata_write_strategy = */                                  \
-                    H5AC__DEFAULT_METADATA_WRITE_STRATEGY  \
+                    H5AC__DEFAULT_METADATA_WRITE_STRATEGY, \
+  /* enum H5C_cache_repl_policy repl_policy = */ H5C_repl__lru                 \
 }
 #endif /* H5_HAVE_PARALLEL */
 
@@ -302,7 +307,8 @@ typedef struct H5AC_proxy_entry_t {
    /* int32_t version            = */ H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION, \
    /* hbool_t generate_image     = */ FALSE,                                 \
    /* hbool_t save_resize_status = */ FALSE,                                 \
-   /* int32_t entry_ageout       = */ H5AC__CACHE_IMAGE__ENTRY_AGEOUT__NONE  \
+   /* int32_t entry_ageout       = */ H5AC__CACHE_IMAGE__ENTRY_AGEOUT__NONE, \
+   /* hbool_t compress_image     = */ FALSE                                  \
 }
 /* clang-format on */
 /*
@@ -384,6 +390,7 @@ H5_DLL herr_t H5AC_get_entry_status(const H5F_t *f, haddr_t addr, unsigned *stat
 H5_DLL herr_t H5AC_insert_entry(H5F_t *f, const H5AC_class_t *type, haddr_t addr, void *thing,
                                 unsigned int flags);
 H5_DLL herr_t H5AC_pin_protected_entry(void *thing);
+H5_DLL herr_t H5AC_prefetch_entries(H5F_t *f, size_t count, const H5AC_prefetch_req_t reqs[]);
 H5_DLL herr_t H5AC_prep_for_file_close(H5F_t *f);
 H5_DLL herr_t H5AC_prep_for_file_flush(H5F_t *f);
 H5_DLL herr_t H5AC_secure_from_file_flush(H5F_t *f);
@@ -393,6 +400,8 @@ H5_DLL herr_t H5AC_resize_entry(void *thing, size_t new_size);
 H5_DLL herr_t H5AC_unpin_entry(void *thing);
 H5_DLL herr_t H5AC_destroy_flush_dependency(void *parent_thing, void *child_thing);
 H5_DLL herr_t H5AC_unprotect(H5F_t *f, const H5AC_class_t *type, haddr_t addr, void *thing, unsigned flags);
+H5_DLL void * H5AC_protect_shared(H5F_t *f, const H5AC_class_t *type, haddr_t addr);
+H5_DLL void   H5AC_unprotect_shared(void *thing);
 H5_DLL herr_t H5AC_flush(H5F_t *f);
 H5_DLL herr_t H5AC_mark_entry_dirty(void *thing);
 H5_DLL herr_t H5AC_mark_entry_clean(void *thing);
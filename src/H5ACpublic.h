@@ -434,6 +434,30 @@ extern "C" {
  *    To avoid possible messages from the past/future, all caches must
  *    wait until all caches are done before leaving the sync point.
  *
+ *
+ * Replacement policy configuration field:
+ *
+ * repl_policy: Instance of the H5C_cache_repl_policy enumerated type whose
+ *    value selects the policy used to choose the entries to evict when
+ *    the cache needs space.  The valid values are:
+ *
+ *    H5C_repl__lru: Evict the least recently used entries first.  This is
+ *    the default.
+ *
+ *    H5C_repl__2q: Scan resistant policy modelled on 2Q.  An entry that is
+ *    accessed again after at least a quarter of the cache's entries have
+ *    been loaded since it was, is promoted to the "hot" part of the cache.
+ *    Repeated accesses in quick succession, as when a single object is
+ *    being read, don't promote it.  When a hot entry reaches the end of
+ *    the LRU list, it is moved back to the head of the list instead of
+ *    being evicted, as long as the hot entries use no more than three
+ *    quarters of the maximum cache size.  Otherwise it is evicted like
+ *    any other entry.
+ *
+ *    Thus a one-off traversal of a large file evicts the entries it loaded
+ *    itself, rather than the frequently used entries -- for example the
+ *    interior nodes of the B-trees indexing heavily used datasets.
+ *
  ****************************************************************************/
 
 #define H5AC__CURR_CACHE_CONFIG_VERSION 1
@@ -497,6 +521,9 @@ typedef struct H5AC_cache_config_t {
     size_t dirty_bytes_threshold;
     int    metadata_write_strategy;
 
+    /* replacement policy fields: */
+    enum H5C_cache_repl_policy repl_policy;
+
 } H5AC_cache_config_t;
 
 /****************************************************************************
@@ -546,6 +573,20 @@ typedef struct H5AC_cache_config_t {
  *    current value, any value in excess of 255 will be the functional
  *    equivalent of H5AC__CACHE_IMAGE__ENTRY_AGEOUT__NONE.
  *
+ * compress_image:  Boolean flag indicating whether the cache image should
+ *    be written in the indexed format, with the on disk image of each
+ *    entry compressed with the deflate filter when the library supports
+ *    it.
+ *
+ *    An indexed cache image places a table of the entries it holds ahead
+ *    of their images.  When a file is opened read only, only that table
+ *    is read, and each entry's image is read from the cache image the
+ *    first time the entry is protected.  Thus opening a file with a large
+ *    cache image costs little more than opening one without.
+ *
+ *    Versions of the library prior to 1.13.0 can't read indexed cache
+ *    images.
+ *
  ****************************************************************************/
 
 #define H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION 1
@@ -558,6 +599,7 @@ typedef struct H5AC_cache_image_config_t {
     hbool_t generate_image;
     hbool_t save_resize_status;
     int     entry_ageout;
+    hbool_t compress_image;
 } H5AC_cache_image_config_t;
 
 #ifdef __cplusplus
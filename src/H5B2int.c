@@ -55,6 +55,8 @@
 static herr_t H5B2__update_child_flush_depends(H5B2_hdr_t *hdr, unsigned depth,
                                                const H5B2_node_ptr_t *node_ptrs, unsigned start_idx,
                                                unsigned end_idx, void *old_parent, void *new_parent);
+static herr_t H5B2__prefetch_children(H5B2_hdr_t *hdr, uint16_t depth, const H5B2_node_ptr_t *node_ptrs,
+                                      unsigned nchildren);
 
 /*********************/
 /* Package Variables */
@@ -1659,6 +1661,10 @@ H5B2__iterate_node(H5B2_hdr_t *hdr, uint16_t depth, const H5B2_node_ptr_t *curr_
         /* Copy the node pointers */
         H5MM_memcpy(node_ptrs, internal->node_ptrs,
                     (sizeof(H5B2_node_ptr_t) * (size_t)(curr_node->node_nrec + 1)));
+
+        /* Read ahead the child nodes, which will all be visited */
+        if (H5B2__prefetch_children(hdr, depth, node_ptrs, (unsigned)curr_node->node_nrec + 1) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTLOAD, FAIL, "unable to read ahead B-tree child nodes")
     } /* end if */
     else {
         H5B2_leaf_t *leaf; /* Pointer to leaf node */
@@ -1725,6 +1731,51 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5B2__iterate_node() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5B2__prefetch_children
+ *
+ * Purpose:	Read ahead the child nodes of an internal node at DEPTH,
+ *		before they are visited one after the other.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5B2__prefetch_children(H5B2_hdr_t *hdr, uint16_t depth, const H5B2_node_ptr_t *node_ptrs,
+                        unsigned nchildren)
+{
+    H5AC_prefetch_req_t *reqs      = NULL;    /* Child nodes to read ahead */
+    unsigned             u;                   /* Local index */
+    herr_t               ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check arguments. */
+    HDassert(hdr);
+    HDassert(depth > 0);
+    HDassert(node_ptrs);
+
+    if (nchildren < 2)
+        HGOTO_DONE(SUCCEED)
+
+    if (NULL == (reqs = (H5AC_prefetch_req_t *)H5MM_malloc(nchildren * sizeof(H5AC_prefetch_req_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for child node read-ahead")
+    for (u = 0; u < nchildren; u++) {
+        reqs[u].type = (depth > 1) ? H5AC_BT2_INT : H5AC_BT2_LEAF;
+        reqs[u].addr = node_ptrs[u].addr;
+        reqs[u].len  = hdr->node_size;
+    } /* end for */
+
+    if (H5AC_prefetch_entries(hdr->f, (size_t)nchildren, reqs) < 0)
+        HGOTO_ERROR(H5E_BTREE, H5E_CANTLOAD, FAIL, "unable to read ahead B-tree nodes")
+
+done:
+    H5MM_xfree(reqs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5B2__prefetch_children() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5B2__delete_node
  *
@@ -1768,6 +1819,10 @@ H5B2__delete_node(H5B2_hdr_t *hdr, uint16_t depth, const H5B2_node_ptr_t *curr_n
         node            = internal;
         native          = internal->int_native;
 
+        /* Read ahead the children */
+        if (H5B2__prefetch_children(hdr, depth, internal->node_ptrs, internal->nrec + (unsigned)1) < 0)
+            HGOTO_ERROR(H5E_BTREE, H5E_CANTLOAD, FAIL, "unable to read ahead B-tree child nodes")
+
         /* Descend into children */
         for (u = 0; u < internal->nrec + (unsigned)1; u++)
             if (H5B2__delete_node(hdr, (uint16_t)(depth - 1), &(internal->node_ptrs[u]), internal, op,
@@ -61,20 +61,20 @@ static herr_t H5B__cache_free_icr(void *thing);
 
 /* H5B inherits cache-like properties from H5AC */
 const H5AC_class_t H5AC_BT[1] = {{
-    H5AC_BT_ID,                       /* Metadata client ID */
-    "v1 B-tree",                      /* Metadata client name (for debugging) */
-    H5FD_MEM_BTREE,                   /* File space memory type for client */
-    H5AC__CLASS_NO_FLAGS_SET,         /* Client class behavior flags */
-    H5B__cache_get_initial_load_size, /* 'get_initial_load_size' callback */
-    NULL,                             /* 'get_final_load_size' callback */
-    NULL,                             /* 'verify_chksum' callback */
-    H5B__cache_deserialize,           /* 'deserialize' callback */
-    H5B__cache_image_len,             /* 'image_len' callback */
-    NULL,                             /* 'pre_serialize' callback */
-    H5B__cache_serialize,             /* 'serialize' callback */
-    NULL,                             /* 'notify' callback */
-    H5B__cache_free_icr,              /* 'free_icr' callback */
-    NULL,                             /* 'fsf_size' callback */
+    H5AC_BT_ID,                          /* Metadata client ID */
+    "v1 B-tree",                         /* Metadata client name (for debugging) */
+    H5FD_MEM_BTREE,                      /* File space memory type for client */
+    H5AC__CLASS_PARALLEL_SERIALIZE_FLAG, /* Client class behavior flags */
+    H5B__cache_get_initial_load_size,    /* 'get_initial_load_size' callback */
+    NULL,                                /* 'get_final_load_size' callback */
+    NULL,                                /* 'verify_chksum' callback */
+    H5B__cache_deserialize,              /* 'deserialize' callback */
+    H5B__cache_image_len,                /* 'image_len' callback */
+    NULL,                                /* 'pre_serialize' callback */
+    H5B__cache_serialize,                /* 'serialize' callback */
+    NULL,                                /* 'notify' callback */
+    H5B__cache_free_icr,                 /* 'free_icr' callback */
+    NULL,                                /* 'fsf_size' callback */
 }};
 
 /*******************/
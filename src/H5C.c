@@ -88,6 +88,7 @@
 #include "H5MFprivate.h" /* File memory management */
 #include "H5MMprivate.h" /* Memory management */
 #include "H5Pprivate.h"  /* Property lists */
+#include "H5Tprivate.h"  /* Datatypes */
 
 /****************/
 /* Local Macros */
@@ -99,6 +100,9 @@
 #define H5C_IMAGE_EXTRA_SPACE 0
 #endif /* H5C_DO_MEMORY_SANITY_CHECKS */
 
+/* Fewest entries ready to be flushed that are worth handing to the worker threads */
+#define H5C_PARALLEL_SERIALIZE_MIN_ENTRIES 16
+
 /******************/
 /* Local Typedefs */
 /******************/
@@ -106,6 +110,15 @@
 /* Alias for pointer to cache entry, for use when allocating sequences of them */
 typedef H5C_cache_entry_t *H5C_cache_entry_ptr_t;
 
+#ifdef H5_HAVE_CONV_THREADS
+/* Entries serialized together on the worker threads */
+typedef struct H5C_serialize_job_t {
+    H5F_t *                f;       /* File the entries belong to */
+    H5C_cache_entry_ptr_t *entries; /* Entries to serialize */
+    herr_t *               status;  /* Result of serializing each entry */
+} H5C_serialize_job_t;
+#endif /* H5_HAVE_CONV_THREADS */
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -139,6 +152,33 @@ static herr_t H5C__flush_invalidate_ring(H5F_t *f, H5C_ring_t ring, unsigned fla
 
 static herr_t H5C__flush_ring(H5F_t *f, H5C_ring_t ring, unsigned flags);
 
+static herr_t H5C__queue_entry_write(H5F_t *f, H5FD_mem_t mem_type, haddr_t addr, size_t size,
+                                     const void *image);
+
+static herr_t H5C__write_batch(H5F_t *f);
+
+static herr_t H5C__end_write_batch(H5F_t *f);
+
+static int H5C__read_ahead_cmp(const void *_ra1, const void *_ra2);
+
+static const H5C_read_ahead_t *H5C__find_read_ahead(const H5C_t *cache_ptr, haddr_t addr);
+
+static void H5C__discard_read_ahead(H5C_t *cache_ptr, haddr_t addr, size_t len, hbool_t within);
+
+static void H5C__add_read_ahead(H5C_t *cache_ptr, H5C_read_ahead_t *ra);
+
+static herr_t H5C__read_ahead_image_index_entry(H5F_t *f, H5FD_mem_t mem_type, haddr_t addr,
+                                                const H5C_read_ahead_t **ra_ptr);
+
+static herr_t H5C__read_image(H5F_t *f, H5FD_mem_t mem_type, haddr_t addr, size_t len, void *image,
+                              hbool_t use_read_ahead);
+
+#ifdef H5_HAVE_CONV_THREADS
+static herr_t H5C__serialize_job_entry(void *op_data, size_t block);
+
+static herr_t H5C__serialize_ready_entries(H5F_t *f, H5C_ring_t ring, unsigned flags);
+#endif /* H5_HAVE_CONV_THREADS */
+
 static void *H5C__load_entry(H5F_t *f,
 #ifdef H5_HAVE_PARALLEL
                              hbool_t coll_access,
@@ -194,6 +234,9 @@ H5FL_DEFINE_STATIC(H5C_t);
 /* Declare a free list to manage arrays of cache entries */
 H5FL_SEQ_DEFINE_STATIC(H5C_cache_entry_ptr_t);
 
+/* Declare a free list to manage the H5C_read_ahead_t struct */
+H5FL_DEFINE_STATIC(H5C_read_ahead_t);
+
 /*-------------------------------------------------------------------------
  * Function:    H5C_create
  *
@@ -370,8 +413,14 @@ H5C_create(size_t max_cache_size, size_t min_clean_size, int max_type_id,
         cache_ptr->slist_ring_size[i] = (size_t)0;
     } /* end for */
 
-    for (i = 0; i < H5C__HASH_TABLE_LEN; i++)
-        (cache_ptr->index)[i] = NULL;
+    if (NULL == (cache_ptr->index = (H5C_cache_entry_t **)H5MM_calloc(
+                     H5C__HASH_NBUCKETS(H5C__HASH_MIN_NBITS) * sizeof(H5C_cache_entry_t *))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, NULL, "can't allocate cache index")
+    cache_ptr->index_nbits       = H5C__HASH_MIN_NBITS;
+    cache_ptr->old_index         = NULL;
+    cache_ptr->old_index_nbits   = 0;
+    cache_ptr->index_rehash_next = 0;
+    cache_ptr->index_seq         = 0;
 
     cache_ptr->il_len  = 0;
     cache_ptr->il_size = (size_t)0;
@@ -436,6 +485,10 @@ H5C_create(size_t max_cache_size, size_t min_clean_size, int max_type_id,
     cache_ptr->dLRU_tail_ptr  = NULL;
 #endif /* H5C_MAINTAIN_CLEAN_AND_DIRTY_LRU_LISTS */
 
+    cache_ptr->repl_policy   = H5C_repl__lru;
+    cache_ptr->rp_load_count = 0;
+    cache_ptr->rp_hot_size   = (size_t)0;
+
     cache_ptr->size_increase_possible        = FALSE;
     cache_ptr->flash_size_increase_possible  = FALSE;
     cache_ptr->flash_size_increase_threshold = 0;
@@ -499,6 +552,7 @@ H5C_create(size_t max_cache_size, size_t min_clean_size, int max_type_id,
     cache_ptr->image_ctl.generate_image     = FALSE;
     cache_ptr->image_ctl.save_resize_status = FALSE;
     cache_ptr->image_ctl.entry_ageout       = -1;
+    cache_ptr->image_ctl.compress_image     = FALSE;
     cache_ptr->image_ctl.flags              = H5C_CI__ALL_FLAGS;
 
     cache_ptr->serialization_in_progress = FALSE;
@@ -508,6 +562,7 @@ H5C_create(size_t max_cache_size, size_t min_clean_size, int max_type_id,
     cache_ptr->image_addr                = HADDR_UNDEF;
     cache_ptr->image_len                 = 0;
     cache_ptr->image_data_len            = 0;
+    cache_ptr->image_index_size          = 0;
 
     cache_ptr->entries_loaded_counter         = 0;
     cache_ptr->entries_inserted_counter       = 0;
@@ -517,6 +572,36 @@ H5C_create(size_t max_cache_size, size_t min_clean_size, int max_type_id,
     cache_ptr->num_entries_in_image = 0;
     cache_ptr->image_entries        = NULL;
     cache_ptr->image_buffer         = NULL;
+    cache_ptr->image_index          = NULL;
+    cache_ptr->image_index_nentries = 0;
+
+    /* initialize the batch of writes during flushes: */
+    cache_ptr->write_batch.active   = FALSE;
+    cache_ptr->write_batch.nwrites  = 0;
+    cache_ptr->write_batch.nalloc   = 0;
+    cache_ptr->write_batch.writes   = NULL;
+    cache_ptr->write_batch.buf_used = 0;
+    cache_ptr->write_batch.buf_size = 0;
+    cache_ptr->write_batch.buf      = NULL;
+
+    /* initialize the list of images read ahead: */
+    cache_ptr->ra_head = NULL;
+    cache_ptr->ra_tail = NULL;
+    cache_ptr->ra_size = 0;
+
+    /* initialize the metadata access trace: */
+    cache_ptr->trace_location  = NULL;
+    cache_ptr->trace_recording = FALSE;
+    cache_ptr->trace_reqs      = NULL;
+    cache_ptr->trace_nreqs     = 0;
+    cache_ptr->trace_nalloc    = 0;
+    cache_ptr->trace_size      = 0;
+
+    /* initialize shared reads: */
+    cache_ptr->shared_reads      = FALSE;
+    cache_ptr->shared_epoch      = 0;
+    cache_ptr->shared_readers[0] = 0;
+    cache_ptr->shared_readers[1] = 0;
 
     /* initialize free space manager related fields: */
     cache_ptr->rdfsm_settled = FALSE;
@@ -549,6 +634,9 @@ done:
             if (cache_ptr->log_info != NULL)
                 H5MM_xfree(cache_ptr->log_info);
 
+            if (cache_ptr->index != NULL)
+                H5MM_xfree(cache_ptr->index);
+
             cache_ptr->magic = 0;
             cache_ptr        = H5FL_FREE(H5C_t, cache_ptr);
         } /* end if */
@@ -907,6 +995,20 @@ H5C_dest(H5F_t *f)
         H5MM_xfree(cache_ptr->log_info);
     }
 
+    /* Discard the index of a lazily loaded cache image */
+    if (cache_ptr->image_index != NULL)
+        if (H5C__free_image_index(cache_ptr) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTFREE, FAIL, "can't free cache image index")
+
+    /* Write the metadata access trace, if one is being recorded */
+    if (cache_ptr->trace_location != NULL)
+        if (H5C__access_trace_tear_down(f) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_WRITEERROR, FAIL, "can't tear down metadata access trace")
+
+    HDassert(cache_ptr->index_len == 0);
+    cache_ptr->index     = (H5C_cache_entry_t **)H5MM_xfree(cache_ptr->index);
+    cache_ptr->old_index = (H5C_cache_entry_t **)H5MM_xfree(cache_ptr->old_index);
+
 #ifndef NDEBUG
 #if H5C_DO_SANITY_CHECKS
 
@@ -1392,6 +1494,10 @@ H5C_insert_entry(H5F_t *f, const H5C_class_t *type, haddr_t addr, void *thing, u
         HGOTO_ERROR(H5E_CACHE, H5E_CANTGETSIZE, FAIL, "can't get size of thing")
     HDassert(entry_ptr->size > 0 && entry_ptr->size < H5C_MAX_ENTRY_SIZE);
 
+    /* Any image read ahead for the entry's range is out of date */
+    if (cache_ptr->ra_head)
+        H5C__discard_read_ahead(cache_ptr, addr, entry_ptr->size, FALSE);
+
     entry_ptr->in_slist = FALSE;
 
 #ifdef H5_HAVE_PARALLEL
@@ -1430,6 +1536,12 @@ H5C_insert_entry(H5F_t *f, const H5C_class_t *type, haddr_t addr, void *thing, u
     entry_ptr->coll_prev = NULL;
 #endif /* H5_HAVE_PARALLEL */
 
+    entry_ptr->rp_hot      = FALSE;
+    entry_ptr->rp_load_seq = cache_ptr->rp_load_count++;
+
+    entry_ptr->shared_ref_count = 0;
+    entry_ptr->shared_retired   = FALSE;
+
     /* initialize cache image related fields */
     entry_ptr->include_in_image     = FALSE;
     entry_ptr->lru_rank             = 0;
@@ -1902,6 +2014,12 @@ H5C_move_entry(H5C_t *cache_ptr, const H5C_class_t *type, haddr_t old_addr, hadd
     if (entry_ptr->is_read_only)
         HGOTO_ERROR(H5E_CACHE, H5E_CANTMOVE, FAIL, "can't move R/O entry")
 
+    /* Threads reading the entry without the library's lock don't expect
+     * it to move.  It stays out of their reach afterwards.
+     */
+    if (!H5C__retire_shared_entry(cache_ptr, entry_ptr, TRUE))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTMOVE, FAIL, "can't move entry in use by shared readers")
+
     H5C__SEARCH_INDEX(cache_ptr, new_addr, test_entry_ptr, FAIL)
 
     if (test_entry_ptr != NULL) { /* we are hosed */
@@ -1937,6 +2055,10 @@ H5C_move_entry(H5C_t *cache_ptr, const H5C_class_t *type, haddr_t old_addr, hadd
 
     entry_ptr->addr = new_addr;
 
+    /* Any image read ahead for the entry's new range is out of date */
+    if (cache_ptr->ra_head)
+        H5C__discard_read_ahead(cache_ptr, new_addr, entry_ptr->size, FALSE);
+
     if (!entry_ptr->destroy_in_progress) {
         hbool_t was_dirty; /* Whether the entry was previously dirty */
 
@@ -2195,6 +2317,163 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C_pin_protected_entry() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5C_prefetch_entries
+ *
+ * Purpose:     Read the images of entries that are about to be protected
+ *              ahead of time, so that H5C__load_entry() can copy them
+ *              instead of reading each one from the file.
+ *
+ *              Entries that are already in the cache or read ahead, and
+ *              entries of classes that skip reads, are passed over.  The
+ *              remaining images are trimmed to the EOA, sorted by memory
+ *              type and address, and read with one vector read per memory
+ *              type, which lets the file driver combine adjacent images
+ *              into a single I/O request.  At most H5C__READ_AHEAD_MAX_SIZE
+ *              bytes are read.
+ *
+ *              This is only a hint, and nothing is read when the file
+ *              driver has no vector I/O, for SWMR readers, which may have
+ *              to read an entry several times before its checksum is
+ *              correct, or when the file is accessed through MPI.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_prefetch_entries(H5F_t *f, size_t count, const H5C_prefetch_req_t reqs[])
+{
+    H5C_t *            cache_ptr;           /* Pointer to the cache */
+    H5C_read_ahead_t **ras       = NULL;    /* Images to read */
+    haddr_t *          addrs     = NULL;    /* Addresses of the images */
+    size_t *           sizes     = NULL;    /* Lengths of the images */
+    void **            bufs      = NULL;    /* Buffers for the images */
+    size_t             nreads    = 0;       /* Number of images to read */
+    size_t             total_len = 0;       /* Total length of the images to read */
+    size_t             u, v;                /* Local index variables */
+    herr_t             ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(count == 0 || reqs);
+
+    if (0 == count || !H5F_shared_has_vector_io(f->shared) || (H5F_INTENT(f) & H5F_ACC_SWMR_READ))
+        HGOTO_DONE(SUCCEED)
+#ifdef H5_HAVE_PARALLEL
+    if (H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+        HGOTO_DONE(SUCCEED)
+#endif /* H5_HAVE_PARALLEL */
+
+    if (NULL == (ras = (H5C_read_ahead_t **)H5MM_calloc(count * sizeof(H5C_read_ahead_t *))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for read-ahead images")
+
+    /* Choose the images to read */
+    for (u = 0; u < count; u++) {
+        const H5C_prefetch_req_t *req = &reqs[u];
+        H5C_cache_entry_t *       entry_ptr;
+        H5FD_mem_t                mem_type;
+        haddr_t                   eoa;
+        size_t                    len = req->len;
+
+        HDassert(req->type);
+
+        if (!H5F_addr_defined(req->addr) || 0 == len || (req->type->flags & H5C__CLASS_SKIP_READS))
+            continue;
+
+        H5C__SEARCH_INDEX(cache_ptr, req->addr, entry_ptr, FAIL)
+        if (entry_ptr || H5C__find_read_ahead(cache_ptr, req->addr))
+            continue;
+
+        /* Entries in a lazily loaded cache image are read from the image */
+        if (cache_ptr->image_index && H5C__find_image_index_entry(cache_ptr, req->addr))
+            continue;
+
+        /* Trim the image to the EOA, treating global heap collections as raw data */
+        mem_type = (req->type->mem_type == H5FD_MEM_GHEAP) ? H5FD_MEM_DRAW : req->type->mem_type;
+        if (!H5F_addr_defined(eoa = H5F_get_eoa(f, mem_type)))
+            HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "invalid EOA address for file")
+        if (H5F_addr_ge(req->addr, eoa))
+            continue;
+        if (H5F_addr_gt(req->addr + len, eoa))
+            len = (size_t)(eoa - req->addr);
+
+        if ((total_len + len) > H5C__READ_AHEAD_MAX_SIZE)
+            break;
+
+        if (NULL == (ras[nreads] = H5FL_MALLOC(H5C_read_ahead_t)))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for read-ahead image")
+        ras[nreads]->addr = req->addr;
+        ras[nreads]->len  = len;
+        ras[nreads]->type = mem_type;
+        ras[nreads]->next = NULL;
+        if (NULL == (ras[nreads++]->image = (uint8_t *)H5MM_malloc(len)))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for read-ahead image")
+
+        total_len += len;
+    } /* end for */
+
+    if (0 == nreads)
+        HGOTO_DONE(SUCCEED)
+
+    /* Allocate the vectors */
+    if (NULL == (addrs = (haddr_t *)H5MM_malloc(nreads * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for address vector")
+    if (NULL == (sizes = (size_t *)H5MM_malloc(nreads * sizeof(size_t))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for size vector")
+    if (NULL == (bufs = (void **)H5MM_malloc(nreads * sizeof(void *))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for buffer vector")
+
+    /* Images queued by a flush in progress must reach the file before it's read */
+    if (cache_ptr->write_batch.nwrites > 0)
+        if (H5C__write_batch(f) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_WRITEERROR, FAIL, "can't write batch of entries")
+
+    HDqsort(ras, nreads, sizeof(H5C_read_ahead_t *), H5C__read_ahead_cmp);
+    for (u = 0; u < nreads; u++) {
+        addrs[u] = ras[u]->addr;
+        sizes[u] = ras[u]->len;
+        bufs[u]  = ras[u]->image;
+    } /* end for */
+
+    /* Read the images of each memory type */
+    for (u = 0; u < nreads; u = v) {
+        for (v = u + 1; v < nreads && ras[v]->type == ras[u]->type; v++)
+            ;
+        if (H5F_shared_block_read_vector(f->shared, ras[u]->type, v - u, &addrs[u], &sizes[u], &bufs[u]) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "can't read ahead entry images")
+    } /* end for */
+
+    /* Append the images to the cache's list */
+    for (u = 0; u < nreads; u++) {
+        H5C__add_read_ahead(cache_ptr, ras[u]);
+        ras[u] = NULL;
+    } /* end for */
+
+    H5C__UPDATE_STATS_FOR_READ_AHEAD(cache_ptr, nreads)
+
+done:
+    /* Release the images not added to the list */
+    if (ras) {
+        for (u = 0; u < nreads; u++)
+            if (ras[u]) {
+                H5MM_xfree(ras[u]->image);
+                ras[u] = H5FL_FREE(H5C_read_ahead_t, ras[u]);
+            } /* end if */
+        H5MM_xfree(ras);
+    } /* end if */
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_prefetch_entries() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5C_protect
  *
@@ -2371,6 +2650,9 @@ H5C_protect(H5F_t *f, const H5C_class_t *type, haddr_t addr, void *udata, unsign
         }
 #endif
 
+        /* A hit may promote the entry to the hot set of the 2Q policy */
+        H5C__2Q_UPDATE_FOR_HIT(cache_ptr, entry_ptr)
+
         hit   = TRUE;
         thing = (void *)entry_ptr;
     }
@@ -2389,6 +2671,12 @@ H5C_protect(H5F_t *f, const H5C_class_t *type, haddr_t addr, void *udata, unsign
 
         entry_ptr = (H5C_cache_entry_t *)thing;
         cache_ptr->entries_loaded_counter++;
+        entry_ptr->rp_load_seq = cache_ptr->rp_load_count++;
+
+        /* If currently logging, record the load, which makes this protect a miss */
+        if (cache_ptr->log_info->logging)
+            if (H5C_log_write_load_entry_msg(cache_ptr, entry_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, NULL, "unable to emit log message")
 
         entry_ptr->ring = ring;
 #ifdef H5_HAVE_PARALLEL
@@ -2900,6 +3188,46 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C_set_evictions_enabled() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5C_set_repl_policy()
+ *
+ * Purpose:     Select the replacement policy used to choose entries for
+ *              eviction.
+ *
+ *              When switching back to the LRU policy, all entries are
+ *              made cold so that a later switch to the 2Q policy starts
+ *              with an empty hot set.
+ *
+ * Return:      SUCCEED on success, and FAIL on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_set_repl_policy(H5C_t *cache_ptr, enum H5C_cache_repl_policy repl_policy)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if ((cache_ptr == NULL) || (cache_ptr->magic != H5C__H5C_T_MAGIC))
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad cache_ptr on entry")
+    if ((repl_policy != H5C_repl__lru) && (repl_policy != H5C_repl__2q))
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Unknown replacement policy")
+
+    if (repl_policy == H5C_repl__lru && cache_ptr->rp_hot_size > 0) {
+        H5C_cache_entry_t *entry_ptr;
+
+        for (entry_ptr = cache_ptr->il_head; entry_ptr != NULL; entry_ptr = entry_ptr->il_next)
+            entry_ptr->rp_hot = FALSE;
+        cache_ptr->rp_hot_size = 0;
+    } /* end if */
+
+    cache_ptr->repl_policy = repl_policy;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_set_repl_policy() */
+
 /*-------------------------------------------------------------------------
  *
  * Function:    H5C_set_slist_enabled()
@@ -4839,6 +5167,9 @@ H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t *f, hbool_t write_permitte
                         restart_scan = TRUE;
                 } /* end else */
             }     /* end if */
+            else if (!entry_ptr->prefetched_dirty && !H5C__retire_shared_entry(cache_ptr, entry_ptr, FALSE))
+                /* Skip entries that threads are reading */
+                skipping_entry = TRUE;
             else if (!entry_ptr->prefetched_dirty) {
 
                 bytes_evicted += entry_ptr->size;
@@ -4912,7 +5243,8 @@ H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t *f, hbool_t write_permitte
 
             prev_ptr = entry_ptr->prev;
 
-            if (!(entry_ptr->is_dirty) && !(entry_ptr->prefetched_dirty))
+            if (!(entry_ptr->is_dirty) && !(entry_ptr->prefetched_dirty) &&
+                H5C__retire_shared_entry(cache_ptr, entry_ptr, FALSE))
                 if (H5C__flush_single_entry(
                         f, entry_ptr, H5C__FLUSH_INVALIDATE_FLAG | H5C__DEL_FROM_SLIST_ON_DESTROY_FLAG) < 0)
                     HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "unable to flush clean entry")
@@ -5416,6 +5748,10 @@ H5C__flush_invalidate_cache(H5F_t *f, unsigned flags)
             HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "error removing all epoch markers")
     }
 
+    /* discard the images read ahead for entries that were never loaded */
+    if (cache_ptr->ra_head)
+        H5C__discard_read_ahead(cache_ptr, HADDR_UNDEF, 0, FALSE);
+
     /* flush invalidate each ring, starting from the outermost ring and
      * working inward.
      */
@@ -6022,6 +6358,430 @@ done:
 
 } /* H5C__flush_invalidate_ring() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5C__batch_write_cmp
+ *
+ * Purpose:     Compare two writes in a batch by memory type, then by
+ *              address, then by the order in which they were queued, for
+ *              HDqsort().
+ *
+ * Return:      -1, 0 or 1 if the first write sorts before, equal to or
+ *              after the second one.
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5C__batch_write_cmp(const void *_w1, const void *_w2)
+{
+    const H5C_batch_write_t *w1 = (const H5C_batch_write_t *)_w1;
+    const H5C_batch_write_t *w2 = (const H5C_batch_write_t *)_w2;
+
+    if (w1->type != w2->type)
+        return (w1->type < w2->type) ? -1 : 1;
+    if (H5F_addr_ne(w1->addr, w2->addr))
+        return H5F_addr_lt(w1->addr, w2->addr) ? -1 : 1;
+    if (w1->seq != w2->seq)
+        return (w1->seq < w2->seq) ? -1 : 1;
+
+    return 0;
+} /* H5C__batch_write_cmp() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__batch_write_seq_cmp
+ *
+ * Purpose:     Compare two writes in a batch by the order in which they
+ *              were queued, for HDqsort().
+ *
+ * Return:      -1, 0 or 1 if the first write was queued before, with or
+ *              after the second one.
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5C__batch_write_seq_cmp(const void *_w1, const void *_w2)
+{
+    const H5C_batch_write_t *w1 = (const H5C_batch_write_t *)_w1;
+    const H5C_batch_write_t *w2 = (const H5C_batch_write_t *)_w2;
+
+    if (w1->seq != w2->seq)
+        return (w1->seq < w2->seq) ? -1 : 1;
+
+    return 0;
+} /* H5C__batch_write_seq_cmp() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__queue_entry_write
+ *
+ * Purpose:     Queue a copy of the image of a flushed entry in the cache's
+ *              batch of writes, writing the batch first if the image
+ *              doesn't fit in it.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__queue_entry_write(H5F_t *f, H5FD_mem_t mem_type, haddr_t addr, size_t size, const void *image)
+{
+    H5C_write_batch_t *batch     = &f->shared->cache->write_batch; /* Batch of writes */
+    H5C_batch_write_t *queued;                                     /* Write queued */
+    herr_t             ret_value = SUCCEED;                        /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(batch->active);
+    HDassert(H5F_addr_defined(addr));
+    HDassert(size > 0);
+    HDassert(image);
+
+    /* Write out the batch when it's full */
+    if (batch->nwrites > 0 && (batch->buf_used + size) > H5C__WRITE_BATCH_MAX_SIZE)
+        if (H5C__write_batch(f) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_WRITEERROR, FAIL, "can't write batch of entries")
+
+    /* Make room for the write and the image */
+    if (batch->nwrites == batch->nalloc) {
+        size_t             new_nalloc = MAX(H5C__WRITE_BATCH_INIT_NWRITES, 2 * batch->nalloc);
+        H5C_batch_write_t *new_writes;
+
+        if (NULL == (new_writes = (H5C_batch_write_t *)H5MM_realloc(
+                         batch->writes, new_nalloc * sizeof(H5C_batch_write_t))))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for batch of writes")
+        batch->writes = new_writes;
+        batch->nalloc = new_nalloc;
+    } /* end if */
+    if ((batch->buf_used + size) > batch->buf_size) {
+        size_t   new_size = MAX(batch->buf_used + size, 2 * batch->buf_size);
+        uint8_t *new_buf;
+
+        if (NULL == (new_buf = (uint8_t *)H5MM_realloc(batch->buf, new_size)))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for batch of writes")
+        batch->buf      = new_buf;
+        batch->buf_size = new_size;
+    } /* end if */
+
+    /* Queue a copy of the image, treating global heap collections as raw data */
+    queued         = &batch->writes[batch->nwrites];
+    queued->addr   = addr;
+    queued->size   = size;
+    queued->offset = batch->buf_used;
+    queued->seq    = batch->nwrites;
+    queued->type   = (mem_type == H5FD_MEM_GHEAP) ? H5FD_MEM_DRAW : mem_type;
+    H5MM_memcpy(batch->buf + batch->buf_used, image, size);
+
+    batch->nwrites++;
+    batch->buf_used += size;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__queue_entry_write() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__write_batch
+ *
+ * Purpose:     Write the images queued in the cache's batch of writes to
+ *              the file and empty the batch.
+ *
+ *              The images are sorted by memory type and address, and
+ *              images that are adjacent or overlap in the file are
+ *              combined into one buffer, copying them in the order they
+ *              were queued so that the latest image of a range wins.  The
+ *              combined images of each memory type are written with a
+ *              single vector write.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__write_batch(H5F_t *f)
+{
+    H5C_write_batch_t *batch        = &f->shared->cache->write_batch; /* Batch of writes */
+    haddr_t *          addrs        = NULL;                           /* Addresses of combined images */
+    size_t *           sizes        = NULL;                           /* Sizes of combined images */
+    const void **      bufs         = NULL;                           /* Buffers of combined images */
+    H5FD_mem_t *       types        = NULL;                           /* Memory types of combined images */
+    uint8_t *          run_buf      = NULL;                           /* Buffer for combined images */
+    size_t             run_buf_used = 0;                              /* Number of bytes used in run_buf */
+    size_t             nruns        = 0;                              /* Number of combined images */
+    size_t             u, v, w;                                       /* Local index variables */
+    herr_t             ret_value    = SUCCEED;                        /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if (0 == batch->nwrites)
+        HGOTO_DONE(SUCCEED)
+
+    /* Allocate the vectors, for the worst case where no images are combined */
+    if (NULL == (addrs = (haddr_t *)H5MM_malloc(batch->nwrites * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for address vector")
+    if (NULL == (sizes = (size_t *)H5MM_malloc(batch->nwrites * sizeof(size_t))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for size vector")
+    if (NULL == (bufs = (const void **)H5MM_malloc(batch->nwrites * sizeof(void *))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for buffer vector")
+    if (NULL == (types = (H5FD_mem_t *)H5MM_malloc(batch->nwrites * sizeof(H5FD_mem_t))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for type vector")
+
+    HDqsort(batch->writes, batch->nwrites, sizeof(H5C_batch_write_t), H5C__batch_write_cmp);
+
+    /* Combine images that are adjacent or overlap in the file */
+    for (u = 0; u < batch->nwrites; u = v) {
+        const H5C_batch_write_t *first   = &batch->writes[u];
+        haddr_t                  run_end = first->addr + first->size;
+
+        for (v = u + 1; v < batch->nwrites && batch->writes[v].type == first->type &&
+                        H5F_addr_le(batch->writes[v].addr, run_end);
+             v++)
+            if (H5F_addr_gt(batch->writes[v].addr + batch->writes[v].size, run_end))
+                run_end = batch->writes[v].addr + batch->writes[v].size;
+
+        addrs[nruns] = first->addr;
+        sizes[nruns] = (size_t)(run_end - first->addr);
+        types[nruns] = first->type;
+        if (v - u == 1)
+            bufs[nruns] = batch->buf + first->offset;
+        else {
+            haddr_t run_addr = first->addr;
+
+            if (NULL == run_buf && NULL == (run_buf = (uint8_t *)H5MM_malloc(batch->buf_used)))
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for combined images")
+
+            /* Copy the images in the order they were queued */
+            HDqsort(&batch->writes[u], v - u, sizeof(H5C_batch_write_t), H5C__batch_write_seq_cmp);
+            for (w = u; w < v; w++)
+                H5MM_memcpy(run_buf + run_buf_used + (batch->writes[w].addr - run_addr),
+                            batch->buf + batch->writes[w].offset, batch->writes[w].size);
+
+            bufs[nruns] = run_buf + run_buf_used;
+            run_buf_used += sizes[nruns];
+        } /* end else */
+        nruns++;
+    } /* end for */
+
+    /* Write the combined images of each memory type */
+    for (u = 0; u < nruns; u = v) {
+        for (v = u + 1; v < nruns && types[v] == types[u]; v++)
+            ;
+        if (H5F_shared_block_write_vector(f->shared, types[u], v - u, &addrs[u], &sizes[u], &bufs[u]) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_WRITEERROR, FAIL, "can't write images to file")
+    } /* end for */
+
+done:
+    /* Empty the batch, even when writing it failed */
+    batch->nwrites  = 0;
+    batch->buf_used = 0;
+
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+    H5MM_xfree(types);
+    H5MM_xfree(run_buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__write_batch() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__end_write_batch
+ *
+ * Purpose:     Stop queueing the images of flushed entries, write the
+ *              images queued to the file and release the batch's buffers.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__end_write_batch(H5F_t *f)
+{
+    H5C_write_batch_t *batch     = &f->shared->cache->write_batch; /* Batch of writes */
+    herr_t             ret_value = SUCCEED;                        /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    batch->active = FALSE;
+
+    if (H5C__write_batch(f) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_WRITEERROR, FAIL, "can't write batch of entries")
+
+done:
+    batch->writes   = (H5C_batch_write_t *)H5MM_xfree(batch->writes);
+    batch->nalloc   = 0;
+    batch->buf      = (uint8_t *)H5MM_xfree(batch->buf);
+    batch->buf_size = 0;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__end_write_batch() */
+
+#ifdef H5_HAVE_CONV_THREADS
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C__serialize_job_entry
+ *
+ * Purpose:     Call the serialize callback of one of the entries of a
+ *              job, on whichever thread of the pool picked it up.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__serialize_job_entry(void *op_data, size_t block)
+{
+    const H5C_serialize_job_t *job       = (const H5C_serialize_job_t *)op_data; /* Job */
+    H5C_cache_entry_t *        entry_ptr = job->entries[block];                 /* Entry to serialize */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    job->status[block] = entry_ptr->type->serialize(job->f, entry_ptr->image_ptr, entry_ptr->size, entry_ptr);
+
+    FUNC_LEAVE_NOAPI(job->status[block])
+} /* H5C__serialize_job_entry() */
+
+/*-------------------------------------------------------------------------
+ *
+ * Function:    H5C__serialize_ready_entries
+ *
+ * Purpose:     Generate the images of the entries that the current pass
+ *              of H5C__flush_ring() will write, on the worker threads.
+ *
+ *              An entry is serialized here when it is in the ring being
+ *              flushed, would be flushed on this pass (it isn't protected
+ *              or a "flush me last" entry, and its flush dependency
+ *              children are all clean) and its class allows its serialize
+ *              callback to run concurrently with others.  Such classes
+ *              have no pre_serialize callback, so the entries can't be
+ *              resized or moved, and the cache's data structures are only
+ *              touched here on the calling thread: before the job, to
+ *              allocate the image buffers, and after it, to mark the
+ *              images up to date and notify the flush dependency parents.
+ *
+ *              The pass then writes these entries without serializing
+ *              them again.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__serialize_ready_entries(H5F_t *f, H5C_ring_t ring, unsigned flags)
+{
+    H5C_t *             cache_ptr = f->shared->cache; /* Cache */
+    hbool_t             flush_marked_entries;         /* Whether only marked entries are flushed */
+    H5C_serialize_job_t job;                          /* Job for the worker threads */
+    H5SL_node_t *       node_ptr;                     /* Node of the skip list */
+    size_t              nentries   = 0;               /* # of entries to serialize */
+    size_t              nalloc     = 0;               /* # of entries allocated in the job */
+    herr_t              run_status = SUCCEED;         /* Result of the job */
+    size_t              u;                            /* Local index variable */
+    herr_t              ret_value = SUCCEED;          /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(cache_ptr->slist_enabled);
+    HDassert(f->shared->mdc_serialize_threads > 1);
+
+    flush_marked_entries = ((flags & H5C__FLUSH_MARKED_ENTRIES_FLAG) != 0);
+
+    HDmemset(&job, 0, sizeof(job));
+    job.f = f;
+
+#ifdef H5_HAVE_PARALLEL
+    /* The parallel cache decides which entries to flush itself */
+    if (cache_ptr->aux_ptr)
+        HGOTO_DONE(SUCCEED)
+#endif /* H5_HAVE_PARALLEL */
+
+    /* Collect the entries that are ready to be serialized */
+    for (node_ptr = H5SL_first(cache_ptr->slist_ptr); node_ptr != NULL; node_ptr = H5SL_next(node_ptr)) {
+        H5C_cache_entry_t *entry_ptr = (H5C_cache_entry_t *)H5SL_item(node_ptr);
+
+        HDassert(entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
+        HDassert(entry_ptr->is_dirty);
+
+        if ((entry_ptr->ring == ring) && (!flush_marked_entries || entry_ptr->flush_marker) &&
+            !entry_ptr->flush_me_last && (entry_ptr->flush_dep_ndirty_children == 0) &&
+            !entry_ptr->is_protected && !entry_ptr->image_up_to_date && !entry_ptr->prefetched &&
+            (entry_ptr->type->flags & H5C__CLASS_PARALLEL_SERIALIZE_FLAG) &&
+            (NULL == entry_ptr->type->pre_serialize)) {
+            HDassert(entry_ptr->flush_dep_nunser_children == 0);
+            HDassert(!entry_ptr->flush_in_progress);
+
+            if (nentries == nalloc) {
+                H5C_cache_entry_ptr_t *entries; /* Resized array of entries */
+
+                nalloc = MAX(2 * nalloc, H5C_PARALLEL_SERIALIZE_MIN_ENTRIES);
+                if (NULL == (entries = (H5C_cache_entry_ptr_t *)H5MM_realloc(
+                                 job.entries, nalloc * sizeof(H5C_cache_entry_ptr_t))))
+                    HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "can't allocate entries to serialize")
+                job.entries = entries;
+            } /* end if */
+            job.entries[nentries++] = entry_ptr;
+        } /* end if */
+    }     /* end for */
+
+    /* Leave the few entries of small flushes to the calling thread */
+    if (nentries < H5C_PARALLEL_SERIALIZE_MIN_ENTRIES)
+        HGOTO_DONE(SUCCEED)
+
+    /* Allocate the image buffers */
+    if (NULL == (job.status = (herr_t *)H5MM_malloc(nentries * sizeof(herr_t))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "can't allocate serialize results")
+    for (u = 0; u < nentries; u++) {
+        H5C_cache_entry_t *entry_ptr = job.entries[u];
+
+        if (NULL == entry_ptr->image_ptr) {
+            HDassert(entry_ptr->size > 0);
+            if (NULL == (entry_ptr->image_ptr = H5MM_malloc(entry_ptr->size + H5C_IMAGE_EXTRA_SPACE)))
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL,
+                            "memory allocation failed for on disk image buffer")
+#if H5C_DO_MEMORY_SANITY_CHECKS
+            H5MM_memcpy(((uint8_t *)entry_ptr->image_ptr) + entry_ptr->size, H5C_IMAGE_SANITY_VALUE,
+                        H5C_IMAGE_EXTRA_SPACE);
+#endif /* H5C_DO_MEMORY_SANITY_CHECKS */
+        } /* end if */
+    }     /* end for */
+
+    /* Serialize the entries on the worker threads */
+    run_status = H5T_pool_run(f->shared->mdc_serialize_threads, nentries, H5C__serialize_job_entry, &job);
+
+    /* Mark the images that were generated up to date, and propagate that up
+     * the flush dependency chains.
+     */
+    for (u = 0; u < nentries; u++) {
+        H5C_cache_entry_t *entry_ptr = job.entries[u];
+
+        if (job.status[u] < 0)
+            continue;
+
+#if H5C_DO_MEMORY_SANITY_CHECKS
+        HDassert(0 == HDmemcmp(((uint8_t *)entry_ptr->image_ptr) + entry_ptr->size, H5C_IMAGE_SANITY_VALUE,
+                               H5C_IMAGE_EXTRA_SPACE));
+#endif /* H5C_DO_MEMORY_SANITY_CHECKS */
+
+        entry_ptr->image_up_to_date = TRUE;
+
+        if (entry_ptr->flush_dep_nparents > 0)
+            if (H5C__mark_flush_dep_serialized(entry_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTNOTIFY, FAIL,
+                            "Can't propagate serialization status to fd parents")
+    } /* end for */
+
+    if (run_status < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTSERIALIZE, FAIL, "unable to serialize entries")
+
+done:
+    H5MM_xfree(job.entries);
+    H5MM_xfree(job.status);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__serialize_ready_entries() */
+
+#endif /* H5_HAVE_CONV_THREADS */
+
 /*-------------------------------------------------------------------------
  *
  * Function:    H5C__flush_ring
@@ -6122,6 +6882,22 @@ H5C__flush_ring(H5F_t *f, H5C_ring_t ring, unsigned flags)
      */
     cache_ptr->slist_changed = FALSE;
 
+    /* Queue the images of the entries flushed, so they are written in
+     * address order with as few writes as possible once the ring has been
+     * flushed.  This isn't needed when the metadata accumulator already
+     * combines the writes.  SWMR writers must write entries in flush
+     * dependency order, and the page buffer and the parallel cache handle
+     * writes themselves.
+     */
+    HDassert(!cache_ptr->write_batch.active);
+    cache_ptr->write_batch.active = (0 == H5F_HAS_FEATURE(f, H5FD_FEAT_ACCUMULATE_METADATA)) &&
+                                    (NULL == f->shared->page_buf) &&
+                                    (0 == (H5F_INTENT(f) & H5F_ACC_SWMR_WRITE));
+#ifdef H5_HAVE_PARALLEL
+    if (cache_ptr->aux_ptr)
+        cache_ptr->write_batch.active = FALSE;
+#endif /* H5_HAVE_PARALLEL */
+
     while ((cache_ptr->slist_ring_len[ring] > 0) && (protected_entries == 0) && (flushed_entries_last_pass)) {
 
         flushed_entries_last_pass = FALSE;
@@ -6165,6 +6941,14 @@ H5C__flush_ring(H5F_t *f, H5C_ring_t ring, unsigned flags)
          */
 #endif /* H5C_DO_SANITY_CHECKS */
 
+#ifdef H5_HAVE_CONV_THREADS
+        /* Serialize the entries this pass will write on the worker threads,
+         * when there are any
+         */
+        if (f->shared->mdc_serialize_threads > 1 && H5C__serialize_ready_entries(f, ring, flags) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTSERIALIZE, FAIL, "can't serialize entries")
+#endif /* H5_HAVE_CONV_THREADS */
+
         restart_slist_scan = TRUE;
 
         while ((restart_slist_scan) || (node_ptr != NULL)) {
@@ -6325,6 +7109,8 @@ H5C__flush_ring(H5F_t *f, H5C_ring_t ring, unsigned flags)
 #endif /* H5C_DO_SANITY_CHECKS */
 
 done:
+    if (cache_ptr->write_batch.active && H5C__end_write_batch(f) < 0)
+        HDONE_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't write batch of entries")
 
     FUNC_LEAVE_NOAPI(ret_value)
 
@@ -6473,6 +7259,12 @@ H5C__flush_single_entry(H5F_t *f, H5C_cache_entry_t *entry_ptr, unsigned flags)
         destroy_entry = destroy;
     }
 
+    /* Entries held by threads reading them without the library's lock
+     * can't leave the cache
+     */
+    if (destroy && !H5C__retire_shared_entry(cache_ptr, entry_ptr, TRUE))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "can't evict entry in use by shared readers")
+
     /* we will write the entry to disk if it exists, is dirty, and if the
      * clear only flag is not set.
      */
@@ -6652,7 +7444,19 @@ H5C__flush_single_entry(H5F_t *f, H5C_cache_entry_t *entry_ptr, unsigned flags)
                     mem_type = entry_ptr->type->mem_type;
                 }
 
-                if (H5F_block_write(f, mem_type, entry_ptr->addr, entry_ptr->size, entry_ptr->image_ptr) < 0)
+                /* An image read ahead for this range is out of date now */
+                if (cache_ptr->ra_head)
+                    H5C__discard_read_ahead(cache_ptr, entry_ptr->addr, entry_ptr->size, FALSE);
+
+                if (cache_ptr->write_batch.active) {
+
+                    if (H5C__queue_entry_write(f, mem_type, entry_ptr->addr, entry_ptr->size,
+                                               entry_ptr->image_ptr) < 0)
+
+                        HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't queue image for writing")
+                }
+                else if (H5F_block_write(f, mem_type, entry_ptr->addr, entry_ptr->size,
+                                         entry_ptr->image_ptr) < 0)
 
                     HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "Can't write image to file")
 
@@ -6697,6 +7501,10 @@ H5C__flush_single_entry(H5F_t *f, H5C_cache_entry_t *entry_ptr, unsigned flags)
         /* only log a flush if we actually wrote to disk */
         H5C__UPDATE_STATS_FOR_FLUSH(cache_ptr, entry_ptr)
 
+        if (cache_ptr->log_info->logging)
+            if (H5C_log_write_flush_entry_msg(cache_ptr, entry_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
     } /* end else if */
 
     /* Note that the algorithm below is (very) similar to the set of operations
@@ -6722,6 +7530,10 @@ H5C__flush_single_entry(H5F_t *f, H5C_cache_entry_t *entry_ptr, unsigned flags)
         /* Update stats, while entry is still in the cache */
         H5C__UPDATE_STATS_FOR_EVICTION(cache_ptr, entry_ptr, take_ownership)
 
+        if (cache_ptr->log_info->logging)
+            if (H5C_log_write_evict_entry_msg(cache_ptr, entry_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
         /* If the entry's type has a 'notify' callback and the entry is about
          * to be removed from the cache, send a 'before eviction' notice while
          * the entry is still fully integrated in the cache.
@@ -6749,6 +7561,10 @@ H5C__flush_single_entry(H5F_t *f, H5C_cache_entry_t *entry_ptr, unsigned flags)
          */
         H5C__DELETE_FROM_INDEX(cache_ptr, entry_ptr, FAIL)
 
+        /* Wait for threads that may still be looking at the entry */
+        if (cache_ptr->shared_reads)
+            H5C__shared_synchronize(cache_ptr);
+
         if ((entry_ptr->in_slist) && (del_from_slist_on_destroy)) {
 
             H5C__REMOVE_ENTRY_FROM_SLIST(cache_ptr, entry_ptr, during_flush)
@@ -7096,6 +7912,265 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__verify_len_eoa() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5C__read_ahead_cmp
+ *
+ * Purpose:     Compare two images to read ahead by memory type, then by
+ *              address, for HDqsort().
+ *
+ * Return:      -1, 0 or 1 if the first image sorts before, equal to or
+ *              after the second one.
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5C__read_ahead_cmp(const void *_ra1, const void *_ra2)
+{
+    const H5C_read_ahead_t *ra1 = *(const H5C_read_ahead_t *const *)_ra1;
+    const H5C_read_ahead_t *ra2 = *(const H5C_read_ahead_t *const *)_ra2;
+
+    if (ra1->type != ra2->type)
+        return (ra1->type < ra2->type) ? -1 : 1;
+    if (H5F_addr_ne(ra1->addr, ra2->addr))
+        return H5F_addr_lt(ra1->addr, ra2->addr) ? -1 : 1;
+
+    return 0;
+} /* H5C__read_ahead_cmp() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__find_read_ahead
+ *
+ * Purpose:     Look for an image read ahead that holds the byte of the
+ *              file at ADDR.
+ *
+ * Return:      Pointer to the image, or NULL if there's none
+ *
+ *-------------------------------------------------------------------------
+ */
+static const H5C_read_ahead_t *
+H5C__find_read_ahead(const H5C_t *cache_ptr, haddr_t addr)
+{
+    const H5C_read_ahead_t *ra;               /* Image being checked */
+    const H5C_read_ahead_t *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for (ra = cache_ptr->ra_head; ra; ra = ra->next)
+        if (H5F_addr_le(ra->addr, addr) && H5F_addr_lt(addr, ra->addr + ra->len)) {
+            ret_value = ra;
+            break;
+        } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__find_read_ahead() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__discard_read_ahead
+ *
+ * Purpose:     Discard the images read ahead by H5C_prefetch_entries()
+ *              that overlap the LEN bytes of the file at ADDR, or all of
+ *              them if LEN is zero.
+ *
+ *              If WITHIN is TRUE, only the images that lie entirely
+ *              within those bytes are discarded.  This is used once an
+ *              entry has been loaded, and keeps an image that spans
+ *              several entries for the others.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5C__discard_read_ahead(H5C_t *cache_ptr, haddr_t addr, size_t len, hbool_t within)
+{
+    H5C_read_ahead_t **ra_ptr = &cache_ptr->ra_head; /* Link to the image being checked */
+    H5C_read_ahead_t * prev   = NULL;                /* Image before the one being checked */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    while (*ra_ptr) {
+        H5C_read_ahead_t *ra = *ra_ptr;
+
+        if (0 == len || (within ? (H5F_addr_le(addr, ra->addr) && H5F_addr_le(ra->addr + ra->len, addr + len))
+                                : H5F_addr_overlap(ra->addr, ra->len, addr, len))) {
+            *ra_ptr = ra->next;
+            if (cache_ptr->ra_tail == ra)
+                cache_ptr->ra_tail = prev;
+            HDassert(cache_ptr->ra_size >= ra->len);
+            cache_ptr->ra_size -= ra->len;
+
+            H5MM_xfree(ra->image);
+            ra = H5FL_FREE(H5C_read_ahead_t, ra);
+        } /* end if */
+        else {
+            prev   = ra;
+            ra_ptr = &ra->next;
+        } /* end else */
+    }     /* end while */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5C__discard_read_ahead() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__add_read_ahead
+ *
+ * Purpose:     Append an image read ahead to the cache's list, replacing
+ *              the older images it overlaps, and discard the oldest
+ *              images other than it while the list is full.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5C__add_read_ahead(H5C_t *cache_ptr, H5C_read_ahead_t *ra)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(ra);
+    HDassert(NULL == ra->next);
+
+    if (cache_ptr->ra_head)
+        H5C__discard_read_ahead(cache_ptr, ra->addr, ra->len, FALSE);
+
+    if (cache_ptr->ra_tail)
+        cache_ptr->ra_tail->next = ra;
+    else
+        cache_ptr->ra_head = ra;
+    cache_ptr->ra_tail = ra;
+    cache_ptr->ra_size += ra->len;
+
+    while (cache_ptr->ra_size > H5C__READ_AHEAD_MAX_SIZE && cache_ptr->ra_head != ra) {
+        H5C_read_ahead_t *oldest = cache_ptr->ra_head;
+
+        cache_ptr->ra_head = oldest->next;
+        cache_ptr->ra_size -= oldest->len;
+
+        H5MM_xfree(oldest->image);
+        oldest = H5FL_FREE(H5C_read_ahead_t, oldest);
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5C__add_read_ahead() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__read_ahead_image_index_entry
+ *
+ * Purpose:     If the index of a lazily loaded metadata cache image has
+ *              an entry holding the byte of the file at ADDR, read that
+ *              entry's image from the cache image block and add it to
+ *              the images read ahead.
+ *
+ *              The image in the cache image block supersedes the one in
+ *              the file, which is out of date if the entry was dirty
+ *              when the cache image was written.
+ *
+ * Return:      Non-negative on success/Negative on failure.  *RA_PTR is
+ *              set to the image read ahead, or NULL if there's no entry
+ *              at ADDR in the index.  An image already read ahead from
+ *              the index is reused.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__read_ahead_image_index_entry(H5F_t *f, H5FD_mem_t mem_type, haddr_t addr,
+                                  const H5C_read_ahead_t **ra_ptr)
+{
+    H5C_t *                  cache_ptr = f->shared->cache; /* Pointer to the cache */
+    const H5C_image_entry_t *ie_ptr;                       /* Entry in the index */
+    H5C_read_ahead_t *       ra        = NULL;             /* Image read ahead */
+    herr_t                   ret_value = SUCCEED;          /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(cache_ptr->image_index);
+    HDassert(ra_ptr);
+
+    *ra_ptr = NULL;
+    if (NULL == (ie_ptr = H5C__find_image_index_entry(cache_ptr, addr)))
+        HGOTO_DONE(SUCCEED)
+
+    /* Images read ahead by H5C_prefetch_entries() never start at an entry in the index */
+    if (cache_ptr->ra_head) {
+        const H5C_read_ahead_t *old_ra = H5C__find_read_ahead(cache_ptr, addr);
+
+        if (old_ra && H5F_addr_eq(old_ra->addr, ie_ptr->addr) && old_ra->len == ie_ptr->size) {
+            *ra_ptr = old_ra;
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+    }     /* end if */
+
+    if (NULL == (ra = H5FL_MALLOC(H5C_read_ahead_t)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for read-ahead image")
+    ra->addr = ie_ptr->addr;
+    ra->len  = ie_ptr->size;
+    ra->type = mem_type;
+    ra->next = NULL;
+    if (NULL == (ra->image = (uint8_t *)H5MM_malloc(ra->len)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for read-ahead image")
+
+    if (H5C__read_image_index_entry(f, ie_ptr, ra->image) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "can't read entry image from cache image")
+
+    H5C__UPDATE_STATS_FOR_PREFETCH_HIT(cache_ptr)
+
+    H5C__add_read_ahead(cache_ptr, ra);
+    *ra_ptr = ra;
+    ra      = NULL;
+
+done:
+    if (ra) {
+        H5MM_xfree(ra->image);
+        ra = H5FL_FREE(H5C_read_ahead_t, ra);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__read_ahead_image_index_entry() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__read_image
+ *
+ * Purpose:     Read the LEN bytes of an entry's image at ADDR.  When
+ *              USE_READ_AHEAD is TRUE, copy them from an image read ahead
+ *              by H5C_prefetch_entries() or from a lazily loaded cache
+ *              image as far as one holds them, and read the rest from
+ *              the file.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__read_image(H5F_t *f, H5FD_mem_t mem_type, haddr_t addr, size_t len, void *image, hbool_t use_read_ahead)
+{
+    H5C_t *                 cache_ptr = f->shared->cache; /* Pointer to the cache */
+    const H5C_read_ahead_t *ra        = NULL;             /* Image read ahead */
+    size_t                  ra_len    = 0;                /* # of bytes copied from the image read ahead */
+    herr_t                  ret_value = SUCCEED;          /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if (use_read_ahead) {
+        if (cache_ptr->image_index)
+            if (H5C__read_ahead_image_index_entry(f, mem_type, addr, &ra) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "can't read image from cache image")
+        if (NULL == ra && cache_ptr->ra_head)
+            ra = H5C__find_read_ahead(cache_ptr, addr);
+    } /* end if */
+
+    if (ra) {
+        ra_len = MIN(len, (size_t)((ra->addr + ra->len) - addr));
+        H5MM_memcpy(image, ra->image + (addr - ra->addr), ra_len);
+        H5C__UPDATE_STATS_FOR_READ_AHEAD_HIT(cache_ptr)
+    } /* end if */
+    if (ra_len < len)
+        if (H5F_block_read(f, mem_type, addr + ra_len, len - ra_len, (uint8_t *)image + ra_len) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "can't read image")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__read_image() */
+
 /*-------------------------------------------------------------------------
  *
  * Function:    H5C__load_entry
@@ -7179,6 +8254,11 @@ H5C__load_entry(H5F_t *f,
     } /* end if */
 #endif /* H5_HAVE_PARALLEL */
 
+    /* Images queued by a flush in progress must reach the file before it's read */
+    if (f->shared->cache->write_batch.nwrites > 0)
+        if (H5C__write_batch(f) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_WRITEERROR, NULL, "can't write batch of entries")
+
     /* Get the on-disk entry image */
     if (0 == (type->flags & H5C__CLASS_SKIP_READS)) {
         unsigned tries, max_tries;   /* The # of read attempts               */
@@ -7188,6 +8268,7 @@ H5C__load_entry(H5F_t *f,
         uint64_t nanosec    = 1;     /* # of nanoseconds to sleep between retries */
         void *   new_image;          /* Pointer to image                     */
         hbool_t  len_changed = TRUE; /* Whether to re-check speculative entries */
+        size_t   init_len    = len;  /* The length of the first read */
 
         /* Get the # of read attempts */
         max_tries = tries = H5F_GET_READ_ATTEMPTS(f);
@@ -7212,7 +8293,7 @@ H5C__load_entry(H5F_t *f,
 #ifdef H5_HAVE_PARALLEL
             if (!coll_access || 0 == mpi_rank) {
 #endif /* H5_HAVE_PARALLEL */
-                if (H5F_block_read(f, type->mem_type, addr, len, image) < 0)
+                if (H5C__read_image(f, type->mem_type, addr, len, image, (tries == max_tries)) < 0)
                     HGOTO_ERROR(H5E_CACHE, H5E_READERROR, NULL, "Can't read image*")
 #ifdef H5_HAVE_PARALLEL
             } /* end if */
@@ -7259,8 +8340,8 @@ H5C__load_entry(H5F_t *f,
                             /* If the thing's image needs to be bigger for a speculatively
                              * loaded thing, go get the on-disk image again (the extra portion).
                              */
-                            if (H5F_block_read(f, type->mem_type, addr + len, actual_len - len, image + len) <
-                                0)
+                            if (H5C__read_image(f, type->mem_type, addr + len, actual_len - len, image + len,
+                                                (tries == max_tries)) < 0)
                                 HGOTO_ERROR(H5E_CACHE, H5E_CANTLOAD, NULL, "can't read image")
 #ifdef H5_HAVE_PARALLEL
                         }
@@ -7316,6 +8397,17 @@ H5C__load_entry(H5F_t *f,
 
         /* Set the final length (in case it wasn't set earlier) */
         len = actual_len;
+
+        /* The entry's image won't be needed again */
+        if (f->shared->cache->ra_head)
+            H5C__discard_read_ahead(f->shared->cache, addr, len, TRUE);
+
+        /* Add the entry to the metadata access trace being recorded, with the
+         * length of its first read, so that replaying the trace covers it
+         */
+        if (f->shared->cache->trace_recording)
+            if (H5C__record_access(f->shared->cache, type, addr, MAX(init_len, len)) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTSET, NULL, "can't record entry in access trace")
     } /* end if !H5C__CLASS_SKIP_READS */
 
     /* Deserialize the on-disk image into the native memory form */
@@ -7396,6 +8488,12 @@ H5C__load_entry(H5F_t *f,
     entry->coll_prev = NULL;
 #endif /* H5_HAVE_PARALLEL */
 
+    entry->rp_hot      = FALSE;
+    entry->rp_load_seq = 0;
+
+    entry->shared_ref_count = 0;
+    entry->shared_retired   = FALSE;
+
     /* initialize cache image related fields */
     entry->include_in_image     = FALSE;
     entry->lru_rank             = 0;
@@ -7576,9 +8674,25 @@ H5C__make_space_in_cache(H5F_t *f, size_t space_needed, hbool_t write_permitted)
                     cache_ptr->entries_scanned_to_make_space++;
 #endif /* H5C_COLLECT_CACHE_STATS */
 
-                    if (H5C__flush_single_entry(f, entry_ptr,
-                                                H5C__FLUSH_INVALIDATE_FLAG |
-                                                    H5C__DEL_FROM_SLIST_ON_DESTROY_FLAG) < 0)
+                    /* Under the 2Q policy, move hot entries back to the
+                     * head of the LRU list instead of evicting them, as
+                     * long as the hot set is within its share of the
+                     * cache.  Otherwise evict them like any other entry.
+                     */
+                    if (entry_ptr->rp_hot &&
+                        (cache_ptr->rp_hot_size <=
+                         (cache_ptr->max_cache_size / 100) * H5C__2Q_HOT_PERCENT)) {
+                        H5C__FAKE_RP_FOR_MOST_RECENT_ACCESS(cache_ptr, entry_ptr, FAIL)
+                        H5C__UPDATE_STATS_FOR_HOT_SECOND_CHANCE(cache_ptr, entry_ptr)
+                        didnt_flush_entry = TRUE;
+                    }
+                    else if (!H5C__retire_shared_entry(cache_ptr, entry_ptr, FALSE)) {
+                        /* Skip entries that threads are reading */
+                        didnt_flush_entry = TRUE;
+                    }
+                    else if (H5C__flush_single_entry(f, entry_ptr,
+                                                     H5C__FLUSH_INVALIDATE_FLAG |
+                                                         H5C__DEL_FROM_SLIST_ON_DESTROY_FLAG) < 0)
                         HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "unable to flush entry")
                 }
                 else {
@@ -7710,7 +8824,7 @@ H5C__make_space_in_cache(H5F_t *f, size_t space_needed, hbool_t write_permitted)
 #ifdef H5_HAVE_PARALLEL
                 && (!(entry_ptr->coll_access))
 #endif /* H5_HAVE_PARALLEL */
-            ) {
+                && H5C__retire_shared_entry(cache_ptr, entry_ptr, FALSE)) {
                 if (H5C__flush_single_entry(
                         f, entry_ptr, H5C__FLUSH_INVALIDATE_FLAG | H5C__DEL_FROM_SLIST_ON_DESTROY_FLAG) < 0)
                     HGOTO_ERROR(H5E_CACHE, H5E_CANTFLUSH, FAIL, "unable to flush entry")
@@ -8080,6 +9194,103 @@ done:
 
 } /* H5C__flush_marked_entries */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5C__rehash_index
+ *
+ * Purpose:     Performs one step of resizing the hash table of the cache
+ *              index.
+ *
+ *              If no resize is in progress, allocates a new table twice
+ *              (or half) as large as the current one and makes the
+ *              current table the old one.  Then moves the entries of the
+ *              next H5C__HASH_REHASH_STEP buckets of the old table to the
+ *              new one, and frees the old table once it is empty.
+ *
+ *              Spreading the work this way keeps the cost of a resize
+ *              out of any single insertion, deletion or search.  As the
+ *              index works with either table size, failing to allocate
+ *              a new table isn't an error: the resize is just put off.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5C__rehash_index(H5C_t *cache_ptr)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity check */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(cache_ptr->index);
+
+    /* Start a resize if there's none in progress */
+    if (NULL == cache_ptr->old_index) {
+        H5C_cache_entry_t **new_index; /* New table of buckets */
+        unsigned            new_nbits; /* Log2 of the size of the new table */
+
+        if (cache_ptr->index_len > H5C__HASH_NBUCKETS(cache_ptr->index_nbits))
+            new_nbits = cache_ptr->index_nbits + 1;
+        else
+            new_nbits = cache_ptr->index_nbits - 1;
+        HDassert(new_nbits >= H5C__HASH_MIN_NBITS);
+        HDassert(new_nbits <= H5C__HASH_MAX_NBITS);
+
+        if (NULL != (new_index = (H5C_cache_entry_t **)H5MM_calloc(H5C__HASH_NBUCKETS(new_nbits) *
+                                                                    sizeof(H5C_cache_entry_t *)))) {
+            /* Let shared readers know the tables are changing */
+            H5C__ATOMIC_INCR(&cache_ptr->index_seq);
+            cache_ptr->old_index         = cache_ptr->index;
+            cache_ptr->old_index_nbits   = cache_ptr->index_nbits;
+            cache_ptr->index             = new_index;
+            cache_ptr->index_nbits       = new_nbits;
+            cache_ptr->index_rehash_next = 0;
+            H5C__ATOMIC_INCR(&cache_ptr->index_seq);
+        } /* end if */
+    }     /* end if */
+
+    if (cache_ptr->old_index) {
+        size_t   old_nbuckets = H5C__HASH_NBUCKETS(cache_ptr->old_index_nbits);
+        unsigned u;
+
+        /* Move the entries of the next few buckets of the old table */
+        for (u = 0; u < H5C__HASH_REHASH_STEP && cache_ptr->index_rehash_next < old_nbuckets; u++) {
+            H5C_cache_entry_t *entry_ptr = cache_ptr->old_index[cache_ptr->index_rehash_next];
+
+            cache_ptr->old_index[cache_ptr->index_rehash_next] = NULL;
+            while (entry_ptr) {
+                H5C_cache_entry_t * next_ptr = entry_ptr->ht_next;
+                H5C_cache_entry_t **bucket =
+                    &(cache_ptr->index[H5C__HASH_FCN(entry_ptr->addr, cache_ptr->index_nbits)]);
+
+                entry_ptr->ht_prev = NULL;
+                entry_ptr->ht_next = *bucket;
+                if (*bucket)
+                    (*bucket)->ht_prev = entry_ptr;
+                H5C__ATOMIC_STORE(bucket, entry_ptr);
+                entry_ptr = next_ptr;
+            } /* end while */
+
+            cache_ptr->index_rehash_next++;
+        } /* end for */
+
+        /* Release the old table once all its buckets have been moved */
+        if (cache_ptr->index_rehash_next >= old_nbuckets) {
+            H5C_cache_entry_t **old_index = cache_ptr->old_index;
+
+            H5C__ATOMIC_STORE(&cache_ptr->old_index, NULL);
+            if (cache_ptr->shared_reads)
+                H5C__shared_synchronize(cache_ptr);
+            cache_ptr->old_index         = (H5C_cache_entry_t **)H5MM_xfree(old_index);
+            cache_ptr->old_index_nbits   = 0;
+            cache_ptr->index_rehash_next = 0;
+        } /* end if */
+    }     /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5C__rehash_index() */
+
 /*-------------------------------------------------------------------------
  *
  * Function:    H5C_cork
@@ -9182,6 +10393,8 @@ H5C_remove_entry(void *_entry)
     if (entry->flush_dep_nchildren > 0)
         HGOTO_ERROR(H5E_CACHE, H5E_CANTREMOVE, FAIL,
                     "can't remove entry with flush dependency children from cache")
+    if (!H5C__retire_shared_entry(cache, entry, TRUE))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTREMOVE, FAIL, "can't remove entry in use by shared readers")
 
     /* Additional internal cache consistency checks */
     HDassert(!entry->in_slist);
@@ -9212,6 +10425,10 @@ H5C_remove_entry(void *_entry)
 
     H5C__DELETE_FROM_INDEX(cache, entry, FAIL)
 
+    /* Wait for threads that may still be looking at the entry */
+    if (cache->shared_reads)
+        H5C__shared_synchronize(cache);
+
 #ifdef H5_HAVE_PARALLEL
     /* Check for collective read access flag */
     if (entry->coll_access) {
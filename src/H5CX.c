@@ -228,6 +228,10 @@ typedef struct H5CX_t {
     hbool_t   btree_split_ratio_valid; /* Whether B-tree split ratios are valid */
     size_t    vec_size;                /* Size of hyperslab vector (H5D_XFER_HYPER_VECTOR_SIZE_NAME) */
     hbool_t   vec_size_valid;          /* Whether hyperslab vector is valid */
+    hbool_t   zero_copy_io;            /* Whether to use zero-copy vector I/O (H5D_XFER_ZERO_COPY_IO_NAME) */
+    hbool_t   zero_copy_io_valid;      /* Whether zero-copy I/O flag is valid */
+    unsigned  conv_threads;            /* # of threads for datatype conversion (H5D_XFER_CONV_THREADS_NAME) */
+    hbool_t   conv_threads_valid;      /* Whether datatype conversion thread count is valid */
 #ifdef H5_HAVE_PARALLEL
     H5FD_mpio_xfer_t io_xfer_mode; /* Parallel transfer mode for this request (H5D_XFER_IO_XFER_MODE_NAME) */
     hbool_t          io_xfer_mode_valid;      /* Whether parallel transfer mode is valid */
@@ -361,6 +365,8 @@ typedef struct H5CX_dxpl_cache_t {
     H5T_bkg_t bkgr_buf_type;        /* Background buffer type (H5D_XFER_BKGR_BUF_NAME) */
     double    btree_split_ratio[3]; /* B-tree split ratios (H5D_XFER_BTREE_SPLIT_RATIO_NAME) */
     size_t    vec_size;             /* Size of hyperslab vector (H5D_XFER_HYPER_VECTOR_SIZE_NAME) */
+    hbool_t   zero_copy_io;         /* Whether to use zero-copy vector I/O (H5D_XFER_ZERO_COPY_IO_NAME) */
+    unsigned  conv_threads;         /* # of threads for datatype conversion (H5D_XFER_CONV_THREADS_NAME) */
 #ifdef H5_HAVE_PARALLEL
     H5FD_mpio_xfer_t io_xfer_mode; /* Parallel transfer mode for this request (H5D_XFER_IO_XFER_MODE_NAME) */
     H5FD_mpio_collective_opt_t mpio_coll_opt; /* Parallel transfer with independent IO or collective IO with
@@ -519,6 +525,14 @@ H5CX__init_package(void)
     if (H5P_get(dx_plist, H5D_XFER_HYPER_VECTOR_SIZE_NAME, &H5CX_def_dxpl_cache.vec_size) < 0)
         HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve I/O vector size")
 
+    /* Get zero-copy I/O flag */
+    if (H5P_get(dx_plist, H5D_XFER_ZERO_COPY_IO_NAME, &H5CX_def_dxpl_cache.zero_copy_io) < 0)
+        HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve zero-copy I/O flag")
+
+    /* Get datatype conversion thread count */
+    if (H5P_get(dx_plist, H5D_XFER_CONV_THREADS_NAME, &H5CX_def_dxpl_cache.conv_threads) < 0)
+        HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve datatype conversion thread count")
+
 #ifdef H5_HAVE_PARALLEL
     /* Collect Parallel I/O information for possible later use */
     if (H5P_get(dx_plist, H5D_XFER_IO_XFER_MODE_NAME, &H5CX_def_dxpl_cache.io_xfer_mode) < 0)
@@ -1109,6 +1123,70 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5CX_free_state() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5CX_get_shared_context
+ *
+ * Purpose:     Retrieve the current API context, so that helper threads
+ *              working on behalf of this API call can share it with
+ *              H5CX_set_shared_context().
+ *
+ * Note:        Helper threads must only read from the shared context, so
+ *              any property values they need must already be retrieved
+ *              by the thread that made the API call.
+ *
+ * Return:      Pointer to the current API context (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+void *
+H5CX_get_shared_context(void)
+{
+    H5CX_node_t **head =
+        H5CX_get_my_context(); /* Get the pointer to the head of the API context, for this thread */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(head && *head);
+
+    FUNC_LEAVE_NOAPI((void *)*head)
+} /* end H5CX_get_shared_context() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5CX_set_shared_context
+ *
+ * Purpose:     Make a helper thread use (or, when CTX is NULL, stop using)
+ *              an API context retrieved with H5CX_get_shared_context().
+ *
+ * Note:        Without the thread-safe build there is only one API context
+ *              for all threads, so this has nothing to do.
+ *
+ * Return:      <none>
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5CX_set_shared_context(void *ctx)
+{
+#ifdef H5_HAVE_THREADSAFE
+    H5CX_node_t **head =
+        H5CX_get_my_context(); /* Get the pointer to the head of the API context, for this thread */
+#endif                         /* H5_HAVE_THREADSAFE */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+#ifdef H5_HAVE_THREADSAFE
+    /* Sanity check */
+    HDassert(head);
+
+    *head = (H5CX_node_t *)ctx;
+#else  /* H5_HAVE_THREADSAFE */
+    HDassert(NULL == ctx || ctx == (void *)H5CX_head_g);
+#endif /* H5_HAVE_THREADSAFE */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5CX_set_shared_context() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5CX_is_def_dxpl
  *
@@ -2049,6 +2127,71 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5CX_get_vec_size() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5CX_get_zero_copy_io
+ *
+ * Purpose:     Retrieves the zero-copy I/O flag for the current API call context.
+ *
+ * Return:      Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5CX_get_zero_copy_io(hbool_t *zero_copy_io)
+{
+    H5CX_node_t **head =
+        H5CX_get_my_context();  /* Get the pointer to the head of the API context, for this thread */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(zero_copy_io);
+    HDassert(head && *head);
+    HDassert(H5P_DEFAULT != (*head)->ctx.dxpl_id);
+
+    H5CX_RETRIEVE_PROP_VALID(dxpl, H5P_DATASET_XFER_DEFAULT, H5D_XFER_ZERO_COPY_IO_NAME, zero_copy_io)
+
+    /* Get the value */
+    *zero_copy_io = (*head)->ctx.zero_copy_io;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5CX_get_zero_copy_io() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5CX_get_conv_threads
+ *
+ * Purpose:     Retrieves the number of threads to use for datatype conversion
+ *              for the current API call context.
+ *
+ * Return:      Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5CX_get_conv_threads(unsigned *conv_threads)
+{
+    H5CX_node_t **head =
+        H5CX_get_my_context();  /* Get the pointer to the head of the API context, for this thread */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(conv_threads);
+    HDassert(head && *head);
+    HDassert(H5P_DEFAULT != (*head)->ctx.dxpl_id);
+
+    H5CX_RETRIEVE_PROP_VALID(dxpl, H5P_DATASET_XFER_DEFAULT, H5D_XFER_CONV_THREADS_NAME, conv_threads)
+
+    /* Get the value */
+    *conv_threads = (*head)->ctx.conv_threads;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5CX_get_conv_threads() */
+
 #ifdef H5_HAVE_PARALLEL
 
 /*-------------------------------------------------------------------------
@@ -72,6 +72,8 @@ H5_DLL hbool_t H5CX_is_def_dxpl(void);
 H5_DLL herr_t H5CX_retrieve_state(H5CX_state_t **api_state);
 H5_DLL herr_t H5CX_restore_state(const H5CX_state_t *api_state);
 H5_DLL herr_t H5CX_free_state(H5CX_state_t *api_state);
+H5_DLL void * H5CX_get_shared_context(void);
+H5_DLL void   H5CX_set_shared_context(void *ctx);
 
 /* "Setter" routines for API context info */
 H5_DLL void   H5CX_set_dxpl(hid_t dxpl_id);
@@ -106,6 +108,8 @@ H5_DLL herr_t H5CX_get_tconv_buf(void **tconv_buf);
 H5_DLL herr_t H5CX_get_bkgr_buf(void **bkgr_buf);
 H5_DLL herr_t H5CX_get_bkgr_buf_type(H5T_bkg_t *bkgr_buf_type);
 H5_DLL herr_t H5CX_get_vec_size(size_t *vec_size);
+H5_DLL herr_t H5CX_get_zero_copy_io(hbool_t *zero_copy_io);
+H5_DLL herr_t H5CX_get_conv_threads(unsigned *conv_threads);
 #ifdef H5_HAVE_PARALLEL
 H5_DLL herr_t H5CX_get_io_xfer_mode(H5FD_mpio_xfer_t *io_xfer_mode);
 H5_DLL herr_t H5CX_get_mpio_coll_opt(H5FD_mpio_collective_opt_t *mpio_coll_opt);
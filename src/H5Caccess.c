@@ -0,0 +1,629 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*-------------------------------------------------------------------------
+ *
+ * Created:     H5Caccess.c
+ *
+ * Purpose:     Functions for recording the metadata cache entries loaded
+ *              while a file is open, and for reading them ahead when the
+ *              file is opened again.
+ *
+ *              The trace is kept in a file of its own, which holds the
+ *              class, address and length of each entry in the order the
+ *              entries were first loaded:
+ *
+ *              signature       4 bytes ("MDAT")
+ *              version         1 byte
+ *              EOA             8 bytes
+ *              # of records    4 bytes
+ *              records         13 bytes each: type id (1 byte),
+ *                              address (8 bytes), length (4 bytes)
+ *              checksum        4 bytes
+ *
+ *-------------------------------------------------------------------------
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#include "H5Cmodule.h" /* This source code file is part of the H5C module */
+#define H5F_FRIEND     /* Suppress error about including H5Fpkg  */
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"   /* Generic Functions                        */
+#include "H5Cpkg.h"      /* Cache                                    */
+#include "H5Eprivate.h"  /* Error handling                           */
+#include "H5Fpkg.h"      /* Files                                    */
+#include "H5FDprivate.h" /* File drivers                             */
+#include "H5MMprivate.h" /* Memory management                        */
+
+/****************/
+/* Local Macros */
+/****************/
+
+#define H5C__ACCESS_TRACE_SIGNATURE     "MDAT"
+#define H5C__ACCESS_TRACE_SIGNATURE_LEN 4
+#define H5C__ACCESS_TRACE_VERSION       0
+
+/* Sizes of the parts of an access trace file */
+#define H5C__ACCESS_TRACE_HEADER_SIZE (H5C__ACCESS_TRACE_SIGNATURE_LEN + 1 + 8 + 4)
+#define H5C__ACCESS_TRACE_RECORD_SIZE (1 + 8 + 4)
+
+/* Initial number of entries in the list of recorded entries */
+#define H5C__ACCESS_TRACE_INIT_NREQS 256
+
+/* Largest gap between entries in the trace that are read ahead together */
+#define H5C__ACCESS_TRACE_MAX_GAP 4096
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+/********************/
+/* Local Prototypes */
+/********************/
+static herr_t H5C__read_access_trace(H5F_t *f, H5C_prefetch_req_t **reqs_ptr, size_t *nreqs_ptr);
+static herr_t H5C__write_access_trace(H5F_t *f);
+static herr_t H5C__merge_access_trace(H5C_t *cache_ptr, H5C_prefetch_req_t *reqs, size_t *nreqs_ptr);
+static int    H5C__access_trace_cmp(const void *_req1, const void *_req2);
+static int    H5C__access_trace_span_cmp(const void *_req1, const void *_req2);
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_access_trace_set_up
+ *
+ * Purpose:     Start recording the entries loaded into the cache, to be
+ *              written to an access trace at LOCATION when the cache is
+ *              destroyed.
+ *
+ *              Nothing is recorded for SWMR readers, for files accessed
+ *              through MPI, or when the file driver has no vector I/O,
+ *              as the trace could not be read ahead.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_access_trace_set_up(H5F_t *f, const char *location)
+{
+    H5C_t *cache_ptr;
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(location);
+
+    if (cache_ptr->trace_location)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "access trace already set up")
+
+    if (!H5F_shared_has_vector_io(f->shared) || (H5F_INTENT(f) & H5F_ACC_SWMR_READ))
+        HGOTO_DONE(SUCCEED)
+#ifdef H5_HAVE_PARALLEL
+    if (H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+        HGOTO_DONE(SUCCEED)
+#endif /* H5_HAVE_PARALLEL */
+
+    if (NULL == (cache_ptr->trace_location = H5MM_xstrdup(location)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "can't copy access trace location")
+    cache_ptr->trace_recording = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_access_trace_set_up() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_replay_access_trace
+ *
+ * Purpose:     Read ahead the entries in the access trace recorded the
+ *              last time the file was opened, and stop recording.
+ *
+ *              This is called once the superblock has been read.  If
+ *              there is no trace yet, or it doesn't match the file, the
+ *              entries loaded keep being recorded, and the trace is
+ *              replaced when the cache is destroyed.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_replay_access_trace(H5F_t *f)
+{
+    H5C_t *             cache_ptr;
+    H5C_prefetch_req_t *reqs      = NULL;    /* Entries in the trace */
+    size_t              nreqs     = 0;       /* Number of entries in the trace */
+    herr_t              ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    if (!cache_ptr->trace_recording)
+        HGOTO_DONE(SUCCEED)
+
+    if (H5C__read_access_trace(f, &reqs, &nreqs) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "can't read access trace")
+    if (NULL == reqs)
+        HGOTO_DONE(SUCCEED)
+
+    /* The trace is up to date, so there's no need to record another one */
+    cache_ptr->trace_recording = FALSE;
+    cache_ptr->trace_reqs      = (H5C_prefetch_req_t *)H5MM_xfree(cache_ptr->trace_reqs);
+    cache_ptr->trace_nreqs     = 0;
+    cache_ptr->trace_nalloc    = 0;
+    cache_ptr->trace_size      = 0;
+
+    if (H5C__merge_access_trace(cache_ptr, reqs, &nreqs) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTMERGE, FAIL, "can't merge entries in access trace")
+    if (H5C_prefetch_entries(f, nreqs, reqs) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTLOAD, FAIL, "can't read ahead entries in access trace")
+
+done:
+    H5MM_xfree(reqs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_replay_access_trace() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__record_access
+ *
+ * Purpose:     Append an entry loaded from the file to the access trace
+ *              being recorded.
+ *
+ *              Entries are only recorded until their images add up to
+ *              H5C__READ_AHEAD_MAX_SIZE bytes, as no more can be read
+ *              ahead when the trace is replayed.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C__record_access(H5C_t *cache_ptr, const H5C_class_t *type, haddr_t addr, size_t len)
+{
+    H5C_prefetch_req_t *req;
+    herr_t              ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(cache_ptr->trace_recording);
+    HDassert(type);
+    HDassert(H5F_addr_defined(addr));
+
+    if ((cache_ptr->trace_size + len) > H5C__READ_AHEAD_MAX_SIZE)
+        HGOTO_DONE(SUCCEED)
+
+    if (cache_ptr->trace_nreqs == cache_ptr->trace_nalloc) {
+        size_t              new_nalloc = MAX(H5C__ACCESS_TRACE_INIT_NREQS, 2 * cache_ptr->trace_nalloc);
+        H5C_prefetch_req_t *new_reqs;
+
+        if (NULL == (new_reqs = (H5C_prefetch_req_t *)H5MM_realloc(cache_ptr->trace_reqs,
+                                                                   new_nalloc * sizeof(H5C_prefetch_req_t))))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "can't extend access trace")
+        cache_ptr->trace_reqs   = new_reqs;
+        cache_ptr->trace_nalloc = new_nalloc;
+    } /* end if */
+
+    req       = &cache_ptr->trace_reqs[cache_ptr->trace_nreqs++];
+    req->type = type;
+    req->addr = addr;
+    req->len  = len;
+    cache_ptr->trace_size += len;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__record_access() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__access_trace_tear_down
+ *
+ * Purpose:     Write the access trace being recorded, if any, and release
+ *              the resources used for the trace.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C__access_trace_tear_down(H5F_t *f)
+{
+    H5C_t *cache_ptr;
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    if (cache_ptr->trace_recording && cache_ptr->trace_nreqs > 0)
+        if (H5C__write_access_trace(f) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_WRITEERROR, FAIL, "can't write access trace")
+
+done:
+    cache_ptr->trace_location  = (char *)H5MM_xfree(cache_ptr->trace_location);
+    cache_ptr->trace_recording = FALSE;
+    cache_ptr->trace_reqs      = (H5C_prefetch_req_t *)H5MM_xfree(cache_ptr->trace_reqs);
+    cache_ptr->trace_nreqs     = 0;
+    cache_ptr->trace_nalloc    = 0;
+    cache_ptr->trace_size      = 0;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__access_trace_tear_down() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__read_access_trace
+ *
+ * Purpose:     Read the access trace at the cache's trace location.
+ *
+ *              If there is no trace, or it is corrupt, was recorded when
+ *              the file had a different EOA, or names an unknown class,
+ *              *REQS_PTR is set to NULL.  Otherwise, it is set to a list
+ *              of the entries in the trace, which the caller must free.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__read_access_trace(H5F_t *f, H5C_prefetch_req_t **reqs_ptr, size_t *nreqs_ptr)
+{
+    H5C_t *             cache_ptr = f->shared->cache;
+    H5C_prefetch_req_t *reqs      = NULL;    /* Entries in the trace */
+    uint8_t *           buf       = NULL;    /* Buffer for the trace */
+    const uint8_t *     p;                   /* Pointer into the trace */
+    h5_stat_t           sb;                  /* Information about the trace file */
+    size_t              buf_size;            /* Size of the trace */
+    uint64_t            eoa;                 /* EOA of the file the trace was recorded for */
+    uint32_t            nrecords;            /* Number of entries in the trace */
+    uint32_t            stored_chksum;       /* Checksum stored in the trace */
+    int                 fd        = -1;      /* Trace file descriptor */
+    size_t              u;                   /* Local index variable */
+    herr_t              ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(cache_ptr->trace_location);
+    HDassert(reqs_ptr);
+    HDassert(nreqs_ptr);
+
+    *reqs_ptr  = NULL;
+    *nreqs_ptr = 0;
+
+    if ((fd = HDopen(cache_ptr->trace_location, O_RDONLY)) < 0) {
+        if (ENOENT == errno)
+            HGOTO_DONE(SUCCEED)
+        HSYS_GOTO_ERROR(H5E_CACHE, H5E_CANTOPENFILE, FAIL, "unable to open access trace")
+    } /* end if */
+    if (HDfstat(fd, &sb) < 0)
+        HSYS_GOTO_ERROR(H5E_CACHE, H5E_BADFILE, FAIL, "unable to fstat access trace")
+
+    /* Check that the trace is the right size for the number of records it claims to hold */
+    if ((size_t)sb.st_size < H5C__ACCESS_TRACE_HEADER_SIZE + H5_SIZEOF_CHKSUM)
+        HGOTO_DONE(SUCCEED)
+    buf_size = (size_t)sb.st_size;
+    if (NULL == (buf = (uint8_t *)H5MM_malloc(buf_size)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for access trace")
+    if (HDread(fd, buf, buf_size) != (h5_posix_io_ret_t)buf_size)
+        HSYS_GOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "unable to read access trace")
+
+    p = buf;
+    if (HDmemcmp(p, H5C__ACCESS_TRACE_SIGNATURE, (size_t)H5C__ACCESS_TRACE_SIGNATURE_LEN) != 0)
+        HGOTO_DONE(SUCCEED)
+    p += H5C__ACCESS_TRACE_SIGNATURE_LEN;
+    if (*p++ != H5C__ACCESS_TRACE_VERSION)
+        HGOTO_DONE(SUCCEED)
+    UINT64DECODE(p, eoa);
+    UINT32DECODE(p, nrecords);
+    if (buf_size !=
+        H5C__ACCESS_TRACE_HEADER_SIZE + ((size_t)nrecords * H5C__ACCESS_TRACE_RECORD_SIZE) + H5_SIZEOF_CHKSUM)
+        HGOTO_DONE(SUCCEED)
+
+    /* Verify the checksum */
+    p = buf + buf_size - H5_SIZEOF_CHKSUM;
+    UINT32DECODE(p, stored_chksum);
+    if (stored_chksum != H5_checksum_metadata(buf, buf_size - H5_SIZEOF_CHKSUM, 0))
+        HGOTO_DONE(SUCCEED)
+
+    /* Ignore a trace recorded before the file was last changed */
+    if ((haddr_t)eoa != H5F_get_eoa(f, H5FD_MEM_SUPER) || 0 == nrecords)
+        HGOTO_DONE(SUCCEED)
+
+    if (NULL == (reqs = (H5C_prefetch_req_t *)H5MM_malloc(nrecords * sizeof(H5C_prefetch_req_t))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for access trace")
+
+    /* Decode the records */
+    p = buf + H5C__ACCESS_TRACE_HEADER_SIZE;
+    for (u = 0; u < nrecords; u++) {
+        unsigned type_id = *p++;
+        uint64_t addr;
+        uint32_t len;
+
+        if (type_id > (unsigned)cache_ptr->max_type_id)
+            HGOTO_DONE(SUCCEED)
+        UINT64DECODE(p, addr);
+        UINT32DECODE(p, len);
+
+        reqs[u].type = cache_ptr->class_table_ptr[type_id];
+        reqs[u].addr = (haddr_t)addr;
+        reqs[u].len  = (size_t)len;
+    } /* end for */
+
+    *reqs_ptr  = reqs;
+    *nreqs_ptr = nrecords;
+    reqs       = NULL;
+
+done:
+    if (fd >= 0 && HDclose(fd) < 0)
+        HSYS_DONE_ERROR(H5E_CACHE, H5E_CANTCLOSEFILE, FAIL, "unable to close access trace")
+    H5MM_xfree(reqs);
+    H5MM_xfree(buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__read_access_trace() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__write_access_trace
+ *
+ * Purpose:     Write the entries recorded since the file was opened to
+ *              the cache's trace location.  Entries loaded more than
+ *              once are written only where they were first loaded.
+ *
+ *              The trace is written to a file of its own first, and then
+ *              renamed, so that processes opening the file at the same
+ *              time never see a partially written trace.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__write_access_trace(H5F_t *f)
+{
+    H5C_t *                    cache_ptr = f->shared->cache;
+    const H5C_prefetch_req_t **sorted    = NULL;    /* Recorded entries, sorted by address */
+    hbool_t *                  dup       = NULL;    /* Whether each entry was loaded before */
+    uint8_t *                  buf       = NULL;    /* Buffer for the trace */
+    uint8_t *                  p;                   /* Pointer into the trace */
+    char *                     tmp_name  = NULL;    /* Name of the file the trace is written to */
+    size_t                     tmp_name_len;        /* Size of the buffer for the name */
+    size_t                     buf_size;            /* Size of the trace */
+    uint32_t                   nrecords  = 0;       /* Number of entries in the trace */
+    uint32_t                   chksum;              /* Checksum of the trace */
+    int                        fd        = -1;      /* Trace file descriptor */
+    size_t                     u;                   /* Local index variable */
+    herr_t                     ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(cache_ptr->trace_location);
+    HDassert(cache_ptr->trace_nreqs > 0);
+
+    /* Find the entries that were loaded more than once */
+    if (NULL == (sorted = (const H5C_prefetch_req_t **)H5MM_malloc(cache_ptr->trace_nreqs *
+                                                                    sizeof(H5C_prefetch_req_t *))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for sorted access trace")
+    if (NULL == (dup = (hbool_t *)H5MM_calloc(cache_ptr->trace_nreqs * sizeof(hbool_t))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for access trace flags")
+    for (u = 0; u < cache_ptr->trace_nreqs; u++)
+        sorted[u] = &cache_ptr->trace_reqs[u];
+    HDqsort(sorted, cache_ptr->trace_nreqs, sizeof(H5C_prefetch_req_t *), H5C__access_trace_cmp);
+    for (u = 1; u < cache_ptr->trace_nreqs; u++)
+        if (H5F_addr_eq(sorted[u]->addr, sorted[u - 1]->addr))
+            dup[sorted[u] - cache_ptr->trace_reqs] = TRUE;
+    for (u = 0; u < cache_ptr->trace_nreqs; u++)
+        if (!dup[u])
+            nrecords++;
+
+    /* Encode the trace */
+    buf_size =
+        H5C__ACCESS_TRACE_HEADER_SIZE + ((size_t)nrecords * H5C__ACCESS_TRACE_RECORD_SIZE) + H5_SIZEOF_CHKSUM;
+    if (NULL == (buf = (uint8_t *)H5MM_malloc(buf_size)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for access trace")
+    p = buf;
+    H5MM_memcpy(p, H5C__ACCESS_TRACE_SIGNATURE, (size_t)H5C__ACCESS_TRACE_SIGNATURE_LEN);
+    p += H5C__ACCESS_TRACE_SIGNATURE_LEN;
+    *p++ = H5C__ACCESS_TRACE_VERSION;
+    UINT64ENCODE(p, (uint64_t)H5F_get_eoa(f, H5FD_MEM_SUPER));
+    UINT32ENCODE(p, nrecords);
+    for (u = 0; u < cache_ptr->trace_nreqs; u++) {
+        const H5C_prefetch_req_t *req = &cache_ptr->trace_reqs[u];
+
+        if (dup[u])
+            continue;
+        *p++ = (uint8_t)req->type->id;
+        UINT64ENCODE(p, (uint64_t)req->addr);
+        UINT32ENCODE(p, (uint32_t)req->len);
+    } /* end for */
+    chksum = H5_checksum_metadata(buf, (size_t)(p - buf), 0);
+    UINT32ENCODE(p, chksum);
+    HDassert((size_t)(p - buf) == buf_size);
+
+    /* Write the trace next to its final location */
+    tmp_name_len = HDstrlen(cache_ptr->trace_location) + 32;
+    if (NULL == (tmp_name = (char *)H5MM_malloc(tmp_name_len)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for access trace name")
+    HDsnprintf(tmp_name, tmp_name_len, "%s.%d", cache_ptr->trace_location, (int)HDgetpid());
+    if ((fd = HDopen(tmp_name, O_WRONLY | O_CREAT | O_TRUNC, H5_POSIX_CREATE_MODE_RW)) < 0)
+        HSYS_GOTO_ERROR(H5E_CACHE, H5E_CANTOPENFILE, FAIL, "unable to create access trace")
+    if (HDwrite(fd, buf, buf_size) != (h5_posix_io_ret_t)buf_size)
+        HSYS_GOTO_ERROR(H5E_CACHE, H5E_WRITEERROR, FAIL, "unable to write access trace")
+    if (HDclose(fd) < 0) {
+        fd = -1;
+        HSYS_GOTO_ERROR(H5E_CACHE, H5E_CANTCLOSEFILE, FAIL, "unable to close access trace")
+    } /* end if */
+    fd = -1;
+    if (HDrename(tmp_name, cache_ptr->trace_location) < 0)
+        HSYS_GOTO_ERROR(H5E_CACHE, H5E_WRITEERROR, FAIL, "unable to rename access trace")
+
+done:
+    if (ret_value < 0 && tmp_name) {
+        if (fd >= 0)
+            HDclose(fd);
+        HDremove(tmp_name);
+    } /* end if */
+    H5MM_xfree(tmp_name);
+    H5MM_xfree(buf);
+    H5MM_xfree(dup);
+    H5MM_xfree(sorted);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__write_access_trace() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__merge_access_trace
+ *
+ * Purpose:     Prepare the entries in an access trace to be read ahead.
+ *
+ *              The entries that are already in the cache, and those of
+ *              classes that skip reads, are dropped.  The others are
+ *              sorted by memory type and address, and entries of the
+ *              same memory type that are less than
+ *              H5C__ACCESS_TRACE_MAX_GAP bytes apart are merged into a
+ *              single span.  Each span is read with one I/O request and
+ *              kept as one image, from which the entries in it are
+ *              copied as they are loaded.
+ *
+ *              On return, *NREQS_PTR is the number of spans at the
+ *              start of REQS.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__merge_access_trace(H5C_t *cache_ptr, H5C_prefetch_req_t *reqs, size_t *nreqs_ptr)
+{
+    size_t nreqs = 0;           /* Number of entries kept */
+    size_t nspans;              /* Number of spans */
+    size_t u;                   /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(reqs);
+    HDassert(nreqs_ptr);
+
+    /* Drop the entries that won't be read */
+    for (u = 0; u < *nreqs_ptr; u++) {
+        H5C_cache_entry_t *entry_ptr;
+
+        if (reqs[u].type->flags & H5C__CLASS_SKIP_READS)
+            continue;
+        H5C__SEARCH_INDEX(cache_ptr, reqs[u].addr, entry_ptr, FAIL)
+        if (entry_ptr)
+            continue;
+        reqs[nreqs++] = reqs[u];
+    } /* end for */
+
+    /* Merge the entries that are close together */
+    HDqsort(reqs, nreqs, sizeof(H5C_prefetch_req_t), H5C__access_trace_span_cmp);
+    for (u = 0, nspans = 0; u < nreqs; u++) {
+        if (nspans > 0) {
+            H5C_prefetch_req_t *span     = &reqs[nspans - 1];
+            haddr_t             span_end = span->addr + span->len;
+
+            if (span->type->mem_type == reqs[u].type->mem_type &&
+                H5F_addr_le(reqs[u].addr, span_end + H5C__ACCESS_TRACE_MAX_GAP)) {
+                if (H5F_addr_gt(reqs[u].addr + reqs[u].len, span_end))
+                    span->len = (size_t)((reqs[u].addr + reqs[u].len) - span->addr);
+                continue;
+            } /* end if */
+        }     /* end if */
+        reqs[nspans++] = reqs[u];
+    } /* end for */
+
+    *nreqs_ptr = nspans;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__merge_access_trace() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__access_trace_cmp
+ *
+ * Purpose:     Comparison callback for sorting the recorded entries by
+ *              address, keeping entries at the same address in the order
+ *              they were loaded.
+ *
+ * Return:      Negative, zero or positive, as for qsort()
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5C__access_trace_cmp(const void *_req1, const void *_req2)
+{
+    const H5C_prefetch_req_t *req1 = *(const H5C_prefetch_req_t *const *)_req1;
+    const H5C_prefetch_req_t *req2 = *(const H5C_prefetch_req_t *const *)_req2;
+
+    if (H5F_addr_ne(req1->addr, req2->addr))
+        return H5F_addr_lt(req1->addr, req2->addr) ? -1 : 1;
+
+    return (req1 < req2) ? -1 : ((req1 > req2) ? 1 : 0);
+} /* H5C__access_trace_cmp() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__access_trace_span_cmp
+ *
+ * Purpose:     Comparison callback for sorting the entries in an access
+ *              trace by memory type and address.
+ *
+ * Return:      Negative, zero or positive, as for qsort()
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5C__access_trace_span_cmp(const void *_req1, const void *_req2)
+{
+    const H5C_prefetch_req_t *req1 = (const H5C_prefetch_req_t *)_req1;
+    const H5C_prefetch_req_t *req2 = (const H5C_prefetch_req_t *)_req2;
+
+    if (req1->type->mem_type != req2->type->mem_type)
+        return (req1->type->mem_type < req2->type->mem_type) ? -1 : 1;
+    if (H5F_addr_ne(req1->addr, req2->addr))
+        return H5F_addr_lt(req1->addr, req2->addr) ? -1 : 1;
+
+    return 0;
+} /* H5C__access_trace_span_cmp() */
@@ -98,17 +98,14 @@ H5C_dump_cache(H5C_t *cache_ptr, const char *cache_name)
      * Do this, as we want to display cache entries in increasing address
      * order.
      */
-    for (i = 0; i < H5C__HASH_TABLE_LEN; i++) {
-        entry_ptr = cache_ptr->index[i];
-
-        while (entry_ptr != NULL) {
-            HDassert(entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
-            if (H5SL_insert(slist_ptr, entry_ptr, &(entry_ptr->addr)) < 0)
-                HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "can't insert entry in skip list")
+    entry_ptr = cache_ptr->il_head;
+    while (entry_ptr != NULL) {
+        HDassert(entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
+        if (H5SL_insert(slist_ptr, entry_ptr, &(entry_ptr->addr)) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "can't insert entry in skip list")
 
-            entry_ptr = entry_ptr->ht_next;
-        } /* end while */
-    }     /* end for */
+        entry_ptr = entry_ptr->il_next;
+    } /* end while */
 
     /* If we get this far, all entries in the cache are listed in the
      * skip list -- scan the skip list generating the desired output.
@@ -421,6 +418,8 @@ H5C_stats(H5C_t *cache_ptr, const char *cache_name,
     int64_t total_dirty_pins               = 0;
     int64_t total_pinned_flushes           = 0;
     int64_t total_pinned_clears            = 0;
+    int64_t total_hot_promotions           = 0;
+    int64_t total_hot_second_chances       = 0;
     int32_t aggregate_max_accesses         = 0;
     int32_t aggregate_min_accesses         = 1000000;
     int32_t aggregate_max_clears           = 0;
@@ -473,6 +472,8 @@ H5C_stats(H5C_t *cache_ptr, const char *cache_name,
         total_dirty_pins += cache_ptr->dirty_pins[i];
         total_pinned_flushes += cache_ptr->pinned_flushes[i];
         total_pinned_clears += cache_ptr->pinned_clears[i];
+        total_hot_promotions += cache_ptr->hot_promotions[i];
+        total_hot_second_chances += cache_ptr->hot_second_chances[i];
 #if H5C_COLLECT_CACHE_ENTRY_STATS
         if (aggregate_max_accesses < cache_ptr->max_accesses[i])
             aggregate_max_accesses = cache_ptr->max_accesses[i];
@@ -578,6 +579,9 @@ H5C_stats(H5C_t *cache_ptr, const char *cache_name,
     HDfprintf(stdout, "%s  Total pinned flushes / clears      = %ld / %ld\n", cache_ptr->prefix,
               (long)total_pinned_flushes, (long)total_pinned_clears);
 
+    HDfprintf(stdout, "%s  Total hot promotions / 2nd chances = %ld / %ld\n", cache_ptr->prefix,
+              (long)total_hot_promotions, (long)total_hot_second_chances);
+
     HDfprintf(stdout, "%s  MSIC: (make space in cache) calls  = %lld\n", cache_ptr->prefix,
               (long long)(cache_ptr->calls_to_msic));
 
@@ -637,6 +641,10 @@ H5C_stats(H5C_t *cache_ptr, const char *cache_name,
 
     HDfprintf(stdout, "%s  prefetched entry use rate          = %lf\n", cache_ptr->prefix, prefetch_use_rate);
 
+    HDfprintf(stdout, "%s  read-aheads / images / hits        = %lld / %lld / %lld\n", cache_ptr->prefix,
+              (long long)(cache_ptr->read_aheads), (long long)(cache_ptr->read_ahead_images),
+              (long long)(cache_ptr->read_ahead_hits));
+
 #if H5C_COLLECT_CACHE_ENTRY_STATS
 
     HDfprintf(stdout, "%s  aggregate max / min accesses       = %d / %d\n", cache_ptr->prefix,
@@ -696,6 +704,9 @@ H5C_stats(H5C_t *cache_ptr, const char *cache_name,
             HDfprintf(stdout, "%s    entry dirty pins/pin'd flushes = %ld / %ld\n", cache_ptr->prefix,
                       (long)(cache_ptr->dirty_pins[i]), (long)(cache_ptr->pinned_flushes[i]));
 
+            HDfprintf(stdout, "%s    hot promotions / 2nd chances   = %ld / %ld\n", cache_ptr->prefix,
+                      (long)(cache_ptr->hot_promotions[i]), (long)(cache_ptr->hot_second_chances[i]));
+
 #if H5C_COLLECT_CACHE_ENTRY_STATS
 
             HDfprintf(stdout, "%s    entry max / min accesses       = %d / %d\n", cache_ptr->prefix,
@@ -775,6 +786,8 @@ H5C_stats__reset(H5C_t H5_ATTR_UNUSED *cache_ptr)
         cache_ptr->size_decreases[i]           = 0;
         cache_ptr->entry_flush_size_changes[i] = 0;
         cache_ptr->cache_flush_size_changes[i] = 0;
+        cache_ptr->hot_promotions[i]           = 0;
+        cache_ptr->hot_second_chances[i]       = 0;
     } /* end for */
 
     cache_ptr->total_ht_insertions              = 0;
@@ -820,6 +833,10 @@ H5C_stats__reset(H5C_t H5_ATTR_UNUSED *cache_ptr)
     cache_ptr->dirty_prefetches = 0;
     cache_ptr->prefetch_hits    = 0;
 
+    cache_ptr->read_aheads       = 0;
+    cache_ptr->read_ahead_images = 0;
+    cache_ptr->read_ahead_hits   = 0;
+
 #if H5C_COLLECT_CACHE_ENTRY_STATS
     for (i = 0; i <= cache_ptr->max_type_id; i++) {
         cache_ptr->max_accesses[i] = 0;
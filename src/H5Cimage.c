@@ -45,6 +45,8 @@
 #include "H5FLprivate.h" /* Free Lists                           */
 #include "H5MFprivate.h" /* File memory management		*/
 #include "H5MMprivate.h" /* Memory management			*/
+#include "H5Oprivate.h"  /* Object headers                       */
+#include "H5Zprivate.h"  /* Filter pipelines                     */
 
 /****************/
 /* Local Macros */
@@ -60,6 +62,7 @@
 #define H5C__MDCI_BLOCK_SIGNATURE     "MDCI"
 #define H5C__MDCI_BLOCK_SIGNATURE_LEN 4
 #define H5C__MDCI_BLOCK_VERSION_0     0
+#define H5C__MDCI_BLOCK_VERSION_1     1 /* Indexed entry images */
 
 /* Metadata cache image header flags -- max 8 bits */
 #define H5C__MDCI_HEADER_HAVE_RESIZE_STATUS 0x01
@@ -69,6 +72,7 @@
 #define H5C__MDCI_ENTRY_IN_LRU_FLAG       0x02
 #define H5C__MDCI_ENTRY_IS_FD_PARENT_FLAG 0x04
 #define H5C__MDCI_ENTRY_IS_FD_CHILD_FLAG  0x08
+#define H5C__MDCI_ENTRY_COMPRESSED_FLAG   0x10
 
 /* Limits on flush dependency values, stored in 16-bit values on disk */
 #define H5C__MDCI_MAX_FD_CHILDREN USHRT_MAX
@@ -81,6 +85,13 @@
 /* Maximum ring allowed in image */
 #define H5C_MAX_RING_IN_IMAGE H5C_RING_MDFSM
 
+/* Deflate level for compressed entry images -- favor speed over ratio */
+#define H5C__MDCI_DEFLATE_LEVEL 1
+
+/* Version of the cache image block described by the cache */
+#define H5C__MDCI_BLOCK_VERSION(cache_ptr)                                                                   \
+    ((cache_ptr)->image_index_size > 0 ? H5C__MDCI_BLOCK_VERSION_1 : H5C__MDCI_BLOCK_VERSION_0)
+
 /******************/
 /* Local Typedefs */
 /******************/
@@ -90,13 +101,15 @@
 /********************/
 
 /* Helper routines */
-static size_t H5C__cache_image_block_entry_header_size(const H5F_t *f);
-static size_t H5C__cache_image_block_header_size(const H5F_t *f);
+static size_t H5C__cache_image_block_entry_header_size(const H5F_t *f, unsigned version);
+static size_t H5C__cache_image_block_header_size(const H5F_t *f, unsigned version);
 static herr_t H5C__decode_cache_image_header(const H5F_t *f, H5C_t *cache_ptr, const uint8_t **buf);
-#ifndef NDEBUG /* only used in assertions */
 static herr_t H5C__decode_cache_image_entry(const H5F_t *f, const H5C_t *cache_ptr, const uint8_t **buf,
-                                            unsigned entry_num);
-#endif /* NDEBUG */ /* only used in assertions */
+                                            unsigned entry_num, const uint8_t **stored_buf);
+static herr_t H5C__decode_stored_image(const uint8_t *stored, size_t stored_size, uint32_t stored_chksum,
+                                       void *image, size_t size);
+static herr_t H5C__image_pipeline(unsigned flags, unsigned *filter_mask, size_t *nbytes, size_t *buf_size,
+                                  void **buf);
 static herr_t H5C__destroy_pf_entry_child_flush_deps(H5C_t *cache_ptr, H5C_cache_entry_t *pf_entry_ptr,
                                                      H5C_cache_entry_t **fd_children);
 static herr_t H5C__encode_cache_image_header(const H5F_t *f, const H5C_t *cache_ptr, uint8_t **buf);
@@ -106,8 +119,12 @@ static void   H5C__prep_for_file_close__compute_fd_heights_real(H5C_cache_entry_
                                                                 uint32_t           fd_height);
 static herr_t H5C__prep_for_file_close__setup_image_entries_array(H5C_t *cache_ptr);
 static herr_t H5C__prep_for_file_close__scan_entries(const H5F_t *f, H5C_t *cache_ptr);
+static herr_t H5C__prep_for_file_close__compress_image_entries(H5C_t *cache_ptr);
 static herr_t H5C__reconstruct_cache_contents(H5F_t *f, H5C_t *cache_ptr);
-static H5C_cache_entry_t *H5C__reconstruct_cache_entry(const H5F_t *f, H5C_t *cache_ptr, const uint8_t **buf);
+static H5C_cache_entry_t *H5C__reconstruct_cache_entry(const H5F_t *f, H5C_t *cache_ptr, const uint8_t **buf,
+                                                       const uint8_t **stored_buf);
+static herr_t             H5C__load_cache_image_index(H5F_t *f, H5C_t *cache_ptr, hbool_t *loaded);
+static int                H5C__image_entry_addr_cmp(const void *_entry1, const void *_entry2);
 static herr_t             H5C__write_cache_image_superblock_msg(H5F_t *f, hbool_t create);
 static herr_t             H5C__read_cache_image(H5F_t *f, H5C_t *cache_ptr);
 static herr_t             H5C__write_cache_image(H5F_t *f, const H5C_t *cache_ptr);
@@ -255,7 +272,9 @@ H5C__construct_cache_image_buffer(H5F_t *f, H5C_t *cache_ptr)
         HGOTO_ERROR(H5E_CACHE, H5E_CANTENCODE, FAIL, "header image construction failed")
     HDassert((size_t)(p - (uint8_t *)cache_ptr->image_buffer) < cache_ptr->image_data_len);
 
-    /* Construct the cache entry images */
+    /* Construct the cache entry images, or the index of the entries when
+     * their images are stored separately
+     */
     for (u = 0; u < cache_ptr->num_entries_in_image; u++)
         if (H5C__encode_cache_image_entry(f, cache_ptr, &p, u) < 0)
             HGOTO_ERROR(H5E_CACHE, H5E_CANTENCODE, FAIL, "entry image construction failed")
@@ -263,10 +282,31 @@ H5C__construct_cache_image_buffer(H5F_t *f, H5C_t *cache_ptr)
 
     /* Construct the adaptive resize status image -- not yet */
 
-    /* Compute the checksum and encode */
-    chksum = H5_checksum_metadata(cache_ptr->image_buffer,
-                                  (size_t)(cache_ptr->image_data_len - H5F_SIZEOF_CHKSUM), 0);
-    UINT32ENCODE(p, chksum);
+    if (H5C__MDCI_BLOCK_VERSION(cache_ptr) == H5C__MDCI_BLOCK_VERSION_1) {
+        HDassert((size_t)(p - (uint8_t *)cache_ptr->image_buffer) ==
+                 H5C__cache_image_block_header_size(f, H5C__MDCI_BLOCK_VERSION_1) +
+                     cache_ptr->image_index_size);
+
+        /* Compute the checksum of the header and index, and encode */
+        chksum = H5_checksum_metadata(cache_ptr->image_buffer,
+                                      (size_t)(p - (uint8_t *)cache_ptr->image_buffer), 0);
+        UINT32ENCODE(p, chksum);
+
+        /* Append the stored entry images, in the order of the index */
+        for (u = 0; u < cache_ptr->num_entries_in_image; u++) {
+            const H5C_image_entry_t *ie_ptr = &((cache_ptr->image_entries)[u]);
+
+            H5MM_memcpy(p, ie_ptr->stored_image_ptr ? ie_ptr->stored_image_ptr : ie_ptr->image_ptr,
+                        ie_ptr->stored_size);
+            p += ie_ptr->stored_size;
+        } /* end for */
+    }     /* end if */
+    else {
+        /* Compute the checksum and encode */
+        chksum = H5_checksum_metadata(cache_ptr->image_buffer,
+                                      (size_t)(cache_ptr->image_data_len - H5F_SIZEOF_CHKSUM), 0);
+        UINT32ENCODE(p, chksum);
+    } /* end else */
     HDassert((size_t)(p - (uint8_t *)cache_ptr->image_buffer) == cache_ptr->image_data_len);
     HDassert((size_t)(p - (uint8_t *)cache_ptr->image_buffer) <= cache_ptr->image_len);
 
@@ -277,6 +317,7 @@ H5C__construct_cache_image_buffer(H5F_t *f, H5C_t *cache_ptr)
     {
         uint32_t       old_chksum;
         const uint8_t *q;
+        const uint8_t *stored_q       = NULL;
         H5C_t *        fake_cache_ptr = NULL;
         unsigned       v;
         herr_t         status; /* Status from decoding */
@@ -293,6 +334,11 @@ H5C__construct_cache_image_buffer(H5F_t *f, H5C_t *cache_ptr)
 
         HDassert(NULL != p);
         HDassert(fake_cache_ptr->num_entries_in_image == cache_ptr->num_entries_in_image);
+        HDassert(fake_cache_ptr->image_index_size == cache_ptr->image_index_size);
+
+        /* Entry images follow the index in an indexed image */
+        if (H5C__MDCI_BLOCK_VERSION(fake_cache_ptr) == H5C__MDCI_BLOCK_VERSION_1)
+            stored_q = q + fake_cache_ptr->image_index_size + H5F_SIZEOF_CHKSUM;
 
         fake_cache_ptr->image_entries = (H5C_image_entry_t *)H5MM_malloc(
             sizeof(H5C_image_entry_t) * (size_t)(fake_cache_ptr->num_entries_in_image + 1));
@@ -304,7 +350,7 @@ H5C__construct_cache_image_buffer(H5F_t *f, H5C_t *cache_ptr)
 
             /* touch up f->shared->cache to satisfy sanity checks... */
             f->shared->cache = fake_cache_ptr;
-            status           = H5C__decode_cache_image_entry(f, fake_cache_ptr, &q, u);
+            status = H5C__decode_cache_image_entry(f, fake_cache_ptr, &q, u, stored_q ? &stored_q : NULL);
             HDassert(status >= 0);
 
             /* ...and then return f->shared->cache to its correct value */
@@ -350,13 +396,21 @@ H5C__construct_cache_image_buffer(H5F_t *f, H5C_t *cache_ptr)
                 H5MM_xfree((fake_cache_ptr->image_entries)[u].image_ptr);
         } /* end for */
 
-        HDassert((size_t)(q - (const uint8_t *)cache_ptr->image_buffer) ==
-                 cache_ptr->image_data_len - H5F_SIZEOF_CHKSUM);
+        if (stored_q) {
+            HDassert((size_t)(q - (const uint8_t *)cache_ptr->image_buffer) ==
+                     H5C__cache_image_block_header_size(f, H5C__MDCI_BLOCK_VERSION_1) +
+                         cache_ptr->image_index_size);
+            HDassert((size_t)(stored_q - (const uint8_t *)cache_ptr->image_buffer) ==
+                     cache_ptr->image_data_len);
+        } /* end if */
+        else
+            HDassert((size_t)(q - (const uint8_t *)cache_ptr->image_buffer) ==
+                     cache_ptr->image_data_len - H5F_SIZEOF_CHKSUM);
 
         /* compute the checksum  */
         old_chksum = chksum;
         chksum     = H5_checksum_metadata(cache_ptr->image_buffer,
-                                      (size_t)(cache_ptr->image_data_len - H5F_SIZEOF_CHKSUM), 0);
+                                      (size_t)(q - (const uint8_t *)cache_ptr->image_buffer), 0);
         HDassert(chksum == old_chksum);
 
         fake_cache_ptr->image_entries = (H5C_image_entry_t *)H5MM_xfree(fake_cache_ptr->image_entries);
@@ -650,6 +704,11 @@ H5C__deserialize_prefetched_entry(H5F_t *f, H5C_t *cache_ptr, H5C_cache_entry_t
     pf_entry_ptr->coll_next = NULL;
     pf_entry_ptr->coll_prev = NULL;
 #endif /* H5_HAVE_PARALLEL */
+    ds_entry_ptr->rp_hot      = FALSE;
+    ds_entry_ptr->rp_load_seq = pf_entry_ptr->rp_load_seq;
+
+    ds_entry_ptr->shared_ref_count = 0;
+    ds_entry_ptr->shared_retired   = FALSE;
 
     /* Initialize cache image related fields */
     ds_entry_ptr->include_in_image     = FALSE;
@@ -850,6 +909,9 @@ H5C__free_image_entries_array(H5C_t *cache_ptr)
             /* Free the image */
             ie_ptr->image_ptr = H5MM_xfree(ie_ptr->image_ptr);
 
+            /* Free the compressed image, if any */
+            ie_ptr->stored_image_ptr = H5MM_xfree(ie_ptr->stored_image_ptr);
+
             /* Set magic field to bad magic so we can detect freed entries */
             ie_ptr->magic = H5C_IMAGE_ENTRY_T_BAD_MAGIC;
         } /* end for */
@@ -1072,24 +1134,41 @@ H5C__load_cache_image(H5F_t *f)
      * silently.
      */
     if (H5F_addr_defined(cache_ptr->image_addr)) {
+        hbool_t index_loaded = FALSE; /* Whether only the index of the image was loaded */
+
         /* Sanity checks */
         HDassert(cache_ptr->image_len > 0);
         HDassert(cache_ptr->image_buffer == NULL);
+        HDassert(cache_ptr->image_index == NULL);
+
+        /* When the file is opened R/O, only the index of an indexed image
+         * is loaded, and the images of its entries are read from the image
+         * block as the entries are protected.  The image block is freed
+         * below when the file is opened R/W, SWMR readers must see the
+         * changes of the writer, and the processes of a parallel computation
+         * share the image contents, so the whole image is loaded otherwise.
+         */
+        if (!cache_ptr->delete_image && !(H5F_INTENT(f) & H5F_ACC_SWMR_READ) && NULL == cache_ptr->aux_ptr)
+            if (H5C__load_cache_image_index(f, cache_ptr, &index_loaded) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTLOAD, FAIL, "Can't load metadata cache image index")
 
-        /* Allocate space for the image */
-        if (NULL == (cache_ptr->image_buffer = H5MM_malloc(cache_ptr->image_len + 1)))
-            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for cache image buffer")
+        if (!index_loaded) {
+            /* Allocate space for the image */
+            if (NULL == (cache_ptr->image_buffer = H5MM_malloc(cache_ptr->image_len + 1)))
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for cache image buffer")
 
-        /* Load the image from file */
-        if (H5C__read_cache_image(f, cache_ptr) < 0)
-            HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "Can't read metadata cache image block")
+            /* Load the image from file */
+            if (H5C__read_cache_image(f, cache_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "Can't read metadata cache image block")
 
-        /* Reconstruct cache contents, from image */
-        if (H5C__reconstruct_cache_contents(f, cache_ptr) < 0)
-            HGOTO_ERROR(H5E_CACHE, H5E_CANTDECODE, FAIL, "Can't reconstruct cache contents from image block")
+            /* Reconstruct cache contents, from image */
+            if (H5C__reconstruct_cache_contents(f, cache_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTDECODE, FAIL,
+                            "Can't reconstruct cache contents from image block")
 
-        /* Free the image buffer */
-        cache_ptr->image_buffer = H5MM_xfree(cache_ptr->image_buffer);
+            /* Free the image buffer */
+            cache_ptr->image_buffer = H5MM_xfree(cache_ptr->image_buffer);
+        } /* end if */
 
         /* Update stats -- must do this now, as we are about
          * to discard the size of the cache image.
@@ -1115,6 +1194,248 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__load_cache_image() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5C__load_cache_image_index
+ *
+ * Purpose:     Read the header of the metadata cache image block and, if
+ *              the images of its entries are stored apart from their
+ *              index, read and decode the index alone into
+ *              cache_ptr->image_index, sorted by address.
+ *
+ *              Flush dependencies are not kept in the index, as they
+ *              only matter when the file is opened R/W.
+ *
+ * Return:      Non-negative on success/Negative on failure.  *LOADED is
+ *              set to TRUE if the index was loaded, and to FALSE if the
+ *              image block has no index.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__load_cache_image_index(H5F_t *f, H5C_t *cache_ptr, hbool_t *loaded)
+{
+    H5C_image_entry_t *image_entries = NULL; /* Index of the image */
+    uint8_t *          buf           = NULL; /* Buffer for the header and index */
+    uint8_t *          new_buf;              /* Reallocated buffer */
+    const uint8_t *    p;                    /* Pointer into buffer */
+    size_t             header_len;           /* Size of the image block header */
+    size_t             index_len;            /* Size of the header, index and checksum */
+    hsize_t            stored_offset;        /* Offset of the next stored entry image */
+    uint32_t           stored_chksum;        /* Stored checksum of the header and index */
+    uint32_t           computed_chksum;      /* Computed checksum of the header and index */
+    unsigned           u;                    /* Local index variable */
+    herr_t             ret_value = SUCCEED;  /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    HDassert(cache_ptr == f->shared->cache);
+    HDassert(H5F_addr_defined(cache_ptr->image_addr));
+    HDassert(cache_ptr->image_entries == NULL);
+    HDassert(loaded);
+
+    *loaded = FALSE;
+
+    /* Read the image block header */
+    header_len = H5C__cache_image_block_header_size(f, H5C__MDCI_BLOCK_VERSION_1);
+    if (cache_ptr->image_len < header_len)
+        HGOTO_DONE(SUCCEED)
+    if (NULL == (buf = (uint8_t *)H5MM_malloc(header_len)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for cache image index buffer")
+    if (H5F_block_read(f, H5FD_MEM_SUPER, cache_ptr->image_addr, header_len, buf) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "Can't read metadata cache image header")
+    p = buf;
+    if (H5C__decode_cache_image_header(f, cache_ptr, &p) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTDECODE, FAIL, "cache image header decode failed")
+    if (H5C__MDCI_BLOCK_VERSION(cache_ptr) != H5C__MDCI_BLOCK_VERSION_1)
+        HGOTO_DONE(SUCCEED)
+
+    /* Read the index and its checksum, which follow the header */
+    index_len = header_len + (size_t)cache_ptr->image_index_size + H5F_SIZEOF_CHKSUM;
+    if (index_len > cache_ptr->image_data_len)
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Bad metadata cache image index size")
+    if (NULL == (new_buf = (uint8_t *)H5MM_realloc(buf, index_len)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for cache image index buffer")
+    buf = new_buf;
+    if (H5F_block_read(f, H5FD_MEM_SUPER, cache_ptr->image_addr + header_len, index_len - header_len,
+                       buf + header_len) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "Can't read metadata cache image index")
+
+    H5C__UPDATE_STATS_FOR_CACHE_IMAGE_READ(cache_ptr)
+
+    H5F_get_checksums(buf, index_len, &stored_chksum, &computed_chksum);
+    if (stored_chksum != computed_chksum)
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Bad metadata cache image index checksum")
+
+    /* Decode the index, locating the stored image of each entry */
+    if (NULL == (image_entries = (H5C_image_entry_t *)H5MM_calloc(
+                     sizeof(H5C_image_entry_t) * (size_t)cache_ptr->num_entries_in_image)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for cache image index")
+    for (u = 0; u < cache_ptr->num_entries_in_image; u++)
+        image_entries[u].magic = H5C_IMAGE_ENTRY_T_MAGIC;
+    cache_ptr->image_entries = image_entries;
+
+    p             = buf + header_len;
+    stored_offset = (hsize_t)index_len;
+    for (u = 0; u < cache_ptr->num_entries_in_image; u++) {
+        H5C_image_entry_t *ie_ptr = &image_entries[u];
+
+        if (H5C__decode_cache_image_entry(f, cache_ptr, &p, u, NULL) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTDECODE, FAIL, "cache image index entry decode failed")
+
+        ie_ptr->fd_parent_addrs = (haddr_t *)H5MM_xfree(ie_ptr->fd_parent_addrs);
+        ie_ptr->fd_parent_count = 0;
+
+        ie_ptr->stored_offset = stored_offset;
+        stored_offset += ie_ptr->stored_size;
+    } /* end for */
+    if ((size_t)(p - buf) != header_len + cache_ptr->image_index_size)
+        HGOTO_ERROR(H5E_CACHE, H5E_BADSIZE, FAIL, "Bad metadata cache image index size")
+    if (stored_offset != cache_ptr->image_data_len)
+        HGOTO_ERROR(H5E_CACHE, H5E_BADSIZE, FAIL, "Bad metadata cache image data length")
+
+    /* Sort the index by address, and check that its entries don't overlap */
+    HDqsort(image_entries, (size_t)cache_ptr->num_entries_in_image, sizeof(H5C_image_entry_t),
+            H5C__image_entry_addr_cmp);
+    for (u = 1; u < cache_ptr->num_entries_in_image; u++)
+        if (H5F_addr_gt(image_entries[u - 1].addr + image_entries[u - 1].size, image_entries[u].addr))
+            HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "overlapping entries in metadata cache image")
+
+    cache_ptr->image_index          = image_entries;
+    cache_ptr->image_index_nentries = cache_ptr->num_entries_in_image;
+    image_entries                   = NULL;
+    *loaded                         = TRUE;
+
+done:
+    cache_ptr->image_entries = NULL;
+    if (image_entries) {
+        for (u = 0; u < cache_ptr->num_entries_in_image; u++)
+            H5MM_xfree(image_entries[u].fd_parent_addrs);
+        H5MM_xfree(image_entries);
+    } /* end if */
+    H5MM_xfree(buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__load_cache_image_index() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__find_image_index_entry
+ *
+ * Purpose:     Look up the entry holding the byte of the file at ADDR in
+ *              the index of a lazily loaded metadata cache image.
+ *
+ * Return:      Pointer to the entry, or NULL if there's none
+ *
+ *-------------------------------------------------------------------------
+ */
+const H5C_image_entry_t *
+H5C__find_image_index_entry(const H5C_t *cache_ptr, haddr_t addr)
+{
+    size_t                   lo        = 0;    /* Low bound of the search */
+    size_t                   hi;               /* High bound of the search */
+    const H5C_image_entry_t *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    hi = (size_t)cache_ptr->image_index_nentries;
+    while (lo < hi) {
+        size_t                   mid    = lo + ((hi - lo) / 2);
+        const H5C_image_entry_t *ie_ptr = &cache_ptr->image_index[mid];
+
+        if (H5F_addr_lt(addr, ie_ptr->addr))
+            hi = mid;
+        else if (H5F_addr_ge(addr, ie_ptr->addr + ie_ptr->size))
+            lo = mid + 1;
+        else {
+            ret_value = ie_ptr;
+            break;
+        } /* end else */
+    }     /* end while */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__find_image_index_entry() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__read_image_index_entry
+ *
+ * Purpose:     Read the stored image of an entry in the index of a lazily
+ *              loaded metadata cache image from the image block, verify
+ *              it, and decompress it as needed into IMAGE, which must be
+ *              large enough to hold the entry.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C__read_image_index_entry(H5F_t *f, const H5C_image_entry_t *ie_ptr, void *image)
+{
+    H5C_t *  cache_ptr;           /* Pointer to the cache */
+    uint8_t *stored    = NULL;    /* Buffer for a compressed image */
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(f);
+    HDassert(f->shared);
+    cache_ptr = f->shared->cache;
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->image_index);
+    HDassert(H5F_addr_defined(cache_ptr->image_addr));
+    HDassert(ie_ptr);
+    HDassert(ie_ptr->magic == H5C_IMAGE_ENTRY_T_MAGIC);
+    HDassert(image);
+
+    /* Images stored raw are read in place */
+    if (ie_ptr->stored_size < ie_ptr->size)
+        if (NULL == (stored = (uint8_t *)H5MM_malloc(ie_ptr->stored_size)))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for stored entry image")
+
+    if (H5F_block_read(f, H5FD_MEM_SUPER, cache_ptr->image_addr + ie_ptr->stored_offset, ie_ptr->stored_size,
+                       stored ? stored : image) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_READERROR, FAIL, "Can't read entry image from metadata cache image")
+
+    if (H5C__decode_stored_image(stored ? stored : (const uint8_t *)image, ie_ptr->stored_size,
+                                 ie_ptr->stored_chksum, image, ie_ptr->size) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTDECODE, FAIL, "Can't decode stored entry image")
+
+done:
+    H5MM_xfree(stored);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__read_image_index_entry() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__free_image_index
+ *
+ * Purpose:     Free the index of a lazily loaded metadata cache image.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C__free_image_index(H5C_t *cache_ptr)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    cache_ptr->image_index          = (H5C_image_entry_t *)H5MM_xfree(cache_ptr->image_index);
+    cache_ptr->image_index_nentries = 0;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5C__free_image_index() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5C_load_cache_image_on_next_protect()
  *
@@ -1220,6 +1541,41 @@ H5C__image_entry_cmp(const void *_entry1, const void *_entry2)
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__image_entry_cmp() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5C__image_entry_addr_cmp
+ *
+ * Purpose:     Comparison callback for qsort(3) on image entries, sorting
+ *              them by address.
+ *
+ * Return:      An integer less than, equal to, or greater than zero if the
+ *              first entry is considered to be respectively less than,
+ *              equal to, or greater than the second.
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5C__image_entry_addr_cmp(const void *_entry1, const void *_entry2)
+{
+    const H5C_image_entry_t *entry1 =
+        (const H5C_image_entry_t *)_entry1; /* Pointer to first image entry to compare */
+    const H5C_image_entry_t *entry2 =
+        (const H5C_image_entry_t *)_entry2; /* Pointer to second image entry to compare */
+    int ret_value = 0;                      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(entry1);
+    HDassert(entry2);
+
+    if (H5F_addr_lt(entry1->addr, entry2->addr))
+        ret_value = -1;
+    else if (H5F_addr_gt(entry1->addr, entry2->addr))
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__image_entry_addr_cmp() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5C__prep_image_for_file_close
  *
@@ -1362,6 +1718,25 @@ H5C__prep_image_for_file_close(H5F_t *f, hbool_t *image_generated)
             HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "H5C__prep_for_file_close__scan_entries failed")
         HDassert(HADDR_UNDEF == cache_ptr->image_addr);
 
+        /* If there are any entries to be included in the metadata cache
+         * image, allocate, populate, and sort the image_entries array.
+         *
+         * Compress the entry images now if so configured, as that
+         * changes the size of the metadata cache image.
+         */
+        if (cache_ptr->num_entries_in_image > 0) {
+            if (H5C__prep_for_file_close__setup_image_entries_array(cache_ptr) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTINIT, FAIL, "can't setup image entries array.")
+
+            /* Sort the entries */
+            HDqsort(cache_ptr->image_entries, (size_t)cache_ptr->num_entries_in_image,
+                    sizeof(H5C_image_entry_t), H5C__image_entry_cmp);
+
+            if (cache_ptr->image_ctl.compress_image)
+                if (H5C__prep_for_file_close__compress_image_entries(cache_ptr) < 0)
+                    HGOTO_ERROR(H5E_CACHE, H5E_CANTFILTER, FAIL, "can't compress image entries")
+        } /* end if */
+
 #ifdef H5_HAVE_PARALLEL
         /* In the parallel case, overwrite the image_len with the
          * value computed by process 0.
@@ -1483,8 +1858,7 @@ H5C__prep_image_for_file_close(H5F_t *f, hbool_t *image_generated)
          *   5) Flush dependency heights are calculated for all
          *      entries that will be included in the cache image.
          *
-         * If there are any entries to be included in the metadata cache
-         * image, allocate, populate, and sort the image_entries array.
+         *   6) The image_entries array is populated and sorted.
          *
          * If the metadata cache image will be empty, delete the
          * metadata cache image superblock extension message, set
@@ -1492,15 +1866,7 @@ H5C__prep_image_for_file_close(H5F_t *f, hbool_t *image_generated)
          * allow the file close to continue normally without the
          * unnecessary generation of the metadata cache image.
          */
-        if (cache_ptr->num_entries_in_image > 0) {
-            if (H5C__prep_for_file_close__setup_image_entries_array(cache_ptr) < 0)
-                HGOTO_ERROR(H5E_CACHE, H5E_CANTINIT, FAIL, "can't setup image entries array.")
-
-            /* Sort the entries */
-            HDqsort(cache_ptr->image_entries, (size_t)cache_ptr->num_entries_in_image,
-                    sizeof(H5C_image_entry_t), H5C__image_entry_cmp);
-        }      /* end if */
-        else { /* cancel creation of metadata cache image */
+        if (cache_ptr->num_entries_in_image == 0) { /* cancel creation of metadata cache image */
             HDassert(cache_ptr->image_entries == NULL);
 
             /* To avoid breaking the control flow tests, only delete
@@ -1670,8 +2036,9 @@ done:
 /*-------------------------------------------------------------------------
  * Function:    H5C__cache_image_block_entry_header_size
  *
- * Purpose:     Compute the size of the header of the metadata cache
- *		image block, and return the value.
+ * Purpose:     Compute the size of the header of an entry in a metadata
+ *		cache image block of the given version, and return the
+ *		value.
  *
  * Return:      Size of the header section of the metadata cache image
  *		block in bytes.
@@ -1682,7 +2049,7 @@ done:
  *-------------------------------------------------------------------------
  */
 static size_t
-H5C__cache_image_block_entry_header_size(const H5F_t *f)
+H5C__cache_image_block_entry_header_size(const H5F_t *f, unsigned version)
 {
     size_t ret_value = 0; /* Return value */
 
@@ -1699,6 +2066,9 @@ H5C__cache_image_block_entry_header_size(const H5F_t *f)
                          4 +                  /* index in LRU             */
                          H5F_SIZEOF_ADDR(f) + /* entry offset             */
                          H5F_SIZEOF_SIZE(f)); /* entry length             */
+    if (version >= H5C__MDCI_BLOCK_VERSION_1)
+        ret_value += (size_t)(H5F_SIZEOF_SIZE(f) + /* stored image length */
+                              H5F_SIZEOF_CHKSUM);  /* stored image checksum */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__cache_image_block_entry_header_size() */
@@ -1706,8 +2076,8 @@ H5C__cache_image_block_entry_header_size(const H5F_t *f)
 /*-------------------------------------------------------------------------
  * Function:    H5C__cache_image_block_header_size
  *
- * Purpose:     Compute the size of the header of the metadata cache
- *		image block, and return the value.
+ * Purpose:     Compute the size of the header of a metadata cache
+ *		image block of the given version, and return the value.
  *
  * Return:      Size of the header section of the metadata cache image
  *		block in bytes.
@@ -1718,7 +2088,7 @@ H5C__cache_image_block_entry_header_size(const H5F_t *f)
  *-------------------------------------------------------------------------
  */
 static size_t
-H5C__cache_image_block_header_size(const H5F_t *f)
+H5C__cache_image_block_header_size(const H5F_t *f, unsigned version)
 {
     size_t ret_value = 0; /* Return value */
 
@@ -1730,6 +2100,8 @@ H5C__cache_image_block_header_size(const H5F_t *f)
                          1 +                  /* flags               */
                          H5F_SIZEOF_SIZE(f) + /* image data length   */
                          4);                  /* num_entries         */
+    if (version >= H5C__MDCI_BLOCK_VERSION_1)
+        ret_value += (size_t)H5F_SIZEOF_SIZE(f); /* index length */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__cache_image_block_header_size() */
@@ -1778,7 +2150,7 @@ H5C__decode_cache_image_header(const H5F_t *f, H5C_t *cache_ptr, const uint8_t *
 
     /* Check version */
     version = *p++;
-    if (version != (uint8_t)H5C__MDCI_BLOCK_VERSION_0)
+    if (version != (uint8_t)H5C__MDCI_BLOCK_VERSION_0 && version != (uint8_t)H5C__MDCI_BLOCK_VERSION_1)
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Bad metadata cache image version")
 
     /* Decode flags */
@@ -1800,9 +2172,17 @@ H5C__decode_cache_image_header(const H5F_t *f, H5C_t *cache_ptr, const uint8_t *
     if (cache_ptr->num_entries_in_image == 0)
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Bad metadata cache entry count")
 
+    /* Read the length of the index of the entries, if they have one */
+    cache_ptr->image_index_size = 0;
+    if (version == (uint8_t)H5C__MDCI_BLOCK_VERSION_1) {
+        H5F_DECODE_LENGTH(f, p, cache_ptr->image_index_size);
+        if (cache_ptr->image_index_size == 0 || cache_ptr->image_index_size >= cache_ptr->image_data_len)
+            HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Bad metadata cache image index length")
+    } /* end if */
+
     /* Verify expected length of header */
     actual_header_len   = (size_t)(p - *buf);
-    expected_header_len = H5C__cache_image_block_header_size(f);
+    expected_header_len = H5C__cache_image_block_header_size(f, (unsigned)version);
     if (actual_header_len != expected_header_len)
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Bad header image len")
 
@@ -1813,8 +2193,6 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__decode_cache_image_header() */
 
-#ifndef NDEBUG
-
 /*-------------------------------------------------------------------------
  * Function:    H5C__decode_cache_image_entry()
  *
@@ -1827,6 +2205,11 @@ done:
  *		Advances the buffer pointer to the first byte
  *		after the entry, or unchanged on failure.
  *
+ *		In an indexed image, the entry image is loaded from
+ *		*STORED_BUF, which is advanced past it.  If STORED_BUF
+ *		is NULL, only the index entry is decoded, and
+ *		ie_ptr->image_ptr is left NULL.
+ *
  * Return:      Non-negative on success/Negative on failure
  *
  * Programmer:  John Mainzer
@@ -1835,16 +2218,19 @@ done:
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5C__decode_cache_image_entry(const H5F_t *f, const H5C_t *cache_ptr, const uint8_t **buf, unsigned entry_num)
+H5C__decode_cache_image_entry(const H5F_t *f, const H5C_t *cache_ptr, const uint8_t **buf, unsigned entry_num,
+                              const uint8_t **stored_buf)
 {
     hbool_t            is_dirty     = FALSE;
     hbool_t            in_lru       = FALSE; /* Only used in assertions */
     hbool_t            is_fd_parent = FALSE; /* Only used in assertions */
     hbool_t            is_fd_child  = FALSE; /* Only used in assertions */
     haddr_t            addr;
-    hsize_t            size = 0;
-    void *             image_ptr;
-    uint8_t            flags = 0;
+    hsize_t            size          = 0;
+    hsize_t            stored_size   = 0;
+    uint32_t           stored_chksum = 0;
+    void *             image_ptr     = NULL;
+    uint8_t            flags         = 0;
     uint8_t            type_id;
     uint8_t            ring;
     uint8_t            age;
@@ -1924,8 +2310,19 @@ H5C__decode_cache_image_entry(const H5F_t *f, const H5C_t *cache_ptr, const uint
     if (size == 0)
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "invalid entry size")
 
+    /* Decode stored image length and checksum */
+    if (H5C__MDCI_BLOCK_VERSION(cache_ptr) == H5C__MDCI_BLOCK_VERSION_1) {
+        H5F_DECODE_LENGTH(f, p, stored_size);
+        UINT32DECODE(p, stored_chksum);
+        if ((flags & H5C__MDCI_ENTRY_COMPRESSED_FLAG) ? (stored_size == 0 || stored_size >= size)
+                                                      : (stored_size != size))
+            HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "invalid stored entry size")
+    } /* end if */
+    else
+        stored_size = size;
+
     /* Verify expected length of entry image */
-    if ((size_t)(p - *buf) != H5C__cache_image_block_entry_header_size(f))
+    if ((size_t)(p - *buf) != H5C__cache_image_block_entry_header_size(f, H5C__MDCI_BLOCK_VERSION(cache_ptr)))
         HGOTO_ERROR(H5E_CACHE, H5E_BADSIZE, FAIL, "Bad entry image len")
 
     /* If parent count greater than zero, allocate array for parent
@@ -1934,7 +2331,7 @@ H5C__decode_cache_image_entry(const H5F_t *f, const H5C_t *cache_ptr, const uint
     if (fd_parent_count > 0) {
         int i; /* Local index variable */
 
-        if (NULL == (fd_parent_addrs = (haddr_t *)H5MM_malloc((size_t)(fd_parent_count)*H5F_SIZEOF_ADDR(f))))
+        if (NULL == (fd_parent_addrs = (haddr_t *)H5MM_malloc((size_t)(fd_parent_count) * sizeof(haddr_t))))
             HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for fd parent addrs buffer")
 
         for (i = 0; i < fd_parent_count; i++) {
@@ -1944,17 +2341,15 @@ H5C__decode_cache_image_entry(const H5F_t *f, const H5C_t *cache_ptr, const uint
         } /* end for */
     }     /* end if */
 
-    /* Allocate buffer for entry image */
-    if (NULL == (image_ptr = H5MM_malloc(size + H5C_IMAGE_EXTRA_SPACE)))
-        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for on disk image buffer")
+    if (H5C__MDCI_BLOCK_VERSION(cache_ptr) == H5C__MDCI_BLOCK_VERSION_0 || stored_buf) {
+        /* Allocate buffer for entry image */
+        if (NULL == (image_ptr = H5MM_malloc(size + H5C_IMAGE_EXTRA_SPACE)))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for on disk image buffer")
 
 #if H5C_DO_MEMORY_SANITY_CHECKS
-    H5MM_memcpy(((uint8_t *)image_ptr) + size, H5C_IMAGE_SANITY_VALUE, H5C_IMAGE_EXTRA_SPACE);
+        H5MM_memcpy(((uint8_t *)image_ptr) + size, H5C_IMAGE_SANITY_VALUE, H5C_IMAGE_EXTRA_SPACE);
 #endif /* H5C_DO_MEMORY_SANITY_CHECKS */
-
-    /* Copy the entry image from the cache image block */
-    H5MM_memcpy(image_ptr, p, size);
-    p += size;
+    }  /* end if */
 
     /* Copy data into target */
     ie_ptr->addr                 = addr;
@@ -1968,15 +2363,119 @@ H5C__decode_cache_image_entry(const H5F_t *f, const H5C_t *cache_ptr, const uint
     ie_ptr->fd_dirty_child_count = (uint64_t)fd_dirty_child_count;
     ie_ptr->fd_parent_count      = (uint64_t)fd_parent_count;
     ie_ptr->fd_parent_addrs      = fd_parent_addrs;
-    ie_ptr->image_ptr            = image_ptr;
+    ie_ptr->stored_size          = (size_t)stored_size;
+    ie_ptr->stored_chksum        = stored_chksum;
+
+    /* Copy the entry image from the cache image block */
+    if (H5C__MDCI_BLOCK_VERSION(cache_ptr) == H5C__MDCI_BLOCK_VERSION_0) {
+        H5MM_memcpy(image_ptr, p, size);
+        p += size;
+    } /* end if */
+    else if (stored_buf) {
+        if (H5C__decode_stored_image(*stored_buf, ie_ptr->stored_size, stored_chksum, image_ptr,
+                                     ie_ptr->size) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTDECODE, FAIL, "Can't decode stored entry image")
+        *stored_buf += stored_size;
+    } /* end else-if */
+    ie_ptr->image_ptr = image_ptr;
+    image_ptr         = NULL;
 
     /* Update buffer pointer */
     *buf = p;
 
 done:
+    H5MM_xfree(image_ptr);
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__decode_cache_image_entry() */
-#endif /* NDEBUG */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__image_pipeline
+ *
+ * Purpose:     Run the filter pipeline used to compress entry images in
+ *		a metadata cache image over *BUF, in the direction given
+ *		by FLAGS.  The arguments are those of H5Z_pipeline().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__image_pipeline(unsigned flags, unsigned *filter_mask, size_t *nbytes, size_t *buf_size, void **buf)
+{
+    H5O_pline_t pline        = H5O_CRT_PIPELINE_DEF;        /* Filter pipeline */
+    H5Z_cb_t    filter_cb    = {NULL, NULL};                /* Filter failure callback */
+    unsigned    cd_values[1] = {H5C__MDCI_DEFLATE_LEVEL}; /* Deflate level */
+    herr_t      ret_value    = SUCCEED;                     /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if (H5Z_append(&pline, H5Z_FILTER_DEFLATE, H5Z_FLAG_OPTIONAL, (size_t)1, cd_values) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTINIT, FAIL, "can't set up metadata cache image filter pipeline")
+
+    if (H5Z_pipeline(&pline, flags, filter_mask, H5Z_NO_EDC, filter_cb, nbytes, buf_size, buf) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTFILTER, FAIL, "metadata cache image filter pipeline failed")
+
+done:
+    if (H5O_msg_reset(H5O_PLINE_ID, &pline) < 0)
+        HDONE_ERROR(H5E_CACHE, H5E_CANTRESET, FAIL, "can't release metadata cache image filter pipeline")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__image_pipeline() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__decode_stored_image()
+ *
+ * Purpose:     Verify the STORED_SIZE byte image of an entry as stored
+ *		in an indexed metadata cache image, and decompress it as
+ *		needed into the SIZE byte buffer IMAGE.  STORED and IMAGE
+ *		may be the same buffer if the image is not compressed.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__decode_stored_image(const uint8_t *stored, size_t stored_size, uint32_t stored_chksum, void *image,
+                         size_t size)
+{
+    void * buf       = NULL;    /* Buffer for decompression */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(stored);
+    HDassert(stored_size > 0 && stored_size <= size);
+    HDassert(image);
+
+    if (H5_checksum_metadata(stored, stored_size, 0) != stored_chksum)
+        HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Bad metadata cache image entry checksum")
+
+    if (stored_size < size) {
+        unsigned filter_mask = 0;
+        size_t   nbytes      = stored_size;
+        size_t   buf_size    = stored_size;
+
+        if (NULL == (buf = H5MM_malloc(buf_size)))
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for entry image")
+        H5MM_memcpy(buf, stored, buf_size);
+
+        if (H5C__image_pipeline(H5Z_FLAG_REVERSE, &filter_mask, &nbytes, &buf_size, &buf) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTFILTER, FAIL, "can't decompress entry image")
+        if (nbytes != size)
+            HGOTO_ERROR(H5E_CACHE, H5E_BADSIZE, FAIL, "decompressed entry image has the wrong size")
+
+        H5MM_memcpy(image, buf, nbytes);
+    } /* end if */
+    else if ((const void *)stored != image)
+        H5MM_memcpy(image, stored, size);
+
+done:
+    H5MM_xfree(buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__decode_stored_image() */
 
 /*-------------------------------------------------------------------------
  * Function:    H5C__destroy_pf_entry_child_flush_deps()
@@ -2150,7 +2649,7 @@ H5C__encode_cache_image_header(const H5F_t *f, const H5C_t *cache_ptr, uint8_t *
     p += H5C__MDCI_BLOCK_SIGNATURE_LEN;
 
     /* write version */
-    *p++ = (uint8_t)H5C__MDCI_BLOCK_VERSION_0;
+    *p++ = (uint8_t)H5C__MDCI_BLOCK_VERSION(cache_ptr);
 
     /* setup and write flags */
 
@@ -2169,9 +2668,13 @@ H5C__encode_cache_image_header(const H5F_t *f, const H5C_t *cache_ptr, uint8_t *
     /* write num entries */
     UINT32ENCODE(p, cache_ptr->num_entries_in_image);
 
+    /* write the length of the index of the entries, if they have one */
+    if (H5C__MDCI_BLOCK_VERSION(cache_ptr) == H5C__MDCI_BLOCK_VERSION_1)
+        H5F_ENCODE_LENGTH(f, p, cache_ptr->image_index_size);
+
     /* verify expected length of header */
     actual_header_len   = (size_t)(p - *buf);
-    expected_header_len = H5C__cache_image_block_header_size(f);
+    expected_header_len = H5C__cache_image_block_header_size(f, H5C__MDCI_BLOCK_VERSION(cache_ptr));
     if (actual_header_len != expected_header_len)
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Bad header image len")
 
@@ -2189,6 +2692,10 @@ done:
  *		supplied buffer.  Updates buffer pointer to the first byte
  *		after the entry in the buffer, or unchanged on failure.
  *
+ *		In an indexed image, only the header of the entry and the
+ *		addresses of its flush dependency parents are encoded, and
+ *		its image is appended after the index.
+ *
  * Return:      Non-negative on success/Negative on failure
  *
  * Programmer:  John Mainzer
@@ -2239,6 +2746,8 @@ H5C__encode_cache_image_entry(H5F_t *f, H5C_t *cache_ptr, uint8_t **buf, unsigne
         flags |= H5C__MDCI_ENTRY_IS_FD_PARENT_FLAG;
     if (ie_ptr->fd_parent_count > 0)
         flags |= H5C__MDCI_ENTRY_IS_FD_CHILD_FLAG;
+    if (ie_ptr->stored_image_ptr)
+        flags |= H5C__MDCI_ENTRY_COMPRESSED_FLAG;
     *p++ = flags;
 
     /* Encode ring */
@@ -2271,17 +2780,25 @@ H5C__encode_cache_image_entry(H5F_t *f, H5C_t *cache_ptr, uint8_t **buf, unsigne
     /* Encode entry length */
     H5F_ENCODE_LENGTH(f, p, ie_ptr->size);
 
+    /* Encode stored image length and checksum */
+    if (H5C__MDCI_BLOCK_VERSION(cache_ptr) == H5C__MDCI_BLOCK_VERSION_1) {
+        H5F_ENCODE_LENGTH(f, p, ie_ptr->stored_size);
+        UINT32ENCODE(p, ie_ptr->stored_chksum);
+    } /* end if */
+
     /* Verify expected length of entry image */
-    if ((size_t)(p - *buf) != H5C__cache_image_block_entry_header_size(f))
+    if ((size_t)(p - *buf) != H5C__cache_image_block_entry_header_size(f, H5C__MDCI_BLOCK_VERSION(cache_ptr)))
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Bad entry image len")
 
     /* Encode dependency parent offsets -- if any */
     for (u = 0; u < ie_ptr->fd_parent_count; u++)
         H5F_addr_encode(f, &p, ie_ptr->fd_parent_addrs[u]);
 
-    /* Copy entry image */
-    H5MM_memcpy(p, ie_ptr->image_ptr, ie_ptr->size);
-    p += ie_ptr->size;
+    /* Copy entry image, unless it's stored after the index */
+    if (H5C__MDCI_BLOCK_VERSION(cache_ptr) == H5C__MDCI_BLOCK_VERSION_0) {
+        H5MM_memcpy(p, ie_ptr->image_ptr, ie_ptr->size);
+        p += ie_ptr->size;
+    } /* end if */
 
     /* Update buffer pointer */
     *buf = p;
@@ -2776,7 +3293,9 @@ H5C__prep_for_file_close__scan_entries(const H5F_t *f, H5C_t *cache_ptr)
     int                lru_rank                         = 1;
     uint32_t           num_entries_tentatively_in_image = 0;
     uint32_t           num_entries_in_image             = 0;
+    unsigned           version;
     size_t             image_len;
+    size_t             index_len = 0;
     size_t             entry_header_len;
     size_t             fd_parents_list_len;
     int                i;
@@ -2794,11 +3313,17 @@ H5C__prep_for_file_close__scan_entries(const H5F_t *f, H5C_t *cache_ptr)
     HDassert(cache_ptr->close_warning_received);
     HDassert(cache_ptr->pl_len == 0);
 
+    /* Entry images are stored after an index of the entries if they're
+     * to be compressed.
+     */
+    version =
+        cache_ptr->image_ctl.compress_image ? H5C__MDCI_BLOCK_VERSION_1 : H5C__MDCI_BLOCK_VERSION_0;
+
     /* Initialize image len to the size of the metadata cache image block
      * header.
      */
-    image_len        = H5C__cache_image_block_header_size(f);
-    entry_header_len = H5C__cache_image_block_entry_header_size(f);
+    image_len        = H5C__cache_image_block_header_size(f, version);
+    entry_header_len = H5C__cache_image_block_entry_header_size(f, version);
 
     /* Scan each entry on the index list */
     entry_ptr = cache_ptr->il_head;
@@ -2932,6 +3457,7 @@ H5C__prep_for_file_close__scan_entries(const H5F_t *f, H5C_t *cache_ptr)
                 fd_parents_list_len = (size_t)0;
 
             image_len += entry_header_len + fd_parents_list_len + entry_ptr->size;
+            index_len += entry_header_len + fd_parents_list_len;
             num_entries_in_image++;
         } /* end if */
 
@@ -2987,13 +3513,97 @@ H5C__prep_for_file_close__scan_entries(const H5F_t *f, H5C_t *cache_ptr)
     } /* end while */
     HDassert(entries_visited == cache_ptr->LRU_list_len);
 
+    /* The checksum of an indexed image covers only its header and
+     * index, as each entry image has its own checksum.
+     */
     image_len += H5F_SIZEOF_CHKSUM;
-    cache_ptr->image_data_len = image_len;
+    cache_ptr->image_data_len   = image_len;
+    cache_ptr->image_index_size = (version == H5C__MDCI_BLOCK_VERSION_1) ? index_len : 0;
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__prep_for_file_close__scan_entries() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5C__prep_for_file_close__compress_image_entries
+ *
+ * Purpose:     Compress the images of the entries in the image_entries
+ *		array where that makes them smaller, record the size and
+ *		checksum of each image as stored in the metadata cache
+ *		image, and reduce the size of the metadata cache image
+ *		block accordingly.
+ *
+ *		If the deflate filter isn't available, the images are
+ *		stored uncompressed, and only gain an index.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__prep_for_file_close__compress_image_entries(H5C_t *cache_ptr)
+{
+    htri_t   deflate_avail;       /* Whether the deflate filter is available */
+    void *   buf = NULL;          /* Buffer for compression */
+    unsigned u;                   /* Local index variable */
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(cache_ptr->image_ctl.compress_image);
+    HDassert(cache_ptr->image_entries);
+    HDassert(cache_ptr->image_index_size > 0);
+
+    if ((deflate_avail = H5Z_filter_avail(H5Z_FILTER_DEFLATE)) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTGET, FAIL, "can't check for deflate filter")
+
+    for (u = 0; u < cache_ptr->num_entries_in_image; u++) {
+        H5C_image_entry_t *ie_ptr = &((cache_ptr->image_entries)[u]);
+
+        HDassert(ie_ptr->magic == H5C_IMAGE_ENTRY_T_MAGIC);
+        HDassert(ie_ptr->image_ptr);
+        HDassert(NULL == ie_ptr->stored_image_ptr);
+
+        ie_ptr->stored_size = ie_ptr->size;
+
+        if (deflate_avail) {
+            unsigned filter_mask = 0;
+            size_t   nbytes      = ie_ptr->size;
+            size_t   buf_size    = ie_ptr->size;
+
+            if (NULL == (buf = H5MM_malloc(buf_size)))
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed for entry image")
+            H5MM_memcpy(buf, ie_ptr->image_ptr, buf_size);
+
+            if (H5C__image_pipeline(0, &filter_mask, &nbytes, &buf_size, &buf) < 0)
+                HGOTO_ERROR(H5E_CACHE, H5E_CANTFILTER, FAIL, "can't compress entry image")
+
+            /* Keep the compressed image only if it's smaller */
+            if (0 == filter_mask && nbytes < ie_ptr->size) {
+                ie_ptr->stored_image_ptr = buf;
+                ie_ptr->stored_size      = nbytes;
+                buf                      = NULL;
+
+                cache_ptr->image_data_len -= (hsize_t)(ie_ptr->size - nbytes);
+            } /* end if */
+            else
+                buf = H5MM_xfree(buf);
+        } /* end if */
+
+        ie_ptr->stored_chksum =
+            H5_checksum_metadata(ie_ptr->stored_image_ptr ? ie_ptr->stored_image_ptr : ie_ptr->image_ptr,
+                                 ie_ptr->stored_size, 0);
+    } /* end for */
+
+done:
+    H5MM_xfree(buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__prep_for_file_close__compress_image_entries() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5C__reconstruct_cache_contents()
  *
@@ -3016,6 +3626,7 @@ H5C__reconstruct_cache_contents(H5F_t *f, H5C_t *cache_ptr)
     H5C_cache_entry_t *pf_entry_ptr;        /* Pointer to prefetched entry */
     H5C_cache_entry_t *parent_ptr;          /* Pointer to parent of prefetched entry */
     const uint8_t *    p;                   /* Pointer into image buffer */
+    const uint8_t *    stored_p = NULL;     /* Pointer to stored entry images in image buffer */
     unsigned           u, v;                /* Local index variable */
     herr_t             ret_value = SUCCEED; /* Return value */
 
@@ -3041,12 +3652,31 @@ H5C__reconstruct_cache_contents(H5F_t *f, H5C_t *cache_ptr)
     HDassert(cache_ptr->image_data_len <= cache_ptr->image_len);
     HDassert(cache_ptr->num_entries_in_image > 0);
 
+    /* Verify the index of an indexed image, and locate the entry images */
+    if (H5C__MDCI_BLOCK_VERSION(cache_ptr) == H5C__MDCI_BLOCK_VERSION_1) {
+        size_t   index_len; /* Size of the header and index */
+        uint32_t stored_chksum;
+        uint32_t computed_chksum;
+
+        index_len = (size_t)(p - (uint8_t *)cache_ptr->image_buffer) + (size_t)cache_ptr->image_index_size;
+        if ((index_len + H5F_SIZEOF_CHKSUM) > cache_ptr->image_data_len)
+            HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Bad metadata cache image index size")
+
+        H5F_get_checksums((const uint8_t *)cache_ptr->image_buffer, index_len + H5F_SIZEOF_CHKSUM,
+                          &stored_chksum, &computed_chksum);
+        if (stored_chksum != computed_chksum)
+            HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, FAIL, "Bad metadata cache image index checksum")
+
+        stored_p = (const uint8_t *)cache_ptr->image_buffer + index_len + H5F_SIZEOF_CHKSUM;
+    } /* end if */
+
     /* Reconstruct entries in image */
     for (u = 0; u < cache_ptr->num_entries_in_image; u++) {
         /* Create the prefetched entry described by the ith
          * entry in cache_ptr->image_entrise.
          */
-        if (NULL == (pf_entry_ptr = H5C__reconstruct_cache_entry(f, cache_ptr, &p)))
+        if (NULL ==
+            (pf_entry_ptr = H5C__reconstruct_cache_entry(f, cache_ptr, &p, stored_p ? &stored_p : NULL)))
             HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "reconstruction of cache entry failed")
 
         /* Note that we make no checks on available cache space before
@@ -3104,6 +3734,10 @@ H5C__reconstruct_cache_contents(H5F_t *f, H5C_t *cache_ptr)
         } /* end for */
     }     /* end for */
 
+    if (stored_p &&
+        (size_t)(stored_p - (const uint8_t *)cache_ptr->image_buffer) != cache_ptr->image_data_len)
+        HGOTO_ERROR(H5E_CACHE, H5E_BADSIZE, FAIL, "Bad metadata cache image data length")
+
 #ifndef NDEBUG
     /* Scan the cache entries, and verify that each entry has
      * the expected flush dependency status.
@@ -3205,6 +3839,10 @@ done:
  * Purpose:     Allocate a prefetched metadata cache entry and initialize
  *		it from image buffer.
  *
+ *		In an indexed image, the entry image is decoded from
+ *		*STORED_BUF, which is advanced past it.  STORED_BUF is
+ *		NULL otherwise.
+ *
  *		Return a pointer to the newly allocated cache entry,
  *		or NULL on failure.
  *
@@ -3217,11 +3855,14 @@ done:
  *-------------------------------------------------------------------------
  */
 static H5C_cache_entry_t *
-H5C__reconstruct_cache_entry(const H5F_t *f, H5C_t *cache_ptr, const uint8_t **buf)
+H5C__reconstruct_cache_entry(const H5F_t *f, H5C_t *cache_ptr, const uint8_t **buf,
+                             const uint8_t **stored_buf)
 {
-    H5C_cache_entry_t *pf_entry_ptr = NULL; /* Reconstructed cache entry */
-    uint8_t            flags        = 0;
-    hbool_t            is_dirty     = FALSE;
+    H5C_cache_entry_t *pf_entry_ptr  = NULL; /* Reconstructed cache entry */
+    uint8_t            flags         = 0;
+    hbool_t            is_dirty      = FALSE;
+    hsize_t            stored_size   = 0;
+    uint32_t           stored_chksum = 0;
 #ifndef NDEBUG /* only used in assertions */
     hbool_t in_lru       = FALSE;
     hbool_t is_fd_parent = FALSE;
@@ -3238,6 +3879,7 @@ H5C__reconstruct_cache_entry(const H5F_t *f, H5C_t *cache_ptr, const uint8_t **b
     HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
     HDassert(cache_ptr->num_entries_in_image > 0);
     HDassert(buf && *buf);
+    HDassert((H5C__MDCI_BLOCK_VERSION(cache_ptr) == H5C__MDCI_BLOCK_VERSION_1) == (stored_buf != NULL));
 
     /* Key R/W access off of whether the image will be deleted */
     file_is_rw = cache_ptr->delete_image;
@@ -3318,8 +3960,18 @@ H5C__reconstruct_cache_entry(const H5F_t *f, H5C_t *cache_ptr, const uint8_t **b
     if (pf_entry_ptr->size == 0)
         HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, NULL, "invalid entry size")
 
+    /* Decode stored image length and checksum */
+    if (stored_buf) {
+        H5F_DECODE_LENGTH(f, p, stored_size);
+        UINT32DECODE(p, stored_chksum);
+        if ((flags & H5C__MDCI_ENTRY_COMPRESSED_FLAG)
+                ? (stored_size == 0 || stored_size >= pf_entry_ptr->size)
+                : (stored_size != pf_entry_ptr->size))
+            HGOTO_ERROR(H5E_CACHE, H5E_BADVALUE, NULL, "invalid stored entry size")
+    } /* end if */
+
     /* Verify expected length of entry image */
-    if ((size_t)(p - *buf) != H5C__cache_image_block_entry_header_size(f))
+    if ((size_t)(p - *buf) != H5C__cache_image_block_entry_header_size(f, H5C__MDCI_BLOCK_VERSION(cache_ptr)))
         HGOTO_ERROR(H5E_CACHE, H5E_BADSIZE, NULL, "Bad entry image len")
 
     /* If parent count greater than zero, allocate array for parent
@@ -3347,8 +3999,16 @@ H5C__reconstruct_cache_entry(const H5F_t *f, H5C_t *cache_ptr, const uint8_t **b
 #endif /* H5C_DO_MEMORY_SANITY_CHECKS */
 
     /* Copy the entry image from the cache image block */
-    H5MM_memcpy(pf_entry_ptr->image_ptr, p, pf_entry_ptr->size);
-    p += pf_entry_ptr->size;
+    if (stored_buf) {
+        if (H5C__decode_stored_image(*stored_buf, (size_t)stored_size, stored_chksum, pf_entry_ptr->image_ptr,
+                                     pf_entry_ptr->size) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_CANTDECODE, NULL, "Can't decode stored entry image")
+        *stored_buf += stored_size;
+    } /* end if */
+    else {
+        H5MM_memcpy(pf_entry_ptr->image_ptr, p, pf_entry_ptr->size);
+        p += pf_entry_ptr->size;
+    } /* end else */
 
     /* Initialize the rest of the fields in the prefetched entry */
     /* (Only need to set non-zero/NULL/FALSE fields, due to calloc() above) */
@@ -3358,6 +4018,7 @@ H5C__reconstruct_cache_entry(const H5F_t *f, H5C_t *cache_ptr, const uint8_t **b
     pf_entry_ptr->type             = H5AC_PREFETCHED_ENTRY;
     pf_entry_ptr->prefetched       = TRUE;
     pf_entry_ptr->prefetched_dirty = is_dirty && (!file_is_rw);
+    pf_entry_ptr->rp_load_seq      = cache_ptr->rp_load_count++;
 
     /* Sanity checks */
     HDassert(pf_entry_ptr->size > 0 && pf_entry_ptr->size < H5C_MAX_ENTRY_SIZE);
@@ -3368,8 +4029,11 @@ H5C__reconstruct_cache_entry(const H5F_t *f, H5C_t *cache_ptr, const uint8_t **b
     ret_value = pf_entry_ptr;
 
 done:
-    if (NULL == ret_value && pf_entry_ptr)
+    if (NULL == ret_value && pf_entry_ptr) {
+        H5MM_xfree(pf_entry_ptr->fd_parent_addrs);
+        H5MM_xfree(pf_entry_ptr->image_ptr);
         pf_entry_ptr = H5FL_FREE(H5C_cache_entry_t, pf_entry_ptr);
+    } /* end if */
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C__reconstruct_cache_entry() */
@@ -108,6 +108,11 @@ H5C_log_set_up(H5C_t *cache, const char log_location[], H5C_log_style_t style, h
         if (H5C_log_trace_set_up(cache->log_info, log_location, mpi_rank) < 0)
             HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to set up trace logging")
     }
+    else if (H5C_LOG_STYLE_BINARY == style) {
+        if (H5C_log_binary_set_up(cache->log_info, log_location, mpi_rank, cache->class_table_ptr,
+                                  cache->max_type_id) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to set up binary logging")
+    }
     else
         HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unknown logging style")
 
@@ -945,3 +950,91 @@ H5C_log_write_remove_entry_msg(H5C_t *cache, const H5C_cache_entry_t *entry, her
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C_log_write_remove_entry_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_log_write_load_entry_msg
+ *
+ * Purpose:     Write a log message for loading a cache entry from the
+ *              file, when a protect misses.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_log_write_load_entry_msg(H5C_t *cache, const H5C_cache_entry_t *entry)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(cache);
+
+    /* Write a log message */
+    HDassert(entry);
+    if (cache->log_info->cls->write_load_entry_log_msg)
+        if (cache->log_info->cls->write_load_entry_log_msg(cache->log_info->udata, entry) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "log-specific load entry call failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_log_write_load_entry_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_log_write_flush_entry_msg
+ *
+ * Purpose:     Write a log message for writing a cache entry to the file.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_log_write_flush_entry_msg(H5C_t *cache, const H5C_cache_entry_t *entry)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(cache);
+
+    /* Write a log message */
+    HDassert(entry);
+    if (cache->log_info->cls->write_flush_entry_log_msg)
+        if (cache->log_info->cls->write_flush_entry_log_msg(cache->log_info->udata, entry) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "log-specific flush entry call failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_log_write_flush_entry_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_log_write_evict_entry_msg
+ *
+ * Purpose:     Write a log message for evicting a cache entry.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_log_write_evict_entry_msg(H5C_t *cache, const H5C_cache_entry_t *entry)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(cache);
+
+    /* Write a log message */
+    HDassert(entry);
+    if (cache->log_info->cls->write_evict_entry_log_msg)
+        if (cache->log_info->cls->write_evict_entry_log_msg(cache->log_info->udata, entry) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "log-specific evict entry call failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_log_write_evict_entry_msg() */
@@ -25,10 +25,74 @@
 /* Package Private Macros */
 /**************************/
 
+/* Binary log format.  A binary log starts with a header:
+ *
+ *      signature ("MDCL", 4 bytes), format version (1 byte),
+ *      record size (1 byte), # of entry types (1 byte), reserved (1 byte),
+ *      time logging was set up (seconds since the epoch, 8 bytes),
+ *      MPI rank (4 bytes, -1 when MPI isn't in use)
+ *
+ * followed by the name of each entry type (type ID, 1 byte; name length,
+ * 1 byte; name, without a terminating NULL) and fixed-size records:
+ *
+ *      time (microseconds since logging was set up, 8 bytes),
+ *      entry address (8 bytes), auxiliary value (8 bytes),
+ *      entry size (4 bytes), operation (1 byte), entry type ID (1 byte),
+ *      status flags (1 byte), reserved (1 byte)
+ *
+ * All values are little-endian.
+ */
+#define H5C_LOG_BINARY_SIGNATURE     "MDCL"
+#define H5C_LOG_BINARY_SIGNATURE_LEN 4
+#define H5C_LOG_BINARY_VERSION       1
+#define H5C_LOG_BINARY_HEADER_SIZE   (H5C_LOG_BINARY_SIGNATURE_LEN + 4 + 8 + 4)
+#define H5C_LOG_BINARY_RECORD_SIZE   32
+
+/* Type ID of records that aren't about an entry */
+#define H5C_LOG_BINARY_NO_TYPE 0xFF
+
+/* Status flags of binary log records */
+#define H5C_LOG_BINARY_HIT    0x01 /* Protect found the entry in the cache */
+#define H5C_LOG_BINARY_FAILED 0x02 /* The operation failed */
+
 /****************************/
 /* Package Private Typedefs */
 /****************************/
 
+/* Operations recorded in binary logs.  The auxiliary value of a record
+ * is the new address for a move, the parent's address for a flush
+ * dependency, the flags for an insert, protect or unprotect, the maximum
+ * size for a new cache configuration, and 0 otherwise.
+ */
+typedef enum H5C_log_binary_op_t {
+    H5C_LOG_BINARY_START = 0,          /* Logging started */
+    H5C_LOG_BINARY_STOP,               /* Logging stopped */
+    H5C_LOG_BINARY_CREATE_CACHE,       /* Cache created */
+    H5C_LOG_BINARY_DESTROY_CACHE,      /* Cache destroyed */
+    H5C_LOG_BINARY_EVICT_CACHE,        /* All entries evicted */
+    H5C_LOG_BINARY_FLUSH_CACHE,        /* All entries flushed */
+    H5C_LOG_BINARY_SET_CONFIG,         /* New cache configuration */
+    H5C_LOG_BINARY_INSERT,             /* Entry inserted */
+    H5C_LOG_BINARY_PROTECT,            /* Entry protected, a hit or a miss */
+    H5C_LOG_BINARY_UNPROTECT,          /* Entry unprotected */
+    H5C_LOG_BINARY_LOAD,               /* Entry loaded from the file, for a miss */
+    H5C_LOG_BINARY_FLUSH,              /* Entry written to the file */
+    H5C_LOG_BINARY_EVICT,              /* Entry evicted */
+    H5C_LOG_BINARY_EXPUNGE,            /* Entry expunged */
+    H5C_LOG_BINARY_REMOVE,             /* Entry removed */
+    H5C_LOG_BINARY_MOVE,               /* Entry moved */
+    H5C_LOG_BINARY_RESIZE,             /* Entry resized */
+    H5C_LOG_BINARY_PIN,                /* Entry pinned */
+    H5C_LOG_BINARY_UNPIN,              /* Entry unpinned */
+    H5C_LOG_BINARY_MARK_DIRTY,         /* Entry marked dirty */
+    H5C_LOG_BINARY_MARK_CLEAN,         /* Entry marked clean */
+    H5C_LOG_BINARY_MARK_UNSERIALIZED,  /* Entry marked unserialized */
+    H5C_LOG_BINARY_MARK_SERIALIZED,    /* Entry marked serialized */
+    H5C_LOG_BINARY_CREATE_FD,          /* Flush dependency created */
+    H5C_LOG_BINARY_DESTROY_FD,         /* Flush dependency destroyed */
+    H5C_LOG_BINARY_NOPS                /* Number of operations, must be last */
+} H5C_log_binary_op_t;
+
 /* Forward declaration for class struct */
 typedef struct H5C_log_info_t H5C_log_info_t;
 
@@ -74,6 +138,9 @@ typedef struct H5C_log_class_t {
     herr_t (*write_set_cache_config_log_msg)(void *udata, const H5AC_cache_config_t *config,
                                              herr_t fxn_ret_value);
     herr_t (*write_remove_entry_log_msg)(void *udata, const H5C_cache_entry_t *entry, herr_t fxn_ret_value);
+    herr_t (*write_load_entry_log_msg)(void *udata, const H5C_cache_entry_t *entry);
+    herr_t (*write_flush_entry_log_msg)(void *udata, const H5C_cache_entry_t *entry);
+    herr_t (*write_evict_entry_log_msg)(void *udata, const H5C_cache_entry_t *entry);
 
 } H5C_log_class_t;
 
@@ -131,9 +198,14 @@ H5_DLL herr_t H5C_log_write_set_cache_config_msg(H5C_t *cache, const H5AC_cache_
                                                  herr_t fxn_ret_value);
 H5_DLL herr_t H5C_log_write_remove_entry_msg(H5C_t *cache, const H5C_cache_entry_t *entry,
                                              herr_t fxn_ret_value);
+H5_DLL herr_t H5C_log_write_load_entry_msg(H5C_t *cache, const H5C_cache_entry_t *entry);
+H5_DLL herr_t H5C_log_write_flush_entry_msg(H5C_t *cache, const H5C_cache_entry_t *entry);
+H5_DLL herr_t H5C_log_write_evict_entry_msg(H5C_t *cache, const H5C_cache_entry_t *entry);
 
 /* Logging-specific setup functions */
 H5_DLL herr_t H5C_log_json_set_up(H5C_log_info_t *log_info, const char log_location[], int mpi_rank);
 H5_DLL herr_t H5C_log_trace_set_up(H5C_log_info_t *log_info, const char log_location[], int mpi_rank);
+H5_DLL herr_t H5C_log_binary_set_up(H5C_log_info_t *log_info, const char log_location[], int mpi_rank,
+                                    const H5C_class_t *const *class_table, int max_type_id);
 
 #endif /* _H5Clog_H */
@@ -0,0 +1,1241 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*-------------------------------------------------------------------------
+ *
+ * Created:     H5Clog_binary.c
+ *
+ * Purpose:     Cache log implementation that emits fixed-size binary
+ *              records, cheap enough to leave on in production.  Records
+ *              are added to a ring buffer of chunks; full chunks are
+ *              written to the log file by a background thread when the
+ *              library is built with threads, and by the thread that
+ *              filled them otherwise.
+ *
+ *              The h5mdclog tool decodes the log.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+#include "H5Cmodule.h" /* This source code file is part of the H5C module */
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"   /* Generic Functions                        */
+#include "H5Cpkg.h"      /* Cache                                    */
+#include "H5Clog.h"      /* Cache logging                            */
+#include "H5Eprivate.h"  /* Error handling                           */
+#include "H5MMprivate.h" /* Memory management                        */
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Write the log from a background thread when threads are available */
+#if (defined(H5_HAVE_THREADSAFE) && !defined(H5_HAVE_WIN_THREADS)) || defined(H5_HAVE_CONV_THREADS)
+#define H5C_LOG_BINARY_FLUSH_THREAD
+#endif
+
+/* Size of the ring buffer: while the flush thread writes one chunk,
+ * records are added to the next one
+ */
+#define H5C_LOG_BINARY_NCHUNKS     4
+#define H5C_LOG_BINARY_CHUNK_NRECS 8192
+#define H5C_LOG_BINARY_CHUNK_SIZE  (H5C_LOG_BINARY_CHUNK_NRECS * H5C_LOG_BINARY_RECORD_SIZE)
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+/********************/
+/* Package Typedefs */
+/********************/
+
+typedef struct H5C_log_binary_udata_t {
+    int      fd;         /* Log file */
+    uint64_t start_time; /* Time logging was set up, in microseconds */
+    uint8_t *ring;       /* Chunks of records */
+    unsigned curr_chunk; /* Chunk records are added to */
+    size_t   curr_nrecs; /* # of records in the current chunk */
+    haddr_t  load_addr;  /* Address of the entry loaded for the current protect */
+
+    /* # of records in each chunk waiting to be written, 0 for free chunks */
+    size_t queued_nrecs[H5C_LOG_BINARY_NCHUNKS];
+
+    hbool_t write_failed; /* Whether writing records to the log failed */
+#ifdef H5C_LOG_BINARY_FLUSH_THREAD
+    pthread_t       flush_thread; /* Thread writing queued chunks */
+    pthread_mutex_t mutex;        /* Protects the queue and the fields below */
+    pthread_cond_t  queued_cond;  /* Signaled when a chunk is queued, or on shutdown */
+    pthread_cond_t  freed_cond;   /* Signaled when a queued chunk has been written */
+    unsigned        flush_chunk;  /* Next chunk the flush thread writes */
+    hbool_t         shutdown;     /* Whether the flush thread should exit */
+#endif                            /* H5C_LOG_BINARY_FLUSH_THREAD */
+} H5C_log_binary_udata_t;
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/* Internal record handling calls */
+static herr_t H5C__binary_write(int fd, const uint8_t *buf, size_t size);
+static herr_t H5C__binary_queue_chunk(H5C_log_binary_udata_t *binary_udata);
+static herr_t H5C__binary_add_record(H5C_log_binary_udata_t *binary_udata, H5C_log_binary_op_t op,
+                                     int type_id, haddr_t addr, size_t size, uint64_t aux,
+                                     herr_t fxn_ret_value);
+#ifdef H5C_LOG_BINARY_FLUSH_THREAD
+static void *H5C__binary_flush_thread(void *arg);
+#endif /* H5C_LOG_BINARY_FLUSH_THREAD */
+
+/* Log message callbacks */
+static herr_t H5C__binary_tear_down_logging(H5C_log_info_t *log_info);
+static herr_t H5C__binary_write_start_log_msg(void *udata);
+static herr_t H5C__binary_write_stop_log_msg(void *udata);
+static herr_t H5C__binary_write_create_cache_log_msg(void *udata, herr_t fxn_ret_value);
+static herr_t H5C__binary_write_destroy_cache_log_msg(void *udata);
+static herr_t H5C__binary_write_evict_cache_log_msg(void *udata, herr_t fxn_ret_value);
+static herr_t H5C__binary_write_expunge_entry_log_msg(void *udata, haddr_t address, int type_id,
+                                                      herr_t fxn_ret_value);
+static herr_t H5C__binary_write_flush_cache_log_msg(void *udata, herr_t fxn_ret_value);
+static herr_t H5C__binary_write_insert_entry_log_msg(void *udata, haddr_t address, int type_id,
+                                                     unsigned flags, size_t size, herr_t fxn_ret_value);
+static herr_t H5C__binary_write_mark_entry_dirty_log_msg(void *udata, const H5C_cache_entry_t *entry,
+                                                         herr_t fxn_ret_value);
+static herr_t H5C__binary_write_mark_entry_clean_log_msg(void *udata, const H5C_cache_entry_t *entry,
+                                                         herr_t fxn_ret_value);
+static herr_t H5C__binary_write_mark_unserialized_entry_log_msg(void *udata, const H5C_cache_entry_t *entry,
+                                                                herr_t fxn_ret_value);
+static herr_t H5C__binary_write_mark_serialized_entry_log_msg(void *udata, const H5C_cache_entry_t *entry,
+                                                              herr_t fxn_ret_value);
+static herr_t H5C__binary_write_move_entry_log_msg(void *udata, haddr_t old_addr, haddr_t new_addr,
+                                                   int type_id, herr_t fxn_ret_value);
+static herr_t H5C__binary_write_pin_entry_log_msg(void *udata, const H5C_cache_entry_t *entry,
+                                                  herr_t fxn_ret_value);
+static herr_t H5C__binary_write_create_fd_log_msg(void *udata, const H5C_cache_entry_t *parent,
+                                                  const H5C_cache_entry_t *child, herr_t fxn_ret_value);
+static herr_t H5C__binary_write_protect_entry_log_msg(void *udata, const H5C_cache_entry_t *entry,
+                                                      int type_id, unsigned flags, herr_t fxn_ret_value);
+static herr_t H5C__binary_write_resize_entry_log_msg(void *udata, const H5C_cache_entry_t *entry,
+                                                     size_t new_size, herr_t fxn_ret_value);
+static herr_t H5C__binary_write_unpin_entry_log_msg(void *udata, const H5C_cache_entry_t *entry,
+                                                    herr_t fxn_ret_value);
+static herr_t H5C__binary_write_destroy_fd_log_msg(void *udata, const H5C_cache_entry_t *parent,
+                                                   const H5C_cache_entry_t *child, herr_t fxn_ret_value);
+static herr_t H5C__binary_write_unprotect_entry_log_msg(void *udata, haddr_t address, int type_id,
+                                                        unsigned flags, herr_t fxn_ret_value);
+static herr_t H5C__binary_write_set_cache_config_log_msg(void *udata, const H5AC_cache_config_t *config,
+                                                         herr_t fxn_ret_value);
+static herr_t H5C__binary_write_remove_entry_log_msg(void *udata, const H5C_cache_entry_t *entry,
+                                                     herr_t fxn_ret_value);
+static herr_t H5C__binary_write_load_entry_log_msg(void *udata, const H5C_cache_entry_t *entry);
+static herr_t H5C__binary_write_flush_entry_log_msg(void *udata, const H5C_cache_entry_t *entry);
+static herr_t H5C__binary_write_evict_entry_log_msg(void *udata, const H5C_cache_entry_t *entry);
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Note that there's no cache set up call since that's the
+ * place where this struct is wired into the cache.
+ */
+static H5C_log_class_t H5C_binary_log_class_g = {"binary",
+                                                 H5C__binary_tear_down_logging,
+                                                 NULL, /* start logging */
+                                                 NULL, /* stop logging */
+                                                 H5C__binary_write_start_log_msg,
+                                                 H5C__binary_write_stop_log_msg,
+                                                 H5C__binary_write_create_cache_log_msg,
+                                                 H5C__binary_write_destroy_cache_log_msg,
+                                                 H5C__binary_write_evict_cache_log_msg,
+                                                 H5C__binary_write_expunge_entry_log_msg,
+                                                 H5C__binary_write_flush_cache_log_msg,
+                                                 H5C__binary_write_insert_entry_log_msg,
+                                                 H5C__binary_write_mark_entry_dirty_log_msg,
+                                                 H5C__binary_write_mark_entry_clean_log_msg,
+                                                 H5C__binary_write_mark_unserialized_entry_log_msg,
+                                                 H5C__binary_write_mark_serialized_entry_log_msg,
+                                                 H5C__binary_write_move_entry_log_msg,
+                                                 H5C__binary_write_pin_entry_log_msg,
+                                                 H5C__binary_write_create_fd_log_msg,
+                                                 H5C__binary_write_protect_entry_log_msg,
+                                                 H5C__binary_write_resize_entry_log_msg,
+                                                 H5C__binary_write_unpin_entry_log_msg,
+                                                 H5C__binary_write_destroy_fd_log_msg,
+                                                 H5C__binary_write_unprotect_entry_log_msg,
+                                                 H5C__binary_write_set_cache_config_log_msg,
+                                                 H5C__binary_write_remove_entry_log_msg,
+                                                 H5C__binary_write_load_entry_log_msg,
+                                                 H5C__binary_write_flush_entry_log_msg,
+                                                 H5C__binary_write_evict_entry_log_msg};
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write
+ *
+ * Purpose:     Write a buffer to the log file.
+ *
+ * Note:        This doesn't push errors on the error stack (or use the
+ *              FUNC_ENTER macros), since it's called from the flush
+ *              thread.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write(int fd, const uint8_t *buf, size_t size)
+{
+    while (size > 0) {
+        h5_posix_io_ret_t nwritten;
+
+        if ((nwritten = HDwrite(fd, buf, MIN(size, H5_POSIX_MAX_IO_BYTES))) < 0) {
+            if (EINTR == errno)
+                continue;
+            return FAIL;
+        } /* end if */
+        buf += nwritten;
+        size -= (size_t)nwritten;
+    } /* end while */
+
+    return SUCCEED;
+} /* H5C__binary_write() */
+
+#ifdef H5C_LOG_BINARY_FLUSH_THREAD
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_flush_thread
+ *
+ * Purpose:     Main routine of the flush thread: write queued chunks to
+ *              the log file, in order, until logging is torn down.
+ *
+ *              After a write fails, queued chunks are dropped, so that
+ *              the threads adding records don't wait forever.
+ *
+ * Return:      NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5C__binary_flush_thread(void *arg)
+{
+    H5C_log_binary_udata_t *binary_udata = (H5C_log_binary_udata_t *)arg;
+
+    HDpthread_mutex_lock(&binary_udata->mutex);
+    for (;;) {
+        unsigned chunk = binary_udata->flush_chunk;
+        size_t   nrecs = binary_udata->queued_nrecs[chunk];
+
+        if (0 == nrecs) {
+            if (binary_udata->shutdown)
+                break;
+            HDpthread_cond_wait(&binary_udata->queued_cond, &binary_udata->mutex);
+        } /* end if */
+        else {
+            hbool_t failed = binary_udata->write_failed;
+
+            /* The chunk belongs to this thread until it's marked free */
+            HDpthread_mutex_unlock(&binary_udata->mutex);
+            if (!failed && H5C__binary_write(binary_udata->fd,
+                                             binary_udata->ring + (chunk * H5C_LOG_BINARY_CHUNK_SIZE),
+                                             nrecs * H5C_LOG_BINARY_RECORD_SIZE) < 0)
+                failed = TRUE;
+            HDpthread_mutex_lock(&binary_udata->mutex);
+
+            if (failed)
+                binary_udata->write_failed = TRUE;
+            binary_udata->queued_nrecs[chunk] = 0;
+            binary_udata->flush_chunk         = (chunk + 1) % H5C_LOG_BINARY_NCHUNKS;
+            HDpthread_cond_signal(&binary_udata->freed_cond);
+        } /* end else */
+    }     /* end for */
+    HDpthread_mutex_unlock(&binary_udata->mutex);
+
+    return NULL;
+} /* H5C__binary_flush_thread() */
+#endif /* H5C_LOG_BINARY_FLUSH_THREAD */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_queue_chunk
+ *
+ * Purpose:     Queue the records in the current chunk for writing, and
+ *              move on to the next chunk, waiting for the flush thread
+ *              to write it out if it's still queued.
+ *
+ *              Without the flush thread, the records are written right
+ *              away.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_queue_chunk(H5C_log_binary_udata_t *binary_udata)
+{
+    unsigned next_chunk = (binary_udata->curr_chunk + 1) % H5C_LOG_BINARY_NCHUNKS;
+    hbool_t  failed;
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(binary_udata);
+    HDassert(binary_udata->curr_nrecs > 0);
+
+#ifdef H5C_LOG_BINARY_FLUSH_THREAD
+    HDpthread_mutex_lock(&binary_udata->mutex);
+    binary_udata->queued_nrecs[binary_udata->curr_chunk] = binary_udata->curr_nrecs;
+    HDpthread_cond_signal(&binary_udata->queued_cond);
+    while (binary_udata->queued_nrecs[next_chunk] > 0)
+        HDpthread_cond_wait(&binary_udata->freed_cond, &binary_udata->mutex);
+    failed = binary_udata->write_failed;
+    HDpthread_mutex_unlock(&binary_udata->mutex);
+#else  /* H5C_LOG_BINARY_FLUSH_THREAD */
+    failed = binary_udata->write_failed ||
+             H5C__binary_write(binary_udata->fd,
+                               binary_udata->ring + (binary_udata->curr_chunk * H5C_LOG_BINARY_CHUNK_SIZE),
+                               binary_udata->curr_nrecs * H5C_LOG_BINARY_RECORD_SIZE) < 0;
+    binary_udata->write_failed = failed;
+#endif /* H5C_LOG_BINARY_FLUSH_THREAD */
+
+    binary_udata->curr_chunk = next_chunk;
+    binary_udata->curr_nrecs = 0;
+
+    if (failed)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "error writing mdc log records")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_queue_chunk() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_add_record
+ *
+ * Purpose:     Add a record to the current chunk, queueing the chunk for
+ *              writing when it's full.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_add_record(H5C_log_binary_udata_t *binary_udata, H5C_log_binary_op_t op, int type_id,
+                       haddr_t addr, size_t size, uint64_t aux, herr_t fxn_ret_value)
+{
+    uint8_t *p;                   /* Pointer into the record */
+    unsigned status    = 0;       /* Status flags of the record */
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(binary_udata);
+    HDassert(binary_udata->curr_nrecs < H5C_LOG_BINARY_CHUNK_NRECS);
+
+    /* A protect that didn't load its entry found it in the cache */
+    if (H5C_LOG_BINARY_PROTECT == op) {
+        if (fxn_ret_value >= 0 && !H5F_addr_eq(binary_udata->load_addr, addr))
+            status |= H5C_LOG_BINARY_HIT;
+        binary_udata->load_addr = HADDR_UNDEF;
+    } /* end if */
+    if (fxn_ret_value < 0)
+        status |= H5C_LOG_BINARY_FAILED;
+
+    /* Encode the record */
+    p = binary_udata->ring + (binary_udata->curr_chunk * H5C_LOG_BINARY_CHUNK_SIZE) +
+        (binary_udata->curr_nrecs * H5C_LOG_BINARY_RECORD_SIZE);
+    UINT64ENCODE(p, H5_now_usec() - binary_udata->start_time);
+    UINT64ENCODE(p, (uint64_t)addr);
+    UINT64ENCODE(p, aux);
+    UINT32ENCODE(p, (uint32_t)MIN(size, UINT32_MAX));
+    *p++ = (uint8_t)op;
+    *p++ = (uint8_t)((type_id >= 0 && type_id < H5C_LOG_BINARY_NO_TYPE) ? type_id : H5C_LOG_BINARY_NO_TYPE);
+    *p++ = (uint8_t)status;
+    *p++ = 0;
+
+    /* Queue the chunk for writing when it's full */
+    if (++binary_udata->curr_nrecs == H5C_LOG_BINARY_CHUNK_NRECS)
+        if (H5C__binary_queue_chunk(binary_udata) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to queue mdc log records")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_add_record() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_log_binary_set_up
+ *
+ * Purpose:     Setup for binary metadata cache logging: open the log
+ *              file, write the header and the names of the cache's entry
+ *              types, and start the flush thread.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_log_binary_set_up(H5C_log_info_t *log_info, const char log_location[], int mpi_rank,
+                      const H5C_class_t *const *class_table, int max_type_id)
+{
+    H5C_log_binary_udata_t *binary_udata = NULL;
+    char *                  file_name    = NULL;
+    uint8_t *               header       = NULL;
+    uint8_t *               p;
+    size_t                  header_size;
+    size_t                  n_chars;
+#ifdef H5C_LOG_BINARY_FLUSH_THREAD
+    hbool_t sync_init = FALSE; /* Whether the mutex and condition variables were initialized */
+#endif                         /* H5C_LOG_BINARY_FLUSH_THREAD */
+    int i;
+    herr_t                  ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(log_info);
+    HDassert(log_location);
+    HDassert(class_table);
+    HDassert(max_type_id >= 0 && max_type_id < H5C_LOG_BINARY_NO_TYPE);
+
+    /* Allocate memory for the binary-specific data */
+    if (NULL == (binary_udata = (H5C_log_binary_udata_t *)H5MM_calloc(sizeof(H5C_log_binary_udata_t))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed")
+    binary_udata->fd         = -1;
+    binary_udata->start_time = H5_now_usec();
+    binary_udata->load_addr  = HADDR_UNDEF;
+
+    /* Allocate the ring buffer */
+    if (NULL ==
+        (binary_udata->ring = (uint8_t *)H5MM_malloc(H5C_LOG_BINARY_NCHUNKS * H5C_LOG_BINARY_CHUNK_SIZE)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed")
+
+    /* Possibly fix up the log file name (see H5C_log_json_set_up) */
+    n_chars = 5 + 39 + 1 + HDstrlen(log_location) + 1;
+    if (NULL == (file_name = (char *)H5MM_calloc(n_chars * sizeof(char))))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL,
+                    "can't allocate memory for mdc log file name manipulation")
+
+    /* Add the rank to the log file name when MPI is in use */
+    if (-1 == mpi_rank)
+        HDsnprintf(file_name, n_chars, "%s", log_location);
+    else
+        HDsnprintf(file_name, n_chars, "RANK_%d.%s", mpi_rank, log_location);
+
+    /* Open log file */
+    if ((binary_udata->fd = HDopen(file_name, O_WRONLY | O_CREAT | O_TRUNC, H5_POSIX_CREATE_MODE_RW)) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "can't create mdc log file")
+
+    /* Build the header, followed by the names of the entry types */
+    header_size = H5C_LOG_BINARY_HEADER_SIZE;
+    for (i = 0; i <= max_type_id; i++)
+        header_size += 2 + MIN(HDstrlen(class_table[i]->name), 255);
+    if (NULL == (header = (uint8_t *)H5MM_malloc(header_size)))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTALLOC, FAIL, "memory allocation failed")
+    p = header;
+    H5MM_memcpy(p, H5C_LOG_BINARY_SIGNATURE, (size_t)H5C_LOG_BINARY_SIGNATURE_LEN);
+    p += H5C_LOG_BINARY_SIGNATURE_LEN;
+    *p++ = H5C_LOG_BINARY_VERSION;
+    *p++ = H5C_LOG_BINARY_RECORD_SIZE;
+    *p++ = (uint8_t)(max_type_id + 1);
+    *p++ = 0;
+    UINT64ENCODE(p, (uint64_t)HDtime(NULL));
+    INT32ENCODE(p, mpi_rank);
+    for (i = 0; i <= max_type_id; i++) {
+        size_t len = MIN(HDstrlen(class_table[i]->name), 255);
+
+        *p++ = (uint8_t)class_table[i]->id;
+        *p++ = (uint8_t)len;
+        H5MM_memcpy(p, class_table[i]->name, len);
+        p += len;
+    } /* end for */
+    HDassert((size_t)(p - header) == header_size);
+
+    if (H5C__binary_write(binary_udata->fd, header, header_size) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "error writing mdc log header")
+
+#ifdef H5C_LOG_BINARY_FLUSH_THREAD
+    /* Start the flush thread */
+    if (0 != HDpthread_mutex_init(&binary_udata->mutex, NULL))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTINIT, FAIL, "can't initialize mdc log mutex")
+    if (0 != HDpthread_cond_init(&binary_udata->queued_cond, NULL)) {
+        pthread_mutex_destroy(&binary_udata->mutex);
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTINIT, FAIL, "can't initialize mdc log condition variable")
+    } /* end if */
+    if (0 != HDpthread_cond_init(&binary_udata->freed_cond, NULL)) {
+        pthread_cond_destroy(&binary_udata->queued_cond);
+        pthread_mutex_destroy(&binary_udata->mutex);
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTINIT, FAIL, "can't initialize mdc log condition variable")
+    } /* end if */
+    sync_init = TRUE;
+    if (0 != HDpthread_create(&binary_udata->flush_thread, NULL, H5C__binary_flush_thread, binary_udata))
+        HGOTO_ERROR(H5E_CACHE, H5E_CANTINIT, FAIL, "can't start mdc log flush thread")
+#endif /* H5C_LOG_BINARY_FLUSH_THREAD */
+
+    /* Set up the class struct */
+    log_info->cls   = &H5C_binary_log_class_g;
+    log_info->udata = binary_udata;
+
+done:
+    H5MM_xfree(file_name);
+    H5MM_xfree(header);
+
+    /* Free the binary-specific data on errors */
+    if (FAIL == ret_value && binary_udata) {
+#ifdef H5C_LOG_BINARY_FLUSH_THREAD
+        if (sync_init) {
+            pthread_cond_destroy(&binary_udata->freed_cond);
+            pthread_cond_destroy(&binary_udata->queued_cond);
+            pthread_mutex_destroy(&binary_udata->mutex);
+        } /* end if */
+#endif /* H5C_LOG_BINARY_FLUSH_THREAD */
+        if (binary_udata->fd >= 0)
+            HDclose(binary_udata->fd);
+        H5MM_xfree(binary_udata->ring);
+        H5MM_xfree(binary_udata);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_log_binary_set_up() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_tear_down_logging
+ *
+ * Purpose:     Tear-down for binary metadata cache logging: write the
+ *              records not written yet, stop the flush thread and close
+ *              the log file.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_tear_down_logging(H5C_log_info_t *log_info)
+{
+    H5C_log_binary_udata_t *binary_udata = NULL;
+    herr_t                  ret_value    = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(log_info);
+
+    /* Alias */
+    binary_udata = (H5C_log_binary_udata_t *)(log_info->udata);
+
+    /* Queue the last records */
+    if (binary_udata->curr_nrecs > 0)
+        if (H5C__binary_queue_chunk(binary_udata) < 0)
+            HDONE_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to queue mdc log records")
+
+#ifdef H5C_LOG_BINARY_FLUSH_THREAD
+    /* Wait for the flush thread to write them */
+    HDpthread_mutex_lock(&binary_udata->mutex);
+    binary_udata->shutdown = TRUE;
+    HDpthread_cond_signal(&binary_udata->queued_cond);
+    HDpthread_mutex_unlock(&binary_udata->mutex);
+    HDpthread_join(binary_udata->flush_thread, NULL);
+
+    pthread_cond_destroy(&binary_udata->freed_cond);
+    pthread_cond_destroy(&binary_udata->queued_cond);
+    pthread_mutex_destroy(&binary_udata->mutex);
+
+    if (binary_udata->write_failed)
+        HDONE_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "error writing mdc log records")
+#endif /* H5C_LOG_BINARY_FLUSH_THREAD */
+
+    /* Close log file */
+    if (HDclose(binary_udata->fd) < 0)
+        HDONE_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "problem closing mdc log file")
+
+    /* Free the udata */
+    H5MM_xfree(binary_udata->ring);
+    H5MM_xfree(binary_udata);
+
+    /* Reset the log class info and udata */
+    log_info->cls   = NULL;
+    log_info->udata = NULL;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_tear_down_logging() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_start_log_msg
+ *
+ * Purpose:     Record the start of logging.  The auxiliary value is the
+ *              time, in seconds since the epoch.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_start_log_msg(void *udata)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_START, -1, HADDR_UNDEF,
+                               (size_t)0, (uint64_t)HDtime(NULL), SUCCEED) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_start_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_stop_log_msg
+ *
+ * Purpose:     Record the end of logging, and queue the records in the
+ *              current chunk for writing, so that they reach the log
+ *              file while logging is stopped.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_stop_log_msg(void *udata)
+{
+    H5C_log_binary_udata_t *binary_udata = (H5C_log_binary_udata_t *)udata;
+    herr_t                  ret_value    = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if (H5C__binary_add_record(binary_udata, H5C_LOG_BINARY_STOP, -1, HADDR_UNDEF, (size_t)0,
+                               (uint64_t)HDtime(NULL), SUCCEED) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+    if (binary_udata->curr_nrecs > 0)
+        if (H5C__binary_queue_chunk(binary_udata) < 0)
+            HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to queue mdc log records")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_stop_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_create_cache_log_msg
+ *
+ * Purpose:     Record the creation of the cache.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_create_cache_log_msg(void *udata, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_CREATE_CACHE, -1,
+                               HADDR_UNDEF, (size_t)0, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_create_cache_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_destroy_cache_log_msg
+ *
+ * Purpose:     Record the destruction of the cache.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_destroy_cache_log_msg(void *udata)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_DESTROY_CACHE, -1,
+                               HADDR_UNDEF, (size_t)0, (uint64_t)0, SUCCEED) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_destroy_cache_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_evict_cache_log_msg
+ *
+ * Purpose:     Record the eviction of all entries in the cache.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_evict_cache_log_msg(void *udata, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_EVICT_CACHE, -1,
+                               HADDR_UNDEF, (size_t)0, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_evict_cache_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_expunge_entry_log_msg
+ *
+ * Purpose:     Record the expunge of a cache entry.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_expunge_entry_log_msg(void *udata, haddr_t address, int type_id, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_EXPUNGE, type_id, address,
+                               (size_t)0, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_expunge_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_flush_cache_log_msg
+ *
+ * Purpose:     Record a flush of the cache.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_flush_cache_log_msg(void *udata, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_FLUSH_CACHE, -1,
+                               HADDR_UNDEF, (size_t)0, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_flush_cache_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_insert_entry_log_msg
+ *
+ * Purpose:     Record the insertion of a cache entry.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_insert_entry_log_msg(void *udata, haddr_t address, int type_id, unsigned flags, size_t size,
+                                       herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_INSERT, type_id, address,
+                               size, (uint64_t)flags, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_insert_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_mark_entry_dirty_log_msg
+ *
+ * Purpose:     Record marking a cache entry dirty.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_mark_entry_dirty_log_msg(void *udata, const H5C_cache_entry_t *entry, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(entry);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_MARK_DIRTY, entry->type->id,
+                               entry->addr, entry->size, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_mark_entry_dirty_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_mark_entry_clean_log_msg
+ *
+ * Purpose:     Record marking a cache entry clean.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_mark_entry_clean_log_msg(void *udata, const H5C_cache_entry_t *entry, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(entry);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_MARK_CLEAN, entry->type->id,
+                               entry->addr, entry->size, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_mark_entry_clean_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_mark_unserialized_entry_log_msg
+ *
+ * Purpose:     Record marking a cache entry unserialized.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_mark_unserialized_entry_log_msg(void *udata, const H5C_cache_entry_t *entry,
+                                                  herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(entry);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_MARK_UNSERIALIZED,
+                               entry->type->id, entry->addr, entry->size, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_mark_unserialized_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_mark_serialized_entry_log_msg
+ *
+ * Purpose:     Record marking a cache entry serialized.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_mark_serialized_entry_log_msg(void *udata, const H5C_cache_entry_t *entry,
+                                                herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(entry);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_MARK_SERIALIZED,
+                               entry->type->id, entry->addr, entry->size, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_mark_serialized_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_move_entry_log_msg
+ *
+ * Purpose:     Record moving a cache entry.  The auxiliary value is the
+ *              new address.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_move_entry_log_msg(void *udata, haddr_t old_addr, haddr_t new_addr, int type_id,
+                                     herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_MOVE, type_id, old_addr,
+                               (size_t)0, (uint64_t)new_addr, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_move_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_pin_entry_log_msg
+ *
+ * Purpose:     Record pinning a cache entry.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_pin_entry_log_msg(void *udata, const H5C_cache_entry_t *entry, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(entry);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_PIN, entry->type->id,
+                               entry->addr, entry->size, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_pin_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_create_fd_log_msg
+ *
+ * Purpose:     Record the creation of a flush dependency.  The record is
+ *              about the child; the auxiliary value is the parent's
+ *              address.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_create_fd_log_msg(void *udata, const H5C_cache_entry_t *parent,
+                                    const H5C_cache_entry_t *child, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(parent);
+    HDassert(child);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_CREATE_FD, child->type->id,
+                               child->addr, child->size, (uint64_t)parent->addr, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_create_fd_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_protect_entry_log_msg
+ *
+ * Purpose:     Record protecting a cache entry, as a hit unless the
+ *              entry was just loaded.  The auxiliary value is the
+ *              protect flags.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_protect_entry_log_msg(void *udata, const H5C_cache_entry_t *entry, int type_id,
+                                        unsigned flags, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_PROTECT, type_id,
+                               entry ? entry->addr : HADDR_UNDEF, entry ? entry->size : 0, (uint64_t)flags,
+                               fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_protect_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_resize_entry_log_msg
+ *
+ * Purpose:     Record resizing a cache entry.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_resize_entry_log_msg(void *udata, const H5C_cache_entry_t *entry, size_t new_size,
+                                       herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(entry);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_RESIZE, entry->type->id,
+                               entry->addr, new_size, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_resize_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_unpin_entry_log_msg
+ *
+ * Purpose:     Record unpinning a cache entry.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_unpin_entry_log_msg(void *udata, const H5C_cache_entry_t *entry, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(entry);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_UNPIN, entry->type->id,
+                               entry->addr, entry->size, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_unpin_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_destroy_fd_log_msg
+ *
+ * Purpose:     Record the destruction of a flush dependency.  The record
+ *              is about the child; the auxiliary value is the parent's
+ *              address.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_destroy_fd_log_msg(void *udata, const H5C_cache_entry_t *parent,
+                                     const H5C_cache_entry_t *child, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(parent);
+    HDassert(child);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_DESTROY_FD, child->type->id,
+                               child->addr, child->size, (uint64_t)parent->addr, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_destroy_fd_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_unprotect_entry_log_msg
+ *
+ * Purpose:     Record unprotecting a cache entry.  The auxiliary value is
+ *              the unprotect flags.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_unprotect_entry_log_msg(void *udata, haddr_t address, int type_id, unsigned flags,
+                                          herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_UNPROTECT, type_id, address,
+                               (size_t)0, (uint64_t)flags, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_unprotect_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_set_cache_config_log_msg
+ *
+ * Purpose:     Record a new cache configuration.  The auxiliary value is
+ *              the maximum cache size.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_set_cache_config_log_msg(void *udata, const H5AC_cache_config_t *config,
+                                           herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(config);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_SET_CONFIG, -1, HADDR_UNDEF,
+                               (size_t)0, (uint64_t)config->max_size, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_set_cache_config_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_remove_entry_log_msg
+ *
+ * Purpose:     Record removing a cache entry.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_remove_entry_log_msg(void *udata, const H5C_cache_entry_t *entry, herr_t fxn_ret_value)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(entry);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_REMOVE, entry->type->id,
+                               entry->addr, entry->size, (uint64_t)0, fxn_ret_value) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_remove_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_load_entry_log_msg
+ *
+ * Purpose:     Record loading a cache entry from the file, and remember
+ *              its address so that the protect that follows is recorded
+ *              as a miss.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_load_entry_log_msg(void *udata, const H5C_cache_entry_t *entry)
+{
+    H5C_log_binary_udata_t *binary_udata = (H5C_log_binary_udata_t *)udata;
+    herr_t                  ret_value    = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(binary_udata);
+    HDassert(entry);
+
+    binary_udata->load_addr = entry->addr;
+
+    if (H5C__binary_add_record(binary_udata, H5C_LOG_BINARY_LOAD, entry->type->id, entry->addr, entry->size,
+                               (uint64_t)0, SUCCEED) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_load_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_flush_entry_log_msg
+ *
+ * Purpose:     Record writing a cache entry to the file.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_flush_entry_log_msg(void *udata, const H5C_cache_entry_t *entry)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(entry);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_FLUSH, entry->type->id,
+                               entry->addr, entry->size, (uint64_t)0, SUCCEED) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_flush_entry_log_msg() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__binary_write_evict_entry_log_msg
+ *
+ * Purpose:     Record evicting a cache entry.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5C__binary_write_evict_entry_log_msg(void *udata, const H5C_cache_entry_t *entry)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_STATIC
+
+    HDassert(entry);
+
+    if (H5C__binary_add_record((H5C_log_binary_udata_t *)udata, H5C_LOG_BINARY_EVICT, entry->type->id,
+                               entry->addr, entry->size, (uint64_t)0, SUCCEED) < 0)
+        HGOTO_ERROR(H5E_CACHE, H5E_LOGGING, FAIL, "unable to emit log message")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__binary_write_evict_entry_log_msg() */
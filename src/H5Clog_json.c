@@ -143,7 +143,10 @@ static H5C_log_class_t H5C_json_log_class_g = {"json",
                                                H5C__json_write_destroy_fd_log_msg,
                                                H5C__json_write_unprotect_entry_log_msg,
                                                H5C__json_write_set_cache_config_log_msg,
-                                               H5C__json_write_remove_entry_log_msg};
+                                               H5C__json_write_remove_entry_log_msg,
+                                               NULL, /* load entry */
+                                               NULL, /* flush entry */
+                                               NULL  /* evict entry */};
 
 /*-------------------------------------------------------------------------
  * Function:    H5C__json_write_log_message
@@ -52,14 +52,87 @@
 
 
 /* Cache configuration settings */
-#define H5C__HASH_TABLE_LEN     (64 * 1024) /* must be a power of 2 */
 #define H5C__H5C_T_MAGIC    0x005CAC0E
 
 
+/* Smallest and largest sizes of the index's hash table, as the log2 of
+ * the number of buckets.  The table doubles when it holds more entries
+ * than buckets, and halves when it holds fewer than one entry for every
+ * eight buckets.
+ */
+#define H5C__HASH_MIN_NBITS     10
+#define H5C__HASH_MAX_NBITS     30
+
+/* Number of buckets of the old hash table moved to the new one by each
+ * insertion, deletion and search while the index is being resized
+ */
+#define H5C__HASH_REHASH_STEP   8
+
+
+/* Limits used by the scan-resistant (2Q) replacement policy.  A hit on an
+ * entry promotes it to the hot set only if at least one entry in
+ * H5C__2Q_CORRELATED_DIVISOR has been loaded since it was, so that the
+ * repeated accesses of a single operation do not count as reuse.  Hot
+ * entries are given a second chance at the tail of the LRU list as long
+ * as they use no more than H5C__2Q_HOT_PERCENT of the maximum cache size.
+ */
+#define H5C__2Q_CORRELATED_DIVISOR      4
+#define H5C__2Q_HOT_PERCENT             75
+
+
 /* Initial allocated size of the "flush_dep_parent" array */
 #define H5C_FLUSH_DEP_PARENT_INIT 8
 
 
+/* Number of bytes of entry images queued by a flush before they are
+ * written to the file, and initial number of writes the queue holds
+ */
+#define H5C__WRITE_BATCH_MAX_SIZE               (8 * 1024 * 1024)
+#define H5C__WRITE_BATCH_INIT_NWRITES           256
+
+
+/* Maximum number of bytes of entry images read ahead by
+ * H5C_prefetch_entries() that the cache holds
+ */
+#define H5C__READ_AHEAD_MAX_SIZE                (4 * 1024 * 1024)
+
+
+/* Largest number of entries in a bucket of the index that
+ * H5C_protect_shared() looks at before giving up on an address.  Chains
+ * are much shorter than this, as the table grows when it holds more
+ * entries than buckets.
+ */
+#define H5C__SHARED_MAX_CHAIN_LEN               64
+
+
+/* Atomic operations on the fields that threads calling
+ * H5C_protect_shared() share with the thread that owns the cache.  They
+ * are sequentially consistent, which the handshakes in H5Cshared.c rely
+ * on.  Builds without threads use plain loads and stores, and builds with
+ * threads but without compiler support for atomic operations don't allow
+ * shared reads.
+ */
+#if !defined(H5_HAVE_THREADSAFE) && !defined(H5_HAVE_CONV_THREADS)
+#define H5C__SHARED_READS_SUPPORTED             TRUE
+#define H5C__ATOMIC_LOAD(p)                     (*(p))
+#define H5C__ATOMIC_STORE(p, v)                 (*(p) = (v))
+#define H5C__ATOMIC_INCR(p)                     ((void)((*(p))++))
+#define H5C__ATOMIC_DECR(p)                     ((void)((*(p))--))
+#elif defined(__GNUC__)
+#define H5C__SHARED_READS_SUPPORTED             TRUE
+#define H5C__ATOMIC_LOAD(p)                     __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define H5C__ATOMIC_STORE(p, v)                 __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define H5C__ATOMIC_INCR(p)                     ((void)__atomic_add_fetch((p), 1, __ATOMIC_SEQ_CST))
+#define H5C__ATOMIC_DECR(p)                     ((void)__atomic_sub_fetch((p), 1, __ATOMIC_SEQ_CST))
+#else
+#define H5C__SHARED_READS_SUPPORTED             FALSE
+#define H5C__ATOMIC_LOAD(p)                     (*(p))
+#define H5C__ATOMIC_STORE(p, v)                 (*(p) = (v))
+#define H5C__ATOMIC_INCR(p)                     ((void)((*(p))++))
+#define H5C__ATOMIC_DECR(p)                     ((void)((*(p))--))
+#endif
+
+
 /* Set to TRUE to enable the slist optimization.  If this field is TRUE,
  * the slist is disabled whenever a flush is not in progress.
  */
@@ -724,6 +797,23 @@ if ( ( ( ( (head_ptr) == NULL ) || ( (tail_ptr) == NULL ) ) &&             \
     (cache_ptr)->prefetch_hits++;                     \
 }
 
+#define H5C__UPDATE_STATS_FOR_HOT_PROMOTION(cache_ptr, entry_ptr) \
+    (((cache_ptr)->hot_promotions)[(entry_ptr)->type->id])++;
+
+#define H5C__UPDATE_STATS_FOR_HOT_SECOND_CHANCE(cache_ptr, entry_ptr) \
+    (((cache_ptr)->hot_second_chances)[(entry_ptr)->type->id])++;
+
+#define H5C__UPDATE_STATS_FOR_READ_AHEAD(cache_ptr, nimages) \
+{                                                           \
+    (cache_ptr)->read_aheads++;                             \
+    (cache_ptr)->read_ahead_images += (int64_t)(nimages);   \
+}
+
+#define H5C__UPDATE_STATS_FOR_READ_AHEAD_HIT(cache_ptr) \
+{                                                      \
+    (cache_ptr)->read_ahead_hits++;                    \
+}
+
 #if H5C_COLLECT_CACHE_ENTRY_STATS
 
 #define H5C__RESET_CACHE_ENTRY_STATS(entry_ptr) \
@@ -953,6 +1043,10 @@ if ( ( ( ( (head_ptr) == NULL ) || ( (tail_ptr) == NULL ) ) &&             \
 #define H5C__UPDATE_STATS_FOR_CACHE_IMAGE_LOAD(cache_ptr)
 #define H5C__UPDATE_STATS_FOR_PREFETCH(cache_ptr, dirty)
 #define H5C__UPDATE_STATS_FOR_PREFETCH_HIT(cache_ptr)
+#define H5C__UPDATE_STATS_FOR_HOT_PROMOTION(cache_ptr, entry_ptr)
+#define H5C__UPDATE_STATS_FOR_HOT_SECOND_CHANCE(cache_ptr, entry_ptr)
+#define H5C__UPDATE_STATS_FOR_READ_AHEAD(cache_ptr, nimages)
+#define H5C__UPDATE_STATS_FOR_READ_AHEAD_HIT(cache_ptr)
 
 #endif /* H5C_COLLECT_CACHE_STATS */
 
@@ -991,11 +1085,42 @@ if ( ( ( ( (head_ptr) == NULL ) || ( (tail_ptr) == NULL ) ) &&             \
  *
  ***********************************************************************/
 
-/* H5C__HASH_TABLE_LEN is defined in H5Cpkg.h.  It mut be a power of two. */
+/* The hash function maps an address to one of the 2^nbits buckets of a
+ * table by multiplying it by 2^64 / phi and keeping the top nbits bits of
+ * the product (Fibonacci hashing), so that all the bits of the address
+ * select the bucket, instead of only its low bits.
+ */
+#define H5C__HASH_MULTIPLIER    ((uint64_t)0x9E3779B97F4A7C15ULL)
 
-#define H5C__HASH_MASK        ((size_t)(H5C__HASH_TABLE_LEN - 1) << 3)
+#define H5C__HASH_FCN(x, nbits) \
+    ((size_t)(((uint64_t)(x) * H5C__HASH_MULTIPLIER) >> (64 - (nbits))))
 
-#define H5C__HASH_FCN(x)    (int)((unsigned)((x) & H5C__HASH_MASK) >> 3)
+#define H5C__HASH_NBUCKETS(nbits)   ((size_t)1 << (nbits))
+
+/* Bucket of the index that holds the entry at an address, if there's one.
+ * While the index is being resized, the buckets of the old table that
+ * haven't been moved to the new table yet still hold their entries.
+ */
+#define H5C__HASH_BUCKET(cache_ptr, Addr)                                      \
+    ( ( ( (cache_ptr)->old_index != NULL ) &&                                  \
+        ( H5C__HASH_FCN(Addr, (cache_ptr)->old_index_nbits) >=                 \
+          (cache_ptr)->index_rehash_next ) ) ?                                 \
+      &((cache_ptr)->old_index[H5C__HASH_FCN(Addr,                           \
+                                             (cache_ptr)->old_index_nbits)]) : \
+      &((cache_ptr)->index[H5C__HASH_FCN(Addr, (cache_ptr)->index_nbits)]) )
+
+/* Move some buckets to the new hash table while the index is being
+ * resized, or start resizing it when it's too full or too empty.
+ */
+#define H5C__INDEX_REHASH_STEP(cache_ptr)                                      \
+if ( ( (cache_ptr)->old_index != NULL ) ||                                     \
+     ( ( (cache_ptr)->index_len >                                              \
+         H5C__HASH_NBUCKETS((cache_ptr)->index_nbits) ) &&                     \
+       ( (cache_ptr)->index_nbits < H5C__HASH_MAX_NBITS ) ) ||                 \
+     ( ( (cache_ptr)->index_len <                                              \
+         (H5C__HASH_NBUCKETS((cache_ptr)->index_nbits) >> 3) ) &&              \
+       ( (cache_ptr)->index_nbits > H5C__HASH_MIN_NBITS ) ) )                  \
+    H5C__rehash_index(cache_ptr);
 
 #if H5C_DO_SANITY_CHECKS
 
@@ -1007,8 +1132,7 @@ if ( ( (cache_ptr) == NULL ) ||                                         \
      ( (entry_ptr)->ht_next != NULL ) ||                                \
      ( (entry_ptr)->ht_prev != NULL ) ||                                \
      ( (entry_ptr)->size <= 0 ) ||                                      \
-     ( H5C__HASH_FCN((entry_ptr)->addr) < 0 ) ||                        \
-     ( H5C__HASH_FCN((entry_ptr)->addr) >= H5C__HASH_TABLE_LEN ) ||     \
+     ( (cache_ptr)->index == NULL ) ||                                  \
      ( (cache_ptr)->index_size !=                                       \
        ((cache_ptr)->clean_index_size +                                 \
     (cache_ptr)->dirty_index_size) ) ||                             \
@@ -1059,14 +1183,11 @@ if ( ( (cache_ptr) == NULL ) ||                                         \
      ( (cache_ptr)->index_size < (entry_ptr)->size ) ||                 \
      ( ! H5F_addr_defined((entry_ptr)->addr) ) ||                       \
      ( (entry_ptr)->size <= 0 ) ||                                      \
-     ( H5C__HASH_FCN((entry_ptr)->addr) < 0 ) ||                        \
-     ( H5C__HASH_FCN((entry_ptr)->addr) >= H5C__HASH_TABLE_LEN ) ||     \
-     ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))]         \
-       == NULL ) ||                                                     \
-     ( ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))]       \
+     ( *H5C__HASH_BUCKET(cache_ptr, (entry_ptr)->addr) == NULL ) ||     \
+     ( ( *H5C__HASH_BUCKET(cache_ptr, (entry_ptr)->addr)                \
        != (entry_ptr) ) &&                                              \
        ( (entry_ptr)->ht_prev == NULL ) ) ||                            \
-     ( ( ((cache_ptr)->index)[(H5C__HASH_FCN((entry_ptr)->addr))] ==    \
+     ( ( *H5C__HASH_BUCKET(cache_ptr, (entry_ptr)->addr) ==             \
          (entry_ptr) ) &&                                               \
        ( (entry_ptr)->ht_prev != NULL ) ) ||                            \
      ( (cache_ptr)->index_size !=                                       \
@@ -1125,13 +1246,12 @@ if ( ( (cache_ptr) == NULL ) ||                                             \
      ( (cache_ptr)->index_size !=                                           \
        ((cache_ptr)->clean_index_size + (cache_ptr)->dirty_index_size) ) || \
      ( ! H5F_addr_defined(Addr) ) ||                                        \
-     ( H5C__HASH_FCN(Addr) < 0 ) ||                                         \
-     ( H5C__HASH_FCN(Addr) >= H5C__HASH_TABLE_LEN ) ) {                     \
+     ( (cache_ptr)->index == NULL ) ) {                                     \
     HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, fail_val, "pre HT search SC failed") \
 }
 
 /* (Keep in sync w/H5C_TEST__POST_SUC_HT_SEARCH_SC macro in test/cache_common.h -QAK) */
-#define H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, k, fail_val)       \
+#define H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, bucket, fail_val)  \
 if ( ( (cache_ptr) == NULL ) ||                                             \
      ( (cache_ptr)->magic != H5C__H5C_T_MAGIC ) ||                          \
      ( (cache_ptr)->index_len < 1 ) ||                                      \
@@ -1140,10 +1260,10 @@ if ( ( (cache_ptr) == NULL ) ||                                             \
      ( (cache_ptr)->index_size !=                                           \
        ((cache_ptr)->clean_index_size + (cache_ptr)->dirty_index_size) ) || \
      ( (entry_ptr)->size <= 0 ) ||                                          \
-     ( ((cache_ptr)->index)[k] == NULL ) ||                                 \
-     ( ( ((cache_ptr)->index)[k] != (entry_ptr) ) &&                        \
+     ( *(bucket) == NULL ) ||                                               \
+     ( ( *(bucket) != (entry_ptr) ) &&                                      \
        ( (entry_ptr)->ht_prev == NULL ) ) ||                                \
-     ( ( ((cache_ptr)->index)[k] == (entry_ptr) ) &&                        \
+     ( ( *(bucket) == (entry_ptr) ) &&                                      \
        ( (entry_ptr)->ht_prev != NULL ) ) ||                                \
      ( ( (entry_ptr)->ht_prev != NULL ) &&                                  \
        ( (entry_ptr)->ht_prev->ht_next != (entry_ptr) ) ) ||                \
@@ -1153,9 +1273,9 @@ if ( ( (cache_ptr) == NULL ) ||                                             \
 }
 
 /* (Keep in sync w/H5C_TEST__POST_HT_SHIFT_TO_FRONT macro in test/cache_common.h -QAK) */
-#define H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k, fail_val) \
+#define H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket, fail_val) \
 if ( ( (cache_ptr) == NULL ) ||                                        \
-     ( ((cache_ptr)->index)[k] != (entry_ptr) ) ||                     \
+     ( *(bucket) != (entry_ptr) ) ||                                   \
      ( (entry_ptr)->ht_prev != NULL ) ) {                              \
     HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, fail_val, "post HT shift to front SC failed") \
 }
@@ -1318,8 +1438,8 @@ if ( ( (cache_ptr)->index_size !=                                           \
 #define H5C__PRE_HT_REMOVE_SC(cache_ptr, entry_ptr)
 #define H5C__POST_HT_REMOVE_SC(cache_ptr, entry_ptr)
 #define H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)
-#define H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, k, fail_val)
-#define H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k, fail_val)
+#define H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, bucket, fail_val)
+#define H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket, fail_val)
 #define H5C__PRE_HT_UPDATE_FOR_ENTRY_CLEAN_SC(cache_ptr, entry_ptr)
 #define H5C__PRE_HT_UPDATE_FOR_ENTRY_DIRTY_SC(cache_ptr, entry_ptr)
 #define H5C__PRE_HT_ENTRY_SIZE_CHANGE_SC(cache_ptr, old_size, new_size, \
@@ -1334,14 +1454,14 @@ if ( ( (cache_ptr)->index_size !=                                           \
 
 #define H5C__INSERT_IN_INDEX(cache_ptr, entry_ptr, fail_val)                 \
 {                                                                            \
-    int k;                                                                   \
+    H5C_cache_entry_t **bucket;                                              \
     H5C__PRE_HT_INSERT_SC(cache_ptr, entry_ptr, fail_val)                    \
-    k = H5C__HASH_FCN((entry_ptr)->addr);                                    \
-    if(((cache_ptr)->index)[k] != NULL) {                                    \
-        (entry_ptr)->ht_next = ((cache_ptr)->index)[k];                      \
+    bucket = H5C__HASH_BUCKET(cache_ptr, (entry_ptr)->addr);                 \
+    if(*bucket != NULL) {                                                    \
+        (entry_ptr)->ht_next = *bucket;                                      \
         (entry_ptr)->ht_next->ht_prev = (entry_ptr);                         \
     }                                                                        \
-    ((cache_ptr)->index)[k] = (entry_ptr);                                   \
+    H5C__ATOMIC_STORE(bucket, (entry_ptr));                                  \
     (cache_ptr)->index_len++;                                                \
     (cache_ptr)->index_size += (entry_ptr)->size;                            \
     ((cache_ptr)->index_ring_len[entry_ptr->ring])++;                        \
@@ -1360,24 +1480,27 @@ if ( ( (cache_ptr)->index_size !=                                           \
         (cache_ptr)->num_last_entries++;                                     \
         HDassert((cache_ptr)->num_last_entries <= 2);                        \
     }                                                                        \
+    if((entry_ptr)->rp_hot)                                                  \
+        (cache_ptr)->rp_hot_size += (entry_ptr)->size;                       \
     H5C__IL_DLL_APPEND((entry_ptr), (cache_ptr)->il_head,                    \
                        (cache_ptr)->il_tail, (cache_ptr)->il_len,            \
                        (cache_ptr)->il_size, fail_val)                       \
     H5C__UPDATE_STATS_FOR_HT_INSERTION(cache_ptr)                            \
     H5C__POST_HT_INSERT_SC(cache_ptr, entry_ptr, fail_val)                   \
+    H5C__INDEX_REHASH_STEP(cache_ptr)                                        \
 }
 
 #define H5C__DELETE_FROM_INDEX(cache_ptr, entry_ptr, fail_val)               \
 {                                                                            \
-    int k;                                                                   \
+    H5C_cache_entry_t **bucket;                                              \
     H5C__PRE_HT_REMOVE_SC(cache_ptr, entry_ptr)                              \
-    k = H5C__HASH_FCN((entry_ptr)->addr);                                    \
+    bucket = H5C__HASH_BUCKET(cache_ptr, (entry_ptr)->addr);                 \
     if((entry_ptr)->ht_next)                                                 \
         (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev;                \
     if((entry_ptr)->ht_prev)                                                 \
         (entry_ptr)->ht_prev->ht_next = (entry_ptr)->ht_next;                \
-    if(((cache_ptr)->index)[k] == (entry_ptr))                               \
-        ((cache_ptr)->index)[k] = (entry_ptr)->ht_next;                      \
+    if(*bucket == (entry_ptr))                                               \
+        *bucket = (entry_ptr)->ht_next;                                      \
     (entry_ptr)->ht_next = NULL;                                             \
     (entry_ptr)->ht_prev = NULL;                                             \
     (cache_ptr)->index_len--;                                                \
@@ -1398,33 +1521,38 @@ if ( ( (cache_ptr)->index_size !=                                           \
         (cache_ptr)->num_last_entries--;                                     \
         HDassert((cache_ptr)->num_last_entries <= 1);                        \
     }                                                                        \
+    if((entry_ptr)->rp_hot) {                                                \
+        HDassert((cache_ptr)->rp_hot_size >= (entry_ptr)->size);             \
+        (cache_ptr)->rp_hot_size -= (entry_ptr)->size;                       \
+    }                                                                        \
     H5C__IL_DLL_REMOVE((entry_ptr), (cache_ptr)->il_head,                    \
                        (cache_ptr)->il_tail, (cache_ptr)->il_len,            \
                        (cache_ptr)->il_size, fail_val)                       \
     H5C__UPDATE_STATS_FOR_HT_DELETION(cache_ptr)                             \
     H5C__POST_HT_REMOVE_SC(cache_ptr, entry_ptr)                             \
+    H5C__INDEX_REHASH_STEP(cache_ptr)                                        \
 }
 
 #define H5C__SEARCH_INDEX(cache_ptr, Addr, entry_ptr, fail_val)             \
 {                                                                           \
-    int k;                                                                  \
+    H5C_cache_entry_t **bucket;                                             \
     int depth = 0;                                                          \
     H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)                        \
-    k = H5C__HASH_FCN(Addr);                                                \
-    entry_ptr = ((cache_ptr)->index)[k];                                    \
+    bucket = H5C__HASH_BUCKET(cache_ptr, Addr);                             \
+    entry_ptr = *bucket;                                                    \
     while(entry_ptr) {                                                      \
         if(H5F_addr_eq(Addr, (entry_ptr)->addr)) {                          \
-            H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, k, fail_val)   \
-            if(entry_ptr != ((cache_ptr)->index)[k]) {                      \
+            H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, bucket, fail_val) \
+            if(entry_ptr != *bucket) {                                      \
                 if((entry_ptr)->ht_next)                                    \
                     (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev;   \
                 HDassert((entry_ptr)->ht_prev != NULL);                     \
                 (entry_ptr)->ht_prev->ht_next = (entry_ptr)->ht_next;       \
-                ((cache_ptr)->index)[k]->ht_prev = (entry_ptr);             \
-                (entry_ptr)->ht_next = ((cache_ptr)->index)[k];             \
+                (*bucket)->ht_prev = (entry_ptr);                           \
+                (entry_ptr)->ht_next = *bucket;                             \
                 (entry_ptr)->ht_prev = NULL;                                \
-                ((cache_ptr)->index)[k] = (entry_ptr);                      \
-                H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k, fail_val) \
+                *bucket = (entry_ptr);                                      \
+                H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket, fail_val) \
             }                                                               \
             break;                                                          \
         }                                                                   \
@@ -1432,27 +1560,28 @@ if ( ( (cache_ptr)->index_size !=                                           \
         (depth)++;                                                          \
     }                                                                       \
     H5C__UPDATE_STATS_FOR_HT_SEARCH(cache_ptr, (entry_ptr != NULL), depth)  \
+    H5C__INDEX_REHASH_STEP(cache_ptr)                                       \
 }
 
 #define H5C__SEARCH_INDEX_NO_STATS(cache_ptr, Addr, entry_ptr, fail_val)    \
 {                                                                           \
-    int k;                                                                  \
+    H5C_cache_entry_t **bucket;                                             \
     H5C__PRE_HT_SEARCH_SC(cache_ptr, Addr, fail_val)                        \
-    k = H5C__HASH_FCN(Addr);                                                \
-    entry_ptr = ((cache_ptr)->index)[k];                                    \
+    bucket = H5C__HASH_BUCKET(cache_ptr, Addr);                             \
+    entry_ptr = *bucket;                                                    \
     while(entry_ptr) {                                                      \
         if(H5F_addr_eq(Addr, (entry_ptr)->addr)) {                          \
-            H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, k, fail_val)   \
-            if(entry_ptr != ((cache_ptr)->index)[k]) {                      \
+            H5C__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, bucket, fail_val) \
+            if(entry_ptr != *bucket) {                                      \
                 if((entry_ptr)->ht_next)                                    \
                     (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev;   \
                 HDassert((entry_ptr)->ht_prev != NULL);                     \
                 (entry_ptr)->ht_prev->ht_next = (entry_ptr)->ht_next;       \
-                ((cache_ptr)->index)[k]->ht_prev = (entry_ptr);             \
-                (entry_ptr)->ht_next = ((cache_ptr)->index)[k];             \
+                (*bucket)->ht_prev = (entry_ptr);                           \
+                (entry_ptr)->ht_next = *bucket;                             \
                 (entry_ptr)->ht_prev = NULL;                                \
-                ((cache_ptr)->index)[k] = (entry_ptr);                      \
-                H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k, fail_val) \
+                *bucket = (entry_ptr);                                      \
+                H5C__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket, fail_val) \
             }                                                               \
             break;                                                          \
         }                                                                   \
@@ -1507,6 +1636,10 @@ if ( ( (cache_ptr)->index_size !=                                           \
     (cache_ptr)->clean_index_size += (new_size);                        \
         ((cache_ptr)->clean_index_ring_size[entry_ptr->ring])+= (new_size); \
     }                                                                       \
+    if((entry_ptr)->rp_hot) {                                               \
+        (cache_ptr)->rp_hot_size -= (old_size);                             \
+        (cache_ptr)->rp_hot_size += (new_size);                             \
+    }                                                                       \
     H5C__DLL_UPDATE_FOR_SIZE_CHANGE((cache_ptr)->il_len,                    \
                                     (cache_ptr)->il_size,                   \
                                     (old_size), (new_size))                 \
@@ -1515,6 +1648,36 @@ if ( ( (cache_ptr)->index_size !=                                           \
 }
 
 
+/*-------------------------------------------------------------------------
+ *
+ * Macro:    H5C__2Q_UPDATE_FOR_HIT
+ *
+ * Purpose:     Promote an entry that has just been found in the cache to
+ *              the hot set of the 2Q replacement policy if it is cold and
+ *              enough other entries have been loaded since it was for the
+ *              hit not to be part of the access that loaded it.
+ *
+ *              Does nothing under the LRU replacement policy.
+ *
+ * Return:      N/A
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#define H5C__2Q_UPDATE_FOR_HIT(cache_ptr, entry_ptr)                        \
+{                                                                           \
+    if(((cache_ptr)->repl_policy == H5C_repl__2q) &&                        \
+            (!(entry_ptr)->rp_hot) &&                                       \
+            (((cache_ptr)->rp_load_count - (entry_ptr)->rp_load_seq) >=     \
+             (uint64_t)((cache_ptr)->index_len /                            \
+                        H5C__2Q_CORRELATED_DIVISOR))) {                     \
+        (entry_ptr)->rp_hot = TRUE;                                         \
+        (cache_ptr)->rp_hot_size += (entry_ptr)->size;                      \
+        H5C__UPDATE_STATS_FOR_HOT_PROMOTION(cache_ptr, entry_ptr)           \
+    }                                                                       \
+}
+
+
 /**************************************************************************
  *
  * Skip list insertion and deletion macros:
@@ -3585,6 +3748,110 @@ typedef struct H5C_tag_info_t {
 } H5C_tag_info_t;
 
 
+/****************************************************************************
+ *
+ * structure H5C_batch_write_t
+ *
+ * Structure describing the image of one entry in a batch of writes,
+ * as queued when the entry was flushed.
+ *
+ * The fields of this structure are discussed individually below:
+ *
+ * addr:   Address in the file at which the image is to be written.
+ *
+ * size:   Size of the image in bytes.
+ *
+ * offset: Offset of the copy of the image in the batch's buffer.
+ *
+ * seq:    Position of the image in the order in which images were queued,
+ *         so that the last image queued for a range of the file wins.
+ *
+ * type:   Memory type the image is written with.  Only images of the same
+ *         type are combined.
+ *
+ ****************************************************************************/
+typedef struct H5C_batch_write_t {
+    haddr_t addr;               /* Address of the image in the file */
+    size_t size;                /* Size of the image */
+    size_t offset;              /* Offset of the image in the batch's buffer */
+    size_t seq;                 /* Order in which the image was queued */
+    H5FD_mem_t type;            /* Memory type to write the image with */
+} H5C_batch_write_t;
+
+
+/****************************************************************************
+ *
+ * structure H5C_write_batch_t
+ *
+ * Structure holding the entry images queued while a ring is flushed.  When
+ * the ring has been flushed, or the batch is full, the images are sorted by
+ * address, images that are adjacent in the file are combined into a single
+ * buffer, and the result is written with one vector write per memory type.
+ *
+ * The fields of this structure are discussed individually below:
+ *
+ * active: Boolean flag indicating whether the images of flushed entries
+ *         are queued in the batch, instead of being written directly.
+ *
+ * nwrites: Number of images in the batch.
+ *
+ * nalloc: Number of elements allocated for the writes array.
+ *
+ * writes: Array of descriptions of the images in the batch.
+ *
+ * buf_used: Number of bytes of buf holding images.
+ *
+ * buf_size: Size of the buffer in bytes.
+ *
+ * buf:    Buffer holding copies of the images in the batch, in the order
+ *         they were queued.
+ *
+ ****************************************************************************/
+typedef struct H5C_write_batch_t {
+    hbool_t active;             /* Whether images are queued in the batch */
+    size_t nwrites;             /* Number of images in the batch */
+    size_t nalloc;              /* Number of writes allocated */
+    H5C_batch_write_t *writes;  /* Descriptions of the images */
+    size_t buf_used;            /* Number of bytes used in the buffer */
+    size_t buf_size;            /* Size of the buffer */
+    uint8_t *buf;               /* Copies of the images */
+} H5C_write_batch_t;
+
+
+/****************************************************************************
+ *
+ * structure H5C_read_ahead_t
+ *
+ * Structure holding the image of an entry read from the file by
+ * H5C_prefetch_entries() before the entry was protected.  The images are
+ * kept in a list on the cache, from which H5C__load_entry() copies the
+ * image of an entry instead of reading it from the file.
+ *
+ * The fields of this structure are discussed individually below:
+ *
+ * addr:   Address in the file of the image.
+ *
+ * len:    Length of the image in bytes.  For classes whose entries are
+ *         loaded speculatively, this may be more or less than the size of
+ *         the entry.
+ *
+ * type:   Memory type the image was read with.
+ *
+ * image:  Buffer holding the image.
+ *
+ * next:   Pointer to the next (more recently read) image in the list, or
+ *         NULL if this is the last one.
+ *
+ ****************************************************************************/
+typedef struct H5C_read_ahead_t {
+    haddr_t addr;                   /* Address of the image in the file */
+    size_t len;                     /* Length of the image */
+    H5FD_mem_t type;                /* Memory type of the image */
+    uint8_t *image;                 /* Buffer holding the image */
+    struct H5C_read_ahead_t *next;  /* Next image in the list */
+} H5C_read_ahead_t;
+
+
 /****************************************************************************
  *
  * structure H5C_t
@@ -3778,20 +4045,38 @@ typedef struct H5C_tag_info_t {
  *        index by ring.  Note that the sum of all cells in this array
  *        must equal the value stored in dirty_index_size above.
  *
- * index:    Array of pointer to H5C_cache_entry_t of size
- *        H5C__HASH_TABLE_LEN.  At present, this value is a power
- *        of two, not the usual prime number.
+ * index:    Dynamically allocated array of pointer to H5C_cache_entry_t
+ *        of length 2^index_nbits, used as the buckets of the hash
+ *        table.  Entries are assigned to buckets by the H5C__HASH_FCN
+ *        macro, a multiplicative hash of the entry's address.
+ *
+ *        The table grows (doubles) when the index holds more entries
+ *        than the table has buckets, and shrinks (halves) when it holds
+ *        fewer than one entry for every eight buckets, within the
+ *        bounds set by H5C__HASH_MIN_NBITS and H5C__HASH_MAX_NBITS.
+ *
+ *        So that no single operation pays for the whole resize, the
+ *        entries are moved to the new table incrementally: every
+ *        insertion, deletion and search moves the entries of the next
+ *        H5C__HASH_REHASH_STEP buckets of the old table, until the old
+ *        table is empty and can be freed.  Use the H5C__HASH_BUCKET
+ *        macro to find the bucket holding an address.
+ *
+ * index_nbits: Log2 of the number of buckets in index.
+ *
+ * old_index:    Table of buckets the index is being moved out of while it
+ *        is resized, or NULL if no resize is in progress.
  *
- *        I hope that the variable size of cache elements, the large
- *        hash table size, and the way in which HDF5 allocates space
- *        will combine to avoid problems with periodicity.  If so, we
- *        can use a trivial hash function (a bit-and and a 3 bit left
- *        shift) with some small savings.
+ * old_index_nbits: Log2 of the number of buckets in old_index.
  *
- *        If not, it will become evident in the statistics. Changing
- *        to the usual prime number length hash table will require
- *        changing the H5C__HASH_FCN macro and the deletion of the
- *        H5C__HASH_MASK #define.  No other changes should be required.
+ * index_rehash_next: Number of the next bucket of old_index to move to
+ *        index.  Buckets of old_index below this number are empty.
+ *
+ * index_seq: Sequence number of the pair of tables of the index.  It is
+ *        odd while a resize is being started, so that threads searching
+ *        the index without the library's lock (see the shared_reads
+ *        field) know when index, index_nbits, old_index and
+ *        old_index_nbits are consistent.
  *
  * il_len:    Number of entries on the index list.
  *
@@ -4182,6 +4467,36 @@ typedef struct H5C_tag_info_t {
  *              This field is NULL if the list is empty.
  *
  *
+ * Fields supporting the scan-resistant replacement policy:
+ *
+ * A plain LRU policy lets a single pass over many entries that are used
+ * once (a scan of a large chunk index, say) flush out entries such as the
+ * upper nodes of a B-tree that are used over and over.  When repl_policy
+ * is H5C_repl__2q, the cache instead keeps a "hot" set in the spirit of
+ * the 2Q and segmented LRU algorithms, without a separate list:
+ *
+ * Newly loaded or inserted entries are cold.  A cold entry becomes hot
+ * when it is protected again after at least index_len /
+ * H5C__2Q_CORRELATED_DIVISOR other entries have been loaded since it was.
+ * When H5C__make_space_in_cache() finds a hot entry at the tail of the
+ * LRU list, it moves the entry back to the head instead of evicting it,
+ * as long as hot entries use no more than H5C__2Q_HOT_PERCENT of
+ * max_cache_size.  Otherwise the entry is demoted to cold and handled as
+ * under the LRU policy.  A scan of cold entries therefore evicts other
+ * cold entries first.
+ *
+ * Evictions done on behalf of parallel reads use the clean LRU list and
+ * ignore the hot set.
+ *
+ * repl_policy: Replacement policy in use, as set by H5C_set_repl_policy().
+ *
+ * rp_load_count: Number of entries loaded or inserted into the cache so
+ *              far.  The value is stored in the rp_load_seq field of each
+ *              entry when it enters the cache.
+ *
+ * rp_hot_size: Number of bytes of hot entries currently in the cache.
+ *
+ *
  * Automatic cache size adjustment:
  *
  * While the default cache size is adequate for most cases, we can run into
@@ -4388,6 +4703,10 @@ typedef struct H5C_tag_info_t {
  *        that are larger than the actual image.  Thus in all
  *        cases image_data_len <= image_len.
  *
+ * image_index_size: Size in bytes of the index of the entries in an
+ *        indexed (version 1) metadata cache image block, or zero if
+ *        the image block is not indexed.
+ *
  * To create the metadata cache image, we must first serialize all the
  * entries in the metadata cache.  This is done by a scan of the index.
  * As entries must be serialized in increasing flush dependency height
@@ -4443,6 +4762,97 @@ typedef struct H5C_tag_info_t {
  *        image_len in which the metadata cache image is assembled,
  *        or NULL if that    buffer does not exist.
  *
+ * When a file with an indexed metadata cache image is opened read only,
+ * the entries in the image are not inserted into the cache.  Instead, the
+ * index of the image is kept, and the image of an entry is read from the
+ * cache image block the first time the entry is loaded:
+ *
+ * image_index: Pointer to a dynamically allocated array of instances of
+ *        H5C_image_entry_t of length image_index_nentries, sorted by
+ *        entry address, or NULL if there is no such index.
+ *
+ * image_index_nentries: Number of entries in image_index.
+ *
+ *
+ * Field supporting batched writes during flushes:
+ *
+ * write_batch: Queue of the images of entries flushed by H5C__flush_ring(),
+ *        which are written to the file in address order, combined into as
+ *        few write calls as possible, when the ring has been flushed.
+ *        Images are only queued when the file driver doesn't accumulate
+ *        metadata, and not for SWMR writers, which must write entries in
+ *        flush dependency order, when page buffering is enabled, or in
+ *        the parallel case.
+ *
+ *
+ * Fields supporting the read-ahead of entry images:
+ *
+ * ra_head: Pointer to the head (least recently read) of the list of images
+ *        read by H5C_prefetch_entries() for entries that have not been
+ *        loaded yet, or NULL if the list is empty.  An image is discarded
+ *        when an entry overlapping it is loaded, inserted, moved or
+ *        written, and the oldest images are discarded when the images in
+ *        the list use more than H5C__READ_AHEAD_MAX_SIZE bytes.
+ *
+ * ra_tail: Pointer to the tail (most recently read) of the list of images,
+ *        or NULL if the list is empty.
+ *
+ * ra_size: Number of bytes of images in the list.
+ *
+ *
+ * Fields supporting the metadata access trace:
+ *
+ * When a file is opened with an access trace location, the entries loaded
+ * from the file are recorded in the order they are loaded, and written to
+ * the trace when the cache is destroyed.  The next time the file is opened,
+ * the entries in the trace are read ahead with H5C_prefetch_entries() once
+ * the superblock has been read, and nothing is recorded.
+ *
+ * trace_location: Pointer to the path of the access trace, or NULL if
+ *        no access trace is kept.
+ *
+ * trace_recording: Boolean flag that is TRUE while the entries loaded
+ *        are being recorded.
+ *
+ * trace_reqs: Pointer to a dynamically allocated array of the entries
+ *        recorded, in the order they were loaded, or NULL if none have
+ *        been recorded.
+ *
+ * trace_nreqs: Number of entries in trace_reqs.
+ *
+ * trace_nalloc: Number of entries allocated for trace_reqs.
+ *
+ * trace_size: Sum of the lengths of the entries in trace_reqs.  No more
+ *        entries are recorded once this would exceed
+ *        H5C__READ_AHEAD_MAX_SIZE.
+ *
+ *
+ * Fields supporting shared reads:
+ *
+ * Once shared reads are enabled, threads that don't hold the library's
+ * lock can look up clean entries with H5C_protect_shared() while the
+ * thread that does hold it uses the cache as usual.  The lookups take no
+ * lock: each one counts itself as a reader in the current epoch while it
+ * searches the index, and holds on to the entry it finds by incrementing
+ * the entry's shared_ref_count field.
+ *
+ * Entries are retired before they leave the index (see
+ * H5C__retire_shared_entry()), which fails while the entry has shared
+ * references, so evictions skip them.  Once an entry has left the index,
+ * its memory isn't freed until the readers that may still be looking at it
+ * are done (see H5C__shared_synchronize()), in the manner of RCU.  Old
+ * tables of the index are released the same way.
+ *
+ * shared_reads: Boolean flag that is TRUE when threads may look up
+ *        entries with H5C_protect_shared().  Once set, it stays set
+ *        until the cache is destroyed.
+ *
+ * shared_epoch: Current epoch of the readers.  Readers count themselves
+ *        in shared_readers[shared_epoch % 2].
+ *
+ * shared_readers: Array of the number of readers searching the index, by
+ *        the parity of the epoch they started in.
+ *
  *
  * Free Space Manager Related fields:
  *
@@ -4737,6 +5147,31 @@ typedef struct H5C_tag_info_t {
  * prefetch_hits:  Number of prefetched entries that are actually used.
  *
  *
+ * Fields for tracking the scan-resistant replacement policy:
+ *
+ * hot_promotions:  Array of int64 of length H5C__MAX_NUM_TYPE_IDS + 1.
+ *              The cells are used to record the number of times an entry
+ *              with type id equal to the array index has been promoted
+ *              to the hot set by a hit under the 2Q replacement policy.
+ *
+ * hot_second_chances:  Array of int64 of length H5C__MAX_NUM_TYPE_IDS + 1.
+ *              The cells are used to record the number of times a hot
+ *              entry with type id equal to the array index has been moved
+ *              back to the head of the LRU list instead of being evicted.
+ *
+ *
+ * Fields for tracking the read-ahead of entry images:
+ *
+ * read_aheads: Number of calls to H5C_prefetch_entries() that read the
+ *              images of one or more entries.
+ *
+ * read_ahead_images: Number of entry images read by H5C_prefetch_entries().
+ *
+ * read_ahead_hits: Number of reads of entry images by H5C__load_entry()
+ *              that were satisfied from an image read ahead, instead of
+ *              from the file.
+ *
+ *
  * As entries are now capable of moving, loading, dirtying, and deleting
  * other entries in their pre_serialize and serialize callbacks, it has
  * been necessary to insert code to restart scans of lists so as to avoid
@@ -4837,7 +5272,12 @@ struct H5C_t {
     size_t            clean_index_ring_size[H5C_RING_NTYPES];
     size_t            dirty_index_size;
     size_t            dirty_index_ring_size[H5C_RING_NTYPES];
-    H5C_cache_entry_t *            index[H5C__HASH_TABLE_LEN];
+    H5C_cache_entry_t **          index;
+    unsigned                    index_nbits;
+    H5C_cache_entry_t **          old_index;
+    unsigned                    old_index_nbits;
+    size_t                      index_rehash_next;
+    unsigned                    index_seq;
     uint32_t                    il_len;
     size_t                      il_size;
     H5C_cache_entry_t *            il_head;
@@ -4899,6 +5339,11 @@ struct H5C_t {
     H5C_cache_entry_t *            dLRU_tail_ptr;
 #endif /* H5C_MAINTAIN_CLEAN_AND_DIRTY_LRU_LISTS */
 
+    /* Fields for the scan-resistant replacement policy */
+    enum H5C_cache_repl_policy  repl_policy;
+    uint64_t                    rp_load_count;
+    size_t                      rp_hot_size;
+
 #ifdef H5_HAVE_PARALLEL
     /* Fields for collective metadata reads */
     uint32_t                    coll_list_len;
@@ -4944,6 +5389,7 @@ struct H5C_t {
     haddr_t             image_addr;
     hsize_t            image_len;
     hsize_t            image_data_len;
+    hsize_t                     image_index_size;
     int64_t            entries_loaded_counter;
     int64_t            entries_inserted_counter;
     int64_t            entries_relocated_counter;
@@ -4951,6 +5397,29 @@ struct H5C_t {
     uint32_t            num_entries_in_image;
     H5C_image_entry_t *        image_entries;
     void *                      image_buffer;
+    H5C_image_entry_t *         image_index;
+    uint32_t                    image_index_nentries;
+
+    /* Field supporting batched writes during flushes */
+    H5C_write_batch_t           write_batch;
+
+    /* Fields supporting the read-ahead of entry images */
+    H5C_read_ahead_t *          ra_head;
+    H5C_read_ahead_t *          ra_tail;
+    size_t                      ra_size;
+
+    /* Fields supporting the metadata access trace */
+    char *                      trace_location;
+    hbool_t                     trace_recording;
+    H5C_prefetch_req_t *        trace_reqs;
+    size_t                      trace_nreqs;
+    size_t                      trace_nalloc;
+    size_t                      trace_size;
+
+    /* Fields supporting shared reads */
+    hbool_t                     shared_reads;
+    unsigned                    shared_epoch;
+    int                         shared_readers[2];
 
     /* Free Space Manager Related fields */
     hbool_t             rdfsm_settled;
@@ -5032,6 +5501,15 @@ struct H5C_t {
     int64_t            dirty_prefetches;
     int64_t            prefetch_hits;
 
+    /* Fields for tracking the scan-resistant replacement policy */
+    int64_t                     hot_promotions[H5C__MAX_NUM_TYPE_IDS + 1];
+    int64_t                     hot_second_chances[H5C__MAX_NUM_TYPE_IDS + 1];
+
+    /* Fields for tracking the read-ahead of entry images */
+    int64_t                     read_aheads;
+    int64_t                     read_ahead_images;
+    int64_t                     read_ahead_hits;
+
 #if H5C_COLLECT_CACHE_ENTRY_STATS
     int32_t                     max_accesses[H5C__MAX_NUM_TYPE_IDS + 1];
     int32_t                     min_accesses[H5C__MAX_NUM_TYPE_IDS + 1];
@@ -5072,12 +5550,24 @@ H5_DLL herr_t H5C__flush_single_entry(H5F_t *f, H5C_cache_entry_t *entry_ptr,
     unsigned flags);
 H5_DLL herr_t H5C__generate_cache_image(H5F_t *f, H5C_t *cache_ptr);
 H5_DLL herr_t H5C__load_cache_image(H5F_t *f);
+H5_DLL const H5C_image_entry_t *H5C__find_image_index_entry(const H5C_t *cache_ptr,
+    haddr_t addr);
+H5_DLL herr_t H5C__read_image_index_entry(H5F_t *f, const H5C_image_entry_t *ie_ptr,
+    void *image);
+H5_DLL herr_t H5C__free_image_index(H5C_t *cache_ptr);
+H5_DLL herr_t H5C__record_access(H5C_t *cache_ptr, const H5C_class_t *type, haddr_t addr,
+    size_t len);
+H5_DLL herr_t H5C__access_trace_tear_down(H5F_t *f);
 H5_DLL herr_t H5C__mark_flush_dep_serialized(H5C_cache_entry_t * entry_ptr);
 H5_DLL herr_t H5C__mark_flush_dep_unserialized(H5C_cache_entry_t * entry_ptr);
 H5_DLL herr_t H5C__make_space_in_cache(H5F_t * f, size_t  space_needed,
     hbool_t write_permitted);
 H5_DLL herr_t H5C__flush_marked_entries(H5F_t * f);
 H5_DLL herr_t H5C__serialize_cache(H5F_t *f);
+H5_DLL void H5C__rehash_index(H5C_t *cache_ptr);
+H5_DLL hbool_t H5C__retire_shared_entry(H5C_t *cache_ptr, H5C_cache_entry_t *entry_ptr,
+    hbool_t wait);
+H5_DLL void H5C__shared_synchronize(H5C_t *cache_ptr);
 H5_DLL herr_t H5C__iter_tagged_entries(H5C_t *cache, haddr_t tag, hbool_t match_global,
     H5C_tag_iter_cb_t cb, void *cb_ctx);
 
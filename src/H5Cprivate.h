@@ -62,8 +62,9 @@
 #endif /* H5_HAVE_PARALLEL */
 
 /* Flags for cache client class behavior */
-#define H5C__CLASS_NO_FLAGS_SET          ((unsigned)0x0)
-#define H5C__CLASS_SPECULATIVE_LOAD_FLAG ((unsigned)0x1)
+#define H5C__CLASS_NO_FLAGS_SET            ((unsigned)0x0)
+#define H5C__CLASS_SPECULATIVE_LOAD_FLAG   ((unsigned)0x1)
+#define H5C__CLASS_PARALLEL_SERIALIZE_FLAG ((unsigned)0x8)
 /* The following flags may only appear in test code */
 #define H5C__CLASS_SKIP_READS  ((unsigned)0x2)
 #define H5C__CLASS_SKIP_WRITES ((unsigned)0x4)
@@ -76,10 +77,8 @@
 /* Upper and lower limits on cache size.  These limits are picked
  * out of a hat -- you should be able to change them as necessary.
  *
- * However, if you need a very big cache, you should also increase the
- * size of the hash table (H5C__HASH_TABLE_LEN in H5Cpkg.h).  The current
- * upper bound on cache size is rather large for the current hash table
- * size.
+ * The hash table of the cache index resizes itself with the number of
+ * entries in the cache, up to 2^H5C__HASH_MAX_NBITS buckets (see H5Cpkg.h).
  */
 #define H5C__MAX_MAX_CACHE_SIZE ((size_t)(128 * 1024 * 1024))
 #define H5C__MIN_MAX_CACHE_SIZE ((size_t)(1024))
@@ -314,6 +313,14 @@ typedef struct H5C_t H5C_t;
  *        read past the end of file, the size is truncated to
  *        avoid this, and processing proceeds as normal.
  *
+ *    H5C__CLASS_PARALLEL_SERIALIZE_FLAG: When this flag is set, the
+ *        serialize callback may be called on a worker thread, at the
+ *        same time as the serialize callbacks of other entries with
+ *        this flag.  It may only be set for classes without a
+ *        pre_serialize callback, whose serialize callback only reads
+ *        the file and other entries, and writes nothing but the entry
+ *        itself and its image.
+ *
  *      The following flags may only appear in test code.
  *
  *    H5C__CLASS_SKIP_READS: This flags is intended only for use in test
@@ -899,6 +906,15 @@ typedef struct H5C_class_t {
     H5C_get_fsf_size_t               fsf_size;
 } H5C_class_t;
 
+/* Description of an entry whose image is to be read ahead by H5C_prefetch_entries().
+ * For classes whose entries are loaded speculatively, the length may be an upper bound.
+ */
+typedef struct H5C_prefetch_req_t {
+    const H5C_class_t *type; /* Class of the entry */
+    haddr_t            addr; /* Address of the entry in the file */
+    size_t             len;  /* Expected length of the entry's image */
+} H5C_prefetch_req_t;
+
 /* Type definitions of callback functions used by the cache as a whole */
 typedef herr_t (*H5C_write_permitted_func_t)(const H5F_t *f, hbool_t *write_permitted_ptr);
 typedef herr_t (*H5C_log_flush_func_t)(H5C_t *cache_ptr, haddr_t addr, hbool_t was_dirty, unsigned flags);
@@ -1327,6 +1343,29 @@ typedef int H5C_ring_t;
  *        In either case, when there is no previous item, it should
  *        be NULL.
  *
+ * rp_hot:    Boolean flag indicating whether the entry belongs to the hot
+ *        set of the scan-resistant (2Q) replacement policy.  Hot
+ *        entries are moved back to the head of the LRU list instead
+ *        of being evicted while the hot set is below its size limit.
+ *        The flag is only set when the cache's repl_policy is
+ *        H5C_repl__2q.  See the discussion in H5Cpkg.h.
+ *
+ * rp_load_seq: Value of the cache's rp_load_count field when the entry
+ *        was loaded or inserted.  Used to tell a hit that repeats the
+ *        access that loaded the entry from genuine reuse.
+ *
+ * Fields supporting shared reads:
+ *
+ * shared_ref_count: Number of references to the entry held by threads
+ *        that looked it up with H5C_protect_shared().  It is changed
+ *        atomically, by threads that may not hold the library's lock.
+ *        The entry can't leave the index while it is non-zero.
+ *
+ * shared_retired: Boolean flag set by the thread holding the library's
+ *        lock when the entry is about to leave the index.  Lookups that
+ *        find it set don't take a reference.  See the discussion of
+ *        shared reads in H5Cpkg.h.
+ *
  * Fields supporting the cache image feature:
  *
  * The following fields are used to store data about the entry which must
@@ -1644,6 +1683,12 @@ typedef struct H5C_cache_entry_t {
     struct H5C_cache_entry_t *coll_next;
     struct H5C_cache_entry_t *coll_prev;
 #endif /* H5_HAVE_PARALLEL */
+    hbool_t                   rp_hot;
+    uint64_t                  rp_load_seq;
+
+    /* fields supporting shared reads */
+    int     shared_ref_count;
+    hbool_t shared_retired;
 
     /* fields supporting cache image */
     hbool_t  include_in_image;
@@ -1818,6 +1863,22 @@ typedef struct H5C_cache_entry_t {
  *               callbacks must be used to update this image before it is
  *               written to disk
  *
+ * The following fields are only used with indexed (version 1) cache
+ * image blocks, in which the images of the entries follow the index of
+ * the entries, and may be compressed:
+ *
+ * stored_image_ptr: Pointer to the dynamically allocated compressed image
+ *               of the entry, or NULL if the image is stored as is.
+ *
+ * stored_size:  Length in bytes of the image of the entry as stored in
+ *               the cache image block.  This is less than size iff the
+ *               stored image is compressed.
+ *
+ * stored_offset: Offset of the stored image of the entry from the start
+ *               of the cache image block.  Only set when the image of
+ *               the entry is to be read from the block on first use.
+ *
+ * stored_chksum: Checksum of the stored image of the entry.
  *
  ****************************************************************************/
 
@@ -1836,6 +1897,10 @@ typedef struct H5C_image_entry_t {
     uint64_t   fd_child_count;
     uint64_t   fd_dirty_child_count;
     void *     image_ptr;
+    void *     stored_image_ptr;
+    size_t     stored_size;
+    hsize_t    stored_offset;
+    uint32_t   stored_chksum;
 } H5C_image_entry_t;
 
 /****************************************************************************
@@ -2176,6 +2241,13 @@ typedef struct H5C_auto_size_ctl_t {
  *      current value, any value in excess of 255 will be the functional
  *      equivalent of H5AC__CACHE_IMAGE__ENTRY_AGEOUT__NONE.
  *
+ * compress_image:  Boolean flag indicating whether the cache image should
+ *      be written in the indexed format (version 1 of the cache image
+ *      block), with the entry images compressed with the deflate filter
+ *      if it is available.  When a file with an indexed cache image is
+ *      opened read only, entries are only read from the image when they
+ *      are first protected.
+ *
  * flags: Unsigned integer containing flags controlling which aspects of the
  *    cache image functinality is actually executed.  The primary impetus
  *    behind this field is to allow development of tests for partial
@@ -2202,6 +2274,7 @@ typedef struct H5C_auto_size_ctl_t {
             FALSE,                                 /* = generate_image */                                    \
             FALSE,                                 /* = save_resize_status */                                \
             H5AC__CACHE_IMAGE__ENTRY_AGEOUT__NONE, /* = entry_ageout */                                      \
+            FALSE,                                 /* = compress_image */                                    \
             H5C_CI__ALL_FLAGS                      /* = flags */                                             \
     }
 
@@ -2210,11 +2283,16 @@ typedef struct H5C_cache_image_ctl_t {
     hbool_t  generate_image;
     hbool_t  save_resize_status;
     int32_t  entry_ageout;
+    hbool_t  compress_image;
     unsigned flags;
 } H5C_cache_image_ctl_t;
 
 /* The cache logging output style */
-typedef enum H5C_log_style_t { H5C_LOG_STYLE_JSON, H5C_LOG_STYLE_TRACE } H5C_log_style_t;
+typedef enum H5C_log_style_t {
+    H5C_LOG_STYLE_JSON,
+    H5C_LOG_STYLE_TRACE,
+    H5C_LOG_STYLE_BINARY
+} H5C_log_style_t;
 
 /***************************************/
 /* Library-private Function Prototypes */
@@ -2251,6 +2329,7 @@ H5_DLL herr_t H5C_get_entry_status(const H5F_t *f, haddr_t addr, size_t *size_pt
                                    hbool_t *is_corked_ptr, hbool_t *is_flush_dep_parent_ptr,
                                    hbool_t *is_flush_dep_child_ptr, hbool_t *image_up_to_date_ptr);
 H5_DLL herr_t H5C_get_evictions_enabled(const H5C_t *cache_ptr, hbool_t *evictions_enabled_ptr);
+H5_DLL herr_t H5C_get_repl_policy(const H5C_t *cache_ptr, enum H5C_cache_repl_policy *repl_policy_ptr);
 H5_DLL void * H5C_get_aux_ptr(const H5C_t *cache_ptr);
 H5_DLL herr_t H5C_image_stats(H5C_t *cache_ptr, hbool_t print_header);
 H5_DLL herr_t H5C_insert_entry(H5F_t *f, const H5C_class_t *type, haddr_t addr, void *thing,
@@ -2262,6 +2341,7 @@ H5_DLL herr_t H5C_mark_entry_unserialized(void *thing);
 H5_DLL herr_t H5C_mark_entry_serialized(void *thing);
 H5_DLL herr_t H5C_move_entry(H5C_t *cache_ptr, const H5C_class_t *type, haddr_t old_addr, haddr_t new_addr);
 H5_DLL herr_t H5C_pin_protected_entry(void *thing);
+H5_DLL herr_t H5C_prefetch_entries(H5F_t *f, size_t count, const H5C_prefetch_req_t reqs[]);
 H5_DLL herr_t H5C_prep_for_file_close(H5F_t *f);
 H5_DLL herr_t H5C_create_flush_dependency(void *parent_thing, void *child_thing);
 H5_DLL void * H5C_protect(H5F_t *f, const H5C_class_t *type, haddr_t addr, void *udata, unsigned flags);
@@ -2270,6 +2350,7 @@ H5_DLL herr_t H5C_resize_entry(void *thing, size_t new_size);
 H5_DLL herr_t H5C_set_cache_auto_resize_config(H5C_t *cache_ptr, H5C_auto_size_ctl_t *config_ptr);
 H5_DLL herr_t H5C_set_cache_image_config(const H5F_t *f, H5C_t *cache_ptr, H5C_cache_image_ctl_t *config_ptr);
 H5_DLL herr_t H5C_set_evictions_enabled(H5C_t *cache_ptr, hbool_t evictions_enabled);
+H5_DLL herr_t H5C_set_repl_policy(H5C_t *cache_ptr, enum H5C_cache_repl_policy repl_policy);
 H5_DLL herr_t H5C_set_slist_enabled(H5C_t *cache_ptr, hbool_t slist_enabled, hbool_t clear_slist);
 H5_DLL herr_t H5C_set_prefix(H5C_t *cache_ptr, char *prefix);
 H5_DLL herr_t H5C_stats(H5C_t *cache_ptr, const char *cache_name, hbool_t display_detailed_stats);
@@ -2292,6 +2373,15 @@ H5_DLL herr_t   H5C_cache_image_status(H5F_t *f, hbool_t *load_ci_ptr, hbool_t *
 H5_DLL hbool_t  H5C_cache_image_pending(const H5C_t *cache_ptr);
 H5_DLL herr_t   H5C_get_mdc_image_info(H5C_t *cache_ptr, haddr_t *image_addr, hsize_t *image_len);
 
+/* Metadata access trace functions */
+H5_DLL herr_t H5C_access_trace_set_up(H5F_t *f, const char *location);
+H5_DLL herr_t H5C_replay_access_trace(H5F_t *f);
+
+/* Shared read functions */
+H5_DLL herr_t H5C_enable_shared_reads(H5C_t *cache_ptr);
+H5_DLL void * H5C_protect_shared(H5C_t *cache_ptr, const H5C_class_t *type, haddr_t addr);
+H5_DLL void   H5C_unprotect_shared(void *thing);
+
 /* Logging functions */
 H5_DLL herr_t H5C_start_logging(H5C_t *cache);
 H5_DLL herr_t H5C_stop_logging(H5C_t *cache);
@@ -42,6 +42,8 @@ enum H5C_cache_decr_mode {
     H5C_decr__age_out_with_threshold
 };
 
+enum H5C_cache_repl_policy { H5C_repl__lru, H5C_repl__2q };
+
 #ifdef __cplusplus
 }
 #endif
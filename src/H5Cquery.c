@@ -322,6 +322,35 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5C_get_evictions_enabled() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5C_get_repl_policy()
+ *
+ * Purpose:     Copy the current value of cache_ptr->repl_policy into
+ *              *repl_policy_ptr.
+ *
+ * Return:      SUCCEED on success, and FAIL on failure.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_get_repl_policy(const H5C_t *cache_ptr, enum H5C_cache_repl_policy *repl_policy_ptr)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if ((cache_ptr == NULL) || (cache_ptr->magic != H5C__H5C_T_MAGIC))
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad cache_ptr on entry.")
+
+    if (repl_policy_ptr == NULL)
+        HGOTO_ERROR(H5E_CACHE, H5E_SYSTEM, FAIL, "Bad repl_policy_ptr on entry.")
+
+    *repl_policy_ptr = cache_ptr->repl_policy;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_get_repl_policy() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5C_get_aux_ptr
  *
@@ -0,0 +1,341 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*-------------------------------------------------------------------------
+ *
+ * Created:     H5Cshared.c
+ *
+ * Purpose:     Functions for looking up clean metadata cache entries from
+ *              threads that don't hold the library's lock, while the
+ *              thread that holds it keeps using the cache.
+ *
+ *              A lookup takes no lock.  It counts itself as a reader in
+ *              the current epoch while it searches the index, and holds
+ *              on to the entry it finds with the entry's shared_ref_count
+ *              field.  The thread that owns the cache retires an entry
+ *              before removing it from the index, which fails while the
+ *              entry has shared references, and waits for the readers of
+ *              the epoch to finish before freeing the entry or an old
+ *              table of the index.
+ *
+ *              See the discussion of shared reads in H5Cpkg.h.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#include "H5Cmodule.h" /* This source code file is part of the H5C module */
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"  /* Generic Functions                        */
+#include "H5Cpkg.h"     /* Cache                                    */
+#include "H5Fprivate.h" /* Files                                    */
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Time to sleep while waiting for readers to finish, in nanoseconds */
+#define H5C__SHARED_WAIT_NSEC 1000
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+/********************/
+/* Local Prototypes */
+/********************/
+static H5C_cache_entry_t *H5C__shared_search(H5C_cache_entry_t **table, unsigned nbits, haddr_t addr);
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_enable_shared_reads
+ *
+ * Purpose:     Allow threads that don't hold the library's lock to look
+ *              up entries of the cache with H5C_protect_shared().
+ *
+ *              This is meant for caches of files that nothing writes:
+ *              entries that shared readers hold on to must not be
+ *              changed.  Shared reads can't be disabled again.
+ *
+ *              Does nothing in builds with threads where the compiler
+ *              doesn't support atomic operations.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5C_enable_shared_reads(H5C_t *cache_ptr)
+{
+    FUNC_ENTER_NOAPI_NOERR
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    if (H5C__SHARED_READS_SUPPORTED)
+        H5C__ATOMIC_STORE(&cache_ptr->shared_reads, TRUE);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5C_enable_shared_reads() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_protect_shared
+ *
+ * Purpose:     Look up the entry of the specified class at the specified
+ *              address, and hold on to it for reading, without taking
+ *              any lock.  This may be called by any number of threads at
+ *              once, and by threads that don't hold the library's lock.
+ *
+ *              Only clean entries that are already in the cache and
+ *              aren't protected read/write are found.  Nothing is loaded,
+ *              and the entry's place in the replacement policy is left
+ *              alone.  When NULL is returned, the caller has to protect
+ *              the entry the usual way, holding the library's lock.  This
+ *              can happen even though the entry is in the cache, when
+ *              the index is being changed at the same time.
+ *
+ *              The entry must be released with H5C_unprotect_shared(),
+ *              and can't be evicted until then.
+ *
+ * Return:      Pointer to the entry on success/NULL if it isn't found
+ *
+ *-------------------------------------------------------------------------
+ */
+void *
+H5C_protect_shared(H5C_t *cache_ptr, const H5C_class_t *type, haddr_t addr)
+{
+    H5C_cache_entry_t *entry_ptr = NULL;
+    unsigned           epoch;
+    unsigned           seq;
+    void *             ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(type);
+    HDassert(H5F_addr_defined(addr));
+
+    if (!H5C__ATOMIC_LOAD(&cache_ptr->shared_reads))
+        HGOTO_DONE(NULL)
+
+    /* Count this thread as a reader of the current epoch while it looks at
+     * the index and its entries
+     */
+    epoch = H5C__ATOMIC_LOAD(&cache_ptr->shared_epoch) % 2;
+    H5C__ATOMIC_INCR(&cache_ptr->shared_readers[epoch]);
+
+    /* Get a consistent view of the index's tables, and search them.  The
+     * entries that haven't been moved out of the old table yet are in it.
+     */
+    seq = H5C__ATOMIC_LOAD(&cache_ptr->index_seq);
+    if (0 == (seq % 2)) {
+        H5C_cache_entry_t **index       = H5C__ATOMIC_LOAD(&cache_ptr->index);
+        unsigned            index_nbits = H5C__ATOMIC_LOAD(&cache_ptr->index_nbits);
+        H5C_cache_entry_t **old_index   = H5C__ATOMIC_LOAD(&cache_ptr->old_index);
+        unsigned            old_nbits   = H5C__ATOMIC_LOAD(&cache_ptr->old_index_nbits);
+
+        if (H5C__ATOMIC_LOAD(&cache_ptr->index_seq) == seq) {
+            if (old_index)
+                entry_ptr = H5C__shared_search(old_index, old_nbits, addr);
+            if (NULL == entry_ptr)
+                entry_ptr = H5C__shared_search(index, index_nbits, addr);
+        } /* end if */
+    }     /* end if */
+
+    /* Take a reference to the entry, unless it's been retired meanwhile */
+    if (entry_ptr && H5C__ATOMIC_LOAD(&entry_ptr->type) == type &&
+        !H5C__ATOMIC_LOAD(&entry_ptr->is_dirty) &&
+        (!H5C__ATOMIC_LOAD(&entry_ptr->is_protected) || H5C__ATOMIC_LOAD(&entry_ptr->is_read_only))) {
+        H5C__ATOMIC_INCR(&entry_ptr->shared_ref_count);
+        if (H5C__ATOMIC_LOAD(&entry_ptr->shared_retired))
+            H5C__ATOMIC_DECR(&entry_ptr->shared_ref_count);
+        else
+            ret_value = (void *)entry_ptr;
+    } /* end if */
+
+    H5C__ATOMIC_DECR(&cache_ptr->shared_readers[epoch]);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C_protect_shared() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C_unprotect_shared
+ *
+ * Purpose:     Release an entry returned by H5C_protect_shared().  This
+ *              takes no lock either.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5C_unprotect_shared(void *thing)
+{
+    H5C_cache_entry_t *entry_ptr = (H5C_cache_entry_t *)thing;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity checks */
+    HDassert(entry_ptr);
+    HDassert(entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
+    HDassert(H5C__ATOMIC_LOAD(&entry_ptr->shared_ref_count) > 0);
+
+    H5C__ATOMIC_DECR(&entry_ptr->shared_ref_count);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5C_unprotect_shared() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__retire_shared_entry
+ *
+ * Purpose:     Stop shared readers from taking new references to an
+ *              entry that is about to leave the index.  This fails if
+ *              the entry has shared references.
+ *
+ *              Lookups that had found the entry before it was retired
+ *              may have incremented its shared_ref_count field only to
+ *              decrement it again.  When wait is TRUE, those are waited
+ *              for, so that only references that were actually returned
+ *              by H5C_protect_shared() make this fail.  Otherwise, it
+ *              fails on any non-zero count, which suits eviction scans
+ *              that can just pass over the entry.
+ *
+ *              Retiring an entry of a cache without shared reads, or an
+ *              entry that has already been retired, always succeeds.
+ *
+ * Return:      TRUE if the entry was retired/FALSE if it's in use
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5C__retire_shared_entry(H5C_t *cache_ptr, H5C_cache_entry_t *entry_ptr, hbool_t wait)
+{
+    hbool_t ret_value = TRUE; /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+    HDassert(entry_ptr);
+    HDassert(entry_ptr->magic == H5C__H5C_CACHE_ENTRY_T_MAGIC);
+
+    if (!cache_ptr->shared_reads || entry_ptr->shared_retired)
+        HGOTO_DONE(TRUE)
+
+    /* Set the flag before looking at the count.  A lookup increments the
+     * count before looking at the flag, so one of the two sees the other.
+     */
+    H5C__ATOMIC_STORE(&entry_ptr->shared_retired, TRUE);
+    if (H5C__ATOMIC_LOAD(&entry_ptr->shared_ref_count) > 0) {
+        if (wait)
+            H5C__shared_synchronize(cache_ptr);
+        if (!wait || H5C__ATOMIC_LOAD(&entry_ptr->shared_ref_count) > 0) {
+            H5C__ATOMIC_STORE(&entry_ptr->shared_retired, FALSE);
+            ret_value = FALSE;
+        } /* end if */
+    }     /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__retire_shared_entry() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__shared_synchronize
+ *
+ * Purpose:     Wait until the shared readers that may have seen an entry
+ *              or a table of the index before it was removed are done
+ *              with it, so that it can be freed.
+ *
+ *              New readers count themselves in the next epoch, so only
+ *              the readers already searching the index are waited for.
+ *              Lookups never block, so this is short.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5C__shared_synchronize(H5C_t *cache_ptr)
+{
+    unsigned epoch;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity checks */
+    HDassert(cache_ptr);
+    HDassert(cache_ptr->magic == H5C__H5C_T_MAGIC);
+
+    if (cache_ptr->shared_reads) {
+        epoch = cache_ptr->shared_epoch;
+        H5C__ATOMIC_STORE(&cache_ptr->shared_epoch, epoch + 1);
+
+        while (H5C__ATOMIC_LOAD(&cache_ptr->shared_readers[epoch % 2]) > 0)
+            H5_nanosleep((uint64_t)H5C__SHARED_WAIT_NSEC);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5C__shared_synchronize() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5C__shared_search
+ *
+ * Purpose:     Search one table of the index for the entry at an address,
+ *              for H5C_protect_shared().  Chains that are being changed
+ *              can't be trusted to end, so the search gives up after
+ *              H5C__SHARED_MAX_CHAIN_LEN entries.
+ *
+ * Return:      Pointer to the entry if found/NULL otherwise
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5C_cache_entry_t *
+H5C__shared_search(H5C_cache_entry_t **table, unsigned nbits, haddr_t addr)
+{
+    H5C_cache_entry_t *entry_ptr;
+    unsigned           u;
+    H5C_cache_entry_t *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    entry_ptr = H5C__ATOMIC_LOAD(&table[H5C__HASH_FCN(addr, nbits)]);
+    for (u = 0; entry_ptr && u < H5C__SHARED_MAX_CHAIN_LEN; u++) {
+        if (H5F_addr_eq(entry_ptr->addr, addr)) {
+            ret_value = entry_ptr;
+            break;
+        } /* end if */
+        entry_ptr = H5C__ATOMIC_LOAD(&entry_ptr->ht_next);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5C__shared_search() */
@@ -49,6 +49,9 @@
 /* Local Macros */
 /****************/
 
+/* Number of sequences gathered into each vector I/O request */
+#define H5D_CONTIG_VIO_BATCH 256
+
 /******************/
 /* Local Typedefs */
 /******************/
@@ -83,6 +86,18 @@ typedef struct H5D_contig_writevv_ud_t {
     const unsigned char *wbuf;      /* Pointer to buffer to write */
 } H5D_contig_writevv_ud_t;
 
+/* Callback info for zero-copy vector I/O operation */
+typedef struct H5D_contig_vio_ud_t {
+    H5F_shared_t * f_sh;                        /* Shared file for dataset */
+    haddr_t        dset_addr;                   /* Address of dataset */
+    hbool_t        do_write;                    /* Whether the requests are writes */
+    unsigned char *buf;                         /* Pointer to application buffer */
+    size_t         count;                       /* # of pending requests */
+    haddr_t        addrs[H5D_CONTIG_VIO_BATCH]; /* File addresses of pending requests */
+    size_t         sizes[H5D_CONTIG_VIO_BATCH]; /* Sizes of pending requests */
+    void *         bufs[H5D_CONTIG_VIO_BATCH];  /* Buffer locations of pending requests */
+} H5D_contig_vio_ud_t;
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -102,7 +117,11 @@ static ssize_t H5D__contig_writevv(const H5D_io_info_t *io_info, size_t dset_max
 static herr_t  H5D__contig_flush(H5D_t *dset);
 
 /* Helper routines */
-static herr_t H5D__contig_write_one(H5D_io_info_t *io_info, hsize_t offset, size_t size);
+static herr_t  H5D__contig_write_one(H5D_io_info_t *io_info, hsize_t offset, size_t size);
+static ssize_t H5D__contig_vio(const H5D_io_info_t *io_info, hbool_t do_write, size_t dset_max_nseq,
+                               size_t *dset_curr_seq, size_t dset_len_arr[], hsize_t dset_off_arr[],
+                               size_t mem_max_nseq, size_t *mem_curr_seq, size_t mem_len_arr[],
+                               hsize_t mem_off_arr[]);
 
 /*********************/
 /* Package Variables */
@@ -864,6 +883,137 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__contig_readvv_cb() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_vio_flush
+ *
+ * Purpose:	Issues the pending requests of a zero-copy vector I/O
+ *              operation to the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__contig_vio_flush(H5D_contig_vio_ud_t *udata)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if (udata->count > 0) {
+        if (udata->do_write) {
+            H5_GCC_DIAG_OFF("cast-qual")
+            if (H5F_shared_block_write_vector(udata->f_sh, H5FD_MEM_DRAW, udata->count, udata->addrs,
+                                              udata->sizes, (const void **)udata->bufs) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "vector write failed")
+            H5_GCC_DIAG_ON("cast-qual")
+        } /* end if */
+        else if (H5F_shared_block_read_vector(udata->f_sh, H5FD_MEM_DRAW, udata->count, udata->addrs,
+                                              udata->sizes, udata->bufs) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "vector read failed")
+
+        udata->count = 0;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__contig_vio_flush() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_vio_cb
+ *
+ * Purpose:	Callback operator for H5D__contig_vio(), which queues one
+ *              sequence and issues the batch when it is full.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__contig_vio_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udata)
+{
+    H5D_contig_vio_ud_t *udata     = (H5D_contig_vio_ud_t *)_udata; /* User data for H5VM_opvv() operator */
+    herr_t               ret_value = SUCCEED;                       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Queue the sequence */
+    udata->addrs[udata->count] = udata->dset_addr + dst_off;
+    udata->sizes[udata->count] = len;
+    udata->bufs[udata->count]  = udata->buf + src_off;
+    udata->count++;
+
+    /* Issue the batch when it's full */
+    if (udata->count == H5D_CONTIG_VIO_BATCH)
+        if (H5D__contig_vio_flush(udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "can't issue vector I/O")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__contig_vio_cb() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__contig_vio
+ *
+ * Purpose:	Transfers some data vectors directly between a contiguous
+ *              dataset (or unfiltered chunk) and the application's
+ *              buffer, with batches of sequences handed to the file
+ *              driver as single vector I/O requests.  The data sieve
+ *              buffer is flushed and released first, so that it can't
+ *              hold stale data afterwards.
+ *
+ * Return:	Success:	Number of bytes transferred
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static ssize_t
+H5D__contig_vio(const H5D_io_info_t *io_info, hbool_t do_write, size_t dset_max_nseq, size_t *dset_curr_seq,
+                size_t dset_len_arr[], hsize_t dset_off_arr[], size_t mem_max_nseq, size_t *mem_curr_seq,
+                size_t mem_len_arr[], hsize_t mem_off_arr[])
+{
+    H5D_rdcdc_t *       dset_contig = &(io_info->dset->shared->cache.contig); /* Cached contiguous data */
+    H5D_contig_vio_ud_t udata;          /* User data for H5VM_opvv() operator */
+    ssize_t             ret_value = -1; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Retire the sieve buffer */
+    if (dset_contig->sieve_buf) {
+        if (dset_contig->sieve_dirty) {
+            if (H5F_shared_block_write(io_info->f_sh, H5FD_MEM_DRAW, dset_contig->sieve_loc,
+                                       dset_contig->sieve_size, dset_contig->sieve_buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
+            dset_contig->sieve_dirty = FALSE;
+        } /* end if */
+
+        dset_contig->sieve_buf  = H5FL_BLK_FREE(sieve_buf, dset_contig->sieve_buf);
+        dset_contig->sieve_loc  = HADDR_UNDEF;
+        dset_contig->sieve_size = 0;
+    } /* end if */
+
+    /* Set up user data for H5VM_opvv() */
+    udata.f_sh      = io_info->f_sh;
+    udata.dset_addr = io_info->store->contig.dset_addr;
+    udata.do_write  = do_write;
+    H5_GCC_DIAG_OFF("cast-qual")
+    udata.buf = do_write ? (unsigned char *)io_info->u.wbuf : (unsigned char *)io_info->u.rbuf;
+    H5_GCC_DIAG_ON("cast-qual")
+    udata.count = 0;
+
+    /* Call generic sequence operation routine */
+    if ((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr, mem_max_nseq,
+                               mem_curr_seq, mem_len_arr, mem_off_arr, H5D__contig_vio_cb, &udata)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized I/O")
+
+    /* Issue the last batch */
+    if (H5D__contig_vio_flush(&udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "can't issue vector I/O")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__contig_vio() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5D__contig_readvv
  *
@@ -900,8 +1050,15 @@ H5D__contig_readvv(const H5D_io_info_t *io_info, size_t dset_max_nseq, size_t *d
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
+    /* Check if the data can go straight into the application's buffer */
+    if (io_info->use_vio) {
+        if ((ret_value = H5D__contig_vio(io_info, FALSE, dset_max_nseq, dset_curr_seq, dset_len_arr,
+                                         dset_off_arr, mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr)) <
+            0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vector read")
+    } /* end if */
     /* Check if data sieving is enabled */
-    if (H5F_SHARED_HAS_FEATURE(io_info->f_sh, H5FD_FEAT_DATA_SIEVE)) {
+    else if (H5F_SHARED_HAS_FEATURE(io_info->f_sh, H5FD_FEAT_DATA_SIEVE)) {
         H5D_contig_readvv_sieve_ud_t udata; /* User data for H5VM_opvv() operator */
 
         /* Set up user data for H5VM_opvv() */
@@ -1218,8 +1375,15 @@ H5D__contig_writevv(const H5D_io_info_t *io_info, size_t dset_max_nseq, size_t *
     HDassert(mem_len_arr);
     HDassert(mem_off_arr);
 
+    /* Check if the data can go straight from the application's buffer */
+    if (io_info->use_vio) {
+        if ((ret_value = H5D__contig_vio(io_info, TRUE, dset_max_nseq, dset_curr_seq, dset_len_arr,
+                                         dset_off_arr, mem_max_nseq, mem_curr_seq, mem_len_arr, mem_off_arr)) <
+            0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vector write")
+    } /* end if */
     /* Check if data sieving is enabled */
-    if (H5F_SHARED_HAS_FEATURE(io_info->f_sh, H5FD_FEAT_DATA_SIEVE)) {
+    else if (H5F_SHARED_HAS_FEATURE(io_info->f_sh, H5FD_FEAT_DATA_SIEVE)) {
         H5D_contig_writevv_sieve_ud_t udata; /* User data for H5VM_opvv() operator */
 
         /* Set up user data for H5VM_opvv() */
@@ -45,7 +45,7 @@
 
 /* Setup/teardown routines */
 static herr_t H5D__ioinfo_init(H5D_t *dset, const H5D_type_info_t *type_info, H5D_storage_t *store,
-                               H5D_io_info_t *io_info);
+                               H5D_io_vec_t *vec, H5D_io_info_t *io_info);
 static herr_t H5D__typeinfo_init(const H5D_t *dset, hid_t mem_type_id, hbool_t do_write,
                                  H5D_type_info_t *type_info);
 #ifdef H5_HAVE_PARALLEL
@@ -152,6 +152,7 @@ H5D__read(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space, const H5S_t
                                                   /* projected mem space must be discarded at the   */
                                                   /* end of the function to avoid a memory leak.    */
     H5D_storage_t store;                          /* union of EFL and chunk pointer in file space */
+    H5D_io_vec_t  io_vec;                         /* Sequence list arrays reused for the operation */
     hsize_t       nelmts;                         /* total number of elmts	*/
     hbool_t       io_op_init = FALSE;             /* Whether the I/O op has been initialized */
     char          fake_char;                      /* Temporary variable for NULL buffer pointers */
@@ -162,6 +163,9 @@ H5D__read(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space, const H5S_t
     /* check args */
     HDassert(dataset && dataset->oloc.file);
 
+    /* No sequence list arrays until the first selection I/O needs them */
+    HDmemset(&io_vec, 0, sizeof(io_vec));
+
     if (!file_space)
         file_space = dataset->shared->space;
     if (!mem_space)
@@ -284,7 +288,7 @@ H5D__read(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space, const H5S_t
     /* Set up I/O operation */
     io_info.op_type = H5D_IO_OP_READ;
     io_info.u.rbuf  = buf;
-    if (H5D__ioinfo_init(dataset, &type_info, &store, &io_info) < 0)
+    if (H5D__ioinfo_init(dataset, &type_info, &store, &io_vec, &io_info) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "unable to set up I/O operation")
 
     /* Sanity check that space is allocated, if there are elements */
@@ -330,6 +334,10 @@ done:
         if (H5S_close(projected_mem_space) < 0)
             HDONE_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "unable to shut down projected memory dataspace")
 
+    /* Release the sequence list arrays */
+    if (H5D__io_vec_release(&io_vec) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to release I/O vector arrays")
+
     FUNC_LEAVE_NOAPI_TAG(ret_value)
 } /* end H5D__read() */
 
@@ -368,6 +376,7 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space, const H5S_
                                                   /* projected mem space must be discarded at the   */
                                                   /* end of the function to avoid a memory leak.    */
     H5D_storage_t store;                          /* union of EFL and chunk pointer in file space */
+    H5D_io_vec_t  io_vec;                         /* Sequence list arrays reused for the operation */
     hsize_t       nelmts;                         /* total number of elmts	*/
     hbool_t       io_op_init = FALSE;             /* Whether the I/O op has been initialized */
     char          fake_char;                      /* Temporary variable for NULL buffer pointers */
@@ -378,6 +387,9 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space, const H5S_
     /* check args */
     HDassert(dataset && dataset->oloc.file);
 
+    /* No sequence list arrays until the first selection I/O needs them */
+    HDmemset(&io_vec, 0, sizeof(io_vec));
+
     /* All filters in the DCPL must have encoding enabled. */
     if (!dataset->shared->checked_filters) {
         if (H5Z_can_apply(dataset->shared->dcpl_id, dataset->shared->type_id) < 0)
@@ -487,7 +499,7 @@ H5D__write(H5D_t *dataset, hid_t mem_type_id, const H5S_t *mem_space, const H5S_
     /* Set up I/O operation */
     io_info.op_type = H5D_IO_OP_WRITE;
     io_info.u.wbuf  = buf;
-    if (H5D__ioinfo_init(dataset, &type_info, &store, &io_info) < 0)
+    if (H5D__ioinfo_init(dataset, &type_info, &store, &io_vec, &io_info) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up I/O operation")
 
     /* Allocate dataspace and initialize it if it hasn't been. */
@@ -565,6 +577,10 @@ done:
         if (H5S_close(projected_mem_space) < 0)
             HDONE_ERROR(H5E_DATASET, H5E_CANTCLOSEOBJ, FAIL, "unable to shut down projected memory dataspace")
 
+    /* Release the sequence list arrays */
+    if (H5D__io_vec_release(&io_vec) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to release I/O vector arrays")
+
     FUNC_LEAVE_NOAPI_TAG(ret_value)
 } /* end H5D__write() */
 
@@ -582,21 +598,27 @@ done:
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__ioinfo_init(H5D_t *dset, const H5D_type_info_t *type_info, H5D_storage_t *store, H5D_io_info_t *io_info)
+H5D__ioinfo_init(H5D_t *dset, const H5D_type_info_t *type_info, H5D_storage_t *store, H5D_io_vec_t *vec,
+                 H5D_io_info_t *io_info)
 {
-    FUNC_ENTER_STATIC_NOERR
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
 
     /* check args */
     HDassert(dset);
     HDassert(dset->oloc.file);
     HDassert(type_info);
     HDassert(type_info->tpath);
+    HDassert(vec);
     HDassert(io_info);
 
     /* Set up "normal" I/O fields */
-    io_info->dset  = dset;
-    io_info->f_sh  = H5F_SHARED(dset->oloc.file);
-    io_info->store = store;
+    io_info->dset    = dset;
+    io_info->f_sh    = H5F_SHARED(dset->oloc.file);
+    io_info->store   = store;
+    io_info->vec     = vec;
+    io_info->use_vio = FALSE;
 
     /* Set I/O operations to initial values */
     io_info->layout_ops = *dset->shared->layout.ops;
@@ -613,6 +635,17 @@ H5D__ioinfo_init(H5D_t *dset, const H5D_type_info_t *type_info, H5D_storage_t *s
          */
         io_info->io_ops.single_read  = H5D__select_read;
         io_info->io_ops.single_write = H5D__select_write;
+
+        /* Check whether the application asked for the file driver to
+         *  transfer directly between the file and its buffer.
+         */
+        if (H5F_shared_has_vector_io(io_info->f_sh)) {
+            hbool_t zero_copy_io = FALSE;
+
+            if (H5CX_get_zero_copy_io(&zero_copy_io) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't retrieve zero-copy I/O flag")
+            io_info->use_vio = zero_copy_io;
+        } /* end if */
     } /* end if */
     else {
         /*
@@ -627,7 +660,8 @@ H5D__ioinfo_init(H5D_t *dset, const H5D_type_info_t *type_info, H5D_storage_t *s
     io_info->using_mpi_vfd = H5F_HAS_FEATURE(dset->oloc.file, H5FD_FEAT_HAS_MPI);
 #endif /* H5_HAVE_PARALLEL */
 
-    FUNC_LEAVE_NOAPI(SUCCEED)
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__ioinfo_init() */
 
 /*-------------------------------------------------------------------------
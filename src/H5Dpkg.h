@@ -49,12 +49,16 @@
     (io_info)->dset    = ds;                                                                                 \
     (io_info)->f_sh    = H5F_SHARED((ds)->oloc.file);                                                        \
     (io_info)->store   = str;                                                                                \
+    (io_info)->vec     = NULL;                                                                               \
+    (io_info)->use_vio = FALSE;                                                                              \
     (io_info)->op_type = H5D_IO_OP_WRITE;                                                                    \
     (io_info)->u.wbuf  = buf
 #define H5D_BUILD_IO_INFO_RD(io_info, ds, str, buf)                                                          \
     (io_info)->dset    = ds;                                                                                 \
     (io_info)->f_sh    = H5F_SHARED((ds)->oloc.file);                                                        \
     (io_info)->store   = str;                                                                                \
+    (io_info)->vec     = NULL;                                                                               \
+    (io_info)->use_vio = FALSE;                                                                              \
     (io_info)->op_type = H5D_IO_OP_READ;                                                                     \
     (io_info)->u.rbuf  = buf
 
@@ -211,6 +215,15 @@ typedef enum H5D_io_op_type_t {
     H5D_IO_OP_WRITE /* Write operation */
 } H5D_io_op_type_t;
 
+/* Sequence list arrays for selection I/O, reused across calls within one operation */
+typedef struct H5D_io_vec_t {
+    size_t   nalloc;   /* Number of sequences each array can hold */
+    hsize_t *mem_off;  /* Sequence offsets in memory */
+    size_t * mem_len;  /* Sequence lengths in memory */
+    hsize_t *file_off; /* Sequence offsets in the file */
+    size_t * file_len; /* Sequence lengths in the file */
+} H5D_io_vec_t;
+
 typedef struct H5D_io_info_t {
     const H5D_t *dset;  /* Pointer to dataset being operated on */
                         /* QAK: Delete the f_sh field when oloc has a shared file pointer? */
@@ -222,6 +235,8 @@ typedef struct H5D_io_info_t {
     H5D_storage_t *  store;      /* Dataset storage info */
     H5D_layout_ops_t layout_ops; /* Dataset layout I/O operation function pointers */
     H5D_io_ops_t     io_ops;     /* I/O operation function pointers */
+    H5D_io_vec_t *   vec;        /* Cached sequence list arrays (NULL if not cached) */
+    hbool_t          use_vio;    /* Whether to use zero-copy vector I/O for contiguous storage */
     H5D_io_op_type_t op_type;
     union {
         void *      rbuf; /* Pointer to buffer for read */
@@ -590,6 +605,9 @@ H5_DLL herr_t H5D__select_read(const H5D_io_info_t *io_info, const H5D_type_info
                                const H5S_t *file_space, const H5S_t *mem_space);
 H5_DLL herr_t H5D__select_write(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                                 hsize_t nelmts, const H5S_t *file_space, const H5S_t *mem_space);
+H5_DLL herr_t H5D__select_vec_size(const H5S_t *space, size_t nelmts, size_t *vec_size);
+H5_DLL herr_t H5D__io_vec_reserve(H5D_io_vec_t *vec, size_t nseq);
+H5_DLL herr_t H5D__io_vec_release(H5D_io_vec_t *vec);
 
 /* Functions that perform scatter-gather serial I/O operations */
 H5_DLL herr_t H5D__scatter_mem(const void *_tscat_buf, H5S_sel_iter_t *iter, size_t nelmts, void *_buf);
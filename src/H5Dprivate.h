@@ -69,6 +69,8 @@
 #define H5D_XFER_VFL_ID_NAME                "vfl_id"              /* File driver ID */
 #define H5D_XFER_VFL_INFO_NAME              "vfl_info"            /* File driver info */
 #define H5D_XFER_HYPER_VECTOR_SIZE_NAME     "vec_size"            /* Hyperslab vector size */
+#define H5D_XFER_ZERO_COPY_IO_NAME          "zero_copy_io"        /* Vector I/O directly to/from user buffer */
+#define H5D_XFER_CONV_THREADS_NAME          "conv_threads"        /* # of threads for datatype conversion */
 #define H5D_XFER_IO_XFER_MODE_NAME          "io_xfer_mode"        /* I/O transfer mode */
 #define H5D_XFER_MPIO_COLLECTIVE_OPT_NAME   "mpio_collective_opt" /* Optimization of MPI-IO transfer mode */
 #define H5D_XFER_MPIO_CHUNK_OPT_HARD_NAME   "mpio_chunk_opt_hard"
@@ -111,6 +113,9 @@
 /* Default I/O vector size */
 #define H5D_IO_VECTOR_SIZE 1024
 
+/* Upper bound on the memory used by adaptively sized I/O vectors */
+#define H5D_IO_VECTOR_MAX_MEM (1024 * 1024)
+
 /* Default VL allocation & free info */
 #define H5D_VLEN_ALLOC      NULL
 #define H5D_VLEN_ALLOC_INFO NULL
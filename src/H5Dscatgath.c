@@ -27,6 +27,7 @@
 #include "H5FLprivate.h" /* Free Lists                           */
 #include "H5Iprivate.h"  /* IDs                                  */
 #include "H5MMprivate.h" /* Memory management			*/
+#include "H5VMprivate.h" /* Vectors and arrays                   */
 
 /****************/
 /* Local Macros */
@@ -43,6 +44,8 @@ static herr_t H5D__scatter_file(const H5D_io_info_t *io_info, H5S_sel_iter_t *fi
                                 const void *buf);
 static size_t H5D__gather_file(const H5D_io_info_t *io_info, H5S_sel_iter_t *file_iter, size_t nelmts,
                                void *buf);
+static htri_t H5D__scatgath_read_direct(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+                                        hsize_t nelmts, H5S_sel_iter_t *file_iter, const H5S_t *mem_space);
 static herr_t H5D__compound_opt_read(size_t nelmts, H5S_sel_iter_t *iter, const H5D_type_info_t *type_info,
                                      void *user_buf /*out*/);
 static herr_t H5D__compound_opt_write(size_t nelmts, const H5D_type_info_t *type_info);
@@ -84,15 +87,16 @@ static herr_t
 H5D__scatter_file(const H5D_io_info_t *_io_info, H5S_sel_iter_t *iter, size_t nelmts, const void *_buf)
 {
     H5D_io_info_t tmp_io_info;           /* Temporary I/O info object */
-    hsize_t *     off = NULL;            /* Pointer to sequence offsets */
+    H5D_io_vec_t  local_vec;             /* Sequence list arrays, when not cached in the I/O info */
+    H5D_io_vec_t *vec;                   /* Sequence list arrays in use */
+    hsize_t *     off;                   /* Pointer to sequence offsets */
     hsize_t       mem_off;               /* Offset in memory */
     size_t        mem_curr_seq;          /* "Current sequence" in memory */
     size_t        dset_curr_seq;         /* "Current sequence" in dataset */
-    size_t *      len = NULL;            /* Array to store sequence lengths */
+    size_t *      len;                   /* Array to store sequence lengths */
     size_t        orig_mem_len, mem_len; /* Length of sequence in memory */
     size_t        nseq;                  /* Number of sequences generated */
     size_t        nelem;                 /* Number of elements used in sequences */
-    size_t        dxpl_vec_size;         /* Vector length from API context's DXPL */
     size_t        vec_size;              /* Vector length */
     herr_t        ret_value = SUCCEED;   /* Return value */
 
@@ -109,19 +113,17 @@ H5D__scatter_file(const H5D_io_info_t *_io_info, H5S_sel_iter_t *iter, size_t ne
     tmp_io_info.op_type = H5D_IO_OP_WRITE;
     tmp_io_info.u.wbuf  = _buf;
 
-    /* Get info from API context */
-    if (H5CX_get_vec_size(&dxpl_vec_size) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't retrieve I/O vector size")
+    /* Use the I/O operation's cached sequence list arrays, if it has them */
+    HDmemset(&local_vec, 0, sizeof(local_vec));
+    vec = _io_info->vec ? _io_info->vec : &local_vec;
 
-    /* Allocate the vector I/O arrays */
-    if (dxpl_vec_size > H5D_IO_VECTOR_SIZE)
-        vec_size = dxpl_vec_size;
-    else
-        vec_size = H5D_IO_VECTOR_SIZE;
-    if (NULL == (len = H5FL_SEQ_MALLOC(size_t, vec_size)))
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O length vector array")
-    if (NULL == (off = H5FL_SEQ_MALLOC(hsize_t, vec_size)))
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O offset vector array")
+    /* Allocate (or reuse) the vector I/O arrays */
+    if (H5D__select_vec_size(NULL, nelmts, &vec_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't compute I/O vector size")
+    if (H5D__io_vec_reserve(vec, vec_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O vector arrays")
+    len = vec->file_len;
+    off = vec->file_off;
 
     /* Loop until all elements are written */
     while (nelmts > 0) {
@@ -147,11 +149,9 @@ H5D__scatter_file(const H5D_io_info_t *_io_info, H5S_sel_iter_t *iter, size_t ne
     } /* end while */
 
 done:
-    /* Release resources, if allocated */
-    if (len)
-        len = H5FL_SEQ_FREE(size_t, len);
-    if (off)
-        off = H5FL_SEQ_FREE(hsize_t, off);
+    /* Release vector arrays, if they aren't cached for the I/O operation */
+    if (H5D__io_vec_release(&local_vec) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to release I/O vector arrays")
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__scatter_file() */
@@ -181,15 +181,16 @@ static size_t
 H5D__gather_file(const H5D_io_info_t *_io_info, H5S_sel_iter_t *iter, size_t nelmts, void *_buf /*out*/)
 {
     H5D_io_info_t tmp_io_info;           /* Temporary I/O info object */
-    hsize_t *     off = NULL;            /* Pointer to sequence offsets */
+    H5D_io_vec_t  local_vec;             /* Sequence list arrays, when not cached in the I/O info */
+    H5D_io_vec_t *vec;                   /* Sequence list arrays in use */
+    hsize_t *     off;                   /* Pointer to sequence offsets */
     hsize_t       mem_off;               /* Offset in memory */
     size_t        mem_curr_seq;          /* "Current sequence" in memory */
     size_t        dset_curr_seq;         /* "Current sequence" in dataset */
-    size_t *      len = NULL;            /* Pointer to sequence lengths */
+    size_t *      len;                   /* Pointer to sequence lengths */
     size_t        orig_mem_len, mem_len; /* Length of sequence in memory */
     size_t        nseq;                  /* Number of sequences generated */
     size_t        nelem;                 /* Number of elements used in sequences */
-    size_t        dxpl_vec_size;         /* Vector length from API context's DXPL */
     size_t        vec_size;              /* Vector length */
     size_t        ret_value = nelmts;    /* Return value */
 
@@ -208,19 +209,17 @@ H5D__gather_file(const H5D_io_info_t *_io_info, H5S_sel_iter_t *iter, size_t nel
     tmp_io_info.op_type = H5D_IO_OP_READ;
     tmp_io_info.u.rbuf  = _buf;
 
-    /* Get info from API context */
-    if (H5CX_get_vec_size(&dxpl_vec_size) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, 0, "can't retrieve I/O vector size")
+    /* Use the I/O operation's cached sequence list arrays, if it has them */
+    HDmemset(&local_vec, 0, sizeof(local_vec));
+    vec = _io_info->vec ? _io_info->vec : &local_vec;
 
-    /* Allocate the vector I/O arrays */
-    if (dxpl_vec_size > H5D_IO_VECTOR_SIZE)
-        vec_size = dxpl_vec_size;
-    else
-        vec_size = H5D_IO_VECTOR_SIZE;
-    if (NULL == (len = H5FL_SEQ_MALLOC(size_t, vec_size)))
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, 0, "can't allocate I/O length vector array")
-    if (NULL == (off = H5FL_SEQ_MALLOC(hsize_t, vec_size)))
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, 0, "can't allocate I/O offset vector array")
+    /* Allocate (or reuse) the vector I/O arrays */
+    if (H5D__select_vec_size(NULL, nelmts, &vec_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, 0, "can't compute I/O vector size")
+    if (H5D__io_vec_reserve(vec, vec_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, 0, "can't allocate I/O vector arrays")
+    len = vec->file_len;
+    off = vec->file_off;
 
     /* Loop until all elements are read */
     while (nelmts > 0) {
@@ -246,11 +245,9 @@ H5D__gather_file(const H5D_io_info_t *_io_info, H5S_sel_iter_t *iter, size_t nel
     } /* end while */
 
 done:
-    /* Release resources, if allocated */
-    if (len)
-        len = H5FL_SEQ_FREE(size_t, len);
-    if (off)
-        off = H5FL_SEQ_FREE(hsize_t, off);
+    /* Release vector arrays, if they aren't cached for the I/O operation */
+    if (H5D__io_vec_release(&local_vec) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, 0, "unable to release I/O vector arrays")
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__gather_file() */
@@ -281,7 +278,6 @@ H5D__scatter_mem(const void *_tscat_buf, H5S_sel_iter_t *iter, size_t nelmts, vo
     size_t         nseq;                /* Number of sequences generated */
     size_t         curr_seq;            /* Current sequence being processed */
     size_t         nelem;               /* Number of elements used in sequences */
-    size_t         dxpl_vec_size;       /* Vector length from API context's DXPL */
     size_t         vec_size;            /* Vector length */
     herr_t         ret_value = SUCCEED; /* Number of elements scattered */
 
@@ -293,15 +289,11 @@ H5D__scatter_mem(const void *_tscat_buf, H5S_sel_iter_t *iter, size_t nelmts, vo
     HDassert(nelmts > 0);
     HDassert(buf);
 
-    /* Get info from API context */
-    if (H5CX_get_vec_size(&dxpl_vec_size) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't retrieve I/O vector size")
+    /* Get the number of sequences to retrieve per pass */
+    if (H5D__select_vec_size(NULL, nelmts, &vec_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't compute I/O vector size")
 
     /* Allocate the vector I/O arrays */
-    if (dxpl_vec_size > H5D_IO_VECTOR_SIZE)
-        vec_size = dxpl_vec_size;
-    else
-        vec_size = H5D_IO_VECTOR_SIZE;
     if (NULL == (len = H5FL_SEQ_MALLOC(size_t, vec_size)))
         HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O length vector array")
     if (NULL == (off = H5FL_SEQ_MALLOC(hsize_t, vec_size)))
@@ -366,7 +358,6 @@ H5D__gather_mem(const void *_buf, H5S_sel_iter_t *iter, size_t nelmts, void *_tg
     size_t         nseq;               /* Number of sequences generated */
     size_t         curr_seq;           /* Current sequence being processed */
     size_t         nelem;              /* Number of elements used in sequences */
-    size_t         dxpl_vec_size;      /* Vector length from API context's DXPL */
     size_t         vec_size;           /* Vector length */
     size_t         ret_value = nelmts; /* Number of elements gathered */
 
@@ -378,15 +369,11 @@ H5D__gather_mem(const void *_buf, H5S_sel_iter_t *iter, size_t nelmts, void *_tg
     HDassert(nelmts > 0);
     HDassert(tgath_buf);
 
-    /* Get info from API context */
-    if (H5CX_get_vec_size(&dxpl_vec_size) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, 0, "can't retrieve I/O vector size")
+    /* Get the number of sequences to retrieve per pass */
+    if (H5D__select_vec_size(NULL, nelmts, &vec_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, 0, "can't compute I/O vector size")
 
     /* Allocate the vector I/O arrays */
-    if (dxpl_vec_size > H5D_IO_VECTOR_SIZE)
-        vec_size = dxpl_vec_size;
-    else
-        vec_size = H5D_IO_VECTOR_SIZE;
     if (NULL == (len = H5FL_SEQ_MALLOC(size_t, vec_size)))
         HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, 0, "can't allocate I/O length vector array")
     if (NULL == (off = H5FL_SEQ_MALLOC(hsize_t, vec_size)))
@@ -423,6 +410,98 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__gather_mem() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5D__scatgath_read_direct
+ *
+ * Purpose:	Reads NELMTS elements from the file straight into the
+ *		application buffer and converts them there, when the memory
+ *		selection is a single contiguous run and no destination
+ *		element is smaller than its source.  Each strip's raw file
+ *		data is placed at the start of the strip's destination
+ *		elements and the conversion widens it in place (the
+ *		conversion routines walk the buffer back to front when the
+ *		destination is larger), so the data is never staged in the
+ *		type conversion buffer and scattered out again.
+ *
+ * Return:	TRUE if the data was read, FALSE if the caller must use
+ *		the type conversion buffer, Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__scatgath_read_direct(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info, hsize_t nelmts,
+                          H5S_sel_iter_t *file_iter, const H5S_t *mem_space)
+{
+    hsize_t  mem_dims[H5S_MAX_RANK];  /* Dimensions of memory dataspace */
+    hsize_t  mem_start[H5S_MAX_RANK]; /* First selected element in memory */
+    hsize_t  mem_end[H5S_MAX_RANK];   /* Last selected element in memory */
+    uint8_t *buf;                     /* First byte of the selection in the application buffer */
+    hsize_t  smine_start;             /* Strip mine start loc */
+    size_t   smine_nelmts;            /* Elements per strip */
+    size_t   n;                       /* Elements read */
+    int      ndims;                   /* Rank of memory dataspace */
+    htri_t   is_contig;               /* Whether the memory selection is contiguous */
+    htri_t   ret_value = FALSE;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check for conversions that can't run in place in the application buffer */
+    if (type_info->dst_type_size < type_info->src_type_size || H5T_BKG_NO != type_info->need_bkg ||
+        (type_info->cmpd_subset && H5T_SUBSET_FALSE != type_info->cmpd_subset->subset))
+        HGOTO_DONE(FALSE)
+
+    /* Check for a single contiguous run in memory */
+    if ((is_contig = H5S_SELECT_IS_CONTIGUOUS(mem_space)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check memory selection contiguity")
+    if (!is_contig)
+        HGOTO_DONE(FALSE)
+
+    /* Locate the start of the run in the application buffer */
+    if ((ndims = H5S_get_simple_extent_dims(mem_space, mem_dims, NULL)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't retrieve memory dataspace dimensions")
+    buf = (uint8_t *)io_info->u.rbuf;
+    if (ndims > 0) {
+        if (H5S_SELECT_BOUNDS(mem_space, mem_start, mem_end) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get memory selection bounds")
+        buf += H5VM_array_offset((unsigned)ndims, mem_dims, mem_start) * type_info->dst_type_size;
+    } /* end if */
+
+    /* Read and convert a strip at a time, so each strip is still in cache when converted */
+    for (smine_start = 0; smine_start < nelmts; smine_start += smine_nelmts) {
+        uint8_t *strip; /* Start of the strip's destination elements */
+
+        smine_nelmts = (size_t)MIN(type_info->request_nelmts, (nelmts - smine_start));
+        strip        = buf + smine_start * type_info->dst_type_size;
+
+        /* Read the strip's file data into the start of its destination elements */
+        n = H5D__gather_file(io_info, file_iter, smine_nelmts, strip /*out*/);
+        if (n != smine_nelmts)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file gather failed")
+
+        /* Convert it in place */
+        if (H5T_convert(type_info->tpath, type_info->src_type_id, type_info->dst_type_id, smine_nelmts,
+                        (size_t)0, (size_t)0, strip, NULL) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
+
+        /* Do the data transform after the conversion (since we're using type mem_type) */
+        if (!type_info->is_xform_noop) {
+            H5Z_data_xform_t *data_transform; /* Data transform info */
+
+            /* Retrieve info from API context */
+            if (H5CX_get_data_transform(&data_transform) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get data transform info")
+
+            if (H5Z_xform_eval(data_transform, strip, smine_nelmts, type_info->mem_type) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "Error performing data transform")
+        } /* end if */
+    }     /* end for */
+
+    ret_value = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__scatgath_read_direct() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5D__scatgath_read
  *
@@ -448,6 +527,7 @@ H5D__scatgath_read(const H5D_io_info_t *io_info, const H5D_type_info_t *type_inf
     hbool_t         file_iter_init = FALSE; /* File selection iteration info has been initialized */
     hsize_t         smine_start;            /* Strip mine start loc	*/
     size_t          smine_nelmts;           /* Elements per strip	*/
+    htri_t          direct;                 /* Whether the data was converted in the application buffer */
     herr_t          ret_value = SUCCEED;    /* Return value		*/
 
     FUNC_ENTER_PACKAGE
@@ -476,6 +556,13 @@ H5D__scatgath_read(const H5D_io_info_t *io_info, const H5D_type_info_t *type_inf
                              H5S_SEL_ITER_GET_SEQ_LIST_SORTED) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize file selection information")
     file_iter_init = TRUE; /*file selection iteration info has been initialized */
+
+    /* Try reading and converting in place in the application buffer */
+    if ((direct = H5D__scatgath_read_direct(io_info, type_info, nelmts, file_iter, mem_space)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "direct read into application buffer failed")
+    if (direct)
+        HGOTO_DONE(SUCCEED)
+
     if (H5S_select_iter_init(mem_iter, mem_space, type_info->dst_type_size, 0) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize memory selection information")
     mem_iter_init = TRUE; /*file selection iteration info has been initialized */
@@ -747,7 +834,6 @@ H5D__compound_opt_read(size_t nelmts, H5S_sel_iter_t *iter, const H5D_type_info_
     hsize_t *off = NULL;                 /* Pointer to sequence offsets */
     size_t * len = NULL;                 /* Pointer to sequence lengths */
     size_t   src_stride, dst_stride, copy_size;
-    size_t   dxpl_vec_size;       /* Vector length from API context's DXPL */
     size_t   vec_size;            /* Vector length */
     herr_t   ret_value = SUCCEED; /* Return value		*/
 
@@ -762,15 +848,11 @@ H5D__compound_opt_read(size_t nelmts, H5S_sel_iter_t *iter, const H5D_type_info_
              H5T_SUBSET_DST == type_info->cmpd_subset->subset);
     HDassert(user_buf);
 
-    /* Get info from API context */
-    if (H5CX_get_vec_size(&dxpl_vec_size) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't retrieve I/O vector size")
+    /* Get the number of sequences to retrieve per pass */
+    if (H5D__select_vec_size(NULL, nelmts, &vec_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't compute I/O vector size")
 
     /* Allocate the vector I/O arrays */
-    if (dxpl_vec_size > H5D_IO_VECTOR_SIZE)
-        vec_size = dxpl_vec_size;
-    else
-        vec_size = H5D_IO_VECTOR_SIZE;
     if (NULL == (len = H5FL_SEQ_MALLOC(size_t, vec_size)))
         HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O length vector array")
     if (NULL == (off = H5FL_SEQ_MALLOC(hsize_t, vec_size)))
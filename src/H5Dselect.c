@@ -64,6 +64,138 @@ H5FL_SEQ_DEFINE(hsize_t);
 /* Declare extern free list to manage the H5S_sel_iter_t struct */
 H5FL_EXTERN(H5S_sel_iter_t);
 
+/*-------------------------------------------------------------------------
+ * Function:	H5D__select_vec_size
+ *
+ * Purpose:	Choose how many sequences to retrieve from a selection
+ *		iterator in each pass.
+ *
+ *		The vector starts at the larger of the DXPL's hyperslab
+ *		vector size and H5D_IO_VECTOR_SIZE.  Selections that can
+ *		produce more sequences than that (at most one per element)
+ *		get a vector large enough to cover them in one pass, bounded
+ *		by H5D_IO_VECTOR_MAX_MEM bytes of offset & length arrays.
+ *		Contiguous selections always produce a single sequence and
+ *		keep the base size.  SPACE may be NULL when the caller only
+ *		has an iterator, in which case only NELMTS is considered.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__select_vec_size(const H5S_t *space, size_t nelmts, size_t *vec_size)
+{
+    size_t dxpl_vec_size;       /* Vector length from API context's DXPL */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(vec_size);
+
+    /* Get info from API context */
+    if (H5CX_get_vec_size(&dxpl_vec_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't retrieve I/O vector size")
+
+    /* Start from the base vector size */
+    *vec_size = MAX(dxpl_vec_size, H5D_IO_VECTOR_SIZE);
+
+    /* Grow the vector for selections with many potential sequences */
+    if (nelmts > *vec_size) {
+        htri_t is_contig = FALSE; /* Whether the selection is contiguous */
+
+        if (space && (is_contig = H5S_select_is_contiguous(space)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check if selection is contiguous")
+        if (!is_contig) {
+            size_t max_vec_size; /* Largest vector that fits in the memory bound */
+
+            /* Each sequence needs an offset & length in both memory and the file */
+            max_vec_size = H5D_IO_VECTOR_MAX_MEM / (2 * (sizeof(hsize_t) + sizeof(size_t)));
+            *vec_size    = MAX(*vec_size, MIN(nelmts, max_vec_size));
+        } /* end if */
+    }     /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__select_vec_size() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_vec_reserve
+ *
+ * Purpose:	Make sure the sequence list arrays in VEC can hold at least
+ *		NSEQ sequences, reallocating them if they are too small.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__io_vec_reserve(H5D_io_vec_t *vec, size_t nseq)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(vec);
+    HDassert(nseq > 0);
+
+    /* Check if the current arrays are large enough */
+    if (vec->nalloc < nseq) {
+        /* Release the old arrays */
+        if (H5D__io_vec_release(vec) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to release I/O vector arrays")
+
+        /* Allocate new arrays */
+        if (NULL == (vec->mem_len = H5FL_SEQ_MALLOC(size_t, nseq)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O length vector array")
+        if (NULL == (vec->mem_off = H5FL_SEQ_MALLOC(hsize_t, nseq)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O offset vector array")
+        if (NULL == (vec->file_len = H5FL_SEQ_MALLOC(size_t, nseq)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O length vector array")
+        if (NULL == (vec->file_off = H5FL_SEQ_MALLOC(hsize_t, nseq)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O offset vector array")
+        vec->nalloc = nseq;
+    } /* end if */
+
+done:
+    if (ret_value < 0)
+        H5D__io_vec_release(vec);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__io_vec_reserve() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__io_vec_release
+ *
+ * Purpose:	Release the sequence list arrays in VEC.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__io_vec_release(H5D_io_vec_t *vec)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Check args */
+    HDassert(vec);
+
+    if (vec->file_len)
+        vec->file_len = H5FL_SEQ_FREE(size_t, vec->file_len);
+    if (vec->file_off)
+        vec->file_off = H5FL_SEQ_FREE(hsize_t, vec->file_off);
+    if (vec->mem_len)
+        vec->mem_len = H5FL_SEQ_FREE(size_t, vec->mem_len);
+    if (vec->mem_off)
+        vec->mem_off = H5FL_SEQ_FREE(hsize_t, vec->mem_off);
+    vec->nalloc = 0;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__io_vec_release() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5D__select_io
  *
@@ -84,15 +216,16 @@ H5D__select_io(const H5D_io_info_t *io_info, size_t elmt_size, size_t nelmts, co
     hbool_t         mem_iter_init  = FALSE; /* Memory selection iteration info has been initialized */
     H5S_sel_iter_t *file_iter      = NULL;  /* File selection iteration info */
     hbool_t         file_iter_init = FALSE; /* File selection iteration info has been initialized */
-    hsize_t *       mem_off        = NULL;  /* Pointer to sequence offsets in memory */
-    hsize_t *       file_off       = NULL;  /* Pointer to sequence offsets in the file */
-    size_t *        mem_len        = NULL;  /* Pointer to sequence lengths in memory */
-    size_t *        file_len       = NULL;  /* Pointer to sequence lengths in the file */
+    H5D_io_vec_t    local_vec;              /* Sequence list arrays, when not cached in the I/O info */
+    H5D_io_vec_t *  vec;                    /* Sequence list arrays in use */
+    hsize_t *       mem_off;                /* Pointer to sequence offsets in memory */
+    hsize_t *       file_off;               /* Pointer to sequence offsets in the file */
+    size_t *        mem_len;                /* Pointer to sequence lengths in memory */
+    size_t *        file_len;               /* Pointer to sequence lengths in the file */
     size_t          curr_mem_seq;           /* Current memory sequence to operate on */
     size_t          curr_file_seq;          /* Current file sequence to operate on */
     size_t          mem_nseq;               /* Number of sequences generated in the file */
     size_t          file_nseq;              /* Number of sequences generated in memory */
-    size_t          dxpl_vec_size;          /* Vector length from API context's DXPL */
     size_t          vec_size;               /* Vector length */
     ssize_t         tmp_file_len;           /* Temporary number of bytes in file sequence */
     herr_t          ret_value = SUCCEED;    /* Return value */
@@ -105,6 +238,10 @@ H5D__select_io(const H5D_io_info_t *io_info, size_t elmt_size, size_t nelmts, co
     HDassert(io_info->store);
     HDassert(io_info->u.rbuf);
 
+    /* Use the I/O operation's cached sequence list arrays, if it has them */
+    HDmemset(&local_vec, 0, sizeof(local_vec));
+    vec = io_info->vec ? io_info->vec : &local_vec;
+
     /* Check for only one element in selection */
     if (nelmts == 1) {
         hsize_t single_mem_off;  /* Offset in memory */
@@ -147,23 +284,19 @@ H5D__select_io(const H5D_io_info_t *io_info, size_t elmt_size, size_t nelmts, co
         size_t mem_nelem;  /* Number of elements used in memory sequences */
         size_t file_nelem; /* Number of elements used in file sequences */
 
-        /* Get info from API context */
-        if (H5CX_get_vec_size(&dxpl_vec_size) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't retrieve I/O vector size")
+        /* Size the sequence lists from the file selection (the memory
+         * selection is consumed in step with it)
+         */
+        if (H5D__select_vec_size(file_space, nelmts, &vec_size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't compute I/O vector size")
 
-        /* Allocate the vector I/O arrays */
-        if (dxpl_vec_size > H5D_IO_VECTOR_SIZE)
-            vec_size = dxpl_vec_size;
-        else
-            vec_size = H5D_IO_VECTOR_SIZE;
-        if (NULL == (mem_len = H5FL_SEQ_MALLOC(size_t, vec_size)))
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O length vector array")
-        if (NULL == (mem_off = H5FL_SEQ_MALLOC(hsize_t, vec_size)))
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O offset vector array")
-        if (NULL == (file_len = H5FL_SEQ_MALLOC(size_t, vec_size)))
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O length vector array")
-        if (NULL == (file_off = H5FL_SEQ_MALLOC(hsize_t, vec_size)))
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O offset vector array")
+        /* Allocate (or reuse) the vector I/O arrays */
+        if (H5D__io_vec_reserve(vec, vec_size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate I/O vector arrays")
+        mem_off  = vec->mem_off;
+        mem_len  = vec->mem_len;
+        file_off = vec->file_off;
+        file_len = vec->file_len;
 
         /* Allocate the iterators */
         if (NULL == (mem_iter = H5FL_MALLOC(H5S_sel_iter_t)))
@@ -243,15 +376,9 @@ done:
     if (mem_iter)
         mem_iter = H5FL_FREE(H5S_sel_iter_t, mem_iter);
 
-    /* Release vector arrays, if allocated */
-    if (file_len)
-        file_len = H5FL_SEQ_FREE(size_t, file_len);
-    if (file_off)
-        file_off = H5FL_SEQ_FREE(hsize_t, file_off);
-    if (mem_len)
-        mem_len = H5FL_SEQ_FREE(size_t, mem_len);
-    if (mem_off)
-        mem_off = H5FL_SEQ_FREE(hsize_t, mem_off);
+    /* Release vector arrays, if they aren't cached for the I/O operation */
+    if (H5D__io_vec_release(&local_vec) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to release I/O vector arrays")
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__select_io() */
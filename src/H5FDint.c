@@ -243,6 +243,161 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_write() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_read_vector
+ *
+ * Purpose:     Private version of H5FDread() for a vector of COUNT
+ *              (address, size, buffer) triples, which are read with the
+ *              driver's 'read_vector' callback, or one at a time with its
+ *              'read' callback if the driver has no vector support.
+ *
+ *              The addresses are relative to the file's base address and
+ *              are adjusted by it in place.
+ *
+ * Return:      Success:    SUCCEED
+ *                          The read results are written into the buffers.
+ *              Failure:    FAIL
+ *                          The contents of the buffers are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_read_vector(H5FD_t *file, H5FD_mem_t type, size_t count, haddr_t addrs[], const size_t sizes[],
+                 void *bufs[] /*out*/)
+{
+    hid_t  dxpl_id   = H5I_INVALID_HID; /* DXPL for operation */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(file);
+    HDassert(file->cls);
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    /* Get proper DXPL for I/O */
+    dxpl_id = H5CX_get_dxpl();
+
+    /* Check the requests against the 'eoa', unless the file is open for SWMR
+     * read access (see H5FD_read)
+     */
+    if (!(file->access_flags & H5F_ACC_SWMR_READ)) {
+        haddr_t eoa;
+
+        if (HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, type)))
+            HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+
+        for (u = 0; u < count; u++)
+            if ((addrs[u] + file->base_addr + sizes[u]) > eoa)
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL,
+                            "addr overflow, addr = %llu, size = %llu, eoa = %llu",
+                            (unsigned long long)(addrs[u] + file->base_addr), (unsigned long long)sizes[u],
+                            (unsigned long long)eoa)
+    } /* end if */
+
+    /* Adjust the addresses by the file's base address */
+    if (file->base_addr > 0)
+        for (u = 0; u < count; u++)
+            addrs[u] += file->base_addr;
+
+    /* Dispatch to driver */
+    if (file->cls->read_vector) {
+        if ((file->cls->read_vector)(file, type, dxpl_id, count, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver read vector request failed")
+    } /* end if */
+    else
+        for (u = 0; u < count; u++)
+            if ((file->cls->read)(file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver read request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_read_vector() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_write_vector
+ *
+ * Purpose:     Private version of H5FDwrite() for a vector of COUNT
+ *              (address, size, buffer) triples, which are written with the
+ *              driver's 'write_vector' callback, or one at a time with its
+ *              'write' callback if the driver has no vector support.
+ *
+ *              The addresses are relative to the file's base address and
+ *              are adjusted by it in place.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_write_vector(H5FD_t *file, H5FD_mem_t type, size_t count, haddr_t addrs[], const size_t sizes[],
+                  const void *bufs[])
+{
+    hid_t   dxpl_id;                 /* DXPL for operation */
+    haddr_t eoa       = HADDR_UNDEF; /* EOA for file */
+    size_t  u;                       /* Local index variable */
+    herr_t  ret_value = SUCCEED;     /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(file);
+    HDassert(file->cls);
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    /* Get proper DXPL for I/O */
+    dxpl_id = H5CX_get_dxpl();
+
+    /* Check the requests against the 'eoa' */
+    if (HADDR_UNDEF == (eoa = (file->cls->get_eoa)(file, type)))
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "driver get_eoa request failed")
+    for (u = 0; u < count; u++)
+        if ((addrs[u] + file->base_addr + sizes[u]) > eoa)
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size=%llu, eoa=%llu",
+                        (unsigned long long)(addrs[u] + file->base_addr), (unsigned long long)sizes[u],
+                        (unsigned long long)eoa)
+
+    /* Adjust the addresses by the file's base address */
+    if (file->base_addr > 0)
+        for (u = 0; u < count; u++)
+            addrs[u] += file->base_addr;
+
+    /* Dispatch to driver */
+    if (file->cls->write_vector) {
+        if ((file->cls->write_vector)(file, type, dxpl_id, count, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver write vector request failed")
+    } /* end if */
+    else
+        for (u = 0; u < count; u++)
+            if ((file->cls->write)(file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_WRITEERROR, FAIL, "driver write request failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_write_vector() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_has_vector_io
+ *
+ * Purpose:     Check whether the file's driver implements the vector
+ *              read & write callbacks.
+ *
+ * Return:      TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5FD_has_vector_io(const H5FD_t *file)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(file);
+    HDassert(file->cls);
+
+    FUNC_LEAVE_NOAPI(file->cls->read_vector != NULL && file->cls->write_vector != NULL)
+} /* end H5FD_has_vector_io() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5FD_set_eoa
  *
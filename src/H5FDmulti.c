@@ -164,6 +164,8 @@ static const H5FD_class_t H5FD_multi_g = {
     H5FD_multi_get_handle,     /*get_handle            */
     H5FD_multi_read,           /*read            */
     H5FD_multi_write,          /*write            */
+    NULL,                      /*read_vector      */
+    NULL,                      /*write_vector     */
     H5FD_multi_flush,          /*flush            */
     H5FD_multi_truncate,       /*truncate        */
     H5FD_multi_lock,           /*lock                  */
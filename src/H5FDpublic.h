@@ -295,6 +295,10 @@ typedef struct H5FD_class_t {
     herr_t (*get_handle)(H5FD_t *file, hid_t fapl, void **file_handle);
     herr_t (*read)(H5FD_t *file, H5FD_mem_t type, hid_t dxpl, haddr_t addr, size_t size, void *buffer);
     herr_t (*write)(H5FD_t *file, H5FD_mem_t type, hid_t dxpl, haddr_t addr, size_t size, const void *buffer);
+    herr_t (*read_vector)(H5FD_t *file, H5FD_mem_t type, hid_t dxpl, size_t count, const haddr_t addrs[],
+                          const size_t sizes[], void *bufs[]);
+    herr_t (*write_vector)(H5FD_t *file, H5FD_mem_t type, hid_t dxpl, size_t count, const haddr_t addrs[],
+                           const size_t sizes[], const void *bufs[]);
     herr_t (*flush)(H5FD_t *file, hid_t dxpl_id, hbool_t closing);
     herr_t (*truncate)(H5FD_t *file, hid_t dxpl_id, hbool_t closing);
     herr_t (*lock)(H5FD_t *file, hbool_t rw);
@@ -121,6 +121,9 @@ typedef struct H5FD_sec2_t {
 #define REGION_OVERFLOW(A, Z)                                                                                \
     (ADDR_OVERFLOW(A) || SIZE_OVERFLOW(Z) || HADDR_UNDEF == (A) + (Z) || (HDoff_t)((A) + (Z)) < (HDoff_t)(A))
 
+/* Maximum number of adjacent requests combined into one preadv/pwritev call */
+#define H5FD_SEC2_MAX_IOV 256
+
 /* Prototypes */
 static herr_t  H5FD__sec2_term(void);
 static H5FD_t *H5FD__sec2_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr);
@@ -135,43 +138,54 @@ static herr_t  H5FD__sec2_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, ha
                                void *buf);
 static herr_t  H5FD__sec2_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr, size_t size,
                                 const void *buf);
+static herr_t  H5FD__sec2_read_vector(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, size_t count,
+                                       const haddr_t addrs[], const size_t sizes[], void *bufs[]);
+static herr_t  H5FD__sec2_write_vector(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, size_t count,
+                                        const haddr_t addrs[], const size_t sizes[], const void *bufs[]);
+#ifdef H5_HAVE_PREADWRITEV
+static size_t H5FD__sec2_count_adjacent(size_t count, const haddr_t addrs[], const size_t sizes[]);
+static herr_t H5FD__sec2_iov_io(H5FD_sec2_t *file, hbool_t do_write, haddr_t addr, size_t iovcnt,
+                                const size_t sizes[], void *const bufs[]);
+#endif /* H5_HAVE_PREADWRITEV */
 static herr_t  H5FD__sec2_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static herr_t  H5FD__sec2_lock(H5FD_t *_file, hbool_t rw);
 static herr_t  H5FD__sec2_unlock(H5FD_t *_file);
 
 static const H5FD_class_t H5FD_sec2_g = {
-    "sec2",                /* name                 */
-    MAXADDR,               /* maxaddr              */
-    H5F_CLOSE_WEAK,        /* fc_degree            */
-    H5FD__sec2_term,       /* terminate            */
-    NULL,                  /* sb_size              */
-    NULL,                  /* sb_encode            */
-    NULL,                  /* sb_decode            */
-    0,                     /* fapl_size            */
-    NULL,                  /* fapl_get             */
-    NULL,                  /* fapl_copy            */
-    NULL,                  /* fapl_free            */
-    0,                     /* dxpl_size            */
-    NULL,                  /* dxpl_copy            */
-    NULL,                  /* dxpl_free            */
-    H5FD__sec2_open,       /* open                 */
-    H5FD__sec2_close,      /* close                */
-    H5FD__sec2_cmp,        /* cmp                  */
-    H5FD__sec2_query,      /* query                */
-    NULL,                  /* get_type_map         */
-    NULL,                  /* alloc                */
-    NULL,                  /* free                 */
-    H5FD__sec2_get_eoa,    /* get_eoa              */
-    H5FD__sec2_set_eoa,    /* set_eoa              */
-    H5FD__sec2_get_eof,    /* get_eof              */
-    H5FD__sec2_get_handle, /* get_handle           */
-    H5FD__sec2_read,       /* read                 */
-    H5FD__sec2_write,      /* write                */
-    NULL,                  /* flush                */
-    H5FD__sec2_truncate,   /* truncate             */
-    H5FD__sec2_lock,       /* lock                 */
-    H5FD__sec2_unlock,     /* unlock               */
-    H5FD_FLMAP_DICHOTOMY   /* fl_map               */
+    "sec2",                  /* name                 */
+    MAXADDR,                 /* maxaddr              */
+    H5F_CLOSE_WEAK,          /* fc_degree            */
+    H5FD__sec2_term,         /* terminate            */
+    NULL,                    /* sb_size              */
+    NULL,                    /* sb_encode            */
+    NULL,                    /* sb_decode            */
+    0,                       /* fapl_size            */
+    NULL,                    /* fapl_get             */
+    NULL,                    /* fapl_copy            */
+    NULL,                    /* fapl_free            */
+    0,                       /* dxpl_size            */
+    NULL,                    /* dxpl_copy            */
+    NULL,                    /* dxpl_free            */
+    H5FD__sec2_open,         /* open                 */
+    H5FD__sec2_close,        /* close                */
+    H5FD__sec2_cmp,          /* cmp                  */
+    H5FD__sec2_query,        /* query                */
+    NULL,                    /* get_type_map         */
+    NULL,                    /* alloc                */
+    NULL,                    /* free                 */
+    H5FD__sec2_get_eoa,      /* get_eoa              */
+    H5FD__sec2_set_eoa,      /* set_eoa              */
+    H5FD__sec2_get_eof,      /* get_eof              */
+    H5FD__sec2_get_handle,   /* get_handle           */
+    H5FD__sec2_read,         /* read                 */
+    H5FD__sec2_write,        /* write                */
+    H5FD__sec2_read_vector,  /* read_vector          */
+    H5FD__sec2_write_vector, /* write_vector         */
+    NULL,                    /* flush                */
+    H5FD__sec2_truncate,     /* truncate             */
+    H5FD__sec2_lock,         /* lock                 */
+    H5FD__sec2_unlock,       /* unlock               */
+    H5FD_FLMAP_DICHOTOMY     /* fl_map               */
 };
 
 /* Declare a free list to manage the H5FD_sec2_t struct */
@@ -894,6 +908,244 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD__sec2_write() */
 
+#ifdef H5_HAVE_PREADWRITEV
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__sec2_count_adjacent
+ *
+ * Purpose:     Count how many of the first COUNT requests are adjacent in
+ *              the file, so they can be combined into one preadv/pwritev
+ *              call (at most H5FD_SEC2_MAX_IOV of them).
+ *
+ * Return:      Number of adjacent requests (at least 1)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5FD__sec2_count_adjacent(size_t count, const haddr_t addrs[], const size_t sizes[])
+{
+    haddr_t end;           /* End of the run of requests so far */
+    size_t  nadj      = 1; /* Number of adjacent requests */
+    size_t  ret_value = 0; /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(count > 0);
+
+    end = addrs[0] + sizes[0];
+    while (nadj < count && nadj < H5FD_SEC2_MAX_IOV && addrs[nadj] == end) {
+        end += sizes[nadj];
+        nadj++;
+    } /* end while */
+
+    ret_value = nadj;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__sec2_count_adjacent() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__sec2_iov_io
+ *
+ * Purpose:     Reads or writes IOVCNT requests that are adjacent in the
+ *              file, starting at ADDR, with a single preadv/pwritev call
+ *              (repeated only for interrupted system calls and partial
+ *              transfers).  Reads past the end of the file are zero-filled,
+ *              like H5FD__sec2_read().
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__sec2_iov_io(H5FD_sec2_t *file, hbool_t do_write, haddr_t addr, size_t iovcnt, const size_t sizes[],
+                  void *const bufs[])
+{
+    struct iovec iov[H5FD_SEC2_MAX_IOV]; /* I/O vector for system call */
+    HDoff_t      offset = (HDoff_t)addr; /* File offset of next transfer */
+    hsize_t      total  = 0;             /* Total bytes in request */
+    size_t       first  = 0;             /* First I/O vector element not yet transferred */
+    size_t       u;                      /* Local index variable */
+    herr_t       ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(file);
+    HDassert(iovcnt > 0 && iovcnt <= H5FD_SEC2_MAX_IOV);
+
+    /* Set up the I/O vector */
+    for (u = 0; u < iovcnt; u++) {
+        iov[u].iov_base = bufs[u];
+        iov[u].iov_len  = sizes[u];
+        total += sizes[u];
+    } /* end for */
+
+    /* Check for overflow conditions */
+    if (REGION_OVERFLOW(addr, total))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu", (unsigned long long)addr)
+
+    /* Transfer the data, being careful of interrupted system calls, partial
+     * results, and the end of the file.
+     */
+    while (first < iovcnt) {
+        ssize_t nbytes = -1; /* # of bytes actually transferred */
+
+        do {
+            if (do_write)
+                nbytes = HDpwritev(file->fd, &iov[first], (int)(iovcnt - first), offset);
+            else
+                nbytes = HDpreadv(file->fd, &iov[first], (int)(iovcnt - first), offset);
+        } while (-1 == nbytes && EINTR == errno);
+
+        if (-1 == nbytes) { /* error */
+            int myerrno = errno;
+
+            if (do_write)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL,
+                            "file vector write failed: filename = '%s', file descriptor = %d, errno = %d, "
+                            "error message = '%s', offset = %llu",
+                            file->filename, file->fd, myerrno, HDstrerror(myerrno),
+                            (unsigned long long)offset)
+            else
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL,
+                            "file vector read failed: filename = '%s', file descriptor = %d, errno = %d, "
+                            "error message = '%s', offset = %llu",
+                            file->filename, file->fd, myerrno, HDstrerror(myerrno),
+                            (unsigned long long)offset)
+        } /* end if */
+
+        if (0 == nbytes) {
+            /* end of file but not end of format address space */
+            HDassert(!do_write);
+            for (; first < iovcnt; first++)
+                HDmemset(iov[first].iov_base, 0, iov[first].iov_len);
+            break;
+        } /* end if */
+
+        /* Advance past the data transferred */
+        offset += nbytes;
+        while (nbytes > 0) {
+            if ((size_t)nbytes >= iov[first].iov_len) {
+                nbytes -= (ssize_t)iov[first].iov_len;
+                first++;
+            } /* end if */
+            else {
+                iov[first].iov_base = (char *)iov[first].iov_base + nbytes;
+                iov[first].iov_len -= (size_t)nbytes;
+                nbytes = 0;
+            } /* end else */
+        }     /* end while */
+    }         /* end while */
+
+    /* Update current position and eof */
+    file->pos = addr + total;
+    file->op  = do_write ? OP_WRITE : OP_READ;
+    if (do_write && file->pos > file->eof)
+        file->eof = file->pos;
+
+done:
+    if (ret_value < 0) {
+        /* Reset last file I/O information */
+        file->pos = HADDR_UNDEF;
+        file->op  = OP_UNKNOWN;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__sec2_iov_io() */
+#endif /* H5_HAVE_PREADWRITEV */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__sec2_read_vector
+ *
+ * Purpose:     Reads COUNT (address, size, buffer) requests from the file.
+ *              Requests that are adjacent in the file are combined into a
+ *              single preadv() call when it is available; the others are
+ *              read individually with H5FD__sec2_read().
+ *
+ * Return:      Success:    SUCCEED. Results are stored in the buffers.
+ *              Failure:    FAIL. Contents of the buffers are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__sec2_read_vector(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, size_t count, const haddr_t addrs[],
+                       const size_t sizes[], void *bufs[])
+{
+    size_t u         = 0;       /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(_file && _file->cls);
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    while (u < count) {
+#ifdef H5_HAVE_PREADWRITEV
+        size_t nadj = H5FD__sec2_count_adjacent(count - u, &addrs[u], &sizes[u]);
+
+        if (nadj > 1) {
+            if (H5FD__sec2_iov_io((H5FD_sec2_t *)_file, FALSE, addrs[u], nadj, &sizes[u], &bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "vector read failed")
+            u += nadj;
+            continue;
+        } /* end if */
+#endif /* H5_HAVE_PREADWRITEV */
+
+        if (H5FD__sec2_read(_file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "read failed")
+        u++;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__sec2_read_vector() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__sec2_write_vector
+ *
+ * Purpose:     Writes COUNT (address, size, buffer) requests to the file.
+ *              Requests that are adjacent in the file are combined into a
+ *              single pwritev() call when it is available; the others are
+ *              written individually with H5FD__sec2_write().
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__sec2_write_vector(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id, size_t count, const haddr_t addrs[],
+                        const size_t sizes[], const void *bufs[])
+{
+    size_t u         = 0;       /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(_file && _file->cls);
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    while (u < count) {
+#ifdef H5_HAVE_PREADWRITEV
+        size_t nadj = H5FD__sec2_count_adjacent(count - u, &addrs[u], &sizes[u]);
+
+        if (nadj > 1) {
+            H5_GCC_DIAG_OFF("cast-qual")
+            if (H5FD__sec2_iov_io((H5FD_sec2_t *)_file, TRUE, addrs[u], nadj, &sizes[u],
+                                  (void *const *)&bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "vector write failed")
+            H5_GCC_DIAG_ON("cast-qual")
+            u += nadj;
+            continue;
+        } /* end if */
+#endif /* H5_HAVE_PREADWRITEV */
+
+        if (H5FD__sec2_write(_file, type, dxpl_id, addrs[u], sizes[u], bufs[u]) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "write failed")
+        u++;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__sec2_write_vector() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5FD__sec2_truncate
  *
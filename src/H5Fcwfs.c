@@ -15,18 +15,23 @@
  * Programmer:  Quincey Koziol
  *              Tuesday, July 19, 2011
  *
- * Purpose:	Each file has a small cache of global heap collections called
- *		the CWFS list and recently accessed collections with free
- *		space appear on this list.  As collections are accessed the
- *		collection is moved toward the front of the list.  New
- *		collections are added to the front of the list while old
- *		collections are added to the end of the list.
+ * Purpose:	Each file keeps an index of the global heap collections with
+ *		free space, the CWFS index.  Every collection the library
+ *		creates or loads is recorded by address along with the size of
+ *		its free space, and stays recorded while it is evicted from
+ *		the metadata cache, so a collection's free space can be
+ *		reused for as long as the file is open.  Collections are
+ *		bucketed into size classes by their free space (class C holds
+ *		collections with between 2^C and 2^(C+1)-1 free bytes), and
+ *		within each class the most recently used collections come
+ *		first.
  *
  *		The collection model reduces the overhead which would be
  *		incurred if the global heap were a single object, and the
- *		CWFS list allows the library to cheaply choose a collection
- *		for a new object based on object size, amount of free space
- *		in the collection, and temporal locality.
+ *		CWFS index allows the library to cheaply choose the
+ *		collection with the least free space that fits a new object,
+ *		packing objects densely and preferring collections with
+ *		temporal locality among equally good candidates.
  */
 
 /****************/
@@ -41,24 +46,44 @@
 #include "H5private.h"   /* Generic Functions			*/
 #include "H5Eprivate.h"  /* Error handling		  	*/
 #include "H5Fpkg.h"      /* File access				*/
+#include "H5FLprivate.h" /* Free Lists                           */
 #include "H5HGprivate.h" /* Global heaps				*/
 #include "H5MFprivate.h" /* File memory management		*/
 #include "H5MMprivate.h" /* Memory management			*/
+#include "H5SLprivate.h" /* Skip Lists                           */
+#include "H5VMprivate.h" /* Vectors and arrays                   */
 
 /****************/
 /* Local Macros */
 /****************/
 
 /*
- * Maximum length of the CWFS list, the list of remembered collections that
- * have free space.
+ * Number of size classes in the CWFS index.  The last class also holds any
+ * collection with more free space than a collection of the maximum size.
  */
-#define H5F_NCWFS 16
+#define H5F_CWFS_NCLASSES 17
 
 /******************/
 /* Local Typedefs */
 /******************/
 
+/* A global heap collection recorded in the CWFS index */
+typedef struct H5F_cwfs_ent_t {
+    haddr_t                addr; /* Address of collection */
+    size_t                 size; /* Total size of collection */
+    size_t                 free; /* Free space in collection */
+    unsigned               cls;  /* Size class of free space */
+    struct H5F_cwfs_ent_t *prev; /* Previous collection in size class */
+    struct H5F_cwfs_ent_t *next; /* Next collection in size class */
+} H5F_cwfs_ent_t;
+
+/* The CWFS index for a file */
+struct H5F_cwfs_t {
+    H5SL_t *        index;                   /* Collections, by address */
+    H5F_cwfs_ent_t *head[H5F_CWFS_NCLASSES]; /* Most recently used collection in each size class */
+    H5F_cwfs_ent_t *mru;                     /* Most recently used collection */
+};
+
 /********************/
 /* Package Typedefs */
 /********************/
@@ -66,6 +91,10 @@
 /********************/
 /* Local Prototypes */
 /********************/
+static unsigned H5F__cwfs_class(size_t free_size);
+static void     H5F__cwfs_unlink(H5F_cwfs_t *cwfs, H5F_cwfs_ent_t *ent);
+static void     H5F__cwfs_link(H5F_cwfs_t *cwfs, H5F_cwfs_ent_t *ent);
+static herr_t   H5F__cwfs_free_cb(void *item, void *key, void *op_data);
 
 /*********************/
 /* Package Variables */
@@ -79,10 +108,115 @@
 /* Local Variables */
 /*******************/
 
+/* Declare a free list to manage the H5F_cwfs_t struct */
+H5FL_DEFINE_STATIC(H5F_cwfs_t);
+
+/* Declare a free list to manage the H5F_cwfs_ent_t struct */
+H5FL_DEFINE_STATIC(H5F_cwfs_ent_t);
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__cwfs_class
+ *
+ * Purpose:	Compute the size class of a collection with FREE_SIZE bytes
+ *		of free space.
+ *
+ * Return:	The size class
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5F__cwfs_class(size_t free_size)
+{
+    unsigned cls = 0; /* Size class */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if (free_size > 0)
+        cls = MIN(H5VM_log2_gen((uint64_t)free_size), H5F_CWFS_NCLASSES - 1);
+
+    FUNC_LEAVE_NOAPI(cls)
+} /* H5F__cwfs_class() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__cwfs_unlink
+ *
+ * Purpose:	Remove a collection from its size class list.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5F__cwfs_unlink(H5F_cwfs_t *cwfs, H5F_cwfs_ent_t *ent)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    if (ent->prev)
+        ent->prev->next = ent->next;
+    else
+        cwfs->head[ent->cls] = ent->next;
+    if (ent->next)
+        ent->next->prev = ent->prev;
+    ent->prev = ent->next = NULL;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5F__cwfs_unlink() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__cwfs_link
+ *
+ * Purpose:	Add a collection to the front of the list for the size
+ *		class of its free space and make it the most recently used
+ *		collection.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5F__cwfs_link(H5F_cwfs_t *cwfs, H5F_cwfs_ent_t *ent)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    ent->cls  = H5F__cwfs_class(ent->free);
+    ent->prev = NULL;
+    ent->next = cwfs->head[ent->cls];
+    if (ent->next)
+        ent->next->prev = ent;
+    cwfs->head[ent->cls] = ent;
+    cwfs->mru            = ent;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5F__cwfs_link() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F__cwfs_free_cb
+ *
+ * Purpose:	Skip list callback to release a collection's entry when the
+ *		CWFS index is destroyed.
+ *
+ * Return:	Non-negative (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5F__cwfs_free_cb(void *item, void H5_ATTR_UNUSED *key, void H5_ATTR_UNUSED *op_data)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    H5FL_FREE(H5F_cwfs_ent_t, item);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* H5F__cwfs_free_cb() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5F_cwfs_add
  *
- * Purpose:	Add a global heap collection to the CWFS for a file.
+ * Purpose:	Record the free space of a global heap collection in the
+ *		CWFS index for a file, adding the collection if it isn't
+ *		already there, and make it the most recently used collection.
+ *		This must be called whenever a collection is created or
+ *		loaded and whenever its free space changes.
  *
  * Return:	Success:	Non-negative
  *		Failure:	Negative
@@ -95,7 +229,10 @@
 herr_t
 H5F_cwfs_add(H5F_t *f, H5HG_heap_t *heap)
 {
-    herr_t ret_value = SUCCEED; /* Return value */
+    H5F_cwfs_t *    cwfs;                /* CWFS index for file */
+    H5F_cwfs_ent_t *ent = NULL;          /* Collection's entry in index */
+    haddr_t         addr;                /* Address of collection */
+    herr_t          ret_value = SUCCEED; /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
 
@@ -104,32 +241,36 @@ H5F_cwfs_add(H5F_t *f, H5HG_heap_t *heap)
     HDassert(f->shared);
     HDassert(heap);
 
-    /*
-     * Add the new heap to the CWFS list, removing some other entry if
-     * necessary to make room. We remove the right-most entry that has less
-     * free space than this heap.
-     */
-    if (NULL == f->shared->cwfs) {
-        if (NULL == (f->shared->cwfs = (H5HG_heap_t **)H5MM_malloc(H5F_NCWFS * sizeof(H5HG_heap_t *))))
+    addr = H5HG_ADDR(heap);
+
+    /* Create the index, the first time a collection is added */
+    if (NULL == (cwfs = f->shared->cwfs)) {
+        if (NULL == (cwfs = H5FL_CALLOC(H5F_cwfs_t)))
             HGOTO_ERROR(H5E_FILE, H5E_CANTALLOC, FAIL, "can't allocate CWFS for file")
-        f->shared->cwfs[0] = heap;
-        f->shared->ncwfs   = 1;
-    }
-    else if (H5F_NCWFS == f->shared->ncwfs) {
-        int i; /* Local index variable */
-
-        for (i = H5F_NCWFS - 1; i >= 0; --i)
-            if (H5HG_FREE_SIZE(f->shared->cwfs[i]) < H5HG_FREE_SIZE(heap)) {
-                HDmemmove(f->shared->cwfs + 1, f->shared->cwfs, (size_t)i * sizeof(H5HG_heap_t *));
-                f->shared->cwfs[0] = heap;
-                break;
-            } /* end if */
-    }
+        if (NULL == (cwfs->index = H5SL_create(H5SL_TYPE_HADDR, NULL))) {
+            cwfs = H5FL_FREE(H5F_cwfs_t, cwfs);
+            HGOTO_ERROR(H5E_FILE, H5E_CANTCREATE, FAIL, "can't create CWFS index for file")
+        } /* end if */
+        f->shared->cwfs = cwfs;
+    } /* end if */
+
+    /* Look up the collection, adding it if it's new */
+    if (NULL != (ent = (H5F_cwfs_ent_t *)H5SL_search(cwfs->index, &addr)))
+        H5F__cwfs_unlink(cwfs, ent);
     else {
-        HDmemmove(f->shared->cwfs + 1, f->shared->cwfs, f->shared->ncwfs * sizeof(H5HG_heap_t *));
-        f->shared->cwfs[0] = heap;
-        f->shared->ncwfs += 1;
-    } /* end else */
+        if (NULL == (ent = H5FL_CALLOC(H5F_cwfs_ent_t)))
+            HGOTO_ERROR(H5E_FILE, H5E_CANTALLOC, FAIL, "can't allocate CWFS entry")
+        ent->addr = addr;
+        if (H5SL_insert(cwfs->index, ent, &ent->addr) < 0) {
+            ent = H5FL_FREE(H5F_cwfs_ent_t, ent);
+            HGOTO_ERROR(H5E_FILE, H5E_CANTINSERT, FAIL, "can't add collection to CWFS index")
+        } /* end if */
+    }     /* end else */
+
+    /* Record the collection's current size and free space */
+    ent->size = H5HG_SIZE(heap);
+    ent->free = H5HG_FREE_SIZE(heap);
+    H5F__cwfs_link(cwfs, ent);
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -139,7 +280,13 @@ done:
  * Function:	H5F_cwfs_find_free_heap
  *
  * Purpose:	Find a global heap collection with free space for storing
- *		a new object.
+ *		NEED bytes of new objects.  The collection chosen is the most
+ *		recently used one with enough space in the smallest size
+ *		class that has any, so large free spaces are kept for large
+ *		objects.  If no collection has enough space, the most
+ *		recently used collection is extended in the file if
+ *		possible.  If that isn't possible either, ADDR is left
+ *		unchanged.
  *
  * Return:	Success:	Non-negative
  *		Failure:	Negative
@@ -152,9 +299,10 @@ done:
 herr_t
 H5F_cwfs_find_free_heap(H5F_t *f, size_t need, haddr_t *addr)
 {
-    unsigned cwfsno;              /* Local index for iterating over collections */
-    hbool_t  found     = FALSE;   /* Flag to indicate a heap with enough space was found */
-    herr_t   ret_value = SUCCEED; /* Return value */
+    H5F_cwfs_t *    cwfs;                /* CWFS index for file */
+    H5F_cwfs_ent_t *ent       = NULL;    /* Collection chosen */
+    unsigned        cls;                 /* Local index for iterating over size classes */
+    herr_t          ret_value = SUCCEED; /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
 
@@ -163,80 +311,62 @@ H5F_cwfs_find_free_heap(H5F_t *f, size_t need, haddr_t *addr)
     HDassert(f->shared);
     HDassert(addr);
 
-    /* Note that we don't have metadata cache locks on the entries in
-     * f->shared->cwfs.
-     *
-     * In the current situation, this doesn't matter, as we are single
-     * threaded, and as best I can tell, entries are added to and deleted
-     * from f->shared->cwfs as they are added to and deleted from the
-     * metadata cache.
-     *
-     * To be proper, we should either lock each entry in f->shared->cwfs
-     * as we examine it, or lock the whole array.  However, at present
-     * I don't see the point as there will be significant overhead,
-     * and protecting and unprotecting all the collections in the global
-     * heap on a regular basis will skew the replacement policy.
-     *
-     *                                        JRM - 5/24/04
+    /* Check for no collections yet */
+    if (NULL == (cwfs = f->shared->cwfs))
+        HGOTO_DONE(SUCCEED)
+
+    /* Look for a fitting collection in the object's own size class, then
+     * take the most recently used collection of the next non-empty class,
+     * all of which fit.
      */
-    for (cwfsno = 0; cwfsno < f->shared->ncwfs; cwfsno++)
-        if (H5HG_FREE_SIZE(f->shared->cwfs[cwfsno]) >= need) {
-            *addr = H5HG_ADDR(f->shared->cwfs[cwfsno]);
-            found = TRUE;
+    cls = H5F__cwfs_class(need);
+    for (ent = cwfs->head[cls]; ent; ent = ent->next)
+        if (ent->free >= need)
             break;
-        } /* end if */
+    while (NULL == ent && ++cls < H5F_CWFS_NCLASSES)
+        ent = cwfs->head[cls];
 
     /*
-     * If we didn't find any collection with enough free space the check if
-     * we can extend any of the collections to make enough room.
+     * If we didn't find any collection with enough free space then check if
+     * we can extend the most recently used collection (usually the one at
+     * the end of the file) to make enough room.
      */
-    if (!found) {
-        size_t new_need;
-
-        for (cwfsno = 0; cwfsno < f->shared->ncwfs; cwfsno++) {
-            new_need = need;
-            new_need -= H5HG_FREE_SIZE(f->shared->cwfs[cwfsno]);
-            new_need = MAX(H5HG_SIZE(f->shared->cwfs[cwfsno]), new_need);
-
-            if ((H5HG_SIZE(f->shared->cwfs[cwfsno]) + new_need) <= H5HG_MAXSIZE) {
-                htri_t was_extended; /* Whether the heap was extended */
-
-                was_extended =
-                    H5MF_try_extend(f, H5FD_MEM_GHEAP, H5HG_ADDR(f->shared->cwfs[cwfsno]),
-                                    (hsize_t)H5HG_SIZE(f->shared->cwfs[cwfsno]), (hsize_t)new_need);
-                if (was_extended < 0)
-                    HGOTO_ERROR(H5E_HEAP, H5E_CANTEXTEND, FAIL, "error trying to extend heap")
-                else if (was_extended == TRUE) {
-                    if (H5HG_extend(f, H5HG_ADDR(f->shared->cwfs[cwfsno]), new_need) < 0)
-                        HGOTO_ERROR(H5E_HEAP, H5E_CANTRESIZE, FAIL, "unable to extend global heap collection")
-                    *addr = H5HG_ADDR(f->shared->cwfs[cwfsno]);
-                    found = TRUE;
-                    break;
-                } /* end if */
-            }     /* end if */
-        }         /* end for */
-    }             /* end if */
-
-    if (found) {
-        /* Move the collection forward in the CWFS list, if it's not
-         * already at the front
-         */
-        if (cwfsno > 0) {
-            H5HG_heap_t *tmp = f->shared->cwfs[cwfsno];
-
-            f->shared->cwfs[cwfsno]     = f->shared->cwfs[cwfsno - 1];
-            f->shared->cwfs[cwfsno - 1] = tmp;
-        } /* end if */
-    }     /* end if */
+    if (NULL == ent && cwfs->mru) {
+        H5F_cwfs_ent_t *mru = cwfs->mru; /* Most recently used collection */
+        size_t          new_need;        /* Amount to extend the collection by */
+
+        new_need = need - mru->free;
+        new_need = MAX(mru->size, new_need);
+
+        if ((mru->size + new_need) <= H5HG_MAXSIZE) {
+            htri_t was_extended; /* Whether the heap was extended */
+
+            was_extended =
+                H5MF_try_extend(f, H5FD_MEM_GHEAP, mru->addr, (hsize_t)mru->size, (hsize_t)new_need);
+            if (was_extended < 0)
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTEXTEND, FAIL, "error trying to extend heap")
+            else if (was_extended == TRUE) {
+                /* (Extending the collection updates its entry) */
+                if (H5HG_extend(f, mru->addr, new_need) < 0)
+                    HGOTO_ERROR(H5E_HEAP, H5E_CANTRESIZE, FAIL, "unable to extend global heap collection")
+                HDassert(mru->free >= need);
+                ent = mru;
+            } /* end if */
+        }     /* end if */
+    }         /* end if */
+
+    if (ent)
+        *addr = ent->addr;
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5F_cwfs_find_free_heap() */
 
 /*-------------------------------------------------------------------------
- * Function:	H5F_cwfs_advance_heap
+ * Function:	H5F_cwfs_remove_heap
  *
- * Purpose:	Advance a heap in the CWFS
+ * Purpose:	Remove the global heap collection at ADDR from the CWFS
+ *		index, when the collection is deleted from the file.
  *
  * Return:	Success:	Non-negative
  *		Failure:	Negative
@@ -247,69 +377,54 @@ done:
  *-------------------------------------------------------------------------
  */
 herr_t
-H5F_cwfs_advance_heap(H5F_t *f, H5HG_heap_t *heap, hbool_t add_heap)
+H5F_cwfs_remove_heap(H5F_shared_t *shared, haddr_t addr)
 {
-    unsigned u;                   /* Local index variable */
-    herr_t   ret_value = SUCCEED; /* Return value */
+    H5F_cwfs_ent_t *ent;                 /* Collection's entry in index */
+    herr_t          ret_value = SUCCEED; /* Return value */
 
-    FUNC_ENTER_NOAPI(FAIL)
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
 
     /* Check args */
-    HDassert(f);
-    HDassert(f->shared);
-    HDassert(heap);
-
-    for (u = 0; u < f->shared->ncwfs; u++)
-        if (f->shared->cwfs[u] == heap) {
-            if (u) {
-                f->shared->cwfs[u]     = f->shared->cwfs[u - 1];
-                f->shared->cwfs[u - 1] = heap;
-            } /* end if */
-            break;
-        } /* end if */
-    if (add_heap && u >= f->shared->ncwfs) {
-        f->shared->ncwfs                      = MIN(f->shared->ncwfs + 1, H5F_NCWFS);
-        f->shared->cwfs[f->shared->ncwfs - 1] = heap;
+    HDassert(shared);
+    HDassert(H5F_addr_defined(addr));
+
+    /* Remove the collection from the CWFS index */
+    if (shared->cwfs && NULL != (ent = (H5F_cwfs_ent_t *)H5SL_remove(shared->cwfs->index, &addr))) {
+        H5F__cwfs_unlink(shared->cwfs, ent);
+        if (shared->cwfs->mru == ent)
+            shared->cwfs->mru = NULL;
+        ent = H5FL_FREE(H5F_cwfs_ent_t, ent);
     } /* end if */
 
-done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* H5F_cwfs_advance_heap() */
+} /* H5F_cwfs_remove_heap() */
 
 /*-------------------------------------------------------------------------
- * Function:	H5F_cwfs_remove_heap
+ * Function:	H5F__cwfs_dest
  *
- * Purpose:	Remove a heap from the CWFS
+ * Purpose:	Destroy the CWFS index for a file.
  *
  * Return:	Success:	Non-negative
  *		Failure:	Negative
  *
- * Programmer:	Quincey Koziol
- *              Wednesday, July 20, 2011
- *
  *-------------------------------------------------------------------------
  */
 herr_t
-H5F_cwfs_remove_heap(H5F_shared_t *shared, H5HG_heap_t *heap)
+H5F__cwfs_dest(H5F_shared_t *shared)
 {
-    unsigned u;                   /* Local index variable */
-    herr_t   ret_value = SUCCEED; /* Return value */
+    herr_t ret_value = SUCCEED; /* Return value */
 
-    FUNC_ENTER_NOAPI(FAIL)
+    FUNC_ENTER_PACKAGE
 
     /* Check args */
     HDassert(shared);
-    HDassert(heap);
 
-    /* Remove the heap from the CWFS list */
-    for (u = 0; u < shared->ncwfs; u++) {
-        if (shared->cwfs[u] == heap) {
-            shared->ncwfs -= 1;
-            HDmemmove(shared->cwfs + u, shared->cwfs + u + 1, (shared->ncwfs - u) * sizeof(H5HG_heap_t *));
-            break;
-        } /* end if */
-    }     /* end for */
+    if (shared->cwfs) {
+        if (H5SL_destroy(shared->cwfs->index, H5F__cwfs_free_cb, NULL) < 0)
+            HGOTO_ERROR(H5E_FILE, H5E_CANTCLOSEOBJ, FAIL, "can't destroy CWFS index")
+        shared->cwfs = H5FL_FREE(H5F_cwfs_t, shared->cwfs);
+    } /* end if */
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* H5F_cwfs_remove_heap() */
+} /* H5F__cwfs_dest() */
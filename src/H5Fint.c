@@ -1190,6 +1190,8 @@ H5F__new(H5F_shared_t *shared, unsigned flags, hid_t fcpl_id, hid_t fapl_id, H5F
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get 'use mdc logging' flag")
         if (H5P_get(plist, H5F_ACS_START_MDC_LOG_ON_ACCESS_NAME, &(f->shared->start_mdc_log_on_access)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get 'start mdc log on access' flag")
+        if (H5P_get(plist, H5F_ACS_MDC_LOG_FORMAT_NAME, &(f->shared->mdc_log_format)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get mdc log format")
         if (H5P_get(plist, H5F_ACS_META_BLOCK_SIZE_NAME, &(f->shared->meta_aggr.alloc_size)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata cache size")
         f->shared->meta_aggr.feature_flag = H5FD_FEAT_AGGREGATE_METADATA;
@@ -1548,7 +1550,9 @@ H5F__dest(H5F_t *f, hbool_t flush)
         if (H5FO_dest(f) < 0)
             /* Push error, but keep going*/
             HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "problems closing file")
-        f->shared->cwfs = (struct H5HG_heap_t **)H5MM_xfree(f->shared->cwfs);
+        if (H5F__cwfs_dest(f->shared) < 0)
+            /* Push error, but keep going*/
+            HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "problems closing file")
         if (H5G_node_close(f) < 0)
             /* Push error, but keep going*/
             HDONE_ERROR(H5E_FILE, H5E_CANTRELEASE, FAIL, "problems closing file")
@@ -1748,6 +1752,8 @@ H5F_open(const char *name, unsigned flags, hid_t fcpl_id, hid_t fapl_id)
     hbool_t            set_flag               = FALSE; /*set the status_flags in the superblock */
     hbool_t            clear                  = FALSE; /*clear the status_flags         */
     hbool_t            evict_on_close;                 /* evict on close value from plist  */
+    unsigned           mdc_serialize_threads;          /* metadata cache serialize thread count */
+    char *             mdc_access_trace = NULL;        /* location of metadata cache access trace */
     hbool_t            use_file_locking = TRUE;        /* Using file locks? */
     hbool_t            ci_load          = FALSE;       /* whether MDC ci load requested */
     hbool_t            ci_write         = FALSE;       /* whether MDC CI write requested */
@@ -1946,6 +1952,13 @@ H5F_open(const char *name, unsigned flags, hid_t fcpl_id, hid_t fapl_id)
             HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "unable to create/open root group")
     } /* end if */
     else if (1 == shared->nrefs) {
+        /* Start recording the metadata loaded, if an access trace is kept */
+        if (H5P_peek(a_plist, H5F_ACS_MDC_ACCESS_TRACE_NAME, &mdc_access_trace) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata cache access trace location")
+        if (mdc_access_trace)
+            if (H5C_access_trace_set_up(file, mdc_access_trace) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "unable to set up metadata cache access trace")
+
         /* Read the superblock if it hasn't been read before. */
         if (H5F__super_read(file, a_plist, TRUE) < 0)
             HGOTO_ERROR(H5E_FILE, H5E_READERROR, NULL, "unable to read superblock")
@@ -1955,9 +1968,22 @@ H5F_open(const char *name, unsigned flags, hid_t fcpl_id, hid_t fapl_id)
             if (H5PB_create(shared, page_buf_size, page_buf_min_meta_perc, page_buf_min_raw_perc) < 0)
                 HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "unable to create page buffer")
 
+        /* Read ahead the metadata in the access trace, if one was recorded */
+        if (mdc_access_trace)
+            if (H5C_replay_access_trace(file) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_READERROR, NULL, "unable to replay metadata cache access trace")
+
         /* Open the root group */
         if (H5G_mkroot(file, FALSE) < 0)
             HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "unable to read root group")
+
+        /* Let threads look up metadata without the library's lock, in files
+         * that nothing writes
+         */
+        if (!(H5F_INTENT(file) & (H5F_ACC_RDWR | H5F_ACC_SWMR_READ)) &&
+            !H5F_HAS_FEATURE(file, H5FD_FEAT_HAS_MPI))
+            if (H5C_enable_shared_reads(shared->cache) < 0)
+                HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "unable to enable shared metadata cache reads")
     } /* end if */
 
     /*
@@ -2004,6 +2030,14 @@ H5F_open(const char *name, unsigned flags, hid_t fcpl_id, hid_t fapl_id)
             HGOTO_ERROR(H5E_FILE, H5E_BADVALUE, NULL, "file evict-on-close value doesn't match")
     } /* end if */
 
+    /* Record the number of threads for serializing metadata cache entries,
+     * from the access property list the file is first opened with.
+     */
+    if (H5P_get(a_plist, H5F_ACS_MDC_SERIALIZE_THREADS_NAME, &mdc_serialize_threads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get metadata cache serialize thread count")
+    if (shared->nrefs == 1)
+        shared->mdc_serialize_threads = mdc_serialize_threads;
+
     /* Formulate the absolute path for later search of target file for external links */
     if (shared->nrefs == 1) {
         if (H5_build_extpath(name, &file->shared->extpath) < 0)
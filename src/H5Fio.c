@@ -54,6 +54,9 @@
 /* Local Prototypes */
 /********************/
 
+static hbool_t H5F__vector_needs_buffering(const H5F_shared_t *f_sh, size_t count, const haddr_t addrs[],
+                                           const size_t sizes[]);
+
 /*********************/
 /* Package Variables */
 /*********************/
@@ -194,6 +197,139 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5F_shared_block_write() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5F__vector_needs_buffering
+ *
+ * Purpose:	Check whether a vector of requests must go through the page
+ *		buffer or the metadata accumulator, instead of being passed
+ *		directly to the file driver.
+ *
+ * Return:	TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5F__vector_needs_buffering(const H5F_shared_t *f_sh, size_t count, const haddr_t addrs[],
+                            const size_t sizes[])
+{
+    size_t  u;                 /* Local index variable */
+    hbool_t ret_value = FALSE; /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Page buffering caches raw data pages */
+    if (f_sh->page_buf)
+        HGOTO_DONE(TRUE)
+
+    /* Data that overlaps the metadata accumulator must be merged with it */
+    if (f_sh->accum.size > 0)
+        for (u = 0; u < count; u++)
+            if (H5F_addr_overlap(addrs[u], sizes[u], f_sh->accum.loc, f_sh->accum.size))
+                HGOTO_DONE(TRUE)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F__vector_needs_buffering() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_shared_block_read_vector
+ *
+ * Purpose:	Reads COUNT blocks of data of one memory type from a file
+ *		into separate buffers.  The addresses are relative to the
+ *		base address for the file, and are modified by this routine.
+ *
+ *		When nothing is cached for the blocks, they are passed to the
+ *		file driver as a single vector request; otherwise each block
+ *		is read with H5F_shared_block_read().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_shared_block_read_vector(H5F_shared_t *f_sh, H5FD_mem_t type, size_t count, haddr_t addrs[],
+                             const size_t sizes[], void *bufs[] /*out*/)
+{
+    H5FD_mem_t map_type;            /* Mapped memory type */
+    size_t     u;                   /* Local index variable */
+    herr_t     ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f_sh);
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    /* Check for attempting I/O on 'temporary' file address */
+    for (u = 0; u < count; u++)
+        if (H5F_addr_le(f_sh->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+
+    /* Treat global heap as raw data */
+    map_type = (type == H5FD_MEM_GHEAP) ? H5FD_MEM_DRAW : type;
+
+    if (H5F__vector_needs_buffering(f_sh, count, addrs, sizes)) {
+        for (u = 0; u < count; u++)
+            if (H5F_shared_block_read(f_sh, map_type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "block read failed")
+    } /* end if */
+    else if (H5FD_read_vector(f_sh->lf, map_type, count, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "driver vector read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_shared_block_read_vector() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_shared_block_write_vector
+ *
+ * Purpose:	Writes COUNT blocks of data of one memory type from separate
+ *		buffers to a file.  The addresses are relative to the base
+ *		address for the file, and are modified by this routine.
+ *
+ *		When nothing is cached for the blocks, they are passed to the
+ *		file driver as a single vector request; otherwise each block
+ *		is written with H5F_shared_block_write().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5F_shared_block_write_vector(H5F_shared_t *f_sh, H5FD_mem_t type, size_t count, haddr_t addrs[],
+                              const size_t sizes[], const void *bufs[])
+{
+    H5FD_mem_t map_type;            /* Mapped memory type */
+    size_t     u;                   /* Local index variable */
+    herr_t     ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity checks */
+    HDassert(f_sh);
+    HDassert(H5F_SHARED_INTENT(f_sh) & H5F_ACC_RDWR);
+    HDassert(count == 0 || (addrs && sizes && bufs));
+
+    /* Check for attempting I/O on 'temporary' file address */
+    for (u = 0; u < count; u++)
+        if (H5F_addr_le(f_sh->tmp_addr, (addrs[u] + sizes[u])))
+            HGOTO_ERROR(H5E_IO, H5E_BADRANGE, FAIL, "attempting I/O in temporary file space")
+
+    /* Treat global heap as raw data */
+    map_type = (type == H5FD_MEM_GHEAP) ? H5FD_MEM_DRAW : type;
+
+    if (H5F__vector_needs_buffering(f_sh, count, addrs, sizes)) {
+        for (u = 0; u < count; u++)
+            if (H5F_shared_block_write(f_sh, map_type, addrs[u], sizes[u], bufs[u]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "block write failed")
+    } /* end if */
+    else if (H5FD_write_vector(f_sh->lf, map_type, count, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "driver vector write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5F_shared_block_write_vector() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5F_block_write
  *
@@ -156,6 +156,10 @@
  * H5Fefc.c) */
 typedef struct H5F_efc_t H5F_efc_t;
 
+/* Forward declaration of global heap collection free space index struct used
+ * below (defined in H5Fcwfs.c) */
+typedef struct H5F_cwfs_t H5F_cwfs_t;
+
 /* Structure for passing 'user data' to superblock cache callbacks */
 typedef struct H5F_superblock_cache_ud_t {
     /* IN: */
@@ -286,8 +290,10 @@ struct H5F_shared_t {
     hbool_t start_mdc_log_on_access;                 /* set when mdc logging should  */
                                                      /* begin on file access/create          */
     char *             mdc_log_location;             /* location of mdc log               */
+    H5F_mdc_log_format_t mdc_log_format;           /* format of mdc log                 */
     hid_t              fcpl_id;                      /* File creation property list ID 	*/
     H5F_close_degree_t fc_degree;                    /* File close behavior degree	*/
+    unsigned           mdc_serialize_threads;        /* # of threads serializing MDC entries */
     hbool_t  evict_on_close; /* If the file's objects should be evicted from the metadata cache on close */
     size_t   rdcc_nslots;    /* Size of raw data chunk cache (slots)	*/
     size_t   rdcc_nbytes;    /* Size of raw data chunk cache	(bytes)	*/
@@ -299,8 +305,7 @@ struct H5F_shared_t {
     H5F_libver_t         low_bound;         /* The 'low' bound of library format versions */
     H5F_libver_t         high_bound;        /* The 'high' bound of library format versions */
     hbool_t              store_msg_crt_idx; /* Store creation index for object header messages?	*/
-    unsigned             ncwfs;             /* Num entries on cwfs list		*/
-    struct H5HG_heap_t **cwfs;              /* Global heap cache			*/
+    H5F_cwfs_t *         cwfs;              /* Global heap collections with free space */
     struct H5G_t *       root_grp;          /* Open root group			*/
     H5FO_t *             open_objs;         /* Open objects in file                 */
     H5UC_t *             grp_btree_shared;  /* Ref-counted group B-tree node info   */
@@ -449,6 +454,9 @@ H5_DLL herr_t H5F__sfile_add(H5F_shared_t *shared);
 H5_DLL H5F_shared_t *H5F__sfile_search(H5FD_t *lf);
 H5_DLL herr_t        H5F__sfile_remove(H5F_shared_t *shared);
 
+/* Global heap CWFS routines */
+H5_DLL herr_t H5F__cwfs_dest(H5F_shared_t *shared);
+
 /* External file cache routines */
 H5_DLL H5F_efc_t *H5F__efc_create(unsigned max_nfiles);
 H5_DLL H5F_t *  H5F__efc_open(H5F_t *parent, const char *name, unsigned flags, hid_t fcpl_id, hid_t fapl_id);
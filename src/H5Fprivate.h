@@ -372,6 +372,7 @@ typedef struct H5F_t H5F_t;
 #define H5F_USE_MDC_LOGGING(F)         ((F)->shared->use_mdc_logging)
 #define H5F_START_MDC_LOG_ON_ACCESS(F) ((F)->shared->start_mdc_log_on_access)
 #define H5F_MDC_LOG_LOCATION(F)        ((F)->shared->mdc_log_location)
+#define H5F_MDC_LOG_FORMAT(F)          ((F)->shared->mdc_log_format)
 #define H5F_ALIGNMENT(F)               ((F)->shared->alignment)
 #define H5F_THRESHOLD(F)               ((F)->shared->threshold)
 #define H5F_PGEND_META_THRES(F)        ((F)->shared->fs.pgend_meta_thres)
@@ -435,6 +436,7 @@ typedef struct H5F_t H5F_t;
 #define H5F_USE_MDC_LOGGING(F)         (H5F_use_mdc_logging(F))
 #define H5F_START_MDC_LOG_ON_ACCESS(F) (H5F_start_mdc_log_on_access(F))
 #define H5F_MDC_LOG_LOCATION(F)        (H5F_mdc_log_location(F))
+#define H5F_MDC_LOG_FORMAT(F)          (H5F_mdc_log_format(F))
 #define H5F_ALIGNMENT(F)               (H5F_get_alignment(F))
 #define H5F_THRESHOLD(F)               (H5F_get_threshold(F))
 #define H5F_PGEND_META_THRES(F)        (H5F_get_pgend_meta_thres(F))
@@ -598,8 +600,12 @@ typedef struct H5F_t H5F_t;
 #define H5F_ACS_MDC_LOG_LOCATION_NAME "mdc_log_location" /* Name of metadata cache log location */
 #define H5F_ACS_START_MDC_LOG_ON_ACCESS_NAME                                                                 \
     "start_mdc_log_on_access" /* Whether logging starts on file create/open */
+#define H5F_ACS_MDC_LOG_FORMAT_NAME "mdc_log_format" /* Format of metadata cache log */
 #define H5F_ACS_EVICT_ON_CLOSE_FLAG_NAME                                                                     \
     "evict_on_close_flag" /* Whether or not the metadata cache will evict objects on close */
+#define H5F_ACS_MDC_SERIALIZE_THREADS_NAME                                                                   \
+    "mdc_serialize_threads" /* # of threads for serializing metadata cache entries on flush */
+#define H5F_ACS_MDC_ACCESS_TRACE_NAME "mdc_access_trace" /* Location of metadata cache access trace */
 #define H5F_ACS_COLL_MD_WRITE_FLAG_NAME                                                                      \
     "collective_metadata_write" /* property indicating whether metadata writes are done collectively or not  \
                                  */
@@ -893,14 +899,16 @@ H5_DLL hsize_t            H5F_get_threshold(const H5F_t *f);
 #ifdef H5_HAVE_PARALLEL
 H5_DLL H5P_coll_md_read_flag_t H5F_coll_md_read(const H5F_t *f);
 #endif /* H5_HAVE_PARALLEL */
-H5_DLL hbool_t H5F_use_mdc_logging(const H5F_t *f);
-H5_DLL hbool_t H5F_start_mdc_log_on_access(const H5F_t *f);
-H5_DLL char *  H5F_mdc_log_location(const H5F_t *f);
+H5_DLL hbool_t              H5F_use_mdc_logging(const H5F_t *f);
+H5_DLL hbool_t              H5F_start_mdc_log_on_access(const H5F_t *f);
+H5_DLL char *               H5F_mdc_log_location(const H5F_t *f);
+H5_DLL H5F_mdc_log_format_t H5F_mdc_log_format(const H5F_t *f);
 
 /* Functions that retrieve values from VFD layer */
 H5_DLL hid_t   H5F_get_driver_id(const H5F_t *f);
 H5_DLL herr_t  H5F_get_fileno(const H5F_t *f, unsigned long *filenum);
 H5_DLL hbool_t H5F_shared_has_feature(const H5F_shared_t *f, unsigned feature);
+H5_DLL hbool_t H5F_shared_has_vector_io(const H5F_shared_t *f_sh);
 H5_DLL hbool_t H5F_has_feature(const H5F_t *f, unsigned feature);
 H5_DLL haddr_t H5F_shared_get_eoa(const H5F_shared_t *f_sh, H5FD_mem_t type);
 H5_DLL haddr_t H5F_get_eoa(const H5F_t *f, H5FD_mem_t type);
@@ -919,6 +927,10 @@ H5_DLL herr_t H5F_block_read(H5F_t *f, H5FD_mem_t type, haddr_t addr, size_t siz
 H5_DLL herr_t H5F_shared_block_write(H5F_shared_t *f_sh, H5FD_mem_t type, haddr_t addr, size_t size,
                                      const void *buf);
 H5_DLL herr_t H5F_block_write(H5F_t *f, H5FD_mem_t type, haddr_t addr, size_t size, const void *buf);
+H5_DLL herr_t H5F_shared_block_read_vector(H5F_shared_t *f_sh, H5FD_mem_t type, size_t count, haddr_t addrs[],
+                                           const size_t sizes[], void *bufs[] /*out*/);
+H5_DLL herr_t H5F_shared_block_write_vector(H5F_shared_t *f_sh, H5FD_mem_t type, size_t count, haddr_t addrs[],
+                                            const size_t sizes[], const void *bufs[]);
 
 /* Functions that flush or evict */
 H5_DLL herr_t H5F_flush_tagged_metadata(H5F_t *f, haddr_t tag);
@@ -975,8 +987,7 @@ H5_DLL H5F_t *H5F_prefix_open_file(H5F_t *primary_file, H5F_prefix_open_t prefix
 /* Global heap CWFS routines */
 H5_DLL herr_t H5F_cwfs_add(H5F_t *f, struct H5HG_heap_t *heap);
 H5_DLL herr_t H5F_cwfs_find_free_heap(H5F_t *f, size_t need, haddr_t *addr);
-H5_DLL herr_t H5F_cwfs_advance_heap(H5F_t *f, struct H5HG_heap_t *heap, hbool_t add_heap);
-H5_DLL herr_t H5F_cwfs_remove_heap(H5F_shared_t *shared, struct H5HG_heap_t *heap);
+H5_DLL herr_t H5F_cwfs_remove_heap(H5F_shared_t *shared, haddr_t addr);
 
 /* Debugging functions */
 H5_DLL herr_t H5F_debug(H5F_t *f, FILE *stream, int indent, int fwidth);
@@ -122,6 +122,14 @@ typedef enum H5F_close_degree_t {
     H5F_CLOSE_STRONG  = 3  /**< If there are opened objects, close them first, then close file */
 } H5F_close_degree_t;
 
+/**
+ * Format of the metadata cache log
+ */
+typedef enum H5F_mdc_log_format_t {
+    H5F_MDC_LOG_FORMAT_JSON   = 0, /**< JSON messages (the default) */
+    H5F_MDC_LOG_FORMAT_BINARY = 1  /**< Fixed-size binary records, decoded with the h5mdclog tool */
+} H5F_mdc_log_format_t;
+
 /**
  * Current "global" information about file
  */
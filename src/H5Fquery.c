@@ -824,6 +824,25 @@ H5F_shared_has_feature(const H5F_shared_t *f_sh, unsigned feature)
     FUNC_LEAVE_NOAPI((hbool_t)(f_sh->lf->feature_flags & feature))
 } /* end H5F_shared_has_feature() */
 
+/*-------------------------------------------------------------------------
+ * Function: H5F_shared_has_vector_io
+ *
+ * Purpose:  Check if the file's driver implements vector I/O callbacks.
+ *
+ * Return:   Success:    Non-negative, TRUE/FALSE
+ *           Failure:    (can't happen)
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5F_shared_has_vector_io(const H5F_shared_t *f_sh)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f_sh);
+
+    FUNC_LEAVE_NOAPI(H5FD_has_vector_io(f_sh->lf))
+} /* end H5F_shared_has_vector_io() */
+
 /*-------------------------------------------------------------------------
  * Function: H5F_has_feature
  *
@@ -1116,6 +1135,29 @@ H5F_mdc_log_location(const H5F_t *f)
     FUNC_LEAVE_NOAPI(f->shared->mdc_log_location)
 } /* end H5F_mdc_log_location() */
 
+/*-------------------------------------------------------------------------
+ * Function: H5F_mdc_log_format
+ *
+ * Purpose:  Quick and dirty routine to retrieve the MDC log format
+ *           for this file.
+ *           (Mainly added to stop non-file routines from poking about in the
+ *           H5F_t data structure)
+ *
+ * Return:   MDC log format on success/abort on failure (shouldn't fail)
+ *-------------------------------------------------------------------------
+ */
+H5F_mdc_log_format_t
+H5F_mdc_log_format(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->mdc_log_format)
+} /* end H5F_mdc_log_format() */
+
 /*-------------------------------------------------------------------------
  * Function: H5F_get_alignment
  *
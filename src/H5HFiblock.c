@@ -36,6 +36,7 @@
 #include "H5Fprivate.h"  /* File access				*/
 #include "H5HFpkg.h"     /* Fractal heaps			*/
 #include "H5MFprivate.h" /* File memory management		*/
+#include "H5MMprivate.h" /* Memory management			*/
 #include "H5VMprivate.h" /* Vectors and arrays 			*/
 
 /****************/
@@ -57,6 +58,7 @@ static herr_t H5HF__iblock_pin(H5HF_indirect_t *iblock);
 static herr_t H5HF__iblock_unpin(H5HF_indirect_t *iblock);
 static herr_t H5HF__man_iblock_root_halve(H5HF_indirect_t *root_iblock);
 static herr_t H5HF__man_iblock_root_revert(H5HF_indirect_t *root_iblock);
+static herr_t H5HF__man_iblock_prefetch_children(H5HF_hdr_t *hdr, const H5HF_indirect_t *iblock);
 
 /*********************/
 /* Package Variables */
@@ -1623,6 +1625,10 @@ H5HF__man_iblock_delete(H5HF_hdr_t *hdr, haddr_t iblock_addr, unsigned iblock_nr
     HDassert(iblock->nchildren > 0);
     HDassert(did_protect == TRUE);
 
+    /* Read ahead the child indirect blocks */
+    if (H5HF__man_iblock_prefetch_children(hdr, iblock) < 0)
+        HGOTO_ERROR(H5E_HEAP, H5E_CANTLOAD, FAIL, "unable to read ahead child indirect blocks")
+
     /* Iterate over rows in this indirect block */
     entry = 0;
     for (row = 0; row < iblock->nrows; row++) {
@@ -1696,6 +1702,66 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5HF__man_iblock_delete() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5HF__man_iblock_prefetch_children
+ *
+ * Purpose:     Read ahead the child indirect blocks of an indirect block,
+ *              before they are visited one after the other.  (Direct
+ *              blocks aren't loaded when a heap is deleted or its size
+ *              computed, so they are left alone.)
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5HF__man_iblock_prefetch_children(H5HF_hdr_t *hdr, const H5HF_indirect_t *iblock)
+{
+    H5AC_prefetch_req_t *reqs      = NULL;    /* Child indirect blocks to read ahead */
+    size_t               nreqs     = 0;       /* Number of child indirect blocks to read ahead */
+    unsigned             row, col;            /* Current row & column in indirect block */
+    unsigned             entry;               /* Current entry in row */
+    herr_t               ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /*
+     * Check arguments.
+     */
+    HDassert(hdr);
+    HDassert(iblock);
+
+    if (iblock->nrows <= hdr->man_dtable.max_direct_rows)
+        HGOTO_DONE(SUCCEED)
+
+    if (NULL == (reqs = (H5AC_prefetch_req_t *)H5MM_malloc(
+                     (iblock->nrows - hdr->man_dtable.max_direct_rows) * hdr->man_dtable.cparam.width *
+                     sizeof(H5AC_prefetch_req_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for indirect block read-ahead")
+
+    entry = hdr->man_dtable.max_direct_rows * hdr->man_dtable.cparam.width;
+    for (row = hdr->man_dtable.max_direct_rows; row < iblock->nrows; row++) {
+        unsigned child_nrows; /* Number of rows in the row's child indirect blocks */
+
+        child_nrows = H5HF__dtable_size_to_rows(&hdr->man_dtable, hdr->man_dtable.row_block_size[row]);
+        for (col = 0; col < hdr->man_dtable.cparam.width; col++, entry++)
+            if (H5F_addr_defined(iblock->ents[entry].addr)) {
+                reqs[nreqs].type = H5AC_FHEAP_IBLOCK;
+                reqs[nreqs].addr = iblock->ents[entry].addr;
+                reqs[nreqs].len  = (size_t)H5HF_MAN_INDIRECT_SIZE(hdr, child_nrows);
+                nreqs++;
+            } /* end if */
+    }         /* end for */
+
+    if (H5AC_prefetch_entries(hdr->f, nreqs, reqs) < 0)
+        HGOTO_ERROR(H5E_HEAP, H5E_CANTLOAD, FAIL, "unable to read ahead fractal heap indirect blocks")
+
+done:
+    H5MM_xfree(reqs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5HF__man_iblock_prefetch_children() */
+
 /*-------------------------------------------------------------------------
  *
  * Function:    H5HF__man_iblock_size
@@ -1747,6 +1813,11 @@ H5HF__man_iblock_size(H5F_t *f, H5HF_hdr_t *hdr, haddr_t iblock_addr, unsigned n
         num_indirect_rows = (H5VM_log2_gen(hdr->man_dtable.row_block_size[hdr->man_dtable.max_direct_rows]) -
                              first_row_bits) +
                             1;
+
+        /* Read ahead the child indirect blocks */
+        if (H5HF__man_iblock_prefetch_children(hdr, iblock) < 0)
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTLOAD, FAIL, "unable to read ahead child indirect blocks")
+
         for (u = hdr->man_dtable.max_direct_rows; u < iblock->nrows; u++, num_indirect_rows++) {
             size_t v; /* Local index variable */
 
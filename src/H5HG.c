@@ -21,16 +21,13 @@
  *		collection.  A collection is treated as an atomic entity for
  *		the purposes of I/O and caching.
  *
- *		Each file has a small cache of global heap collections called
- *		the CWFS list and recently accessed collections with free
- *		space appear on this list.  As collections are accessed the
- *		collection is moved toward the front of the list.  New
- *		collections are added to the front of the list while old
- *		collections are added to the end of the list.
+ *		Each file has an index of its global heap collections and
+ *		their free space called the CWFS index (see H5Fcwfs.c), with
+ *		the collections bucketed into size classes by free space.
  *
  *		The collection model reduces the overhead which would be
  *		incurred if the global heap were a single object, and the
- *		CWFS list allows the library to cheaply choose a collection
+ *		CWFS index allows the library to cheaply choose a collection
  *		for a new object based on object size, amount of free space
  *		in the collection, and temporal locality.
  */
@@ -69,6 +66,12 @@
 /* Local Typedefs */
 /******************/
 
+/* An object of a batched read, with its position in the batch */
+typedef struct H5HG_batch_obj_t {
+    H5HG_t hobj; /* Location of the object in the heap */
+    size_t pos;  /* Index of the object in the batch */
+} H5HG_batch_obj_t;
+
 /********************/
 /* Package Typedefs */
 /********************/
@@ -79,6 +82,7 @@
 
 static haddr_t H5HG__create(H5F_t *f, size_t size);
 static size_t  H5HG__alloc(H5F_t *f, H5HG_heap_t *heap, size_t size, unsigned *heap_flags_ptr);
+static int     H5HG__batch_obj_cmp(const void *_obj1, const void *_obj2);
 
 /*********************/
 /* Package Variables */
@@ -96,6 +100,9 @@ H5FL_SEQ_DEFINE(H5HG_obj_t);
 /* Declare a PQ free list to manage heap chunks */
 H5FL_BLK_DEFINE(gheap_chunk);
 
+/* Declare a free list to manage the objects of batched reads */
+H5FL_SEQ_DEFINE_STATIC(H5HG_batch_obj_t);
+
 /*****************************/
 /* Library Private Variables */
 /*****************************/
@@ -110,7 +117,7 @@ H5FL_BLK_DEFINE(gheap_chunk);
  * Purpose:	Creates a global heap collection of the specified size.  If
  *		SIZE is less than some minimum it will be readjusted.  The
  *		new collection is allocated in the file and added to the
- *		beginning of the CWFS list.
+ *		file's CWFS index.
  *
  * Return:	Success:	Ptr to a cached heap.  The pointer is valid
  *				only until some other hdf5 library function
@@ -193,7 +200,7 @@ H5HG__create(H5F_t *f, size_t size)
     HDmemset(p, 0, (size_t)((heap->chunk + heap->size) - p));
 #endif /* OLD_WAY */
 
-    /* Add this heap to the beginning of the CWFS list */
+    /* Add this heap to the file's CWFS index */
     if (H5F_cwfs_add(f, heap) < 0)
         HGOTO_ERROR(H5E_HEAP, H5E_CANTINIT, HADDR_UNDEF,
                     "unable to add global heap collection to file's CWFS")
@@ -211,6 +218,9 @@ done:
             /* Release the space on disk */
             if (H5MF_xfree(f, H5FD_MEM_GHEAP, addr, (hsize_t)size) < 0)
                 HDONE_ERROR(H5E_BTREE, H5E_CANTFREE, HADDR_UNDEF, "unable to free global heap")
+            if (H5F_cwfs_remove_heap(H5F_SHARED(f), addr) < 0)
+                HDONE_ERROR(H5E_HEAP, H5E_CANTREMOVE, HADDR_UNDEF,
+                            "can't remove global heap collection from file's CWFS")
 
             /* Check if the heap object was allocated */
             if (heap)
@@ -239,7 +249,7 @@ done:
 H5HG_heap_t *
 H5HG__protect(H5F_t *f, haddr_t addr, unsigned flags)
 {
-    H5HG_heap_t *heap;             /* Global heap */
+    H5HG_heap_t *heap      = NULL; /* Global heap */
     H5HG_heap_t *ret_value = NULL; /* Return value */
 
     FUNC_ENTER_PACKAGE
@@ -258,10 +268,19 @@ H5HG__protect(H5F_t *f, haddr_t addr, unsigned flags)
     /* Set the heap's address */
     heap->addr = addr;
 
+    /* Record the heap's free space in the CWFS index for the file, now that
+     * its address is known (the heap may have just been loaded)
+     */
+    if ((H5F_INTENT(f) & H5F_ACC_RDWR) && H5F_cwfs_add(f, heap) < 0)
+        HGOTO_ERROR(H5E_HEAP, H5E_CANTINIT, NULL, "unable to add global heap collection to file's CWFS")
+
     /* Set the return value */
     ret_value = heap;
 
 done:
+    if (!ret_value && heap && H5AC_unprotect(f, H5AC_GHEAP, addr, heap, H5AC__NO_FLAGS_SET) < 0)
+        HDONE_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, NULL, "unable to unprotect global heap")
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5HG__protect() */
 
@@ -377,6 +396,10 @@ H5HG__alloc(H5F_t *f, H5HG_heap_t *heap, size_t size, unsigned *heap_flags_ptr)
         HDassert(H5HG_ISALIGNED(heap->obj[0].size));
     }
 
+    /* Record the collection's remaining free space */
+    if (H5F_cwfs_add(f, heap) < 0)
+        HGOTO_ERROR(H5E_HEAP, H5E_CANTMODIFY, 0, "can't adjust file's CWFS")
+
     /* Mark the heap as dirty */
     *heap_flags_ptr |= H5AC__DIRTIED_FLAG;
 
@@ -461,6 +484,10 @@ H5HG_extend(H5F_t *f, haddr_t addr, size_t need)
     if (H5AC_resize_entry(heap, heap->size) < 0)
         HGOTO_ERROR(H5E_HEAP, H5E_CANTRESIZE, FAIL, "unable to resize global heap in cache")
 
+    /* Record the collection's new free space */
+    if (H5F_cwfs_add(f, heap) < 0)
+        HGOTO_ERROR(H5E_HEAP, H5E_CANTMODIFY, FAIL, "can't adjust file's CWFS")
+
     /* Mark the heap as dirty */
     heap_flags |= H5AC__DIRTIED_FLAG;
 
@@ -475,10 +502,10 @@ done:
  * Function:	H5HG_insert
  *
  * Purpose:	A new object is inserted into the global heap.  It will be
- *		placed in the first collection on the CWFS list which has
- *		enough free space and that collection will be advanced one
- *		position in the list.  If no collection on the CWFS list has
- *		enough space then  a new collection will be created.
+ *		placed in the collection on the CWFS index which best fits
+ *		it, and that collection becomes the most recently used one.
+ *		If no collection on the CWFS index has enough space then a
+ *		new collection will be created.
  *
  *		It is legal to push a zero-byte object onto the heap to get
  *		the reference count features of heap objects.
@@ -513,7 +540,7 @@ H5HG_insert(H5F_t *f, size_t size, const void *obj, H5HG_t *hobj /*out*/)
     if (0 == (H5F_INTENT(f) & H5F_ACC_RDWR))
         HGOTO_ERROR(H5E_HEAP, H5E_WRITEERROR, FAIL, "no write intent on file")
 
-    /* Find a large enough collection on the CWFS list */
+    /* Find a large enough collection on the CWFS index */
     need = H5HG_SIZEOF_OBJHDR(f) + H5HG_ALIGN(size);
 
     /* Look for a heap in the file's CWFS that has enough space for the object */
@@ -562,6 +589,98 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value)
 } /* H5HG_insert() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5HG_insert_batch
+ *
+ * Purpose:	Inserts NOBJS new objects into the global heap at once.
+ *		Rather than searching the CWFS index for each object, the
+ *		objects are split in order into runs of up to H5HG_MAXSIZE
+ *		bytes (an object too large for that is a run of its own, as
+ *		with H5HG_insert).  Each run is packed into the collection
+ *		on the CWFS index which best fits the whole run, or else into
+ *		a freshly created collection sized to hold it.  Each
+ *		collection is protected only once while its objects are
+ *		copied in, and any space left over is available to later
+ *		inserts through the CWFS index.
+ *
+ *		SIZES and OBJS describe the objects, which may be zero bytes
+ *		long, and the heap object handles are returned through HOBJS.
+ *
+ * Return:	Success:	Non-negative
+ *
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5HG_insert_batch(H5F_t *f, size_t nobjs, const size_t sizes[], const void *objs[], H5HG_t hobjs[] /*out*/)
+{
+    H5HG_heap_t *heap       = NULL;
+    unsigned     heap_flags = H5AC__NO_FLAGS_SET;
+    size_t       first;               /* Index of first object in current collection */
+    size_t       last;                /* Index one past the last object in current collection */
+    size_t       u;                   /* Local index variable */
+    herr_t       ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI_TAG(H5AC__GLOBALHEAP_TAG, FAIL)
+
+    /* Check args */
+    HDassert(f);
+    HDassert(0 == nobjs || (sizes && objs && hobjs));
+
+    if (0 == (H5F_INTENT(f) & H5F_ACC_RDWR))
+        HGOTO_ERROR(H5E_HEAP, H5E_WRITEERROR, FAIL, "no write intent on file")
+
+    for (first = 0; first < nobjs; first = last) {
+        size_t  total = H5HG_SIZEOF_HDR(f); /* Size of the collection for this run of objects */
+        haddr_t addr;                       /* Address of the collection for this run */
+
+        /* Gather as many objects as fit in a collection of the maximum size */
+        for (last = first; last < nobjs; last++) {
+            size_t need = H5HG_SIZEOF_OBJHDR(f) + H5HG_ALIGN(sizes[last]);
+
+            if (last > first && total + need > H5HG_MAXSIZE)
+                break;
+            total += need;
+        } /* end for */
+        HDassert((last - first) <= H5HG_MAXIDX);
+
+        /* Look for a collection with room for them, or allocate one */
+        addr = HADDR_UNDEF;
+        if (H5F_cwfs_find_free_heap(f, total - H5HG_SIZEOF_HDR(f), &addr) < 0)
+            HGOTO_ERROR(H5E_HEAP, H5E_NOTFOUND, FAIL, "error trying to locate heap")
+        if (!H5F_addr_defined(addr) && !H5F_addr_defined(addr = H5HG__create(f, total)))
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTINIT, FAIL, "unable to allocate a global heap collection")
+        if (NULL == (heap = H5HG__protect(f, addr, H5AC__NO_FLAGS_SET)))
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTPROTECT, FAIL, "unable to protect global heap")
+
+        /* Split off the objects and copy their data into the collection */
+        for (u = first; u < last; u++) {
+            size_t idx;
+
+            HDassert(0 == sizes[u] || objs[u]);
+            if (0 == (idx = H5HG__alloc(f, heap, sizes[u], &heap_flags)))
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTALLOC, FAIL, "unable to allocate global heap object")
+            if (sizes[u] > 0)
+                H5MM_memcpy(heap->obj[idx].begin + H5HG_SIZEOF_OBJHDR(f), objs[u], sizes[u]);
+
+            hobjs[u].addr = heap->addr;
+            hobjs[u].idx  = idx;
+        } /* end for */
+
+        if (H5AC_unprotect(f, H5AC_GHEAP, heap->addr, heap, heap_flags) < 0)
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to unprotect heap.")
+        heap       = NULL;
+        heap_flags = H5AC__NO_FLAGS_SET;
+    } /* end for */
+
+done:
+    if (heap && H5AC_unprotect(f, H5AC_GHEAP, heap->addr, heap, heap_flags) < 0)
+        HDONE_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to unprotect heap.")
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value)
+} /* H5HG_insert_batch() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5HG_read
  *
@@ -608,15 +727,6 @@ H5HG_read(H5F_t *f, H5HG_t *hobj, void *object /*out*/, size_t *buf_size)
         HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed")
     H5MM_memcpy(object, p, size);
 
-    /*
-     * Advance the heap in the CWFS list. We might have done this already
-     * with the H5AC_protect(), but it won't hurt to do it twice.
-     */
-    if (heap->obj[0].begin) {
-        if (H5F_cwfs_advance_heap(f, heap, FALSE) < 0)
-            HGOTO_ERROR(H5E_HEAP, H5E_CANTMODIFY, NULL, "can't adjust file's CWFS")
-    } /* end if */
-
     /* If the caller would like to know the heap object's size, set that */
     if (buf_size)
         *buf_size = size;
@@ -634,6 +744,122 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value)
 } /* end H5HG_read() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5HG__batch_obj_cmp
+ *
+ * Purpose:	Callback routine for sorting the objects of a batched read
+ *		by collection address and then by index within the collection
+ *
+ * Return:	An integer less than, equal to, or greater than zero if the
+ *		first object is considered to be respectively less than,
+ *		equal to, or greater than the second.
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5HG__batch_obj_cmp(const void *_obj1, const void *_obj2)
+{
+    const H5HG_batch_obj_t *obj1      = (const H5HG_batch_obj_t *)_obj1;
+    const H5HG_batch_obj_t *obj2      = (const H5HG_batch_obj_t *)_obj2;
+    int                     ret_value = 0; /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if (H5F_addr_lt(obj1->hobj.addr, obj2->hobj.addr))
+        ret_value = -1;
+    else if (H5F_addr_gt(obj1->hobj.addr, obj2->hobj.addr))
+        ret_value = 1;
+    else if (obj1->hobj.idx < obj2->hobj.idx)
+        ret_value = -1;
+    else if (obj1->hobj.idx > obj2->hobj.idx)
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5HG__batch_obj_cmp() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5HG_read_batch
+ *
+ * Purpose:	Reads NOBJS global heap objects into the buffers OBJS
+ *		supplied by the caller.  SIZES gives the expected size of
+ *		each object, which must match the size stored in the heap.
+ *		Objects with a size of zero aren't looked up at all.
+ *
+ *		The objects are visited in collection order so that each
+ *		collection is protected only once, however the objects are
+ *		ordered in the batch.
+ *
+ * Return:	Success:	Non-negative
+ *
+ *		Failure:	Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5HG_read_batch(H5F_t *f, size_t nobjs, const H5HG_t hobjs[], void *objs[] /*out*/, const size_t sizes[])
+{
+    H5HG_batch_obj_t *order     = NULL;        /* Objects to read, in collection order */
+    H5HG_heap_t *     heap      = NULL;        /* Pointer to global heap object */
+    haddr_t           heap_addr = HADDR_UNDEF; /* Address of the protected collection */
+    size_t            nread     = 0;           /* Number of objects to read */
+    size_t            u;                       /* Local index variable */
+    herr_t            ret_value = SUCCEED;     /* Return value */
+
+    FUNC_ENTER_NOAPI_TAG(H5AC__GLOBALHEAP_TAG, FAIL)
+
+    /* Check args */
+    HDassert(f);
+    HDassert(0 == nobjs || (hobjs && objs && sizes));
+
+    if (0 == nobjs)
+        HGOTO_DONE(SUCCEED)
+
+    /* Sort the objects that have data by their location in the heap */
+    if (NULL == (order = H5FL_SEQ_MALLOC(H5HG_batch_obj_t, nobjs)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    for (u = 0; u < nobjs; u++)
+        if (sizes[u] > 0) {
+            order[nread].hobj = hobjs[u];
+            order[nread].pos  = u;
+            nread++;
+        } /* end if */
+    if (nread > 1)
+        HDqsort(order, nread, sizeof(H5HG_batch_obj_t), H5HG__batch_obj_cmp);
+
+    for (u = 0; u < nread; u++) {
+        const H5HG_t *hobj = &order[u].hobj;
+        size_t        pos  = order[u].pos;
+
+        /* Move on to the object's collection, if it's not the current one */
+        if (!heap || !H5F_addr_eq(heap_addr, hobj->addr)) {
+            if (heap) {
+                if (H5AC_unprotect(f, H5AC_GHEAP, heap_addr, heap, H5AC__NO_FLAGS_SET) < 0)
+                    HGOTO_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to release object header")
+                heap = NULL;
+            } /* end if */
+
+            if (NULL == (heap = H5HG__protect(f, hobj->addr, H5AC__READ_ONLY_FLAG)))
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTPROTECT, FAIL, "unable to protect global heap")
+            heap_addr = hobj->addr;
+        } /* end if */
+
+        /* Copy the object out */
+        if (hobj->idx >= heap->nused || NULL == heap->obj[hobj->idx].begin)
+            HGOTO_ERROR(H5E_HEAP, H5E_BADVALUE, FAIL, "bad global heap object index")
+        if (heap->obj[hobj->idx].size != sizes[pos])
+            HGOTO_ERROR(H5E_HEAP, H5E_BADVALUE, FAIL, "global heap object size does not match")
+        H5MM_memcpy(objs[pos], heap->obj[hobj->idx].begin + H5HG_SIZEOF_OBJHDR(f), sizes[pos]);
+    } /* end for */
+
+done:
+    if (heap && H5AC_unprotect(f, H5AC_GHEAP, heap_addr, heap, H5AC__NO_FLAGS_SET) < 0)
+        HDONE_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to release object header")
+    if (order)
+        order = H5FL_SEQ_FREE(H5HG_batch_obj_t, order);
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value)
+} /* end H5HG_read_batch() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5HG_link
  *
@@ -806,20 +1032,21 @@ H5HG_remove(H5F_t *f, H5HG_t *hobj)
 
     if ((heap->obj[0].size + H5HG_SIZEOF_HDR(f)) == heap->size) {
         /*
-         * The collection is empty. Remove it from the CWFS list and return it
+         * The collection is empty. Remove it from the CWFS index and return it
          * to the file free list.
          */
+        if (H5F_cwfs_remove_heap(H5F_SHARED(f), hobj->addr) < 0)
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTREMOVE, FAIL, "can't remove heap from file's CWFS")
         flags |=
             H5AC__DELETED_FLAG |
             H5AC__FREE_FILE_SPACE_FLAG; /* Indicate that the object was deleted, for the unprotect call */
     }                                   /* end if */
     else {
         /*
-         * If the heap is in the CWFS list then advance it one position.  The
-         * H5AC_protect() might have done that too, but that's okay.  If the
-         * heap isn't on the CWFS list then add it to the end.
+         * Record the collection's new free space, making it the most
+         * recently used collection.
          */
-        if (H5F_cwfs_advance_heap(f, heap, TRUE) < 0)
+        if (H5F_cwfs_add(f, heap) < 0)
             HGOTO_ERROR(H5E_HEAP, H5E_CANTMODIFY, FAIL, "can't adjust file's CWFS")
     } /* end else */
 
@@ -833,7 +1060,9 @@ done:
 /*-------------------------------------------------------------------------
  * Function:    H5HG__free
  *
- * Purpose:     Destroys a global heap collection in memory
+ * Purpose:     Destroys a global heap collection in memory.  The
+ *              collection stays in the file's CWFS index, which
+ *              doesn't refer to it in memory.
  *
  * Return:      SUCCEED/FAIL
  *
@@ -847,21 +1076,16 @@ H5HG__free(H5HG_heap_t *heap)
 {
     herr_t ret_value = SUCCEED; /* Return value */
 
-    FUNC_ENTER_NOAPI(FAIL)
+    FUNC_ENTER_NOAPI_NOERR
 
     /* Check arguments */
     HDassert(heap);
 
-    /* Remove the heap from the CWFS list */
-    if (H5F_cwfs_remove_heap(heap->shared, heap) < 0)
-        HGOTO_ERROR(H5E_HEAP, H5E_CANTREMOVE, FAIL, "can't remove heap from file's CWFS")
-
     if (heap->chunk)
         heap->chunk = H5FL_BLK_FREE(gheap_chunk, heap->chunk);
     if (heap->obj)
         heap->obj = H5FL_SEQ_FREE(H5HG_obj_t, heap->obj);
     heap = H5FL_FREE(H5HG_heap_t, heap);
 
-done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5HG__free() */
@@ -349,10 +349,6 @@ H5HG__cache_heap_deserialize(const void *_image, size_t len, void *_udata, hbool
     /* Sanity check */
     HDassert(max_idx < heap->nused);
 
-    /* Add the new heap to the CWFS list for the file */
-    if (H5F_cwfs_add(f, heap) < 0)
-        HGOTO_ERROR(H5E_HEAP, H5E_CANTINIT, NULL, "unable to add global heap collection to file's CWFS")
-
     ret_value = heap;
 
 done:
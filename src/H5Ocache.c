@@ -91,20 +91,21 @@ static herr_t H5O__add_cont_msg(H5O_cont_msgs_t *cont_msg_info, const H5O_cont_t
 
 /* H5O object header prefix inherits cache-like properties from H5AC */
 const H5AC_class_t H5AC_OHDR[1] = {{
-    H5AC_OHDR_ID,                      /* Metadata client ID */
-    "object header",                   /* Metadata client name (for debugging) */
-    H5FD_MEM_OHDR,                     /* File space memory type for client */
-    H5AC__CLASS_SPECULATIVE_LOAD_FLAG, /* Client class behavior flags */
-    H5O__cache_get_initial_load_size,  /* 'get_initial_load_size' callback */
-    H5O__cache_get_final_load_size,    /* 'get_final_load_size' callback */
-    H5O__cache_verify_chksum,          /* 'verify_chksum' callback */
-    H5O__cache_deserialize,            /* 'deserialize' callback */
-    H5O__cache_image_len,              /* 'image_len' callback */
-    NULL,                              /* 'pre_serialize' callback */
-    H5O__cache_serialize,              /* 'serialize' callback */
-    H5O__cache_notify,                 /* 'notify' callback */
-    H5O__cache_free_icr,               /* 'free_icr' callback */
-    NULL,                              /* 'fsf_size' callback */
+    H5AC_OHDR_ID,                            /* Metadata client ID */
+    "object header",                         /* Metadata client name (for debugging) */
+    H5FD_MEM_OHDR,                           /* File space memory type for client */
+    H5AC__CLASS_SPECULATIVE_LOAD_FLAG |
+        H5AC__CLASS_PARALLEL_SERIALIZE_FLAG, /* Client class behavior flags */
+    H5O__cache_get_initial_load_size,        /* 'get_initial_load_size' callback */
+    H5O__cache_get_final_load_size,          /* 'get_final_load_size' callback */
+    H5O__cache_verify_chksum,                /* 'verify_chksum' callback */
+    H5O__cache_deserialize,                  /* 'deserialize' callback */
+    H5O__cache_image_len,                    /* 'image_len' callback */
+    NULL,                                    /* 'pre_serialize' callback */
+    H5O__cache_serialize,                    /* 'serialize' callback */
+    H5O__cache_notify,                       /* 'notify' callback */
+    H5O__cache_free_icr,                     /* 'free_icr' callback */
+    NULL,                                    /* 'fsf_size' callback */
 }};
 
 /* H5O object header chunk inherits cache-like properties from H5AC */
@@ -112,7 +113,7 @@ const H5AC_class_t H5AC_OHDR_CHK[1] = {{
     H5AC_OHDR_CHK_ID,                     /* Metadata client ID */
     "object header continuation chunk",   /* Metadata client name (for debugging) */
     H5FD_MEM_OHDR,                        /* File space memory type for client */
-    H5AC__CLASS_NO_FLAGS_SET,             /* Client class behavior flags */
+    H5AC__CLASS_PARALLEL_SERIALIZE_FLAG,  /* Client class behavior flags */
     H5O__cache_chk_get_initial_load_size, /* 'get_initial_load_size' callback */
     NULL,                                 /* 'get_final_load_size' callback */
     H5O__cache_chk_verify_chksum,         /* 'verify_chksum' callback */
@@ -1632,9 +1633,12 @@ H5O__chunk_serialize(const H5F_t *f, H5O_t *oh, unsigned chunkno)
     HDassert(f);
     HDassert(oh);
 
-    /* Encode any dirty messages in this chunk */
+    /* Encode any dirty messages in this chunk.  (Other chunks of the header
+     * may be serialized at the same time on other threads, so check a
+     * message's chunk before looking at its dirty flag.)
+     */
     for (u = 0, curr_msg = &oh->mesg[0]; u < oh->nmesgs; u++, curr_msg++)
-        if (curr_msg->dirty && curr_msg->chunkno == chunkno)
+        if (curr_msg->chunkno == chunkno && curr_msg->dirty)
             /* Casting away const OK -QAK */
             if (H5O_msg_flush((H5F_t *)f, oh, curr_msg) < 0)
                 HGOTO_ERROR(H5E_OHDR, H5E_CANTENCODE, FAIL, "unable to encode object header message")
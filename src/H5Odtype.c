@@ -515,6 +515,14 @@ H5O__dtype_decode_helper(unsigned *ioflags /*in,out*/, const uint8_t **pp, H5T_t
             if (H5O__dtype_decode_helper(ioflags, pp, dt->shared->parent) < 0)
                 HGOTO_ERROR(H5E_DATATYPE, H5E_CANTDECODE, FAIL, "unable to decode VL parent type")
 
+            /* Decode the length of the longest string stored inline */
+            if (version >= H5O_DTYPE_VERSION_5 && dt->shared->u.vlen.type == H5T_VLEN_STRING &&
+                (flags & 0x1000)) {
+                UINT32DECODE(*pp, dt->shared->u.vlen.inline_size);
+            } /* end if */
+            else
+                dt->shared->u.vlen.inline_size = 0;
+
             /* Check if the parent of this vlen has a version greater than the
              * vlen itself. */
             H5O_DTYPE_CHECK_VERSION(dt, version, dt->shared->parent->shared->version, ioflags, "vlen", FAIL)
@@ -1032,11 +1040,19 @@ H5O__dtype_encode_helper(uint8_t **pp, const H5T_t *dt)
             if (dt->shared->u.vlen.type == H5T_VLEN_STRING) {
                 flags = (unsigned)(flags | (((unsigned)dt->shared->u.vlen.pad & 0x0f) << 4));
                 flags = (unsigned)(flags | (((unsigned)dt->shared->u.vlen.cset & 0x0f) << 8));
-            } /* end if */
+                if (dt->shared->u.vlen.inline_size > 0) {
+                    HDassert(dt->shared->version >= H5O_DTYPE_VERSION_5);
+                    flags |= 0x1000;
+                } /* end if */
+            }     /* end if */
 
             /* Encode base type of VL information */
             if (H5O__dtype_encode_helper(pp, dt->shared->parent) < 0)
                 HGOTO_ERROR(H5E_DATATYPE, H5E_CANTENCODE, FAIL, "unable to encode VL parent type")
+
+            /* Encode the length of the longest string stored inline */
+            if (dt->shared->u.vlen.inline_size > 0)
+                UINT32ENCODE(*pp, dt->shared->u.vlen.inline_size);
             break;
 
         case H5T_ARRAY: /* Array datatypes */
@@ -1336,6 +1352,8 @@ H5O__dtype_size(const H5F_t *f, const void *_mesg)
 
         case H5T_VLEN:
             ret_value += H5O__dtype_size(f, dt->shared->parent);
+            if (dt->shared->u.vlen.inline_size > 0)
+                ret_value += 4; /* inline string size */
             break;
 
         case H5T_ARRAY:
@@ -1958,6 +1976,9 @@ H5O__dtype_debug(H5F_t *f, const void *mesg, FILE *stream, int indent, int fwidt
                     break;
             } /* end switch */
             HDfprintf(stream, "%*s%-*s %s\n", indent, "", fwidth, "String Padding:", s);
+            if (dt->shared->u.vlen.inline_size > 0)
+                HDfprintf(stream, "%*s%-*s %zu\n", indent, "", fwidth, "Inline Size:",
+                          dt->shared->u.vlen.inline_size);
         } /* end if */
     }     /* end else if */
     else if (H5T_ARRAY == dt->shared->type) {
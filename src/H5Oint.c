@@ -71,6 +71,7 @@ typedef struct {
 /********************/
 
 static herr_t H5O__delete_oh(H5F_t *f, H5O_t *oh);
+static herr_t H5O__prefetch_chunks(H5F_t *f, const H5O_cont_msgs_t *cont_msg_info, size_t start);
 static herr_t H5O__obj_type_real(const H5O_t *oh, H5O_type_t *obj_type);
 static herr_t H5O__get_hdr_info_real(const H5O_t *oh, H5O_hdr_info_t *hdr);
 static herr_t H5O__free_visit_visited(void *item, void *key, void *operator_data /*in,out*/);
@@ -1049,8 +1050,9 @@ H5O_protect(const H5O_loc_t *loc, unsigned prot_flags, hbool_t pin_all_chunks)
 
     /* Check if there are any continuation messages to process */
     if (cont_msg_info.nmsgs > 0) {
-        size_t             curr_msg;  /* Current continuation message to process */
-        H5O_chk_cache_ud_t chk_udata; /* User data for loading chunk */
+        size_t             curr_msg;       /* Current continuation message to process */
+        size_t             prefetched = 0; /* # of continuation messages whose chunks were read ahead */
+        H5O_chk_cache_ud_t chk_udata;      /* User data for loading chunk */
 
         /* Sanity check - we should only have continuation messages to process
          *      when the object header is actually loaded from the file.
@@ -1078,6 +1080,13 @@ H5O_protect(const H5O_loc_t *loc, unsigned prot_flags, hbool_t pin_all_chunks)
             size_t chkcnt = oh->nchunks; /* Count of chunks (for sanity checking) */
 #endif /* NDEBUG */
 
+            /* Read ahead the chunks of the continuation messages found so far */
+            if (curr_msg == prefetched) {
+                if (H5O__prefetch_chunks(loc->file, &cont_msg_info, curr_msg) < 0)
+                    HGOTO_ERROR(H5E_OHDR, H5E_CANTLOAD, NULL, "unable to read ahead object header chunks")
+                prefetched = cont_msg_info.nmsgs;
+            } /* end if */
+
             /* Bring the chunk into the cache */
             /* (which adds to the object header) */
             chk_udata.common.addr = cont_msg_info.msgs[curr_msg].addr;
@@ -1174,6 +1183,52 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value)
 } /* end H5O_protect() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5O__prefetch_chunks
+ *
+ * Purpose:     Read ahead the chunks of an object header described by the
+ *              continuation messages from START on, so that protecting
+ *              them one after the other doesn't read them one by one.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5O__prefetch_chunks(H5F_t *f, const H5O_cont_msgs_t *cont_msg_info, size_t start)
+{
+    H5AC_prefetch_req_t *reqs      = NULL;    /* Chunks to read ahead */
+    size_t               nreqs;               /* Number of chunks to read ahead */
+    size_t               u;                   /* Local index variable */
+    herr_t               ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(f);
+    HDassert(cont_msg_info);
+    HDassert(start <= cont_msg_info->nmsgs);
+
+    /* Reading a single chunk ahead saves nothing */
+    if ((nreqs = cont_msg_info->nmsgs - start) < 2)
+        HGOTO_DONE(SUCCEED)
+
+    if (NULL == (reqs = (H5AC_prefetch_req_t *)H5MM_malloc(nreqs * sizeof(H5AC_prefetch_req_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk read-ahead")
+    for (u = 0; u < nreqs; u++) {
+        reqs[u].type = H5AC_OHDR_CHK;
+        reqs[u].addr = cont_msg_info->msgs[start + u].addr;
+        reqs[u].len  = cont_msg_info->msgs[start + u].size;
+    } /* end for */
+
+    if (H5AC_prefetch_entries(f, nreqs, reqs) < 0)
+        HGOTO_ERROR(H5E_OHDR, H5E_CANTLOAD, FAIL, "unable to read ahead object header chunks")
+
+done:
+    H5MM_xfree(reqs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5O__prefetch_chunks() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5O_pin
  *
@@ -92,6 +92,12 @@
 #define H5D_XFER_HYPER_VECTOR_SIZE_DEF  H5D_IO_VECTOR_SIZE
 #define H5D_XFER_HYPER_VECTOR_SIZE_ENC  H5P__encode_size_t
 #define H5D_XFER_HYPER_VECTOR_SIZE_DEC  H5P__decode_size_t
+/* Definitions for zero-copy I/O property */
+#define H5D_XFER_ZERO_COPY_IO_SIZE sizeof(hbool_t)
+#define H5D_XFER_ZERO_COPY_IO_DEF  FALSE
+/* Definitions for datatype conversion thread count property */
+#define H5D_XFER_CONV_THREADS_SIZE sizeof(unsigned)
+#define H5D_XFER_CONV_THREADS_DEF  1
 
 /* Parallel I/O properties */
 /* Note: Some of these are registered with the DXPL class even when parallel
@@ -247,6 +253,10 @@ static const void *H5D_def_vlen_free_info_g =
     H5D_XFER_VLEN_FREE_INFO_DEF; /* Default value for vlen free information */
 static const size_t H5D_def_hyp_vec_size_g =
     H5D_XFER_HYPER_VECTOR_SIZE_DEF; /* Default value for vector size */
+static const hbool_t H5D_def_zero_copy_io_g =
+    H5D_XFER_ZERO_COPY_IO_DEF; /* Default value for zero-copy I/O */
+static const unsigned H5D_def_conv_threads_g =
+    H5D_XFER_CONV_THREADS_DEF; /* Default value for datatype conversion thread count */
 static const H5FD_mpio_xfer_t H5D_def_io_xfer_mode_g =
     H5D_XFER_IO_XFER_MODE_DEF; /* Default value for I/O transfer mode */
 static const H5FD_mpio_chunk_opt_t      H5D_def_mpio_chunk_opt_mode_g      = H5D_XFER_MPIO_CHUNK_OPT_HARD_DEF;
@@ -344,6 +354,20 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
                            H5D_XFER_HYPER_VECTOR_SIZE_DEC, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the zero-copy I/O property */
+    /* (Note: this property is not encoded, so that encoded DXPLs stay
+     *  readable by library versions without it)
+     */
+    if (H5P__register_real(pclass, H5D_XFER_ZERO_COPY_IO_NAME, H5D_XFER_ZERO_COPY_IO_SIZE,
+                           &H5D_def_zero_copy_io_g, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the datatype conversion thread count property */
+    /* (Note: not encoded either, for the same reason) */
+    if (H5P__register_real(pclass, H5D_XFER_CONV_THREADS_NAME, H5D_XFER_CONV_THREADS_SIZE,
+                           &H5D_def_conv_threads_g, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the I/O transfer mode properties */
     if (H5P__register_real(pclass, H5D_XFER_IO_XFER_MODE_NAME, H5D_XFER_IO_XFER_MODE_SIZE,
                            &H5D_def_io_xfer_mode_g, NULL, NULL, NULL, H5D_XFER_IO_XFER_MODE_ENC,
@@ -1714,6 +1738,156 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_hyper_vector_size() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_zero_copy_io
+ *
+ * Purpose:	Given a dataset transfer property list, set whether raw data
+ *              that needs no datatype conversion is transferred directly
+ *              between the application's buffer and the file driver, with
+ *              one vector I/O request per batch of selection sequences,
+ *              instead of being staged through the dataset's data sieve
+ *              buffer.
+ *
+ *              This only has an effect for contiguous datasets (and
+ *              unfiltered chunks) in files whose driver implements vector
+ *              I/O, such as the sec2 driver.  It helps large strided
+ *              transfers, where the sieve buffer copies every byte twice;
+ *              many tiny scattered transfers may be faster with the sieve
+ *              buffer, which is why this is off by default.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_zero_copy_io(hid_t plist_id, hbool_t zero_copy)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ib", plist_id, zero_copy);
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if (H5P_set(plist, H5D_XFER_ZERO_COPY_IO_NAME, &zero_copy) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_zero_copy_io() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_zero_copy_io
+ *
+ * Purpose:	Reads values previously set with H5Pset_zero_copy_io().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_zero_copy_io(hid_t plist_id, hbool_t *zero_copy /*out*/)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, zero_copy);
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Return values */
+    if (zero_copy)
+        if (H5P_get(plist, H5D_XFER_ZERO_COPY_IO_NAME, zero_copy) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_zero_copy_io() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_conv_threads
+ *
+ * Purpose:	Given a dataset transfer property list, set the number of
+ *              threads (including the calling thread) that may share the
+ *              work of converting raw data between datatypes.
+ *
+ *              Only conversions that treat every element independently
+ *              are split: the library's hard numeric conversions and
+ *              byte-order swaps, with no conversion exception callback
+ *              set.  Each type conversion buffer is cut into blocks sized
+ *              to fit in the processor's L2 cache and the blocks are
+ *              handed out to a pool of worker threads, which is created
+ *              on first use and kept until the library shuts down.
+ *              Buffers too small to fill two blocks are converted by the
+ *              calling thread alone.
+ *
+ *              A value of 0 or 1 (the default) converts on the calling
+ *              thread only.  The setting is ignored if the library was
+ *              built without support for conversion threads.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_conv_threads(hid_t plist_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, nthreads);
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if (H5P_set(plist, H5D_XFER_CONV_THREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_conv_threads() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_conv_threads
+ *
+ * Purpose:	Reads values previously set with H5Pset_conv_threads().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_conv_threads(hid_t plist_id, unsigned *nthreads /*out*/)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nthreads);
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Return values */
+    if (nthreads)
+        if (H5P_get(plist, H5D_XFER_CONV_THREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_conv_threads() */
+
 /*-------------------------------------------------------------------------
  * Function:       H5P__dxfr_io_xfer_mode_enc
  *
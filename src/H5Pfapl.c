@@ -219,11 +219,24 @@
 #define H5F_ACS_START_MDC_LOG_ON_ACCESS_DEF  FALSE
 #define H5F_ACS_START_MDC_LOG_ON_ACCESS_ENC  H5P__encode_hbool_t
 #define H5F_ACS_START_MDC_LOG_ON_ACCESS_DEC  H5P__decode_hbool_t
+/* Definition for metadata cache log format property */
+#define H5F_ACS_MDC_LOG_FORMAT_SIZE sizeof(H5F_mdc_log_format_t)
+#define H5F_ACS_MDC_LOG_FORMAT_DEF  H5F_MDC_LOG_FORMAT_JSON
 /* Definition for evict on close property */
 #define H5F_ACS_EVICT_ON_CLOSE_FLAG_SIZE sizeof(hbool_t)
 #define H5F_ACS_EVICT_ON_CLOSE_FLAG_DEF  FALSE
 #define H5F_ACS_EVICT_ON_CLOSE_FLAG_ENC  H5P__encode_hbool_t
 #define H5F_ACS_EVICT_ON_CLOSE_FLAG_DEC  H5P__decode_hbool_t
+/* Definition for metadata cache serialize thread count property */
+#define H5F_ACS_MDC_SERIALIZE_THREADS_SIZE sizeof(unsigned)
+#define H5F_ACS_MDC_SERIALIZE_THREADS_DEF  1
+/* Definition for metadata cache access trace location property */
+#define H5F_ACS_MDC_ACCESS_TRACE_SIZE  sizeof(char *)
+#define H5F_ACS_MDC_ACCESS_TRACE_DEF   NULL /* default is no access trace */
+#define H5F_ACS_MDC_ACCESS_TRACE_DEL   H5P__facc_mdc_log_location_del
+#define H5F_ACS_MDC_ACCESS_TRACE_COPY  H5P__facc_mdc_log_location_copy
+#define H5F_ACS_MDC_ACCESS_TRACE_CMP   H5P__facc_mdc_log_location_cmp
+#define H5F_ACS_MDC_ACCESS_TRACE_CLOSE H5P__facc_mdc_log_location_close
 #ifdef H5_HAVE_PARALLEL
 /* Definition of collective metadata read mode flag */
 #define H5F_ACS_COLL_MD_READ_FLAG_SIZE sizeof(H5P_coll_md_read_flag_t)
@@ -484,8 +497,14 @@ static const hbool_t H5F_def_use_mdc_logging_g =
 static const char *  H5F_def_mdc_log_location_g = H5F_ACS_MDC_LOG_LOCATION_DEF; /* Default mdc log location */
 static const hbool_t H5F_def_start_mdc_log_on_access_g =
     H5F_ACS_START_MDC_LOG_ON_ACCESS_DEF; /* Default mdc log start on access flag */
+static const H5F_mdc_log_format_t H5F_def_mdc_log_format_g =
+    H5F_ACS_MDC_LOG_FORMAT_DEF; /* Default mdc log format */
 static const hbool_t H5F_def_evict_on_close_flag_g =
     H5F_ACS_EVICT_ON_CLOSE_FLAG_DEF; /* Default setting for evict on close property */
+static const unsigned H5F_def_mdc_serialize_threads_g =
+    H5F_ACS_MDC_SERIALIZE_THREADS_DEF; /* Default metadata cache serialize thread count */
+static const char *H5F_def_mdc_access_trace_g =
+    H5F_ACS_MDC_ACCESS_TRACE_DEF; /* Default metadata cache access trace location */
 #ifdef H5_HAVE_PARALLEL
 static const H5P_coll_md_read_flag_t H5F_def_coll_md_read_flag_g =
     H5F_ACS_COLL_MD_READ_FLAG_DEF; /* Default setting for the collective metedata read flag */
@@ -718,12 +737,37 @@ H5P__facc_reg_prop(H5P_genclass_t *pclass)
                            NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the metadata cache log format */
+    /* (Note: this property is not encoded, so that encoded FAPLs stay
+     *  readable by library versions without it)
+     */
+    if (H5P__register_real(pclass, H5F_ACS_MDC_LOG_FORMAT_NAME, H5F_ACS_MDC_LOG_FORMAT_SIZE,
+                           &H5F_def_mdc_log_format_g, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                           NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the evict on close flag */
     if (H5P__register_real(pclass, H5F_ACS_EVICT_ON_CLOSE_FLAG_NAME, H5F_ACS_EVICT_ON_CLOSE_FLAG_SIZE,
                            &H5F_def_evict_on_close_flag_g, NULL, NULL, NULL, H5F_ACS_EVICT_ON_CLOSE_FLAG_ENC,
                            H5F_ACS_EVICT_ON_CLOSE_FLAG_DEC, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the metadata cache serialize thread count */
+    /* (Note: this property is not encoded, so that encoded FAPLs stay
+     *  readable by library versions without it)
+     */
+    if (H5P__register_real(pclass, H5F_ACS_MDC_SERIALIZE_THREADS_NAME, H5F_ACS_MDC_SERIALIZE_THREADS_SIZE,
+                           &H5F_def_mdc_serialize_threads_g, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                           NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the metadata cache access trace location (not encoded either) */
+    if (H5P__register_real(pclass, H5F_ACS_MDC_ACCESS_TRACE_NAME, H5F_ACS_MDC_ACCESS_TRACE_SIZE,
+                           &H5F_def_mdc_access_trace_g, NULL, NULL, NULL, NULL, NULL,
+                           H5F_ACS_MDC_ACCESS_TRACE_DEL, H5F_ACS_MDC_ACCESS_TRACE_COPY,
+                           H5F_ACS_MDC_ACCESS_TRACE_CMP, H5F_ACS_MDC_ACCESS_TRACE_CLOSE) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 #ifdef H5_HAVE_PARALLEL
     /* Register the metadata collective read flag */
     if (H5P__register_real(pclass, H5_COLL_MD_READ_FLAG_NAME, H5F_ACS_COLL_MD_READ_FLAG_SIZE,
@@ -3058,6 +3102,11 @@ H5P__facc_cache_image_config_cmp(const void *_config1, const void *_config2, siz
     if (config1->entry_ageout > config2->entry_ageout)
         HGOTO_DONE(1);
 
+    if (config1->compress_image < config2->compress_image)
+        HGOTO_DONE(-1);
+    if (config1->compress_image > config2->compress_image)
+        HGOTO_DONE(1);
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__facc_cache_image_config_cmp() */
@@ -3100,10 +3149,12 @@ H5P__facc_cache_image_config_enc(const void *value, void **_pp, size_t *size)
         H5_ENCODE_UNSIGNED(*pp, config->save_resize_status);
 
         INT32ENCODE(*pp, (int32_t)config->entry_ageout);
+
+        *(*pp)++ = (uint8_t)config->compress_image;
     } /* end if */
 
     /* Compute encoded size of fixed-size values */
-    *size += (1 + (2 * sizeof(unsigned)) + (2 * sizeof(int32_t)));
+    *size += (2 + (2 * sizeof(unsigned)) + (2 * sizeof(int32_t)));
 
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* end H5P__facc_cache_image_config_enc() */
@@ -3155,6 +3206,8 @@ H5P__facc_cache_image_config_dec(const void **_pp, void *_value)
 
     INT32DECODE(*pp, config->entry_ageout);
 
+    config->compress_image = (hbool_t) * (*pp)++;
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__facc_cache_image_config_dec() */
@@ -3547,6 +3600,11 @@ H5P__facc_cache_config_cmp(const void *_config1, const void *_config2, size_t H5
     if (config1->metadata_write_strategy > config2->metadata_write_strategy)
         HGOTO_DONE(1);
 
+    if (config1->repl_policy < config2->repl_policy)
+        HGOTO_DONE(-1);
+    if (config1->repl_policy > config2->repl_policy)
+        HGOTO_DONE(1);
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__facc_cache_config_cmp() */
@@ -3675,6 +3733,9 @@ H5P__facc_cache_config_enc(const void *value, void **_pp, size_t *size)
 
         /* int */
         INT32ENCODE(*pp, (int32_t)config->metadata_write_strategy);
+
+        /* enum */
+        *(*pp)++ = (uint8_t)config->repl_policy;
     } /* end if */
 
     /* Compute encoded size of variably-encoded values */
@@ -3690,7 +3751,7 @@ H5P__facc_cache_config_enc(const void *value, void **_pp, size_t *size)
     *size += 1 + H5VM_limit_enc_size(enc_value);
 
     /* Compute encoded size of fixed-size values */
-    *size += (5 + (sizeof(unsigned) * 8) + (sizeof(double) * 8) + (sizeof(int32_t) * 4) + sizeof(int64_t) +
+    *size += (6 + (sizeof(unsigned) * 8) + (sizeof(double) * 8) + (sizeof(int32_t) * 4) + sizeof(int64_t) +
               H5AC__MAX_TRACE_FILE_NAME_LEN + 1);
 
     FUNC_LEAVE_NOAPI(SUCCEED)
@@ -3826,6 +3887,9 @@ H5P__facc_cache_config_dec(const void **_pp, void *_value)
     /* int */
     INT32DECODE(*pp, config->metadata_write_strategy);
 
+    /* enum */
+    config->repl_policy = (enum H5C_cache_repl_policy) * (*pp)++;
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__facc_cache_config_dec() */
@@ -4311,6 +4375,81 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_mdc_log_options() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_mdc_log_format
+ *
+ * Purpose:     Set the format of the metadata cache log enabled with
+ *              H5Pset_mdc_log_options().
+ *
+ *              H5F_MDC_LOG_FORMAT_JSON (the default) writes a JSON
+ *              message for each cache operation.  H5F_MDC_LOG_FORMAT_BINARY
+ *              writes fixed-size binary records from a background
+ *              thread, which is cheap enough to leave on in production,
+ *              and also records loads, flushes and evictions of single
+ *              entries.  The h5mdclog tool decodes binary logs.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_mdc_log_format(hid_t plist_id, H5F_mdc_log_format_t format)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iFl", plist_id, format);
+
+    /* Check arguments */
+    if (H5P_DEFAULT == plist_id)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "can't modify default property list")
+    if (format != H5F_MDC_LOG_FORMAT_JSON && format != H5F_MDC_LOG_FORMAT_BINARY)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid log format")
+
+    /* Get the property list structure */
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "plist_id is not a file access property list")
+
+    /* Set value */
+    if (H5P_set(plist, H5F_ACS_MDC_LOG_FORMAT_NAME, &format) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set log format")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_mdc_log_format() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_mdc_log_format
+ *
+ * Purpose:     Get the format of the metadata cache log.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_mdc_log_format(hid_t plist_id, H5F_mdc_log_format_t *format /*out*/)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, format);
+
+    /* Get the property list structure */
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "plist_id is not a file access property list")
+
+    /* Get value */
+    if (format)
+        if (H5P_get(plist, H5F_ACS_MDC_LOG_FORMAT_NAME, format) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get log format")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_mdc_log_format() */
+
 /*-------------------------------------------------------------------------
  * Function:       H5P__facc_mdc_log_location_enc
  *
@@ -4602,6 +4741,189 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_evict_on_close() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_mdc_serialize_threads
+ *
+ * Purpose:     Sets the number of threads (including the calling thread)
+ *              that may share the work of serializing the metadata cache's
+ *              dirty entries when a file is flushed.
+ *
+ *              On each pass over a ring of the cache, the entries that are
+ *              ready to be written (whose flush dependency children are
+ *              all clean) and whose client allows it are encoded and
+ *              checksummed on the worker thread pool, before they are
+ *              written in the usual order.  Everything else about the
+ *              flush stays on the calling thread.
+ *
+ *              A value of 0 or 1 (the default) serializes on the calling
+ *              thread only.  The setting is ignored if the library was
+ *              built without support for conversion threads, and for
+ *              files opened by more than one process with the MPI-IO
+ *              driver.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_mdc_serialize_threads(hid_t fapl_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", fapl_id, nthreads);
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Set value */
+    if (H5P_set(plist, H5F_ACS_MDC_SERIALIZE_THREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata cache serialize thread count")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_mdc_serialize_threads() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_mdc_serialize_threads
+ *
+ * Purpose:     Reads the value set with H5Pset_mdc_serialize_threads().
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_mdc_serialize_threads(hid_t fapl_id, unsigned *nthreads /*out*/)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", fapl_id, nthreads);
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Get value */
+    if (nthreads)
+        if (H5P_get(plist, H5F_ACS_MDC_SERIALIZE_THREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get metadata cache serialize thread count")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_mdc_serialize_threads() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_mdc_access_trace
+ *
+ * Purpose:     Sets the location of a file in which the metadata cache
+ *              keeps a trace of the metadata read when a file is opened
+ *              with this property list.
+ *
+ *              If there is no trace at LOCATION yet, or it was recorded
+ *              before the file last changed, the cache records the
+ *              class, address and length of each piece of metadata it
+ *              loads from the file, and writes them to LOCATION when the
+ *              file is closed.  Otherwise, the metadata in the trace is
+ *              read ahead with a few large reads right after the
+ *              superblock, so that the metadata touched as the file is
+ *              opened and accessed is already in memory.
+ *
+ *              A NULL or empty LOCATION (the default) keeps no trace.
+ *              The setting is ignored for SWMR readers, for files opened
+ *              through MPI, and for file drivers without vector I/O.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_mdc_access_trace(hid_t fapl_id, const char *location)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    char *          tmp_location = NULL;    /* Working location pointer */
+    herr_t          ret_value    = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*s", fapl_id, location);
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Make a copy of the passed-in location */
+    if (location && *location)
+        if (NULL == (tmp_location = H5MM_xstrdup(location)))
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTCOPY, FAIL, "can't copy passed-in access trace location")
+
+    /* Set value, releasing the previous location */
+    if (H5P_set(plist, H5F_ACS_MDC_ACCESS_TRACE_NAME, &tmp_location) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set access trace location")
+    tmp_location = NULL;
+
+done:
+    H5MM_xfree(tmp_location);
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_mdc_access_trace() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_mdc_access_trace
+ *
+ * Purpose:     Reads the location set with H5Pset_mdc_access_trace().
+ *
+ *              If LOCATION_SIZE is not NULL, it is set to the size of
+ *              the location, including the terminating NULL, or 0 if no
+ *              location is set.  If LOCATION is not NULL, at most
+ *              *LOCATION_SIZE bytes of the location are copied to it.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_mdc_access_trace(hid_t fapl_id, char *location /*out*/, size_t *location_size /*in,out*/)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    char *          location_ptr;        /* Pointer to location string */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "ix*z", fapl_id, location, location_size);
+
+    /* Check arguments */
+    if (location && !location_size)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "location_size cannot be NULL with location")
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Get the location */
+    if (H5P_peek(plist, H5F_ACS_MDC_ACCESS_TRACE_NAME, &location_ptr) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get access trace location")
+
+    /* Copy the location to the output buffer */
+    if (location && *location_size > 0) {
+        if (location_ptr)
+            HDstrncpy(location, location_ptr, *location_size);
+        else
+            *location = '\0';
+        location[*location_size - 1] = '\0';
+    } /* end if */
+
+    /* Get the location size, including the terminating NULL */
+    if (location_size)
+        *location_size = location_ptr ? HDstrlen(location_ptr) + 1 : 0;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_mdc_access_trace() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_file_locking
  *
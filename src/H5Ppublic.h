@@ -568,8 +568,15 @@ H5_DLL herr_t      H5Pset_mdc_log_options(hid_t plist_id, hbool_t is_enabled, co
                                           hbool_t start_on_access);
 H5_DLL herr_t      H5Pget_mdc_log_options(hid_t plist_id, hbool_t *is_enabled, char *location,
                                           size_t *location_size, hbool_t *start_on_access);
+H5_DLL herr_t      H5Pset_mdc_log_format(hid_t plist_id, H5F_mdc_log_format_t format);
+H5_DLL herr_t      H5Pget_mdc_log_format(hid_t plist_id, H5F_mdc_log_format_t *format /*out*/);
 H5_DLL herr_t      H5Pset_evict_on_close(hid_t fapl_id, hbool_t evict_on_close);
 H5_DLL herr_t      H5Pget_evict_on_close(hid_t fapl_id, hbool_t *evict_on_close);
+H5_DLL herr_t      H5Pset_mdc_serialize_threads(hid_t fapl_id, unsigned nthreads);
+H5_DLL herr_t      H5Pget_mdc_serialize_threads(hid_t fapl_id, unsigned *nthreads /*out*/);
+H5_DLL herr_t      H5Pset_mdc_access_trace(hid_t fapl_id, const char *location);
+H5_DLL herr_t      H5Pget_mdc_access_trace(hid_t fapl_id, char *location /*out*/,
+                                           size_t *location_size /*in,out*/);
 H5_DLL herr_t      H5Pset_file_locking(hid_t fapl_id, hbool_t use_file_locking, hbool_t ignore_when_disabled);
 H5_DLL herr_t H5Pget_file_locking(hid_t fapl_id, hbool_t *use_file_locking, hbool_t *ignore_when_disabled);
 #ifdef H5_HAVE_PARALLEL
@@ -1229,6 +1236,10 @@ H5_DLL herr_t    H5Pget_vlen_mem_manager(hid_t plist_id, H5MM_allocate_t *alloc_
                                          H5MM_free_t *free_func, void **free_info);
 H5_DLL herr_t    H5Pset_hyper_vector_size(hid_t fapl_id, size_t size);
 H5_DLL herr_t    H5Pget_hyper_vector_size(hid_t fapl_id, size_t *size /*out*/);
+H5_DLL herr_t    H5Pset_zero_copy_io(hid_t dxpl_id, hbool_t zero_copy);
+H5_DLL herr_t    H5Pget_zero_copy_io(hid_t dxpl_id, hbool_t *zero_copy /*out*/);
+H5_DLL herr_t    H5Pset_conv_threads(hid_t dxpl_id, unsigned nthreads);
+H5_DLL herr_t    H5Pget_conv_threads(hid_t dxpl_id, unsigned *nthreads /*out*/);
 H5_DLL herr_t    H5Pset_type_conv_cb(hid_t dxpl_id, H5T_conv_except_func_t op, void *operate_data);
 H5_DLL herr_t    H5Pget_type_conv_cb(hid_t dxpl_id, H5T_conv_except_func_t *op, void **operate_data);
 #ifdef H5_HAVE_PARALLEL
@@ -40,6 +40,33 @@
 /* Local Macros */
 /****************/
 
+/* Encode / decode an unsigned value in a variable number of bytes, seven
+ * bits per byte with the high bit set on all but the last byte.  (Used for
+ * version 4 span tree encoding)
+ */
+#define H5S_HYPER_ENCODE_VARINT(p, n)                                                                        \
+    {                                                                                                        \
+        hsize_t _n = (n);                                                                                    \
+                                                                                                             \
+        while (_n >= 0x80) {                                                                                 \
+            *(p)++ = (uint8_t)(_n | 0x80);                                                                   \
+            _n >>= 7;                                                                                        \
+        }                                                                                                    \
+        *(p)++ = (uint8_t)_n;                                                                                \
+    }
+#define H5S_HYPER_DECODE_VARINT(p, n)                                                                        \
+    {                                                                                                        \
+        unsigned _shift = 0;                                                                                 \
+        uint8_t  _b;                                                                                         \
+                                                                                                             \
+        (n) = 0;                                                                                             \
+        do {                                                                                                 \
+            _b = *(p)++;                                                                                     \
+            (n) |= (hsize_t)(_b & 0x7f) << _shift;                                                           \
+            _shift += 7;                                                                                     \
+        } while ((_b & 0x80) && _shift < 64);                                                                \
+    }
+
 /* Flags for which hyperslab fragments to compute */
 #define H5S_HYPER_COMPUTE_B_NOT_A 0x01
 #define H5S_HYPER_COMPUTE_A_AND_B 0x02
@@ -123,6 +150,10 @@ static herr_t H5S__hyper_span_blocklist(const H5S_hyper_span_info_t *spans, hsiz
                                         hsize_t rank, hsize_t *startblock, hsize_t *numblocks, hsize_t **buf);
 static herr_t H5S__get_select_hyper_blocklist(H5S_t *space, hsize_t startblock, hsize_t numblocks,
                                               hsize_t *buf);
+static size_t H5S__hyper_varint_size(hsize_t n);
+static size_t H5S__hyper_span_tree_serial_size(const H5S_hyper_span_info_t *spans, unsigned rank);
+static void   H5S__hyper_serialize_span_tree(const H5S_hyper_span_info_t *spans, unsigned rank, uint8_t **p);
+static H5S_hyper_span_info_t *H5S__hyper_deserialize_span_tree(unsigned rank, const uint8_t **p);
 static H5S_hyper_span_t *H5S__hyper_coord_to_span(unsigned rank, const hsize_t *coords);
 static herr_t  H5S__hyper_append_span(H5S_hyper_span_info_t **span_tree, unsigned ndims, hsize_t low,
                                       hsize_t high, H5S_hyper_span_info_t *down);
@@ -243,7 +274,7 @@ const unsigned H5O_sds_hyper_ver_bounds[] = {
     H5S_HYPER_VERSION_1, /* H5F_LIBVER_V18 */
     H5S_HYPER_VERSION_2, /* H5F_LIBVER_V110 */
     H5S_HYPER_VERSION_3, /* H5F_LIBVER_V112 */
-    H5S_HYPER_VERSION_3  /* H5F_LIBVER_LATEST */
+    H5S_HYPER_VERSION_4  /* H5F_LIBVER_LATEST */
 };
 
 /*******************/
@@ -3561,6 +3592,8 @@ H5S__hyper_get_enc_size_real(hsize_t max_size)
     (2) whether the number of blocks or selection high bounds exceeds H5S_UINT32_MAX or not
 
     Determine the encoded size based on version:
+    For version 4 (irregular hyperslabs only), the encoded size is 0, since
+    the span tree is stored with variable-length coordinates.
     For version 3, the encoded size is determined according to:
     (a) regular hyperslab
         (1) The maximum needed to store start/stride/count/block
@@ -3626,6 +3659,10 @@ H5S__hyper_get_version_enc_size(const H5S_t *space, hsize_t block_count, uint32_
                 (is_regular && block_count >= 4) ? H5O_sds_hyper_ver_bounds[low_bound] : H5S_HYPER_VERSION_1;
     } /* end else */
 
+    /* Version 4 only changes the encoding of irregular hyperslabs */
+    if (tmp_version == H5S_HYPER_VERSION_4 && is_regular)
+        tmp_version = H5S_HYPER_VERSION_3;
+
     /* Version bounds check */
     if (tmp_version > H5O_sds_hyper_ver_bounds[high_bound]) {
         /* Fail for irregular hyperslab if exceeds 32 bits */
@@ -3699,6 +3736,12 @@ H5S__hyper_get_version_enc_size(const H5S_t *space, hsize_t block_count, uint32_
             } /* end else */
             break;
 
+        case H5S_HYPER_VERSION_4:
+            /* Span tree coordinates are stored as variable-length deltas */
+            HDassert(!is_regular);
+            *enc_size = 0;
+            break;
+
         default:
             HGOTO_ERROR(H5E_DATASPACE, H5E_UNSUPPORTED, FAIL, "unknown hyperslab selection version")
             break;
@@ -3747,7 +3790,20 @@ H5S__hyper_serial_size(const H5S_t *space)
     if (H5S__hyper_get_version_enc_size(space, block_count, &version, &enc_size) < 0)
         HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't determine hyper version & enc_size")
 
-    if (version == H5S_HYPER_VERSION_3) {
+    if (version == H5S_HYPER_VERSION_4) {
+        /* Version 4: irregular */
+        /* Size required is:
+         * <type (4 bytes)> + <version (4 bytes)> + <flags (1 byte)> +
+         * <size of offset info (1 byte)> + <rank (4 bytes)> +
+         * <encoded span tree> =
+         * 14 bytes + span tree bytes
+         */
+        HDassert(space->select.sel_info.hslab->span_lst);
+        ret_value = (hssize_t)14 +
+                    (hssize_t)H5S__hyper_span_tree_serial_size(space->select.sel_info.hslab->span_lst,
+                                                               space->extent.rank);
+    } /* end if */
+    else if (version == H5S_HYPER_VERSION_3) {
         /* Version 3: regular */
         /* Size required is always:
          * <type (4 bytes)> + <version (4 bytes)> + <flags (1 byte)> +
@@ -3770,7 +3826,7 @@ H5S__hyper_serial_size(const H5S_t *space)
             H5_CHECK_OVERFLOW(((unsigned)2 * enc_size * space->extent.rank * block_count), hsize_t, hssize_t);
             ret_value += (hssize_t)((unsigned)2 * enc_size * space->extent.rank * block_count);
         } /* end else */
-    }     /* end if */
+    }     /* end else-if */
     else if (version == H5S_HYPER_VERSION_2) {
         /* Version 2 */
         /* Size required is always:
@@ -3921,6 +3977,166 @@ H5S__hyper_serialize_helper(const H5S_hyper_span_info_t *spans, hsize_t *start,
     FUNC_LEAVE_NOAPI_VOID
 } /* end H5S__hyper_serialize_helper() */
 
+/*--------------------------------------------------------------------------
+ NAME
+    H5S__hyper_varint_size
+ PURPOSE
+    Determine the number of bytes H5S_HYPER_ENCODE_VARINT() uses for a value
+ USAGE
+    size_t H5S__hyper_varint_size(n)
+        hsize_t n;              IN: Value to query
+ RETURNS
+    The number of bytes required
+ DESCRIPTION
+    One byte for every seven significant bits, and at least one byte.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static size_t
+H5S__hyper_varint_size(hsize_t n)
+{
+    size_t ret_value = 1; /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    while (n >= 0x80) {
+        n >>= 7;
+        ret_value++;
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S__hyper_varint_size() */
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S__hyper_span_tree_serial_size
+ PURPOSE
+    Determine the number of bytes needed to store a span tree in the
+    version 4 hyperslab selection encoding.
+ USAGE
+    size_t H5S__hyper_span_tree_serial_size(spans, rank)
+        const H5S_hyper_span_info_t *spans; IN: Span tree to query
+        unsigned rank;                      IN: # of dimensions in span tree
+ RETURNS
+    The number of bytes required
+ DESCRIPTION
+    Mirrors H5S__hyper_serialize_span_tree(), without writing anything.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static size_t
+H5S__hyper_span_tree_serial_size(const H5S_hyper_span_info_t *spans, unsigned rank)
+{
+    const H5S_hyper_span_t *curr;             /* Pointer to current hyperslab span */
+    const H5S_hyper_span_t *prev      = NULL; /* Pointer to previous hyperslab span */
+    hsize_t                 next_low  = 0;    /* Lowest possible start of the next span */
+    hsize_t                 nspans    = 0;    /* # of spans in this dimension */
+    size_t                  ret_value = 0;    /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(spans);
+    HDassert(rank > 0);
+
+    for (curr = spans->head; curr != NULL; prev = curr, curr = curr->next) {
+        /* Offset from the end of the previous span & length of this span */
+        ret_value += H5S__hyper_varint_size(curr->low - next_low);
+        ret_value += H5S__hyper_varint_size(curr->high - curr->low);
+
+        /* Down span flag, followed by the down spans if they differ from
+         * the previous span's down spans
+         */
+        if (rank > 1) {
+            ret_value++;
+            if (NULL == prev || !H5S__hyper_cmp_spans(curr->down, prev->down))
+                ret_value += H5S__hyper_span_tree_serial_size(curr->down, rank - 1);
+        } /* end if */
+
+        next_low = curr->high + 1;
+        nspans++;
+    } /* end for */
+
+    /* # of spans */
+    ret_value += H5S__hyper_varint_size(nspans);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S__hyper_span_tree_serial_size() */
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S__hyper_serialize_span_tree
+ PURPOSE
+    Serialize a span tree with the version 4 hyperslab selection encoding.
+ USAGE
+    void H5S__hyper_serialize_span_tree(spans, rank, p)
+        const H5S_hyper_span_info_t *spans; IN: Span tree to serialize
+        unsigned rank;                      IN: # of dimensions in span tree
+        uint8_t **p;                        IN/OUT: Buffer to put serialized
+                                            span tree into
+ RETURNS
+    None
+ DESCRIPTION
+    Each list of spans is stored as the number of spans, followed by a
+    (gap, length - 1) pair per span, where the gap is measured from the end
+    of the previous span in the list.  For spans with down spans, a flag
+    byte follows: 1 if the down span tree is stored next, 0 if the span
+    uses the same down span tree as the previous span in the list.  All
+    values are stored with H5S_HYPER_ENCODE_VARINT(), so small gaps and
+    lengths take a single byte, no matter how far into the extent they are.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static void
+H5S__hyper_serialize_span_tree(const H5S_hyper_span_info_t *spans, unsigned rank, uint8_t **p)
+{
+    const H5S_hyper_span_t *curr;            /* Pointer to current hyperslab span */
+    const H5S_hyper_span_t *prev     = NULL; /* Pointer to previous hyperslab span */
+    hsize_t                 next_low = 0;    /* Lowest possible start of the next span */
+    hsize_t                 nspans   = 0;    /* # of spans in this dimension */
+    uint8_t *               pp       = (*p); /* Local pointer for encoding */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(spans);
+    HDassert(rank > 0);
+    HDassert(p && pp);
+
+    /* Encode the # of spans */
+    for (curr = spans->head; curr != NULL; curr = curr->next)
+        nspans++;
+    H5S_HYPER_ENCODE_VARINT(pp, nspans);
+
+    /* Encode the spans */
+    for (curr = spans->head; curr != NULL; prev = curr, curr = curr->next) {
+        H5S_HYPER_ENCODE_VARINT(pp, curr->low - next_low);
+        H5S_HYPER_ENCODE_VARINT(pp, curr->high - curr->low);
+
+        if (rank > 1) {
+            if (NULL != prev && H5S__hyper_cmp_spans(curr->down, prev->down))
+                *pp++ = 0;
+            else {
+                *pp++ = 1;
+                H5S__hyper_serialize_span_tree(curr->down, rank - 1, &pp);
+            } /* end else */
+        }     /* end if */
+
+        next_low = curr->high + 1;
+    } /* end for */
+
+    /* Update encoding pointer */
+    *p = pp;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5S__hyper_serialize_span_tree() */
+
 /*--------------------------------------------------------------------------
  NAME
     H5S__hyper_serialize
@@ -4150,7 +4366,9 @@ H5S__hyper_serialize(const H5S_t *space, uint8_t **p)
             } /* end while */
         }     /* end else */
     }         /* end if */
-    else {    /* irregular */
+    else if (version == H5S_HYPER_VERSION_4) /* irregular, as span tree */
+        H5S__hyper_serialize_span_tree(space->select.sel_info.hslab->span_lst, ndims, &pp);
+    else { /* irregular */
         /* Encode number of hyperslabs */
         switch (enc_size) {
             case H5S_SELECT_INFO_ENC_SIZE_2:
@@ -4198,6 +4416,128 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5S__hyper_serialize() */
 
+/*--------------------------------------------------------------------------
+ NAME
+    H5S__hyper_deserialize_span_tree
+ PURPOSE
+    Rebuild a span tree from the version 4 hyperslab selection encoding.
+ USAGE
+    H5S_hyper_span_info_t *H5S__hyper_deserialize_span_tree(rank, p)
+        unsigned rank;          IN: # of dimensions in span tree
+        const uint8_t **p;      IN/OUT: Pointer to buffer holding serialized
+                                span tree.  Will be advanced past it.
+ RETURNS
+    Pointer to new span tree (with a reference count of 1) on success,
+    NULL on failure
+ DESCRIPTION
+    Decodes the format written by H5S__hyper_serialize_span_tree(), sharing
+    down span trees between spans the same way the encoder found them.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static H5S_hyper_span_info_t *
+H5S__hyper_deserialize_span_tree(unsigned rank, const uint8_t **p)
+{
+    H5S_hyper_span_info_t *spans    = NULL;  /* New span tree */
+    H5S_hyper_span_info_t *down     = NULL;  /* Down span tree for current span */
+    H5S_hyper_span_t *     span;             /* New span */
+    const uint8_t *        pp       = (*p);  /* Local pointer for decoding */
+    hsize_t                next_low = 0;     /* Lowest possible start of the next span */
+    hsize_t                nspans;           /* # of spans in this dimension */
+    hsize_t                u;                /* Local index variable */
+    unsigned               v;                /* Local index variable */
+    H5S_hyper_span_info_t *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(rank > 0);
+    HDassert(pp);
+
+    /* Decode the # of spans */
+    H5S_HYPER_DECODE_VARINT(pp, nspans);
+    if (0 == nspans)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, NULL, "empty span list in serialized selection")
+
+    /* Allocate the span tree for this dimension */
+    if (NULL == (spans = H5S__hyper_new_span_info(rank)))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, NULL, "can't allocate hyperslab span info")
+    spans->count = 1;
+
+    for (u = 0; u < nspans; u++) {
+        hsize_t gap, len; /* Encoded span information */
+        hsize_t low;      /* Low bound of span */
+
+        /* Decode the span */
+        H5S_HYPER_DECODE_VARINT(pp, gap);
+        H5S_HYPER_DECODE_VARINT(pp, len);
+        if (gap > H5S_MAX_SIZE - next_low || len > H5S_MAX_SIZE - (next_low + gap))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, NULL, "span out of range in serialized selection")
+        low = next_low + gap;
+
+        /* Get the down spans, holding a reference to them */
+        if (rank > 1) {
+            if (*pp++) {
+                if (NULL == (down = H5S__hyper_deserialize_span_tree(rank - 1, &pp)))
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDECODE, NULL, "can't decode down spans")
+            } /* end if */
+            else {
+                if (NULL == spans->tail)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, NULL,
+                                "no previous down spans to share in serialized selection")
+                down = spans->tail->down;
+                down->count++;
+            } /* end else */
+        }     /* end if */
+
+        /* Append the new span */
+        if (NULL == (span = H5S__hyper_new_span(low, low + len, down, NULL)))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, NULL, "can't allocate hyperslab span")
+        if (spans->tail)
+            spans->tail->next = span;
+        else
+            spans->head = span;
+        spans->tail = span;
+
+        /* Update the bounds of the span tree */
+        if (0 == u)
+            spans->low_bounds[0] = low;
+        spans->high_bounds[0] = low + len;
+        if (down) {
+            for (v = 0; v < (rank - 1); v++) {
+                if (0 == u || down->low_bounds[v] < spans->low_bounds[v + 1])
+                    spans->low_bounds[v + 1] = down->low_bounds[v];
+                if (0 == u || down->high_bounds[v] > spans->high_bounds[v + 1])
+                    spans->high_bounds[v + 1] = down->high_bounds[v];
+            } /* end for */
+
+            /* Drop our reference, now that the span holds one */
+            down->count--;
+            down = NULL;
+        } /* end if */
+
+        next_low = low + len + 1;
+    } /* end for */
+
+    /* Update decoding pointer */
+    *p = pp;
+
+    /* Set return value */
+    ret_value = spans;
+
+done:
+    if (NULL == ret_value) {
+        if (down)
+            H5S__hyper_free_span_info(down);
+        if (spans)
+            H5S__hyper_free_span_info(spans);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S__hyper_deserialize_span_tree() */
+
 /*--------------------------------------------------------------------------
  NAME
     H5S__hyper_deserialize
@@ -4367,6 +4707,41 @@ H5S__hyper_deserialize(H5S_t **space, const uint8_t **p)
         if ((ret_value = H5S_select_hyperslab(tmp_space, H5S_SELECT_SET, start, stride, count, block)) < 0)
             HGOTO_ERROR(H5E_DATASPACE, H5E_CANTSET, FAIL, "can't change selection")
     } /* end if */
+    else if (version >= H5S_HYPER_VERSION_4) {
+        H5S_hyper_span_info_t *span_lst; /* Decoded span tree */
+
+        /* Rebuild the span tree directly */
+        if (0 == rank)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "hyperslab selection of rank 0")
+        if (NULL == (span_lst = H5S__hyper_deserialize_span_tree(rank, &pp)))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDECODE, FAIL, "can't decode hyperslab span tree")
+
+        /* Remove current selection */
+        if (H5S_SELECT_RELEASE(tmp_space) < 0) {
+            H5S__hyper_free_span_info(span_lst);
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDELETE, FAIL, "can't release selection")
+        } /* end if */
+
+        /* Allocate space for the hyperslab selection information (note this sets
+         * diminfo_valid to FALSE, diminfo arrays to 0, and span list to NULL) */
+        if (NULL == (tmp_space->select.sel_info.hslab = H5FL_CALLOC(H5S_hyper_sel_t))) {
+            H5S__hyper_free_span_info(span_lst);
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, FAIL, "can't allocate hyperslab info")
+        } /* end if */
+
+        /* Set up the selection */
+        tmp_space->select.type                      = H5S_sel_hyper;
+        tmp_space->select.sel_info.hslab->unlim_dim = -1;
+        tmp_space->select.sel_info.hslab->span_lst  = span_lst;
+        tmp_space->select.num_elem                  = H5S__hyper_spans_nelem(span_lst);
+
+        /* Attempt to build "optimized" start/stride/count/block information
+         * from resulting hyperslab span tree.
+         */
+        H5S__hyper_rebuild(tmp_space);
+
+        ret_value = SUCCEED;
+    } /* end else-if */
     else {
         const hsize_t *stride;            /* Hyperslab stride information */
         const hsize_t *count;             /* Hyperslab count information */
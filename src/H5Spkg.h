@@ -44,7 +44,8 @@
 #define H5S_HYPER_VERSION_1      1
 #define H5S_HYPER_VERSION_2      2
 #define H5S_HYPER_VERSION_3      3
-#define H5S_HYPER_VERSION_LATEST H5S_HYPER_VERSION_3
+#define H5S_HYPER_VERSION_4      4 /* Irregular selections encoded as a span tree */
+#define H5S_HYPER_VERSION_LATEST H5S_HYPER_VERSION_4
 
 /* Versions for H5S_SEL_POINTS selection info */
 #define H5S_POINT_VERSION_1      1
@@ -48,6 +48,12 @@
 
 #define H5T_ENCODE_VERSION 0
 
+/* Combine the hashes of a conversion path's source and destination types */
+#define H5T_PATH_HASH(S, D) (((S)*0x9e3779b1U) ^ (D))
+
+/* Minimum number of slots in the conversion path index */
+#define H5T_PATH_INDEX_MIN 256
+
 /*
  * Type initialization macros
  *
@@ -349,6 +355,10 @@ static herr_t H5T__set_size(H5T_t *dt, size_t size);
 static herr_t H5T__close_cb(H5T_t *dt, void **request);
 static H5T_path_t *H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name,
                                        H5T_conv_func_t *conv);
+static H5T_path_t *H5T__path_lookup(const H5T_t *src, const H5T_t *dst, uint32_t hash);
+static void        H5T__path_index_insert(H5T_path_t *path);
+static void        H5T__path_index_replace(H5T_path_t *old_path, H5T_path_t *new_path);
+static void        H5T__path_index_fill(void);
 static hbool_t     H5T__detect_vlen_ref(const H5T_t *dt);
 static H5T_t *     H5T__initiate_copy(const H5T_t *old_dt);
 static H5T_t *     H5T__copy_transient(H5T_t *old_dt);
@@ -583,12 +593,16 @@ const unsigned H5O_dtype_ver_bounds[] = {
 
 /*
  * The path database. Each path has a source and destination data type pair
- * which is used as the key by which the `entries' array is sorted.
+ * which is used as the key by which paths are looked up in the `index' hash
+ * table.  The first entry of the `path' array is always the no-op path, which
+ * isn't in the index.
  */
 static struct {
     int          npaths; /*number of paths defined               */
     size_t       apaths; /*number of paths allocated             */
-    H5T_path_t **path;   /*sorted array of path pointers         */
+    H5T_path_t **path;   /*array of path pointers, in creation order */
+    size_t       nslots; /*number of slots in index (power of two) */
+    H5T_path_t **index;  /*open-addressed hash index of paths    */
     int          nsoft;  /*number of soft conversions defined    */
     size_t       asoft;  /*number of soft conversions allocated  */
     H5T_soft_t * soft;   /*unsorted array of soft conversions    */
@@ -1597,6 +1611,8 @@ H5T_top_term_package(void)
             H5T_g.path   = (H5T_path_t **)H5MM_xfree(H5T_g.path);
             H5T_g.npaths = 0;
             H5T_g.apaths = 0;
+            H5T_g.index  = (H5T_path_t **)H5MM_xfree(H5T_g.index);
+            H5T_g.nslots = 0;
             H5T_g.soft   = (H5T_soft_t *)H5MM_xfree(H5T_g.soft);
             H5T_g.nsoft  = 0;
             H5T_g.asoft  = 0;
@@ -1758,8 +1774,17 @@ H5T_term_package(void)
         n += (H5I_dec_type_ref(H5I_DATATYPE) > 0);
 
         /* Mark interface as closed */
-        if (0 == n)
+        if (0 == n) {
+#ifdef H5_HAVE_CONV_THREADS
+            /* Stop the worker threads, which the metadata cache may use
+             * while the files are closed, after the "top" of the interface
+             * has been shut down.
+             */
+            H5T__pool_term();
+#endif /* H5_HAVE_CONV_THREADS */
+
             H5_PKG_INIT_VAR = FALSE;
+        } /* end if */
     } /* end if */
 
     FUNC_LEAVE_NOAPI(n)
@@ -2625,8 +2650,10 @@ H5T__register(H5T_pers_t pers, const char *name, H5T_t *src, H5T_t *dst, H5T_con
             new_path->conv    = *conv;
             new_path->is_hard = FALSE;
             new_path->cdata   = cdata;
+            new_path->hash    = old_path->hash;
 
             /* Replace previous path */
+            H5T__path_index_replace(old_path, new_path);
             H5T_g.path[i] = new_path;
             new_path      = NULL; /*so we don't free it on error*/
 
@@ -2759,10 +2786,11 @@ done:
 static herr_t
 H5T__unregister(H5T_pers_t pers, const char *name, H5T_t *src, H5T_t *dst, H5T_conv_t func)
 {
-    H5T_path_t *path   = NULL; /*conversion path             */
-    H5T_soft_t *soft   = NULL; /*soft conversion information */
-    int         nprint = 0;    /*number of paths shut down   */
-    int         i;             /*counter                     */
+    H5T_path_t *path       = NULL;         /*conversion path             */
+    H5T_soft_t *soft       = NULL;         /*soft conversion information */
+    int         old_npaths = H5T_g.npaths; /*number of paths before removal */
+    int         nprint     = 0;            /*number of paths shut down   */
+    int         i;                         /*counter                     */
 
     FUNC_ENTER_STATIC_NOERR
 
@@ -2842,6 +2870,10 @@ H5T__unregister(H5T_pers_t pers, const char *name, H5T_t *src, H5T_t *dst, H5T_c
         }                          /* end else */
     }                              /* end for */
 
+    /* Drop the removed paths from the hash index */
+    if (H5T_g.npaths != old_npaths)
+        H5T__path_index_fill();
+
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* end H5T__unregister() */
 
@@ -3432,6 +3464,9 @@ H5T__initiate_copy(const H5T_t *old_dt)
     new_dt->vol_obj               = NULL;
     new_dt->shared->owned_vol_obj = NULL;
 
+    /* The copy may be modified, so don't keep the cached hash */
+    new_dt->shared->hash_valid = FALSE;
+
     /* Set return value */
     ret_value = new_dt;
 
@@ -3920,6 +3955,9 @@ H5T_lock(H5T_t *dt, hbool_t immutable)
             HGOTO_ERROR(H5E_DATATYPE, H5E_BADTYPE, FAIL, "invalid datatype state")
     }
 
+    /* Cache the datatype's hash, now that it can't be modified */
+    (void)H5T__hash(dt);
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 }
@@ -4324,8 +4362,9 @@ H5T__set_size(H5T_t *dt, size_t size)
                     dt->shared->u.vlen.type = H5T_VLEN_STRING;
 
                     /* Set character set and padding information */
-                    dt->shared->u.vlen.cset = tmp_cset;
-                    dt->shared->u.vlen.pad  = tmp_strpad;
+                    dt->shared->u.vlen.cset        = tmp_cset;
+                    dt->shared->u.vlen.pad         = tmp_strpad;
+                    dt->shared->u.vlen.inline_size = 0;
 
                     /* Set up VL information */
                     if (H5T_set_loc(dt, NULL, H5T_LOC_MEMORY) < 0)
@@ -4703,6 +4742,12 @@ H5T_cmp(const H5T_t *dt1, const H5T_t *dt2, hbool_t superset)
                 HGOTO_DONE(1);
             }
 
+            /* Sort VL strings by the length of the longest string stored inline */
+            if (dt1->shared->u.vlen.inline_size < dt2->shared->u.vlen.inline_size)
+                HGOTO_DONE(-1);
+            if (dt1->shared->u.vlen.inline_size > dt2->shared->u.vlen.inline_size)
+                HGOTO_DONE(1);
+
             /* Don't allow VL types in different files to compare as equal */
             if (dt1->shared->u.vlen.file < dt2->shared->u.vlen.file)
                 HGOTO_DONE(-1);
@@ -4878,6 +4923,269 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T_cmp() */
 
+/*-------------------------------------------------------------------------
+ * Function:  H5T__hash
+ *
+ * Purpose:   Computes a structural hash of a datatype, used to index the
+ *            conversion path table.  Datatypes which H5T_cmp() reports as
+ *            equal always hash to the same value: compound and enumerated
+ *            type members are combined independently of their order, and
+ *            fields which H5T_cmp() doesn't compare symmetrically (the
+ *            opaque tag and the VL location and file) are left out.
+ *
+ *            The hash of a datatype which can no longer be modified is
+ *            cached in the datatype.  Changing its location with
+ *            H5T_set_loc() discards the cached value.
+ *
+ * Return:    The hash value (never fails)
+ *
+ *-------------------------------------------------------------------------
+ */
+uint32_t
+H5T__hash(const H5T_t *dt)
+{
+    H5T_shared_t *shared = dt->shared; /* Shared datatype info */
+    uint32_t      key[20];             /* Fields to hash */
+    size_t        nkey = 0;            /* Number of fields to hash */
+    uint32_t      memb_hash;           /* Combined hash of compound or enum members */
+    unsigned      u;                   /* Local index variable */
+    uint32_t      ret_value = 0;       /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity check */
+    HDassert(dt);
+    HDassert(shared);
+
+    /* Use the cached value, if there is one */
+    if (shared->hash_valid)
+        HGOTO_DONE(shared->hash)
+
+    key[nkey++] = (uint32_t)shared->type;
+    key[nkey++] = (uint32_t)shared->size;
+    if (shared->parent)
+        key[nkey++] = H5T__hash(shared->parent);
+
+    switch (shared->type) {
+        case H5T_COMPOUND:
+            key[nkey++] = shared->u.compnd.nmembs;
+            for (u = 0, memb_hash = 0; u < shared->u.compnd.nmembs; u++) {
+                const H5T_cmemb_t *memb = &shared->u.compnd.memb[u];
+                uint32_t           memb_key[4];
+
+                memb_key[0] = H5_hash_string(memb->name);
+                memb_key[1] = (uint32_t)memb->offset;
+                memb_key[2] = (uint32_t)memb->size;
+                memb_key[3] = H5T__hash(memb->type);
+                memb_hash += H5_checksum_lookup3(memb_key, sizeof(memb_key), 0);
+            } /* end for */
+            key[nkey++] = memb_hash;
+            break;
+
+        case H5T_ENUM: {
+            size_t base_size = shared->parent->shared->size;
+
+            key[nkey++] = shared->u.enumer.nmembs;
+            for (u = 0, memb_hash = 0; u < shared->u.enumer.nmembs; u++)
+                memb_hash += H5_checksum_lookup3((const uint8_t *)shared->u.enumer.value + u * base_size,
+                                                 base_size, H5_hash_string(shared->u.enumer.name[u]));
+            key[nkey++] = memb_hash;
+        } break;
+
+        case H5T_VLEN:
+            key[nkey++] = (uint32_t)shared->u.vlen.type;
+            key[nkey++] = (uint32_t)shared->u.vlen.inline_size;
+            break;
+
+        case H5T_ARRAY:
+            key[nkey++] = shared->u.array.ndims;
+            key[nkey++] = H5_checksum_lookup3(shared->u.array.dim, shared->u.array.ndims * sizeof(size_t), 0);
+            break;
+
+        case H5T_OPAQUE:
+            break;
+
+        case H5T_NO_CLASS:
+        case H5T_INTEGER:
+        case H5T_FLOAT:
+        case H5T_TIME:
+        case H5T_STRING:
+        case H5T_BITFIELD:
+        case H5T_REFERENCE:
+        case H5T_NCLASSES:
+        default:
+            key[nkey++] = (uint32_t)shared->u.atomic.order;
+            key[nkey++] = (uint32_t)shared->u.atomic.prec;
+            key[nkey++] = (uint32_t)shared->u.atomic.offset;
+            key[nkey++] = (uint32_t)shared->u.atomic.lsb_pad;
+            key[nkey++] = (uint32_t)shared->u.atomic.msb_pad;
+
+            if (H5T_INTEGER == shared->type)
+                key[nkey++] = (uint32_t)shared->u.atomic.u.i.sign;
+            else if (H5T_FLOAT == shared->type) {
+                key[nkey++] = (uint32_t)shared->u.atomic.u.f.sign;
+                key[nkey++] = (uint32_t)shared->u.atomic.u.f.epos;
+                key[nkey++] = (uint32_t)shared->u.atomic.u.f.esize;
+                key[nkey++] = (uint32_t)shared->u.atomic.u.f.ebias;
+                key[nkey++] = (uint32_t)shared->u.atomic.u.f.mpos;
+                key[nkey++] = (uint32_t)shared->u.atomic.u.f.msize;
+                key[nkey++] = (uint32_t)shared->u.atomic.u.f.norm;
+                key[nkey++] = (uint32_t)shared->u.atomic.u.f.pad;
+            } /* end if */
+            else if (H5T_STRING == shared->type) {
+                key[nkey++] = (uint32_t)shared->u.atomic.u.s.cset;
+                key[nkey++] = (uint32_t)shared->u.atomic.u.s.pad;
+            } /* end else-if */
+            else if (H5T_REFERENCE == shared->type) {
+                key[nkey++] = (uint32_t)shared->u.atomic.u.r.rtype;
+                key[nkey++] = (uint32_t)shared->u.atomic.u.r.loc;
+            } /* end else-if */
+            break;
+    } /* end switch */
+    HDassert(nkey <= NELMTS(key));
+
+    ret_value = H5_checksum_lookup3(key, nkey * sizeof(uint32_t), 0);
+
+    /* Cache the value if the datatype can't be modified any more */
+    if (shared->state != H5T_STATE_TRANSIENT) {
+        shared->hash       = ret_value;
+        shared->hash_valid = TRUE;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__hash() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__path_lookup
+ *
+ * Purpose:     Looks up the conversion path from SRC to DST in the path
+ *              table's hash index.  HASH is the combined hash of the two
+ *              types, from H5T_PATH_HASH().  The types of paths with a
+ *              matching hash are compared with H5T_cmp(), to rule out
+ *              collisions.
+ *
+ * Return:      Success:    Pointer to the path
+ *
+ *              Failure:    NULL if there's no such path (never fails)
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_path_t *
+H5T__path_lookup(const H5T_t *src, const H5T_t *dst, uint32_t hash)
+{
+    size_t      mask;             /* Mask for wrapping slot numbers */
+    size_t      u;                /* Slot number */
+    H5T_path_t *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if (H5T_g.nslots > 0) {
+        mask = H5T_g.nslots - 1;
+        for (u = hash & mask; H5T_g.index[u]; u = (u + 1) & mask) {
+            H5T_path_t *path = H5T_g.index[u];
+
+            if (path->hash == hash && 0 == H5T_cmp(src, path->src, FALSE) &&
+                0 == H5T_cmp(dst, path->dst, FALSE))
+                HGOTO_DONE(path)
+        } /* end for */
+    }     /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__path_lookup() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__path_index_insert
+ *
+ * Purpose:     Adds PATH to the path table's hash index, which must have
+ *              a free slot.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__path_index_insert(H5T_path_t *path)
+{
+    size_t mask = H5T_g.nslots - 1; /* Mask for wrapping slot numbers */
+    size_t u;                       /* Slot number */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(path);
+    HDassert(H5T_g.nslots > 0);
+
+    for (u = path->hash & mask; H5T_g.index[u]; u = (u + 1) & mask)
+        HDassert(H5T_g.index[u] != path);
+    H5T_g.index[u] = path;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__path_index_insert() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__path_index_replace
+ *
+ * Purpose:     Replaces OLD_PATH with NEW_PATH, which converts between the
+ *              same types, in the path table's hash index.  Nothing is
+ *              done if OLD_PATH isn't in the index (i.e. the no-op path).
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__path_index_replace(H5T_path_t *old_path, H5T_path_t *new_path)
+{
+    size_t mask; /* Mask for wrapping slot numbers */
+    size_t u;    /* Slot number */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(old_path);
+    HDassert(new_path);
+    HDassert(old_path->hash == new_path->hash);
+
+    if (H5T_g.nslots > 0) {
+        mask = H5T_g.nslots - 1;
+        for (u = old_path->hash & mask; H5T_g.index[u]; u = (u + 1) & mask)
+            if (H5T_g.index[u] == old_path) {
+                H5T_g.index[u] = new_path;
+                break;
+            } /* end if */
+    }         /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__path_index_replace() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__path_index_fill
+ *
+ * Purpose:     Rebuilds the path table's hash index from the array of
+ *              paths, after the index is resized or paths are removed.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__path_index_fill(void)
+{
+    int i; /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if (H5T_g.nslots > 0) {
+        HDassert(2 * (size_t)H5T_g.npaths <= H5T_g.nslots);
+
+        HDmemset(H5T_g.index, 0, H5T_g.nslots * sizeof(H5T_path_t *));
+        for (i = 1; i < H5T_g.npaths; i++)
+            H5T__path_index_insert(H5T_g.path[i]);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__path_index_fill() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5T_path_find
  *
@@ -4953,9 +5261,7 @@ done:
 static H5T_path_t *
 H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name, H5T_conv_func_t *conv)
 {
-    int         lt, rt;                   /* left and right edges */
-    int         md;                       /* middle */
-    int         cmp;                      /* comparison result  */
+    uint32_t    hash = 0;                 /* hash of source and destination types */
     int         old_npaths;               /* Previous number of paths in table */
     H5T_path_t *table  = NULL;            /* path existing in the table */
     H5T_path_t *path   = NULL;            /* new path */
@@ -4999,38 +5305,20 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name, H5T_co
     } /* end if */
 
     /* Find the conversion path.  If source and destination types are equal
-     * then use entry[0], otherwise do a binary search over the
-     * remaining entries.
+     * then use entry[0], otherwise look the types up in the hash index of
+     * the remaining entries.
      *
      * Quincey Koziol, 2 July, 1999
      * Only allow the no-op conversion to occur if no "force conversion" flags
      * are set
      */
     if (src->shared->force_conv == FALSE && dst->shared->force_conv == FALSE &&
-        0 == H5T_cmp(src, dst, TRUE)) {
+        0 == H5T_cmp(src, dst, TRUE))
         table = H5T_g.path[0];
-        cmp   = 0;
-        md    = 0;
-    } /* end if */
     else {
-        lt = md = 1;
-        rt      = H5T_g.npaths;
-        cmp     = -1;
-
-        while (cmp && lt < rt) {
-            md = (lt + rt) / 2;
-            HDassert(H5T_g.path[md]);
-            cmp = H5T_cmp(src, H5T_g.path[md]->src, FALSE);
-            if (0 == cmp)
-                cmp = H5T_cmp(dst, H5T_g.path[md]->dst, FALSE);
-            if (cmp < 0)
-                rt = md;
-            else if (cmp > 0)
-                lt = md + 1;
-            else
-                table = H5T_g.path[md];
-        } /* end while */
-    }     /* end else */
+        hash  = H5T_PATH_HASH(H5T__hash(src), H5T__hash(dst));
+        table = H5T__path_lookup(src, dst, hash);
+    } /* end else */
 
     /* Keep a record of the number of paths in the table, in case one of the
      * initialization calls below (hard or soft) causes more entries to be
@@ -5143,31 +5431,19 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name, H5T_co
         HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, NULL, "no appropriate function for conversion path")
 
     /* Check if paths were inserted into the table through a recursive call
-     * and re-compute the correct location for this path if so. - QAK, 1/26/02
+     * and look up the path again if so. - QAK, 1/26/02
      */
     if (old_npaths != H5T_g.npaths) {
-        lt = md = 1;
-        rt      = H5T_g.npaths;
-        cmp     = -1;
-
-        while (cmp && lt < rt) {
-            md = (lt + rt) / 2;
-            HDassert(H5T_g.path[md]);
-            cmp = H5T_cmp(src, H5T_g.path[md]->src, FALSE);
-            if (0 == cmp)
-                cmp = H5T_cmp(dst, H5T_g.path[md]->dst, FALSE);
-            if (cmp < 0)
-                rt = md;
-            else if (cmp > 0)
-                lt = md + 1;
-            else
-                table = H5T_g.path[md];
-        } /* end while */
-    }     /* end if */
+        hash  = H5T_PATH_HASH(H5T__hash(src), H5T__hash(dst));
+        table = H5T__path_lookup(src, dst, hash);
+    } /* end if */
+    if (path != table)
+        path->hash = hash;
 
     /* Replace an existing table entry or add a new entry */
     if (table && path != table) {
-        HDassert(table == H5T_g.path[md]);
+        for (i = 0; H5T_g.path[i] != table; i++)
+            HDassert(i + 1 < H5T_g.npaths);
         H5T__print_stats(table, &nprint /*in,out*/);
         table->cdata.command = H5T_CONV_FREE;
         if (table->conv.is_app) {
@@ -5194,12 +5470,12 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name, H5T_co
             (void)H5T_close_real(table->src);
         if (table->dst)
             (void)H5T_close_real(table->dst);
-        table          = H5FL_FREE(H5T_path_t, table);
-        table          = path;
-        H5T_g.path[md] = path;
+        H5T__path_index_replace(table, path);
+        table         = H5FL_FREE(H5T_path_t, table);
+        table         = path;
+        H5T_g.path[i] = path;
     } /* end if */
     else if (path != table) {
-        HDassert(cmp);
         if ((size_t)H5T_g.npaths >= H5T_g.apaths) {
             size_t       na = MAX(128, 2 * H5T_g.apaths);
             H5T_path_t **x;
@@ -5209,12 +5485,23 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name, H5T_co
             H5T_g.apaths = na;
             H5T_g.path   = x;
         } /* end if */
-        if (cmp > 0)
-            md++;
-        HDmemmove(H5T_g.path + md + 1, H5T_g.path + md, (size_t)(H5T_g.npaths - md) * sizeof(H5T_path_t *));
-        H5T_g.npaths++;
-        H5T_g.path[md] = path;
-        table          = path;
+
+        /* Grow the hash index, to keep it no more than half full */
+        if (2 * (size_t)H5T_g.npaths > H5T_g.nslots) {
+            size_t       ns = MAX(H5T_PATH_INDEX_MIN, 2 * H5T_g.nslots);
+            H5T_path_t **x;
+
+            if (NULL == (x = (H5T_path_t **)H5MM_malloc(ns * sizeof(H5T_path_t *))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed")
+            H5MM_xfree(H5T_g.index);
+            H5T_g.nslots = ns;
+            H5T_g.index  = x;
+            H5T__path_index_fill();
+        } /* end if */
+
+        H5T_g.path[H5T_g.npaths++] = path;
+        H5T__path_index_insert(path);
+        table = path;
     } /* end else-if */
 
     /* Set the flag to indicate both source and destination types are compound types
@@ -5382,7 +5669,8 @@ H5T_convert(H5T_path_t *tpath, hid_t src_id, hid_t dst_id, size_t nelmts, size_t
 #ifdef H5T_DEBUG
     H5_timer_t timer; /* Timer for conversion */
 #endif
-    herr_t ret_value = SUCCEED; /* Return value */
+    hbool_t converted = FALSE;   /* Whether the conversion was done by the worker threads */
+    herr_t  ret_value = SUCCEED; /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
 
@@ -5396,14 +5684,21 @@ H5T_convert(H5T_path_t *tpath, hid_t src_id, hid_t dst_id, size_t nelmts, size_t
 
     /* Call the appropriate conversion callback */
     tpath->cdata.command = H5T_CONV_CONV;
-    if (tpath->conv.is_app) {
-        if ((tpath->conv.u.app_func)(src_id, dst_id, &(tpath->cdata), nelmts, buf_stride, bkg_stride, buf,
-                                     bkg, H5CX_get_dxpl()) < 0)
+#ifdef H5_HAVE_CONV_THREADS
+    /* Split the conversion across worker threads, if requested and possible */
+    if (H5T__pool_convert(tpath, src_id, dst_id, nelmts, buf_stride, buf, &converted) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
+#endif /* H5_HAVE_CONV_THREADS */
+    if (!converted) {
+        if (tpath->conv.is_app) {
+            if ((tpath->conv.u.app_func)(src_id, dst_id, &(tpath->cdata), nelmts, buf_stride, bkg_stride,
+                                         buf, bkg, H5CX_get_dxpl()) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
+        } /* end if */
+        else if ((tpath->conv.u.lib_func)(src_id, dst_id, &(tpath->cdata), nelmts, buf_stride, bkg_stride,
+                                          buf, bkg) < 0)
             HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
     } /* end if */
-    else if ((tpath->conv.u.lib_func)(src_id, dst_id, &(tpath->cdata), nelmts, buf_stride, bkg_stride, buf,
-                                      bkg) < 0)
-        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
 #ifdef H5T_DEBUG
     if (H5DEBUG(T)) {
         /* Stop timer */
@@ -5739,6 +6034,9 @@ H5T_set_loc(H5T_t *dt, H5VL_object_t *file, H5T_loc_t loc)
 
     /* Datatypes can't change in size if the force_conv flag is not set */
     if (dt->shared->force_conv) {
+        /* The size or reference location may change, so drop the cached hash */
+        dt->shared->hash_valid = FALSE;
+
         /* Check the datatype of this element */
         switch (dt->shared->type) {
             case H5T_ARRAY: /* Recurse on VL, compound and array base element type */
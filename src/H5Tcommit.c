@@ -458,6 +458,9 @@ H5T__commit(H5F_t *file, H5T_t *type, hid_t tcpl_id)
     if (H5T_set_loc(type, NULL, H5T_LOC_MEMORY) < 0)
         HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "cannot mark datatype in memory")
 
+    /* Cache the datatype's hash, now that it can't be modified */
+    (void)H5T__hash(type);
+
 done:
     if (ret_value < 0) {
         if (loc_init) {
@@ -34,6 +34,14 @@
 #include "H5Pprivate.h"  /* Property lists            */
 #include "H5Tpkg.h"      /* Datatypes                */
 
+/* Byte order conversions of packed elements use SSSE3 byte shuffles on x86
+ * CPUs which have them, when the compiler can build code for them without
+ * requiring them for the whole library */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define H5T_CONV_ORDER_SSSE3
+#include <tmmintrin.h>
+#endif
+
 /****************/
 /* Local Macros */
 /****************/
@@ -818,7 +826,12 @@
                         } /* end else */                                                                     \
                                                                                                              \
                         /* Perform loop over elements to convert */                                          \
-                        if (s_mv && d_mv) {                                                                  \
+                        if (H5_GLUE(GUTS, _VEC) && !cb_struct.func && !s_mv && !d_mv &&                      \
+                            s_stride == (ssize_t)sizeof(ST) && d_stride == (ssize_t)sizeof(DT)) {            \
+                            /* Packed, aligned elements with no exception callback */                        \
+                            H5T_CONV_LOOP_VEC(GUTS, STYPE, DTYPE, ST, DT, D_MIN, D_MAX)                      \
+                        }                                                                                    \
+                        else if (s_mv && d_mv) {                                                             \
                             /* Alignment is required for both source and dest */                             \
                             s = &src_aligned;                                                                \
                             H5T_CONV_LOOP_OUTER(PRE_SALIGN, PRE_DALIGN, POST_SALIGN, POST_DALIGN, GUTS,      \
@@ -967,6 +980,65 @@ done:
         dst         = (DT *)dst_buf;                                                                         \
     }
 
+/* Whether to use H5T_CONV_LOOP_VEC for each kind of conversion.  The range
+ * checks of floating-point narrowing conversions can't be vectorized without
+ * relaxing floating-point exception semantics, so those stay in the scalar loop.
+ */
+#define H5T_CONV_xX_VEC 1
+#define H5T_CONV_Xx_VEC 1
+#define H5T_CONV_Ux_VEC 1
+#define H5T_CONV_sU_VEC 1
+#define H5T_CONV_uS_VEC 1
+#define H5T_CONV_Su_VEC 1
+#define H5T_CONV_su_VEC 1
+#define H5T_CONV_us_VEC 1
+#define H5T_CONV_xF_VEC 1
+#define H5T_CONV_Fx_VEC 1
+#define H5T_CONV_Ff_VEC 0
+
+/* Number of elements converted at a time by H5T_CONV_LOOP_VEC */
+#define H5T_CONV_VEC_NELMTS 256
+
+/* The inner loop of the type conversion macro for packed, aligned elements with
+ * no exception callback, written so that the compiler can vectorize it.
+ *
+ * When elements grow, the outer loop only converts elements whose source and
+ * destination don't overlap, so they are converted directly.  Otherwise they are
+ * converted a short block at a time into a local array, which can't alias the
+ * conversion buffer, and then copied to their destination.  Every source element
+ * of a block is read before any destination element of the block is written, so
+ * converting in place is safe.
+ */
+#define H5T_CONV_LOOP_VEC(GUTS, STYPE, DTYPE, ST, DT, D_MIN, D_MAX)                                          \
+    if (sizeof(DT) > sizeof(ST)) {                                                                           \
+        for (elmtno = 0; elmtno < safe; elmtno++)                                                            \
+            H5T_CONV_LOOP_GUTS(H5_GLUE(GUTS, _NOEX), STYPE, DTYPE, src + elmtno, dst + elmtno, ST, DT, D_MIN,\
+                               D_MAX)                                                                        \
+    }                                                                                                        \
+    else {                                                                                                   \
+        DT     vec_buf[H5T_CONV_VEC_NELMTS]; /* Converted elements */                                        \
+        size_t vec_nelmts;                    /* # of elements in this block */                              \
+        size_t vec_u;                         /* Index of element within block */                            \
+                                                                                                             \
+        for (elmtno = 0; elmtno < safe; elmtno += vec_nelmts) {                                              \
+            vec_nelmts = MIN(safe - elmtno, H5T_CONV_VEC_NELMTS);                                            \
+                                                                                                             \
+            /* (A constant trip count for full blocks helps the vectorizer) */                               \
+            if (vec_nelmts == H5T_CONV_VEC_NELMTS)                                                           \
+                for (vec_u = 0; vec_u < H5T_CONV_VEC_NELMTS; vec_u++)                                        \
+                    H5T_CONV_LOOP_GUTS(H5_GLUE(GUTS, _NOEX), STYPE, DTYPE, src + vec_u, vec_buf + vec_u, ST, \
+                                       DT, D_MIN, D_MAX)                                                     \
+            else                                                                                             \
+                for (vec_u = 0; vec_u < vec_nelmts; vec_u++)                                                 \
+                    H5T_CONV_LOOP_GUTS(H5_GLUE(GUTS, _NOEX), STYPE, DTYPE, src + vec_u, vec_buf + vec_u, ST, \
+                                       DT, D_MIN, D_MAX)                                                     \
+                                                                                                             \
+            H5MM_memcpy(dst, vec_buf, vec_nelmts * sizeof(DT));                                              \
+            src += vec_nelmts;                                                                               \
+            dst += vec_nelmts;                                                                               \
+        }                                                                                                    \
+    }
+
 /* Macro to call the actual "guts" of the type conversion, or call the "no exception" guts */
 #ifdef H5_WANT_DCONV_EXCEPTION
 #define H5T_CONV_LOOP_GUTS(GUTS, STYPE, DTYPE, S, D, ST, DT, D_MIN, D_MAX)                                   \
@@ -1029,21 +1101,83 @@ done:
         ARRAY[J] = _tmp;                                                                                     \
     }
 
+/* Reverse the byte order of 16, 32 and 64-bit values (compilers turn these
+ * into a single instruction) */
+#define H5T_BSWAP16(X) ((uint16_t)(((X) >> 8) | ((X) << 8)))
+#define H5T_BSWAP32(X)                                                                                       \
+    ((((X)&0x000000ffU) << 24) | (((X)&0x0000ff00U) << 8) | (((X)&0x00ff0000U) >> 8) |                       \
+     (((X)&0xff000000U) >> 24))
+#define H5T_BSWAP64(X)                                                                                       \
+    (((uint64_t)H5T_BSWAP32((uint32_t)(X)) << 32) | (uint64_t)H5T_BSWAP32((uint32_t)((X) >> 32)))
+
 /* Minimum size of variable-length conversion buffer */
 #define H5T_VLEN_MIN_CONF_BUF_SIZE 4096
 
+/* Maximum number of variable-length sequences gathered for a batched read or write */
+#define H5T_VLEN_BATCH_NELMTS 2048
+
+/* Maximum number of bytes of variable-length data gathered for a batched read */
+#define H5T_VLEN_READ_BATCH_SIZE (1024 * 1024)
+
+/* Convert enum values by copying them out of the destination value table
+ * built by H5T__conv_enum_init(), for source and destination values of a
+ * fixed size (HDmemcpy() avoids alignment issues).  Source values outside
+ * the table use the extra entry at its end. */
+#define H5T_CONV_ENUM_TABLE_CORE(STYPE, DTYPE)                                                               \
+    do {                                                                                                     \
+        const DTYPE *_table = (const DTYPE *)((const void *)val2dst);                                        \
+                                                                                                             \
+        for (i = 0; i < nelmts; i++, s += src_delta, d += dst_delta) {                                       \
+            STYPE    _key;                                                                                   \
+            uint64_t _idx;                                                                                   \
+                                                                                                             \
+            HDmemcpy(&_key, s, sizeof(STYPE));                                                               \
+            _idx = (uint64_t)((int64_t)_key - priv->base);                                                   \
+            HDmemcpy(d, &_table[MIN(_idx, priv->length)], sizeof(DTYPE));                                    \
+        }                                                                                                    \
+    } while (0)
+
+#define H5T_CONV_ENUM_TABLE(DTYPE)                                                                           \
+    do {                                                                                                     \
+        if (1 == src->shared->size)                                                                          \
+            H5T_CONV_ENUM_TABLE_CORE(int8_t, DTYPE);                                                         \
+        else if (2 == src->shared->size)                                                                     \
+            H5T_CONV_ENUM_TABLE_CORE(int16_t, DTYPE);                                                        \
+        else                                                                                                 \
+            H5T_CONV_ENUM_TABLE_CORE(int32_t, DTYPE);                                                        \
+    } while (0)
+
+/* Maximum number of entries in an enum conversion lookup table whose
+ * source values don't otherwise fill it densely (enough for every value
+ * of a 1 or 2-byte enum) */
+#define H5T_ENUM_TABLE_MAX 65536
+
 /******************/
 /* Local Typedefs */
 /******************/
 
+/* One step of the copy plan for H5T__conv_struct(): a run of member values
+ * which are copied, or have their byte order reversed, into the background
+ * buffer without calling a conversion function */
+typedef struct H5T_conv_struct_op_t {
+    size_t  src_offset; /*offset of the run in the source element     */
+    size_t  dst_offset; /*offset of the run in the destination element */
+    size_t  size;       /*size of each value in the run               */
+    size_t  nvals;      /*number of values in the run                 */
+    hbool_t swap;       /*reverse the byte order of each value?       */
+} H5T_conv_struct_op_t;
+
 /* Conversion data for H5T__conv_struct() */
 typedef struct H5T_conv_struct_t {
-    int *             src2dst;     /*mapping from src to dst member num */
-    hid_t *           src_memb_id; /*source member type ID's         */
-    hid_t *           dst_memb_id; /*destination member type ID's         */
-    H5T_path_t **     memb_path;   /*conversion path for each member    */
-    H5T_subset_info_t subset_info; /*info related to compound subsets   */
-    unsigned          src_nmembs;  /*needed by free function            */
+    int *                 src2dst;      /*mapping from src to dst member num */
+    hid_t *               src_memb_id;  /*source member type ID's         */
+    hid_t *               dst_memb_id;  /*destination member type ID's         */
+    H5T_path_t **         memb_path;    /*conversion path for each member    */
+    H5T_subset_info_t     subset_info;  /*info related to compound subsets   */
+    unsigned              src_nmembs;   /*needed by free function            */
+    hbool_t *             memb_planned; /*is src member handled by the plan? */
+    H5T_conv_struct_op_t *plan;         /*copy plan for unconverted members  */
+    unsigned              plan_nops;    /*number of steps in the copy plan   */
 } H5T_conv_struct_t;
 
 /* Conversion data for H5T__conv_enum() */
@@ -1051,6 +1185,7 @@ typedef struct H5T_enum_struct_t {
     int      base;    /*lowest `in' value             */
     unsigned length;  /*num elements in arrays         */
     int *    src2dst; /*map from src to dst index         */
+    uint8_t *val2dst; /*map from src value to dst value  */
 } H5T_enum_struct_t;
 
 /* Conversion data for the hardware conversion functions */
@@ -1068,6 +1203,15 @@ typedef struct H5T_conv_hw_t {
 /********************/
 
 static herr_t H5T__reverse_order(uint8_t *rev, uint8_t *s, size_t size, H5T_order_t order);
+#ifdef H5T_CONV_ORDER_SSSE3
+static size_t H5T__conv_order_swap_ssse3(uint8_t *buf, size_t nelmts, size_t size);
+#endif /* H5T_CONV_ORDER_SSSE3 */
+static void H5T__conv_order_swap(uint8_t *buf, size_t nelmts, size_t size);
+static H5_INLINE int H5T__conv_enum_key(const uint8_t *s, size_t size);
+static herr_t H5T__conv_vlen_read_batch(const H5T_t *src, const H5T_t *dst,
+                                        const H5T_vlen_alloc_info_t *vl_alloc_info, size_t nseq,
+                                        const void *vl[], void *dst_elmts[], void *bufs[],
+                                        const size_t sizes[], uint8_t *conv_buf, size_t base_size);
 
 /*********************/
 /* Public Variables */
@@ -1136,6 +1280,148 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__conv_noop() */
 
+#ifdef H5T_CONV_ORDER_SSSE3
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_order_swap_ssse3
+ *
+ * Purpose:     Reverse the byte order of packed 2, 4, 8 or 16-byte
+ *              elements, sixteen bytes at a time with SSSE3 byte shuffles.
+ *              Must only be called on CPUs which support SSSE3.
+ *
+ * Return:      The number of elements swapped (the remaining elements
+ *              don't fill a 16-byte vector)
+ *
+ *-------------------------------------------------------------------------
+ */
+__attribute__((target("ssse3"))) static size_t
+H5T__conv_order_swap_ssse3(uint8_t *buf, size_t nelmts, size_t size)
+{
+    __m128i mask;      /* Shuffle mask reversing each element */
+    size_t  nbytes;    /* Number of bytes swapped with vectors */
+    size_t  u;         /* Local index variable */
+    size_t  ret_value; /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    switch (size) {
+        case 2:
+            mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+            break;
+
+        case 4:
+            mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+            break;
+
+        case 8:
+            mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+            break;
+
+        case 16:
+        default:
+            HDassert(16 == size);
+            mask = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+            break;
+    } /* end switch */
+
+    /* Swap whole vectors, four at a time while there are enough */
+    nbytes = (nelmts * size) & ~(size_t)15;
+    for (u = 0; u + 64 <= nbytes; u += 64) {
+        __m128i v0 = _mm_loadu_si128((const __m128i *)(buf + u));
+        __m128i v1 = _mm_loadu_si128((const __m128i *)(buf + u + 16));
+        __m128i v2 = _mm_loadu_si128((const __m128i *)(buf + u + 32));
+        __m128i v3 = _mm_loadu_si128((const __m128i *)(buf + u + 48));
+
+        _mm_storeu_si128((__m128i *)(buf + u), _mm_shuffle_epi8(v0, mask));
+        _mm_storeu_si128((__m128i *)(buf + u + 16), _mm_shuffle_epi8(v1, mask));
+        _mm_storeu_si128((__m128i *)(buf + u + 32), _mm_shuffle_epi8(v2, mask));
+        _mm_storeu_si128((__m128i *)(buf + u + 48), _mm_shuffle_epi8(v3, mask));
+    } /* end for */
+    for (/*void*/; u < nbytes; u += 16)
+        _mm_storeu_si128((__m128i *)(buf + u),
+                         _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(buf + u)), mask));
+
+    ret_value = nbytes / size;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_order_swap_ssse3() */
+#endif /* H5T_CONV_ORDER_SSSE3 */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_order_swap
+ *
+ * Purpose:     Reverse the byte order of NELMTS packed 2, 4, 8 or 16-byte
+ *              elements in BUF, in place.  Elements are swapped a whole
+ *              word at a time, with SSSE3 byte shuffles when the CPU has
+ *              them.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__conv_order_swap(uint8_t *buf, size_t nelmts, size_t size)
+{
+    size_t u = 0; /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Swap as many elements as possible with vectors */
+#ifdef H5T_CONV_ORDER_SSSE3
+    if (__builtin_cpu_supports("ssse3"))
+        u = H5T__conv_order_swap_ssse3(buf, nelmts, size);
+#endif /* H5T_CONV_ORDER_SSSE3 */
+
+    /* Swap the rest a word at a time (HDmemcpy() avoids alignment issues) */
+    switch (size) {
+        case 2:
+            for (/*void*/; u < nelmts; u++) {
+                uint16_t v;
+
+                HDmemcpy(&v, buf + u * 2, 2);
+                v = H5T_BSWAP16(v);
+                HDmemcpy(buf + u * 2, &v, 2);
+            } /* end for */
+            break;
+
+        case 4:
+            for (/*void*/; u < nelmts; u++) {
+                uint32_t v;
+
+                HDmemcpy(&v, buf + u * 4, 4);
+                v = H5T_BSWAP32(v);
+                HDmemcpy(buf + u * 4, &v, 4);
+            } /* end for */
+            break;
+
+        case 8:
+            for (/*void*/; u < nelmts; u++) {
+                uint64_t v;
+
+                HDmemcpy(&v, buf + u * 8, 8);
+                v = H5T_BSWAP64(v);
+                HDmemcpy(buf + u * 8, &v, 8);
+            } /* end for */
+            break;
+
+        case 16:
+        default:
+            HDassert(16 == size);
+            for (/*void*/; u < nelmts; u++) {
+                uint64_t lo, hi;
+
+                HDmemcpy(&lo, buf + u * 16, 8);
+                HDmemcpy(&hi, buf + u * 16 + 8, 8);
+                lo = H5T_BSWAP64(lo);
+                hi = H5T_BSWAP64(hi);
+                HDmemcpy(buf + u * 16, &hi, 8);
+                HDmemcpy(buf + u * 16 + 8, &lo, 8);
+            } /* end for */
+            break;
+    } /* end switch */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__conv_order_swap() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5T__conv_order_opt
  *
@@ -1242,6 +1528,13 @@ H5T__conv_order_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmt
             } /* end if */
 
             buf_stride = buf_stride ? buf_stride : src->shared->size;
+
+            /* Swap packed elements a word or vector at a time */
+            if (buf_stride == src->shared->size && src->shared->size > 1) {
+                H5T__conv_order_swap(buf, nelmts, src->shared->size);
+                break;
+            } /* end if */
+
             switch (src->shared->size) {
                 case 1:
                     /*no-op*/
@@ -1928,10 +2221,138 @@ H5T__conv_struct_free(H5T_conv_struct_t *priv)
     H5MM_xfree(src_memb_id);
     H5MM_xfree(dst_memb_id);
     H5MM_xfree(priv->memb_path);
+    H5MM_xfree(priv->memb_planned);
+    H5MM_xfree(priv->plan);
 
     FUNC_LEAVE_NOAPI((H5T_conv_struct_t *)H5MM_xfree(priv))
 } /* end H5T__conv_struct_free() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_struct_plan
+ *
+ * Purpose:     Build the copy plan for a compound conversion.  Members
+ *              which need no conversion are copied, and members which
+ *              only change byte order are byte-swapped, straight into the
+ *              background buffer instead of calling H5T_convert() for
+ *              them.  Members that follow each other in both the source
+ *              and the destination are merged into a single step, so a
+ *              run of unconverted members costs one copy per element.
+ *
+ *              Members handled by the plan are flagged in MEMB_PLANNED so
+ *              the member loops of the conversion functions skip them.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__conv_struct_plan(const H5T_t *src, const H5T_t *dst, H5T_conv_struct_t *priv)
+{
+    H5T_conv_struct_op_t *op         = NULL; /* Current step of the plan */
+    unsigned              src_nmembs = src->shared->u.compnd.nmembs; /* Number of source members */
+    unsigned              u;                                        /* Local index variable */
+    herr_t                ret_value = SUCCEED;                      /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    priv->memb_planned = (hbool_t *)H5MM_xfree(priv->memb_planned);
+    priv->plan         = (H5T_conv_struct_op_t *)H5MM_xfree(priv->plan);
+    priv->plan_nops    = 0;
+    if (0 == src_nmembs)
+        HGOTO_DONE(SUCCEED)
+
+    if (NULL == (priv->memb_planned = (hbool_t *)H5MM_calloc(src_nmembs * sizeof(hbool_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    if (NULL == (priv->plan = (H5T_conv_struct_op_t *)H5MM_malloc(src_nmembs * sizeof(H5T_conv_struct_op_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+
+    for (u = 0; u < src_nmembs; u++) {
+        const H5T_cmemb_t *src_memb, *dst_memb;
+        const H5T_path_t * tpath = priv->memb_path[u];
+        hbool_t            swap;
+
+        if (priv->src2dst[u] < 0)
+            continue;
+        src_memb = src->shared->u.compnd.memb + u;
+        dst_memb = dst->shared->u.compnd.memb + priv->src2dst[u];
+
+        /* Only no-op and byte order conversions can be planned */
+        if (tpath->is_noop)
+            swap = FALSE;
+        else if (!tpath->conv.is_app && H5T_REFERENCE != src_memb->type->shared->type &&
+                 (tpath->conv.u.lib_func == H5T__conv_order_opt || tpath->conv.u.lib_func == H5T__conv_order))
+            swap = TRUE;
+        else
+            continue;
+        HDassert(src_memb->size == dst_memb->size);
+
+        /* Extend the previous step if this member follows it, otherwise start a new one */
+        if (op && op->swap == swap && (!swap || op->size == src_memb->size) &&
+            op->src_offset + op->size * op->nvals == src_memb->offset &&
+            op->dst_offset + op->size * op->nvals == dst_memb->offset) {
+            if (swap)
+                op->nvals++;
+            else
+                op->size += src_memb->size;
+        } /* end if */
+        else {
+            op             = priv->plan + priv->plan_nops++;
+            op->src_offset = src_memb->offset;
+            op->dst_offset = dst_memb->offset;
+            op->size       = src_memb->size;
+            op->nvals      = 1;
+            op->swap       = swap;
+        } /* end else */
+        priv->memb_planned[u] = TRUE;
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_struct_plan() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_struct_plan_exec
+ *
+ * Purpose:     Carry out the copy plan of a compound conversion for
+ *              NELMTS elements, moving the planned members of each source
+ *              element in BUF to their place in the corresponding
+ *              destination element in BKG.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__conv_struct_plan_exec(const H5T_conv_struct_t *priv, size_t nelmts, const uint8_t *buf,
+                           size_t buf_stride, uint8_t *bkg, size_t bkg_stride)
+{
+    size_t   elmtno; /* Element counter */
+    size_t   j, k;   /* Local index variables */
+    unsigned u;      /* Plan step counter */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for (elmtno = 0; elmtno < nelmts; elmtno++) {
+        for (u = 0; u < priv->plan_nops; u++) {
+            const H5T_conv_struct_op_t *op = priv->plan + u;
+            const uint8_t *             s  = buf + op->src_offset;
+            uint8_t *                   d  = bkg + op->dst_offset;
+
+            if (op->swap)
+                for (k = 0; k < op->nvals; k++, s += op->size, d += op->size)
+                    for (j = 0; j < op->size; j++)
+                        d[j] = s[op->size - (j + 1)];
+            else
+                H5MM_memcpy(d, s, op->size);
+        } /* end for */
+
+        buf += buf_stride;
+        bkg += bkg_stride;
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__conv_struct_plan_exec() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5T__conv_struct_init
  *
@@ -2075,6 +2496,12 @@ H5T__conv_struct_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
         }     /* end if */
     }         /* end for */
 
+    /* (Re)build the plan for members which don't need a conversion function */
+    if (H5T__conv_struct_plan(src, dst, priv) < 0) {
+        cdata->priv = H5T__conv_struct_free(priv);
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "unable to build compound conversion plan")
+    } /* end if */
+
     /* The compound conversion functions need a background buffer */
     cdata->need_bkg = H5T_BKG_YES;
 
@@ -2291,8 +2718,11 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
 
             /* Conversion loop... */
             for (elmtno = 0; elmtno < nelmts; elmtno++) {
+                /* Move the members which need no conversion function */
+                H5T__conv_struct_plan_exec(priv, (size_t)1, xbuf, (size_t)0, xbkg, (size_t)0);
+
                 /*
-                 * For each source member which will be present in the
+                 * For each other source member which will be present in the
                  * destination, convert the member to the destination type unless
                  * it is larger than the source type.  Then move the member to the
                  * left-most unoccupied position in the buffer.  This makes the
@@ -2300,8 +2730,8 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
                  * right side.
                  */
                 for (u = 0, offset = 0; u < src->shared->u.compnd.nmembs; u++) {
-                    if (src2dst[u] < 0)
-                        continue; /*subsetting*/
+                    if (src2dst[u] < 0 || priv->memb_planned[u])
+                        continue; /*subsetting or planned*/
                     src_memb = src->shared->u.compnd.memb + u;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[u];
 
@@ -2330,8 +2760,8 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
                  */
                 H5_CHECK_OVERFLOW(src->shared->u.compnd.nmembs, size_t, int);
                 for (i = (int)src->shared->u.compnd.nmembs - 1; i >= 0; --i) {
-                    if (src2dst[i] < 0)
-                        continue; /*subsetting*/
+                    if (src2dst[i] < 0 || priv->memb_planned[i])
+                        continue; /*subsetting or planned*/
                     src_memb = src->shared->u.compnd.memb + i;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[i];
 
@@ -2481,7 +2911,7 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelm
              */
             if (dst->shared->size > src->shared->size) {
                 for (u = 0, offset = 0; u < src->shared->u.compnd.nmembs; u++) {
-                    if (src2dst[u] < 0)
+                    if (src2dst[u] < 0 || priv->memb_planned[u])
                         continue;
                     src_memb = src->shared->u.compnd.memb + u;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[u];
@@ -2490,7 +2920,7 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelm
                 } /* end for */
                 H5_CHECK_OVERFLOW(src->shared->u.compnd.nmembs, size_t, int);
                 for (i = (int)src->shared->u.compnd.nmembs - 1; i >= 0; --i) {
-                    if (src2dst[i] < 0)
+                    if (src2dst[i] < 0 || priv->memb_planned[i])
                         continue;
                     src_memb = src->shared->u.compnd.memb + i;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[i];
@@ -2568,16 +2998,19 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelm
                 } /* end for */
             }     /* end if */
             else {
+                /* Move the members which need no conversion function */
+                H5T__conv_struct_plan_exec(priv, nelmts, buf, buf_stride, bkg, bkg_stride);
+
                 /*
-                 * For each member where the destination is not larger than the
+                 * For each other member where the destination is not larger than the
                  * source, stride through all the elements converting only that member
                  * in each element and then copying the element to its final
                  * destination in the bkg buffer. Otherwise move the element as far
                  * left as possible in the buffer.
                  */
                 for (u = 0, offset = 0; u < src->shared->u.compnd.nmembs; u++) {
-                    if (src2dst[u] < 0)
-                        continue; /*subsetting*/
+                    if (src2dst[u] < 0 || priv->memb_planned[u])
+                        continue; /*subsetting or planned*/
                     src_memb = src->shared->u.compnd.memb + u;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[u];
 
@@ -2612,7 +3045,7 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelm
                  */
                 H5_CHECK_OVERFLOW(src->shared->u.compnd.nmembs, size_t, int);
                 for (i = (int)src->shared->u.compnd.nmembs - 1; i >= 0; --i) {
-                    if (src2dst[i] < 0)
+                    if (src2dst[i] < 0 || priv->memb_planned[i])
                         continue;
                     src_memb = src->shared->u.compnd.memb + i;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[i];
@@ -2655,6 +3088,45 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__conv_struct_opt() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_enum_key
+ *
+ * Purpose:     Read the bit pattern of a 1, 2 or 4-byte enum value as a
+ *              native signed integer, for looking it up in the tables
+ *              built by H5T__conv_enum_init().
+ *
+ * Return:      The value read
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_INLINE int
+H5T__conv_enum_key(const uint8_t *s, size_t size)
+{
+    int ret_value = 0; /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(1 == size || 2 == size || 4 == size);
+
+    /* (HDmemcpy() avoids alignment issues) */
+    if (1 == size)
+        ret_value = (int8_t)*s;
+    else if (2 == size) {
+        int16_t v;
+
+        HDmemcpy(&v, s, 2);
+        ret_value = v;
+    } /* end if */
+    else {
+        int32_t v;
+
+        HDmemcpy(&v, s, 4);
+        ret_value = (int)v;
+    } /* end else */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_enum_key() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5T__conv_enum_init
  *
@@ -2676,7 +3148,7 @@ H5T__conv_enum_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
     int                n;                   /*src value cast as native int    */
     int                domain[2] = {0, 0};  /*min and max source values    */
     int *              map       = NULL;    /*map from src value to dst idx    */
-    unsigned           length;              /*nelmts in map array        */
+    uint64_t           length;              /*nelmts in map array        */
     unsigned           i, j;                /*counters            */
     herr_t             ret_value = SUCCEED; /* Return value */
 
@@ -2710,37 +3182,34 @@ H5T__conv_enum_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
     /*
      * The conversion function will use an O(log N) lookup method for each
      * value converted. However, if all of the following constraints are met
-     * then we can build a perfect hash table and use an O(1) lookup method.
+     * then we can build a lookup table and use an O(1) lookup method.
      *
-     *      A: The source datatype size matches one of our native datatype
-     *         sizes.
+     *      A: The source datatype is 1, 2 or 4 bytes.
      *
-     *      B: After casting the source value bit pattern to a native type
-     *         the size of the range of values is less than 20% larger than
-     *         the number of values.
+     *      B: After reading the source value bit pattern as a native signed
+     *         integer of that size, the range of values has no more than
+     *         H5T_ENUM_TABLE_MAX values or is less than 20% larger than the
+     *         number of values.
      *
-     * If this special case is met then we use the source bit pattern cast as
-     * a native integer type as an index into the `val2dst'. The values of
-     * that array are the index numbers in the destination type or negative
-     * if the entry is unused.
+     * If this special case is met then we use the source bit pattern read as
+     * a native integer as an index into the `val2dst' table, which holds the
+     * destination value for each source value, and into `src2dst', which
+     * holds the index numbers in the destination type or is negative if the
+     * entry is unused.  Both tables have an extra entry at the end, which
+     * any source value outside the table is mapped to: it is unused and its
+     * destination value is all ones, as for an unhandled exception.  When
+     * there is no conversion exception callback, every element is then just
+     * copied out of `val2dst'.
      *
-     * (This optimized algorithm doesn't work when the byte orders are different.
-     * The code such as "n = *((int*)(src->shared->u.enumer.value+i*src->shared->size));"
-     * can change the value significantly. i.g. if the source value is big-endian 0x0000000f,
-     * executing the casting on little-endian machine will get a big number 0x0f000000.
-     * Then it can't meet the condition
-     * "if(src->shared->u.enumer.nmembs<2 || (double)length/src->shared->u.enumer.nmembs<1.2)"
-     * Because this is the optimized code, we won't fix it. It should still work in some
-     * situations. SLU - 2011/5/24)
+     * (Reading the bit pattern natively works whatever the source byte
+     * order is, because values are looked up the same way they were added,
+     * but a range of values in a foreign byte order is usually too sparse
+     * for a 4-byte table.)
      */
-    if (1 == src->shared->size || sizeof(short) == src->shared->size || sizeof(int) == src->shared->size) {
+    if (1 == src->shared->size || 2 == src->shared->size || 4 == src->shared->size) {
         for (i = 0; i < src->shared->u.enumer.nmembs; i++) {
-            if (1 == src->shared->size)
-                n = *((signed char *)((uint8_t *)src->shared->u.enumer.value + i));
-            else if (sizeof(short) == src->shared->size)
-                n = *((short *)((void *)((uint8_t *)src->shared->u.enumer.value + (i * src->shared->size))));
-            else
-                n = *((int *)((void *)((uint8_t *)src->shared->u.enumer.value + (i * src->shared->size))));
+            n = H5T__conv_enum_key((uint8_t *)src->shared->u.enumer.value + (i * src->shared->size),
+                                   src->shared->size);
             if (0 == i) {
                 domain[0] = domain[1] = n;
             }
@@ -2751,28 +3220,29 @@ H5T__conv_enum_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
         } /* end for */
 
         HDassert(domain[1] >= domain[0]);
-        length = (unsigned)(domain[1] - domain[0]) + 1;
-        if (src->shared->u.enumer.nmembs < 2 ||
+        length = (uint64_t)((int64_t)domain[1] - (int64_t)domain[0]) + 1;
+        if (length <= H5T_ENUM_TABLE_MAX ||
             (double)length / src->shared->u.enumer.nmembs < (double)(1.2f)) {
+            size_t dst_size = dst->shared->size; /* Size of destination values */
+
             priv->base   = domain[0];
-            priv->length = length;
-            if (NULL == (map = (int *)H5MM_malloc(length * sizeof(int))))
+            priv->length = (unsigned)length;
+            if (NULL == (map = (int *)H5MM_malloc((length + 1) * sizeof(int))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+            if (NULL == (priv->val2dst = (uint8_t *)H5MM_malloc((length + 1) * dst_size)))
                 HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
-            for (i = 0; i < length; i++)
+            for (i = 0; i <= priv->length; i++)
                 map[i] = -1; /*entry unused*/
+            HDmemset(priv->val2dst, 0xff, (length + 1) * dst_size);
             for (i = 0; i < src->shared->u.enumer.nmembs; i++) {
-                if (1 == src->shared->size)
-                    n = *((signed char *)((uint8_t *)src->shared->u.enumer.value + i));
-                else if (sizeof(short) == src->shared->size)
-                    n = *((
-                        short *)((void *)((uint8_t *)src->shared->u.enumer.value + (i * src->shared->size))));
-                else
-                    n = *(
-                        (int *)((void *)((uint8_t *)src->shared->u.enumer.value + (i * src->shared->size))));
+                n = H5T__conv_enum_key((uint8_t *)src->shared->u.enumer.value + (i * src->shared->size),
+                                       src->shared->size);
                 n -= priv->base;
                 HDassert(n >= 0 && (unsigned)n < priv->length);
                 HDassert(map[n] < 0);
                 map[n] = priv->src2dst[i];
+                H5MM_memcpy(priv->val2dst + ((size_t)n * dst_size),
+                            (uint8_t *)dst->shared->u.enumer.value + ((size_t)map[n] * dst_size), dst_size);
             } /* end for */
 
             /*
@@ -2782,6 +3252,7 @@ H5T__conv_enum_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
              */
             H5MM_xfree(priv->src2dst);
             priv->src2dst = map;
+            map           = NULL;
             HGOTO_DONE(SUCCEED);
         }
     }
@@ -2790,10 +3261,14 @@ H5T__conv_enum_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
     H5T__sort_value(src, priv->src2dst);
 
 done:
-    if (ret_value < 0 && priv) {
-        H5MM_xfree(priv->src2dst);
-        H5MM_xfree(priv);
-        cdata->priv = NULL;
+    if (ret_value < 0) {
+        H5MM_xfree(map);
+        if (priv) {
+            H5MM_xfree(priv->src2dst);
+            H5MM_xfree(priv->val2dst);
+            H5MM_xfree(priv);
+            cdata->priv = NULL;
+        }
     }
     FUNC_LEAVE_NOAPI(ret_value)
 }
@@ -2857,6 +3332,7 @@ H5T__conv_enum(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
 #endif
             if (priv) {
                 H5MM_xfree(priv->src2dst);
+                H5MM_xfree(priv->val2dst);
                 H5MM_xfree(priv);
             }
             cdata->priv = NULL;
@@ -2904,21 +3380,41 @@ H5T__conv_enum(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
             if (H5CX_get_dt_conv_cb(&cb_struct) < 0)
                 HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to get conversion exception callback")
 
+            if (priv->length && NULL == cb_struct.func) {
+                size_t         dst_size = dst->shared->size; /* Size of destination values */
+                const uint8_t *val2dst  = priv->val2dst;     /* Destination value for each source value */
+
+                /* Use O(1) lookup, with no exceptions to handle */
+                switch (dst_size) {
+                    case 1:
+                        H5T_CONV_ENUM_TABLE(uint8_t);
+                        break;
+                    case 2:
+                        H5T_CONV_ENUM_TABLE(uint16_t);
+                        break;
+                    case 4:
+                        H5T_CONV_ENUM_TABLE(uint32_t);
+                        break;
+                    case 8:
+                        H5T_CONV_ENUM_TABLE(uint64_t);
+                        break;
+                    default:
+                        for (i = 0; i < nelmts; i++, s += src_delta, d += dst_delta) {
+                            uint64_t idx =
+                                (uint64_t)((int64_t)H5T__conv_enum_key(s, src->shared->size) - priv->base);
+
+                            HDmemcpy(d, val2dst + (MIN(idx, priv->length) * dst_size), dst_size);
+                        } /* end for */
+                        break;
+                } /* end switch */
+
+                break;
+            } /* end if */
+
             for (i = 0; i < nelmts; i++, s += src_delta, d += dst_delta) {
                 if (priv->length) {
                     /* Use O(1) lookup */
-                    /* (The casting won't work when the byte orders are different. i.g. if the source value
-                     * is big-endian 0x0000000f, the direct casting "n = *((int*)s);" will make it a big
-                     * number 0x0f000000 on little-endian machine. But we won't fix it because it's an
-                     * optimization code. Please also see the comment in the H5T__conv_enum_init() function.
-                     * SLU - 2011/5/24)
-                     */
-                    if (1 == src->shared->size)
-                        n = *((signed char *)s);
-                    else if (sizeof(short) == src->shared->size)
-                        n = *((short *)((void *)s));
-                    else
-                        n = *((int *)((void *)s));
+                    n = H5T__conv_enum_key(s, src->shared->size);
                     n -= priv->base;
                     if (n < 0 || (unsigned)n >= priv->length || priv->src2dst[n] < 0) {
                         /*overflow*/
@@ -2935,10 +3431,7 @@ H5T__conv_enum(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
                                         "can't handle conversion exception")
                     }
                     else
-                        H5MM_memcpy(d,
-                                    (uint8_t *)dst->shared->u.enumer.value +
-                                        ((unsigned)priv->src2dst[n] * dst->shared->size),
-                                    dst->shared->size);
+                        H5MM_memcpy(d, priv->val2dst + ((unsigned)n * dst->shared->size), dst->shared->size);
                 } /* end if */
                 else {
                     /* Use O(log N) lookup */
@@ -3075,6 +3568,54 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__conv_enum_numeric() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_vlen_read_batch
+ *
+ * Purpose:     Reads a batch of NSEQ VL sequences from the file into
+ *              CONV_BUF with a single call to the source class' 'read_batch'
+ *              callback, then writes each sequence to its destination
+ *              element in memory.  VL holds the (copied) source elements,
+ *              DST_ELMTS the destination elements and SIZES the sizes of
+ *              the sequences in bytes.  BUFS is scratch space for NSEQ
+ *              pointers and CONV_BUF must be large enough for all of the
+ *              sequences.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__conv_vlen_read_batch(const H5T_t *src, const H5T_t *dst, const H5T_vlen_alloc_info_t *vl_alloc_info,
+                          size_t nseq, const void *vl[], void *dst_elmts[], void *bufs[],
+                          const size_t sizes[], uint8_t *conv_buf, size_t base_size)
+{
+    size_t offset = 0;          /* Offset of sequence in conversion buffer */
+    size_t u;                   /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(conv_buf);
+
+    /* Read the sequences into the conversion buffer */
+    for (u = 0; u < nseq; u++) {
+        bufs[u] = conv_buf + offset;
+        offset += sizes[u];
+    } /* end for */
+    if ((*(src->shared->u.vlen.cls->read_batch))(src->shared->u.vlen.file, nseq, vl, bufs, sizes) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "can't read VL data")
+
+    /* Write the sequences to their destination locations */
+    for (u = 0; u < nseq; u++)
+        if ((*(dst->shared->u.vlen.cls->write))(dst->shared->u.vlen.file, vl_alloc_info, dst_elmts[u],
+                                                bufs[u], NULL, sizes[u] / base_size, base_size,
+                                                dst->shared->size) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_vlen_read_batch() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5T__conv_vlen
  *
@@ -3124,6 +3665,15 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
     void *                tmp_buf       = NULL;         /*temporary background buffer          */
     size_t                tmp_buf_size  = 0;            /*size of temporary bkg buffer         */
     hbool_t               nested        = FALSE;        /*flag of nested VL case             */
+    void **               batch_vl      = NULL;         /*destination elements of batched sequences */
+    const void **         batch_bufs    = NULL;         /*data of batched sequences written   */
+    const void **         batch_src     = NULL;         /*source elements of batched sequences read */
+    void **               batch_rbufs   = NULL;         /*buffers for batched sequences read  */
+    uint8_t *             batch_elmts   = NULL;         /*copies of source elements of batch read */
+    size_t *              batch_sizes   = NULL;         /*sizes of batched sequences in bytes */
+    size_t                batch_nalloc  = 0;            /*number of sequences a batch can hold */
+    size_t                batch_nused   = 0;            /*number of sequences in current batch */
+    size_t                batch_bytes   = 0;            /*bytes of data in current batch read */
     size_t                elmtno;                       /*element number counter         */
     herr_t                ret_value = SUCCEED;          /* Return value */
 
@@ -3247,6 +3797,33 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
             if (write_to_file && parent_is_vlen && bkg != NULL)
                 nested = TRUE;
 
+            /* When the sequences are written to the file straight from the
+             * caller's memory, gather them up and write them in batches */
+            if (write_to_file && noop_conv && dst->shared->u.vlen.cls->write_batch) {
+                batch_nalloc = MIN(nelmts, H5T_VLEN_BATCH_NELMTS);
+                if (NULL == (batch_vl = (void **)H5MM_malloc(batch_nalloc * sizeof(void *))) ||
+                    NULL == (batch_bufs = (const void **)H5MM_malloc(batch_nalloc * sizeof(void *))) ||
+                    NULL == (batch_sizes = (size_t *)H5MM_malloc(batch_nalloc * sizeof(size_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL,
+                                "memory allocation failed for type conversion")
+            } /* end if */
+
+            /* Likewise, when the sequences are read from the file into memory
+             * without conversion, gather them up so that each global heap
+             * collection is visited once per batch.  The source elements are
+             * copied, as the destination elements written before the batch is
+             * read may overlap them. */
+            else if (!write_to_file && noop_conv && src->shared->u.vlen.cls->read_batch) {
+                batch_nalloc = MIN(nelmts, H5T_VLEN_BATCH_NELMTS);
+                if (NULL == (batch_vl = (void **)H5MM_malloc(batch_nalloc * sizeof(void *))) ||
+                    NULL == (batch_src = (const void **)H5MM_malloc(batch_nalloc * sizeof(void *))) ||
+                    NULL == (batch_rbufs = (void **)H5MM_malloc(batch_nalloc * sizeof(void *))) ||
+                    NULL == (batch_elmts = (uint8_t *)H5MM_malloc(batch_nalloc * src->shared->size)) ||
+                    NULL == (batch_sizes = (size_t *)H5MM_malloc(batch_nalloc * sizeof(size_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL,
+                                "memory allocation failed for type conversion")
+            } /* end else-if */
+
             /* The outer loop of the type conversion macro, controlling which */
             /* direction the buffer is walked */
             while (nelmts > 0) {
@@ -3296,7 +3873,8 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
                         HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "can't check if VL data is 'nil'")
                     else if (is_nil) {
                         /* Write "nil" sequence to destination location */
-                        if ((*(dst->shared->u.vlen.cls->setnull))(dst->shared->u.vlen.file, d, b) < 0)
+                        if ((*(dst->shared->u.vlen.cls->setnull))(dst->shared->u.vlen.file, d, b,
+                                                                  dst->shared->size) < 0)
                             HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't set VL data to 'nil'")
                     } /* end else-if */
                     else {
@@ -3306,6 +3884,46 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
                         if ((*(src->shared->u.vlen.cls->getlen))(src->shared->u.vlen.file, s, &seq_len) < 0)
                             HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "bad sequence length")
 
+                        /* Add the sequence to the batch being read, reading the batch first
+                         * if it is full */
+                        if (batch_src) {
+                            size_t src_size = seq_len * src_base_size;
+
+                            if (batch_nused == batch_nalloc ||
+                                (batch_nused > 0 && batch_bytes + src_size > H5T_VLEN_READ_BATCH_SIZE)) {
+                                if (H5T__conv_vlen_read_batch(src, dst, &vl_alloc_info, batch_nused,
+                                                              batch_src, batch_vl, batch_rbufs, batch_sizes,
+                                                              (uint8_t *)conv_buf, dst_base_size) < 0)
+                                    HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "can't read VL data")
+                                batch_nused = 0;
+                                batch_bytes = 0;
+                            } /* end if */
+
+                            /* Make sure the conversion buffer can hold the whole batch */
+                            if (!conv_buf || conv_buf_size < batch_bytes + src_size) {
+                                conv_buf_size =
+                                    (((batch_bytes + src_size) / H5T_VLEN_MIN_CONF_BUF_SIZE) + 1) *
+                                    H5T_VLEN_MIN_CONF_BUF_SIZE;
+                                if (NULL == (conv_buf = H5FL_BLK_REALLOC(vlen_seq, conv_buf, conv_buf_size)))
+                                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL,
+                                                "memory allocation failed for type conversion")
+                            } /* end if */
+
+                            H5MM_memcpy(batch_elmts + batch_nused * src->shared->size, s, src->shared->size);
+                            batch_src[batch_nused]   = batch_elmts + batch_nused * src->shared->size;
+                            batch_vl[batch_nused]    = d;
+                            batch_sizes[batch_nused] = src_size;
+                            batch_bytes += src_size;
+                            batch_nused++;
+
+                            /* Advance pointers */
+                            s += s_stride;
+                            d += d_stride;
+                            b += b_stride;
+
+                            continue;
+                        } /* end if */
+
                         /* If we are reading from memory and there is no conversion, just get the pointer to
                          * sequence */
                         if (write_to_file && noop_conv) {
@@ -3344,6 +3962,32 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
                                 HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "can't read VL data")
                         } /* end else */
 
+                        /* Add the sequence to the current batch, writing the batch once it is full */
+                        if (batch_bufs) {
+                            /* Free heap object for old data */
+                            if (b && (*(dst->shared->u.vlen.cls->del))(dst->shared->u.vlen.file, b) < 0)
+                                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTREMOVE, FAIL,
+                                            "unable to remove background heap object")
+
+                            batch_vl[batch_nused]    = d;
+                            batch_bufs[batch_nused]  = conv_buf;
+                            batch_sizes[batch_nused] = seq_len * dst_base_size;
+                            if (++batch_nused == batch_nalloc) {
+                                if ((*(dst->shared->u.vlen.cls->write_batch))(
+                                        dst->shared->u.vlen.file, batch_nused, batch_vl, batch_bufs,
+                                        batch_sizes, dst_base_size) < 0)
+                                    HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
+                                batch_nused = 0;
+                            } /* end if */
+
+                            /* Advance pointers */
+                            s += s_stride;
+                            d += d_stride;
+                            b += b_stride;
+
+                            continue;
+                        } /* end if */
+
                         if (!noop_conv) {
                             /* Check if temporary buffer is large enough, resize if necessary */
                             /* (Chain off the conversion buffer size) */
@@ -3399,7 +4043,8 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
 
                         /* Write sequence to destination location */
                         if ((*(dst->shared->u.vlen.cls->write))(dst->shared->u.vlen.file, &vl_alloc_info, d,
-                                                                conv_buf, b, seq_len, dst_base_size) < 0)
+                                                                conv_buf, b, seq_len, dst_base_size,
+                                                                dst->shared->size) < 0)
                             HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
 
                         if (!noop_conv) {
@@ -3429,6 +4074,22 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
                     b += b_stride;
                 } /* end for */
 
+                /* Read or write any sequences left in the batch */
+                if (batch_nused > 0) {
+                    if (batch_src) {
+                        if (H5T__conv_vlen_read_batch(src, dst, &vl_alloc_info, batch_nused, batch_src,
+                                                      batch_vl, batch_rbufs, batch_sizes, (uint8_t *)conv_buf,
+                                                      dst_base_size) < 0)
+                            HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "can't read VL data")
+                    } /* end if */
+                    else if ((*(dst->shared->u.vlen.cls->write_batch))(dst->shared->u.vlen.file, batch_nused,
+                                                                       batch_vl, batch_bufs, batch_sizes,
+                                                                       dst_base_size) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
+                    batch_nused = 0;
+                    batch_bytes = 0;
+                } /* end if */
+
                 /* Decrement number of elements left to convert */
                 nelmts -= safe;
             } /* end while */
@@ -3454,6 +4115,13 @@ done:
     /* Release the background buffer, if we have one */
     if (tmp_buf)
         tmp_buf = H5FL_BLK_FREE(vlen_seq, tmp_buf);
+    /* Release the batch arrays */
+    H5MM_xfree(batch_vl);
+    H5MM_xfree(batch_bufs);
+    H5MM_xfree(batch_src);
+    H5MM_xfree(batch_rbufs);
+    H5MM_xfree(batch_elmts);
+    H5MM_xfree(batch_sizes);
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__conv_vlen() */
@@ -9485,6 +10153,7 @@ H5T_reclaim(hid_t type_id, H5S_t *space, void *buf)
     H5T_t *               type;             /* Datatype */
     H5S_sel_iter_op_t     dset_op;          /* Operator for iteration */
     H5T_vlen_alloc_info_t vl_alloc_info;    /* VL allocation info */
+    htri_t                reclaimed;        /* Whether the VL data was reclaimed at once */
     herr_t                ret_value = FAIL; /* Return value */
 
     FUNC_ENTER_NOAPI_NOINIT
@@ -9501,6 +10170,12 @@ H5T_reclaim(hid_t type_id, H5S_t *space, void *buf)
     if (H5CX_get_vlen_alloc_info(&vl_alloc_info) < 0)
         HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to retrieve VL allocation info")
 
+    /* Reclaim the VL data of the whole selection at once, if possible */
+    if ((reclaimed = H5T__vlen_reclaim_sel(type, space, buf, &vl_alloc_info)) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTFREE, FAIL, "unable to reclaim VL data")
+    if (reclaimed)
+        HGOTO_DONE(SUCCEED)
+
     /* Call H5S_select_iterate with args, etc. */
     dset_op.op_type  = H5S_SEL_ITER_OP_LIB;
     dset_op.u.lib_op = H5T_reclaim_cb;
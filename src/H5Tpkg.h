@@ -102,9 +102,14 @@
  */
 #define H5O_DTYPE_VERSION_4 4
 
+/* This is the version that adds support for storing short variable-length
+ * strings inline in the dataset element.
+ */
+#define H5O_DTYPE_VERSION_5 5
+
 /* The latest version of the format.  Look through the 'encode helper' routine
  *      and 'size' callback for places to change when updating this. */
-#define H5O_DTYPE_VERSION_LATEST H5O_DTYPE_VERSION_4
+#define H5O_DTYPE_VERSION_LATEST H5O_DTYPE_VERSION_5
 
 /* Flags for visiting datatype */
 #define H5T_VISIT_COMPLEX_FIRST 0x01 /* Visit complex datatype before visiting member/parent datatypes */
@@ -176,6 +181,7 @@ struct H5T_path_t {
     hbool_t         is_hard;           /*is it a hard function?	     */
     hbool_t         is_noop;           /*is it the noop conversion?	     */
     hbool_t         are_compounds;     /*are source and dest both compounds?*/
+    uint32_t        hash;              /*hash of source & dest types, for path table index */
     H5T_stats_t     stats;             /*statistics for the conversion	     */
     H5T_cdata_t     cdata;             /*data for this function	     */
 };
@@ -283,21 +289,28 @@ typedef enum {
 typedef herr_t (*H5T_vlen_getlen_func_t)(H5VL_object_t *file, const void *vl_addr, size_t *len);
 typedef void *(*H5T_vlen_getptr_func_t)(void *vl_addr);
 typedef herr_t (*H5T_vlen_isnull_func_t)(const H5VL_object_t *file, void *vl_addr, hbool_t *isnull);
-typedef herr_t (*H5T_vlen_setnull_func_t)(H5VL_object_t *file, void *_vl, void *_bg);
+typedef herr_t (*H5T_vlen_setnull_func_t)(H5VL_object_t *file, void *_vl, void *_bg, size_t elmt_size);
 typedef herr_t (*H5T_vlen_read_func_t)(H5VL_object_t *file, void *_vl, void *buf, size_t len);
 typedef herr_t (*H5T_vlen_write_func_t)(H5VL_object_t *file, const H5T_vlen_alloc_info_t *vl_alloc_info,
-                                        void *_vl, void *buf, void *_bg, size_t seq_len, size_t base_size);
+                                        void *_vl, void *buf, void *_bg, size_t seq_len, size_t base_size,
+                                        size_t elmt_size);
 typedef herr_t (*H5T_vlen_delete_func_t)(H5VL_object_t *file, const void *_vl);
+typedef herr_t (*H5T_vlen_read_batch_func_t)(H5VL_object_t *file, size_t nseq, const void *vl[], void *bufs[],
+                                             const size_t sizes[]);
+typedef herr_t (*H5T_vlen_write_batch_func_t)(H5VL_object_t *file, size_t nseq, void *vl[],
+                                              const void *bufs[], const size_t sizes[], size_t base_size);
 
 /* VL datatype callbacks */
 typedef struct H5T_vlen_class_t {
-    H5T_vlen_getlen_func_t  getlen;  /* Function to get VL sequence size (in element units, not bytes) */
-    H5T_vlen_getptr_func_t  getptr;  /* Function to get VL sequence pointer */
-    H5T_vlen_isnull_func_t  isnull;  /* Function to check if VL value is NIL */
-    H5T_vlen_setnull_func_t setnull; /* Function to set a VL value to NIL */
-    H5T_vlen_read_func_t    read;    /* Function to read VL sequence into buffer */
-    H5T_vlen_write_func_t   write;   /* Function to write VL sequence from buffer */
-    H5T_vlen_delete_func_t  del;     /* Function to delete VL sequence */
+    H5T_vlen_getlen_func_t      getlen;      /* Function to get VL sequence size (in elements, not bytes) */
+    H5T_vlen_getptr_func_t      getptr;      /* Function to get VL sequence pointer */
+    H5T_vlen_isnull_func_t      isnull;      /* Function to check if VL value is NIL */
+    H5T_vlen_setnull_func_t     setnull;     /* Function to set a VL value to NIL */
+    H5T_vlen_read_func_t        read;        /* Function to read VL sequence into buffer */
+    H5T_vlen_write_func_t       write;       /* Function to write VL sequence from buffer */
+    H5T_vlen_delete_func_t      del;         /* Function to delete VL sequence */
+    H5T_vlen_read_batch_func_t  read_batch;  /* Function to read several VL sequences at once */
+    H5T_vlen_write_batch_func_t write_batch; /* Function to write several VL sequences at once */
 } H5T_vlen_class_t;
 
 /* A VL datatype */
@@ -307,8 +320,9 @@ typedef struct H5T_vlen_t {
     H5T_cset_t      cset;         /* For VL string: character set */
     H5T_str_t       pad;          /* For VL string: space or null padding of
                                    * extra bytes */
-    H5VL_object_t *         file; /* File object (if VL data is on disk) */
-    const H5T_vlen_class_t *cls;  /* Pointer to VL class callbacks */
+    size_t                  inline_size; /* For VL string: longest string stored inline on disk */
+    H5VL_object_t *         file;        /* File object (if VL data is on disk) */
+    const H5T_vlen_class_t *cls;         /* Pointer to VL class callbacks */
 } H5T_vlen_t;
 
 /* An opaque datatype */
@@ -341,6 +355,8 @@ typedef struct H5T_shared_t {
     hbool_t     force_conv; /* Set if this type always needs to be converted and H5T__conv_noop cannot be called */
     struct H5T_t * parent;        /*parent type for derived datatypes	     */
     H5VL_object_t *owned_vol_obj; /* Vol object owned by this type (free on close) */
+    uint32_t       hash;          /* Structural hash of the type (valid if 'hash_valid' is set) */
+    hbool_t        hash_valid;    /* Whether 'hash' is cached (only for types that can't be modified) */
     union {
         H5T_atomic_t atomic; /* an atomic datatype              */
         H5T_compnd_t compnd; /* a compound datatype (struct)    */
@@ -483,6 +499,7 @@ H5_DLL H5T_t *H5T__alloc(void);
 H5_DLL herr_t H5T__free(H5T_t *dt);
 H5_DLL herr_t H5T__visit(H5T_t *dt, unsigned visit_flags, H5T_operator_t op, void *op_value);
 H5_DLL herr_t H5T__upgrade_version(H5T_t *dt, unsigned new_version);
+H5_DLL uint32_t H5T__hash(const H5T_t *dt);
 
 /* Committed / named datatype routines */
 H5_DLL herr_t H5T__commit_anon(H5F_t *file, H5T_t *type, hid_t tcpl_id);
@@ -859,6 +876,8 @@ H5_DLL void     H5T__bit_neg(uint8_t *buf, size_t start, size_t size);
 /* VL functions */
 H5_DLL H5T_t *H5T__vlen_create(const H5T_t *base);
 H5_DLL herr_t H5T__vlen_reclaim(void *elem, const H5T_t *dt, H5T_vlen_alloc_info_t *alloc_info);
+H5_DLL htri_t H5T__vlen_reclaim_sel(const H5T_t *dt, const struct H5S_t *space, void *buf,
+                                    const H5T_vlen_alloc_info_t *alloc_info);
 H5_DLL htri_t H5T__vlen_set_loc(const H5T_t *dt, H5VL_object_t *file, H5T_loc_t loc);
 
 /* Array functions */
@@ -889,4 +908,11 @@ H5_DLL herr_t H5T__sort_name(const H5T_t *dt, int *map);
 /* Debugging functions */
 H5_DLL herr_t H5T__print_stats(H5T_path_t *path, int *nprint /*in,out*/);
 
+#ifdef H5_HAVE_CONV_THREADS
+/* Conversion thread pool functions */
+H5_DLL herr_t H5T__pool_convert(H5T_path_t *tpath, hid_t src_id, hid_t dst_id, size_t nelmts,
+                                size_t buf_stride, void *buf, hbool_t *converted);
+H5_DLL void   H5T__pool_term(void);
+#endif /* H5_HAVE_CONV_THREADS */
+
 #endif /* _H5Tpkg_H */
@@ -0,0 +1,479 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Module Info: This module contains the pool of worker threads that share
+ *      the conversion of large buffers between datatypes, for conversion
+ *      functions that treat every element independently, the reclaiming
+ *      of large buffers of variable-length data, and the serializing of
+ *      metadata cache entries on flush.
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#include "H5Tmodule.h" /* This source code file is part of the H5T module */
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"   /* Generic Functions			*/
+#include "H5CXprivate.h" /* API Contexts                         */
+#include "H5Eprivate.h"  /* Error handling		  	*/
+#include "H5MMprivate.h" /* Memory management			*/
+#include "H5Tpkg.h"      /* Datatypes				*/
+
+#ifdef H5_HAVE_CONV_THREADS
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Largest number of threads (including the calling thread) used for one job */
+#define H5T_POOL_MAX_THREADS 64
+
+/* L2 cache size to assume when the system doesn't report it */
+#define H5T_POOL_DEF_L2_SIZE (256 * 1024)
+
+/* Smallest block of the conversion buffer handed to one thread */
+#define H5T_POOL_MIN_BLOCK_SIZE (16 * 1024)
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+/* A job shared among the threads of the pool */
+typedef struct H5T_pool_job_t {
+    H5T_pool_op_t op;          /* Operation on one block */
+    void *        op_data;     /* Operation's data */
+    size_t        nblocks;     /* # of blocks */
+    size_t        next_block;  /* Next block to hand out */
+    size_t        blocks_done; /* # of blocks done */
+    hbool_t       failed;      /* Whether the operation failed on any block */
+    void *        api_ctx;     /* API context of the calling thread */
+} H5T_pool_job_t;
+
+/* A conversion shared among the threads of the pool */
+typedef struct H5T_pool_conv_t {
+    H5T_path_t *tpath;        /* Conversion path */
+    hid_t       src_id;       /* Source datatype ID */
+    hid_t       dst_id;       /* Destination datatype ID */
+    uint8_t *   buf;          /* Conversion buffer */
+    size_t      nelmts;       /* Total # of elements to convert */
+    size_t      block_nelmts; /* # of elements in each block */
+    size_t      block_size;   /* Size of each block's region of the buffer, in bytes */
+} H5T_pool_conv_t;
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static size_t H5T__pool_block_size(void);
+static void   H5T__pool_grow(unsigned nworkers);
+static herr_t H5T__pool_convert_block(void *op_data, size_t block);
+static void * H5T__pool_worker(void *arg);
+static void   H5T__pool_atfork_child(void);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Lock protecting the pool's state and the current job's block counters */
+static pthread_mutex_t H5T_pool_mutex_g = PTHREAD_MUTEX_INITIALIZER;
+
+/* Signaled when there are blocks to work on, or the pool is shutting down */
+static pthread_cond_t H5T_pool_work_cond_g = PTHREAD_COND_INITIALIZER;
+
+/* Signaled when the last block of the current job is done */
+static pthread_cond_t H5T_pool_done_cond_g = PTHREAD_COND_INITIALIZER;
+
+static pthread_t *     H5T_pool_threads_g    = NULL;  /* Worker threads */
+static unsigned        H5T_pool_nthreads_g   = 0;     /* # of worker threads */
+static H5T_pool_job_t *H5T_pool_job_g        = NULL;  /* Current job, if any */
+static hbool_t         H5T_pool_shutdown_g   = FALSE; /* Whether the workers should exit */
+static hbool_t         H5T_pool_atfork_g     = FALSE; /* Whether the fork handler is installed */
+static size_t          H5T_pool_block_size_g = 0;     /* Size of a block, in bytes */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__pool_block_size
+ *
+ * Purpose:     Determine how many bytes of the conversion buffer to hand to
+ *              a thread at a time: half of the L2 cache, so that a block
+ *              stays in cache while it's converted in place.
+ *
+ * Return:      Size of a block, in bytes (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__pool_block_size(void)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    if (0 == H5T_pool_block_size_g) {
+        long l2_size = -1; /* Size of the L2 cache */
+
+#ifdef _SC_LEVEL2_CACHE_SIZE
+        l2_size = HDsysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif /* _SC_LEVEL2_CACHE_SIZE */
+        if (l2_size <= 0)
+            l2_size = H5T_POOL_DEF_L2_SIZE;
+
+        H5T_pool_block_size_g = MAX((size_t)l2_size / 2, H5T_POOL_MIN_BLOCK_SIZE);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(H5T_pool_block_size_g)
+} /* end H5T__pool_block_size() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__pool_grow
+ *
+ * Purpose:     Start worker threads until there are NWORKERS of them.
+ *
+ * Note:        Running short of threads isn't an error, the calling thread
+ *              works on whatever blocks the workers don't pick up.
+ *
+ * Return:      <none>
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__pool_grow(unsigned nworkers)
+{
+    pthread_t *threads; /* Resized array of worker threads */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if (nworkers > H5T_pool_nthreads_g) {
+        /* Workers don't survive fork(), so forget them in the child */
+        if (!H5T_pool_atfork_g)
+            if (0 == HDpthread_atfork(NULL, NULL, H5T__pool_atfork_child))
+                H5T_pool_atfork_g = TRUE;
+
+        if (NULL != (threads = (pthread_t *)H5MM_realloc(H5T_pool_threads_g, nworkers * sizeof(pthread_t)))) {
+            H5T_pool_threads_g = threads;
+            while (H5T_pool_nthreads_g < nworkers &&
+                   0 == HDpthread_create(&H5T_pool_threads_g[H5T_pool_nthreads_g], NULL, H5T__pool_worker,
+                                         NULL))
+                H5T_pool_nthreads_g++;
+        } /* end if */
+    }     /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__pool_grow() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__pool_convert_block
+ *
+ * Purpose:     Convert one block of a conversion's buffer, in place.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__pool_convert_block(void *op_data, size_t block)
+{
+    const H5T_pool_conv_t *conv = (const H5T_pool_conv_t *)op_data; /* Conversion */
+    size_t                 nelmts;                                  /* # of elements in this block */
+    herr_t                 ret_value;                               /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    nelmts    = MIN(conv->block_nelmts, conv->nelmts - block * conv->block_nelmts);
+    ret_value = (conv->tpath->conv.u.lib_func)(conv->src_id, conv->dst_id, &(conv->tpath->cdata), nelmts,
+                                               (size_t)0, (size_t)0, conv->buf + block * conv->block_size,
+                                               NULL);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__pool_convert_block() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__pool_worker
+ *
+ * Purpose:     Main routine of a worker thread: work on blocks of the
+ *              current job until the pool shuts down.
+ *
+ * Return:      NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5T__pool_worker(void H5_ATTR_UNUSED *arg)
+{
+    H5T_pool_job_t *job;    /* Current job */
+    size_t          block;  /* Block to work on */
+    herr_t          status; /* Result of the operation on the block */
+
+    HDpthread_mutex_lock(&H5T_pool_mutex_g);
+    while (!H5T_pool_shutdown_g) {
+        job = H5T_pool_job_g;
+        if (job && job->next_block < job->nblocks) {
+            block = job->next_block++;
+            HDpthread_mutex_unlock(&H5T_pool_mutex_g);
+
+            H5CX_set_shared_context(job->api_ctx);
+            status = (job->op)(job->op_data, block);
+            H5CX_set_shared_context(NULL);
+
+            HDpthread_mutex_lock(&H5T_pool_mutex_g);
+            if (status < 0)
+                job->failed = TRUE;
+            if (++job->blocks_done == job->nblocks)
+                HDpthread_cond_signal(&H5T_pool_done_cond_g);
+        } /* end if */
+        else
+            HDpthread_cond_wait(&H5T_pool_work_cond_g, &H5T_pool_mutex_g);
+    } /* end while */
+    HDpthread_mutex_unlock(&H5T_pool_mutex_g);
+
+    return NULL;
+} /* end H5T__pool_worker() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__pool_atfork_child
+ *
+ * Purpose:     Forget the worker threads in the child of a fork(), which
+ *              only has the thread that called fork().
+ *
+ * Return:      <none>
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__pool_atfork_child(void)
+{
+    H5T_pool_nthreads_g = 0;
+    H5T_pool_job_g      = NULL;
+} /* end H5T__pool_atfork_child() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T_pool_run
+ *
+ * Purpose:     Apply OP to each of NBLOCKS blocks of a job, sharing them
+ *              among the calling thread and up to NTHREADS - 1 worker
+ *              threads, and wait for all of them to be done.
+ *
+ *              OP is called with OP_DATA and the number of the block.  It
+ *              may run on any of the threads, with the API context of the
+ *              calling thread, which it must only read from.
+ *
+ * Return:      Non-negative on success/Negative on failure (when OP
+ *              failed on any block)
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T_pool_run(unsigned nthreads, size_t nblocks, H5T_pool_op_t op, void *op_data)
+{
+    H5T_pool_job_t job;                 /* Job shared with the workers */
+    herr_t         ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(op);
+
+    /* Start any worker threads that aren't running yet */
+    nthreads = MIN(nthreads, H5T_POOL_MAX_THREADS);
+    if (nthreads > 1)
+        H5T__pool_grow(nthreads - 1);
+
+    /* Set up the job */
+    HDmemset(&job, 0, sizeof(job));
+    job.op      = op;
+    job.op_data = op_data;
+    job.nblocks = nblocks;
+    job.api_ctx = H5CX_get_shared_context();
+
+    /* Hand the job to the workers, and work on blocks on this thread too */
+    HDpthread_mutex_lock(&H5T_pool_mutex_g);
+    H5T_pool_job_g = &job;
+    HDpthread_cond_broadcast(&H5T_pool_work_cond_g);
+    while (job.next_block < job.nblocks) {
+        size_t block = job.next_block++; /* Block to work on */
+        herr_t status;                   /* Result of the operation on the block */
+
+        HDpthread_mutex_unlock(&H5T_pool_mutex_g);
+        status = (op)(op_data, block);
+        HDpthread_mutex_lock(&H5T_pool_mutex_g);
+
+        if (status < 0)
+            job.failed = TRUE;
+        job.blocks_done++;
+    } /* end while */
+
+    /* Wait for the workers to finish their blocks */
+    while (job.blocks_done < job.nblocks)
+        HDpthread_cond_wait(&H5T_pool_done_cond_g, &H5T_pool_mutex_g);
+    H5T_pool_job_g = NULL;
+    HDpthread_mutex_unlock(&H5T_pool_mutex_g);
+
+    if (job.failed)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTOPERATE, FAIL, "operation failed on a block")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_pool_run() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__pool_convert
+ *
+ * Purpose:     Split the conversion of NELMTS elements in BUF across the
+ *              calling thread and the pool of worker threads, if the API
+ *              context's DXPL asks for more than one conversion thread and
+ *              the conversion qualifies.
+ *
+ *              Conversions qualify when the library's function for them
+ *              treats every element independently (hard conversions and
+ *              byte-order swaps), the buffer is packed and needs no
+ *              background buffer, no conversion exception callback is set,
+ *              and there are enough elements for at least two blocks.
+ *
+ *              Blocks are converted in place, each in its own region of
+ *              the buffer that is big enough for the larger of the source
+ *              and destination elements.  When elements grow, the source
+ *              data is spread out to those regions first; when they
+ *              shrink, the converted blocks are packed together afterward.
+ *
+ * Return:      Non-negative on success/Negative on failure.  *CONVERTED
+ *              is set to TRUE if the conversion was done here, and to
+ *              FALSE if the caller still has to do it.
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__pool_convert(H5T_path_t *tpath, hid_t src_id, hid_t dst_id, size_t nelmts, size_t buf_stride, void *_buf,
+                  hbool_t *converted)
+{
+    H5T_pool_conv_t conv;                   /* Conversion shared with the workers */
+    H5T_conv_cb_t   cb_struct;              /* Conversion exception callback */
+    uint8_t *       buf = (uint8_t *)_buf;  /* Conversion buffer */
+    size_t          src_size, dst_size;     /* Sizes of source & destination elements */
+    size_t          elmt_size;              /* Size of an element's region in a block */
+    size_t          block_nelmts;           /* # of elements in a block */
+    size_t          nblocks;                /* # of blocks */
+    unsigned        nthreads;               /* # of threads requested */
+    size_t          u;                      /* Local index variable */
+    herr_t          ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(tpath);
+    HDassert(converted);
+
+    *converted = FALSE;
+
+    /* Check for a library conversion of a packed buffer, with no background buffer */
+    if (tpath->conv.is_app || tpath->is_noop || buf_stride || NULL == tpath->src || NULL == tpath->dst ||
+        H5T_BKG_NO != tpath->cdata.need_bkg)
+        HGOTO_DONE(SUCCEED)
+
+    /* Check for a conversion function that treats every element independently */
+    if (!tpath->is_hard && tpath->conv.u.lib_func != H5T__conv_order &&
+        tpath->conv.u.lib_func != H5T__conv_order_opt)
+        HGOTO_DONE(SUCCEED)
+
+    /* Check for enough elements to fill two blocks */
+    src_size     = tpath->src->shared->size;
+    dst_size     = tpath->dst->shared->size;
+    elmt_size    = MAX(src_size, dst_size);
+    block_nelmts = MAX(H5T__pool_block_size() / elmt_size, 1);
+    if (nelmts / 2 < block_nelmts)
+        HGOTO_DONE(SUCCEED)
+
+    /* Check whether the application asked for more threads */
+    if (H5CX_get_conv_threads(&nthreads) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to get datatype conversion thread count")
+    if (nthreads <= 1)
+        HGOTO_DONE(SUCCEED)
+
+    /* Exception callbacks could be invoked on any thread, so leave those
+     * conversions to the calling thread.  (Retrieving the callback also
+     * caches it in the API context, which the workers only read from.)
+     */
+    if (H5CX_get_dt_conv_cb(&cb_struct) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to get conversion exception callback")
+    if (cb_struct.func)
+        HGOTO_DONE(SUCCEED)
+
+    /* Set up the conversion */
+    conv.tpath        = tpath;
+    conv.src_id       = src_id;
+    conv.dst_id       = dst_id;
+    conv.buf          = buf;
+    conv.nelmts       = nelmts;
+    conv.block_nelmts = block_nelmts;
+    conv.block_size   = block_nelmts * elmt_size;
+    nblocks           = (nelmts + block_nelmts - 1) / block_nelmts;
+
+    /* Spread growing source elements out to their blocks' regions, starting
+     * at the end so that no block's source data is overwritten before it's
+     * moved
+     */
+    if (dst_size > src_size)
+        for (u = nblocks - 1; u > 0; u--)
+            HDmemmove(buf + u * conv.block_size, buf + u * block_nelmts * src_size,
+                      MIN(block_nelmts, nelmts - u * block_nelmts) * src_size);
+
+    /* Convert the blocks */
+    if (H5T_pool_run(nthreads, nblocks, H5T__pool_convert_block, &conv) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
+
+    /* Pack shrunken destination elements together */
+    if (dst_size < src_size)
+        for (u = 1; u < nblocks; u++)
+            HDmemmove(buf + u * block_nelmts * dst_size, buf + u * conv.block_size,
+                      MIN(block_nelmts, nelmts - u * block_nelmts) * dst_size);
+
+    *converted = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__pool_convert() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__pool_term
+ *
+ * Purpose:     Stop the worker threads, when the library shuts down.
+ *
+ * Return:      <none>
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5T__pool_term(void)
+{
+    unsigned u; /* Local index variable */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (H5T_pool_nthreads_g > 0) {
+        HDpthread_mutex_lock(&H5T_pool_mutex_g);
+        H5T_pool_shutdown_g = TRUE;
+        HDpthread_cond_broadcast(&H5T_pool_work_cond_g);
+        HDpthread_mutex_unlock(&H5T_pool_mutex_g);
+
+        for (u = 0; u < H5T_pool_nthreads_g; u++)
+            HDpthread_join(H5T_pool_threads_g[u], NULL);
+
+        H5T_pool_nthreads_g = 0;
+        H5T_pool_shutdown_g = FALSE;
+    } /* end if */
+    H5T_pool_threads_g = (pthread_t *)H5MM_xfree(H5T_pool_threads_g);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__pool_term() */
+
+#endif /* H5_HAVE_CONV_THREADS */
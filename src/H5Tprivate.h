@@ -97,6 +97,9 @@ typedef struct H5T_subset_info_t {
     size_t       copy_size; /* Size in bytes, to copy for each element */
 } H5T_subset_info_t;
 
+/* Operation on one block of a job for the worker thread pool */
+typedef herr_t (*H5T_pool_op_t)(void *op_data, size_t block);
+
 /* Forward declarations for prototype arguments */
 struct H5O_shared_t;
 
@@ -172,4 +175,9 @@ H5_DLL int         H5T_get_offset(const H5T_t *dt);
 /* Fixed-point functions */
 H5_DLL H5T_sign_t H5T_get_sign(H5T_t const *dt);
 
+#ifdef H5_HAVE_CONV_THREADS
+/* Worker thread pool functions */
+H5_DLL herr_t H5T_pool_run(unsigned nthreads, size_t nblocks, H5T_pool_op_t op, void *op_data);
+#endif /* H5_HAVE_CONV_THREADS */
+
 #endif /* _H5Tprivate_H */
@@ -2258,6 +2258,29 @@ H5_DLL H5T_cset_t H5Tget_cset(hid_t type_id);
  *
  */
 H5_DLL htri_t H5Tis_variable_str(hid_t type_id);
+/**
+ * \ingroup ATOM
+ *
+ * \brief Retrieves the length of the longest variable-length string stored
+ *        inline in a datatype's elements
+ *
+ * \type_id
+ * \param[out] size Length, in bytes, of the longest string stored inline
+ *
+ * \return \herr_t
+ *
+ * \details H5Tget_str_inline() retrieves the length of the longest string
+ *          that is stored inline in the elements of the variable-length
+ *          string datatype \p type_id when it is written to a file.  A
+ *          length of zero means that all strings are stored in the global
+ *          heap.
+ *
+ * \see H5Tset_str_inline()
+ *
+ * \since 1.13.0
+ *
+ */
+H5_DLL herr_t H5Tget_str_inline(hid_t type_id, size_t *size /*out*/);
 /**
  * \ingroup H5T
  *
@@ -2680,6 +2703,41 @@ H5_DLL herr_t H5Tset_cset(hid_t type_id, H5T_cset_t cset);
  *
  */
 H5_DLL herr_t H5Tset_strpad(hid_t type_id, H5T_str_t strpad);
+/**
+ * \ingroup ATOM
+ *
+ * \brief Sets the length of the longest variable-length string to store
+ *        inline in a datatype's elements
+ *
+ * \type_id
+ * \param[in] size Length, in bytes, of the longest string to store inline
+ *
+ * \return \herr_t
+ *
+ * \details H5Tset_str_inline() sets the length of the longest string to
+ *          store directly in the elements of the variable-length string
+ *          datatype \p type_id when it is written to a file.  Strings of at
+ *          most \p size bytes are stored in the dataset or attribute element
+ *          itself, avoiding a global heap object and the extra read it
+ *          costs.  Longer strings are stored in the global heap, as usual.
+ *          A \p size of zero, the default, stores all the strings in the
+ *          global heap.
+ *
+ *          Each element on disk is four bytes larger than the larger of
+ *          \p size and the size of a global heap ID, whatever the length
+ *          of the string it holds.  Strings are still read and written
+ *          as \c char* in memory.
+ *
+ *          Storing strings inline requires a version of the datatype
+ *          message that can only be written when the high bound of the
+ *          library version bounds for the file is #H5F_LIBVER_LATEST.
+ *
+ * \see H5Tget_str_inline()
+ *
+ * \since 1.13.0
+ *
+ */
+H5_DLL herr_t H5Tset_str_inline(hid_t type_id, size_t size);
 
 /* Type conversion database */
 /**
@@ -28,21 +28,74 @@
 /***********/
 #include "H5private.h"   /* Generic Functions    */
 #include "H5CXprivate.h" /* API Contexts         */
+#include "H5Dprivate.h"  /* Datasets             */
 #include "H5Eprivate.h"  /* Error handling       */
 #include "H5Fpkg.h"      /* File                 */
+#include "H5FLprivate.h" /* Free Lists           */
 #include "H5Iprivate.h"  /* IDs                  */
 #include "H5MMprivate.h" /* Memory management    */
+#include "H5Sprivate.h"  /* Dataspaces           */
 #include "H5Tpkg.h"      /* Datatypes            */
 #include "H5VLprivate.h" /* Virtual Object Layer                     */
 
+#include "H5VLnative_private.h" /* Native VOL connector                     */
+
 /****************/
 /* Local Macros */
 /****************/
 
+/* Minimum number of sequences for a batched write to get global heap
+ * collections of its own; smaller batches fill existing collections */
+#define H5T_VLEN_DISK_BATCH_MIN 64
+
+/* Largest string that may be stored inline in a VL string element on disk */
+#define H5T_VLEN_INLINE_MAX 65535
+
+/* Flags and length mask for the 4-byte length of a VL string element with
+ * short strings stored inline.  An element with neither flag set is "nil". */
+#define H5T_VLEN_INLINE_FLAG_INLINE 0x40000000 /* String is stored in the element */
+#define H5T_VLEN_INLINE_FLAG_HEAP   0x80000000 /* String is stored in a blob, ID in the element */
+#define H5T_VLEN_INLINE_LEN_MASK    0x3fffffff /* Length of the string */
+
+/* Most VL fields in an element (or an element of a VL sequence) that are
+ * reclaimed by following a plan; the VL data of types with more fields is
+ * reclaimed element by element */
+#define H5T_VLEN_RECLAIM_MAX_OPS 4096
+
+/* Number of elements whose VL data one thread reclaims at a time */
+#define H5T_VLEN_RECLAIM_BLOCK_NELMTS 4096
+
 /******************/
 /* Local Typedefs */
 /******************/
 
+/* A VL field of an element, to reclaim */
+typedef struct H5T_vlen_reclaim_op_t {
+    size_t                          offset;    /* Offset of the field in the element */
+    hbool_t                         is_str;    /* Whether the field is a VL string, not a sequence */
+    size_t                          elmt_size; /* Size of the sequence's elements */
+    struct H5T_vlen_reclaim_plan_t *seq_plan;  /* Plan for the sequence's elements (NULL if no VL data) */
+} H5T_vlen_reclaim_op_t;
+
+/* Where the VL data of an element of a datatype is, for reclaiming it
+ * without walking the datatype for each element */
+typedef struct H5T_vlen_reclaim_plan_t {
+    size_t                 nops;   /* # of VL fields in an element */
+    size_t                 nalloc; /* # of VL fields allocated */
+    H5T_vlen_reclaim_op_t *ops;    /* VL fields, in order of offset */
+} H5T_vlen_reclaim_plan_t;
+
+/* A batch of sequences of elements of a selection, to reclaim in parallel */
+typedef struct H5T_vlen_reclaim_job_t {
+    const H5T_vlen_reclaim_plan_t *plan;       /* Plan for the elements */
+    const H5T_vlen_alloc_info_t *  alloc_info; /* VL allocation info */
+    uint8_t *                      buf;        /* Buffer with the elements */
+    size_t                         elmt_size;  /* Size of an element */
+    size_t                         nseq;       /* # of sequences */
+    const hsize_t *                off;        /* Offsets of sequences in the buffer, in bytes */
+    const size_t *                 start;      /* # of elements before each sequence (and in all) */
+} H5T_vlen_reclaim_job_t;
+
 /********************/
 /* Package Typedefs */
 /********************/
@@ -55,28 +108,53 @@
 static herr_t H5T__vlen_mem_seq_getlen(H5VL_object_t *file, const void *_vl, size_t *len);
 static void * H5T__vlen_mem_seq_getptr(void *_vl);
 static herr_t H5T__vlen_mem_seq_isnull(const H5VL_object_t *file, void *_vl, hbool_t *isnull);
-static herr_t H5T__vlen_mem_seq_setnull(H5VL_object_t *file, void *_vl, void *_bg);
+static herr_t H5T__vlen_mem_seq_setnull(H5VL_object_t *file, void *_vl, void *_bg, size_t elmt_size);
 static herr_t H5T__vlen_mem_seq_read(H5VL_object_t *file, void *_vl, void *_buf, size_t len);
 static herr_t H5T__vlen_mem_seq_write(H5VL_object_t *file, const H5T_vlen_alloc_info_t *vl_alloc_info,
-                                      void *_vl, void *_buf, void *_bg, size_t seq_len, size_t base_size);
+                                      void *_vl, void *_buf, void *_bg, size_t seq_len, size_t base_size,
+                                      size_t elmt_size);
 
 /* Memory-based VL string callbacks */
 static herr_t H5T__vlen_mem_str_getlen(H5VL_object_t *file, const void *_vl, size_t *len);
 static void * H5T__vlen_mem_str_getptr(void *_vl);
 static herr_t H5T__vlen_mem_str_isnull(const H5VL_object_t *file, void *_vl, hbool_t *isnull);
-static herr_t H5T__vlen_mem_str_setnull(H5VL_object_t *file, void *_vl, void *_bg);
+static herr_t H5T__vlen_mem_str_setnull(H5VL_object_t *file, void *_vl, void *_bg, size_t elmt_size);
 static herr_t H5T__vlen_mem_str_read(H5VL_object_t *file, void *_vl, void *_buf, size_t len);
 static herr_t H5T__vlen_mem_str_write(H5VL_object_t *file, const H5T_vlen_alloc_info_t *vl_alloc_info,
-                                      void *_vl, void *_buf, void *_bg, size_t seq_len, size_t base_size);
+                                      void *_vl, void *_buf, void *_bg, size_t seq_len, size_t base_size,
+                                      size_t elmt_size);
 
 /* Disk-based VL sequence (and string) callbacks */
 static herr_t H5T__vlen_disk_getlen(H5VL_object_t *file, const void *_vl, size_t *len);
 static herr_t H5T__vlen_disk_isnull(const H5VL_object_t *file, void *_vl, hbool_t *isnull);
-static herr_t H5T__vlen_disk_setnull(H5VL_object_t *file, void *_vl, void *_bg);
+static herr_t H5T__vlen_disk_setnull(H5VL_object_t *file, void *_vl, void *_bg, size_t elmt_size);
 static herr_t H5T__vlen_disk_read(H5VL_object_t *file, void *_vl, void *_buf, size_t len);
+static herr_t H5T__vlen_disk_read_batch(H5VL_object_t *file, size_t nseq, const void *vl[], void *bufs[],
+                                        const size_t sizes[]);
 static herr_t H5T__vlen_disk_write(H5VL_object_t *file, const H5T_vlen_alloc_info_t *vl_alloc_info, void *_vl,
-                                   void *_buf, void *_bg, size_t seq_len, size_t base_size);
+                                   void *_buf, void *_bg, size_t seq_len, size_t base_size, size_t elmt_size);
 static herr_t H5T__vlen_disk_delete(H5VL_object_t *file, const void *_vl);
+static herr_t H5T__vlen_disk_write_batch(H5VL_object_t *file, size_t nseq, void *vl[], const void *bufs[],
+                                         const size_t sizes[], size_t base_size);
+
+/* Disk-based VL string callbacks, for strings with short strings stored inline */
+static herr_t H5T__vlen_disk_inline_getlen(H5VL_object_t *file, const void *_vl, size_t *len);
+static herr_t H5T__vlen_disk_inline_isnull(const H5VL_object_t *file, void *_vl, hbool_t *isnull);
+static herr_t H5T__vlen_disk_inline_setnull(H5VL_object_t *file, void *_vl, void *_bg, size_t elmt_size);
+static herr_t H5T__vlen_disk_inline_read(H5VL_object_t *file, void *_vl, void *_buf, size_t len);
+static herr_t H5T__vlen_disk_inline_write(H5VL_object_t *file, const H5T_vlen_alloc_info_t *vl_alloc_info,
+                                          void *_vl, void *_buf, void *_bg, size_t seq_len, size_t base_size,
+                                          size_t elmt_size);
+static herr_t H5T__vlen_disk_inline_delete(H5VL_object_t *file, const void *_vl);
+
+/* Planned reclaiming of VL data */
+static htri_t H5T__vlen_reclaim_plan_add(H5T_vlen_reclaim_plan_t *plan, const H5T_t *dt, size_t offset);
+static herr_t H5T__vlen_reclaim_plan_free(H5T_vlen_reclaim_plan_t *plan);
+static void   H5T__vlen_reclaim_plan_apply(const H5T_vlen_reclaim_plan_t *plan, uint8_t *buf, size_t nelmts,
+                                           size_t elmt_size, const H5T_vlen_alloc_info_t *alloc_info);
+#ifdef H5_HAVE_CONV_THREADS
+static herr_t H5T__vlen_reclaim_block(void *op_data, size_t block);
+#endif /* H5_HAVE_CONV_THREADS */
 
 /*********************/
 /* Public Variables */
@@ -94,6 +172,18 @@ static herr_t H5T__vlen_disk_delete(H5VL_object_t *file, const void *_vl);
 /* Local Variables */
 /*******************/
 
+/* Declare a free list to manage the H5T_vlen_reclaim_plan_t struct */
+H5FL_DEFINE_STATIC(H5T_vlen_reclaim_plan_t);
+
+/* Declare extern free list to manage the H5S_sel_iter_t struct */
+H5FL_EXTERN(H5S_sel_iter_t);
+
+/* Declare extern free list to manage sequences of size_t */
+H5FL_SEQ_EXTERN(size_t);
+
+/* Declare extern free list to manage sequences of hsize_t */
+H5FL_SEQ_EXTERN(hsize_t);
+
 /* Class for VL sequences in memory */
 static const H5T_vlen_class_t H5T_vlen_mem_seq_g = {
     H5T__vlen_mem_seq_getlen,  /* 'getlen' */
@@ -102,7 +192,9 @@ static const H5T_vlen_class_t H5T_vlen_mem_seq_g = {
     H5T__vlen_mem_seq_setnull, /* 'setnull' */
     H5T__vlen_mem_seq_read,    /* 'read' */
     H5T__vlen_mem_seq_write,   /* 'write' */
-    NULL                       /* 'delete' */
+    NULL,                      /* 'delete' */
+    NULL,                      /* 'read_batch' */
+    NULL                       /* 'write_batch' */
 };
 
 /* Class for VL strings in memory */
@@ -113,18 +205,35 @@ static const H5T_vlen_class_t H5T_vlen_mem_str_g = {
     H5T__vlen_mem_str_setnull, /* 'setnull' */
     H5T__vlen_mem_str_read,    /* 'read' */
     H5T__vlen_mem_str_write,   /* 'write' */
-    NULL                       /* 'delete' */
+    NULL,                      /* 'delete' */
+    NULL,                      /* 'read_batch' */
+    NULL                       /* 'write_batch' */
 };
 
 /* Class for both VL strings and sequences in file */
 static const H5T_vlen_class_t H5T_vlen_disk_g = {
-    H5T__vlen_disk_getlen,  /* 'getlen' */
-    NULL,                   /* 'getptr' */
-    H5T__vlen_disk_isnull,  /* 'isnull' */
-    H5T__vlen_disk_setnull, /* 'setnull' */
-    H5T__vlen_disk_read,    /* 'read' */
-    H5T__vlen_disk_write,   /* 'write' */
-    H5T__vlen_disk_delete   /* 'delete' */
+    H5T__vlen_disk_getlen,     /* 'getlen' */
+    NULL,                      /* 'getptr' */
+    H5T__vlen_disk_isnull,     /* 'isnull' */
+    H5T__vlen_disk_setnull,    /* 'setnull' */
+    H5T__vlen_disk_read,       /* 'read' */
+    H5T__vlen_disk_write,      /* 'write' */
+    H5T__vlen_disk_delete,     /* 'delete' */
+    H5T__vlen_disk_read_batch, /* 'read_batch' */
+    H5T__vlen_disk_write_batch /* 'write_batch' */
+};
+
+/* Class for VL strings in file, with short strings stored inline */
+static const H5T_vlen_class_t H5T_vlen_disk_inline_g = {
+    H5T__vlen_disk_inline_getlen,  /* 'getlen' */
+    NULL,                          /* 'getptr' */
+    H5T__vlen_disk_inline_isnull,  /* 'isnull' */
+    H5T__vlen_disk_inline_setnull, /* 'setnull' */
+    H5T__vlen_disk_inline_read,    /* 'read' */
+    H5T__vlen_disk_inline_write,   /* 'write' */
+    H5T__vlen_disk_inline_delete,  /* 'delete' */
+    NULL,                          /* 'read_batch' */
+    NULL                           /* 'write_batch' */
 };
 
 /*-------------------------------------------------------------------------
@@ -168,6 +277,84 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Tvlen_create() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5Tset_str_inline
+ *
+ * Purpose:	Sets the length of the longest variable-length string to
+ *		store inline in each element of the datatype on disk.  Longer
+ *		strings are stored in the global heap, as usual.  A SIZE of
+ *		zero stores all the strings in the global heap.
+ *
+ *		Storing strings inline requires version 5 of the datatype
+ *		message.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Tset_str_inline(hid_t type_id, size_t size)
+{
+    H5T_t *dt        = NULL;    /* Datatype to modify */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", type_id, size);
+
+    /* Check args */
+    if (NULL == (dt = (H5T_t *)H5I_object_verify(type_id, H5I_DATATYPE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+    if (H5T_STATE_TRANSIENT != dt->shared->state)
+        HGOTO_ERROR(H5E_ARGS, H5E_CANTINIT, FAIL, "datatype is read-only")
+    if (H5T_VLEN != dt->shared->type || H5T_VLEN_STRING != dt->shared->u.vlen.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a variable-length string datatype")
+    if (size > H5T_VLEN_INLINE_MAX)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "inline string size is too large")
+
+    /* Commit */
+    dt->shared->u.vlen.inline_size = size;
+
+    /* Inline strings need a newer version of the datatype message */
+    if (size > 0 && dt->shared->version < H5O_DTYPE_VERSION_5)
+        dt->shared->version = H5O_DTYPE_VERSION_5;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Tset_str_inline() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Tget_str_inline
+ *
+ * Purpose:	Retrieves the length of the longest variable-length string
+ *		stored inline in each element of the datatype on disk.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Tget_str_inline(hid_t type_id, size_t *size /*out*/)
+{
+    H5T_t *dt        = NULL;    /* Datatype to query */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", type_id, size);
+
+    /* Check args */
+    if (NULL == (dt = (H5T_t *)H5I_object_verify(type_id, H5I_DATATYPE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+    if (H5T_VLEN != dt->shared->type || H5T_VLEN_STRING != dt->shared->u.vlen.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a variable-length string datatype")
+
+    /* Get value */
+    if (size)
+        *size = dt->shared->u.vlen.inline_size;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Tget_str_inline() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5T__vlen_create
  *
@@ -297,13 +484,24 @@ H5T__vlen_set_loc(const H5T_t *dt, H5VL_object_t *file, H5T_loc_t loc)
                                   &cont_info) < 0)
                     HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to get container info")
 
-                /* The datatype size is equal to 4 bytes for the sequence length
-                 * plus the size of a blob id */
-                dt->shared->size = 4 + cont_info.blob_id_size;
+                if (dt->shared->u.vlen.inline_size > 0) {
+                    /* The datatype size is equal to 4 bytes for the string length plus
+                     * room for either the longest inline string or a blob id */
+                    dt->shared->size = 4 + MAX(dt->shared->u.vlen.inline_size, cont_info.blob_id_size);
+
+                    /* Set up the function pointers to access the VL strings on disk */
+                    dt->shared->u.vlen.cls = &H5T_vlen_disk_inline_g;
+                } /* end if */
+                else {
+                    /* The datatype size is equal to 4 bytes for the sequence length
+                     * plus the size of a blob id */
+                    dt->shared->size = 4 + cont_info.blob_id_size;
 
-                /* Set up the function pointers to access the VL information on disk */
-                /* VL sequences and VL strings are stored identically on disk, so use the same functions */
-                dt->shared->u.vlen.cls = &H5T_vlen_disk_g;
+                    /* Set up the function pointers to access the VL information on disk */
+                    /* VL sequences and VL strings are stored identically on disk, so use the same
+                     * functions */
+                    dt->shared->u.vlen.cls = &H5T_vlen_disk_g;
+                } /* end else */
 
                 /* Set file ID (since this VL is on disk) */
                 dt->shared->u.vlen.file = file;
@@ -460,7 +658,8 @@ H5T__vlen_mem_seq_isnull(const H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, hb
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5T__vlen_mem_seq_setnull(H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, void H5_ATTR_UNUSED *_bg)
+H5T__vlen_mem_seq_setnull(H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, void H5_ATTR_UNUSED *_bg,
+                          size_t H5_ATTR_UNUSED elmt_size)
 {
     hvl_t vl; /* Temporary hvl_t to use during operation */
 
@@ -533,7 +732,8 @@ H5T__vlen_mem_seq_read(H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, void *buf,
  */
 static herr_t
 H5T__vlen_mem_seq_write(H5VL_object_t H5_ATTR_UNUSED *file, const H5T_vlen_alloc_info_t *vl_alloc_info,
-                        void *_vl, void *buf, void H5_ATTR_UNUSED *_bg, size_t seq_len, size_t base_size)
+                        void *_vl, void *buf, void H5_ATTR_UNUSED *_bg, size_t seq_len, size_t base_size,
+                        size_t H5_ATTR_UNUSED elmt_size)
 {
     hvl_t  vl;                  /* Temporary hvl_t to use during operation */
     herr_t ret_value = SUCCEED; /* Return value */
@@ -687,7 +887,8 @@ H5T__vlen_mem_str_isnull(const H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, hb
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5T__vlen_mem_str_setnull(H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, void H5_ATTR_UNUSED *_bg)
+H5T__vlen_mem_str_setnull(H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, void H5_ATTR_UNUSED *_bg,
+                          size_t H5_ATTR_UNUSED elmt_size)
 {
     char *t = NULL; /* Pointer to temporary buffer allocated */
 
@@ -752,7 +953,8 @@ H5T__vlen_mem_str_read(H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, void *buf,
  */
 static herr_t
 H5T__vlen_mem_str_write(H5VL_object_t H5_ATTR_UNUSED *file, const H5T_vlen_alloc_info_t *vl_alloc_info,
-                        void *_vl, void *buf, void H5_ATTR_UNUSED *_bg, size_t seq_len, size_t base_size)
+                        void *_vl, void *buf, void H5_ATTR_UNUSED *_bg, size_t seq_len, size_t base_size,
+                        size_t H5_ATTR_UNUSED elmt_size)
 {
     char * t;                   /* Pointer to temporary buffer allocated */
     size_t len;                 /* Maximum length of the string to copy */
@@ -864,7 +1066,7 @@ done:
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5T__vlen_disk_setnull(H5VL_object_t *file, void *_vl, void *bg)
+H5T__vlen_disk_setnull(H5VL_object_t *file, void *_vl, void *bg, size_t H5_ATTR_UNUSED elmt_size)
 {
     uint8_t *vl        = (uint8_t *)_vl; /* Pointer to the user's hvl_t information */
     herr_t   ret_value = SUCCEED;        /* Return value */
@@ -928,6 +1130,53 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__vlen_disk_read() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5T__vlen_disk_read_batch
+ *
+ * Purpose:	Reads NSEQ disk based VL elements at once.  VL[u] is the
+ *		element holding the u'th sequence, BUFS[u] the buffer to
+ *		read it into and SIZES[u] its size in bytes.
+ *
+ *		Files in the native connector read all the sequences with a
+ *		single batched global heap read; other connectors get one
+ *		blob 'get' per sequence.  The entries of VL are overwritten
+ *		with pointers to the elements' blob IDs.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_disk_read_batch(H5VL_object_t *file, size_t nseq, const void *vl[], void *bufs[],
+                          const size_t sizes[])
+{
+    size_t u;                   /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check parameters */
+    HDassert(file);
+    HDassert(0 == nseq || (vl && bufs && sizes));
+
+    /* Skip the length of each sequence */
+    for (u = 0; u < nseq; u++)
+        vl[u] = (const uint8_t *)vl[u] + 4;
+
+    /* Retrieve blobs */
+    if (H5_VOL_NATIVE == file->connector->cls->value) {
+        if (H5VL_native_blob_get_batch(file->data, nseq, vl, bufs, sizes) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to get blobs")
+    } /* end if */
+    else
+        for (u = 0; u < nseq; u++)
+            if (sizes[u] > 0 && H5VL_blob_get(file, vl[u], bufs[u], sizes[u], NULL) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to get blob")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_disk_read_batch() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5T__vlen_disk_write
  *
@@ -942,7 +1191,8 @@ done:
  */
 static herr_t
 H5T__vlen_disk_write(H5VL_object_t *file, const H5T_vlen_alloc_info_t H5_ATTR_UNUSED *vl_alloc_info,
-                     void *_vl, void *buf, void *_bg, size_t seq_len, size_t base_size)
+                     void *_vl, void *buf, void *_bg, size_t seq_len, size_t base_size,
+                     size_t H5_ATTR_UNUSED elmt_size)
 {
     uint8_t *      vl        = (uint8_t *)_vl;       /* Pointer to the user's hvl_t information */
     const uint8_t *bg        = (const uint8_t *)_bg; /* Pointer to the old data hvl_t */
@@ -971,6 +1221,61 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__vlen_disk_write() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5T__vlen_disk_write_batch
+ *
+ * Purpose:	Writes NSEQ disk based VL elements at once.  VL[u] is the
+ *		element to store the u'th sequence in, BUFS[u] its data and
+ *		SIZES[u] its size in bytes.  The elements must not refer to
+ *		existing heap objects (any background data must already have
+ *		been deleted).
+ *
+ *		Files in the native connector store batches of at least
+ *		H5T_VLEN_DISK_BATCH_MIN sequences with a single batched global
+ *		heap insert; smaller batches and other connectors get one
+ *		blob 'put' per sequence.  The entries of VL are overwritten
+ *		with pointers to the elements' blob IDs.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_disk_write_batch(H5VL_object_t *file, size_t nseq, void *vl[], const void *bufs[],
+                           const size_t sizes[], size_t base_size)
+{
+    size_t u;                   /* Local index variable */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* check parameters */
+    HDassert(file);
+    HDassert(0 == nseq || (vl && bufs && sizes));
+    HDassert(base_size > 0);
+
+    /* Set the length of each sequence, leaving VL pointing at the blob IDs */
+    for (u = 0; u < nseq; u++) {
+        uint8_t *p = (uint8_t *)vl[u];
+
+        UINT32ENCODE(p, sizes[u] / base_size);
+        vl[u] = p;
+    } /* end for */
+
+    /* Store blobs */
+    if (nseq >= H5T_VLEN_DISK_BATCH_MIN && H5_VOL_NATIVE == file->connector->cls->value) {
+        if (H5VL_native_blob_put_batch(file->data, nseq, bufs, sizes, vl) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTSET, FAIL, "unable to put blobs")
+    } /* end if */
+    else
+        for (u = 0; u < nseq; u++)
+            if (H5VL_blob_put(file, bufs[u], sizes[u], vl[u], NULL) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTSET, FAIL, "unable to put blob")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_disk_write_batch() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5T__vlen_disk_delete
  *
@@ -1011,6 +1316,233 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__vlen_disk_delete() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5T__vlen_disk_inline_getlen
+ *
+ * Purpose:	Retrieves the length of a disk based VL string with short
+ *		strings stored inline.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_disk_inline_getlen(H5VL_object_t H5_ATTR_UNUSED *file, const void *_vl, size_t *seq_len)
+{
+    const uint8_t *vl = (const uint8_t *)_vl; /* Pointer to the element */
+    uint32_t       word;                      /* Flags and length of the string */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Check parameters */
+    HDassert(vl);
+    HDassert(seq_len);
+
+    /* Get length of string, without the storage flags */
+    UINT32DECODE(vl, word);
+    *seq_len = (size_t)(word & H5T_VLEN_INLINE_LEN_MASK);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T__vlen_disk_inline_getlen() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__vlen_disk_inline_isnull
+ *
+ * Purpose:	Checks if a disk VL string with short strings stored inline
+ *		is the "nil" string
+ *
+ * Return:	Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_disk_inline_isnull(const H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, hbool_t *isnull)
+{
+    const uint8_t *vl = (const uint8_t *)_vl; /* Pointer to the element */
+    uint32_t       word;                      /* Flags and length of the string */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Check parameters */
+    HDassert(vl);
+    HDassert(isnull);
+
+    /* The string is "nil" if it isn't stored anywhere */
+    UINT32DECODE(vl, word);
+    *isnull = (0 == (word & (H5T_VLEN_INLINE_FLAG_INLINE | H5T_VLEN_INLINE_FLAG_HEAP)));
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T__vlen_disk_inline_isnull() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__vlen_disk_inline_setnull
+ *
+ * Purpose:	Sets a disk VL string with short strings stored inline to the
+ *		"nil" value.  ELMT_SIZE is the size of the element on disk.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_disk_inline_setnull(H5VL_object_t *file, void *_vl, void *bg, size_t elmt_size)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* check parameters */
+    HDassert(file);
+    HDassert(_vl);
+    HDassert(elmt_size > 4);
+
+    /* Free heap object for old data */
+    if (bg != NULL)
+        if (H5T__vlen_disk_inline_delete(file, bg) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTREMOVE, FAIL, "unable to remove background heap object")
+
+    /* An all-zero element is the "nil" string */
+    HDmemset(_vl, 0, elmt_size);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_disk_inline_setnull() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__vlen_disk_inline_read
+ *
+ * Purpose:	Reads a disk VL string with short strings stored inline into
+ *		a buffer, from the element itself or from its blob
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_disk_inline_read(H5VL_object_t *file, void *_vl, void *buf, size_t len)
+{
+    uint32_t       word;                             /* Flags and length of the string */
+    const uint8_t *vl        = (const uint8_t *)_vl; /* Pointer to the element */
+    herr_t         ret_value = SUCCEED;              /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check parameters */
+    HDassert(file);
+    HDassert(vl);
+    HDassert(buf);
+
+    /* Get the string's flags, leaving VL pointing at the string or blob ID */
+    UINT32DECODE(vl, word);
+
+    if (word & H5T_VLEN_INLINE_FLAG_INLINE)
+        H5MM_memcpy(buf, vl, len);
+    else if (word & H5T_VLEN_INLINE_FLAG_HEAP) {
+        if (H5VL_blob_get(file, vl, buf, len, NULL) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to get blob")
+    } /* end if */
+    else
+        HDassert(0 == len);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_disk_inline_read() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__vlen_disk_inline_write
+ *
+ * Purpose:	Writes a disk VL string with short strings stored inline
+ *		from a buffer.  Strings that fit in the ELMT_SIZE byte element
+ *		(after its 4-byte length) are copied into it, longer ones are
+ *		stored in a blob whose ID is put in the element.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_disk_inline_write(H5VL_object_t *file, const H5T_vlen_alloc_info_t H5_ATTR_UNUSED *vl_alloc_info,
+                            void *_vl, void *buf, void *_bg, size_t seq_len, size_t base_size,
+                            size_t elmt_size)
+{
+    uint8_t *vl        = (uint8_t *)_vl;      /* Pointer to the element */
+    size_t   len       = seq_len * base_size; /* Size of the string */
+    herr_t   ret_value = SUCCEED;             /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* check parameters */
+    HDassert(vl);
+    HDassert(seq_len == 0 || buf);
+    HDassert(file);
+    HDassert(elmt_size > 4);
+
+    if (seq_len > H5T_VLEN_INLINE_LEN_MASK)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_BADRANGE, FAIL, "VL string is too long to store")
+
+    /* Free heap object for old data, if non-NULL */
+    if (_bg != NULL)
+        if (H5T__vlen_disk_inline_delete(file, _bg) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTREMOVE, FAIL, "unable to remove background heap object")
+
+    /* Clear the element, so unused bytes are deterministic */
+    HDmemset(vl, 0, elmt_size);
+
+    if (len <= elmt_size - 4) {
+        /* Store the string in the element */
+        UINT32ENCODE(vl, (uint32_t)seq_len | H5T_VLEN_INLINE_FLAG_INLINE);
+        if (len > 0)
+            H5MM_memcpy(vl, buf, len);
+    } /* end if */
+    else {
+        /* Store the string in a blob */
+        UINT32ENCODE(vl, (uint32_t)seq_len | H5T_VLEN_INLINE_FLAG_HEAP);
+        if (H5VL_blob_put(file, buf, len, vl, NULL) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTSET, FAIL, "unable to put blob")
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_disk_inline_write() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__vlen_disk_inline_delete
+ *
+ * Purpose:	Deletes a disk VL string with short strings stored inline,
+ *		releasing its blob if it has one
+ *
+ * Return:	Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_disk_inline_delete(H5VL_object_t *file, const void *_vl)
+{
+    const uint8_t *vl        = (const uint8_t *)_vl; /* Pointer to the element */
+    herr_t         ret_value = SUCCEED;              /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check parameters */
+    HDassert(file);
+
+    /* Free heap object for old data */
+    if (vl != NULL) {
+        uint32_t word; /* Flags and length of the string */
+
+        /* Get flags of string */
+        UINT32DECODE(vl, word);
+
+        /* Delete object, if the string is stored in one */
+        if (word & H5T_VLEN_INLINE_FLAG_HEAP)
+            if (H5VL_blob_specific(file, (void *)vl, H5VL_BLOB_DELETE) < 0) /* Casting away 'const' OK */
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTREMOVE, FAIL, "unable to delete blob")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_disk_inline_delete() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5T__vlen_reclaim
  *
@@ -1173,3 +1705,371 @@ H5T_vlen_reclaim_elmt(void *elem, H5T_t *dt)
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5T_vlen_reclaim_elmt() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_reclaim_plan_add
+ *
+ * Purpose:     Add the VL fields of datatype DT, at OFFSET within an
+ *              element, to a reclaim plan.  Arrays and compound datatypes
+ *              are flattened into their VL fields, and each VL sequence
+ *              whose elements have VL data gets a plan of its own.
+ *
+ * Return:      Success:    TRUE if the fields were added, FALSE if the
+ *                          datatype can't be reclaimed with a plan
+ *                          (it has references, or too many VL fields)
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5T__vlen_reclaim_plan_add(H5T_vlen_reclaim_plan_t *plan, const H5T_t *dt, size_t offset)
+{
+    H5T_vlen_reclaim_op_t *op;               /* New VL field */
+    unsigned               u;                /* Local index variable */
+    htri_t                 ret_value = TRUE; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(plan);
+    HDassert(dt);
+
+    switch (dt->shared->type) {
+        case H5T_ARRAY:
+            if (H5T_IS_COMPLEX(dt->shared->parent->shared->type))
+                for (u = 0; u < dt->shared->u.array.nelem && ret_value == TRUE; u++)
+                    if ((ret_value = H5T__vlen_reclaim_plan_add(
+                             plan, dt->shared->parent, offset + u * dt->shared->parent->shared->size)) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "can't plan array element")
+            break;
+
+        case H5T_COMPOUND:
+            for (u = 0; u < dt->shared->u.compnd.nmembs && ret_value == TRUE; u++)
+                if (H5T_IS_COMPLEX(dt->shared->u.compnd.memb[u].type->shared->type)) {
+                    const H5T_cmemb_t *memb = &dt->shared->u.compnd.memb[u];
+
+                    if ((ret_value = H5T__vlen_reclaim_plan_add(plan, memb->type, offset + memb->offset)) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "can't plan compound field")
+                } /* end if */
+            break;
+
+        case H5T_VLEN:
+            if (plan->nops >= H5T_VLEN_RECLAIM_MAX_OPS)
+                HGOTO_DONE(FALSE)
+
+            /* Make room for the field */
+            if (plan->nops == plan->nalloc) {
+                size_t                 n_alloc = MAX(2 * plan->nalloc, 4); /* New # of fields allocated */
+                H5T_vlen_reclaim_op_t *ops;                                /* Resized array of fields */
+
+                if (NULL == (ops = (H5T_vlen_reclaim_op_t *)H5MM_realloc(plan->ops, n_alloc * sizeof(*ops))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for VL fields")
+                plan->ops    = ops;
+                plan->nalloc = n_alloc;
+            } /* end if */
+            op = &plan->ops[plan->nops++];
+            HDmemset(op, 0, sizeof(*op));
+            op->offset = offset;
+
+            if (dt->shared->u.vlen.type == H5T_VLEN_STRING)
+                op->is_str = TRUE;
+            else {
+                HDassert(dt->shared->u.vlen.type == H5T_VLEN_SEQUENCE);
+                op->elmt_size = dt->shared->parent->shared->size;
+
+                /* Plan for the sequence's elements, if they have VL data */
+                if (H5T_IS_COMPLEX(dt->shared->parent->shared->type)) {
+                    if (NULL == (op->seq_plan = H5FL_CALLOC(H5T_vlen_reclaim_plan_t)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for plan")
+                    if ((ret_value = H5T__vlen_reclaim_plan_add(op->seq_plan, dt->shared->parent, 0)) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "can't plan VL sequence elements")
+                    if (ret_value == TRUE && 0 == op->seq_plan->nops) {
+                        H5T__vlen_reclaim_plan_free(op->seq_plan);
+                        op->seq_plan = NULL;
+                    } /* end if */
+                }     /* end if */
+            }         /* end else */
+            break;
+
+        /* References are reclaimed element by element */
+        case H5T_REFERENCE:
+            ret_value = FALSE;
+            break;
+
+        /* Don't do anything for simple types */
+        case H5T_INTEGER:
+        case H5T_FLOAT:
+        case H5T_TIME:
+        case H5T_STRING:
+        case H5T_BITFIELD:
+        case H5T_OPAQUE:
+        case H5T_ENUM:
+            break;
+
+        /* Should never have these values */
+        case H5T_NO_CLASS:
+        case H5T_NCLASSES:
+        default:
+            HGOTO_ERROR(H5E_DATATYPE, H5E_BADRANGE, FAIL, "invalid VL datatype class")
+            break;
+    } /* end switch */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_reclaim_plan_add() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_reclaim_plan_free
+ *
+ * Purpose:     Release a reclaim plan, with the plans for its VL
+ *              sequences.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_reclaim_plan_free(H5T_vlen_reclaim_plan_t *plan)
+{
+    size_t u; /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if (plan) {
+        for (u = 0; u < plan->nops; u++)
+            H5T__vlen_reclaim_plan_free(plan->ops[u].seq_plan);
+        H5MM_xfree(plan->ops);
+        plan = H5FL_FREE(H5T_vlen_reclaim_plan_t, plan);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T__vlen_reclaim_plan_free() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_reclaim_plan_apply
+ *
+ * Purpose:     Free the VL data of NELMTS elements of ELMT_SIZE bytes
+ *              each in BUF, following a reclaim plan.  As in
+ *              H5T__vlen_reclaim(), the data in each VL sequence is
+ *              reclaimed before the sequence itself is freed.
+ *
+ * Return:      <none>
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__vlen_reclaim_plan_apply(const H5T_vlen_reclaim_plan_t *plan, uint8_t *buf, size_t nelmts,
+                             size_t elmt_size, const H5T_vlen_alloc_info_t *alloc_info)
+{
+    H5MM_free_t free_func = alloc_info->free_func; /* Free function */
+    void *      free_info = alloc_info->free_info; /* Free info */
+    size_t      u, v;                              /* Local index variables */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* (HDmemcpy() avoids alignment issues with packed compound datatypes) */
+    for (u = 0; u < nelmts; u++, buf += elmt_size)
+        for (v = 0; v < plan->nops; v++) {
+            const H5T_vlen_reclaim_op_t *op = &plan->ops[v]; /* VL field */
+            void *                       p;                  /* VL data to free */
+
+            if (op->is_str)
+                HDmemcpy(&p, buf + op->offset, sizeof(char *));
+            else {
+                hvl_t vl; /* VL sequence */
+
+                HDmemcpy(&vl, buf + op->offset, sizeof(hvl_t));
+                if (0 == vl.len)
+                    continue;
+                if (op->seq_plan)
+                    H5T__vlen_reclaim_plan_apply(op->seq_plan, (uint8_t *)vl.p, vl.len, op->elmt_size,
+                                                 alloc_info);
+                p = vl.p;
+            } /* end else */
+
+            if (free_func != NULL)
+                (*free_func)(p, free_info);
+            else
+                HDfree(p);
+        } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__vlen_reclaim_plan_apply() */
+
+#ifdef H5_HAVE_CONV_THREADS
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_reclaim_block
+ *
+ * Purpose:     Reclaim the VL data of one block of the elements of a batch
+ *              of sequences, on a thread of the conversion thread pool.
+ *
+ * Return:      Non-negative (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_reclaim_block(void *op_data, size_t block)
+{
+    const H5T_vlen_reclaim_job_t *job = (const H5T_vlen_reclaim_job_t *)op_data; /* Batch to reclaim */
+    size_t                        first, last; /* First and last + 1 elements of the block */
+    size_t                        lo, hi;      /* Bounds for searching for the first sequence */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    first = block * H5T_VLEN_RECLAIM_BLOCK_NELMTS;
+    last  = MIN(first + H5T_VLEN_RECLAIM_BLOCK_NELMTS, job->start[job->nseq]);
+
+    /* Find the sequence with the block's first element */
+    lo = 0;
+    hi = job->nseq;
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+
+        if (job->start[mid] <= first)
+            lo = mid;
+        else
+            hi = mid;
+    } /* end while */
+
+    /* Reclaim the block's part of each sequence */
+    while (first < last) {
+        size_t nelmts = MIN(last, job->start[lo + 1]) - first; /* # of elements in this sequence */
+
+        H5T__vlen_reclaim_plan_apply(
+            job->plan, job->buf + job->off[lo] + (first - job->start[lo]) * job->elmt_size, nelmts,
+            job->elmt_size, job->alloc_info);
+        first += nelmts;
+        lo++;
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T__vlen_reclaim_block() */
+#endif /* H5_HAVE_CONV_THREADS */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_reclaim_sel
+ *
+ * Purpose:     Free the VL data of the elements of datatype DT in BUF that
+ *              are selected in SPACE, without walking the datatype or
+ *              making a callback for each element.
+ *
+ *              A plan of where the VL data is in an element is made once,
+ *              and followed for each run of elements in the selection.
+ *              When the default memory manager is used and the API
+ *              context's DXPL asks for more than one conversion thread,
+ *              large runs are shared among the threads of the conversion
+ *              thread pool.
+ *
+ * Return:      Success:    TRUE if the VL data was freed, FALSE if the
+ *                          datatype can't be reclaimed this way and the
+ *                          caller must reclaim it element by element
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+htri_t
+H5T__vlen_reclaim_sel(const H5T_t *dt, const H5S_t *space, void *_buf,
+                      const H5T_vlen_alloc_info_t *alloc_info)
+{
+    H5T_vlen_reclaim_plan_t *plan      = NULL;            /* Plan for an element */
+    H5S_sel_iter_t *         iter      = NULL;            /* Selection iterator */
+    hbool_t                  iter_init = FALSE;           /* Whether the iterator is initialized */
+    hsize_t *                off       = NULL;            /* Offsets of sequences */
+    size_t *                 len       = NULL;            /* Lengths of sequences */
+    size_t *                 start     = NULL;            /* # of elements before each sequence */
+    uint8_t *                buf       = (uint8_t *)_buf; /* Buffer with the elements */
+    size_t                   elmt_size;                   /* Size of an element */
+    size_t                   max_elem;                    /* # of elements left in the selection */
+    unsigned                 nthreads  = 1;               /* # of threads to reclaim with */
+    htri_t                   ret_value = TRUE;            /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dt);
+    HDassert(space);
+    HDassert(buf);
+    HDassert(alloc_info);
+
+    /* Make the plan */
+    if (NULL == (plan = H5FL_CALLOC(H5T_vlen_reclaim_plan_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for plan")
+    if ((ret_value = H5T__vlen_reclaim_plan_add(plan, dt, 0)) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "can't plan reclaiming VL data")
+    if (FALSE == ret_value || 0 == plan->nops)
+        HGOTO_DONE(ret_value)
+
+#ifdef H5_HAVE_CONV_THREADS
+    /* Application free routines may not be thread-safe, but HDfree() is */
+    if (NULL == alloc_info->free_func)
+        if (H5CX_get_conv_threads(&nthreads) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to get datatype conversion thread count")
+#endif /* H5_HAVE_CONV_THREADS */
+
+    /* Set up to iterate over the selection's sequences of elements */
+    elmt_size = dt->shared->size;
+    if (NULL == (iter = H5FL_MALLOC(H5S_sel_iter_t)))
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTALLOC, FAIL, "can't allocate selection iterator")
+    if (H5S_select_iter_init(iter, space, elmt_size, 0) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator")
+    iter_init = TRUE;
+    if (NULL == (len = H5FL_SEQ_MALLOC(size_t, H5D_IO_VECTOR_SIZE)))
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTALLOC, FAIL, "can't allocate length vector array")
+    if (NULL == (off = H5FL_SEQ_MALLOC(hsize_t, H5D_IO_VECTOR_SIZE)))
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTALLOC, FAIL, "can't allocate offset vector array")
+    H5_CHECKED_ASSIGN(max_elem, size_t, H5S_GET_SELECT_NPOINTS(space), hsize_t);
+
+    while (max_elem > 0) {
+        size_t nelem; /* # of elements in the sequences */
+        size_t nseq;  /* # of sequences */
+        size_t u;     /* Local index variable */
+
+        if (H5S_SELECT_ITER_GET_SEQ_LIST(iter, (size_t)H5D_IO_VECTOR_SIZE, max_elem, &nseq, &nelem, off,
+                                         len) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, FAIL, "sequence length generation failed")
+
+#ifdef H5_HAVE_CONV_THREADS
+        /* Share enough elements for two blocks among the threads */
+        if (nthreads > 1 && nelem / 2 >= H5T_VLEN_RECLAIM_BLOCK_NELMTS) {
+            H5T_vlen_reclaim_job_t job; /* Batch shared with the threads */
+
+            if (NULL == start && NULL == (start = (size_t *)H5MM_malloc((H5D_IO_VECTOR_SIZE + 1) *
+                                                                         sizeof(size_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for sequences")
+            for (u = 0, start[0] = 0; u < nseq; u++)
+                start[u + 1] = start[u] + len[u] / elmt_size;
+
+            job.plan       = plan;
+            job.alloc_info = alloc_info;
+            job.buf        = buf;
+            job.elmt_size  = elmt_size;
+            job.nseq       = nseq;
+            job.off        = off;
+            job.start      = start;
+            if (H5T_pool_run(nthreads,
+                             (nelem + H5T_VLEN_RECLAIM_BLOCK_NELMTS - 1) / H5T_VLEN_RECLAIM_BLOCK_NELMTS,
+                             H5T__vlen_reclaim_block, &job) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTFREE, FAIL, "can't reclaim VL data")
+        } /* end if */
+        else
+#endif /* H5_HAVE_CONV_THREADS */
+            for (u = 0; u < nseq; u++)
+                H5T__vlen_reclaim_plan_apply(plan, buf + off[u], len[u] / elmt_size, elmt_size, alloc_info);
+
+        max_elem -= nelem;
+    } /* end while */
+
+done:
+    if (iter_init && H5S_SELECT_ITER_RELEASE(iter) < 0)
+        HDONE_ERROR(H5E_DATATYPE, H5E_CANTRELEASE, FAIL, "unable to release selection iterator")
+    if (iter)
+        iter = H5FL_FREE(H5S_sel_iter_t, iter);
+    if (len)
+        len = H5FL_SEQ_FREE(size_t, len);
+    if (off)
+        off = H5FL_SEQ_FREE(hsize_t, off);
+    H5MM_xfree(start);
+    H5T__vlen_reclaim_plan_free(plan);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_reclaim_sel() */
@@ -21,6 +21,7 @@
 #include "H5Eprivate.h"         /* Error handling                       */
 #include "H5Fprivate.h"         /* File access				*/
 #include "H5HGprivate.h"        /* Global Heaps				*/
+#include "H5MMprivate.h"        /* Memory management                    */
 #include "H5VLnative_private.h" /* Native VOL connector                 */
 
 /****************/
@@ -86,6 +87,56 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5VL__native_blob_put() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5VL_native_blob_put_batch
+ *
+ * Purpose:     Stores NBLOBS blobs at once, packing them into new global
+ *              heap collections rather than inserting them one at a time.
+ *              The encoded heap ID of each blob is written to the
+ *              corresponding entry of BLOB_IDS.
+ *
+ * Return:      SUCCEED / FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5VL_native_blob_put_batch(void *obj, size_t nblobs, const void *bufs[], const size_t sizes[],
+                           void *blob_ids[])
+{
+    H5F_t * f      = (H5F_t *)obj; /* Retrieve file pointer */
+    H5HG_t *hobjid = NULL;         /* New VL sequences' heap IDs */
+    size_t  u;                     /* Local index variable */
+    herr_t  ret_value = SUCCEED;   /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Check parameters */
+    HDassert(f);
+    HDassert(0 == nblobs || (bufs && sizes && blob_ids));
+
+    if (nblobs > 0) {
+        if (NULL == (hobjid = (H5HG_t *)H5MM_malloc(nblobs * sizeof(H5HG_t))))
+            HGOTO_ERROR(H5E_VOL, H5E_CANTALLOC, FAIL, "memory allocation failed for heap IDs")
+
+        /* Write the VL information to disk (allocates space also) */
+        if (H5HG_insert_batch(f, nblobs, sizes, bufs, hobjid) < 0)
+            HGOTO_ERROR(H5E_VOL, H5E_WRITEERROR, FAIL, "unable to write blob information")
+
+        /* Encode the heap information */
+        for (u = 0; u < nblobs; u++) {
+            uint8_t *id = (uint8_t *)blob_ids[u]; /* Pointer to blob ID */
+
+            H5F_addr_encode(f, &id, hobjid[u].addr);
+            UINT32ENCODE(id, hobjid[u].idx);
+        } /* end for */
+    }     /* end if */
+
+done:
+    H5MM_xfree(hobjid);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5VL_native_blob_put_batch() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5VL__native_blob_get
  *
@@ -132,6 +183,56 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5VL__native_blob_get() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5VL_native_blob_get_batch
+ *
+ * Purpose:     Retrieves NBLOBS blobs at once into the buffers BUFS,
+ *              visiting each global heap collection only once.  SIZES
+ *              gives the size of each blob; blobs of size zero are not
+ *              looked up.
+ *
+ * Return:      SUCCEED / FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5VL_native_blob_get_batch(void *obj, size_t nblobs, const void *blob_ids[], void *bufs[],
+                           const size_t sizes[])
+{
+    H5F_t * f      = (H5F_t *)obj; /* Retrieve file pointer */
+    H5HG_t *hobjid = NULL;         /* VL sequences' heap IDs */
+    size_t  u;                     /* Local index variable */
+    herr_t  ret_value = SUCCEED;   /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Check parameters */
+    HDassert(f);
+    HDassert(0 == nblobs || (blob_ids && bufs && sizes));
+
+    if (nblobs > 0) {
+        if (NULL == (hobjid = (H5HG_t *)H5MM_malloc(nblobs * sizeof(H5HG_t))))
+            HGOTO_ERROR(H5E_VOL, H5E_CANTALLOC, FAIL, "memory allocation failed for heap IDs")
+
+        /* Get the heap information */
+        for (u = 0; u < nblobs; u++) {
+            const uint8_t *id = (const uint8_t *)blob_ids[u]; /* Pointer to the disk blob ID */
+
+            H5F_addr_decode(f, &id, &hobjid[u].addr);
+            UINT32DECODE(id, hobjid[u].idx);
+        } /* end for */
+
+        /* Read the VL information from disk */
+        if (H5HG_read_batch(f, nblobs, hobjid, bufs, sizes) < 0)
+            HGOTO_ERROR(H5E_VOL, H5E_READERROR, FAIL, "unable to read VL information")
+    } /* end if */
+
+done:
+    H5MM_xfree(hobjid);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5VL_native_blob_get_batch() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5VL__native_blob_specific
  *
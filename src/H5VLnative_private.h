@@ -173,6 +173,10 @@ H5_DLL herr_t H5VL__native_get_file_addr_len(void *obj, H5I_type_t obj_type, siz
 H5_DLL herr_t H5VL_native_addr_to_token(void *obj, H5I_type_t obj_type, haddr_t addr, H5O_token_t *token);
 H5_DLL herr_t H5VL_native_token_to_addr(void *obj, H5I_type_t obj_type, H5O_token_t token, haddr_t *addr);
 H5_DLL herr_t H5VL_native_get_file_struct(void *obj, H5I_type_t type, H5F_t **file);
+H5_DLL herr_t H5VL_native_blob_put_batch(void *obj, size_t nblobs, const void *bufs[], const size_t sizes[],
+                                         void *blob_ids[]);
+H5_DLL herr_t H5VL_native_blob_get_batch(void *obj, size_t nblobs, const void *blob_ids[], void *bufs[],
+                                         const size_t sizes[]);
 
 #ifdef __cplusplus
 }
@@ -27,7 +27,7 @@
 #include "H5public.h" /* Include Public Definitions    */
 
 /* include the pthread header */
-#ifdef H5_HAVE_THREADSAFE
+#if defined(H5_HAVE_THREADSAFE) || defined(H5_HAVE_CONV_THREADS)
 #ifdef H5_HAVE_WIN32_API
 #ifndef H5_HAVE_WIN_THREADS
 #ifdef H5_HAVE_PTHREAD_H
@@ -39,7 +39,7 @@
 #include <pthread.h>
 #endif /* H5_HAVE_PTHREAD_H */
 #endif /* H5_HAVE_WIN32_API */
-#endif /* H5_HAVE_THREADSAFE */
+#endif /* defined(H5_HAVE_THREADSAFE) || defined(H5_HAVE_CONV_THREADS) */
 
 /*
  * Include ANSI-C header files.
@@ -122,6 +122,13 @@
 #include <sys/file.h>
 #endif
 
+/*
+ * preadv()/pwritev() in sys/uio.h are used by the sec2 driver for vector I/O.
+ */
+#ifdef H5_HAVE_PREADWRITEV
+#include <sys/uio.h>
+#endif
+
 /*
  * Resource usage is not Posix.1 but HDF5 uses it anyway for some performance
  * and debugging code if available.
@@ -1256,9 +1263,15 @@ typedef off_t       h5_stat_size_t;
 #ifndef HDpread
 #define HDpread(F, B, C, O) pread(F, B, C, O)
 #endif /* HDpread */
+#ifndef HDpreadv
+#define HDpreadv(F, V, C, O) preadv(F, V, C, O)
+#endif /* HDpreadv */
 #ifndef HDprintf
 #define HDprintf printf
 #endif /* HDprintf */
+#ifndef HDpthread_atfork
+#define HDpthread_atfork(P, A, C) pthread_atfork(P, A, C)
+#endif /* HDpthread_atfork */
 #ifndef HDpthread_attr_destroy
 #define HDpthread_attr_destroy(A) pthread_attr_destroy(A)
 #endif /* HDpthread_attr_destroy */
@@ -1268,6 +1281,9 @@ typedef off_t       h5_stat_size_t;
 #ifndef HDpthread_attr_setscope
 #define HDpthread_attr_setscope(A, S) pthread_attr_setscope(A, S)
 #endif /* HDpthread_attr_setscope */
+#ifndef HDpthread_cond_broadcast
+#define HDpthread_cond_broadcast(C) pthread_cond_broadcast(C)
+#endif /* HDpthread_cond_broadcast */
 #ifndef HDpthread_cond_init
 #define HDpthread_cond_init(C, A) pthread_cond_init(C, A)
 #endif /* HDpthread_cond_init */
@@ -1322,6 +1338,9 @@ typedef off_t       h5_stat_size_t;
 #ifndef HDpwrite
 #define HDpwrite(F, B, C, O) pwrite(F, B, C, O)
 #endif /* HDpwrite */
+#ifndef HDpwritev
+#define HDpwritev(F, V, C, O) pwritev(F, V, C, O)
+#endif /* HDpwritev */
 #ifndef HDqsort
 #define HDqsort(M, N, Z, F) qsort(M, N, Z, F)
 #endif /* HDqsort*/
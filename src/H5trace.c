@@ -594,7 +594,9 @@ H5_trace_args(H5RS_str_t *rs, const char *type, va_list ap)
                             H5RS_acat(rs, ", ");
                             H5_trace_args_bool(rs, cic.save_resize_status);
                             H5RS_acat(rs, ", ");
-                            H5RS_asprintf_cat(rs, "%d}", cic.entry_ageout);
+                            H5RS_asprintf_cat(rs, "%d, ", cic.entry_ageout);
+                            H5_trace_args_bool(rs, cic.compress_image);
+                            H5RS_acat(rs, "}");
                         } /* end block */
                         break;
 
@@ -1233,6 +1235,26 @@ H5_trace_args(H5RS_str_t *rs, const char *type, va_list ap)
                         } /* end block */
                         break;
 
+                        case 'l': /* H5F_mdc_log_format_t */
+                        {
+                            H5F_mdc_log_format_t log_format = (H5F_mdc_log_format_t)HDva_arg(ap, int);
+
+                            switch (log_format) {
+                                case H5F_MDC_LOG_FORMAT_JSON:
+                                    H5RS_acat(rs, "H5F_MDC_LOG_FORMAT_JSON");
+                                    break;
+
+                                case H5F_MDC_LOG_FORMAT_BINARY:
+                                    H5RS_acat(rs, "H5F_MDC_LOG_FORMAT_BINARY");
+                                    break;
+
+                                default:
+                                    H5RS_asprintf_cat(rs, "%ld", (long)log_format);
+                                    break;
+                            } /* end switch */
+                        }     /* end block */
+                        break;
+
                         case 'm': /* H5F_mem_t */
                         {
                             H5F_mem_t mem_type = (H5F_mem_t)HDva_arg(ap, int);
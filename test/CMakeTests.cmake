@@ -394,6 +394,7 @@ set (test_CLEANFILES
     test_swmr*.h5
     cache_logging.h5
     cache_logging.out
+    cache_logging.trace
     vds_swmr.h5
     vds_swmr_src_*.h5
     swmr*.h5
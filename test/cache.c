@@ -205,6 +205,10 @@ static void     cedds__H5C_make_space_in_cache(H5F_t *file_ptr);
 static void     cedds__H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t *file_ptr);
 static void     cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t *file_ptr);
 static unsigned check_stats(unsigned paged);
+static unsigned check_index_resize(unsigned paged);
+static unsigned check_scan_resistant_policy(unsigned paged);
+static unsigned check_read_ahead(unsigned paged);
+static unsigned check_shared_reads(unsigned paged);
 #if H5C_COLLECT_CACHE_STATS
 static void check_stats__smoke_check_1(H5F_t *file_ptr);
 #endif /* H5C_COLLECT_CACHE_STATS */
@@ -34670,19 +34674,17 @@ cedds__H5C__autoadjust__ageout__evict_aged_out_entries(H5F_t *file_ptr)
  *
  *              !!!!!!!!!!WARNING !!!!!!!!!!
  *
- *              This test may fail to function correctly if the hash
- *              table size or hash function is altered.
- *
  *              To setup the test, this function depends on the fact that
  *              H5C_flush_invalidate_cache() does alternating scans of the
  *              slist and the index.  If this changes, the test will likely
  *              also cease to function correctly.
  *
- *              The test relies on a known hash function and hash table
- *              size to select a set of test entries that will all hash
- *              to the same hash bucket -- call it the test hash bucket.
- *              It also relies on known behavior of the cache to place
- *              the entries in the test bucket in a known order.
+ *              The hash table is now resized dynamically and uses a
+ *              multiplicative hash, so the test no longer selects
+ *              entries that hash to the same bucket.  Instead, it relies
+ *              on the index list keeping entries in the order they were
+ *              inserted -- the entries below are the "test hash bucket"
+ *              in that order.
  *
  *              To avoid pre-mature flushes of the entries in the
  *              test hash bucket, all entries are initially clean,
@@ -34743,8 +34745,6 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t *file_ptr)
 {
     H5C_t *                   cache_ptr = file_ptr->shared->cache;
     int                       i;
-    int                       expected_hash_bucket = 0;
-    haddr_t                   entry_addr;
     test_entry_t *            entry_ptr;
     test_entry_t *            base_addr = NULL;
     struct H5C_cache_entry_t *scan_ptr;
@@ -34805,8 +34805,8 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t *file_ptr)
 
         H5C_stats__reset(cache_ptr);
 
-        /* load one dirty and three clean entries that should hash to the
-         * same hash bucket.
+        /* load one dirty and three clean entries, which will appear
+         * in this order on the index list.
          */
 
         protect_entry(file_ptr, MONSTER_ENTRY_TYPE, 0);
@@ -34818,30 +34818,6 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t *file_ptr)
         }
     }
 
-    if (pass) {
-
-        /* verify that the above entries hash to the same bucket */
-        base_addr  = entries[MONSTER_ENTRY_TYPE];
-        entry_ptr  = &(base_addr[0]);
-        entry_addr = entry_ptr->header.addr;
-
-        HDassert(entry_addr == entry_ptr->addr);
-
-        expected_hash_bucket = H5C__HASH_FCN(entry_addr);
-
-        for (i = 8; i <= 24; i += 8) {
-
-            entry_ptr  = &(base_addr[i]);
-            entry_addr = entry_ptr->header.addr;
-
-            if (expected_hash_bucket != H5C__HASH_FCN(entry_addr)) {
-
-                pass         = FALSE;
-                failure_mssg = "Test entries don't map to same bucket -- hash table size or hash fcn change?";
-            }
-        }
-    }
-
     if (pass) {
 
         /* setup the expunge flush operation:
@@ -34863,22 +34839,6 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t *file_ptr)
         unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, 31, H5C__DIRTIED_FLAG);
     }
 
-    if (pass) {
-
-        /* verify that the dirty entry doesn't map to the same
-         * hash bucket as the clean entries.
-         */
-
-        entry_ptr  = &(base_addr[31]);
-        entry_addr = entry_ptr->header.addr;
-
-        if (expected_hash_bucket == H5C__HASH_FCN(entry_addr)) {
-
-            pass         = FALSE;
-            failure_mssg = "Dirty entry maps to same hash bucket as clean entries?!?!";
-        }
-    }
-
     if (pass) {
 
         /* Next, create the flush dependency requiring (MET, 31) to
@@ -34910,24 +34870,11 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t *file_ptr)
 
     if (pass) {
 
-        /* now do some protect / unprotect cycles to force the
-         * entries into the desired order in the hash bucket.
-         * Recall that entries are moved to the head of the
-         * hash bucket list on lookup.
-         */
-
-        for (i = 24; i >= 0; i -= 8) {
-            protect_entry(file_ptr, MONSTER_ENTRY_TYPE, i);
-            unprotect_entry(file_ptr, MONSTER_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
-        }
-    }
-
-    if (pass) {
-
-        /* scan the hash bucket to verify that the expected entries appear
+        /* scan the index list to verify that the expected entries appear
          * in the expected order.
          */
-        scan_ptr = cache_ptr->index[expected_hash_bucket];
+        base_addr = entries[MONSTER_ENTRY_TYPE];
+        scan_ptr  = cache_ptr->il_head;
 
         i = 0;
 
@@ -34937,17 +34884,17 @@ cedds__H5C_flush_invalidate_cache__bucket_scan(H5F_t *file_ptr)
             if (scan_ptr == NULL) {
 
                 pass         = FALSE;
-                failure_mssg = "premature end of hash bucket list?!?!";
+                failure_mssg = "premature end of index list?!?!";
             }
             else if ((scan_ptr == NULL) || (scan_ptr != &(entry_ptr->header))) {
 
                 pass         = FALSE;
-                failure_mssg = "bad test hash bucket setup?!?!";
+                failure_mssg = "bad test index list setup?!?!";
             }
 
             if (pass) {
 
-                scan_ptr = scan_ptr->ht_next;
+                scan_ptr = scan_ptr->il_next;
                 i += 8;
             }
         }
@@ -35098,6 +35045,624 @@ check_stats(unsigned paged)
 
 } /* check_stats() */
 
+/*-------------------------------------------------------------------------
+ * Function:    check_index_resize()
+ *
+ * Purpose:     Verify that the hash table of the cache index grows as
+ *              entries are inserted, that every entry can still be found
+ *              while the entries are being moved to the new table, and
+ *              that the table shrinks again as the entries are removed.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static unsigned
+check_index_resize(unsigned paged)
+{
+    H5F_t *  file_ptr  = NULL;
+    H5C_t *  cache_ptr = NULL;
+    unsigned max_nbits = 0;
+    int32_t  i;
+
+    if (paged)
+        TESTING("cache index resizing (paged aggregation)")
+    else
+        TESTING("cache index resizing")
+
+    pass = TRUE;
+
+    reset_entries();
+
+    file_ptr = setup_cache((size_t)(2 * 1024 * 1024), (size_t)(1 * 1024 * 1024), paged);
+
+    if (pass) {
+
+        cache_ptr = file_ptr->shared->cache;
+
+        if ((cache_ptr->index_nbits != H5C__HASH_MIN_NBITS) || (cache_ptr->old_index != NULL)) {
+
+            pass         = FALSE;
+            failure_mssg = "unexpected index table size at start of check_index_resize().";
+        }
+    }
+
+    /* Insert enough entries to make the table double several times, and
+     * check that all of them can be found after each insertion.
+     */
+    for (i = 0; pass && i < NUM_PICO_ENTRIES; i++) {
+
+        insert_entry(file_ptr, PICO_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+
+        if (cache_ptr->index_nbits > max_nbits)
+            max_nbits = cache_ptr->index_nbits;
+
+        if (pass && (i % 1024 == 0 || cache_ptr->old_index != NULL)) {
+            int32_t j;
+
+            for (j = 0; pass && j <= i; j += (cache_ptr->old_index != NULL ? 97 : 1))
+                if (!entry_in_cache(cache_ptr, PICO_ENTRY_TYPE, j)) {
+
+                    pass         = FALSE;
+                    failure_mssg = "entry missing from index in check_index_resize().";
+                }
+        }
+    }
+
+    if (pass && (max_nbits <= H5C__HASH_MIN_NBITS ||
+                 H5C__HASH_NBUCKETS(max_nbits) < (size_t)cache_ptr->index_len / 2)) {
+
+        pass         = FALSE;
+        failure_mssg = "index table didn't grow in check_index_resize().";
+    }
+
+    /* Remove the entries, and check that the table shrinks */
+    for (i = 0; pass && i < NUM_PICO_ENTRIES; i++) {
+
+        expunge_entry(file_ptr, PICO_ENTRY_TYPE, i);
+
+        if (pass && (i + 1 < NUM_PICO_ENTRIES) && !entry_in_cache(cache_ptr, PICO_ENTRY_TYPE, i + 1)) {
+
+            pass         = FALSE;
+            failure_mssg = "entry missing from index while shrinking in check_index_resize().";
+        }
+    }
+
+    if (pass && ((cache_ptr->index_len != 0) || (cache_ptr->index_nbits >= max_nbits))) {
+
+        pass         = FALSE;
+        failure_mssg = "index table didn't shrink in check_index_resize().";
+    }
+
+    if (pass) {
+
+        takedown_cache(file_ptr, FALSE, FALSE);
+    }
+
+    if (pass) {
+        PASSED();
+    }
+    else {
+        H5_FAILED();
+    }
+
+    if (!pass) {
+
+        HDfprintf(stdout, "%s(): failure_mssg = \"%s\".\n", FUNC, failure_mssg);
+    }
+
+    return (unsigned)!pass;
+
+} /* check_index_resize() */
+
+/*-------------------------------------------------------------------------
+ * Function:    check_scan_resistant_policy()
+ *
+ * Purpose:     Verify that under the 2Q replacement policy, entries that
+ *              are used repeatedly survive a scan of many entries that
+ *              are used once, while under the LRU policy the same scan
+ *              evicts them.
+ *
+ *              The cache holds 256 small entries.  Both runs load 32
+ *              "hot" entries and 64 others, access the hot entries a
+ *              second time, and then scan 1024 entries that are not
+ *              accessed again.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static unsigned
+check_scan_resistant_policy(unsigned paged)
+{
+    H5F_t *                    file_ptr  = NULL;
+    H5C_t *                    cache_ptr = NULL;
+    enum H5C_cache_repl_policy policy;
+    int32_t                    num_hot;
+    int32_t                    i;
+    unsigned                   u;
+
+    if (paged)
+        TESTING("scan-resistant replacement policy (paged aggregation)")
+    else
+        TESTING("scan-resistant replacement policy")
+
+    pass = TRUE;
+
+    for (u = 0; pass && u < 2; u++) {
+
+        policy = (u == 0) ? H5C_repl__lru : H5C_repl__2q;
+
+        reset_entries();
+
+        file_ptr = setup_cache((size_t)(64 * 1024), (size_t)(32 * 1024), paged);
+
+        if (pass) {
+
+            cache_ptr = file_ptr->shared->cache;
+
+            if (H5C_set_repl_policy(cache_ptr, policy) < 0) {
+
+                pass         = FALSE;
+                failure_mssg = "H5C_set_repl_policy() failed in check_scan_resistant_policy().";
+            }
+        }
+
+        /* Load the hot entries, followed by enough other entries that
+         * a second access to the hot entries counts as reuse.
+         */
+        for (i = 0; pass && i < 96; i++) {
+
+            protect_entry(file_ptr, SMALL_ENTRY_TYPE, i);
+            unprotect_entry(file_ptr, SMALL_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+        }
+
+        for (i = 0; pass && i < 32; i++) {
+
+            protect_entry(file_ptr, SMALL_ENTRY_TYPE, i);
+            unprotect_entry(file_ptr, SMALL_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+        }
+
+        if (pass && ((policy == H5C_repl__2q) != (cache_ptr->rp_hot_size == 32 * SMALL_ENTRY_SIZE))) {
+
+            pass         = FALSE;
+            failure_mssg = "unexpected hot set size in check_scan_resistant_policy().";
+        }
+
+#if H5C_COLLECT_CACHE_STATS
+        if (pass && (cache_ptr->hot_promotions[SMALL_ENTRY_TYPE] != (policy == H5C_repl__2q ? 32 : 0))) {
+
+            pass         = FALSE;
+            failure_mssg = "unexpected hot promotions in check_scan_resistant_policy().";
+        }
+#endif /* H5C_COLLECT_CACHE_STATS */
+
+        /* Scan entries that are only used once */
+        for (i = 96; pass && i < 96 + 1024; i++) {
+
+            protect_entry(file_ptr, SMALL_ENTRY_TYPE, i);
+            unprotect_entry(file_ptr, SMALL_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+        }
+
+        num_hot = 0;
+        for (i = 0; pass && i < 32; i++)
+            if (entry_in_cache(cache_ptr, SMALL_ENTRY_TYPE, i))
+                num_hot++;
+
+        if (pass && (num_hot != (policy == H5C_repl__2q ? 32 : 0))) {
+
+            pass         = FALSE;
+            failure_mssg = "unexpected hot entries in cache after scan in check_scan_resistant_policy().";
+        }
+
+        /* Entries loaded before the scan that were not reused are gone
+         * under either policy.
+         */
+        for (i = 32; pass && i < 96; i++)
+            if (entry_in_cache(cache_ptr, SMALL_ENTRY_TYPE, i)) {
+
+                pass         = FALSE;
+                failure_mssg = "cold entry survived scan in check_scan_resistant_policy().";
+            }
+
+#if H5C_COLLECT_CACHE_STATS
+        if (pass && (policy == H5C_repl__2q) && (cache_ptr->hot_second_chances[SMALL_ENTRY_TYPE] == 0)) {
+
+            pass         = FALSE;
+            failure_mssg = "no second chances counted in check_scan_resistant_policy().";
+        }
+#endif /* H5C_COLLECT_CACHE_STATS */
+
+        /* Switching back to LRU empties the hot set */
+        if (pass && ((H5C_set_repl_policy(cache_ptr, H5C_repl__lru) < 0) || (cache_ptr->rp_hot_size != 0))) {
+
+            pass         = FALSE;
+            failure_mssg = "H5C_set_repl_policy() didn't reset hot set in check_scan_resistant_policy().";
+        }
+
+        if (pass) {
+
+            takedown_cache(file_ptr, FALSE, FALSE);
+        }
+    }
+
+    if (pass) {
+        PASSED();
+    }
+    else {
+        H5_FAILED();
+    }
+
+    if (!pass) {
+
+        HDfprintf(stdout, "%s(): failure_mssg = \"%s\".\n", FUNC, failure_mssg);
+    }
+
+    return (unsigned)!pass;
+
+} /* check_scan_resistant_policy() */
+
+/*-------------------------------------------------------------------------
+ * Function:    check_read_ahead()
+ *
+ * Purpose:     Verify that H5C_prefetch_entries() reads ahead the images
+ *              of entries that are not in the cache, that the images are
+ *              used when the entries are protected, and that an image is
+ *              discarded when an entry is inserted over it.
+ *
+ *              16 small entries are written to the file and evicted, and
+ *              one of them is loaded again.  Reading ahead all 16 must
+ *              read the other 15, and after entry 5 has been inserted
+ *              anew, protecting the remaining 14 must use up the images.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static unsigned
+check_read_ahead(unsigned paged)
+{
+    H5F_t *            file_ptr  = NULL;
+    H5C_t *            cache_ptr = NULL;
+    H5C_prefetch_req_t reqs[16];
+    int32_t            i;
+
+    if (paged)
+        TESTING("reading ahead entry images (paged aggregation)")
+    else
+        TESTING("reading ahead entry images")
+
+    pass = TRUE;
+
+    reset_entries();
+
+    file_ptr = setup_cache((size_t)(2 * 1024 * 1024), (size_t)(1 * 1024 * 1024), paged);
+
+    if (pass)
+        cache_ptr = file_ptr->shared->cache;
+
+    /* Write the entries to the file and empty the cache */
+    for (i = 0; pass && i < 16; i++)
+        insert_entry(file_ptr, SMALL_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+
+    if (pass)
+        flush_cache(file_ptr, TRUE, FALSE, FALSE);
+
+    /* Entry 0 is in the cache again, and mustn't be read ahead */
+    protect_entry(file_ptr, SMALL_ENTRY_TYPE, 0);
+    unprotect_entry(file_ptr, SMALL_ENTRY_TYPE, 0, H5C__NO_FLAGS_SET);
+
+#if H5C_COLLECT_CACHE_STATS
+    if (pass)
+        H5C_stats__reset(cache_ptr);
+#endif /* H5C_COLLECT_CACHE_STATS */
+
+    if (pass) {
+
+        for (i = 0; i < 16; i++) {
+
+            reqs[i].type = types[SMALL_ENTRY_TYPE];
+            reqs[i].addr = entries[SMALL_ENTRY_TYPE][i].addr;
+            reqs[i].len  = entries[SMALL_ENTRY_TYPE][i].size;
+        }
+
+        if (H5C_prefetch_entries(file_ptr, (size_t)16, reqs) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "H5C_prefetch_entries() failed in check_read_ahead().";
+        }
+        else if (cache_ptr->ra_size != 15 * SMALL_ENTRY_SIZE) {
+
+            pass         = FALSE;
+            failure_mssg = "unexpected size of images read ahead in check_read_ahead().";
+        }
+    }
+
+    /* Inserting an entry discards its image */
+    insert_entry(file_ptr, SMALL_ENTRY_TYPE, 5, H5C__NO_FLAGS_SET);
+
+    if (pass && (cache_ptr->ra_size != 14 * SMALL_ENTRY_SIZE)) {
+
+        pass         = FALSE;
+        failure_mssg = "image not discarded on insertion in check_read_ahead().";
+    }
+
+    /* Loading the other entries uses up the images */
+    for (i = 1; pass && i < 16; i++) {
+
+        if (i == 5)
+            continue;
+
+        protect_entry(file_ptr, SMALL_ENTRY_TYPE, i);
+        unprotect_entry(file_ptr, SMALL_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+    }
+
+    if (pass && ((cache_ptr->ra_head != NULL) || (cache_ptr->ra_size != 0))) {
+
+        pass         = FALSE;
+        failure_mssg = "images left after loading entries in check_read_ahead().";
+    }
+
+#if H5C_COLLECT_CACHE_STATS
+    if (pass && ((cache_ptr->read_aheads != 1) || (cache_ptr->read_ahead_images != 15) ||
+                 (cache_ptr->read_ahead_hits != 14))) {
+
+        pass         = FALSE;
+        failure_mssg = "unexpected read-ahead stats in check_read_ahead().";
+    }
+#endif /* H5C_COLLECT_CACHE_STATS */
+
+    if (pass) {
+
+        takedown_cache(file_ptr, FALSE, FALSE);
+    }
+
+    if (pass) {
+        PASSED();
+    }
+    else {
+        H5_FAILED();
+    }
+
+    if (!pass) {
+
+        HDfprintf(stdout, "%s(): failure_mssg = \"%s\".\n", FUNC, failure_mssg);
+    }
+
+    return (unsigned)!pass;
+
+} /* check_read_ahead() */
+
+/*-------------------------------------------------------------------------
+ * Function:    check_shared_reads()
+ *
+ * Purpose:     Verify that H5C_protect_shared() finds the clean entries
+ *              of the cache and nothing else, and that entries held by
+ *              shared readers are neither evicted nor expunged.
+ *
+ *              Entries are then removed one at a time, so that the index
+ *              shrinks, and the entries left must be found throughout.
+ *              Lookups from several threads at once are tested in
+ *              ttsafe_shared_reads.c.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static unsigned
+check_shared_reads(unsigned paged)
+{
+    H5F_t * file_ptr   = NULL;
+    H5C_t * cache_ptr  = NULL;
+    void *  thing      = NULL;
+    hbool_t saw_resize = FALSE;
+    herr_t  result;
+    int32_t i;
+
+    if (paged)
+        TESTING("shared reads of cache entries (paged aggregation)")
+    else
+        TESTING("shared reads of cache entries")
+
+    pass = TRUE;
+
+    reset_entries();
+
+    file_ptr = setup_cache((size_t)(2 * 1024 * 1024), (size_t)(1 * 1024 * 1024), paged);
+
+    if (pass)
+        cache_ptr = file_ptr->shared->cache;
+
+    for (i = 0; pass && i < 16; i++)
+        insert_entry(file_ptr, SMALL_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+
+    if (pass)
+        flush_cache(file_ptr, FALSE, FALSE, FALSE);
+
+    /* Nothing is found until shared reads are enabled */
+    if (pass) {
+
+        if (NULL != H5C_protect_shared(cache_ptr, types[SMALL_ENTRY_TYPE], entries[SMALL_ENTRY_TYPE][0].addr)) {
+
+            pass         = FALSE;
+            failure_mssg = "entry found before enabling shared reads in check_shared_reads().";
+        }
+        else if (H5C_enable_shared_reads(cache_ptr) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "H5C_enable_shared_reads() failed in check_shared_reads().";
+        }
+    }
+
+    /* Clean entries are found, with the right class only */
+    if (pass) {
+
+        thing = H5C_protect_shared(cache_ptr, types[SMALL_ENTRY_TYPE], entries[SMALL_ENTRY_TYPE][0].addr);
+
+        if (thing != (void *)&(entries[SMALL_ENTRY_TYPE][0])) {
+
+            pass         = FALSE;
+            failure_mssg = "clean entry not found in check_shared_reads().";
+        }
+        else if ((((H5C_cache_entry_t *)thing)->shared_ref_count != 1) ||
+                 (NULL != H5C_protect_shared(cache_ptr, types[MEDIUM_ENTRY_TYPE],
+                                             entries[SMALL_ENTRY_TYPE][0].addr)) ||
+                 (NULL != H5C_protect_shared(cache_ptr, types[SMALL_ENTRY_TYPE],
+                                             entries[SMALL_ENTRY_TYPE][16].addr))) {
+
+            pass         = FALSE;
+            failure_mssg = "unexpected result of shared lookup in check_shared_reads().";
+        }
+    }
+
+    /* An entry held by a shared reader can't be expunged */
+    if (pass) {
+
+        H5E_BEGIN_TRY
+        {
+            result = H5C_expunge_entry(file_ptr, types[SMALL_ENTRY_TYPE], entries[SMALL_ENTRY_TYPE][0].addr,
+                                       H5C__NO_FLAGS_SET);
+        }
+        H5E_END_TRY;
+
+        if ((result >= 0) || !entry_in_cache(cache_ptr, SMALL_ENTRY_TYPE, 0)) {
+
+            pass         = FALSE;
+            failure_mssg = "entry held by a shared reader expunged in check_shared_reads().";
+        }
+        else {
+
+            H5C_unprotect_shared(thing);
+            thing = NULL;
+        }
+    }
+
+    /* Once released, it can be found again, and then expunged */
+    if (pass) {
+
+        thing = H5C_protect_shared(cache_ptr, types[SMALL_ENTRY_TYPE], entries[SMALL_ENTRY_TYPE][0].addr);
+
+        if (thing == NULL) {
+
+            pass         = FALSE;
+            failure_mssg = "released entry not found in check_shared_reads().";
+        }
+        else {
+
+            H5C_unprotect_shared(thing);
+            thing = NULL;
+        }
+    }
+
+    expunge_entry(file_ptr, SMALL_ENTRY_TYPE, 0);
+
+    /* Dirty entries aren't found */
+    protect_entry(file_ptr, SMALL_ENTRY_TYPE, 1);
+    unprotect_entry(file_ptr, SMALL_ENTRY_TYPE, 1, H5C__DIRTIED_FLAG);
+
+    if (pass && ((NULL != H5C_protect_shared(cache_ptr, types[SMALL_ENTRY_TYPE],
+                                             entries[SMALL_ENTRY_TYPE][0].addr)) ||
+                 (NULL != H5C_protect_shared(cache_ptr, types[SMALL_ENTRY_TYPE],
+                                             entries[SMALL_ENTRY_TYPE][1].addr)))) {
+
+        pass         = FALSE;
+        failure_mssg = "expunged or dirty entry found in check_shared_reads().";
+    }
+
+    /* Making space in the cache passes over entries held by shared readers */
+    if (pass) {
+
+        thing = H5C_protect_shared(cache_ptr, types[SMALL_ENTRY_TYPE], entries[SMALL_ENTRY_TYPE][2].addr);
+
+        if (thing == NULL) {
+
+            pass         = FALSE;
+            failure_mssg = "clean entry not found before evictions in check_shared_reads().";
+        }
+    }
+
+    for (i = 0; pass && i < 1024; i++)
+        insert_entry(file_ptr, LARGE_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+
+    if (pass && (!entry_in_cache(cache_ptr, SMALL_ENTRY_TYPE, 2) ||
+                 entry_in_cache(cache_ptr, SMALL_ENTRY_TYPE, 3))) {
+
+        pass         = FALSE;
+        failure_mssg = "unexpected evictions in check_shared_reads().";
+    }
+
+    if (thing) {
+
+        H5C_unprotect_shared(thing);
+        thing = NULL;
+    }
+
+    if (pass)
+        flush_cache(file_ptr, TRUE, FALSE, FALSE);
+
+    /* Entries are found while the index shrinks */
+    for (i = 0; pass && i < 4096; i++)
+        insert_entry(file_ptr, PICO_ENTRY_TYPE, i, H5C__NO_FLAGS_SET);
+
+    if (pass)
+        flush_cache(file_ptr, FALSE, FALSE, FALSE);
+
+    for (i = 0; pass && i < 4095; i++) {
+
+        expunge_entry(file_ptr, PICO_ENTRY_TYPE, i);
+
+        if (cache_ptr->old_index != NULL)
+            saw_resize = TRUE;
+
+        if (pass) {
+
+            thing = H5C_protect_shared(cache_ptr, types[PICO_ENTRY_TYPE],
+                                       entries[PICO_ENTRY_TYPE][i + 1 + (i % (4095 - i))].addr);
+
+            if (thing == NULL) {
+
+                pass         = FALSE;
+                failure_mssg = "entry not found while index shrinks in check_shared_reads().";
+            }
+            else {
+
+                H5C_unprotect_shared(thing);
+                thing = NULL;
+            }
+        }
+    }
+
+    if (pass && !saw_resize) {
+
+        pass         = FALSE;
+        failure_mssg = "index didn't shrink in check_shared_reads().";
+    }
+
+    if (pass) {
+
+        takedown_cache(file_ptr, FALSE, FALSE);
+    }
+
+    if (pass) {
+        PASSED();
+    }
+    else {
+        H5_FAILED();
+    }
+
+    if (!pass) {
+
+        HDfprintf(stdout, "%s(): failure_mssg = \"%s\".\n", FUNC, failure_mssg);
+    }
+
+    return (unsigned)!pass;
+
+} /* check_shared_reads() */
+
 /*-------------------------------------------------------------------------
  * Function:    check_stats__smoke_check_1()
  *
@@ -35201,7 +35766,7 @@ check_stats__smoke_check_1(H5F_t *file_ptr)
 
         if ((cache_ptr->total_ht_insertions != 32) || (cache_ptr->total_ht_deletions != 0) ||
             (cache_ptr->successful_ht_searches != 0) || (cache_ptr->total_successful_ht_search_depth != 0) ||
-            (cache_ptr->failed_ht_searches != 32) || (cache_ptr->total_failed_ht_search_depth != 48) ||
+            (cache_ptr->failed_ht_searches != 32) || (cache_ptr->total_failed_ht_search_depth != 0) ||
             (cache_ptr->max_index_len != 32) || (cache_ptr->max_index_size != 2 * 1024 * 1024) ||
             (cache_ptr->max_clean_index_size != 0) || (cache_ptr->max_dirty_index_size != 2 * 1024 * 1024) ||
             ((cache_ptr->slist_enabled) &&
@@ -35274,8 +35839,8 @@ check_stats__smoke_check_1(H5F_t *file_ptr)
 
         if ((cache_ptr->total_ht_insertions != 32) || (cache_ptr->total_ht_deletions != 0) ||
             (cache_ptr->successful_ht_searches != 32) ||
-            (cache_ptr->total_successful_ht_search_depth != 96) || (cache_ptr->failed_ht_searches != 32) ||
-            (cache_ptr->total_failed_ht_search_depth != 48) || (cache_ptr->max_index_len != 32) ||
+            (cache_ptr->total_successful_ht_search_depth != 0) || (cache_ptr->failed_ht_searches != 32) ||
+            (cache_ptr->total_failed_ht_search_depth != 0) || (cache_ptr->max_index_len != 32) ||
             (cache_ptr->max_index_size != 2 * 1024 * 1024) || (cache_ptr->max_clean_index_size != 0) ||
             (cache_ptr->max_dirty_index_size != 2 * 1024 * 1024) ||
             ((cache_ptr->slist_enabled) &&
@@ -35348,8 +35913,8 @@ check_stats__smoke_check_1(H5F_t *file_ptr)
 
         if ((cache_ptr->total_ht_insertions != 33) || (cache_ptr->total_ht_deletions != 1) ||
             (cache_ptr->successful_ht_searches != 32) ||
-            (cache_ptr->total_successful_ht_search_depth != 96) || (cache_ptr->failed_ht_searches != 33) ||
-            (cache_ptr->total_failed_ht_search_depth != 52) || (cache_ptr->max_index_len != 32) ||
+            (cache_ptr->total_successful_ht_search_depth != 0) || (cache_ptr->failed_ht_searches != 33) ||
+            (cache_ptr->total_failed_ht_search_depth != 0) || (cache_ptr->max_index_len != 32) ||
             (cache_ptr->max_index_size != 2 * 1024 * 1024) ||
             (cache_ptr->max_clean_index_size != 2 * 1024 * 1024) ||
             (cache_ptr->max_dirty_index_size != 2 * 1024 * 1024) ||
@@ -35437,8 +36002,8 @@ check_stats__smoke_check_1(H5F_t *file_ptr)
 
         if ((cache_ptr->total_ht_insertions != 33) || (cache_ptr->total_ht_deletions != 33) ||
             (cache_ptr->successful_ht_searches != 33) ||
-            (cache_ptr->total_successful_ht_search_depth != 99) || (cache_ptr->failed_ht_searches != 33) ||
-            (cache_ptr->total_failed_ht_search_depth != 52) || (cache_ptr->max_index_len != 32) ||
+            (cache_ptr->total_successful_ht_search_depth != 0) || (cache_ptr->failed_ht_searches != 33) ||
+            (cache_ptr->total_failed_ht_search_depth != 0) || (cache_ptr->max_index_len != 32) ||
             (cache_ptr->max_index_size != 2 * 1024 * 1024) ||
             (cache_ptr->max_clean_index_size != 2 * 1024 * 1024) ||
             (cache_ptr->max_dirty_index_size != 2 * 1024 * 1024) ||
@@ -35993,6 +36558,10 @@ main(void)
         nerrs += check_metadata_cork(FALSE, paged);
         nerrs += check_entry_deletions_during_scans(paged);
         nerrs += check_stats(paged);
+        nerrs += check_index_resize(paged);
+        nerrs += check_scan_resistant_policy(paged);
+        nerrs += check_read_ahead(paged);
+        nerrs += check_shared_reads(paged);
     } /* end for */
 
     /* can't fail, returns void */
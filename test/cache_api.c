@@ -28,6 +28,10 @@ const char *FILENAME[] = {"cache_api_test", NULL};
 
 /* macro definitions */
 
+/* # of groups, and # of dataset elements, in check_mdc_serialize_threads() */
+#define SERIALIZE_THREADS_NGROUPS 1000
+#define SERIALIZE_THREADS_NELMTS  16384
+
 /* private function declarations: */
 
 static hbool_t              check_fapl_mdc_api_calls(unsigned paged, hid_t fcpl_id);
@@ -36,6 +40,7 @@ static hbool_t              mdc_api_call_smoke_check(int express_test, unsigned
 static H5AC_cache_config_t *init_invalid_configs(void);
 static hbool_t              check_fapl_mdc_api_errs(void);
 static hbool_t              check_file_mdc_api_errs(unsigned paged, hid_t fcpl_id);
+static hbool_t              check_mdc_serialize_threads(unsigned paged, hid_t fcpl_id);
 
 /**************************************************************************/
 /**************************************************************************/
@@ -104,7 +109,8 @@ check_fapl_mdc_api_calls(unsigned paged, hid_t fcpl_id)
         /* double      empty_reserve          = */ 0.05f,
         /* int         dirty_bytes_threshold  = */ (256 * 1024),
         /* int        metadata_write_strategy = */
-        H5AC__DEFAULT_METADATA_WRITE_STRATEGY};
+        H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+        /* enum H5C_cache_repl_policy repl_policy = */ H5C_repl__2q};
     H5AC_cache_config_t scratch;
     H5C_auto_size_ctl_t default_auto_size_ctl;
     H5C_auto_size_ctl_t mod_auto_size_ctl;
@@ -549,7 +555,8 @@ check_file_mdc_api_calls(unsigned paged, hid_t fcpl_id)
         /* double      empty_reserve          = */ 0.05f,
         /* int         dirty_bytes_threshold  = */ (256 * 1024),
         /* int        metadata_write_strategy = */
-        H5AC__DEFAULT_METADATA_WRITE_STRATEGY};
+        H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+        /* enum H5C_cache_repl_policy repl_policy = */ H5C_repl__lru};
     H5AC_cache_config_t mod_config_2 = {
         /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
         /* hbool_t     rpt_fcn_enabled        = */ TRUE,
@@ -582,7 +589,8 @@ check_file_mdc_api_calls(unsigned paged, hid_t fcpl_id)
         /* double      empty_reserve          = */ 0.05f,
         /* int         dirty_bytes_threshold  = */ (256 * 1024),
         /* int        metadata_write_strategy = */
-        H5AC__DEFAULT_METADATA_WRITE_STRATEGY};
+        H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+        /* enum H5C_cache_repl_policy repl_policy = */ H5C_repl__lru};
     H5AC_cache_config_t mod_config_3 = {
         /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
         /* hbool_t     rpt_fcn_enabled        = */ FALSE,
@@ -615,7 +623,8 @@ check_file_mdc_api_calls(unsigned paged, hid_t fcpl_id)
         /* double      empty_reserve          = */ 0.05f,
         /* int         dirty_bytes_threshold  = */ (256 * 1024),
         /* int        metadata_write_strategy = */
-        H5AC__DEFAULT_METADATA_WRITE_STRATEGY};
+        H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+        /* enum H5C_cache_repl_policy repl_policy = */ H5C_repl__lru};
     H5AC_cache_config_t mod_config_4 = {
         /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
         /* hbool_t     rpt_fcn_enabled        = */ FALSE,
@@ -649,7 +658,8 @@ check_file_mdc_api_calls(unsigned paged, hid_t fcpl_id)
         /* double      empty_reserve          = */ 0.1f,
         /* int         dirty_bytes_threshold  = */ (256 * 1024),
         /* int        metadata_write_strategy = */
-        H5AC__DEFAULT_METADATA_WRITE_STRATEGY};
+        H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+        /* enum H5C_cache_repl_policy repl_policy = */ H5C_repl__lru};
 
     if (paged)
         TESTING("MDC/FILE related API calls for paged aggregation strategy")
@@ -906,7 +916,8 @@ mdc_api_call_smoke_check(int express_test, unsigned paged, hid_t fcpl_id)
         /* double      empty_reserve          = */ 0.05f,
         /* int         dirty_bytes_threshold  = */ (256 * 1024),
         /* int        metadata_write_strategy = */
-        H5AC__DEFAULT_METADATA_WRITE_STRATEGY};
+        H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+        /* enum H5C_cache_repl_policy repl_policy = */ H5C_repl__lru};
     H5AC_cache_config_t mod_config_2 = {
         /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
         /* hbool_t     rpt_fcn_enabled        = */ FALSE,
@@ -939,7 +950,8 @@ mdc_api_call_smoke_check(int express_test, unsigned paged, hid_t fcpl_id)
         /* double      empty_reserve          = */ 0.05f,
         /* int         dirty_bytes_threshold  = */ (256 * 1024),
         /* int        metadata_write_strategy = */
-        H5AC__DEFAULT_METADATA_WRITE_STRATEGY};
+        H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+        /* enum H5C_cache_repl_policy repl_policy = */ H5C_repl__lru};
     H5AC_cache_config_t mod_config_3 = {
         /* int         version                = */ H5C__CURR_AUTO_SIZE_CTL_VER,
         /* hbool_t     rpt_fcn_enabled        = */ FALSE,
@@ -972,7 +984,8 @@ mdc_api_call_smoke_check(int express_test, unsigned paged, hid_t fcpl_id)
         /* double      empty_reserve          = */ 0.05f,
         /* int         dirty_bytes_threshold  = */ (256 * 1024),
         /* int        metadata_write_strategy = */
-        H5AC__DEFAULT_METADATA_WRITE_STRATEGY};
+        H5AC__DEFAULT_METADATA_WRITE_STRATEGY,
+        /* enum H5C_cache_repl_policy repl_policy = */ H5C_repl__lru};
 
     if (paged)
         TESTING("MDC API smoke check for paged aggregation strategy")
@@ -1489,7 +1502,7 @@ mdc_api_call_smoke_check(int express_test, unsigned paged, hid_t fcpl_id)
  *-------------------------------------------------------------------------
  */
 
-#define NUM_INVALID_CONFIGS 36
+#define NUM_INVALID_CONFIGS 37
 static H5AC_cache_config_t *invalid_configs = NULL;
 
 static H5AC_cache_config_t *
@@ -1539,6 +1552,7 @@ init_invalid_configs(void)
         configs[i].empty_reserve           = 0.1F;
         configs[i].dirty_bytes_threshold   = (256 * 1024);
         configs[i].metadata_write_strategy = H5AC__DEFAULT_METADATA_WRITE_STRATEGY;
+        configs[i].repl_policy             = H5C_repl__lru;
     }
 
     /* Set badness for each config */
@@ -1662,6 +1676,9 @@ init_invalid_configs(void)
     /* 35 -- unknown metadata write strategy */
     configs[35].metadata_write_strategy = -1;
 
+    /* 36 -- unknown replacement policy */
+    configs[36].repl_policy = (enum H5C_cache_repl_policy)(H5C_repl__2q + 1);
+
     return configs;
 
 } /* initialize_invalid_configs() */
@@ -1830,6 +1847,239 @@ check_fapl_mdc_api_errs(void)
 
 } /* check_fapl_mdc_api_errs() */
 
+/*-------------------------------------------------------------------------
+ * Function:    check_mdc_serialize_threads()
+ *
+ * Purpose:     Verify that H5Pset/get_mdc_serialize_threads() work, and
+ *              that a file whose metadata cache entries are serialized on
+ *              several threads reads back correctly.
+ *
+ *              The groups and their attributes make object headers and
+ *              symbol table and v1 B-tree nodes (or v2 B-tree nodes with
+ *              the latest format), and the dataset's chunk index makes
+ *              v1 B-tree nodes (or extensible array data blocks) -- all
+ *              of which may be serialized on the worker threads.
+ *
+ * Return:      Test pass status (TRUE/FALSE)
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+check_mdc_serialize_threads(unsigned paged, hid_t fcpl_id)
+{
+    char     filename[512];
+    char     name[32];
+    hid_t    fapl_id  = -1;
+    hid_t    file_id  = -1;
+    hid_t    group_id = -1;
+    hid_t    attr_id  = -1;
+    hid_t    space_id = -1;
+    hid_t    dcpl_id  = -1;
+    hid_t    dset_id  = -1;
+    hsize_t  dims[1]    = {SERIALIZE_THREADS_NELMTS};
+    hsize_t  maxdims[1] = {H5S_UNLIMITED};
+    hsize_t  chunk[1]   = {16};
+    unsigned nthreads   = 0;
+    unsigned latest;
+    int *    data = NULL;
+    int      value;
+    int      i;
+
+    if (paged) {
+        TESTING("metadata cache serialize threads with paged aggregation");
+    }
+    else {
+        TESTING("metadata cache serialize threads");
+    }
+
+    pass = TRUE;
+
+    if (NULL == (data = (int *)HDmalloc(SERIALIZE_THREADS_NELMTS * sizeof(int)))) {
+
+        pass         = FALSE;
+        failure_mssg = "HDmalloc() failed.\n";
+    }
+
+    if (pass && (h5_fixname(FILENAME[0], H5P_DEFAULT, filename, sizeof(filename)) == NULL)) {
+
+        pass         = FALSE;
+        failure_mssg = "h5_fixname() failed.\n";
+    }
+
+    for (latest = FALSE; pass && latest <= TRUE; latest++) {
+
+        /* Check the property's default, and set it */
+        if ((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Pcreate(H5P_FILE_ACCESS) failed.\n";
+        }
+
+        if (pass && ((H5Pget_mdc_serialize_threads(fapl_id, &nthreads) < 0) || (nthreads != 1))) {
+
+            pass         = FALSE;
+            failure_mssg = "unexpected default serialize thread count.\n";
+        }
+
+        if (pass && ((H5Pset_mdc_serialize_threads(fapl_id, 4) < 0) ||
+                     (H5Pget_mdc_serialize_threads(fapl_id, &nthreads) < 0) || (nthreads != 4))) {
+
+            pass         = FALSE;
+            failure_mssg = "can't set serialize thread count.\n";
+        }
+
+        if (pass && latest && (H5Pset_libver_bounds(fapl_id, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0)) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Pset_libver_bounds() failed.\n";
+        }
+
+        /* Create the file, with the groups and the dataset */
+        if (pass && ((file_id = H5Fcreate(filename, H5F_ACC_TRUNC, fcpl_id, fapl_id)) < 0)) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Fcreate() failed.\n";
+        }
+
+        if (pass && ((space_id = H5Screate(H5S_SCALAR)) < 0)) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Screate() failed.\n";
+        }
+
+        for (i = 0; pass && i < SERIALIZE_THREADS_NGROUPS; i++) {
+
+            HDsnprintf(name, sizeof(name), "group %d", i);
+            if (((group_id = H5Gcreate2(file_id, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) ||
+                ((attr_id = H5Acreate2(group_id, "attr", H5T_NATIVE_INT, space_id, H5P_DEFAULT,
+                                       H5P_DEFAULT)) < 0) ||
+                (H5Awrite(attr_id, H5T_NATIVE_INT, &i) < 0) || (H5Aclose(attr_id) < 0) ||
+                (H5Gclose(group_id) < 0)) {
+
+                pass         = FALSE;
+                failure_mssg = "can't create group.\n";
+            }
+        }
+
+        if (pass && (H5Sclose(space_id) < 0)) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Sclose() failed.\n";
+        }
+
+        for (i = 0; i < SERIALIZE_THREADS_NELMTS; i++)
+            data[i] = i;
+
+        if (pass && (((space_id = H5Screate_simple(1, dims, maxdims)) < 0) ||
+                     ((dcpl_id = H5Pcreate(H5P_DATASET_CREATE)) < 0) ||
+                     (H5Pset_chunk(dcpl_id, 1, chunk) < 0) ||
+                     ((dset_id = H5Dcreate2(file_id, "dset", H5T_NATIVE_INT, space_id, H5P_DEFAULT, dcpl_id,
+                                            H5P_DEFAULT)) < 0) ||
+                     (H5Dwrite(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) < 0) ||
+                     (H5Dclose(dset_id) < 0) || (H5Pclose(dcpl_id) < 0) || (H5Sclose(space_id) < 0))) {
+
+            pass         = FALSE;
+            failure_mssg = "can't create dataset.\n";
+        }
+
+        /* Flush, then dirty half of the groups' attributes again before closing */
+        if (pass && (H5Fflush(file_id, H5F_SCOPE_GLOBAL) < 0)) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Fflush() failed.\n";
+        }
+
+        for (i = 0; pass && i < SERIALIZE_THREADS_NGROUPS; i += 2) {
+
+            value = -i;
+            HDsnprintf(name, sizeof(name), "group %d", i);
+            if (((group_id = H5Gopen2(file_id, name, H5P_DEFAULT)) < 0) ||
+                ((attr_id = H5Aopen(group_id, "attr", H5P_DEFAULT)) < 0) ||
+                (H5Awrite(attr_id, H5T_NATIVE_INT, &value) < 0) || (H5Aclose(attr_id) < 0) ||
+                (H5Gclose(group_id) < 0)) {
+
+                pass         = FALSE;
+                failure_mssg = "can't rewrite attribute.\n";
+            }
+        }
+
+        if (pass && ((H5Fclose(file_id) < 0) || (H5Pclose(fapl_id) < 0))) {
+
+            pass         = FALSE;
+            failure_mssg = "can't close file.\n";
+        }
+
+        /* Read everything back on the calling thread alone */
+        if (pass && ((file_id = H5Fopen(filename, H5F_ACC_RDONLY, H5P_DEFAULT)) < 0)) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Fopen() failed.\n";
+        }
+
+        for (i = 0; pass && i < SERIALIZE_THREADS_NGROUPS; i++) {
+
+            HDsnprintf(name, sizeof(name), "group %d", i);
+            if (((group_id = H5Gopen2(file_id, name, H5P_DEFAULT)) < 0) ||
+                ((attr_id = H5Aopen(group_id, "attr", H5P_DEFAULT)) < 0) ||
+                (H5Aread(attr_id, H5T_NATIVE_INT, &value) < 0) || (H5Aclose(attr_id) < 0) ||
+                (H5Gclose(group_id) < 0)) {
+
+                pass         = FALSE;
+                failure_mssg = "can't read attribute.\n";
+            }
+            else if (value != ((i % 2) ? i : -i)) {
+
+                pass         = FALSE;
+                failure_mssg = "unexpected attribute value.\n";
+            }
+        }
+
+        if (pass) {
+
+            HDmemset(data, 0, SERIALIZE_THREADS_NELMTS * sizeof(int));
+            if (((dset_id = H5Dopen2(file_id, "dset", H5P_DEFAULT)) < 0) ||
+                (H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) < 0) ||
+                (H5Dclose(dset_id) < 0)) {
+
+                pass         = FALSE;
+                failure_mssg = "can't read dataset.\n";
+            }
+        }
+
+        for (i = 0; pass && i < SERIALIZE_THREADS_NELMTS; i++)
+            if (data[i] != i) {
+
+                pass         = FALSE;
+                failure_mssg = "unexpected dataset value.\n";
+            }
+
+        if (pass && (H5Fclose(file_id) < 0)) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Fclose() failed.\n";
+        }
+    }
+
+    HDfree(data);
+
+    if (pass) {
+
+        PASSED();
+    }
+    else {
+
+        H5_FAILED();
+    }
+
+    if (!pass) {
+
+        HDfprintf(stdout, "%s: failure_mssg = \"%s\".\n", FUNC, failure_mssg);
+    }
+
+    return pass;
+
+} /* check_mdc_serialize_threads() */
+
 /*-------------------------------------------------------------------------
  * Function:    check_file_mdc_api_errs()
  *
@@ -2227,6 +2477,9 @@ main(void)
 
         if (!check_file_mdc_api_errs(paged, my_fcpl))
             nerrs += 1;
+
+        if (!check_mdc_serialize_threads(paged, my_fcpl))
+            nerrs += 1;
     } /* end for paged */
 
     if (!check_fapl_mdc_api_errs())
@@ -410,53 +410,50 @@ typedef struct test_entry_t {
  * updated as necessary.
  */
 
-#define H5C__HASH_MASK ((size_t)(H5C__HASH_TABLE_LEN - 1) << 3)
-
 #define H5C_TEST__PRE_HT_SEARCH_SC(cache_ptr, Addr)                                                          \
     if (((cache_ptr) == NULL) || ((cache_ptr)->magic != H5C__H5C_T_MAGIC) ||                                 \
         ((cache_ptr)->index_size != ((cache_ptr)->clean_index_size + (cache_ptr)->dirty_index_size)) ||      \
-        (!H5F_addr_defined(Addr)) || (H5C__HASH_FCN(Addr) < 0) ||                                            \
-        (H5C__HASH_FCN(Addr) >= H5C__HASH_TABLE_LEN)) {                                                      \
+        (!H5F_addr_defined(Addr)) || ((cache_ptr)->index == NULL)) {                                         \
         HDfprintf(stdout, "Pre HT search SC failed.\n");                                                     \
     }
 
-#define H5C_TEST__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, k)                                             \
+#define H5C_TEST__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, bucket)                                        \
     if (((cache_ptr) == NULL) || ((cache_ptr)->magic != H5C__H5C_T_MAGIC) || ((cache_ptr)->index_len < 1) || \
         ((entry_ptr) == NULL) || ((cache_ptr)->index_size < (entry_ptr)->size) ||                            \
         ((cache_ptr)->index_size != ((cache_ptr)->clean_index_size + (cache_ptr)->dirty_index_size)) ||      \
-        ((entry_ptr)->size <= 0) || (((cache_ptr)->index)[k] == NULL) ||                                     \
-        ((((cache_ptr)->index)[k] != (entry_ptr)) && ((entry_ptr)->ht_prev == NULL)) ||                      \
-        ((((cache_ptr)->index)[k] == (entry_ptr)) && ((entry_ptr)->ht_prev != NULL)) ||                      \
+        ((entry_ptr)->size <= 0) || (*(bucket) == NULL) ||                                                   \
+        ((*(bucket) != (entry_ptr)) && ((entry_ptr)->ht_prev == NULL)) ||                                    \
+        ((*(bucket) == (entry_ptr)) && ((entry_ptr)->ht_prev != NULL)) ||                                    \
         (((entry_ptr)->ht_prev != NULL) && ((entry_ptr)->ht_prev->ht_next != (entry_ptr))) ||                \
         (((entry_ptr)->ht_next != NULL) && ((entry_ptr)->ht_next->ht_prev != (entry_ptr)))) {                \
         HDfprintf(stdout, "Post successful HT search SC failed.\n");                                         \
     }
 
-#define H5C_TEST__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k)                                            \
-    if (((cache_ptr) == NULL) || (((cache_ptr)->index)[k] != (entry_ptr)) ||                                 \
+#define H5C_TEST__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket)                                       \
+    if (((cache_ptr) == NULL) || (*(bucket) != (entry_ptr)) ||                                               \
         ((entry_ptr)->ht_prev != NULL)) {                                                                    \
         HDfprintf(stdout, "Post HT shift to front failed.\n");                                               \
     }
 
 #define H5C_TEST__SEARCH_INDEX(cache_ptr, Addr, entry_ptr)                                                   \
     {                                                                                                        \
-        int k;                                                                                               \
+        H5C_cache_entry_t **bucket;                                                                          \
         H5C_TEST__PRE_HT_SEARCH_SC(cache_ptr, Addr)                                                          \
-        k         = H5C__HASH_FCN(Addr);                                                                     \
-        entry_ptr = ((cache_ptr)->index)[k];                                                                 \
+        bucket    = H5C__HASH_BUCKET(cache_ptr, Addr);                                                       \
+        entry_ptr = *bucket;                                                                                 \
         while (entry_ptr) {                                                                                  \
             if (H5F_addr_eq(Addr, (entry_ptr)->addr)) {                                                      \
-                H5C_TEST__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, k)                                     \
-                if (entry_ptr != ((cache_ptr)->index)[k]) {                                                  \
+                H5C_TEST__POST_SUC_HT_SEARCH_SC(cache_ptr, entry_ptr, bucket)                                \
+                if (entry_ptr != *bucket) {                                                                  \
                     if ((entry_ptr)->ht_next)                                                                \
                         (entry_ptr)->ht_next->ht_prev = (entry_ptr)->ht_prev;                                \
                     HDassert((entry_ptr)->ht_prev != NULL);                                                  \
-                    (entry_ptr)->ht_prev->ht_next    = (entry_ptr)->ht_next;                                 \
-                    ((cache_ptr)->index)[k]->ht_prev = (entry_ptr);                                          \
-                    (entry_ptr)->ht_next             = ((cache_ptr)->index)[k];                              \
-                    (entry_ptr)->ht_prev             = NULL;                                                 \
-                    ((cache_ptr)->index)[k]          = (entry_ptr);                                          \
-                    H5C_TEST__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, k)                                \
+                    (entry_ptr)->ht_prev->ht_next = (entry_ptr)->ht_next;                                    \
+                    (*bucket)->ht_prev            = (entry_ptr);                                             \
+                    (entry_ptr)->ht_next          = *bucket;                                                 \
+                    (entry_ptr)->ht_prev          = NULL;                                                    \
+                    *bucket                       = (entry_ptr);                                             \
+                    H5C_TEST__POST_HT_SHIFT_TO_FRONT(cache_ptr, entry_ptr, bucket)                           \
                 }                                                                                            \
                 break;                                                                                       \
             }                                                                                                \
@@ -489,7 +486,7 @@ typedef struct test_entry_t {
      ((a).apply_empty_reserve == (b).apply_empty_reserve) &&                                                 \
      (H5_DBL_ABS_EQUAL((a).empty_reserve, (b).empty_reserve)) &&                                             \
      ((a).dirty_bytes_threshold == (b).dirty_bytes_threshold) &&                                             \
-     ((a).metadata_write_strategy == (b).metadata_write_strategy))
+     ((a).metadata_write_strategy == (b).metadata_write_strategy) && ((a).repl_policy == (b).repl_policy))
 
 #define XLATE_EXT_TO_INT_MDC_CONFIG(i, e)                                                                    \
     {                                                                                                        \
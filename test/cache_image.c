@@ -57,6 +57,7 @@ static unsigned cache_image_api_error_check_4(hbool_t single_file_vfd);
 
 static unsigned get_free_sections_test(hbool_t single_file_vfd);
 static unsigned evict_on_close_test(hbool_t single_file_vfd);
+static unsigned cache_image_compressed_check(hbool_t single_file_vfd);
 
 /****************************************************************************/
 /***************************** Utility Functions ****************************/
@@ -523,7 +524,7 @@ open_hdf5_file(hbool_t create_file, hbool_t mdci_sbem_expected, hbool_t read_onl
     H5C_t *                   cache_ptr = NULL;
     H5C_cache_image_ctl_t     image_ctl;
     H5AC_cache_image_config_t cache_image_config = {H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION, TRUE, FALSE,
-                                                    H5AC__CACHE_IMAGE__ENTRY_AGEOUT__NONE};
+                                                    H5AC__CACHE_IMAGE__ENTRY_AGEOUT__NONE, FALSE};
 
     if (pass) {
         /* opening the file both read only and with a cache image
@@ -883,7 +884,7 @@ attempt_swmr_open_hdf5_file(const hbool_t create_file, const hbool_t set_mdci_fa
     hid_t                     file_id       = -1;
     herr_t                    result;
     H5AC_cache_image_config_t cache_image_config = {H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION, TRUE, FALSE,
-                                                    H5AC__CACHE_IMAGE__ENTRY_AGEOUT__NONE};
+                                                    H5AC__CACHE_IMAGE__ENTRY_AGEOUT__NONE, FALSE};
 
     /* create a file access propertly list. */
     if (pass) {
@@ -6567,6 +6568,7 @@ cache_image_api_error_check_4(hbool_t single_file_vfd)
         cache_image_config.generate_image     = TRUE;
         cache_image_config.save_resize_status = FALSE;
         cache_image_config.entry_ageout       = H5AC__CACHE_IMAGE__ENTRY_AGEOUT__NONE;
+        cache_image_config.compress_image     = FALSE;
 
         if (H5Pset_mdc_image_config(fapl_id, &cache_image_config) < 0) {
 
@@ -7823,6 +7825,269 @@ evict_on_close_test(hbool_t single_file_vfd)
 
 } /* evict_on_close_test() */
 
+/*-------------------------------------------------------------------------
+ * Function:    cache_image_compressed_check()
+ *
+ * Purpose:     Verify that a compressed cache image is written, that only
+ *              its index is loaded when the file is opened R/O, and that
+ *              it is loaded in full when the file is opened R/W.
+ *
+ *              Do this as follows:
+ *
+ *               1) Create a HDF5 file with a compressed cache image
+ *                  requested.
+ *
+ *               2) Create some datasets.
+ *
+ *               3) Close the file.
+ *
+ *               4) Open the file R/O.
+ *
+ *               5) Verify the datasets, and verify that the cache image
+ *                  was loaded as an index.
+ *
+ *               6) Close the file.
+ *
+ *               7) Open the file R/W.
+ *
+ *               8) Verify the datasets, and verify that the cache image
+ *                  was loaded in full.
+ *
+ *               9) Close the file.
+ *
+ *              10) Discard the file.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+cache_image_compressed_check(hbool_t single_file_vfd)
+{
+    const char *              fcn_name = "cache_image_compressed_check()";
+    char                      filename[512];
+    hbool_t                   show_progress = FALSE;
+    hid_t                     fapl_id       = -1;
+    hid_t                     file_id       = -1;
+    H5F_t *                   file_ptr      = NULL;
+    H5C_t *                   cache_ptr     = NULL;
+    int                       cp            = 0;
+    H5AC_cache_image_config_t cache_image_config = {H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION, TRUE, FALSE,
+                                                    H5AC__CACHE_IMAGE__ENTRY_AGEOUT__NONE, TRUE};
+
+    TESTING("compressed metadata cache image");
+
+    /* Check for VFD that is a single file */
+    if (!single_file_vfd) {
+        SKIPPED();
+        HDputs("    Cache image not supported with the current VFD.");
+        return 0;
+    }
+
+    pass = TRUE;
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    /* setup the file name */
+    if (pass) {
+
+        if (h5_fixname(FILENAMES[0], H5P_DEFAULT, filename, sizeof(filename)) == NULL) {
+
+            pass         = FALSE;
+            failure_mssg = "h5_fixname() failed.\n";
+        }
+    }
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    /* 1) Create a HDF5 file with a compressed cache image requested. */
+
+    if (pass) {
+
+        if ((fapl_id = h5_fileaccess()) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "h5_fileaccess() failed.\n";
+        }
+        else if (H5Pset_libver_bounds(fapl_id, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Pset_libver_bounds() failed.\n";
+        }
+        else if (H5Pset_mdc_image_config(fapl_id, &cache_image_config) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Pset_mdc_image_config() failed.\n";
+        }
+        else if ((file_id = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id)) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Fcreate() failed.\n";
+        }
+    }
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    /* 2) Create some datasets. */
+
+    create_datasets(file_id, 0, 5);
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    /* 3) Close the file. */
+
+    if (pass) {
+
+        if (H5Fclose(file_id) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Fclose() failed (1).\n";
+        }
+    }
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    /* 4) Open the file R/O. */
+
+    if (pass) {
+
+        if ((file_id = H5Fopen(filename, H5F_ACC_RDONLY, fapl_id)) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Fopen() failed (1).\n";
+        }
+        else if ((NULL == (file_ptr = (H5F_t *)H5VL_object_verify(file_id, H5I_FILE))) ||
+                 (NULL == (cache_ptr = file_ptr->shared->cache))) {
+
+            pass         = FALSE;
+            failure_mssg = "can't get cache pointer (1).\n";
+        }
+    }
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    /* 5) Verify the datasets, and verify that the cache image was loaded
+     *    as an index.
+     */
+
+    verify_datasets(file_id, 0, 5);
+
+    if (pass) {
+
+        if ((!cache_ptr->image_loaded) || (cache_ptr->image_index == NULL) ||
+            (cache_ptr->image_index_nentries == 0) || (cache_ptr->image_index_size == 0)) {
+
+            pass         = FALSE;
+            failure_mssg = "cache image not loaded as an index.\n";
+        }
+    }
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    /* 6) Close the file. */
+
+    if (pass) {
+
+        if (H5Fclose(file_id) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Fclose() failed (2).\n";
+        }
+    }
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    /* 7) Open the file R/W. */
+
+    if (pass) {
+
+        if ((file_id = H5Fopen(filename, H5F_ACC_RDWR, fapl_id)) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Fopen() failed (2).\n";
+        }
+        else if ((NULL == (file_ptr = (H5F_t *)H5VL_object_verify(file_id, H5I_FILE))) ||
+                 (NULL == (cache_ptr = file_ptr->shared->cache))) {
+
+            pass         = FALSE;
+            failure_mssg = "can't get cache pointer (2).\n";
+        }
+    }
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    /* 8) Verify the datasets, and verify that the cache image was loaded
+     *    in full.
+     */
+
+    verify_datasets(file_id, 0, 5);
+
+    if (pass) {
+
+        if ((!cache_ptr->image_loaded) || (cache_ptr->image_index != NULL)) {
+
+            pass         = FALSE;
+            failure_mssg = "cache image not loaded in full.\n";
+        }
+    }
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    /* 9) Close the file. */
+
+    if (pass) {
+
+        if (H5Fclose(file_id) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "H5Fclose() failed (3).\n";
+        }
+    }
+
+    if (fapl_id >= 0)
+        H5Pclose(fapl_id);
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    /* 10) Discard the file. */
+
+    if (pass) {
+
+        if (HDremove(filename) < 0) {
+
+            pass         = FALSE;
+            failure_mssg = "HDremove() failed.\n";
+        }
+    }
+
+    if (show_progress)
+        HDfprintf(stdout, "%s: cp = %d, pass = %d.\n", fcn_name, cp++, pass);
+
+    if (pass) {
+        PASSED();
+    }
+    else {
+        H5_FAILED();
+    }
+
+    if (!pass)
+        HDfprintf(stdout, "%s: failure_mssg = \"%s\".\n", FUNC, failure_mssg);
+
+    return !pass;
+
+} /* cache_image_compressed_check() */
+
 /*-------------------------------------------------------------------------
  * Function:    main
  *
@@ -7884,6 +8149,7 @@ main(void)
 
     nerrs += get_free_sections_test(single_file_vfd);
     nerrs += evict_on_close_test(single_file_vfd);
+    nerrs += cache_image_compressed_check(single_file_vfd);
 
     return (nerrs > 0);
 
@@ -14,8 +14,11 @@
 /* Purpose: Tests the metadata cache logging framework */
 
 #include "h5test.h"
+#include "H5Clog.h"
 
-#define LOG_LOCATION "cache_logging.out"
+#define LOG_LOCATION    "cache_logging.out"
+#define TRACE_LOCATION  "cache_logging.trace"
+#define BINARY_LOCATION "cache_logging.bin"
 #define FILE_NAME    "cache_logging"
 
 #define N_GROUPS 100
@@ -134,6 +137,360 @@ error:
     return 1;
 } /* test_logging_api() */
 
+/*-------------------------------------------------------------------------
+ * Function:    read_file
+ *
+ * Purpose:     Reads a metadata cache access trace or log into a buffer
+ *
+ * Return:      Success:        Pointer to the contents, which the caller
+ *                              must free
+ *              Failure:        NULL
+ *-------------------------------------------------------------------------
+ */
+static uint8_t *
+read_file(const char *name, size_t *size)
+{
+    h5_stat_t sb;
+    uint8_t * buf = NULL;
+    int       fd  = -1;
+
+    if ((fd = HDopen(name, O_RDONLY)) < 0)
+        goto error;
+    if (HDfstat(fd, &sb) < 0 || sb.st_size <= 0)
+        goto error;
+    *size = (size_t)sb.st_size;
+    if (NULL == (buf = (uint8_t *)HDmalloc(*size)))
+        goto error;
+    if (HDread(fd, buf, *size) != (h5_posix_io_ret_t)*size)
+        goto error;
+    HDclose(fd);
+
+    return buf;
+
+error:
+    if (fd >= 0)
+        HDclose(fd);
+    HDfree(buf);
+    return NULL;
+} /* read_file() */
+
+/*-------------------------------------------------------------------------
+ * Function:    open_groups
+ *
+ * Purpose:     Opens the file and each of its groups with FAPL
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *-------------------------------------------------------------------------
+ */
+static int
+open_groups(const char *filename, unsigned flags, hid_t fapl)
+{
+    hid_t fid = -1;
+    hid_t gid = -1;
+    char  group_name[12];
+    int   i;
+
+    if ((fid = H5Fopen(filename, flags, fapl)) < 0)
+        goto error;
+    for (i = 0; i < N_GROUPS; i++) {
+        HDsnprintf(group_name, sizeof(group_name), "%d", i);
+        if ((gid = H5Gopen2(fid, group_name, H5P_DEFAULT)) < 0)
+            goto error;
+        if (H5Gclose(gid) < 0)
+            goto error;
+    }
+    if (H5Fclose(fid) < 0)
+        goto error;
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(gid);
+        H5Fclose(fid);
+    }
+    H5E_END_TRY;
+    return -1;
+} /* open_groups() */
+
+/*-------------------------------------------------------------------------
+ * Function:    test_access_trace
+ *
+ * Purpose:     Tests recording and replaying a metadata cache access
+ *              trace
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_access_trace(void)
+{
+    hid_t    fapl  = -1;
+    hid_t    fid   = -1;
+    hid_t    gid   = -1;
+    uint8_t *trace = NULL;
+    uint8_t *trace2 = NULL;
+    size_t   trace_size;
+    size_t   trace2_size;
+    char     location[64];
+    size_t   size;
+    char     group_name[12];
+    char     filename[1024];
+    int      i;
+
+    TESTING("metadata cache access trace");
+
+    fapl = h5_fileaccess();
+    h5_fixname(FILE_NAME, fapl, filename, sizeof filename);
+    HDremove(TRACE_LOCATION);
+
+    /* Check the property list setter and getter */
+    size = sizeof(location);
+    if (H5Pget_mdc_access_trace(fapl, location, &size) < 0 || size != 0 || location[0] != '\0')
+        TEST_ERROR;
+    if (H5Pset_mdc_access_trace(fapl, TRACE_LOCATION) < 0)
+        TEST_ERROR;
+    size = 0;
+    if (H5Pget_mdc_access_trace(fapl, NULL, &size) < 0 || size != HDstrlen(TRACE_LOCATION) + 1)
+        TEST_ERROR;
+    size = sizeof(location);
+    if (H5Pget_mdc_access_trace(fapl, location, &size) < 0 || HDstrcmp(location, TRACE_LOCATION))
+        TEST_ERROR;
+
+    /* Create a file with some groups (no trace is recorded on create) */
+    if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR;
+    for (i = 0; i < N_GROUPS; i++) {
+        HDsnprintf(group_name, sizeof(group_name), "%d", i);
+        if ((gid = H5Gcreate2(fid, group_name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+            TEST_ERROR;
+        if (H5Gclose(gid) < 0)
+            TEST_ERROR;
+    }
+    if (H5Fclose(fid) < 0)
+        TEST_ERROR;
+    if (HDaccess(TRACE_LOCATION, F_OK) == 0)
+        TEST_ERROR;
+
+    /* The first read-only open records the trace */
+    if (open_groups(filename, H5F_ACC_RDONLY, fapl) < 0)
+        TEST_ERROR;
+    if (NULL == (trace = read_file(TRACE_LOCATION, &trace_size)))
+        TEST_ERROR;
+
+    /* Later opens replay it, leaving it alone */
+    if (open_groups(filename, H5F_ACC_RDONLY, fapl) < 0)
+        TEST_ERROR;
+    if (NULL == (trace2 = read_file(TRACE_LOCATION, &trace2_size)))
+        TEST_ERROR;
+    if (trace_size != trace2_size || HDmemcmp(trace, trace2, trace_size))
+        TEST_ERROR;
+    HDfree(trace2);
+    trace2 = NULL;
+
+    /* Changing the file makes the next open record a new trace */
+    if ((fid = H5Fopen(filename, H5F_ACC_RDWR, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if ((gid = H5Gcreate2(fid, "new", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if (H5Gclose(gid) < 0)
+        TEST_ERROR;
+    if (H5Fclose(fid) < 0)
+        TEST_ERROR;
+    if (open_groups(filename, H5F_ACC_RDONLY, fapl) < 0)
+        TEST_ERROR;
+    if (NULL == (trace2 = read_file(TRACE_LOCATION, &trace2_size)))
+        TEST_ERROR;
+    if (trace_size == trace2_size && !HDmemcmp(trace, trace2, trace_size))
+        TEST_ERROR;
+
+    /* Resetting the location turns the trace off */
+    if (H5Pset_mdc_access_trace(fapl, NULL) < 0)
+        TEST_ERROR;
+    size = sizeof(location);
+    if (H5Pget_mdc_access_trace(fapl, location, &size) < 0 || size != 0)
+        TEST_ERROR;
+
+    /* Clean up */
+    HDfree(trace);
+    HDfree(trace2);
+    HDremove(TRACE_LOCATION);
+    if (H5Pclose(fapl) < 0)
+        TEST_ERROR;
+
+    PASSED();
+    return 0;
+
+error:
+    HDfree(trace);
+    HDfree(trace2);
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(gid);
+        H5Fclose(fid);
+        H5Pclose(fapl);
+    }
+    H5E_END_TRY;
+    return 1;
+} /* test_access_trace() */
+
+/*-------------------------------------------------------------------------
+ * Function:    count_binary_records
+ *
+ * Purpose:     Checks the binary metadata cache log and counts its
+ *              protects that hit, protects that missed, and entry flushes
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *-------------------------------------------------------------------------
+ */
+static int
+count_binary_records(unsigned *nhits, unsigned *nmisses, unsigned *nflushes)
+{
+    uint8_t *      log = NULL;
+    const uint8_t *p;
+    size_t         size;
+    unsigned       ntypes;
+    unsigned       u;
+
+    *nhits = *nmisses = *nflushes = 0;
+
+    if (NULL == (log = read_file(BINARY_LOCATION, &size)))
+        goto error;
+
+    /* Check the header, and skip the names of the entry types */
+    if (size < H5C_LOG_BINARY_HEADER_SIZE ||
+        HDmemcmp(log, H5C_LOG_BINARY_SIGNATURE, (size_t)H5C_LOG_BINARY_SIGNATURE_LEN) != 0 ||
+        log[H5C_LOG_BINARY_SIGNATURE_LEN] != H5C_LOG_BINARY_VERSION ||
+        log[H5C_LOG_BINARY_SIGNATURE_LEN + 1] != H5C_LOG_BINARY_RECORD_SIZE)
+        goto error;
+    ntypes = log[H5C_LOG_BINARY_SIGNATURE_LEN + 2];
+    p      = log + H5C_LOG_BINARY_HEADER_SIZE;
+    for (u = 0; u < ntypes; u++) {
+        if (p + 2 > log + size)
+            goto error;
+        p += 2 + p[1];
+    }
+
+    /* The records follow, starting with the start of logging */
+    if (p >= log + size || (size_t)((log + size) - p) % H5C_LOG_BINARY_RECORD_SIZE != 0 ||
+        p[28] != H5C_LOG_BINARY_START)
+        goto error;
+    for (; p < log + size; p += H5C_LOG_BINARY_RECORD_SIZE) {
+        unsigned op     = p[28];
+        unsigned status = p[30];
+
+        if (op == H5C_LOG_BINARY_PROTECT && !(status & H5C_LOG_BINARY_FAILED)) {
+            if (status & H5C_LOG_BINARY_HIT)
+                (*nhits)++;
+            else
+                (*nmisses)++;
+        }
+        else if (op == H5C_LOG_BINARY_FLUSH)
+            (*nflushes)++;
+    }
+
+    HDfree(log);
+    return 0;
+
+error:
+    HDfree(log);
+    return -1;
+} /* count_binary_records() */
+
+/*-------------------------------------------------------------------------
+ * Function:    test_binary_logging
+ *
+ * Purpose:     Tests the binary metadata cache log
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_binary_logging(void)
+{
+    hid_t                fapl = -1;
+    hid_t                fid  = -1;
+    hid_t                gid  = -1;
+    H5F_mdc_log_format_t format;
+    herr_t               ret;
+    unsigned             nhits, nmisses, nflushes;
+    char                 group_name[12];
+    char                 filename[1024];
+    int                  i;
+
+    TESTING("binary metadata cache log");
+
+    fapl = h5_fileaccess();
+    h5_fixname(FILE_NAME, fapl, filename, sizeof filename);
+
+    /* Check the property list setter and getter */
+    if (H5Pget_mdc_log_format(fapl, &format) < 0 || format != H5F_MDC_LOG_FORMAT_JSON)
+        TEST_ERROR;
+    if (H5Pset_mdc_log_format(fapl, H5F_MDC_LOG_FORMAT_BINARY) < 0)
+        TEST_ERROR;
+    if (H5Pget_mdc_log_format(fapl, &format) < 0 || format != H5F_MDC_LOG_FORMAT_BINARY)
+        TEST_ERROR;
+    H5E_BEGIN_TRY
+    {
+        ret = H5Pset_mdc_log_format(fapl, (H5F_mdc_log_format_t)99);
+    }
+    H5E_END_TRY;
+    if (ret >= 0)
+        TEST_ERROR;
+    if (H5Pset_mdc_log_options(fapl, TRUE, BINARY_LOCATION, TRUE) < 0)
+        TEST_ERROR;
+
+    /* Creating groups protects the root group over and over, and closing
+     * the file flushes the new entries
+     */
+    if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR;
+    for (i = 0; i < N_GROUPS; i++) {
+        HDsnprintf(group_name, sizeof(group_name), "%d", i);
+        if ((gid = H5Gcreate2(fid, group_name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+            TEST_ERROR;
+        if (H5Gclose(gid) < 0)
+            TEST_ERROR;
+    }
+    if (H5Fclose(fid) < 0)
+        TEST_ERROR;
+    if (count_binary_records(&nhits, &nmisses, &nflushes) < 0)
+        TEST_ERROR;
+    if (nhits == 0 || nflushes == 0)
+        TEST_ERROR;
+
+    /* Opening the groups loads their object headers */
+    if (open_groups(filename, H5F_ACC_RDONLY, fapl) < 0)
+        TEST_ERROR;
+    if (count_binary_records(&nhits, &nmisses, &nflushes) < 0)
+        TEST_ERROR;
+    if (nhits == 0 || nmisses < N_GROUPS)
+        TEST_ERROR;
+
+    /* Clean up */
+    HDremove(BINARY_LOCATION);
+    if (H5Pclose(fapl) < 0)
+        TEST_ERROR;
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(gid);
+        H5Fclose(fid);
+        H5Pclose(fapl);
+    }
+    H5E_END_TRY;
+    return 1;
+} /* test_binary_logging() */
+
 /*-------------------------------------------------------------------------
  * Function:    main
  *
@@ -155,6 +512,8 @@ main(void)
     HDprintf("Testing basic metadata cache logging functionality.\n");
 
     nerrors += test_logging_api();
+    nerrors += test_access_trace();
+    nerrors += test_binary_logging();
 
     if (nerrors) {
         HDprintf("***** %d Metadata cache logging TEST%s FAILED! *****\n", nerrors, nerrors > 1 ? "S" : "");
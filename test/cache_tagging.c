@@ -153,26 +153,22 @@ static int
 verify_no_unknown_tags(hid_t fid)
 {
 
-    H5F_t *f;         /* File Pointer */
-    H5C_t *cache_ptr; /* Cache Pointer */
-    int    i;         /* Iterator */
+    H5F_t *            f;         /* File Pointer */
+    H5C_t *            cache_ptr; /* Cache Pointer */
+    H5C_cache_entry_t *entry_ptr; /* entry pointer */
 
     /* Get Internal File / Cache Pointers */
     if (NULL == (f = (H5F_t *)H5VL_object(fid)))
         TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for (i = 0; i < H5C__HASH_TABLE_LEN; i++) {
-        H5C_cache_entry_t *entry_ptr; /* entry pointer */
-
-        entry_ptr = cache_ptr->index[i];
-        while (entry_ptr != NULL) {
-            if (!entry_ptr->dirtied)
-                TEST_ERROR;
+    entry_ptr = cache_ptr->il_head;
+    while (entry_ptr != NULL) {
+        if (!entry_ptr->dirtied)
+            TEST_ERROR;
 
-            entry_ptr = entry_ptr->ht_next;
-        } /* end if */
-    }     /* end for */
+        entry_ptr = entry_ptr->il_next;
+    } /* end while */
 
     return 0;
 
@@ -200,26 +196,22 @@ error:
 static int
 mark_all_entries_investigated(hid_t fid)
 {
-    H5F_t *f;         /* File Pointer */
-    H5C_t *cache_ptr; /* Cache Pointer */
-    int    i;         /* Iterator */
+    H5F_t *            f;         /* File Pointer */
+    H5C_t *            cache_ptr; /* Cache Pointer */
+    H5C_cache_entry_t *entry_ptr; /* entry pointer */
 
     /* Get Internal File / Cache Pointers */
     if (NULL == (f = (H5F_t *)H5VL_object(fid)))
         TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for (i = 0; i < H5C__HASH_TABLE_LEN; i++) {
-        H5C_cache_entry_t *entry_ptr; /* entry pointer */
+    entry_ptr = cache_ptr->il_head;
+    while (entry_ptr != NULL) {
+        if (!entry_ptr->dirtied)
+            entry_ptr->dirtied = TRUE;
 
-        entry_ptr = cache_ptr->index[i];
-        while (entry_ptr != NULL) {
-            if (!entry_ptr->dirtied)
-                entry_ptr->dirtied = TRUE;
-
-            entry_ptr = entry_ptr->ht_next;
-        } /* end if */
-    }     /* end for */
+        entry_ptr = entry_ptr->il_next;
+    } /* end while */
 
     return 0;
 
@@ -245,26 +237,22 @@ error:
 static int
 reset_all_entries_investigated(hid_t fid)
 {
-    H5F_t *f;         /* File Pointer */
-    H5C_t *cache_ptr; /* Cache Pointer */
-    int    i;         /* Iterator */
+    H5F_t *            f;         /* File Pointer */
+    H5C_t *            cache_ptr; /* Cache Pointer */
+    H5C_cache_entry_t *entry_ptr; /* entry pointer */
 
     /* Get Internal File / Cache Pointers */
     if (NULL == (f = (H5F_t *)H5VL_object(fid)))
         TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for (i = 0; i < H5C__HASH_TABLE_LEN; i++) {
-        H5C_cache_entry_t *entry_ptr; /* entry pointer */
+    entry_ptr = cache_ptr->il_head;
+    while (entry_ptr != NULL) {
+        if (entry_ptr->dirtied)
+            entry_ptr->dirtied = FALSE;
 
-        entry_ptr = cache_ptr->index[i];
-        while (entry_ptr != NULL) {
-            if (entry_ptr->dirtied)
-                entry_ptr->dirtied = FALSE;
-
-            entry_ptr = entry_ptr->ht_next;
-        } /* end if */
-    }     /* end for */
+        entry_ptr = entry_ptr->il_next;
+    } /* end while */
 
     return 0;
 
@@ -292,34 +280,27 @@ error:
 static int
 verify_tag(hid_t fid, int id, haddr_t tag)
 {
-    H5F_t *f;         /* File Pointer */
-    H5C_t *cache_ptr; /* Cache Pointer */
-    int    i;         /* Iterator */
+    H5F_t *            f;         /* File Pointer */
+    H5C_t *            cache_ptr; /* Cache Pointer */
+    H5C_cache_entry_t *entry_ptr; /* entry pointer */
 
     /* Get Internal File / Cache Pointers */
     if (NULL == (f = (H5F_t *)H5VL_object(fid)))
         TEST_ERROR;
     cache_ptr = f->shared->cache;
 
-    for (i = 0; i < H5C__HASH_TABLE_LEN; i++) {
-        H5C_cache_entry_t *entry_ptr; /* entry pointer */
-
-        entry_ptr = cache_ptr->index[i];
-        while (entry_ptr != NULL) {
-            if (entry_ptr->type->id == id && !entry_ptr->dirtied) {
-                if (entry_ptr->tag_info->tag != tag)
-                    TEST_ERROR;
-
-                /* Mark the entry/tag pair as found */
-                entry_ptr->dirtied = TRUE;
+    entry_ptr = cache_ptr->il_head;
+    while (entry_ptr != NULL) {
+        if (entry_ptr->type->id == id && !entry_ptr->dirtied && entry_ptr->tag_info->tag == tag) {
+            /* Mark the entry/tag pair as found */
+            entry_ptr->dirtied = TRUE;
 
-                /* leave now that we've found the entry */
-                goto done;
-            } /* end if */
-
-            entry_ptr = entry_ptr->ht_next;
+            /* leave now that we've found the entry */
+            goto done;
         } /* end if */
-    }     /* end for */
+
+        entry_ptr = entry_ptr->il_next;
+    } /* end while */
 
     /* Didn't find the tagged entry, throw an error */
     TEST_ERROR;
@@ -83,6 +83,7 @@ const char *FILENAME[] = {"dataset",             /* 0 */
                           "power2up",            /* 24 */
                           "version_bounds",      /* 25 */
                           "alloc_0sized",        /* 26 */
+                          "zero_copy_io",        /* 27 */
                           NULL};
 
 #define OHMIN_FILENAME_A "ohdr_min_a"
@@ -103,6 +104,7 @@ const char *FILENAME[] = {"dataset",             /* 0 */
 #define DSET_COMPACT_MAX2_NAME    "max_compact_2"
 #define DSET_CONV_BUF_NAME        "conv_buf"
 #define DSET_TCONV_NAME           "tconv"
+#define DSET_TCONV_IN_PLACE_NAME  "tconv_in_place"
 #define DSET_DEFLATE_NAME         "deflate"
 #define DSET_SHUFFLE_NAME         "shuffle"
 #define DSET_FLETCHER32_NAME      "fletcher32"
@@ -675,6 +677,165 @@ error:
     return FAIL;
 } /* end test_simple_io() */
 
+/*-------------------------------------------------------------------------
+ * Function:    test_zero_copy_io
+ *
+ * Purpose:     Tests strided reads and writes of contiguous and unfiltered
+ *              chunked datasets with zero-copy vector I/O enabled, mixed
+ *              with I/O that goes through the data sieve buffer.
+ *
+ * Return:      Success:    0
+ *              Failure:    -1
+ *-------------------------------------------------------------------------
+ */
+#define ZERO_COPY_IO_DIM   4096
+#define ZERO_COPY_IO_CHUNK 512
+static herr_t
+test_zero_copy_io(hid_t fapl)
+{
+    char     filename[FILENAME_BUF_SIZE];
+    hid_t    file          = H5I_INVALID_HID;
+    hid_t    dset          = H5I_INVALID_HID;
+    hid_t    space         = H5I_INVALID_HID;
+    hid_t    dcpl          = H5I_INVALID_HID;
+    hid_t    dxpl          = H5I_INVALID_HID;
+    int *    wbuf          = NULL;
+    int *    rbuf          = NULL;
+    hbool_t  zc            = FALSE;
+    hsize_t  dims[1]       = {ZERO_COPY_IO_DIM};
+    hsize_t  chunk_dims[1] = {ZERO_COPY_IO_CHUNK};
+    hsize_t  start[1], stride[1], count[1];
+    unsigned chunked;
+    int      i;
+
+    TESTING("zero-copy vector I/O");
+
+    h5_fixname(FILENAME[27], fapl, filename, sizeof filename);
+
+    if (NULL == (wbuf = (int *)HDmalloc(ZERO_COPY_IO_DIM * sizeof(int))))
+        TEST_ERROR
+    if (NULL == (rbuf = (int *)HDmalloc(ZERO_COPY_IO_DIM * sizeof(int))))
+        TEST_ERROR
+
+    /* Check the property */
+    if ((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        FAIL_STACK_ERROR
+    if (H5Pget_zero_copy_io(dxpl, &zc) < 0)
+        FAIL_STACK_ERROR
+    if (zc)
+        TEST_ERROR
+    if (H5Pset_zero_copy_io(dxpl, TRUE) < 0)
+        FAIL_STACK_ERROR
+    if (H5Pget_zero_copy_io(dxpl, &zc) < 0)
+        FAIL_STACK_ERROR
+    if (!zc)
+        TEST_ERROR
+
+    if ((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if ((space = H5Screate_simple(1, dims, NULL)) < 0)
+        FAIL_STACK_ERROR
+
+    for (chunked = 0; chunked < 2; chunked++) {
+        if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+            FAIL_STACK_ERROR
+        if (chunked && H5Pset_chunk(dcpl, 1, chunk_dims) < 0)
+            FAIL_STACK_ERROR
+        if ((dset = H5Dcreate2(file, chunked ? "chunked" : "contig", H5T_NATIVE_INT, space, H5P_DEFAULT,
+                               dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+
+        /* Write the whole dataset through the sieve buffer */
+        for (i = 0; i < ZERO_COPY_IO_DIM; i++)
+            wbuf[i] = i;
+        if (H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+            FAIL_STACK_ERROR
+
+        /* Overwrite every third element with zero-copy I/O, leaving any
+         * sieve buffer content behind it stale
+         */
+        for (i = 0; i < ZERO_COPY_IO_DIM; i++)
+            wbuf[i] = -i;
+        start[0]  = 1;
+        stride[0] = 3;
+        count[0]  = (ZERO_COPY_IO_DIM - 1) / 3;
+        if (H5Sselect_hyperslab(space, H5S_SELECT_SET, start, stride, count, NULL) < 0)
+            FAIL_STACK_ERROR
+        if (H5Dwrite(dset, H5T_NATIVE_INT, space, space, dxpl, wbuf) < 0)
+            FAIL_STACK_ERROR
+
+        /* Read every other element with zero-copy I/O */
+        HDmemset(rbuf, 0xff, ZERO_COPY_IO_DIM * sizeof(int));
+        start[0]  = 0;
+        stride[0] = 2;
+        count[0]  = ZERO_COPY_IO_DIM / 2;
+        if (H5Sselect_hyperslab(space, H5S_SELECT_SET, start, stride, count, NULL) < 0)
+            FAIL_STACK_ERROR
+        if (H5Dread(dset, H5T_NATIVE_INT, space, space, dxpl, rbuf) < 0)
+            FAIL_STACK_ERROR
+        for (i = 0; i < ZERO_COPY_IO_DIM; i++) {
+            int expect = (i % 2) ? -1 : (((i % 3) == 1) ? -i : i);
+
+            if (rbuf[i] != expect) {
+                H5_FAILED();
+                HDprintf("    zero-copy read: rbuf[%d] = %d, expected %d\n", i, rbuf[i], expect);
+                goto error;
+            } /* end if */
+        }     /* end for */
+
+        /* Read everything back through the sieve buffer */
+        if (H5Sselect_all(space) < 0)
+            FAIL_STACK_ERROR
+        if (H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+            FAIL_STACK_ERROR
+        for (i = 0; i < ZERO_COPY_IO_DIM; i++) {
+            int expect = ((i % 3) == 1) ? -i : i;
+
+            if (rbuf[i] != expect) {
+                H5_FAILED();
+                HDprintf("    sieve read: rbuf[%d] = %d, expected %d\n", i, rbuf[i], expect);
+                goto error;
+            } /* end if */
+        }     /* end for */
+
+        if (H5Dclose(dset) < 0)
+            FAIL_STACK_ERROR
+        dset = H5I_INVALID_HID;
+        if (H5Pclose(dcpl) < 0)
+            FAIL_STACK_ERROR
+        dcpl = H5I_INVALID_HID;
+    } /* end for */
+
+    if (H5Sclose(space) < 0)
+        FAIL_STACK_ERROR
+    if (H5Pclose(dxpl) < 0)
+        FAIL_STACK_ERROR
+    if (H5Fclose(file) < 0)
+        FAIL_STACK_ERROR
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(dset);
+        H5Pclose(dcpl);
+        H5Pclose(dxpl);
+        H5Sclose(space);
+        H5Fclose(file);
+    }
+    H5E_END_TRY;
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    return FAIL;
+} /* end test_zero_copy_io() */
+
 /*-------------------------------------------------------------------------
  * Function:  test_userblock_offset
  *
@@ -1595,6 +1756,131 @@ error:
     return FAIL;
 } /* end test_tconv() */
 
+/*-------------------------------------------------------------------------
+ * Function:  test_tconv_in_place
+ *
+ * Purpose:   Test widening data type conversions on reads whose memory
+ *            selection is contiguous, which the library converts in place
+ *            in the application buffer, with and without chunking and a
+ *            data transform.
+ *
+ * Return:    Success:    0
+ *            Failure:    -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_tconv_in_place(hid_t file)
+{
+    const size_t nelmts = 300000; /* More than the default conversion buffer holds */
+    const size_t pad    = 5;      /* Unselected elements at each end of the memory buffer */
+    float *      out    = NULL;
+    double *     in     = NULL;
+    hsize_t      dims[1], mem_dims[1], start[1], count[1], chunk_dims[1];
+    hid_t        space = H5I_INVALID_HID, mem_space = H5I_INVALID_HID, dataset = H5I_INVALID_HID;
+    hid_t        dcpl = H5I_INVALID_HID, dxpl = H5I_INVALID_HID;
+    unsigned     chunked, xform;
+    size_t       u;
+
+    TESTING("in-place data type conversion on read");
+
+    if (NULL == (out = (float *)HDmalloc(nelmts * sizeof(float))))
+        TEST_ERROR
+    if (NULL == (in = (double *)HDmalloc((nelmts + 2 * pad) * sizeof(double))))
+        TEST_ERROR
+    for (u = 0; u < nelmts; u++)
+        out[u] = (float)u * 0.5f;
+
+    /* Select the middle of a padded memory buffer, which is still contiguous */
+    dims[0] = nelmts;
+    if ((space = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR
+    mem_dims[0] = nelmts + 2 * pad;
+    if ((mem_space = H5Screate_simple(1, mem_dims, NULL)) < 0)
+        TEST_ERROR
+    start[0] = pad;
+    count[0] = nelmts;
+    if (H5Sselect_hyperslab(mem_space, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+        TEST_ERROR
+
+    if ((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        TEST_ERROR
+    if (H5Pset_data_transform(dxpl, "2*x") < 0)
+        TEST_ERROR
+
+    for (chunked = 0; chunked < 2; chunked++) {
+        char name[64];
+
+        if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+            TEST_ERROR
+        if (chunked) {
+            chunk_dims[0] = nelmts / 7;
+            if (H5Pset_chunk(dcpl, 1, chunk_dims) < 0)
+                TEST_ERROR
+        } /* end if */
+
+        HDsnprintf(name, sizeof(name), "%s_%u", DSET_TCONV_IN_PLACE_NAME, chunked);
+        if ((dataset = H5Dcreate2(file, name, H5T_NATIVE_FLOAT, space, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            TEST_ERROR
+        if (H5Dwrite(dataset, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, out) < 0)
+            TEST_ERROR
+
+        for (xform = 0; xform < 2; xform++) {
+            for (u = 0; u < nelmts + 2 * pad; u++)
+                in[u] = -1.0;
+
+            if (H5Dread(dataset, H5T_NATIVE_DOUBLE, mem_space, space, xform ? dxpl : H5P_DEFAULT, in) < 0)
+                TEST_ERROR
+
+            /* Check the converted values and that the padding was left alone */
+            for (u = 0; u < nelmts + 2 * pad; u++) {
+                double expect = -1.0;
+
+                if (u >= pad && u < nelmts + pad)
+                    expect = (double)out[u - pad] * (xform ? 2.0 : 1.0);
+                if (!H5_DBL_ABS_EQUAL(in[u], expect)) {
+                    H5_FAILED();
+                    HDprintf("    chunked=%u, xform=%u: element %lu is %g, should be %g\n", chunked, xform,
+                             (unsigned long)u, in[u], expect);
+                    goto error;
+                } /* end if */
+            }     /* end for */
+        }         /* end for */
+
+        if (H5Dclose(dataset) < 0)
+            TEST_ERROR
+        if (H5Pclose(dcpl) < 0)
+            TEST_ERROR
+    } /* end for */
+
+    if (H5Pclose(dxpl) < 0)
+        TEST_ERROR
+    if (H5Sclose(mem_space) < 0)
+        TEST_ERROR
+    if (H5Sclose(space) < 0)
+        TEST_ERROR
+    HDfree(out);
+    HDfree(in);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    HDfree(out);
+    HDfree(in);
+
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(dataset);
+        H5Pclose(dcpl);
+        H5Pclose(dxpl);
+        H5Sclose(mem_space);
+        H5Sclose(space);
+    }
+    H5E_END_TRY;
+
+    return FAIL;
+} /* end test_tconv_in_place() */
+
 /* This message derives from H5Z */
 const H5Z_class2_t H5Z_BOGUS[1] = {{
     H5Z_CLASS_T_VERS, /* H5Z_class_t version */
@@ -15204,11 +15490,13 @@ main(void)
 
                 nerrors += (test_create(file) < 0 ? 1 : 0);
                 nerrors += (test_simple_io(envval, my_fapl) < 0 ? 1 : 0);
+                nerrors += (test_zero_copy_io(my_fapl) < 0 ? 1 : 0);
                 nerrors += (test_compact_io(my_fapl) < 0 ? 1 : 0);
                 nerrors += (test_max_compact(my_fapl) < 0 ? 1 : 0);
                 nerrors += (test_compact_open_close_dirty(my_fapl) < 0 ? 1 : 0);
                 nerrors += (test_conv_buffer(file) < 0 ? 1 : 0);
                 nerrors += (test_tconv(file) < 0 ? 1 : 0);
+                nerrors += (test_tconv_in_place(file) < 0 ? 1 : 0);
                 nerrors += (test_filters(file, my_fapl) < 0 ? 1 : 0);
                 nerrors += (test_onebyte_shuffle(file) < 0 ? 1 : 0);
                 nerrors += (test_nbit_int(file) < 0 ? 1 : 0);
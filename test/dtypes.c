@@ -3676,6 +3676,160 @@ error:
     return 1;
 } /* end test_compound_18() */
 
+/*-------------------------------------------------------------------------
+ * Function:    test_compound_19
+ *
+ * Purpose:     Tests compound conversions where some members are copied
+ *              unchanged or only byte-swapped, some need a conversion
+ *              function and a destination member has no source, with
+ *              both the optimized and the general conversion functions.
+ *
+ * Return:      Success:        0
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+#define COMPOUND19_NELMTS 100
+#define COMPOUND19_DSTSIZE 28
+static int
+test_compound_19(void)
+{
+    typedef struct {
+        int    a;
+        int    b;
+        double c;
+        short  d;
+        float  e;
+    } src_t;
+
+    hid_t          src_tid = -1, dst_tid = -1;
+    src_t *        orig = NULL;
+    unsigned char *buf  = NULL;
+    unsigned char *bkg  = NULL;
+    unsigned char  c_be[8], e_be[4];
+    int            pass, x;
+    size_t         u;
+
+    TESTING("compound conversions with unconverted members");
+
+    if (NULL == (orig = (src_t *)HDmalloc(COMPOUND19_NELMTS * sizeof(src_t))) ||
+        NULL == (buf = (unsigned char *)HDmalloc(COMPOUND19_NELMTS * COMPOUND19_DSTSIZE)) ||
+        NULL == (bkg = (unsigned char *)HDmalloc(COMPOUND19_NELMTS * COMPOUND19_DSTSIZE)))
+        goto error;
+    for (u = 0; u < COMPOUND19_NELMTS; u++) {
+        orig[u].a = (int)u;
+        orig[u].b = -(int)u;
+        orig[u].c = (double)u * 1.5;
+        orig[u].d = (short)(u * 3);
+        orig[u].e = (float)u * 0.25F;
+    } /* end for */
+
+    /* Source is the native struct */
+    if ((src_tid = H5Tcreate(H5T_COMPOUND, sizeof(src_t))) < 0)
+        FAIL_STACK_ERROR
+    if (H5Tinsert(src_tid, "a", HOFFSET(src_t, a), H5T_NATIVE_INT) < 0 ||
+        H5Tinsert(src_tid, "b", HOFFSET(src_t, b), H5T_NATIVE_INT) < 0 ||
+        H5Tinsert(src_tid, "c", HOFFSET(src_t, c), H5T_NATIVE_DOUBLE) < 0 ||
+        H5Tinsert(src_tid, "d", HOFFSET(src_t, d), H5T_NATIVE_SHORT) < 0 ||
+        H5Tinsert(src_tid, "e", HOFFSET(src_t, e), H5T_NATIVE_FLOAT) < 0)
+        FAIL_STACK_ERROR
+
+    /* Destination reorders the members, byte-swaps some of them, converts
+     * one of them and has an extra member which keeps its background value
+     */
+    if ((dst_tid = H5Tcreate(H5T_COMPOUND, (size_t)COMPOUND19_DSTSIZE)) < 0)
+        FAIL_STACK_ERROR
+    if (H5Tinsert(dst_tid, "e", (size_t)0, H5T_IEEE_F32BE) < 0 ||
+        H5Tinsert(dst_tid, "a", (size_t)4, H5T_NATIVE_INT) < 0 ||
+        H5Tinsert(dst_tid, "b", (size_t)8, H5T_NATIVE_INT) < 0 ||
+        H5Tinsert(dst_tid, "c", (size_t)12, H5T_IEEE_F64BE) < 0 ||
+        H5Tinsert(dst_tid, "d", (size_t)20, H5T_NATIVE_INT) < 0 ||
+        H5Tinsert(dst_tid, "x", (size_t)24, H5T_NATIVE_INT) < 0)
+        FAIL_STACK_ERROR
+
+    /* First with the optimized compound conversion, then with the general one */
+    for (pass = 0; pass < 2; pass++) {
+        if (pass == 1 && H5Tunregister(H5T_PERS_SOFT, "struct(opt)", -1, -1, NULL) < 0)
+            FAIL_STACK_ERROR
+
+        HDmemcpy(buf, orig, COMPOUND19_NELMTS * sizeof(src_t));
+        for (u = 0, x = 777; u < COMPOUND19_NELMTS; u++)
+            HDmemcpy(bkg + u * COMPOUND19_DSTSIZE + 24, &x, sizeof(int));
+        if (H5Tconvert(src_tid, dst_tid, (size_t)COMPOUND19_NELMTS, buf, bkg, H5P_DEFAULT) < 0)
+            FAIL_STACK_ERROR
+
+        for (u = 0; u < COMPOUND19_NELMTS; u++) {
+            unsigned char *elmt = buf + u * COMPOUND19_DSTSIZE;
+            double         c    = orig[u].c;
+            float          e    = orig[u].e;
+            int            a, b, d;
+
+            HDmemcpy(&a, elmt + 4, sizeof(int));
+            HDmemcpy(&b, elmt + 8, sizeof(int));
+            HDmemcpy(&d, elmt + 20, sizeof(int));
+            HDmemcpy(&x, elmt + 24, sizeof(int));
+            if (H5Tconvert(H5T_NATIVE_DOUBLE, H5T_IEEE_F64BE, (size_t)1, &c, NULL, H5P_DEFAULT) < 0 ||
+                H5Tconvert(H5T_NATIVE_FLOAT, H5T_IEEE_F32BE, (size_t)1, &e, NULL, H5P_DEFAULT) < 0)
+                FAIL_STACK_ERROR
+            HDmemcpy(c_be, &c, sizeof(c_be));
+            HDmemcpy(e_be, &e, sizeof(e_be));
+
+            if (a != orig[u].a || b != orig[u].b || d != orig[u].d || x != 777 ||
+                HDmemcmp(elmt + 12, c_be, sizeof(c_be)) || HDmemcmp(elmt, e_be, sizeof(e_be))) {
+                H5_FAILED();
+                HDprintf("    pass %d: element %u converted incorrectly\n", pass, (unsigned)u);
+                goto error;
+            } /* end if */
+        }     /* end for */
+
+        /* Convert back */
+        if (H5Tconvert(dst_tid, src_tid, (size_t)COMPOUND19_NELMTS, buf, bkg, H5P_DEFAULT) < 0)
+            FAIL_STACK_ERROR
+        for (u = 0; u < COMPOUND19_NELMTS; u++) {
+            const src_t *s = (const src_t *)buf + u;
+
+            if (s->a != orig[u].a || s->b != orig[u].b || !H5_DBL_ABS_EQUAL(s->c, orig[u].c) ||
+                s->d != orig[u].d || !H5_FLT_ABS_EQUAL(s->e, orig[u].e)) {
+                H5_FAILED();
+                HDprintf("    pass %d: element %u converted back incorrectly\n", pass, (unsigned)u);
+                goto error;
+            } /* end if */
+        }     /* end for */
+    }         /* end for */
+
+    if (H5Tclose(src_tid) < 0 || H5Tclose(dst_tid) < 0)
+        FAIL_STACK_ERROR
+    HDfree(orig);
+    HDfree(buf);
+    HDfree(bkg);
+
+    /* Restore the default error handler (set in h5_reset()) and the
+     * compound conversion functions */
+    h5_restore_err();
+    reset_hdf5();
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Tclose(src_tid);
+        H5Tclose(dst_tid);
+    }
+    H5E_END_TRY;
+    HDfree(orig);
+    HDfree(buf);
+    HDfree(bkg);
+
+    /* Restore the default error handler (set in h5_reset()) */
+    h5_restore_err();
+
+    reset_hdf5();
+
+    return 1;
+} /* end test_compound_19() */
+
 /*-------------------------------------------------------------------------
  * Function:    test_query
  *
@@ -5151,6 +5305,163 @@ test_conv_enum_2(void)
     return 0;
 }
 
+/* Exception callback for test_conv_enum_3(), which fills the destination
+ * value with a marker and counts the exceptions */
+static H5T_conv_ret_t
+conv_enum_except(H5T_conv_except_t except_type, hid_t H5_ATTR_UNUSED src_id, hid_t dst_id,
+                 void H5_ATTR_UNUSED *src_buf, void *dst_buf, void *_user_data)
+{
+    unsigned *nexcept = (unsigned *)_user_data;
+
+    if (except_type != H5T_CONV_EXCEPT_RANGE_HI)
+        return H5T_CONV_ABORT;
+    HDmemset(dst_buf, 0x5a, H5Tget_size(dst_id));
+    (*nexcept)++;
+
+    return H5T_CONV_HANDLED;
+}
+
+/* Store VAL in a SIZE-byte integer with byte order ORDER */
+static void
+conv_enum_encode(long long val, size_t size, H5T_order_t order, unsigned char *buf)
+{
+    size_t u;
+
+    for (u = 0; u < size; u++)
+        buf[H5T_ORDER_LE == order ? u : size - 1 - u] = (unsigned char)((unsigned long long)val >> (8 * u));
+}
+
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_enum_3
+ *
+ * Purpose:     Tests enumeration conversions between source and
+ *              destination types of each size, in both byte orders and
+ *              with values which do and don't fit in a lookup table,
+ *              with and without an exception callback for source values
+ *              which aren't members.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_conv_enum_3(void)
+{
+    const struct {
+        size_t      size;  /* Size of source values */
+        H5T_order_t order; /* Byte order of source values */
+        long long   step;  /* Difference between successive source values */
+    } srcs[] = {{1, H5T_ORDER_LE, 1},   {2, H5T_ORDER_BE, 300}, {4, H5T_ORDER_LE, -7},
+                {4, H5T_ORDER_BE, 1},   {4, H5T_ORDER_LE, 100000}};
+    const size_t   dst_sizes[] = {1, 2, 3, 4, 8};
+    const char *   mname[]     = {"RED", "GREEN", "BLUE", "YELLOW", "PINK", "PURPLE", "ORANGE", "WHITE"};
+    const unsigned nmembs      = 8;
+    const size_t   nelmts      = 1000;
+    hid_t          src_base = -1, dst_base = -1, srctype = -1, dsttype = -1, dxpl = -1;
+    unsigned char *buf = NULL, *expect = NULL;
+    unsigned char  val[8];
+    size_t         s, t, u;
+    unsigned       i, use_cb, nexcept = 0;
+
+    TESTING("enumeration conversion lookup tables");
+
+    if (NULL == (buf = (unsigned char *)HDmalloc(nelmts * 8)))
+        goto error;
+    if (NULL == (expect = (unsigned char *)HDmalloc(nelmts * 8)))
+        goto error;
+    if ((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        goto error;
+
+    for (s = 0; s < sizeof(srcs) / sizeof(srcs[0]); s++)
+        for (t = 0; t < sizeof(dst_sizes) / sizeof(dst_sizes[0]); t++)
+            for (use_cb = 0; use_cb < 2; use_cb++) {
+                size_t src_size = srcs[s].size, dst_size = dst_sizes[t];
+
+                /* Build the datatypes, listing the members in a different order */
+                if ((src_base = H5Tcopy(H5T_STD_I32LE)) < 0)
+                    goto error;
+                if (H5Tset_order(src_base, srcs[s].order) < 0 || H5Tset_size(src_base, src_size) < 0)
+                    goto error;
+                if ((dst_base = H5Tcopy(H5T_NATIVE_LLONG)) < 0)
+                    goto error;
+                if (H5Tset_size(dst_base, dst_size) < 0)
+                    goto error;
+                if ((srctype = H5Tenum_create(src_base)) < 0 || (dsttype = H5Tenum_create(dst_base)) < 0)
+                    goto error;
+                for (i = 0; i < nmembs; i++) {
+                    conv_enum_encode(srcs[s].step * i, src_size, srcs[s].order, val);
+                    if (H5Tenum_insert(srctype, mname[i], val) < 0)
+                        goto error;
+                    conv_enum_encode(5 * (long long)(nmembs - 1 - i) + 1, dst_size, H5Tget_order(dst_base),
+                                     val);
+                    if (H5Tenum_insert(dsttype, mname[nmembs - 1 - i], val) < 0)
+                        goto error;
+                } /* end for */
+
+                /* Source data, with every ninth value not a member */
+                for (u = 0; u < nelmts; u++) {
+                    i = (unsigned)(u % (nmembs + 1));
+                    conv_enum_encode(srcs[s].step * i, src_size, srcs[s].order, buf + u * src_size);
+                    if (i < nmembs)
+                        conv_enum_encode(5 * (long long)i + 1, dst_size, H5Tget_order(dst_base),
+                                         expect + u * dst_size);
+                    else
+                        HDmemset(expect + u * dst_size, use_cb ? 0x5a : 0xff, dst_size);
+                } /* end for */
+
+                nexcept = 0;
+                if (H5Pset_type_conv_cb(dxpl, use_cb ? conv_enum_except : NULL, &nexcept) < 0)
+                    goto error;
+                if (H5Tconvert(srctype, dsttype, nelmts, buf, NULL, dxpl) < 0)
+                    goto error;
+
+                /* Check results */
+                if (HDmemcmp(buf, expect, nelmts * dst_size) != 0) {
+                    H5_FAILED();
+                    HDprintf("    %u-byte %s source values to %u-byte values %s callback converted wrongly\n",
+                             (unsigned)src_size, H5T_ORDER_LE == srcs[s].order ? "LE" : "BE",
+                             (unsigned)dst_size, use_cb ? "with" : "without");
+                    goto error;
+                } /* end if */
+                if (nexcept != (use_cb ? nelmts / (nmembs + 1) : 0)) {
+                    H5_FAILED();
+                    HDprintf("    wrong number of exceptions: %u\n", nexcept);
+                    goto error;
+                } /* end if */
+
+                if (H5Tclose(srctype) < 0 || H5Tclose(dsttype) < 0)
+                    goto error;
+                if (H5Tclose(src_base) < 0 || H5Tclose(dst_base) < 0)
+                    goto error;
+                srctype = dsttype = src_base = dst_base = -1;
+            } /* end for */
+
+    if (H5Pclose(dxpl) < 0)
+        goto error;
+    HDfree(buf);
+    HDfree(expect);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Tclose(srctype);
+        H5Tclose(dsttype);
+        H5Tclose(src_base);
+        H5Tclose(dst_base);
+        H5Pclose(dxpl);
+    }
+    H5E_END_TRY;
+    HDfree(buf);
+    HDfree(expect);
+
+    return 1;
+}
+
 /*-------------------------------------------------------------------------
  * Function:    test_conv_bitfield
  *
@@ -5247,6 +5558,111 @@ error:
     return 1;
 }
 
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_threads
+ *
+ * Purpose:     Test numeric conversions split across conversion threads,
+ *              for conversions that grow, shrink and keep the size of the
+ *              elements.  The element count leaves a partial last block.
+ *
+ * Return:      Success:    0
+ *              Failure:    number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_conv_threads(void)
+{
+    const size_t nelmts = (size_t)(3 * 1024 * 1024 + 7);
+    hid_t        dxpl   = -1;
+    unsigned     nthreads;
+    void *       buf = NULL;
+    int *        ibuf;
+    double *     dbuf;
+    float *      fbuf;
+    uint8_t *    bbuf;
+    size_t       u;
+
+    TESTING("conversions with worker threads");
+
+    if (NULL == (buf = HDmalloc(nelmts * sizeof(double))))
+        goto error;
+    ibuf = (int *)buf;
+    dbuf = (double *)buf;
+    fbuf = (float *)buf;
+    bbuf = (uint8_t *)buf;
+
+    if ((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        goto error;
+    if (H5Pget_conv_threads(dxpl, &nthreads) < 0)
+        goto error;
+    if (nthreads != 1)
+        FAIL_PUTS_ERROR("wrong default number of conversion threads");
+    if (H5Pset_conv_threads(dxpl, 4) < 0)
+        goto error;
+    if (H5Pget_conv_threads(dxpl, &nthreads) < 0)
+        goto error;
+    if (nthreads != 4)
+        FAIL_PUTS_ERROR("wrong number of conversion threads");
+
+    /* int -> double: elements grow */
+    for (u = 0; u < nelmts; u++)
+        ibuf[u] = (int)u - (int)(nelmts / 2);
+    if (H5Tconvert(H5T_NATIVE_INT, H5T_NATIVE_DOUBLE, nelmts, buf, NULL, dxpl) < 0)
+        goto error;
+    for (u = 0; u < nelmts; u++)
+        if (!H5_DBL_ABS_EQUAL(dbuf[u], (double)((int)u - (int)(nelmts / 2)))) {
+            H5_FAILED();
+            HDprintf("    int -> double: element %lu is %g\n", (unsigned long)u, dbuf[u]);
+            goto error;
+        }
+
+    /* double -> float: elements shrink */
+    for (u = 0; u < nelmts; u++)
+        dbuf[u] = (double)u * 0.5;
+    if (H5Tconvert(H5T_NATIVE_DOUBLE, H5T_NATIVE_FLOAT, nelmts, buf, NULL, dxpl) < 0)
+        goto error;
+    for (u = 0; u < nelmts; u++)
+        if (!H5_FLT_ABS_EQUAL(fbuf[u], (float)u * 0.5F)) {
+            H5_FAILED();
+            HDprintf("    double -> float: element %lu is %g\n", (unsigned long)u, (double)fbuf[u]);
+            goto error;
+        }
+
+    /* little-endian -> big-endian: elements keep their size */
+    for (u = 0; u < nelmts; u++) {
+        bbuf[u * 4]     = (uint8_t)u;
+        bbuf[u * 4 + 1] = (uint8_t)(u >> 8);
+        bbuf[u * 4 + 2] = (uint8_t)(u >> 16);
+        bbuf[u * 4 + 3] = 0;
+    }
+    if (H5Tconvert(H5T_STD_U32LE, H5T_STD_U32BE, nelmts, buf, NULL, dxpl) < 0)
+        goto error;
+    for (u = 0; u < nelmts; u++)
+        if (bbuf[u * 4] != 0 || bbuf[u * 4 + 1] != (uint8_t)(u >> 16) || bbuf[u * 4 + 2] != (uint8_t)(u >> 8) ||
+            bbuf[u * 4 + 3] != (uint8_t)u) {
+            H5_FAILED();
+            HDprintf("    byte swap: element %lu is wrong\n", (unsigned long)u);
+            goto error;
+        }
+
+    if (H5Pclose(dxpl) < 0)
+        goto error;
+    HDfree(buf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(dxpl);
+    }
+    H5E_END_TRY;
+    HDfree(buf);
+    return 1;
+} /* end test_conv_threads() */
+
 /*-------------------------------------------------------------------------
  * Function:    test_bitfield_funcs
  *
@@ -6616,6 +7032,213 @@ error:
 #endif /* H5_SIZEOF_INT==4 && H5_SIZEOF_FLOAT==4 */
 } /* end test_int_float_except() */
 
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_path_table
+ *
+ * Purpose:     Tests looking up conversion paths in the path table:
+ *              compound types with the same members in a different order
+ *              share a path, paths stay put as the table grows, and
+ *              replacing and removing a path doesn't disturb the others.
+ *
+ * Return:      Success:    0
+ *              Failure:    number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+#define NPATHS 400
+static int
+test_conv_path_table(void)
+{
+    hid_t        cmpd1 = -1, cmpd2 = -1, cmpd3 = -1;
+    hid_t        src[NPATHS], dst[NPATHS];
+    H5T_cdata_t *cdata[NPATHS];
+    H5T_cdata_t *cd1, *cd2;
+    unsigned     u;
+
+    TESTING("conversion path table");
+
+    for (u = 0; u < NPATHS; u++)
+        src[u] = dst[u] = -1;
+
+    /* Same members, inserted in a different order */
+    if ((cmpd1 = H5Tcreate(H5T_COMPOUND, 16)) < 0)
+        goto error;
+    if (H5Tinsert(cmpd1, "a", 0, H5T_NATIVE_INT) < 0 || H5Tinsert(cmpd1, "b", 8, H5T_NATIVE_DOUBLE) < 0)
+        goto error;
+    if ((cmpd2 = H5Tcreate(H5T_COMPOUND, 16)) < 0)
+        goto error;
+    if (H5Tinsert(cmpd2, "b", 8, H5T_NATIVE_DOUBLE) < 0 || H5Tinsert(cmpd2, "a", 0, H5T_NATIVE_INT) < 0)
+        goto error;
+    if ((cmpd3 = H5Tcreate(H5T_COMPOUND, 12)) < 0)
+        goto error;
+    if (H5Tinsert(cmpd3, "b", 0, H5T_NATIVE_DOUBLE) < 0 || H5Tinsert(cmpd3, "a", 8, H5T_NATIVE_INT) < 0)
+        goto error;
+    if (NULL == H5Tfind(cmpd1, cmpd3, &cd1) || NULL == H5Tfind(cmpd2, cmpd3, &cd2))
+        goto error;
+    if (cd1 != cd2)
+        FAIL_PUTS_ERROR("equal compound types found different conversion paths");
+
+    /* Enough paths to grow the table */
+    for (u = 0; u < NPATHS; u++) {
+        if ((src[u] = H5Tcopy(H5T_C_S1)) < 0 || H5Tset_size(src[u], (size_t)u + 1) < 0)
+            goto error;
+        if ((dst[u] = H5Tcopy(H5T_C_S1)) < 0 || H5Tset_size(dst[u], (size_t)u + 2) < 0)
+            goto error;
+        if (NULL == H5Tfind(src[u], dst[u], &cdata[u]))
+            goto error;
+    } /* end for */
+    for (u = 0; u < NPATHS; u++) {
+        if (NULL == H5Tfind(src[u], dst[u], &cd1))
+            goto error;
+        if (cd1 != cdata[u])
+            FAIL_PUTS_ERROR("conversion path moved as the table grew");
+    } /* end for */
+
+    /* Replace one path with a hard conversion, then remove it again */
+    if (H5Tregister(H5T_PERS_HARD, "path_test", src[NPATHS / 2], dst[NPATHS / 2], convert_opaque) < 0)
+        goto error;
+    if (NULL == H5Tfind(src[NPATHS / 2], dst[NPATHS / 2], &cd1))
+        goto error;
+    if (cd1 == cdata[NPATHS / 2])
+        FAIL_PUTS_ERROR("hard conversion didn't replace the path");
+    if (H5Tunregister(H5T_PERS_HARD, "path_test", src[NPATHS / 2], dst[NPATHS / 2], convert_opaque) < 0)
+        goto error;
+    for (u = 0; u < NPATHS; u++) {
+        if (NULL == H5Tfind(src[u], dst[u], &cd1))
+            goto error;
+        if (u != NPATHS / 2 && cd1 != cdata[u])
+            FAIL_PUTS_ERROR("conversion path moved after another path was removed");
+    } /* end for */
+
+    for (u = 0; u < NPATHS; u++)
+        if (H5Tclose(src[u]) < 0 || H5Tclose(dst[u]) < 0)
+            goto error;
+    if (H5Tclose(cmpd1) < 0 || H5Tclose(cmpd2) < 0 || H5Tclose(cmpd3) < 0)
+        goto error;
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        for (u = 0; u < NPATHS; u++) {
+            H5Tclose(src[u]);
+            H5Tclose(dst[u]);
+        } /* end for */
+        H5Tclose(cmpd1);
+        H5Tclose(cmpd2);
+        H5Tclose(cmpd3);
+    }
+    H5E_END_TRY;
+    return 1;
+} /* end test_conv_path_table() */
+#undef NPATHS
+
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_order
+ *
+ * Purpose:     Tests byte order conversions of 2, 4, 8 and 16-byte
+ *              integers, for element counts on either side of the
+ *              boundaries of the vectorized byte swapping, both packed and
+ *              with a stride between the elements.
+ *
+ * Return:      Success:    0
+ *              Failure:    number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+#define ORDER_NELMTS 67
+static int
+test_conv_order(void)
+{
+    hid_t          be = -1, le = -1;
+    unsigned char *buf = NULL, *orig = NULL, *bkg = NULL;
+    size_t         size, stride, nelmts, u, v;
+
+    TESTING("byte order conversions");
+
+    if (NULL == (buf = (unsigned char *)HDmalloc(ORDER_NELMTS * 32)))
+        goto error;
+    if (NULL == (orig = (unsigned char *)HDmalloc(ORDER_NELMTS * 32)))
+        goto error;
+    if (NULL == (bkg = (unsigned char *)HDcalloc(ORDER_NELMTS, 32)))
+        goto error;
+    for (u = 0; u < ORDER_NELMTS * 32; u++)
+        orig[u] = (unsigned char)(u * 7 + 3);
+
+    for (size = 2; size <= 16; size *= 2) {
+        if ((be = H5Tcopy(H5T_STD_U16BE)) < 0 || H5Tset_size(be, size) < 0 ||
+            H5Tset_precision(be, 8 * size) < 0)
+            goto error;
+        if ((le = H5Tcopy(H5T_STD_U16LE)) < 0 || H5Tset_size(le, size) < 0 ||
+            H5Tset_precision(le, 8 * size) < 0)
+            goto error;
+
+        for (stride = size; stride <= 2 * size; stride += size)
+            for (nelmts = 0; nelmts <= ORDER_NELMTS; nelmts++) {
+                HDmemcpy(buf, orig, ORDER_NELMTS * 32);
+
+                /* Convert packed elements with H5Tconvert() and strided ones through a compound */
+                if (stride == size) {
+                    if (H5Tconvert(be, le, nelmts, buf, NULL, H5P_DEFAULT) < 0)
+                        goto error;
+                } /* end if */
+                else {
+                    hid_t src_cmpd, dst_cmpd;
+
+                    if ((src_cmpd = H5Tcreate(H5T_COMPOUND, stride)) < 0 ||
+                        H5Tinsert(src_cmpd, "a", 0, be) < 0)
+                        goto error;
+                    if ((dst_cmpd = H5Tcreate(H5T_COMPOUND, stride)) < 0 ||
+                        H5Tinsert(dst_cmpd, "a", 0, le) < 0)
+                        goto error;
+                    if (H5Tconvert(src_cmpd, dst_cmpd, nelmts, buf, bkg, H5P_DEFAULT) < 0)
+                        goto error;
+                    if (H5Tclose(src_cmpd) < 0 || H5Tclose(dst_cmpd) < 0)
+                        goto error;
+                } /* end else */
+
+                /* Check that each element was reversed and nothing else changed */
+                for (u = 0; u < nelmts; u++)
+                    for (v = 0; v < size; v++)
+                        if (buf[u * stride + v] != orig[u * stride + size - (v + 1)]) {
+                            H5_FAILED();
+                            HDprintf("    %u-byte element %u (stride %u, %u elements) not swapped\n",
+                                     (unsigned)size, (unsigned)u, (unsigned)stride, (unsigned)nelmts);
+                            goto error;
+                        } /* end if */
+                if (stride == size && HDmemcmp(buf + nelmts * size, orig + nelmts * size,
+                                               (ORDER_NELMTS * 32) - nelmts * size) != 0)
+                    FAIL_PUTS_ERROR("byte order conversion wrote past the last element");
+            } /* end for */
+
+        if (H5Tclose(be) < 0 || H5Tclose(le) < 0)
+            goto error;
+        be = le = -1;
+    } /* end for */
+
+    HDfree(buf);
+    HDfree(orig);
+    HDfree(bkg);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Tclose(be);
+        H5Tclose(le);
+    }
+    H5E_END_TRY;
+    HDfree(buf);
+    HDfree(orig);
+    HDfree(bkg);
+    return 1;
+} /* end test_conv_order() */
+#undef ORDER_NELMTS
+
 /*-------------------------------------------------------------------------
  * Function:    test_set_order
  *
@@ -8584,11 +9207,16 @@ main(void)
     nerrors += test_compound_16();
     nerrors += test_compound_17();
     nerrors += test_compound_18();
+    nerrors += test_compound_19();
     nerrors += test_conv_enum_1();
     nerrors += test_conv_enum_2();
+    nerrors += test_conv_enum_3();
     nerrors += test_conv_bitfield();
+    nerrors += test_conv_threads();
     nerrors += test_bitfield_funcs();
     nerrors += test_opaque();
+    nerrors += test_conv_path_table();
+    nerrors += test_conv_order();
     nerrors += test_set_order();
     nerrors += test_utf_ascii_conv();
     nerrors += test_versionbounds();
@@ -77,7 +77,8 @@ main(void)
                                            0 /*FALSE*/,
                                            0.2f,
                                            (256 * 2048),
-                                           H5AC_METADATA_WRITE_STRATEGY__PROCESS_0_ONLY};
+                                           H5AC_METADATA_WRITE_STRATEGY__PROCESS_0_ONLY,
+                                           H5C_repl__lru};
     H5AC_cache_image_config_t my_cache_image_config = {H5AC__CURR_CACHE_IMAGE_CONFIG_VERSION, TRUE, FALSE,
                                                        -1};
 
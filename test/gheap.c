@@ -48,7 +48,7 @@
         } /* end if */                                                                                       \
     }     /* end GHEAP_REPEATED_ERR */
 
-const char *FILENAME[] = {"gheap1", "gheap2", "gheap3", "gheap4", "gheapooo", NULL};
+const char *FILENAME[] = {"gheap1", "gheap2", "gheap3", "gheap4", "gheapooo", "gheapreuse", NULL};
 
 /*-------------------------------------------------------------------------
  * Function:    test_1
@@ -549,6 +549,151 @@ error:
     return MAX(1, nerrors);
 } /* end test_ooo_indices */
 
+/*-------------------------------------------------------------------------
+ * Function:    test_reuse
+ *
+ * Purpose:     Tests that free space in any of a file's collections is
+ *              reused, no matter how many collections have free space,
+ *              and that batches of objects fill the free space left by
+ *              earlier batches before creating new collections.
+ *
+ * Return:      Success:    0
+ *
+ *              Failure:    number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_reuse(hid_t fapl)
+{
+    hid_t       file = H5I_INVALID_HID;
+    H5F_t *     f    = NULL;
+    H5HG_t *    obj  = NULL;
+    H5HG_t      small_obj[40];
+    size_t      small_sizes[4];
+    const void *small_bufs[4];
+    uint8_t *   out = NULL;
+    uint8_t *   in  = NULL;
+    haddr_t     batch_addr;
+    size_t      nobjs = 60;    /* Number of large objects */
+    size_t      size  = 20000; /* Size of each large object */
+    size_t      u, v;
+    int         nerrors = 0;
+    char        filename[1024];
+
+    TESTING("reuse of free space in collections");
+
+    if (NULL == (obj = (H5HG_t *)HDmalloc(nobjs * sizeof(H5HG_t))))
+        goto error;
+    if (NULL == (out = (uint8_t *)HDmalloc(size)))
+        goto error;
+    if (NULL == (in = (uint8_t *)HDmalloc(size)))
+        goto error;
+
+    /* Open a clean file */
+    h5_fixname(FILENAME[5], fapl, filename, sizeof filename);
+    if ((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        goto error;
+    if (NULL == (f = (H5F_t *)H5VL_object(file))) {
+        H5_FAILED();
+        HDputs("    Unable to create file");
+        goto error;
+    }
+
+    /* Fill many collections, several large objects apiece */
+    for (u = 0; u < nobjs; u++) {
+        HDmemset(out, (int)('A' + u % 26), size);
+        if (H5HG_insert(f, size, out, obj + u) < 0)
+            GHEAP_REPEATED_ERR("    Unable to insert object into global heap")
+    }
+
+    /* Free space in each collection by removing every other object */
+    for (u = 0; u < nobjs; u += 2)
+        if (H5HG_remove(f, obj + u) < 0)
+            GHEAP_REPEATED_ERR("    Unable to remove object from global heap")
+
+    /* Insert objects of the same size again, which should all go into the
+     * freed space rather than into new collections
+     */
+    for (u = 0; u < nobjs; u += 2) {
+        H5HG_t new_obj;
+
+        HDmemset(out, (int)('a' + u % 26), size);
+        if (H5HG_insert(f, size, out, &new_obj) < 0)
+            GHEAP_REPEATED_ERR("    Unable to insert object into global heap")
+        for (v = 1; v < nobjs; v += 2)
+            if (H5F_addr_eq(new_obj.addr, obj[v].addr))
+                break;
+        if (v >= nobjs)
+            GHEAP_REPEATED_ERR("    Object not placed in a collection with free space")
+        obj[u] = new_obj;
+    }
+
+    /* Insert small batches of small objects, which should all be packed into
+     * the collection the first batch creates
+     */
+    batch_addr = HADDR_UNDEF;
+    for (u = 0; u < 10; u++) {
+        for (v = 0; v < 4; v++) {
+            small_sizes[v] = 50 + v;
+            small_bufs[v]  = out;
+        }
+        HDmemset(out, (int)('0' + u), size);
+        if (H5HG_insert_batch(f, (size_t)4, small_sizes, small_bufs, small_obj + 4 * u) < 0)
+            GHEAP_REPEATED_ERR("    Unable to insert batch of objects into global heap")
+        for (v = 0; v < 4; v++) {
+            if (!H5F_addr_defined(batch_addr))
+                batch_addr = small_obj[4 * u].addr;
+            if (!H5F_addr_eq(batch_addr, small_obj[4 * u + v].addr))
+                GHEAP_REPEATED_ERR("    Batch not packed into the collection of earlier batches")
+        }
+    }
+
+    /* Reopen the file and read back the objects */
+    if (H5Fclose(file) < 0)
+        goto error;
+    if ((file = H5Fopen(filename, H5F_ACC_RDWR, fapl)) < 0)
+        goto error;
+    if (NULL == (f = (H5F_t *)H5VL_object(file))) {
+        H5_FAILED();
+        HDputs("    Unable to open file");
+        goto error;
+    }
+    for (u = 0; u < nobjs; u++) {
+        HDmemset(out, (int)((u % 2 ? 'A' : 'a') + u % 26), size);
+        if (NULL == H5HG_read(f, obj + u, in, NULL))
+            GHEAP_REPEATED_ERR("    Unable to read object")
+        else if (HDmemcmp(in, out, size))
+            GHEAP_REPEATED_ERR("    Value read doesn't match value written")
+    }
+    for (u = 0; u < 40; u++) {
+        HDmemset(out, (int)('0' + u / 4), size);
+        if (NULL == H5HG_read(f, small_obj + u, in, NULL))
+            GHEAP_REPEATED_ERR("    Unable to read object")
+        else if (HDmemcmp(in, out, small_sizes[u % 4]))
+            GHEAP_REPEATED_ERR("    Value read doesn't match value written")
+    }
+
+    if (H5Fclose(file) < 0)
+        goto error;
+    if (nerrors)
+        goto error;
+    HDfree(obj);
+    HDfree(out);
+    HDfree(in);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY { H5Fclose(file); }
+    H5E_END_TRY;
+    HDfree(obj);
+    HDfree(out);
+    HDfree(in);
+    return MAX(1, nerrors);
+} /* end test_reuse */
+
 /*-------------------------------------------------------------------------
  * Function:	main
  *
@@ -579,6 +724,7 @@ main(void)
     nerrors += test_3(fapl_id);
     nerrors += test_4(fapl_id);
     nerrors += test_ooo_indices(fapl_id);
+    nerrors += test_reuse(fapl_id);
 
     /* Verify symbol table messages are cached */
     nerrors += (h5_verify_cached_stabs(FILENAME, fapl_id) < 0 ? 1 : 0);
@@ -1961,6 +1961,8 @@ static const H5FD_class_t H5FD_dummy_g = {
     NULL,                /* get_handle   */
     dummy_vfd_read,      /* read         */
     dummy_vfd_write,     /* write        */
+    NULL,                /* read_vector  */
+    NULL,                /* write_vector */
     NULL,                /* flush        */
     NULL,                /* truncate     */
     NULL,                /* lock         */
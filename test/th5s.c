@@ -1888,7 +1888,9 @@ test_h5s_encode_irregular_hyper(H5F_libver_t low, H5F_libver_t high)
         if (high <= H5F_LIBVER_V110 && config == CONFIG_32)
             expected_to_fail = TRUE;
 
-        if (low >= H5F_LIBVER_V112 || config == CONFIG_32)
+        if (low >= H5F_LIBVER_V114)
+            expected_version = 4;
+        else if (low >= H5F_LIBVER_V112 || config == CONFIG_32)
             expected_version = 3;
         else
             expected_version = 1;
@@ -1961,6 +1963,136 @@ test_h5s_encode_irregular_hyper(H5F_libver_t low, H5F_libver_t high)
 
 } /* test_h5s_encode_irregular_hyper() */
 
+/****************************************************************
+**
+**  test_h5s_encode_span_tree():
+**      This test verifies that multi-dimensional irregular
+**      hyperslabs encoded as a span tree (version 4 selection info)
+**      decode to the same selection, and take less space than the
+**      block list encoding (version 3 selection info).
+**
+****************************************************************/
+static void
+test_h5s_encode_span_tree(void)
+{
+    hid_t    fapl_v112, fapl_latest;                   /* File access property list IDs */
+    hid_t    sid;                                      /* Dataspace ID */
+    hid_t    d_sid;                                    /* Decoded dataspace ID */
+    hsize_t  dims[3] = {40, 100, 1000};                /* Dataspace dimensions */
+    hsize_t  start[3], stride[3], count[3], block[3];  /* Selection info */
+    hsize_t  nblocks;                                  /* # of blocks in selection */
+    hsize_t *blocks   = NULL;                          /* Block list for original selection */
+    hsize_t *d_blocks = NULL;                          /* Block list for decoded selection */
+    size_t   v3_size, v4_size;                         /* Sizes of encoded selections */
+    char *   buf = NULL;                               /* Encoded selection */
+    htri_t   check;                                    /* Selection comparison result */
+    herr_t   ret;                                      /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing Dataspace encoding of hyperslab span trees\n"));
+
+    fapl_v112 = H5Pcreate(H5P_FILE_ACCESS);
+    CHECK(fapl_v112, FAIL, "H5Pcreate");
+    ret = H5Pset_libver_bounds(fapl_v112, H5F_LIBVER_V112, H5F_LIBVER_LATEST);
+    CHECK(ret, FAIL, "H5Pset_libver_bounds");
+    fapl_latest = H5Pcreate(H5P_FILE_ACCESS);
+    CHECK(fapl_latest, FAIL, "H5Pcreate");
+    ret = H5Pset_libver_bounds(fapl_latest, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+    CHECK(ret, FAIL, "H5Pset_libver_bounds");
+
+    sid = H5Screate_simple(3, dims, NULL);
+    CHECK(sid, FAIL, "H5Screate_simple");
+
+    /* Build an irregular selection: a strided grid of small blocks, with
+     *  a second, overlapping grid of different shape or'ed in.
+     */
+    start[0]  = 1;
+    start[1]  = 2;
+    start[2]  = 3;
+    stride[0] = 4;
+    stride[1] = 5;
+    stride[2] = 7;
+    count[0]  = 10;
+    count[1]  = 20;
+    count[2]  = 140;
+    block[0]  = 2;
+    block[1]  = 3;
+    block[2]  = 2;
+    ret       = H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, stride, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    start[0]  = 0;
+    start[1]  = 10;
+    start[2]  = 500;
+    stride[0] = 3;
+    stride[1] = 11;
+    stride[2] = 13;
+    count[0]  = 13;
+    count[1]  = 8;
+    count[2]  = 30;
+    block[0]  = 1;
+    block[1]  = 2;
+    block[2]  = 4;
+    ret       = H5Sselect_hyperslab(sid, H5S_SELECT_OR, start, stride, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+
+    check = H5Sis_regular_hyperslab(sid);
+    VERIFY(check, FALSE, "H5Sis_regular_hyperslab");
+
+    /* Get the encoded sizes for both versions */
+    ret = H5Sencode2(sid, NULL, &v3_size, fapl_v112);
+    CHECK(ret, FAIL, "H5Sencode2");
+    ret = H5Sencode2(sid, NULL, &v4_size, fapl_latest);
+    CHECK(ret, FAIL, "H5Sencode2");
+    if (v4_size >= v3_size)
+        TestErrPrintf("span tree encoding (%zu bytes) is not smaller than block list encoding (%zu bytes)\n",
+                      v4_size, v3_size);
+
+    /* Encode & decode with the span tree encoding */
+    buf = (char *)HDmalloc(v4_size);
+    CHECK_PTR(buf, "HDmalloc");
+    ret = H5Sencode2(sid, buf, &v4_size, fapl_latest);
+    CHECK(ret, FAIL, "H5Sencode2");
+    {
+        /* Skip the H5Sencode header and the encoded extent to get to the selection version */
+        size_t ext_size = (size_t)((uint8_t)buf[3] | ((uint8_t)buf[4] << 8) | ((uint8_t)buf[5] << 16) |
+                                   ((uint32_t)(uint8_t)buf[6] << 24));
+
+        VERIFY((uint32_t)buf[7 + ext_size + 4], 4, "Version for hyperslab selection info");
+    }
+    d_sid = H5Sdecode(buf);
+    CHECK(d_sid, FAIL, "H5Sdecode");
+
+    /* Verify the decoded selection */
+    VERIFY(H5Sget_select_npoints(d_sid), H5Sget_select_npoints(sid), "Compare npoints");
+    check = H5Sselect_shape_same(sid, d_sid);
+    VERIFY(check, TRUE, "H5Sselect_shape_same");
+    nblocks = (hsize_t)H5Sget_select_hyper_nblocks(sid);
+    VERIFY(H5Sget_select_hyper_nblocks(d_sid), (hssize_t)nblocks, "H5Sget_select_hyper_nblocks");
+    blocks = (hsize_t *)HDmalloc(nblocks * 6 * sizeof(hsize_t));
+    CHECK_PTR(blocks, "HDmalloc");
+    d_blocks = (hsize_t *)HDmalloc(nblocks * 6 * sizeof(hsize_t));
+    CHECK_PTR(d_blocks, "HDmalloc");
+    ret = H5Sget_select_hyper_blocklist(sid, (hsize_t)0, nblocks, blocks);
+    CHECK(ret, FAIL, "H5Sget_select_hyper_blocklist");
+    ret = H5Sget_select_hyper_blocklist(d_sid, (hsize_t)0, nblocks, d_blocks);
+    CHECK(ret, FAIL, "H5Sget_select_hyper_blocklist");
+    if (HDmemcmp(blocks, d_blocks, nblocks * 6 * sizeof(hsize_t)) != 0)
+        TestErrPrintf("decoded span tree selection has different blocks\n");
+
+    ret = H5Sclose(d_sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Sclose(sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Pclose(fapl_v112);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Pclose(fapl_latest);
+    CHECK(ret, FAIL, "H5Pclose");
+
+    HDfree(buf);
+    HDfree(blocks);
+    HDfree(d_blocks);
+} /* test_h5s_encode_span_tree() */
+
 /****************************************************************
 **
 **  test_h5s_encode_points():
@@ -3363,7 +3495,8 @@ test_h5s(void)
         } /* end high bound */
     }     /* end low bound */
 
-    test_h5s_encode_length(); /* Test version 2 hyperslab encoding length is correct */
+    test_h5s_encode_length();    /* Test version 2 hyperslab encoding length is correct */
+    test_h5s_encode_span_tree(); /* Test version 4 hyperslab span tree encoding */
 #ifndef H5_NO_DEPRECATED_SYMBOLS
     test_h5s_encode1(); /* Test operations with old API routine (H5Sencode1) */
 #endif                  /* H5_NO_DEPRECATED_SYMBOLS */
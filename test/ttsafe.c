@@ -113,6 +113,7 @@ main(int argc, char *argv[])
 #endif /* H5_HAVE_PTHREAD_H */
     AddTest("acreate", tts_acreate, cleanup_acreate, "multi-attribute creation", NULL);
     AddTest("attr_vlen", tts_attr_vlen, cleanup_attr_vlen, "multi-file-attribute-vlen read", NULL);
+    AddTest("shared_reads", tts_shared_reads, cleanup_shared_reads, "shared metadata cache reads", NULL);
 
 #else /* H5_HAVE_THREADSAFE */
 
@@ -0,0 +1,205 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/********************************************************************
+ *
+ * Testing for thread safety of shared metadata cache reads.
+ * ------------------------------------------------------------------
+ *
+ * Purpose: Verify that threads that don't hold the library's lock can
+ *          look up object headers in the metadata cache of a file
+ *          opened read-only while the library evicts and loads them.
+ *
+ *          --Create a file with NUM_GROUPS groups and close it
+ *          --Open it read-only and find the groups' object headers
+ *          --Create NUM_THREADS threads, each of which:
+ *              --Looks up object headers with H5AC_protect_shared()
+ *              --Checks the entries found, and releases them
+ *          --Meanwhile, shrink the metadata cache and read the groups
+ *            again, over and over, so that object headers are evicted
+ *            and loaded while the threads look them up
+ *
+ ********************************************************************/
+
+#include "ttsafe.h"
+#include "H5ACprivate.h"
+#include "H5VLprivate.h"
+
+#ifdef H5_HAVE_THREADSAFE
+
+#define FILENAME    "ttsafe_shared_reads.h5"
+#define NUM_GROUPS  2048
+#define NUM_THREADS 8
+#define NUM_ROUNDS  4
+
+typedef struct shared_reads_info_t {
+    H5F_t *          f;                 /* File whose cache is read */
+    haddr_t *        addrs;             /* Addresses of the object headers */
+    volatile hbool_t done;              /* Whether the threads should stop */
+    volatile int     nerrors;           /* # of bad entries found */
+    volatile int     nhits[NUM_THREADS]; /* # of entries found by each thread */
+} shared_reads_info_t;
+
+typedef struct shared_reads_thread_t {
+    shared_reads_info_t *info; /* Information shared by the threads */
+    unsigned             id;   /* Number of the thread */
+} shared_reads_thread_t;
+
+void *tts_shared_reads_thread(void *);
+
+static void
+set_cache_size(hid_t fid, size_t size)
+{
+    H5AC_cache_config_t config;
+    herr_t              ret;
+
+    config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    ret            = H5Fget_mdc_config(fid, &config);
+    CHECK(ret, FAIL, "H5Fget_mdc_config");
+
+    config.set_initial_size = TRUE;
+    config.initial_size     = size;
+    config.min_size         = H5C__MIN_MAX_CACHE_SIZE;
+    config.max_size         = 4 * 1024 * 1024;
+    config.incr_mode        = H5C_incr__off;
+    config.flash_incr_mode  = H5C_flash_incr__off;
+    config.decr_mode        = H5C_decr__off;
+
+    ret = H5Fset_mdc_config(fid, &config);
+    CHECK(ret, FAIL, "H5Fset_mdc_config");
+} /* end set_cache_size() */
+
+void
+tts_shared_reads(void)
+{
+    H5TS_thread_t         threads[NUM_THREADS];
+    shared_reads_thread_t thread_info[NUM_THREADS];
+    shared_reads_info_t   info;
+    H5O_info2_t           oinfo;
+    hid_t                 fid = H5I_INVALID_HID;
+    hid_t                 gid = H5I_INVALID_HID;
+    char                  name[32];
+    int                   nhits = 0;
+    int                   round;
+    int                   i;
+    herr_t                ret;
+
+    HDmemset(&info, 0, sizeof(info));
+    info.addrs = (haddr_t *)HDmalloc(NUM_GROUPS * sizeof(haddr_t));
+    CHECK_PTR(info.addrs, "HDmalloc");
+
+    /* Create the groups */
+    fid = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid, H5I_INVALID_HID, "H5Fcreate");
+
+    for (i = 0; i < NUM_GROUPS; i++) {
+        HDsnprintf(name, sizeof(name), "g%d", i);
+        gid = H5Gcreate2(fid, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        CHECK(gid, H5I_INVALID_HID, "H5Gcreate2");
+        ret = H5Gclose(gid);
+        CHECK(ret, FAIL, "H5Gclose");
+    } /* end for */
+
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    /* Open the file read-only, and find the object headers, which loads
+     * them into the cache
+     */
+    fid = H5Fopen(FILENAME, H5F_ACC_RDONLY, H5P_DEFAULT);
+    CHECK(fid, H5I_INVALID_HID, "H5Fopen");
+
+    set_cache_size(fid, (size_t)(4 * 1024 * 1024));
+
+    for (i = 0; i < NUM_GROUPS; i++) {
+        HDsnprintf(name, sizeof(name), "g%d", i);
+        ret = H5Oget_info_by_name3(fid, name, &oinfo, H5O_INFO_BASIC, H5P_DEFAULT);
+        CHECK(ret, FAIL, "H5Oget_info_by_name3");
+        ret = H5VLnative_token_to_addr(fid, oinfo.token, &info.addrs[i]);
+        CHECK(ret, FAIL, "H5VLnative_token_to_addr");
+    } /* end for */
+
+    info.f = (H5F_t *)H5VL_object_verify(fid, H5I_FILE);
+    CHECK_PTR(info.f, "H5VL_object_verify");
+
+    /* Start the threads */
+    for (i = 0; i < NUM_THREADS; i++) {
+        thread_info[i].info = &info;
+        thread_info[i].id   = (unsigned)i;
+        threads[i]          = H5TS_create_thread(tts_shared_reads_thread, NULL, &thread_info[i]);
+    } /* end for */
+
+    /* Evict the object headers and load them again while the threads are
+     * looking them up
+     */
+    for (round = 0; round < NUM_ROUNDS; round++) {
+        set_cache_size(fid, (round % 2) ? (size_t)(4 * 1024 * 1024) : H5C__MIN_MAX_CACHE_SIZE);
+
+        for (i = 0; i < NUM_GROUPS; i++) {
+            HDsnprintf(name, sizeof(name), "g%d", i);
+            ret = H5Oget_info_by_name3(fid, name, &oinfo, H5O_INFO_BASIC, H5P_DEFAULT);
+            CHECK(ret, FAIL, "H5Oget_info_by_name3");
+        } /* end for */
+    }     /* end for */
+
+    /* Stop the threads */
+    info.done = TRUE;
+    for (i = 0; i < NUM_THREADS; i++) {
+        H5TS_wait_for_thread(threads[i]);
+        nhits += info.nhits[i];
+    } /* end for */
+
+    VERIFY(info.nerrors, 0, "H5AC_protect_shared");
+    if (nhits == 0)
+        TestErrPrintf("No object header found by the threads\n");
+
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    HDfree(info.addrs);
+} /* end tts_shared_reads() */
+
+/* Look up object headers until told to stop */
+void *
+tts_shared_reads_thread(void *client_data)
+{
+    shared_reads_thread_t *thread_info = (shared_reads_thread_t *)client_data;
+    shared_reads_info_t *  info        = thread_info->info;
+    unsigned               seed        = thread_info->id + 1;
+
+    while (!info->done) {
+        haddr_t      addr;
+        H5AC_info_t *entry;
+
+        seed = seed * 1103515245 + 12345;
+        addr = info->addrs[(seed >> 8) % NUM_GROUPS];
+
+        if (NULL != (entry = (H5AC_info_t *)H5AC_protect_shared(info->f, H5AC_OHDR, addr))) {
+            if (!H5F_addr_eq(entry->addr, addr) || entry->type != H5AC_OHDR || entry->is_dirty ||
+                entry->shared_ref_count < 1)
+                info->nerrors++;
+            else
+                info->nhits[thread_info->id]++;
+            H5AC_unprotect_shared(entry);
+        } /* end if */
+    }     /* end while */
+
+    return NULL;
+} /* end tts_shared_reads_thread() */
+
+void
+cleanup_shared_reads(void)
+{
+    HDunlink(FILENAME);
+}
+
+#endif /*H5_HAVE_THREADSAFE*/
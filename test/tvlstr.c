@@ -37,6 +37,16 @@
 /* Definitions for the VL re-writing test */
 #define REWRITE_NDATASETS 32
 
+/* Number of strings (and length of the longest one) for test_vlstrings_batch() */
+#define BATCH_NSTRINGS    5000
+#define BATCH_LONG_STRLEN 1100000
+
+/* Number of strings, length of the longest string stored inline and length of
+ * the longest string for test_vlstrings_inline() */
+#define INLINE_NSTRINGS    20
+#define INLINE_SIZE        32
+#define INLINE_LONG_STRLEN 100
+
 /* String for testing attributes */
 static const char *string_att       = "This is the string for the attribute";
 static char *      string_att_write = NULL;
@@ -384,6 +394,346 @@ test_vlstrings_special(void)
     CHECK(ret, FAIL, "H5Fclose");
 }
 
+/****************************************************************
+**
+**  test_vlstrings_batch(): Test writing enough VL strings at once
+**      for them to be stored in the global heap in batches,
+**      including empty, NULL and very long strings, and then
+**      overwriting them.
+**
+****************************************************************/
+static void
+test_vlstrings_batch(void)
+{
+    hid_t    fid;        /* HDF5 File IDs */
+    hid_t    dataset;    /* Dataset ID */
+    hid_t    sid;        /* Dataspace ID */
+    hid_t    tid;        /* Datatype ID */
+    hsize_t  dims[] = {BATCH_NSTRINGS};
+    char **  wdata;      /* Strings written */
+    char **  rdata;      /* Strings read */
+    char *   chars;      /* Storage for the strings written */
+    unsigned pass;       /* Which set of strings is written */
+    unsigned i;          /* Local index variable */
+    herr_t   ret;        /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing Batched VL String Writes\n"));
+
+    wdata = (char **)HDmalloc(BATCH_NSTRINGS * sizeof(char *));
+    CHECK_PTR(wdata, "HDmalloc");
+    rdata = (char **)HDmalloc(BATCH_NSTRINGS * sizeof(char *));
+    CHECK_PTR(rdata, "HDmalloc");
+    chars = (char *)HDmalloc(BATCH_NSTRINGS * 64 + BATCH_LONG_STRLEN + 1);
+    CHECK_PTR(chars, "HDmalloc");
+
+    /* Create file, VL string datatype and dataset */
+    fid = H5Fcreate(DATAFILE, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid, FAIL, "H5Fcreate");
+
+    tid = H5Tcopy(H5T_C_S1);
+    CHECK(tid, FAIL, "H5Tcopy");
+    ret = H5Tset_size(tid, H5T_VARIABLE);
+    CHECK(ret, FAIL, "H5Tset_size");
+
+    sid = H5Screate_simple(1, dims, NULL);
+    CHECK(sid, FAIL, "H5Screate_simple");
+
+    dataset = H5Dcreate2(fid, "Batch", tid, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dcreate2");
+
+    for (pass = 0; pass < 2; pass++) {
+        char *p = chars;
+
+        /* Build the strings, with a very long one in the middle */
+        for (i = 0; i < BATCH_NSTRINGS; i++) {
+            if ((i % 101) == (pass + 3))
+                wdata[i] = NULL;
+            else if (i == BATCH_NSTRINGS / 2) {
+                HDmemset(p, 'a' + (int)pass, BATCH_LONG_STRLEN);
+                p[BATCH_LONG_STRLEN] = '\0';
+                wdata[i]             = p;
+                p += BATCH_LONG_STRLEN + 1;
+            }
+            else {
+                HDsnprintf(p, 64, "%.*s%u", (int)((i + pass) % 37), "abcdefghijklmnopqrstuvwxyz0123456789",
+                           i);
+                wdata[i] = p;
+                p += HDstrlen(p) + 1;
+            }
+        } /* end for */
+
+        ret = H5Dwrite(dataset, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata);
+        CHECK(ret, FAIL, "H5Dwrite");
+
+        /* Read the strings back and check them */
+        ret = H5Dread(dataset, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata);
+        CHECK(ret, FAIL, "H5Dread");
+
+        for (i = 0; i < BATCH_NSTRINGS; i++) {
+            if (wdata[i] == NULL || rdata[i] == NULL) {
+                if (wdata[i] != rdata[i])
+                    TestErrPrintf("VL string %u NULL mismatch, pass %u\n", i, pass);
+            }
+            else if (HDstrcmp(wdata[i], rdata[i]) != 0)
+                TestErrPrintf("VL string %u doesn't match, pass %u, wdata=%.20s, rdata=%.20s\n", i, pass,
+                              wdata[i], rdata[i]);
+        } /* end for */
+
+        ret = H5Treclaim(tid, sid, H5P_DEFAULT, rdata);
+        CHECK(ret, FAIL, "H5Treclaim");
+    } /* end for */
+
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    /* Re-open the file and check the last strings written made it to disk */
+    fid = H5Fopen(DATAFILE, H5F_ACC_RDONLY, H5P_DEFAULT);
+    CHECK(fid, FAIL, "H5Fopen");
+
+    dataset = H5Dopen2(fid, "Batch", H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dopen2");
+
+    ret = H5Dread(dataset, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+
+    for (i = 0; i < BATCH_NSTRINGS; i++) {
+        if (wdata[i] == NULL || rdata[i] == NULL) {
+            if (wdata[i] != rdata[i])
+                TestErrPrintf("VL string %u NULL mismatch after reopen\n", i);
+        }
+        else if (HDstrcmp(wdata[i], rdata[i]) != 0)
+            TestErrPrintf("VL string %u doesn't match after reopen\n", i);
+    } /* end for */
+
+    ret = H5Treclaim(tid, sid, H5P_DEFAULT, rdata);
+    CHECK(ret, FAIL, "H5Treclaim");
+
+    /* Close everything */
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Sclose(sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Tclose(tid);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    HDfree(wdata);
+    HDfree(rdata);
+    HDfree(chars);
+} /* end test_vlstrings_batch() */
+
+/****************************************************************
+**
+**  test_vlstrings_inline(): Test storing short VL strings inline
+**      in the dataset and attribute elements, with longer ones
+**      spilling to the global heap.
+**
+****************************************************************/
+static void
+test_vlstrings_inline(void)
+{
+    hid_t       fid;       /* HDF5 File IDs */
+    hid_t       fapl;      /* File access property list */
+    hid_t       dataset;   /* Dataset ID */
+    hid_t       attr;      /* Attribute ID */
+    hid_t       sid;       /* Dataspace ID */
+    hid_t       tid;       /* Datatype ID */
+    hid_t       tid2;      /* Datatype ID */
+    hsize_t     dims[] = {INLINE_NSTRINGS};
+    const char *wdata[INLINE_NSTRINGS];
+    char *      rdata[INLINE_NSTRINGS];
+    char        long_str[INLINE_LONG_STRLEN + 1];
+    size_t      inline_size; /* Longest string stored inline */
+    unsigned    pass;        /* Which set of strings is written */
+    unsigned    i;           /* Local index variable */
+    herr_t      ret;         /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing Inline VL Strings\n"));
+
+    HDmemset(long_str, 'x', INLINE_LONG_STRLEN);
+    long_str[INLINE_LONG_STRLEN] = '\0';
+
+    /* Create VL string datatype with short strings stored inline */
+    tid = H5Tcopy(H5T_C_S1);
+    CHECK(tid, FAIL, "H5Tcopy");
+    ret = H5Tset_size(tid, H5T_VARIABLE);
+    CHECK(ret, FAIL, "H5Tset_size");
+
+    ret = H5Tget_str_inline(tid, &inline_size);
+    CHECK(ret, FAIL, "H5Tget_str_inline");
+    VERIFY(inline_size, 0, "H5Tget_str_inline");
+
+    ret = H5Tset_str_inline(tid, INLINE_SIZE);
+    CHECK(ret, FAIL, "H5Tset_str_inline");
+    ret = H5Tget_str_inline(tid, &inline_size);
+    CHECK(ret, FAIL, "H5Tget_str_inline");
+    VERIFY(inline_size, INLINE_SIZE, "H5Tget_str_inline");
+
+    /* Inline storage is only for VL strings */
+    tid2 = H5Tcopy(H5T_C_S1);
+    CHECK(tid2, FAIL, "H5Tcopy");
+    H5E_BEGIN_TRY
+    {
+        ret = H5Tset_str_inline(tid2, INLINE_SIZE);
+    }
+    H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5Tset_str_inline");
+    ret = H5Tclose(tid2);
+    CHECK(ret, FAIL, "H5Tclose");
+
+    sid = H5Screate_simple(1, dims, NULL);
+    CHECK(sid, FAIL, "H5Screate_simple");
+
+    /* Inline strings can't be written to files limited to an older format */
+    fapl = H5Pcreate(H5P_FILE_ACCESS);
+    CHECK(fapl, FAIL, "H5Pcreate");
+    ret = H5Pset_libver_bounds(fapl, H5F_LIBVER_EARLIEST, H5F_LIBVER_V112);
+    CHECK(ret, FAIL, "H5Pset_libver_bounds");
+
+    fid = H5Fcreate(DATAFILE, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    CHECK(fid, FAIL, "H5Fcreate");
+    H5E_BEGIN_TRY
+    {
+        dataset = H5Dcreate2(fid, "Inline", tid, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    }
+    H5E_END_TRY;
+    VERIFY(dataset, FAIL, "H5Dcreate2");
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+    ret = H5Pclose(fapl);
+    CHECK(ret, FAIL, "H5Pclose");
+
+    /* Create file and dataset */
+    fid = H5Fcreate(DATAFILE, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid, FAIL, "H5Fcreate");
+
+    dataset = H5Dcreate2(fid, "Inline", tid, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dcreate2");
+
+    /* Elements hold the length and the longest inline string */
+    VERIFY(H5Dget_storage_size(dataset), 0, "H5Dget_storage_size");
+
+    for (pass = 0; pass < 2; pass++) {
+        /* Mix NULL, empty, inline and spilled strings, moving them around each pass */
+        for (i = 0; i < INLINE_NSTRINGS; i++)
+            switch ((i + pass) % 5) {
+                case 0:
+                    wdata[i] = NULL;
+                    break;
+                case 1:
+                    wdata[i] = "";
+                    break;
+                case 2:
+                    wdata[i] = "short";
+                    break;
+                case 3:
+                    wdata[i] = long_str + INLINE_LONG_STRLEN - INLINE_SIZE;
+                    break;
+                default:
+                    wdata[i] = long_str + pass;
+                    break;
+            } /* end switch */
+
+        ret = H5Dwrite(dataset, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata);
+        CHECK(ret, FAIL, "H5Dwrite");
+
+        VERIFY(H5Dget_storage_size(dataset), INLINE_NSTRINGS * (4 + INLINE_SIZE), "H5Dget_storage_size");
+
+        ret = H5Dread(dataset, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata);
+        CHECK(ret, FAIL, "H5Dread");
+
+        for (i = 0; i < INLINE_NSTRINGS; i++) {
+            if (wdata[i] == NULL || rdata[i] == NULL) {
+                if (wdata[i] != rdata[i])
+                    TestErrPrintf("VL string %u NULL mismatch, pass %u\n", i, pass);
+            }
+            else if (HDstrcmp(wdata[i], rdata[i]) != 0)
+                TestErrPrintf("VL string %u doesn't match, pass %u, wdata=%.20s, rdata=%.20s\n", i, pass,
+                              wdata[i], rdata[i]);
+        } /* end for */
+
+        ret = H5Treclaim(tid, sid, H5P_DEFAULT, rdata);
+        CHECK(ret, FAIL, "H5Treclaim");
+    } /* end for */
+
+    /* Write the same strings to an attribute */
+    attr = H5Acreate2(dataset, "Inline", tid, sid, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(attr, FAIL, "H5Acreate2");
+    ret = H5Awrite(attr, tid, wdata);
+    CHECK(ret, FAIL, "H5Awrite");
+    ret = H5Aclose(attr);
+    CHECK(ret, FAIL, "H5Aclose");
+
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    /* Re-open the file and check the strings and the datatype */
+    fid = H5Fopen(DATAFILE, H5F_ACC_RDONLY, H5P_DEFAULT);
+    CHECK(fid, FAIL, "H5Fopen");
+
+    dataset = H5Dopen2(fid, "Inline", H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dopen2");
+
+    tid2 = H5Dget_type(dataset);
+    CHECK(tid2, FAIL, "H5Dget_type");
+    ret = H5Tget_str_inline(tid2, &inline_size);
+    CHECK(ret, FAIL, "H5Tget_str_inline");
+    VERIFY(inline_size, INLINE_SIZE, "H5Tget_str_inline");
+    ret = H5Tclose(tid2);
+    CHECK(ret, FAIL, "H5Tclose");
+
+    ret = H5Dread(dataset, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+
+    for (i = 0; i < INLINE_NSTRINGS; i++) {
+        if (wdata[i] == NULL || rdata[i] == NULL) {
+            if (wdata[i] != rdata[i])
+                TestErrPrintf("VL string %u NULL mismatch after reopen\n", i);
+        }
+        else if (HDstrcmp(wdata[i], rdata[i]) != 0)
+            TestErrPrintf("VL string %u doesn't match after reopen\n", i);
+    } /* end for */
+
+    ret = H5Treclaim(tid, sid, H5P_DEFAULT, rdata);
+    CHECK(ret, FAIL, "H5Treclaim");
+
+    attr = H5Aopen(dataset, "Inline", H5P_DEFAULT);
+    CHECK(attr, FAIL, "H5Aopen");
+    ret = H5Aread(attr, tid, rdata);
+    CHECK(ret, FAIL, "H5Aread");
+
+    for (i = 0; i < INLINE_NSTRINGS; i++) {
+        if (wdata[i] == NULL || rdata[i] == NULL) {
+            if (wdata[i] != rdata[i])
+                TestErrPrintf("VL string attribute %u NULL mismatch\n", i);
+        }
+        else if (HDstrcmp(wdata[i], rdata[i]) != 0)
+            TestErrPrintf("VL string attribute %u doesn't match\n", i);
+    } /* end for */
+
+    ret = H5Treclaim(tid, sid, H5P_DEFAULT, rdata);
+    CHECK(ret, FAIL, "H5Treclaim");
+    ret = H5Aclose(attr);
+    CHECK(ret, FAIL, "H5Aclose");
+
+    /* Close everything */
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Sclose(sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Tclose(tid);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+} /* end test_vlstrings_inline() */
+
 /****************************************************************
 **
 **  test_vlstring_type(): Test VL string type.
@@ -977,6 +1327,8 @@ test_vlstrings(void)
     /* Test basic VL string datatype */
     test_vlstrings_basic();
     test_vlstrings_special();
+    test_vlstrings_batch();
+    test_vlstrings_inline();
     test_vlstring_type();
     test_compact_vlstring();
 
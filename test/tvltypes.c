@@ -41,6 +41,10 @@
 #define SPACE4_DIM_SMALL 128
 #define SPACE4_DIM_LARGE (H5D_TEMP_BUF_SIZE / 64)
 
+/* 1-D dataspace used for reclaiming nested VL data */
+#define SPACE5_RANK 1
+#define SPACE5_DIM1 20000
+
 void *test_vltypes_alloc_custom(size_t size, void *info);
 void  test_vltypes_free_custom(void *mem, void *info);
 
@@ -3195,6 +3199,184 @@ test_vltypes_fill_value(void)
     HDfree(rbuf);
 } /* end test_vltypes_fill_value() */
 
+/****************************************************************
+**
+**  test_vltypes_reclaim_create(): Fill a buffer of VL sequences
+**      of compound elements with VL data, as used by
+**      test_vltypes_reclaim().  The memory for the odd elements is
+**      counted in ODD_USED and the rest in EVEN_USED, unless they
+**      are NULL.
+**
+****************************************************************/
+static void
+test_vltypes_reclaim_create(hvl_t *buf, size_t *even_used, size_t *odd_used)
+{
+    typedef struct { /* Struct that the compound type is composed of */
+        int   i;
+        hvl_t v;
+        char *s;
+        hvl_t a[2];
+    } s1;
+    s1 *     t1;       /* Temporary pointer to compound elements */
+    unsigned i, j, k;  /* counting variables */
+    size_t * mem_used; /* Memory counter for an element */
+
+    for (i = 0; i < SPACE5_DIM1; i++) {
+        mem_used = (i % 2) ? odd_used : even_used;
+
+#define RECLAIM_ALLOC(size) (mem_used ? test_vltypes_alloc_custom((size), mem_used) : HDmalloc(size))
+        buf[i].len = i % 4;
+        buf[i].p   = buf[i].len ? RECLAIM_ALLOC(buf[i].len * sizeof(s1)) : NULL;
+        for (t1 = (s1 *)buf[i].p, j = 0; j < buf[i].len; j++, t1++) {
+            t1->i     = (int)(i * 10 + j);
+            t1->v.len = j + 1;
+            t1->v.p   = RECLAIM_ALLOC(t1->v.len * sizeof(int));
+            for (k = 0; k < t1->v.len; k++)
+                ((int *)t1->v.p)[k] = (int)(i + j + k);
+            t1->s = (char *)RECLAIM_ALLOC(8);
+            HDsnprintf(t1->s, 8, "s%u", i % 1000);
+            for (k = 0; k < 2; k++) {
+                t1->a[k].len = k;
+                t1->a[k].p   = k ? RECLAIM_ALLOC(sizeof(int)) : NULL;
+                if (k)
+                    *(int *)t1->a[k].p = (int)i;
+            } /* end for */
+        }     /* end for */
+#undef RECLAIM_ALLOC
+    } /* end for */
+} /* end test_vltypes_reclaim_create() */
+
+/****************************************************************
+**
+**  test_vltypes_reclaim(): Test reclaiming VL sequences of
+**      compound elements with VL sequence, VL string and array of
+**      VL sequence fields, for part of a selection at a time, with
+**      a custom memory manager and with the default one and more
+**      than one datatype conversion thread.
+**
+****************************************************************/
+static void
+test_vltypes_reclaim(void)
+{
+    typedef struct { /* Struct that the compound type is composed of */
+        int   i;
+        hvl_t v;
+        char *s;
+        hvl_t a[2];
+    } s1;
+    hvl_t * buf;                          /* Buffer of VL data */
+    hid_t   sid1;                         /* Dataspace ID */
+    hid_t   tid1, tid2, tid3, tid4, tid5; /* Datatype IDs */
+    hid_t   xfer_pid;                     /* Dataset transfer property list ID */
+    hsize_t dims1[] = {SPACE5_DIM1};
+    hsize_t dims2[] = {2};
+    hsize_t start[] = {0}, stride[] = {2}, count[] = {SPACE5_DIM1 / 2};
+    size_t  even_used = 0, odd_used = 0; /* Memory used for even and odd elements */
+    s1 *    t1;                          /* Temporary pointer to compound elements */
+    unsigned i, j;                       /* counting variables */
+    herr_t   ret;                        /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing Reclaiming Nested VL Data\n"));
+
+    buf = (hvl_t *)HDmalloc(sizeof(hvl_t) * SPACE5_DIM1);
+    CHECK_PTR(buf, "HDmalloc");
+
+    /* Create the datatype */
+    tid1 = H5Tvlen_create(H5T_NATIVE_INT);
+    CHECK(tid1, FAIL, "H5Tvlen_create");
+    tid2 = H5Tcopy(H5T_C_S1);
+    CHECK(tid2, FAIL, "H5Tcopy");
+    ret = H5Tset_size(tid2, H5T_VARIABLE);
+    CHECK(ret, FAIL, "H5Tset_size");
+    tid3 = H5Tarray_create2(tid1, 1, dims2);
+    CHECK(tid3, FAIL, "H5Tarray_create2");
+    tid4 = H5Tcreate(H5T_COMPOUND, sizeof(s1));
+    CHECK(tid4, FAIL, "H5Tcreate");
+    ret = H5Tinsert(tid4, "i", HOFFSET(s1, i), H5T_NATIVE_INT);
+    CHECK(ret, FAIL, "H5Tinsert");
+    ret = H5Tinsert(tid4, "v", HOFFSET(s1, v), tid1);
+    CHECK(ret, FAIL, "H5Tinsert");
+    ret = H5Tinsert(tid4, "s", HOFFSET(s1, s), tid2);
+    CHECK(ret, FAIL, "H5Tinsert");
+    ret = H5Tinsert(tid4, "a", HOFFSET(s1, a), tid3);
+    CHECK(ret, FAIL, "H5Tinsert");
+    tid5 = H5Tvlen_create(tid4);
+    CHECK(tid5, FAIL, "H5Tvlen_create");
+
+    sid1 = H5Screate_simple(SPACE5_RANK, dims1, NULL);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+
+    xfer_pid = H5Pcreate(H5P_DATASET_XFER);
+    CHECK(xfer_pid, FAIL, "H5Pcreate");
+    ret = H5Pset_vlen_mem_manager(xfer_pid, test_vltypes_alloc_custom, &even_used, test_vltypes_free_custom,
+                                  &even_used);
+    CHECK(ret, FAIL, "H5Pset_vlen_mem_manager");
+
+    /* Reclaim the even elements with the custom memory manager */
+    test_vltypes_reclaim_create(buf, &even_used, &odd_used);
+    ret = H5Sselect_hyperslab(sid1, H5S_SELECT_SET, start, stride, count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    ret = H5Treclaim(tid5, sid1, xfer_pid, buf);
+    CHECK(ret, FAIL, "H5Treclaim");
+    VERIFY(even_used, 0, "H5Treclaim");
+
+    /* The odd elements must be untouched */
+    for (i = 1; i < SPACE5_DIM1; i += 2) {
+        if (buf[i].len != i % 4)
+            TestErrPrintf("%d: VL data length don't match!, buf[%u].len=%u\n", __LINE__, i,
+                          (unsigned)buf[i].len);
+        for (t1 = (s1 *)buf[i].p, j = 0; j < buf[i].len; j++, t1++)
+            if (t1->i != (int)(i * 10 + j) || t1->v.len != j + 1 || ((int *)t1->v.p)[j] != (int)(i + 2 * j) ||
+                t1->a[1].len != 1 || *(int *)t1->a[1].p != (int)i)
+                TestErrPrintf("%d: VL data values don't match!, element %u, %u\n", __LINE__, i, j);
+    } /* end for */
+
+    /* Reclaim the odd elements with the custom memory manager and more
+     * than one conversion thread (which reclaims on the calling thread)
+     */
+    ret = H5Pset_vlen_mem_manager(xfer_pid, test_vltypes_alloc_custom, &odd_used, test_vltypes_free_custom,
+                                  &odd_used);
+    CHECK(ret, FAIL, "H5Pset_vlen_mem_manager");
+    ret = H5Pset_conv_threads(xfer_pid, 4);
+    CHECK(ret, FAIL, "H5Pset_conv_threads");
+    start[0] = 1;
+    ret      = H5Sselect_hyperslab(sid1, H5S_SELECT_SET, start, stride, count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    ret = H5Treclaim(tid5, sid1, xfer_pid, buf);
+    CHECK(ret, FAIL, "H5Treclaim");
+    VERIFY(odd_used, 0, "H5Treclaim");
+
+    /* Reclaim everything with the default memory manager and more than one
+     * conversion thread
+     */
+    ret = H5Pset_vlen_mem_manager(xfer_pid, NULL, NULL, NULL, NULL);
+    CHECK(ret, FAIL, "H5Pset_vlen_mem_manager");
+    test_vltypes_reclaim_create(buf, NULL, NULL);
+    ret = H5Sselect_all(sid1);
+    CHECK(ret, FAIL, "H5Sselect_all");
+    ret = H5Treclaim(tid5, sid1, xfer_pid, buf);
+    CHECK(ret, FAIL, "H5Treclaim");
+
+    /* Close everything */
+    ret = H5Pclose(xfer_pid);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Tclose(tid5);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(tid4);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(tid3);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(tid2);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(tid1);
+    CHECK(ret, FAIL, "H5Tclose");
+
+    HDfree(buf);
+} /* end test_vltypes_reclaim() */
+
 /****************************************************************
 **
 **  test_vltypes(): Main VL datatype testing routine.
@@ -3222,6 +3404,7 @@ test_vltypes(void)
     test_vltypes_compound_vlen_vlen();          /* Test compound datatypes with VL atomic components */
     test_vltypes_compound_vlstr();              /* Test data rewritten of nested VL data */
     test_vltypes_fill_value();                  /* Test fill value for VL data */
+    test_vltypes_reclaim();                     /* Test reclaiming nested VL data */
 } /* test_vltypes() */
 
 /*-------------------------------------------------------------------------
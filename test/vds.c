@@ -606,8 +606,9 @@ test_api(test_api_config_t config, hid_t fapl, H5F_libver_t low)
 
     /* Get examination DCPL */
     if (test_api_get_ex_dcpl(config, fapl, dcpl, &ex_dcpl, vspace[0], filename,
-                             (low >= H5F_LIBVER_V112) ? (hsize_t)99 : (low >= H5F_LIBVER_V110 ? 174 : 213)) <
-        0)
+                             (low >= H5F_LIBVER_V114)
+                                 ? (hsize_t)94
+                                 : (low >= H5F_LIBVER_V112 ? 99 : (low >= H5F_LIBVER_V110 ? 174 : 213))) < 0)
         TEST_ERROR
 
     /* Test H5Pget_virtual_count */
@@ -1791,6 +1791,121 @@ error:
     return FAIL;
 } /* end test_multi_compat() */
 
+/*-------------------------------------------------------------------------
+ * Function:    test_split_metadata_flush
+ *
+ * Purpose:     Flush many small metadata cache entries to a file whose
+ *              driver doesn't accumulate metadata, so that they're written
+ *              in batches, and verify that the file reads back correctly.
+ *
+ * Return:      Success:    0
+ *              Failure:    -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_split_metadata_flush(void)
+{
+    hid_t file = H5I_INVALID_HID, fapl = H5I_INVALID_HID;
+    hid_t group = H5I_INVALID_HID, attr = H5I_INVALID_HID, space = H5I_INVALID_HID;
+    char  filename[1024];
+    char  name[32];
+    int   i, val;
+
+    TESTING("metadata flush with SPLIT file driver");
+
+    if ((fapl = h5_fileaccess()) < 0)
+        TEST_ERROR;
+    if (H5Pset_fapl_split(fapl, "-m.h5", H5P_DEFAULT, "-r.h5", H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    if (H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0)
+        TEST_ERROR;
+    h5_fixname(FILENAME[4], fapl, filename, sizeof(filename));
+
+    if ((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        TEST_ERROR;
+    if ((space = H5Screate(H5S_SCALAR)) < 0)
+        TEST_ERROR;
+
+    /* Create groups with an attribute each, flushing part way through */
+    for (i = 0; i < 2000; i++) {
+        HDsnprintf(name, sizeof(name), "group %d", i);
+        if ((group = H5Gcreate2(file, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+            TEST_ERROR;
+        if ((attr = H5Acreate2(group, "attr", H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+            TEST_ERROR;
+        if (H5Awrite(attr, H5T_NATIVE_INT, &i) < 0)
+            TEST_ERROR;
+        if (H5Aclose(attr) < 0)
+            TEST_ERROR;
+        if (H5Gclose(group) < 0)
+            TEST_ERROR;
+        if (i == 1000 && H5Fflush(file, H5F_SCOPE_GLOBAL) < 0)
+            TEST_ERROR;
+    } /* end for */
+    if (H5Fflush(file, H5F_SCOPE_GLOBAL) < 0)
+        TEST_ERROR;
+
+    /* Dirty every other attribute again */
+    for (i = 0; i < 2000; i += 2) {
+        HDsnprintf(name, sizeof(name), "group %d", i);
+        val = -i;
+        if ((group = H5Gopen2(file, name, H5P_DEFAULT)) < 0)
+            TEST_ERROR;
+        if ((attr = H5Aopen(group, "attr", H5P_DEFAULT)) < 0)
+            TEST_ERROR;
+        if (H5Awrite(attr, H5T_NATIVE_INT, &val) < 0)
+            TEST_ERROR;
+        if (H5Aclose(attr) < 0)
+            TEST_ERROR;
+        if (H5Gclose(group) < 0)
+            TEST_ERROR;
+    } /* end for */
+
+    if (H5Sclose(space) < 0)
+        TEST_ERROR;
+    if (H5Fclose(file) < 0)
+        TEST_ERROR;
+
+    /* Check the file */
+    if ((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR;
+    for (i = 0; i < 2000; i++) {
+        HDsnprintf(name, sizeof(name), "group %d", i);
+        if ((attr = H5Aopen_by_name(file, name, "attr", H5P_DEFAULT, H5P_DEFAULT)) < 0)
+            TEST_ERROR;
+        if (H5Aread(attr, H5T_NATIVE_INT, &val) < 0)
+            TEST_ERROR;
+        if (H5Aclose(attr) < 0)
+            TEST_ERROR;
+        if (val != ((i % 2) ? i : -i))
+            TEST_ERROR;
+    } /* end for */
+    if (H5Fclose(file) < 0)
+        TEST_ERROR;
+
+    h5_delete_test_file(FILENAME[4], fapl);
+    if (H5Pclose(fapl) < 0)
+        TEST_ERROR;
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Aclose(attr);
+        H5Gclose(group);
+        H5Sclose(space);
+        H5Fclose(file);
+        H5Pclose(fapl);
+    }
+    H5E_END_TRY;
+
+    return -1;
+} /* end test_split_metadata_flush() */
+
 /*-------------------------------------------------------------------------
  * Function:    test_log
  *
@@ -3330,6 +3445,7 @@ main(void)
     nerrors += test_family_member_fapl() < 0 ? 1 : 0;
     nerrors += test_multi() < 0 ? 1 : 0;
     nerrors += test_multi_compat() < 0 ? 1 : 0;
+    nerrors += test_split_metadata_flush() < 0 ? 1 : 0;
     nerrors += test_log() < 0 ? 1 : 0;
     nerrors += test_stdio() < 0 ? 1 : 0;
     nerrors += test_windows() < 0 ? 1 : 0;
@@ -0,0 +1,769 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Decode a binary metadata cache log, written when logging is
+ *          enabled with H5Pset_mdc_log_options() and the format is set
+ *          to H5F_MDC_LOG_FORMAT_BINARY with H5Pset_mdc_log_format().
+ *
+ *          The records can be printed as JSON or CSV, and summarized:
+ *          hit rate by entry type, eviction churn (evicted entries that
+ *          are loaded again) and bursts of entry flushes.
+ */
+#include "H5private.h"
+#include "H5Clog.h"
+#include "h5tools.h"
+#include "h5tools_utils.h"
+
+/* Name of tool */
+#define PROGRAMNAME "h5mdclog"
+
+/* Number of records read at a time */
+#define RECORDS_PER_READ 4096
+
+/* Default largest gap between flushes in the same burst, in microseconds */
+#define DEFAULT_BURST_GAP 1000
+
+/* Number of entry type IDs a log can use */
+#define NUM_TYPE_IDS H5C_LOG_BINARY_NO_TYPE
+
+/* Output formats for records */
+typedef enum { FORMAT_NONE, FORMAT_JSON, FORMAT_CSV } record_format_t;
+
+/* A decoded record */
+typedef struct record_t {
+    uint64_t time;    /* Microseconds since logging was set up */
+    haddr_t  addr;    /* Entry address */
+    uint64_t aux;     /* Auxiliary value */
+    uint32_t size;    /* Entry size */
+    unsigned op;      /* Operation */
+    unsigned type_id; /* Entry type ID */
+    unsigned status;  /* Status flags */
+} record_t;
+
+/* Statistics for one entry type */
+typedef struct type_stats_t {
+    uint64_t protects;    /* # of successful protects */
+    uint64_t hits;        /* # of protects that found the entry in the cache */
+    uint64_t inserts;     /* # of inserts */
+    uint64_t flushes;     /* # of entries written */
+    uint64_t flush_bytes; /* # of bytes written */
+    uint64_t evictions;   /* # of entries evicted */
+    uint64_t reloads;     /* # of evicted entries loaded again */
+} type_stats_t;
+
+/* Set of addresses of evicted entries, with open addressing */
+typedef struct addr_set_t {
+    haddr_t *addrs; /* Slots, HADDR_UNDEF for empty ones */
+    size_t   nslots;
+    size_t   nused;
+} addr_set_t;
+
+/* Statistics for the whole log */
+typedef struct log_stats_t {
+    uint64_t     nrecords;                    /* # of records */
+    uint64_t     duration;                    /* Time of the last record */
+    uint64_t     nfailed;                     /* # of failed operations */
+    type_stats_t types[NUM_TYPE_IDS];         /* Statistics by entry type */
+    addr_set_t   evicted;                     /* Entries evicted and not loaded again */
+    uint64_t     reload_bytes;                /* # of bytes of evicted entries loaded again */
+    uint64_t     nbursts;                     /* # of bursts of 2 or more flushes */
+    uint64_t     burst_flushes;               /* # of flushes in bursts */
+    uint64_t     max_burst_flushes;           /* Largest burst, in flushes */
+    uint64_t     max_burst_bytes;             /* Largest burst, in bytes */
+    uint64_t     max_burst_duration;          /* Longest burst, in microseconds */
+    uint64_t     curr_burst_flushes;          /* Current run of flushes */
+    uint64_t     curr_burst_bytes;            /* Bytes written by the current run */
+    uint64_t     curr_burst_start;            /* Time of the first flush of the current run */
+    uint64_t     last_flush;                  /* Time of the last flush */
+} log_stats_t;
+
+static char *          fname_g      = NULL;
+static record_format_t format_g     = FORMAT_NONE;
+static hbool_t         summary_g    = FALSE;
+static uint64_t        burst_gap_g  = DEFAULT_BURST_GAP;
+static char *          type_names_g[NUM_TYPE_IDS];
+
+/* Names of the operations, indexed by H5C_log_binary_op_t */
+static const char *op_names_g[] = {"start",
+                                   "stop",
+                                   "create cache",
+                                   "destroy cache",
+                                   "evict cache",
+                                   "flush cache",
+                                   "set config",
+                                   "insert",
+                                   "protect",
+                                   "unprotect",
+                                   "load",
+                                   "flush",
+                                   "evict",
+                                   "expunge",
+                                   "remove",
+                                   "move",
+                                   "resize",
+                                   "pin",
+                                   "unpin",
+                                   "mark dirty",
+                                   "mark clean",
+                                   "mark unserialized",
+                                   "mark serialized",
+                                   "create flush dependency",
+                                   "destroy flush dependency"};
+
+/*
+ * Command-line options: only publicize long options
+ */
+static const char *        s_opts   = "hVf:sg:";
+static struct long_options l_opts[] = {{"help", no_arg, 'h'},
+                                       {"hel", no_arg, 'h'},
+                                       {"he", no_arg, 'h'},
+                                       {"version", no_arg, 'V'},
+                                       {"versio", no_arg, 'V'},
+                                       {"versi", no_arg, 'V'},
+                                       {"vers", no_arg, 'V'},
+                                       {"format", require_arg, 'f'},
+                                       {"forma", require_arg, 'f'},
+                                       {"form", require_arg, 'f'},
+                                       {"for", require_arg, 'f'},
+                                       {"fo", require_arg, 'f'},
+                                       {"summary", no_arg, 's'},
+                                       {"summar", no_arg, 's'},
+                                       {"summa", no_arg, 's'},
+                                       {"summ", no_arg, 's'},
+                                       {"sum", no_arg, 's'},
+                                       {"su", no_arg, 's'},
+                                       {"burst-gap", require_arg, 'g'},
+                                       {"burst-ga", require_arg, 'g'},
+                                       {"burst-g", require_arg, 'g'},
+                                       {"burst", require_arg, 'g'},
+                                       {"burs", require_arg, 'g'},
+                                       {"bur", require_arg, 'g'},
+                                       {"bu", require_arg, 'g'},
+                                       {NULL, 0, '\0'}};
+
+/*-------------------------------------------------------------------------
+ * Function:    usage
+ *
+ * Purpose:     Prints a usage message
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+usage(const char *prog)
+{
+    HDfprintf(stdout, "usage: %s [OPTIONS] log_file\n", prog);
+    HDfprintf(stdout, "  OPTIONS\n");
+    HDfprintf(stdout, "   -h, --help                Print a usage message and exit\n");
+    HDfprintf(stdout, "   -V, --version             Print version number and exit\n");
+    HDfprintf(stdout, "   -f F, --format=F          Print the records as F, which is json or csv\n");
+    HDfprintf(stdout, "   -s, --summary             Print summary statistics: hit rate by entry type,\n");
+    HDfprintf(stdout, "                             eviction churn and flush bursts.  This is the\n");
+    HDfprintf(stdout, "                             default without --format.  With --format, the\n");
+    HDfprintf(stdout, "                             summary is printed to stderr.\n");
+    HDfprintf(stdout, "   -g U, --burst-gap=U       Count flushes at most U microseconds apart as one\n");
+    HDfprintf(stdout, "                             burst (default %d)\n", DEFAULT_BURST_GAP);
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "Examples of use:\n");
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "h5mdclog mdc.log\n");
+    HDfprintf(stdout, "  Summarize the binary metadata cache log <mdc.log>.\n");
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "h5mdclog --format=csv mdc.log > mdc.csv\n");
+    HDfprintf(stdout, "  Convert the records of <mdc.log> to CSV.\n");
+} /* usage() */
+
+/*-------------------------------------------------------------------------
+ * Function: parse_command_line
+ *
+ * Purpose: Parses command line and sets up global variable to control output
+ *
+ * Return:  Success: 0
+ *
+ *          Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+parse_command_line(int argc, const char **argv)
+{
+    int opt;
+
+    /* no arguments */
+    if (argc == 1) {
+        usage(h5tools_getprogname());
+        h5tools_setstatus(EXIT_FAILURE);
+        goto error;
+    }
+
+    /* parse command line options */
+    while ((opt = get_option(argc, argv, s_opts, l_opts)) != EOF) {
+        switch ((char)opt) {
+            case 'h':
+                usage(h5tools_getprogname());
+                h5tools_setstatus(EXIT_SUCCESS);
+                goto done;
+
+            case 'V':
+                print_version(h5tools_getprogname());
+                h5tools_setstatus(EXIT_SUCCESS);
+                goto done;
+
+            case 'f':
+                if (!HDstrcmp(opt_arg, "json"))
+                    format_g = FORMAT_JSON;
+                else if (!HDstrcmp(opt_arg, "csv"))
+                    format_g = FORMAT_CSV;
+                else {
+                    error_msg("unknown format \"%s\"\n", opt_arg);
+                    usage(h5tools_getprogname());
+                    h5tools_setstatus(EXIT_FAILURE);
+                    goto error;
+                }
+                break;
+
+            case 's':
+                summary_g = TRUE;
+                break;
+
+            case 'g':
+                if (HDatoi(opt_arg) < 0) {
+                    usage(h5tools_getprogname());
+                    h5tools_setstatus(EXIT_FAILURE);
+                    goto error;
+                }
+                burst_gap_g = (uint64_t)HDatoi(opt_arg);
+                break;
+
+            default:
+                usage(h5tools_getprogname());
+                h5tools_setstatus(EXIT_FAILURE);
+                goto error;
+        } /* end switch */
+    }     /* end while */
+
+    /* check for file name to be processed */
+    if (argc <= opt_ind) {
+        error_msg("missing file name\n");
+        usage(h5tools_getprogname());
+        h5tools_setstatus(EXIT_FAILURE);
+        goto error;
+    } /* end if */
+
+    fname_g = HDstrdup(argv[opt_ind]);
+
+    /* Summarize when there's nothing else to do */
+    if (FORMAT_NONE == format_g)
+        summary_g = TRUE;
+
+done:
+    return (0);
+
+error:
+    return -1;
+}
+
+/*-------------------------------------------------------------------------
+ * Function:    leave
+ *
+ * Purpose:     Close the tools library and exit
+ *
+ * Return:      Does not return
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+leave(int ret)
+{
+    h5tools_close();
+    HDexit(ret);
+} /* leave() */
+
+/*-------------------------------------------------------------------------
+ * Function:    addr_set_insert
+ *
+ * Purpose:     Add an address to a set
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+addr_set_insert(addr_set_t *set, haddr_t addr)
+{
+    size_t u;
+
+    /* Grow the set when it's half full */
+    if (2 * (set->nused + 1) > set->nslots) {
+        haddr_t *old_addrs  = set->addrs;
+        size_t   old_nslots = set->nslots;
+
+        set->nslots = old_nslots ? 2 * old_nslots : 1024;
+        if (NULL == (set->addrs = (haddr_t *)HDmalloc(set->nslots * sizeof(haddr_t))))
+            return -1;
+        for (u = 0; u < set->nslots; u++)
+            set->addrs[u] = HADDR_UNDEF;
+        set->nused = 0;
+        for (u = 0; u < old_nslots; u++)
+            if (H5F_addr_defined(old_addrs[u]))
+                addr_set_insert(set, old_addrs[u]);
+        HDfree(old_addrs);
+    } /* end if */
+
+    for (u = (size_t)(addr * 0x9E3779B97F4A7C15ULL) & (set->nslots - 1); H5F_addr_defined(set->addrs[u]);
+         u = (u + 1) & (set->nslots - 1))
+        if (H5F_addr_eq(set->addrs[u], addr))
+            return 0;
+    set->addrs[u] = addr;
+    set->nused++;
+
+    return 0;
+} /* addr_set_insert() */
+
+/*-------------------------------------------------------------------------
+ * Function:    addr_set_remove
+ *
+ * Purpose:     Remove an address from a set
+ *
+ * Return:      TRUE if the address was in the set, FALSE otherwise
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+addr_set_remove(addr_set_t *set, haddr_t addr)
+{
+    size_t u, v;
+
+    if (0 == set->nused)
+        return FALSE;
+
+    for (u = (size_t)(addr * 0x9E3779B97F4A7C15ULL) & (set->nslots - 1); H5F_addr_defined(set->addrs[u]);
+         u = (u + 1) & (set->nslots - 1))
+        if (H5F_addr_eq(set->addrs[u], addr)) {
+            set->addrs[u] = HADDR_UNDEF;
+            set->nused--;
+
+            /* Put back the addresses after the hole that probed past it */
+            for (v = (u + 1) & (set->nslots - 1); H5F_addr_defined(set->addrs[v]);
+                 v = (v + 1) & (set->nslots - 1)) {
+                haddr_t moved = set->addrs[v];
+
+                set->addrs[v] = HADDR_UNDEF;
+                set->nused--;
+                addr_set_insert(set, moved);
+            } /* end for */
+
+            return TRUE;
+        } /* end if */
+
+    return FALSE;
+} /* addr_set_remove() */
+
+/*-------------------------------------------------------------------------
+ * Function:    read_header
+ *
+ * Purpose:     Read and check the header of the log, and the names of the
+ *              entry types
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+read_header(FILE *fp, int64_t *start_time, int *mpi_rank)
+{
+    uint8_t        header[H5C_LOG_BINARY_HEADER_SIZE];
+    const uint8_t *p = header;
+    unsigned       ntypes;
+    unsigned       u;
+
+    if (HDfread(header, 1, sizeof(header), fp) != sizeof(header) ||
+        HDmemcmp(p, H5C_LOG_BINARY_SIGNATURE, (size_t)H5C_LOG_BINARY_SIGNATURE_LEN) != 0) {
+        error_msg("not a binary metadata cache log\n");
+        return -1;
+    } /* end if */
+    p += H5C_LOG_BINARY_SIGNATURE_LEN;
+    if (*p++ != H5C_LOG_BINARY_VERSION) {
+        error_msg("unsupported log version %u\n", (unsigned)p[-1]);
+        return -1;
+    } /* end if */
+    if (*p++ != H5C_LOG_BINARY_RECORD_SIZE) {
+        error_msg("unexpected record size %u\n", (unsigned)p[-1]);
+        return -1;
+    } /* end if */
+    ntypes = *p++;
+    p++;
+    INT64DECODE(p, *start_time);
+    INT32DECODE(p, *mpi_rank);
+
+    /* Read the names of the entry types */
+    for (u = 0; u < ntypes; u++) {
+        uint8_t id_len[2];
+
+        if (HDfread(id_len, 1, sizeof(id_len), fp) != sizeof(id_len) || id_len[0] >= NUM_TYPE_IDS) {
+            error_msg("bad entry type table\n");
+            return -1;
+        } /* end if */
+        HDfree(type_names_g[id_len[0]]);
+        if (NULL == (type_names_g[id_len[0]] = (char *)HDcalloc((size_t)id_len[1] + 1, 1)) ||
+            HDfread(type_names_g[id_len[0]], 1, (size_t)id_len[1], fp) != (size_t)id_len[1]) {
+            error_msg("bad entry type table\n");
+            return -1;
+        } /* end if */
+    }     /* end for */
+
+    return 0;
+} /* read_header() */
+
+/*-------------------------------------------------------------------------
+ * Function:    decode_record
+ *
+ * Purpose:     Decode a record
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+decode_record(const uint8_t *p, record_t *rec)
+{
+    uint64_t addr;
+
+    UINT64DECODE(p, rec->time);
+    UINT64DECODE(p, addr);
+    UINT64DECODE(p, rec->aux);
+    UINT32DECODE(p, rec->size);
+    rec->addr    = (haddr_t)addr;
+    rec->op      = *p++;
+    rec->type_id = *p++;
+    rec->status  = *p++;
+} /* decode_record() */
+
+/*-------------------------------------------------------------------------
+ * Function:    print_record
+ *
+ * Purpose:     Print a record as JSON or CSV
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+print_record(const record_t *rec, hbool_t first)
+{
+    const char *op   = rec->op < H5C_LOG_BINARY_NOPS ? op_names_g[rec->op] : "unknown";
+    const char *type = NULL;
+
+    if (rec->type_id != H5C_LOG_BINARY_NO_TYPE)
+        type = type_names_g[rec->type_id] ? type_names_g[rec->type_id] : "unknown";
+
+    if (FORMAT_JSON == format_g) {
+        HDfprintf(stdout, "%s{\"time\":%" PRIu64 ",\"op\":\"%s\",", first ? "" : ",\n", rec->time, op);
+        if (type)
+            HDfprintf(stdout, "\"type\":\"%s\",", type);
+        else
+            HDfprintf(stdout, "\"type\":null,");
+        if (H5F_addr_defined(rec->addr))
+            HDfprintf(stdout, "\"address\":%" PRIuHADDR ",", rec->addr);
+        else
+            HDfprintf(stdout, "\"address\":null,");
+        HDfprintf(stdout, "\"size\":%" PRIu32 ",\"aux\":%" PRIu64 ",", rec->size, rec->aux);
+        if (H5C_LOG_BINARY_PROTECT == rec->op)
+            HDfprintf(stdout, "\"hit\":%s,", (rec->status & H5C_LOG_BINARY_HIT) ? "true" : "false");
+        HDfprintf(stdout, "\"failed\":%s}", (rec->status & H5C_LOG_BINARY_FAILED) ? "true" : "false");
+    } /* end if */
+    else {
+        HDfprintf(stdout, "%" PRIu64 ",%s,%s,", rec->time, op, type ? type : "");
+        if (H5F_addr_defined(rec->addr))
+            HDfprintf(stdout, "%" PRIuHADDR, rec->addr);
+        HDfprintf(stdout, ",%" PRIu32 ",%" PRIu64 ",", rec->size, rec->aux);
+        if (H5C_LOG_BINARY_PROTECT == rec->op)
+            HDfprintf(stdout, "%d", (rec->status & H5C_LOG_BINARY_HIT) ? 1 : 0);
+        HDfprintf(stdout, ",%d\n", (rec->status & H5C_LOG_BINARY_FAILED) ? 1 : 0);
+    } /* end else */
+} /* print_record() */
+
+/*-------------------------------------------------------------------------
+ * Function:    end_burst
+ *
+ * Purpose:     Account for the current run of flushes
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+end_burst(log_stats_t *stats)
+{
+    if (stats->curr_burst_flushes >= 2) {
+        stats->nbursts++;
+        stats->burst_flushes += stats->curr_burst_flushes;
+        stats->max_burst_flushes = MAX(stats->max_burst_flushes, stats->curr_burst_flushes);
+        stats->max_burst_bytes   = MAX(stats->max_burst_bytes, stats->curr_burst_bytes);
+        stats->max_burst_duration =
+            MAX(stats->max_burst_duration, stats->last_flush - stats->curr_burst_start);
+    } /* end if */
+    stats->curr_burst_flushes = 0;
+    stats->curr_burst_bytes   = 0;
+} /* end_burst() */
+
+/*-------------------------------------------------------------------------
+ * Function:    update_stats
+ *
+ * Purpose:     Account for a record in the summary statistics
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+update_stats(log_stats_t *stats, const record_t *rec)
+{
+    type_stats_t *type = &stats->types[rec->type_id < NUM_TYPE_IDS ? rec->type_id : 0];
+
+    stats->nrecords++;
+    stats->duration = MAX(stats->duration, rec->time);
+    if (rec->status & H5C_LOG_BINARY_FAILED) {
+        stats->nfailed++;
+        return 0;
+    } /* end if */
+    if (rec->type_id >= NUM_TYPE_IDS)
+        return 0;
+
+    switch (rec->op) {
+        case H5C_LOG_BINARY_PROTECT:
+            type->protects++;
+            if (rec->status & H5C_LOG_BINARY_HIT)
+                type->hits++;
+            break;
+
+        case H5C_LOG_BINARY_INSERT:
+            type->inserts++;
+            break;
+
+        case H5C_LOG_BINARY_LOAD:
+            if (addr_set_remove(&stats->evicted, rec->addr)) {
+                type->reloads++;
+                stats->reload_bytes += rec->size;
+            } /* end if */
+            break;
+
+        case H5C_LOG_BINARY_EVICT:
+            type->evictions++;
+            if (addr_set_insert(&stats->evicted, rec->addr) < 0)
+                return -1;
+            break;
+
+        case H5C_LOG_BINARY_FLUSH:
+            type->flushes++;
+            type->flush_bytes += rec->size;
+
+            /* Flushes close together make up a burst */
+            if (stats->curr_burst_flushes > 0 && rec->time - stats->last_flush > burst_gap_g)
+                end_burst(stats);
+            if (0 == stats->curr_burst_flushes)
+                stats->curr_burst_start = rec->time;
+            stats->curr_burst_flushes++;
+            stats->curr_burst_bytes += rec->size;
+            stats->last_flush = rec->time;
+            break;
+
+        default:
+            break;
+    } /* end switch */
+
+    return 0;
+} /* update_stats() */
+
+/*-------------------------------------------------------------------------
+ * Function:    print_summary
+ *
+ * Purpose:     Print the summary statistics
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+print_summary(FILE *out, log_stats_t *stats, int64_t start_time, int mpi_rank)
+{
+    type_stats_t total;
+    unsigned     u;
+
+    end_burst(stats);
+
+    HDmemset(&total, 0, sizeof(total));
+    for (u = 0; u < NUM_TYPE_IDS; u++) {
+        total.protects += stats->types[u].protects;
+        total.hits += stats->types[u].hits;
+        total.inserts += stats->types[u].inserts;
+        total.flushes += stats->types[u].flushes;
+        total.flush_bytes += stats->types[u].flush_bytes;
+        total.evictions += stats->types[u].evictions;
+        total.reloads += stats->types[u].reloads;
+    } /* end for */
+
+    HDfprintf(out, "Metadata cache log: %s\n", fname_g);
+    HDfprintf(out, "\tStarted at: %" PRId64 " (seconds since the epoch)\n", start_time);
+    if (mpi_rank >= 0)
+        HDfprintf(out, "\tMPI rank: %d\n", mpi_rank);
+    HDfprintf(out, "\tRecords: %" PRIu64 " over %.6f seconds\n", stats->nrecords,
+              (double)stats->duration / 1000000.0);
+    HDfprintf(out, "\tFailed operations: %" PRIu64 "\n", stats->nfailed);
+
+    HDfprintf(out, "Hit rate by entry type:\n");
+    HDfprintf(out, "\t%-32s %12s %12s %8s %10s %10s %10s\n", "Entry type", "Protects", "Hits", "Hit rate",
+              "Inserts", "Flushes", "Evictions");
+    for (u = 0; u < NUM_TYPE_IDS; u++) {
+        const type_stats_t *type = &stats->types[u];
+
+        if (type->protects || type->inserts || type->flushes || type->evictions)
+            HDfprintf(out,
+                      "\t%-32s %12" PRIu64 " %12" PRIu64 " %7.2f%% %10" PRIu64 " %10" PRIu64 " %10" PRIu64
+                      "\n",
+                      type_names_g[u] ? type_names_g[u] : "unknown", type->protects, type->hits,
+                      type->protects ? 100.0 * (double)type->hits / (double)type->protects : 0.0,
+                      type->inserts, type->flushes, type->evictions);
+    } /* end for */
+    HDfprintf(out,
+              "\t%-32s %12" PRIu64 " %12" PRIu64 " %7.2f%% %10" PRIu64 " %10" PRIu64 " %10" PRIu64 "\n",
+              "Total", total.protects, total.hits,
+              total.protects ? 100.0 * (double)total.hits / (double)total.protects : 0.0, total.inserts,
+              total.flushes, total.evictions);
+
+    HDfprintf(out, "Eviction churn:\n");
+    HDfprintf(out, "\tEvictions: %" PRIu64 "\n", total.evictions);
+    HDfprintf(out, "\tEvicted entries loaded again: %" PRIu64 " (%.2f%%), %" PRIu64 " bytes\n",
+              total.reloads, total.evictions ? 100.0 * (double)total.reloads / (double)total.evictions : 0.0,
+              stats->reload_bytes);
+    for (u = 0; u < NUM_TYPE_IDS; u++)
+        if (stats->types[u].reloads)
+            HDfprintf(out, "\t\t%-32s %10" PRIu64 "\n", type_names_g[u] ? type_names_g[u] : "unknown",
+                      stats->types[u].reloads);
+
+    HDfprintf(out, "Flush bursts (flushes at most %" PRIu64 " us apart):\n", burst_gap_g);
+    HDfprintf(out, "\tFlushes: %" PRIu64 ", %" PRIu64 " bytes\n", total.flushes, total.flush_bytes);
+    HDfprintf(out, "\tBursts: %" PRIu64 ", with %" PRIu64 " flushes\n", stats->nbursts, stats->burst_flushes);
+    if (stats->nbursts) {
+        HDfprintf(out, "\tMean burst: %.1f flushes\n", (double)stats->burst_flushes / (double)stats->nbursts);
+        HDfprintf(out, "\tLargest burst: %" PRIu64 " flushes, %" PRIu64 " bytes\n", stats->max_burst_flushes,
+                  stats->max_burst_bytes);
+        HDfprintf(out, "\tLongest burst: %" PRIu64 " us\n", stats->max_burst_duration);
+    } /* end if */
+} /* print_summary() */
+
+/*-------------------------------------------------------------------------
+ * Function:    main
+ *
+ * Purpose:     Decode a binary metadata cache log
+ *
+ * Return:      Success: 0
+ *              Failure: 1
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(int argc, const char *argv[])
+{
+    FILE *       fp    = NULL;
+    uint8_t *    buf   = NULL;
+    log_stats_t *stats = NULL;
+    int64_t      start_time;
+    int          mpi_rank;
+    size_t       nrecs;
+    size_t       u;
+    hbool_t      first = TRUE;
+
+    h5tools_setprogname(PROGRAMNAME);
+    h5tools_setstatus(EXIT_SUCCESS);
+
+    /* initialize h5tools lib */
+    h5tools_init();
+
+    HDcompile_assert(NELMTS(op_names_g) == H5C_LOG_BINARY_NOPS);
+
+    /* Parse command line options */
+    if (parse_command_line(argc, argv) < 0)
+        goto done;
+
+    if (fname_g == NULL)
+        goto done;
+
+    if (NULL == (fp = HDfopen(fname_g, "rb"))) {
+        error_msg("unable to open \"%s\"\n", fname_g);
+        h5tools_setstatus(EXIT_FAILURE);
+        goto done;
+    }
+    if (read_header(fp, &start_time, &mpi_rank) < 0) {
+        h5tools_setstatus(EXIT_FAILURE);
+        goto done;
+    }
+
+    if (NULL == (buf = (uint8_t *)HDmalloc(RECORDS_PER_READ * H5C_LOG_BINARY_RECORD_SIZE)) ||
+        NULL == (stats = (log_stats_t *)HDcalloc(1, sizeof(log_stats_t)))) {
+        error_msg("memory allocation failed\n");
+        h5tools_setstatus(EXIT_FAILURE);
+        goto done;
+    }
+
+    if (FORMAT_JSON == format_g)
+        HDfprintf(stdout, "{\n\"mpi_rank\":%d,\n\"start_time\":%" PRId64 ",\n\"records\":[\n", mpi_rank,
+                  start_time);
+    else if (FORMAT_CSV == format_g)
+        HDfprintf(stdout, "time_us,op,type,address,size,aux,hit,failed\n");
+
+    /* Decode the records */
+    while ((nrecs = HDfread(buf, H5C_LOG_BINARY_RECORD_SIZE, RECORDS_PER_READ, fp)) > 0) {
+        for (u = 0; u < nrecs; u++) {
+            record_t rec;
+
+            decode_record(buf + (u * H5C_LOG_BINARY_RECORD_SIZE), &rec);
+            if (FORMAT_NONE != format_g)
+                print_record(&rec, first);
+            if (summary_g && update_stats(stats, &rec) < 0) {
+                error_msg("memory allocation failed\n");
+                h5tools_setstatus(EXIT_FAILURE);
+                goto done;
+            }
+            first = FALSE;
+        } /* end for */
+    }     /* end while */
+    if (HDferror(fp)) {
+        error_msg("error reading \"%s\"\n", fname_g);
+        h5tools_setstatus(EXIT_FAILURE);
+        goto done;
+    }
+
+    if (FORMAT_JSON == format_g)
+        HDfprintf(stdout, "\n]}\n");
+
+    if (summary_g)
+        print_summary(FORMAT_NONE == format_g ? stdout : stderr, stats, start_time, mpi_rank);
+
+done:
+    if (fp)
+        HDfclose(fp);
+    HDfree(buf);
+    if (stats)
+        HDfree(stats->evicted.addrs);
+    HDfree(stats);
+    for (u = 0; u < NUM_TYPE_IDS; u++)
+        HDfree(type_names_g[u]);
+    HDfree(fname_g);
+
+    leave(h5tools_getstatus());
+}